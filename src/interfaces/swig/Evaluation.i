@@ -56,6 +56,7 @@
 %include <shogun/evaluation/MeanAbsoluteError.h>
 %include <shogun/evaluation/MeanSquaredError.h>
 %include <shogun/evaluation/MeanSquaredLogError.h>
+%include <shogun/evaluation/BinaryScores.h>
 %include <shogun/evaluation/ROCEvaluation.h>
 %include <shogun/evaluation/PRCEvaluation.h>
 %include <shogun/evaluation/MachineEvaluation.h>
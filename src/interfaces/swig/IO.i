@@ -18,6 +18,7 @@
 %rename(HDF5File) CHDF5File;
 %rename(SerializableFile) CSerializableFile;
 %rename(SerializableAsciiFile) CSerializableAsciiFile;
+%rename(SerializableBinaryFile) CSerializableBinaryFile;
 %rename(SerializableHdf5File) CSerializableHdf5File;
 %rename(SerializableJsonFile) CSerializableJsonFile;
 %rename(SerializableXmlFile) CSerializableXmlFile;
@@ -122,6 +123,7 @@ namespace shogun
 %include <shogun/io/HDF5File.h>
 %include <shogun/io/SerializableFile.h>
 %include <shogun/io/SerializableAsciiFile.h>
+%include <shogun/io/SerializableBinaryFile.h>
 %include <shogun/io/SerializableHdf5File.h>
 %include <shogun/io/SerializableJsonFile.h>
 %include <shogun/io/SerializableXmlFile.h>
@@ -19,6 +19,7 @@
 %rename(StreamingMMD) CStreamingMMD;
 %rename(LinearTimeMMD) CLinearTimeMMD;
 %rename(BTestMMD) CBTestMMD;
+%rename(LinearTimeHSIC) CLinearTimeHSIC;
 %rename(QuadraticTimeMMD) CQuadraticTimeMMD;
 %rename(MultiKernelQuadraticTimeMMD) CMultiKernelQuadraticTimeMMD;
 %rename(KernelSelectionStrategy) CKernelSelectionStrategy;
@@ -34,6 +35,7 @@
 %include <shogun/statistical_testing/StreamingMMD.h>
 %include <shogun/statistical_testing/LinearTimeMMD.h>
 %include <shogun/statistical_testing/BTestMMD.h>
+%include <shogun/statistical_testing/LinearTimeHSIC.h>
 %include <shogun/statistical_testing/QuadraticTimeMMD.h>
 %include <shogun/statistical_testing/MultiKernelQuadraticTimeMMD.h>
 %include <shogun/statistical_testing/kernelselection/KernelSelectionStrategy.h>
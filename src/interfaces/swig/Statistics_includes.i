@@ -9,6 +9,7 @@
  #include <shogun/statistical_testing/StreamingMMD.h>
  #include <shogun/statistical_testing/LinearTimeMMD.h>
  #include <shogun/statistical_testing/BTestMMD.h>
+ #include <shogun/statistical_testing/LinearTimeHSIC.h>
  #include <shogun/statistical_testing/QuadraticTimeMMD.h>
  #include <shogun/statistical_testing/MultiKernelQuadraticTimeMMD.h>
  #include <shogun/statistical_testing/kernelselection/KernelSelectionStrategy.h>
@@ -160,7 +160,6 @@
 %ignore shogun::CSVMLight::update_linear_component;
 %ignore shogun::CSVMLight::update_linear_component_mkl;
 %ignore shogun::CSVMLight::update_linear_component_mkl_linadd;
-%ignore shogun::CSVMLight::update_linear_component_mkl_linadd_helper;
 %ignore shogun::CSVRLight::call_mkl_callback;
 %ignore shogun::CSVRLight::svr_learn;
 %ignore shogun::CSVRLight::update_linear_component_mkl;
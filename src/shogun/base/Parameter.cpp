@@ -2304,6 +2304,11 @@ TParameter::save_stype(CSerializableFile* file, const void* param,
 		}
 		if (!file->write_string_begin(
 				&m_datatype, m_name, prefix, len_real)) return false;
+		if (len_real > 0 && file->has_block_support(&m_datatype)) {
+			if (!file->write_block(
+					&m_datatype, m_name, prefix, str_ptr->string,
+					len_real*m_datatype.sizeof_ptype())) return false;
+		} else
 		for (index_t i=0; i<len_real; i++) {
 			if (!file->write_stringentry_begin(
 					&m_datatype, m_name, prefix, i)) return false;
@@ -2327,6 +2332,12 @@ TParameter::save_stype(CSerializableFile* file, const void* param,
 		}
 		if (!file->write_sparse_begin(
 				&m_datatype, m_name, prefix, len_real)) return false;
+		if (len_real > 0 && file->has_block_support(&m_datatype)) {
+			if (!file->write_block(
+					&m_datatype, m_name, prefix, spr_ptr->features,
+					len_real*TSGDataType::sizeof_sparseentry(
+						m_datatype.m_ptype))) return false;
+		} else
 		for (index_t i=0; i<len_real; i++) {
 			SGSparseVectorEntry<char>* cur = (SGSparseVectorEntry<char>*)
 				((char*) spr_ptr->features + i *TSGDataType
@@ -2370,6 +2381,11 @@ TParameter::load_stype(CSerializableFile* file, void* param,
 			return false;
 		str_ptr->string = len_real > 0
 			? SG_MALLOC(char, len_real*m_datatype.sizeof_ptype()): NULL;
+		if (len_real > 0 && file->has_block_support(&m_datatype)) {
+			if (!file->read_block(
+					&m_datatype, m_name, prefix, str_ptr->string,
+					len_real*m_datatype.sizeof_ptype())) return false;
+		} else
 		for (index_t i=0; i<len_real; i++) {
 			if (!file->read_stringentry_begin(
 					&m_datatype, m_name, prefix, i)) return false;
@@ -2390,6 +2406,12 @@ TParameter::load_stype(CSerializableFile* file, void* param,
 		spr_ptr->features = len_real > 0? (SGSparseVectorEntry<char>*)
 			SG_MALLOC(char, len_real *TSGDataType::sizeof_sparseentry(
 				m_datatype.m_ptype)): NULL;
+		if (len_real > 0 && file->has_block_support(&m_datatype)) {
+			if (!file->read_block(
+					&m_datatype, m_name, prefix, spr_ptr->features,
+					len_real*TSGDataType::sizeof_sparseentry(
+						m_datatype.m_ptype))) return false;
+		} else
 		for (index_t i=0; i<len_real; i++) {
 			SGSparseVectorEntry<char>* cur = (SGSparseVectorEntry<char>*)
 				((char*) spr_ptr->features + i *TSGDataType
@@ -2572,6 +2594,13 @@ TParameter::save(CSerializableFile* file, const char* prefix)
 
 		/* ******************************************************** */
 
+		if (m_datatype.m_stype == ST_NONE && (int64_t) len_real_x*len_real_y > 0
+			&& file->has_block_support(&m_datatype)) {
+			if (!file->write_block(
+					&m_datatype, m_name, prefix, *(char**) m_parameter,
+					(size_t) len_real_x*len_real_y
+					*m_datatype.sizeof_stype())) return false;
+		} else
 		for (index_t x=0; x<len_real_x; x++)
 			for (index_t y=0; y<len_real_y; y++) {
 				if (!file->write_item_begin(
@@ -2658,6 +2687,15 @@ TParameter::load(CSerializableFile* file, const char* prefix)
 					break;
 			}
 
+			if (m_datatype.m_stype == ST_NONE && (int64_t) dims[0]*dims[1] > 0
+				&& file->has_block_support(&m_datatype))
+			{
+				if (!file->read_block(
+							&m_datatype, m_name, prefix, *(char**) m_parameter,
+							(size_t) dims[0]*dims[1]*m_datatype.sizeof_stype()))
+					return false;
+			}
+			else
 			for (index_t x=0; x<dims[0]; x++)
 			{
 				for (index_t y=0; y<dims[1]; y++)
@@ -11,6 +11,7 @@
 #include <shogun/classifier/mkl/MKL.h>
 #include <shogun/classifier/svm/LibSVM.h>
 #include <shogun/kernel/CombinedKernel.h>
+#include <shogun/kernel/normalizer/IdentityKernelNormalizer.h>
 
 #ifdef USE_GLPK
 #include <glpk.h>
@@ -267,6 +268,7 @@ void CMKL::register_params()
 	mkl_iterations = 0;
 	mkl_epsilon = 1e-5;
 	interleaved_optimization = true;
+	subkernel_cache_enabled = false;
 	w_gap = 1.0;
 	rho = 0;
 	lp_initialized = false;
@@ -285,6 +287,7 @@ void CMKL::register_params()
 	SG_ADD(&mkl_iterations, "mkl_iterations", "number of mkl steps");
 	SG_ADD(&mkl_epsilon, "mkl_epsilon", "mkl epsilon");
 	SG_ADD(&interleaved_optimization, "interleaved_optimization", "whether to use mkl wrapper or interleaved opt.");
+	SG_ADD(&subkernel_cache_enabled, "subkernel_cache_enabled", "whether to cache sub-kernel Gram matrices for training");
 	SG_ADD(&w_gap, "w_gap", "gap between interactions");
 	SG_ADD(&rho, "rho", "objective after mkl iterations");
 	SG_ADD(&lp_initialized, "lp_initialized", "if lp is Initialized");
@@ -427,6 +430,14 @@ bool CMKL::train_machine(CFeatures* data)
 		self->init_glpk();
 #endif
 
+	// every beta iteration evaluates the same sub-kernel entries with new
+	// weights, serve them from the cache if requested
+	CCombinedKernel* cached_kernel=NULL;
+	if (subkernel_cache_enabled && kernel->get_kernel_type()==K_COMBINED &&
+		!((CCombinedKernel*) kernel)->get_append_subkernel_weights() &&
+		((CCombinedKernel*) kernel)->precompute_subkernel_cache())
+		cached_kernel=(CCombinedKernel*) kernel;
+
 	mkl_iterations = 0;
 
 	training_time_clock.start();
@@ -493,6 +504,9 @@ bool CMKL::train_machine(CFeatures* data)
 	self->cleanup_glpk(lp_initialized);
 #endif
 
+	if (cached_kernel)
+		cached_kernel->clear_subkernel_cache();
+
 	int32_t nsv=svm->get_num_support_vectors();
 	create_new_model(nsv);
 
@@ -1634,6 +1648,59 @@ void CMKL::compute_sum_beta(float64_t* sumw)
 		sumw[i]=0;
 	}
 
+	bool direct=false;
+	if (kernel->get_kernel_type()==K_COMBINED &&
+		!((CCombinedKernel*) kernel)->get_append_subkernel_weights())
+	{
+		// a normalizer on the combined kernel rescales the weighted sum,
+		// which the sub-kernels alone do not see
+		CKernelNormalizer* normalizer=kernel->get_normalizer();
+		direct=dynamic_cast<CIdentityKernelNormalizer*>(normalizer)!=NULL;
+		SG_UNREF(normalizer);
+	}
+
+	if (direct)
+	{
+		// one weight per sub-kernel: evaluate the sub-kernels directly
+		// instead of toggling the weights, in parallel over support vectors
+		CCombinedKernel* ck=(CCombinedKernel*) kernel;
+		ASSERT(ck->get_num_kernels()==num_kernels)
+
+		SGVector<int32_t> sv_idx(nsv);
+		SGVector<float64_t> sv_alpha(nsv);
+		for (int32_t i=0; i<nsv; i++)
+		{
+			sv_idx[i]=svm->get_support_vector(i);
+			sv_alpha[i]=svm->get_alpha(i);
+		}
+
+		const bool cached=ck->has_subkernel_cache();
+		for (int32_t n=0; n<num_kernels; n++)
+		{
+			CKernel* kn=ck->get_kernel(n);
+			float64_t sum=0;
+
+#pragma omp parallel for reduction(+:sum) schedule(dynamic)
+			for (int32_t i=0; i<nsv; i++)
+			{
+				float64_t row_sum=0;
+				for (int32_t j=0; j<nsv; j++)
+				{
+					float64_t k_ij=cached ? ck->compute_subkernel(n, sv_idx[i], sv_idx[j])
+						: kn->kernel(sv_idx[i], sv_idx[j]);
+					row_sum+=sv_alpha[j]*k_ij;
+				}
+				sum+=sv_alpha[i]*row_sum;
+			}
+
+			sumw[n]=0.5*sum;
+			SG_UNREF(kn);
+		}
+
+		mkl_iterations++;
+		return;
+	}
+
 	for (int32_t n=0; n<num_kernels; n++)
 	{
 		beta.vector[n]=1.0;
@@ -168,6 +168,28 @@ class CMKL : public CSVM
 			return interleaved_optimization;
 		}
 
+		/** set whether the sub-kernel Gram matrices of a combined kernel are
+		 * cached for training, see
+		 * CCombinedKernel::precompute_subkernel_cache(). The cache needs
+		 * num_kernels*n*(n+1)/2 floats for n training vectors and is
+		 * dropped after training.
+		 *
+		 * @param enable if true sub-kernels are cached
+		 */
+		inline void set_subkernel_cache_enabled(bool enable)
+		{
+			subkernel_cache_enabled=enable;
+		}
+
+		/** get whether sub-kernel Gram matrices are cached for training
+		 *
+		 * @return true if sub-kernels are cached
+		 */
+		inline bool get_subkernel_cache_enabled()
+		{
+			return subkernel_cache_enabled;
+		}
+
 		/** compute mkl primal objective
 		 *
 		 * @return computed mkl primal objective
@@ -428,6 +450,8 @@ class CMKL : public CSVM
 		float64_t mkl_epsilon;
 		/** whether to use mkl wrapper or interleaved opt. */
 		bool interleaved_optimization;
+		/** whether to cache the sub-kernel Gram matrices for training */
+		bool subkernel_cache_enabled;
 
 		/** gap between iterations */
 		float64_t w_gap;
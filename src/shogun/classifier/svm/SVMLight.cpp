@@ -70,16 +70,6 @@ struct S_THREAD_PARAM_REACTIVATE_LINADD
 	int32_t end;
 };
 
-struct S_THREAD_PARAM_SVMLIGHT
-{
-	float64_t * lin ;
-	float64_t* W;
-	int32_t start, end;
-	int32_t * active2dnum ;
-	int32_t * docs ;
-	CKernel* kernel ;
-};
-
 struct S_THREAD_PARAM_REACTIVATE_VANILLA
 {
 	CKernel* kernel;
@@ -104,18 +94,6 @@ struct S_THREAD_PARAM_KERNEL
 
 #endif // DOXYGEN_SHOULD_SKIP_THIS
 
-void* CSVMLight::update_linear_component_linadd_helper(void* p)
-{
-	S_THREAD_PARAM_SVMLIGHT* params = (S_THREAD_PARAM_SVMLIGHT*) p;
-
-	int32_t jj=0, j=0 ;
-
-	for (jj=params->start;(jj<params->end) && (j=params->active2dnum[jj])>=0;jj++)
-		params->lin[j]+=params->kernel->compute_optimized(params->docs[j]);
-
-	return NULL ;
-}
-
 void* CSVMLight::compute_kernel_helper(void* p)
 {
 	S_THREAD_PARAM_KERNEL* params = (S_THREAD_PARAM_KERNEL*) p;
@@ -1472,54 +1450,18 @@ void CSVMLight::update_linear_component(
 
 			if (num_working>0)
 			{
-				// TODO: port to use OpenMP backend instead of pthread
-#ifdef HAVE_PTHREAD
-				int32_t num_threads=parallel->get_num_threads();
-#else
-				int32_t num_threads=1;
-#endif
-				if (num_threads < 2)
+				int32_t num_active=0;
+				while (active2dnum[num_active]>=0)
+					num_active++;
+
+				// the examples differ in cost, so they are handed out
+				// dynamically to the threads
+#pragma omp parallel for schedule(dynamic, 64)
+				for (int32_t k=0; k<num_active; k++)
 				{
-					for (jj=0;(j=active2dnum[jj])>=0;jj++) {
-						lin[j]+=kernel->compute_optimized(docs[j]);
-					}
+					int32_t idx=active2dnum[k];
+					lin[idx]+=kernel->compute_optimized(docs[idx]);
 				}
-#ifdef HAVE_PTHREAD
-				else
-				{
-					int32_t num_elem = 0 ;
-					for (jj=0;(j=active2dnum[jj])>=0;jj++) num_elem++ ;
-
-					pthread_t* threads = SG_MALLOC(pthread_t, num_threads-1);
-					S_THREAD_PARAM_SVMLIGHT* params = SG_MALLOC(S_THREAD_PARAM_SVMLIGHT, num_threads-1);
-					int32_t start = 0 ;
-					int32_t step = num_elem/num_threads;
-					int32_t end = step ;
-
-					for (int32_t t=0; t<num_threads-1; t++)
-					{
-						params[t].kernel = kernel ;
-						params[t].lin = lin ;
-						params[t].docs = docs ;
-						params[t].active2dnum=active2dnum ;
-						params[t].start = start ;
-						params[t].end = end ;
-						start=end ;
-						end+=step ;
-						pthread_create(&threads[t], NULL, update_linear_component_linadd_helper, (void*)&params[t]) ;
-					}
-
-					for (jj=params[num_threads-2].end;(j=active2dnum[jj])>=0;jj++) {
-						lin[j]+=kernel->compute_optimized(docs[j]);
-					}
-					void* ret;
-					for (int32_t t=0; t<num_threads-1; t++)
-						pthread_join(threads[t], &ret) ;
-
-					SG_FREE(params);
-					SG_FREE(threads);
-				}
-#endif
 			}
 		}
 	}
@@ -1564,18 +1506,16 @@ void CSVMLight::update_linear_component_mkl(
 
 		for (index_t k_idx=0; k_idx<k->get_num_kernels(); k_idx++)
 		{
-			CKernel* kn = k->get_kernel(k_idx);
 			for (i=0;i<num;i++)
 			{
 				if(a[i] != a_old[i])
 				{
-					kn->get_kernel_row(i,NULL,aicache, true);
+					k->get_subkernel_row(k_idx, i, aicache);
 					for (j=0;j<num;j++)
 						W[j*num_kernels+n]+=(a[i]-a_old[i])*aicache[j]*(float64_t)label[i];
 				}
 			}
 
-			SG_UNREF(kn);
 			n++ ;
 		}
 	}
@@ -1651,45 +1591,10 @@ void CSVMLight::update_linear_component_mkl_linadd(
 			kernel->add_to_normal(docs[i], (a[i]-a_old[i])*(float64_t)label[i]);
 		}
 	}
-	// TODO: port to use OpenMP backend instead of pthread
-#ifdef HAVE_PTHREAD
-	int32_t num_threads=parallel->get_num_threads();
-#else
-	int32_t num_threads=1;
-#endif
-
-	if (num_threads < 2)
-	{
-		// determine contributions of different kernels
-		for (int32_t i=0; i<num; i++)
-			kernel->compute_by_subkernel(i,&W[i*num_kernels]);
-	}
-#ifdef HAVE_PTHREAD
-	else
-	{
-		pthread_t* threads = SG_MALLOC(pthread_t, num_threads-1);
-		S_THREAD_PARAM_SVMLIGHT* params = SG_MALLOC(S_THREAD_PARAM_SVMLIGHT, num_threads-1);
-		int32_t step= num/num_threads;
-
-		for (int32_t t=0; t<num_threads-1; t++)
-		{
-			params[t].kernel = kernel;
-			params[t].W = W;
-			params[t].start = t*step;
-			params[t].end = (t+1)*step;
-			pthread_create(&threads[t], NULL, CSVMLight::update_linear_component_mkl_linadd_helper, (void*)&params[t]);
-		}
-
-		for (int32_t i=params[num_threads-2].end; i<num; i++)
-			kernel->compute_by_subkernel(i,&W[i*num_kernels]);
-
-		for (int32_t t=0; t<num_threads-1; t++)
-			pthread_join(threads[t], NULL);
-
-		SG_FREE(params);
-		SG_FREE(threads);
-	}
-#endif
+	// determine contributions of different kernels
+#pragma omp parallel for schedule(dynamic, 64)
+	for (int32_t i=0; i<num; i++)
+		kernel->compute_by_subkernel(i,&W[i*num_kernels]);
 
 	// restore old weights
 	kernel->set_subkernel_weights(SGVector<float64_t>(w_backup,num_weights));
@@ -1697,19 +1602,6 @@ void CSVMLight::update_linear_component_mkl_linadd(
 	call_mkl_callback(a, label, lin);
 }
 
-void* CSVMLight::update_linear_component_mkl_linadd_helper(void* p)
-{
-	S_THREAD_PARAM_SVMLIGHT* params = (S_THREAD_PARAM_SVMLIGHT*) p;
-
-	int32_t num_kernels=params->kernel->get_num_subkernels();
-
-	// determine contributions of different kernels
-	for (int32_t i=params->start; i<params->end; i++)
-		params->kernel->compute_by_subkernel(i,&(params->W[i*num_kernels]));
-
-	return NULL ;
-}
-
 void CSVMLight::call_mkl_callback(float64_t* a, int32_t* label, float64_t* lin)
 {
 	int32_t num = kernel->get_num_vec_rhs();
@@ -13,15 +13,339 @@
 #include <shogun/clustering/GMM.h>
 #include <shogun/clustering/KMeans.h>
 #include <shogun/distance/EuclideanDistance.h>
-#include <shogun/labels/MulticlassLabels.h>
+#include <shogun/features/DenseFeatures.h>
 #include <shogun/lib/observers/ObservedValueTemplated.h>
 #include <shogun/mathematics/Math.h>
+#include <shogun/mathematics/eigen3.h>
 #include <shogun/mathematics/linalg/LinalgNamespace.h>
-#include <shogun/multiclass/KNN.h>
+#include <limits>
 #include <vector>
 
 using namespace shogun;
 using namespace std;
+using namespace Eigen;
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+/** vectors whose log-densities are computed together */
+static const index_t em_block_size=1024;
+
+/** sufficient statistics of vectors weighted by their responsibilities,
+ * centered at the means they were computed with
+ */
+struct EMStatistics
+{
+	EMStatistics(const vector<CGaussian*>& components, index_t dim)
+	{
+		const index_t num_components=components.size();
+		log_likelihood=0;
+		weights=VectorXd::Zero(num_components);
+		sums=MatrixXd::Zero(dim, num_components);
+		for (auto component : components)
+		{
+			switch (component->get_cov_type())
+			{
+				case FULL:
+					squares.push_back(MatrixXd::Zero(dim, dim));
+					break;
+				case DIAG:
+					squares.push_back(MatrixXd::Zero(dim, 1));
+					break;
+				case SPHERICAL:
+					squares.push_back(MatrixXd::Zero(1, 1));
+					break;
+			}
+		}
+	}
+
+	void add(const EMStatistics& other)
+	{
+		log_likelihood+=other.log_likelihood;
+		weights+=other.weights;
+		sums+=other.sums;
+		for (size_t k=0; k<squares.size(); k++)
+			squares[k]+=other.squares[k];
+	}
+
+	/** log likelihood of the vectors */
+	float64_t log_likelihood;
+	/** sums of the responsibilities */
+	VectorXd weights;
+	/** weighted sums of the centered vectors */
+	MatrixXd sums;
+	/** weighted sums of the outer products, squares or squared norms of
+	 * the centered vectors
+	 */
+	vector<MatrixXd> squares;
+};
+
+/** E-step over all vectors, accumulating the statistics for the M-step.
+ * If hard is set, each vector is assigned to the nearest center instead.
+ */
+template <class T>
+static EMStatistics em_pass(CDotFeatures* features,
+		const vector<CGaussian*>& components, SGVector<float64_t> coefficients,
+		const MatrixXd& centers, bool hard)
+{
+	typedef Matrix<T, Dynamic, Dynamic> MatrixXt;
+	typedef Matrix<T, Dynamic, 1> VectorXt;
+
+	const index_t num_vectors=features->get_num_vectors();
+	const index_t dim=features->get_dim_feature_space();
+	const index_t num_components=components.size();
+
+	/* log-densities are c_k-||W_k x-b_k||^2/2 with the whitening
+	 * transform W_k of the covariance, or its inverse diagonal */
+	vector<MatrixXt> whitening(num_components);
+	vector<VectorXt> offsets(num_components);
+	VectorXd constants=VectorXd::Zero(num_components);
+	const MatrixXt centers_t=centers.cast<T>();
+	for (index_t k=0; k<num_components && !hard; k++)
+	{
+		SGVector<float64_t> d=components[k]->get_d();
+		Map<VectorXd> eigenvalues(d.vector, d.vlen);
+		const ECovType cov_type=components[k]->get_cov_type();
+
+		float64_t log_det=eigenvalues.array().log().sum();
+		if (cov_type==SPHERICAL)
+			log_det*=dim;
+		constants[k]=std::log(coefficients[k])-0.5*(std::log(2*M_PI)*dim+log_det);
+
+		if (cov_type==FULL)
+		{
+			SGMatrix<float64_t> u=components[k]->get_u();
+			Map<MatrixXd> eigenvectors(u.matrix, u.num_rows, u.num_cols);
+			MatrixXd w=eigenvalues.array().rsqrt().matrix().asDiagonal()*
+				eigenvectors.transpose();
+			whitening[k]=w.cast<T>();
+			offsets[k]=(w*centers.col(k)).cast<T>();
+		}
+		else
+			offsets[k]=eigenvalues.array().inverse().matrix().cast<T>();
+	}
+
+	SGMatrix<T> matrix;
+	auto dense=dynamic_cast<CDenseFeatures<T>*>(features);
+	if (dense && !dense->get_subset_stack()->has_subsets())
+		matrix=dense->get_feature_matrix();
+
+	EMStatistics result(components, dim);
+	#pragma omp parallel
+	{
+		EMStatistics statistics(components, dim);
+		MatrixXt buffer(dim, em_block_size);
+		MatrixXt projected(dim, em_block_size);
+		MatrixXd log_densities(num_components, em_block_size);
+		MatrixXt centered;
+		MatrixXt weighted;
+		MatrixXt outer;
+
+		#pragma omp for schedule(dynamic)
+		for (index_t start=0; start<num_vectors; start+=em_block_size)
+		{
+			const index_t size=CMath::min(em_block_size, num_vectors-start);
+			Map<const MatrixXt> block(matrix.matrix ?
+					matrix.matrix+int64_t(start)*dim : buffer.data(), dim, size);
+			if (!matrix.matrix)
+			{
+				for (index_t i=0; i<size; i++)
+				{
+					SGVector<float64_t> v=features->get_computed_dot_feature_vector(start+i);
+					buffer.col(i)=Map<VectorXd>(v.vector, v.vlen).cast<T>();
+				}
+			}
+
+			auto responsibilities=log_densities.leftCols(size);
+			if (hard)
+			{
+				responsibilities.setZero();
+				for (index_t i=0; i<size; i++)
+				{
+					index_t nearest;
+					(centers_t.colwise()-block.col(i)).colwise().squaredNorm().minCoeff(&nearest);
+					responsibilities(nearest, i)=1;
+				}
+			}
+			else
+			{
+				for (index_t k=0; k<num_components; k++)
+				{
+					switch (components[k]->get_cov_type())
+					{
+						case FULL:
+							projected.leftCols(size).noalias()=whitening[k]*block;
+							responsibilities.row(k)=(projected.leftCols(size).colwise()-
+								offsets[k]).colwise().squaredNorm().template cast<float64_t>();
+							break;
+						case DIAG:
+							responsibilities.row(k)=((block.colwise()-centers_t.col(k)).array().square().colwise()*
+								offsets[k].array()).colwise().sum().template cast<float64_t>();
+							break;
+						case SPHERICAL:
+							responsibilities.row(k)=(block.colwise()-centers_t.col(k)).colwise().squaredNorm().
+								template cast<float64_t>()*float64_t(offsets[k][0]);
+							break;
+					}
+					responsibilities.row(k)=constants[k]-0.5*responsibilities.row(k).array();
+				}
+
+				/* the responsibilities are the normalized densities */
+				for (index_t i=0; i<size; i++)
+				{
+					auto column=responsibilities.col(i);
+					const float64_t max=column.maxCoeff();
+					const float64_t log_sum=max+std::log((column.array()-max).exp().sum());
+					column=(column.array()-log_sum).exp();
+					statistics.log_likelihood+=log_sum;
+				}
+			}
+
+			for (index_t k=0; k<num_components; k++)
+			{
+				const VectorXd r=responsibilities.row(k).transpose();
+				const float64_t weight=r.sum();
+				if (weight==0)
+					continue;
+
+				/* responsibilities that would be subnormal in T are
+				 * dropped, arithmetic on them is very slow */
+				centered=block.colwise()-centers_t.col(k);
+				const VectorXt r_t=(r.array()<float64_t(std::numeric_limits<T>::min())).
+					select(0, r).template cast<T>();
+				statistics.weights[k]+=weight;
+				statistics.sums.col(k)+=(centered*r_t).template cast<float64_t>();
+				switch (components[k]->get_cov_type())
+				{
+					case FULL:
+						weighted=centered*r_t.asDiagonal();
+						outer.noalias()=weighted*centered.transpose();
+						statistics.squares[k]+=outer.template cast<float64_t>();
+						break;
+					case DIAG:
+						statistics.squares[k]+=(centered.array().square().matrix()*r_t).template cast<float64_t>();
+						break;
+					case SPHERICAL:
+						statistics.squares[k](0, 0)+=centered.colwise().squaredNorm().dot(r_t.transpose());
+						break;
+				}
+			}
+		}
+
+		#pragma omp critical
+		result.add(statistics);
+	}
+
+	return result;
+}
+
+/** sets the mean of a component and an isotropic covariance */
+static void reseed_component(CGaussian* component, const VectorXd& center,
+		float64_t variance)
+{
+	const index_t dim=center.size();
+	SGVector<float64_t> mean(dim);
+	Map<VectorXd>(mean.vector, dim)=center;
+	component->set_mean(mean);
+
+	SGVector<float64_t> d(component->get_cov_type()==SPHERICAL ? 1 : dim);
+	d.set_const(variance);
+	if (component->get_cov_type()==FULL)
+	{
+		SGMatrix<float64_t> u(dim, dim);
+		Map<MatrixXd>(u.matrix, dim, dim).setIdentity();
+		component->set_u(u);
+	}
+	component->set_d(d);
+}
+
+/** M-step from the statistics, which are centered at the given centers */
+static void em_update(const EMStatistics& statistics,
+		const vector<CGaussian*>& components, SGVector<float64_t> coefficients,
+		const MatrixXd& centers, float64_t min_cov)
+{
+	const index_t dim=centers.rows();
+	const index_t num_components=components.size();
+
+	/* components that the initial assignment leaves without vectors have no
+	 * parameters yet, they are reseeded at their initial center with the
+	 * pooled variance and the weight of a single vector */
+	float64_t sum_weights=statistics.weights.sum();
+	float64_t pooled_variance=0;
+	index_t num_reseeded=0;
+	for (index_t k=0; k<num_components; k++)
+	{
+		const float64_t weight=statistics.weights[k];
+		if (weight==0)
+		{
+			if (!components[k]->get_mean().vector)
+				num_reseeded++;
+			continue;
+		}
+
+		const MatrixXd& squares=statistics.squares[k];
+		pooled_variance+=(squares.cols()==1 ? squares.sum() : squares.trace())-
+			statistics.sums.col(k).squaredNorm()/weight;
+	}
+	pooled_variance=CMath::max(min_cov, pooled_variance/(sum_weights*dim));
+	sum_weights+=num_reseeded;
+
+	for (index_t k=0; k<num_components; k++)
+	{
+		const float64_t weight=statistics.weights[k];
+		coefficients[k]=weight/sum_weights;
+		if (weight==0)
+		{
+			if (!components[k]->get_mean().vector)
+			{
+				coefficients[k]=1/sum_weights;
+				reseed_component(components[k], centers.col(k), pooled_variance);
+			}
+			continue;
+		}
+
+		/* the covariance follows from the second moments around the old
+		 * mean and its shift */
+		const VectorXd shift=statistics.sums.col(k)/weight;
+		SGVector<float64_t> mean(dim);
+		Map<VectorXd>(mean.vector, dim)=centers.col(k)+shift;
+		components[k]->set_mean(mean);
+
+		switch (components[k]->get_cov_type())
+		{
+			case FULL:
+			{
+				SGMatrix<float64_t> cov(dim, dim);
+				Map<MatrixXd>(cov.matrix, dim, dim)=statistics.squares[k]/weight-
+					shift*shift.transpose();
+
+				SGVector<float64_t> d(dim);
+				linalg::eigen_solver_symmetric(cov, d, cov);
+				for (auto& v : d)
+					v=CMath::max(min_cov, v);
+
+				components[k]->set_u(cov);
+				components[k]->set_d(d);
+				break;
+			}
+			case DIAG:
+			{
+				SGVector<float64_t> d(dim);
+				Map<VectorXd>(d.vector, dim)=(statistics.squares[k].col(0)/weight-
+					shift.cwiseAbs2()).cwiseMax(min_cov);
+				components[k]->set_d(d);
+				break;
+			}
+			case SPHERICAL:
+			{
+				SGVector<float64_t> d(1);
+				d[0]=CMath::max(min_cov,
+					(statistics.squares[k](0, 0)/weight-shift.squaredNorm())/dim);
+				components[k]->set_d(d);
+				break;
+			}
+		}
+	}
+}
+#endif // DOXYGEN_SHOULD_SKIP_THIS
 
 CGMM::CGMM() : CDistribution(), m_components(),	m_coefficients()
 {
@@ -125,71 +449,65 @@ float64_t CGMM::train_em(float64_t min_cov, int32_t max_iter, float64_t min_chan
 		SG_ERROR("No features to train on.\n")
 
 	CDotFeatures* dotdata=(CDotFeatures *) features;
-	int32_t num_vectors=dotdata->get_num_vectors();
-
-	SGMatrix<float64_t> alpha;
 
 	/* compute initialization via kmeans if none is present */
+	SGMatrix<float64_t> init_means;
 	if (m_components[0]->get_mean().vector==NULL)
 	{
 		CKMeans* init_k_means=new CKMeans(int32_t(m_components.size()), new CEuclideanDistance());
 		init_k_means->train(dotdata);
-		SGMatrix<float64_t> init_means=init_k_means->get_cluster_centers();
+		init_means=init_k_means->get_cluster_centers();
+		SG_UNREF(init_k_means);
+	}
 
-		alpha=alpha_init(init_means);
+	if (dotdata->get_feature_class()==C_DENSE && dotdata->get_feature_type()==F_SHORTREAL)
+		return train_em_blocks<float32_t>(init_means, min_cov, max_iter, min_change);
 
-		SG_UNREF(init_k_means);
+	return train_em_blocks<float64_t>(init_means, min_cov, max_iter, min_change);
+}
 
-		max_likelihood(alpha, min_cov);
+template <class T>
+float64_t CGMM::train_em_blocks(SGMatrix<float64_t> init_means,
+		float64_t min_cov, int32_t max_iter, float64_t min_change)
+{
+	CDotFeatures* dotdata=(CDotFeatures *) features;
+	const index_t num_dim=dotdata->get_dim_feature_space();
+	const index_t num_components=m_components.size();
+
+	/* each vector is assigned to the closest initial mean */
+	MatrixXd centers(num_dim, num_components);
+	if (init_means.matrix)
+	{
+		centers=Map<MatrixXd>(init_means.matrix, init_means.num_rows, init_means.num_cols);
+		EMStatistics statistics=em_pass<T>(dotdata, m_components, m_coefficients, centers, true);
+		em_update(statistics, m_components, m_coefficients, centers, min_cov);
 	}
-	else
-		alpha=SGMatrix<float64_t>(num_vectors,int32_t(m_components.size()));
 
 	int32_t iter=0;
 	float64_t log_likelihood_prev=0;
 	float64_t log_likelihood_cur=0;
-	SGVector<float64_t> logPxy(num_vectors * m_components.size());
-	SGVector<float64_t> logPx(num_vectors);
-	//float64_t* logPost=SG_MALLOC(float64_t, num_vectors*m_components.vlen);
 	auto pb = SG_PROGRESS(range(max_iter));
 	while (iter<max_iter)
 	{
-		log_likelihood_prev=log_likelihood_cur;
-		log_likelihood_cur=0;
-
-		for (int32_t i=0; i<num_vectors; i++)
+		for (index_t k=0; k<num_components; k++)
 		{
-			logPx[i]=0;
-			SGVector<float64_t> v=dotdata->get_computed_dot_feature_vector(i);
-			for (int32_t j=0; j<int32_t(m_components.size()); j++)
-			{
-				logPxy[index_t(i * m_components.size() + j)] =
-				    m_components[j]->compute_log_PDF(v) +
-				    std::log(m_coefficients[j]);
-				logPx[i] +=
-				    std::exp(logPxy[index_t(i * m_components.size() + j)]);
-			}
-
-			logPx[i] = std::log(logPx[i]);
-			log_likelihood_cur+=logPx[i];
-
-			for (int32_t j=0; j<int32_t(m_components.size()); j++)
-			{
-				//logPost[i*m_components.vlen+j]=logPxy[i*m_components.vlen+j]-logPx[i];
-				alpha.matrix[i * m_components.size() + j] = std::exp(
-				    logPxy[index_t(i * m_components.size() + j)] - logPx[i]);
-			}
+			SGVector<float64_t> mean=m_components[k]->get_mean();
+			centers.col(k)=Map<VectorXd>(mean.vector, mean.vlen);
 		}
 
+		EMStatistics statistics=em_pass<T>(dotdata, m_components, m_coefficients, centers, false);
+		log_likelihood_prev=log_likelihood_cur;
+		log_likelihood_cur=statistics.log_likelihood;
+
 		if (iter>0 && log_likelihood_cur-log_likelihood_prev<min_change)
 			break;
 		pb.print_progress();
-		max_likelihood(alpha, min_cov);
+		em_update(statistics, m_components, m_coefficients, centers, min_cov);
 
 		this->observe<float64_t>(
 		    iter, "log_likelihood", "Log Likelihood", log_likelihood_cur);
 		this->observe<SGVector<float64_t>>(
-		    iter, "coefficients", "Mixture Coefficients", alpha);
+		    iter, "coefficients", "Mixture Coefficients", m_coefficients);
 		this->observe<std::vector<CGaussian*>>(iter, "components");
 
 		iter++;
@@ -779,26 +1097,6 @@ void CGMM::set_comp(vector<CGaussian*> components)
 	}
 }
 
-SGMatrix<float64_t> CGMM::alpha_init(SGMatrix<float64_t> init_means)
-{
-	CDotFeatures* dotdata=(CDotFeatures *) features;
-	auto num_vectors=dotdata->get_num_vectors();
-
-	SGVector<float64_t> label_num(init_means.num_cols);
-	linalg::range_fill(label_num);
-
-	auto knn=some<CKNN>(1, new CEuclideanDistance(), new CMulticlassLabels(label_num));
-	knn->train(new CDenseFeatures<float64_t>(init_means));
-	auto init_labels = knn->apply(features)->as<CMulticlassLabels>();
-
-	SGMatrix<float64_t> alpha(num_vectors, index_t(m_components.size()));
-	for (auto i: range(num_vectors))
-		alpha[i * m_components.size() + init_labels->get_int_label(i)] = 1;
-
-	SG_UNREF(init_labels);
-	return alpha;
-}
-
 SGVector<float64_t> CGMM::sample()
 {
 	REQUIRE(m_components.size()>0, "Number of mixture components is %d but "
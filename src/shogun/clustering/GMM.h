@@ -27,6 +27,16 @@ namespace shogun
  * estimation.
  * The EM algorithm is described here:
  * http://en.wikipedia.org/wiki/Expectation-maximization_algorithm
+ *
+ * train_em() processes blocks of vectors in parallel. The log-densities
+ * of a block under a component with full covariance are computed with one
+ * matrix product of the block and the whitening transform of the
+ * component, which is obtained from its eigendecomposition. Each thread
+ * accumulates the weighted sums and second moments of its blocks, so
+ * neither the responsibilities of all vectors nor a second pass over the
+ * data are needed for the M-step. Dense float32 features are processed in
+ * single precision, the statistics are accumulated in double precision.
+ *
  * The SMEM algorithm is described here:
  * http://mlg.eng.cam.ac.uk/zoubin/papers/uedanc.pdf
  */
@@ -214,13 +224,19 @@ class CGMM : public CDistribution
 		virtual const char* get_name() const { return "GMM"; }
 
 	private:
-		/** 1NN assignment initialization
+		/** EM iterations on blocks of vectors, see train_em()
 		 *
-		 * @param init_means initial means
+		 * @param init_means means to assign vectors to for the initial
+		 * M-step, if the components have no means yet
+		 * @param min_cov minimum covariance
+		 * @param max_iter maximum iterations
+		 * @param min_change minimum change in log likelihood
 		 *
-		 * @return initial alphas
+		 * @return log likelihood of training data
 		 */
-		SGMatrix<float64_t> alpha_init(SGMatrix<float64_t> init_means);
+		template <class T>
+		float64_t train_em_blocks(SGMatrix<float64_t> init_means,
+				float64_t min_cov, int32_t max_iter, float64_t min_change);
 
 		/** Initialize parameters for serialization */
 		void register_params();
@@ -8,21 +8,241 @@
 #include <shogun/base/Parallel.h>
 #include <shogun/base/progress.h>
 #include <shogun/clustering/Hierarchical.h>
+#include <shogun/distance/BatchDistances.h>
 #include <shogun/distance/Distance.h>
+#include <shogun/distance/EuclideanDistance.h>
+#include <shogun/features/DenseFeatures.h>
 #include <shogun/features/Features.h>
 #include <shogun/labels/Labels.h>
 #include <shogun/mathematics/Math.h>
 
+#include <algorithm>
+
 using namespace shogun;
 
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
-struct pair
+/** vectors whose distances to one vector are computed as one batch */
+static const int32_t batch_size=1024;
+
+/** linkage of clusters from the n(n-1)/2 distances between them, updated
+ * with the Lance-Williams formulas
+ */
+class MatrixLinkage
+{
+public:
+	MatrixLinkage(CDistance* distance, int32_t num, ELinkage linkage)
+		: m_num(num), m_linkage(linkage), m_sizes(num)
+	{
+		m_sizes.set_const(1);
+		m_distances=SG_MALLOC(float64_t, int64_t(num)*(num-1)/2);
+
+		// the distances of every vector to the following ones are a batch
+		#pragma omp parallel for schedule(dynamic)
+		for (int32_t i=0; i<num-1; i++)
+			distance->distances_rhs(m_distances+index(i, i+1), i+1, num, i);
+	}
+
+	~MatrixLinkage()
+	{
+		SG_FREE(m_distances);
+	}
+
+	void distances(int32_t a, const SGVector<bool>& active, float64_t* result)
+	{
+		#pragma omp parallel for
+		for (int32_t s=0; s<m_num; s++)
+		{
+			if (active[s] && s!=a)
+				result[s]=get(a, s);
+		}
+	}
+
+	void merge(int32_t a, int32_t b, const SGVector<bool>& active)
+	{
+		const float64_t size_a=m_sizes[a];
+		const float64_t size_b=m_sizes[b];
+		const float64_t dist_ab=get(a, b);
+
+		// the merged cluster takes the place of b
+		#pragma omp parallel for
+		for (int32_t s=0; s<m_num; s++)
+		{
+			if (!active[s] || s==a || s==b)
+				continue;
+
+			const float64_t dist_as=get(a, s);
+			const float64_t dist_bs=get(b, s);
+			float64_t& dist=m_distances[s<b ? index(s, b) : index(b, s)];
+			switch (m_linkage)
+			{
+				case LINKAGE_SINGLE:
+					dist=CMath::min(dist_as, dist_bs);
+					break;
+				case LINKAGE_COMPLETE:
+					dist=CMath::max(dist_as, dist_bs);
+					break;
+				case LINKAGE_AVERAGE:
+					dist=(size_a*dist_as+size_b*dist_bs)/(size_a+size_b);
+					break;
+				case LINKAGE_WARD:
+				{
+					const float64_t size_s=m_sizes[s];
+					dist=CMath::sqrt(CMath::max(((size_a+size_s)*dist_as*dist_as+
+							(size_b+size_s)*dist_bs*dist_bs-size_s*dist_ab*dist_ab)/
+							(size_a+size_b+size_s), 0.0));
+					break;
+				}
+			}
+		}
+		m_sizes[b]+=m_sizes[a];
+	}
+
+private:
+	int64_t index(int32_t i, int32_t j) const
+	{
+		return int64_t(i)*m_num-int64_t(i)*(i+1)/2+j-i-1;
+	}
+
+	float64_t get(int32_t i, int32_t j) const
+	{
+		return i<j ? m_distances[index(i, j)] : m_distances[index(j, i)];
+	}
+
+	int32_t m_num;
+	ELinkage m_linkage;
+	SGVector<int32_t> m_sizes;
+	float64_t* m_distances;
+};
+
+/** Ward linkage of clusters from their centroids and sizes */
+class CentroidLinkage
 {
-	/** index 1 */
-	int32_t idx1;
-	/** index 2 */
-	int32_t idx2;
+public:
+	CentroidLinkage(SGMatrix<float64_t> features)
+		: m_centroids(features.clone()), m_sizes(features.num_cols)
+	{
+		m_sizes.set_const(1);
+	}
+
+	void distances(int32_t a, const SGVector<bool>& active, float64_t* result)
+	{
+		const int32_t dim=m_centroids.num_rows;
+		const int32_t num=m_centroids.num_cols;
+		const float64_t* centroid=m_centroids.get_column_vector(a);
+
+		#pragma omp parallel for schedule(dynamic)
+		for (int32_t start=0; start<num; start+=batch_size)
+		{
+			const int32_t stop=CMath::min(start+batch_size, num);
+			batch_distances<float64_t>(BM_SQUARED_EUCLIDEAN, centroid,
+					m_centroids.get_column_vector(start), dim, stop-start,
+					result+start);
+
+			for (int32_t s=start; s<stop; s++)
+			{
+				const float64_t size=float64_t(m_sizes[a])*m_sizes[s];
+				result[s]=CMath::sqrt(2*size/(m_sizes[a]+m_sizes[s])*result[s]);
+			}
+		}
+	}
+
+	void merge(int32_t a, int32_t b, const SGVector<bool>& active)
+	{
+		// the merged cluster takes the place of b
+		const float64_t size_a=m_sizes[a];
+		const float64_t size_b=m_sizes[b];
+		float64_t* centroid_a=m_centroids.get_column_vector(a);
+		float64_t* centroid_b=m_centroids.get_column_vector(b);
+		for (int32_t i=0; i<m_centroids.num_rows; i++)
+			centroid_b[i]=(size_a*centroid_a[i]+size_b*centroid_b[i])/(size_a+size_b);
+
+		m_sizes[b]+=m_sizes[a];
+	}
+
+private:
+	SGMatrix<float64_t> m_centroids;
+	SGVector<int32_t> m_sizes;
 };
+
+/** Nearest neighbour chain algorithm: follows nearest neighbours from any
+ * cluster until two clusters are reciprocal nearest neighbours, which are
+ * merged, and continues with the rest of the chain. Merges are found in
+ * the order of the chain, so they are sorted afterwards. progress() is
+ * called after every merge.
+ */
+template <class Linkage, class Progress>
+static void follow_chains(Linkage& linkage, int32_t num, int32_t* lhs,
+		int32_t* rhs, float64_t* dist, Progress progress)
+{
+	SGVector<bool> active(num);
+	active.set_const(true);
+	SGVector<int32_t> chain(num);
+	SGVector<float64_t> distances(num);
+	int32_t chain_len=0;
+	int32_t first=0;
+
+	for (int32_t l=0; l<num-1; l++)
+	{
+		if (!chain_len)
+		{
+			while (!active[first])
+				first++;
+			chain[chain_len++]=first;
+		}
+
+		int32_t a;
+		int32_t b;
+		float64_t d;
+		while (true)
+		{
+			a=chain[chain_len-1];
+			linkage.distances(a, active, distances.vector);
+
+			// ties are resolved in favour of the previous cluster in the
+			// chain, which prevents cycles
+			b=-1;
+			d=0;
+			if (chain_len>1)
+			{
+				b=chain[chain_len-2];
+				d=distances[b];
+			}
+			for (int32_t s=0; s<num; s++)
+			{
+				if (active[s] && s!=a && (b<0 || distances[s]<d))
+				{
+					b=s;
+					d=distances[s];
+				}
+			}
+
+			if (chain_len>1 && b==chain[chain_len-2])
+				break;
+
+			chain[chain_len++]=b;
+		}
+
+		chain_len-=2;
+		linkage.merge(a, b, active);
+		active[a]=false;
+
+		lhs[l]=a;
+		rhs[l]=b;
+		dist[l]=d;
+		progress();
+	}
+}
+
+/** root of the tree of vector i, halves the path */
+static int32_t find_root(int32_t* parent, int32_t i)
+{
+	while (parent[i]!=i)
+	{
+		parent[i]=parent[parent[i]];
+		i=parent[i];
+	}
+	return i;
+}
 #endif // DOXYGEN_SHOULD_SKIP_THIS
 
 CHierarchical::CHierarchical()
@@ -44,6 +264,7 @@ CHierarchical::CHierarchical(int32_t merges_, CDistance* d)
 void CHierarchical::init()
 {
 	merges = 3;
+	linkage = LINKAGE_SINGLE;
 	dimensions = 0;
 	assignment = NULL;
 	assignment_len = 0;
@@ -57,6 +278,10 @@ void CHierarchical::init()
 void CHierarchical::register_parameters()
 {
 	watch_param("merges", &merges);
+	SG_ADD_OPTIONS(
+	    (machine_int_t*)&linkage, "linkage", "Linkage of clusters",
+	    ParameterProperties::HYPER,
+	    SG_OPTIONS(LINKAGE_SINGLE, LINKAGE_COMPLETE, LINKAGE_AVERAGE, LINKAGE_WARD));
 	watch_param("dimensions", &dimensions);
 	watch_param("assignment", &assignment, &assignment_len);
 	watch_param("table_size", &table_size);
@@ -89,8 +314,6 @@ bool CHierarchical::train_machine(CFeatures* data)
 	int32_t num=lhs->get_num_vectors();
 	ASSERT(num>0)
 
-	const int32_t num_pairs=num*(num-1)/2;
-
 	SG_FREE(merge_distance);
 	merge_distance=SG_MALLOC(float64_t, num);
 	merge_distance_len=num;
@@ -103,78 +326,148 @@ bool CHierarchical::train_machine(CFeatures* data)
 
 	SG_FREE(pairs);
 	pairs=SG_MALLOC(int32_t, 2*num);
+	pairs_len=2*num;
 	SGVector<int32_t>::fill_vector(pairs, 2*num, -1);
 
-	pair* index=SG_MALLOC(pair, num_pairs);
-	float64_t* distances=SG_MALLOC(float64_t, num_pairs);
+	SGVector<int32_t> lhs_vectors(num);
+	SGVector<int32_t> rhs_vectors(num);
+	SGVector<float64_t> distances(num);
+
+	if (linkage==LINKAGE_SINGLE)
+		minimum_spanning_tree(num, lhs_vectors.vector, rhs_vectors.vector, distances.vector);
+	else
+		nearest_neighbor_chain(num, lhs_vectors.vector, rhs_vectors.vector, distances.vector);
+
+	store_merges(num, lhs_vectors.vector, rhs_vectors.vector, distances.vector);
+	ASSERT(table_size>0)
+	SG_UNREF(lhs)
+
+	return true;
+}
+
+void CHierarchical::compute_distances(int32_t idx, int32_t num, float64_t* result)
+{
+	#pragma omp parallel for schedule(dynamic)
+	for (int32_t start=0; start<num; start+=batch_size)
+		distance->distances_rhs(result+start, start, CMath::min(start+batch_size, num), idx);
+}
 
-	int32_t offs=0;
-	for (auto i : SG_PROGRESS(range(0, num)))
+void CHierarchical::minimum_spanning_tree(int32_t num, int32_t* lhs,
+		int32_t* rhs, float64_t* dist)
+{
+	// distance of every vector to the tree, and the tree vector it is
+	// closest to
+	SGVector<float64_t> nearest(num);
+	nearest.set_const(CMath::INFTY);
+	SGVector<int32_t> parent(num);
+	parent.set_const(0);
+	SGVector<bool> in_tree(num);
+	in_tree.set_const(false);
+	SGVector<float64_t> distances(num);
+
+	auto pb=SG_PROGRESS(range(0, num-1));
+	int32_t current=0;
+	for (int32_t l=0; l<num-1; l++)
 	{
-		for (int32_t j=i+1; j<num; j++)
+		in_tree[current]=true;
+		compute_distances(current, num, distances.vector);
+
+		int32_t next=-1;
+		for (int32_t i=0; i<num; i++)
 		{
-			distances[offs] = distance->distance(i, j);
-			index[offs].idx1 = i;
-			index[offs].idx2 = j;
-			offs++; // offs=i*(i+1)/2+j
+			if (in_tree[i])
+				continue;
+
+			if (distances[i]<nearest[i])
+			{
+				nearest[i]=distances[i];
+				parent[i]=current;
+			}
+			if (next<0 || nearest[i]<nearest[next])
+				next=i;
 		}
-	}
 
-	CMath::qsort_index<float64_t,pair>(distances, index, (num-1)*num/2);
-	//CMath::display_vector(distances, (num-1)*num/2, "dists");
+		lhs[l]=parent[next];
+		rhs[l]=next;
+		dist[l]=nearest[next];
+		current=next;
+		pb.print_progress();
+	}
+	pb.complete();
+}
 
-	auto pb = SG_PROGRESS(range(0, num_pairs - 1));
-	int32_t k=-1;
-	int32_t l=0;
-	for (; l<num && (num-l)>=merges && k<num_pairs-1; l++)
+void CHierarchical::nearest_neighbor_chain(int32_t num, int32_t* lhs,
+		int32_t* rhs, float64_t* dist)
+{
+	CFeatures* features=distance->get_lhs();
+	bool centroids=linkage==LINKAGE_WARD &&
+		distance->get_distance_type()==D_EUCLIDEAN &&
+		!((CEuclideanDistance*) distance)->get_disable_sqrt() &&
+		features->get_feature_class()==C_DENSE &&
+		features->get_feature_type()==F_DREAL &&
+		!features->get_subset_stack()->has_subsets();
+
+	SGMatrix<float64_t> matrix;
+	if (centroids)
 	{
-		while (k<num_pairs-1)
-		{
-			k++;
-
-			int32_t i=index[k].idx1;
-			int32_t j=index[k].idx2;
-			int32_t c1=assignment[i];
-			int32_t c2=assignment[j];
+		matrix=((CDenseFeatures<float64_t>*) features)->get_feature_matrix();
+		centroids=matrix.matrix!=NULL;
+	}
+	SG_UNREF(features);
 
-			if (c1==c2)
-				continue;
+	auto pb=SG_PROGRESS(range(0, num-1));
+	auto progress=[&pb]() { pb.print_progress(); };
+	if (centroids)
+	{
+		CentroidLinkage centroid_linkage(matrix);
+		follow_chains(centroid_linkage, num, lhs, rhs, dist, progress);
+	}
+	else
+	{
+		MatrixLinkage matrix_linkage(distance, num, linkage);
+		follow_chains(matrix_linkage, num, lhs, rhs, dist, progress);
+	}
+	pb.complete();
+}
 
-			pb.print_progress();
+void CHierarchical::store_merges(int32_t num, const int32_t* lhs,
+		const int32_t* rhs, const float64_t* dist)
+{
+	SGVector<index_t> order(num-1);
+	order.range_fill();
+	std::stable_sort(order.vector, order.vector+num-1,
+			[dist](index_t i, index_t j) { return dist[i]<dist[j]; });
 
-			if (c1<c2)
-			{
-				pairs[2*l]=c1;
-				pairs[2*l+1]=c2;
-			}
-			else
-			{
-				pairs[2*l]=c2;
-				pairs[2*l+1]=c1;
-			}
-			merge_distance[l]=distances[k];
+	// every tree of vectors is a cluster, with the id of its root
+	SGVector<int32_t> parent(num);
+	parent.range_fill();
+	SGVector<int32_t> cluster(num);
+	cluster.range_fill();
 
-			int32_t c=num+l;
-			for (int32_t m=0; m<num; m++)
-			{
-				if (assignment[m] == c1 || assignment[m] == c2)
-					assignment[m] = c;
-			}
+	int32_t l=0;
+	for (; l<num-1 && (num-l)>=merges; l++)
+	{
+		const index_t k=order[l];
+		const int32_t r1=find_root(parent.vector, lhs[k]);
+		const int32_t r2=find_root(parent.vector, rhs[k]);
+		const int32_t c1=cluster[r1];
+		const int32_t c2=cluster[r2];
+
+		pairs[2*l]=CMath::min(c1, c2);
+		pairs[2*l+1]=CMath::max(c1, c2);
+		merge_distance[l]=dist[k];
+
+		parent[r1]=r2;
+		cluster[r2]=num+l;
 #ifdef DEBUG_HIERARCHICAL
-			SG_PRINT("l=%04i i=%04i j=%04i c1=%+04d c2=%+04d c=%+04d dist=%6.6f\n", l,i,j, c1,c2,c, merge_distance[l])
+		SG_PRINT("l=%04i c1=%+04d c2=%+04d c=%+04d dist=%6.6f\n", l, c1, c2, num+l, merge_distance[l])
 #endif
-			break;
-		}
 	}
-	pb.complete();
 
-	table_size=l-1;
-	ASSERT(table_size>0)
-	SG_FREE(distances);
-	SG_FREE(index);
-	SG_UNREF(lhs)
+	for (int32_t m=0; m<num; m++)
+		assignment[m]=cluster[find_root(parent.vector, m)];
 
-	return true;
+	table_size=l-1;
 }
 
 bool CHierarchical::load(FILE* srcfile)
@@ -197,6 +490,16 @@ int32_t CHierarchical::get_merges()
 	return merges;
 }
 
+void CHierarchical::set_linkage(ELinkage l)
+{
+	linkage=l;
+}
+
+ELinkage CHierarchical::get_linkage() const
+{
+	return linkage;
+}
+
 SGVector<int32_t> CHierarchical::get_assignment()
 {
 	return SGVector<int32_t>(assignment,table_size, false);
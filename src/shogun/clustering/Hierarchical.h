@@ -19,19 +19,52 @@ namespace shogun
 {
 class CDistanceMachine;
 
-/** @brief Agglomerative hierarchical single linkage clustering.
+/** distance of two clusters in terms of the distances of their elements */
+enum ELinkage
+{
+	/** smallest distance of two elements */
+	LINKAGE_SINGLE,
+	/** largest distance of two elements */
+	LINKAGE_COMPLETE,
+	/** mean distance of the elements */
+	LINKAGE_AVERAGE,
+	/** Ward's criterion, i.e. the increase of the sum of squared Euclidean
+	 * distances to the cluster centroids
+	 */
+	LINKAGE_WARD
+};
+
+/** @brief Agglomerative hierarchical clustering.
  *
  * Starting with each object being assigned to its own cluster clusters are
- * iteratively merged.  Here the clusters are merged whose elements have
- * minimum distance, i.e.  the clusters A and B that obtain
+ * iteratively merged.  Here the clusters are merged that have minimum
+ * linkage, by default single linkage, i.e. the clusters A and B that obtain
  *
  * \f[
  * \min\{d({\bf x},{\bf x'}): {\bf x}\in {\cal A},{\bf x'}\in {\cal B}\}
  * \f]
  *
- * are merged.
+ * are merged. Complete and average linkage use the maximum and the mean of
+ * these distances, Ward linkage the distance
+ *
+ * \f[
+ * \sqrt{\frac{2|{\cal A}||{\cal B}|}{|{\cal A}|+|{\cal B}|}}
+ * \|{\bf c}_{\cal A}-{\bf c}_{\cal B}\|
+ * \f]
+ *
+ * of the centroids, which equals d for two single objects.
  *
- * cf e.g. http://en.wikipedia.org/wiki/Data_clustering*/
+ * Single linkage clustering is the minimum spanning tree of the objects,
+ * which is grown with Prim's algorithm while computing the distances of
+ * the newest tree node to all objects in parallel, O(n^2) time and O(n)
+ * memory. The other linkages use the nearest neighbour chain algorithm in
+ * O(n^2) time. Ward linkage of dense real valued features and Euclidean
+ * distance merges centroids, so it needs O(n) memory in addition to the
+ * features, the others keep the n(n-1)/2 distances between clusters.
+ *
+ * cf e.g. http://en.wikipedia.org/wiki/Data_clustering and
+ * D. Muellner, Modern hierarchical, agglomerative clustering algorithms,
+ * arXiv:1109.2378, 2011 */
 class CHierarchical : public CDistanceMachine
 {
 	public:
@@ -85,6 +118,18 @@ class CHierarchical : public CDistanceMachine
 		 */
 		int32_t get_merges();
 
+		/** set linkage
+		 *
+		 * @param linkage new linkage
+		 */
+		void set_linkage(ELinkage linkage);
+
+		/** get linkage
+		 *
+		 * @return linkage
+		 */
+		ELinkage get_linkage() const;
+
 		/** get assignment
 		 *
 		 */
@@ -131,10 +176,46 @@ class CHierarchical : public CDistanceMachine
 		/** Register all parameters (aka this class' attributes) */
 		void register_parameters();
 
+		/** computes the distances of vector idx to all num vectors in
+		 * parallel
+		 */
+		void compute_distances(int32_t idx, int32_t num, float64_t* result);
+
+		/** computes the minimum spanning tree with Prim's algorithm
+		 *
+		 * @param num number of vectors
+		 * @param lhs num-1 first vectors of the edges
+		 * @param rhs num-1 second vectors of the edges
+		 * @param dist num-1 lengths of the edges
+		 */
+		void minimum_spanning_tree(int32_t num, int32_t* lhs, int32_t* rhs,
+				float64_t* dist);
+
+		/** computes the merges of the nearest neighbour chain algorithm,
+		 * each as two vectors of the merged clusters
+		 *
+		 * @param num number of vectors
+		 * @param lhs num-1 vectors of the first clusters
+		 * @param rhs num-1 vectors of the second clusters
+		 * @param dist num-1 linkages of the clusters
+		 */
+		void nearest_neighbor_chain(int32_t num, int32_t* lhs, int32_t* rhs,
+				float64_t* dist);
+
+		/** stores the merges by increasing distance, as pairs of the
+		 * clusters that contain the given vectors, up to the number of
+		 * merges
+		 */
+		void store_merges(int32_t num, const int32_t* lhs, const int32_t* rhs,
+				const float64_t* dist);
+
 	protected:
 		/// the number of merges in hierarchical clustering
 		int32_t merges;
 
+		/// linkage
+		ELinkage linkage;
+
 		/// number of dimensions
 		int32_t dimensions;
 
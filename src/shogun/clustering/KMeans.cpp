@@ -71,74 +71,80 @@ void CKMeans::Lloyd_KMeans(SGMatrix<float64_t> centers, int32_t num_centers)
 		auto rhs_mus = some<CDenseFeatures<float64_t>>(centers.clone());
 		distance->replace_rhs(rhs_mus);
 
-#pragma omp parallel for firstprivate(lhs_size, dim, num_centers) \
+#pragma omp parallel firstprivate(lhs_size, dim, num_centers) \
 		shared(centers, cluster_assignments, weights_set) \
 		reduction(+:changed) if (!fixed_centers)
-		/* Assigment step : Assign each point to nearest cluster */
-		for (int32_t i=0; i<lhs_size; i++)
 		{
-			const int32_t cluster_assignments_i=cluster_assignments[i];
-			int32_t min_cluster, j;
-			float64_t min_dist, dist;
+			SGVector<float64_t> dists(num_centers);
 
-			min_cluster=0;
-		   	min_dist=distance->distance(i,0);
-			for (j=1; j<num_centers; j++)
+			/* Assigment step : Assign each point to nearest cluster */
+			#pragma omp for
+			for (int32_t i=0; i<lhs_size; i++)
 			{
-				dist=distance->distance(i,j);
-				if (dist<min_dist)
+				const int32_t cluster_assignments_i=cluster_assignments[i];
+				int32_t min_cluster, j;
+				float64_t min_dist;
+
+				/* distances to all centers in one batch */
+				distance->distances_rhs(dists.vector, 0, num_centers, i);
+				min_cluster=0;
+				min_dist=dists[0];
+				for (j=1; j<num_centers; j++)
 				{
-					min_dist=dist;
-					min_cluster=j;
+					if (dists[j]<min_dist)
+					{
+						min_dist=dists[j];
+						min_cluster=j;
+					}
 				}
-			}
 
-			if (min_cluster!=cluster_assignments_i)
-			{
-				changed++;
+				if (min_cluster!=cluster_assignments_i)
+				{
+					changed++;
 #pragma omp atomic
-				++weights_set[min_cluster];
+					++weights_set[min_cluster];
 #pragma omp atomic
-				--weights_set[cluster_assignments_i];
+					--weights_set[cluster_assignments_i];
 
-				if(fixed_centers)
-				{
-					SGVector<float64_t>vec=lhs->get_feature_vector(i);
-					float64_t temp_min = 1.0 / weights_set[min_cluster];
-
-					/* mu_new = mu_old + (x - mu_old)/(w) */
-					for (j=0; j<dim; j++)
+					if(fixed_centers)
 					{
-						centers(j, min_cluster)+=
-							(vec[j]-centers(j, min_cluster))*temp_min;
-					}
+						SGVector<float64_t>vec=lhs->get_feature_vector(i);
+						float64_t temp_min = 1.0 / weights_set[min_cluster];
 
-					lhs->free_feature_vector(vec, i);
+						/* mu_new = mu_old + (x - mu_old)/(w) */
+						for (j=0; j<dim; j++)
+						{
+							centers(j, min_cluster)+=
+								(vec[j]-centers(j, min_cluster))*temp_min;
+						}
 
-					/* mu_new = mu_old - (x - mu_old)/(w-1) */
-					/* if weights_set(j)~=0 */
-					if (weights_set[cluster_assignments_i]!=0)
-					{
-						float64_t temp_i = 1.0 / weights_set[cluster_assignments_i];
-						SGVector<float64_t>vec1=lhs->get_feature_vector(i);
+						lhs->free_feature_vector(vec, i);
 
-						for (j=0; j<dim; j++)
+						/* mu_new = mu_old - (x - mu_old)/(w-1) */
+						/* if weights_set(j)~=0 */
+						if (weights_set[cluster_assignments_i]!=0)
 						{
-							centers(j, cluster_assignments_i)-=
-								(vec1[j]-centers(j, cluster_assignments_i))*temp_i;
+							float64_t temp_i = 1.0 / weights_set[cluster_assignments_i];
+							SGVector<float64_t>vec1=lhs->get_feature_vector(i);
+
+							for (j=0; j<dim; j++)
+							{
+								centers(j, cluster_assignments_i)-=
+									(vec1[j]-centers(j, cluster_assignments_i))*temp_i;
+							}
+							lhs->free_feature_vector(vec1, i);
 						}
-						lhs->free_feature_vector(vec1, i);
-					}
-					else
-					{
-						/*  mus(:,j)=zeros(dim,1) ; */
-						for (j=0; j<dim; j++)
-							centers(j, cluster_assignments_i)=0;
+						else
+						{
+							/*  mus(:,j)=zeros(dim,1) ; */
+							for (j=0; j<dim; j++)
+								centers(j, cluster_assignments_i)=0;
+						}
+
 					}
 
+					cluster_assignments[i] = min_cluster;
 				}
-
-				cluster_assignments[i] = min_cluster;
 			}
 		}
 		if(changed==0)
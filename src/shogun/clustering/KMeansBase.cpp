@@ -10,6 +10,7 @@
 #include <shogun/labels/Labels.h>
 #include <shogun/features/DenseFeatures.h>
 #include <shogun/mathematics/Math.h>
+#include <shogun/mathematics/RandomStream.h>
 #include <shogun/base/Parallel.h>
 #include <shogun/mathematics/eigen3.h>
 #include <shogun/lib/observers/ObservedValueTemplated.h>
@@ -47,14 +48,23 @@ CKMeansBase::~CKMeansBase()
 
 void CKMeansBase::set_initial_centers(SGMatrix<float64_t> centers)
 {
-	CDenseFeatures<float64_t>* lhs=distance->get_lhs()->as<CDenseFeatures<float64_t>>();
-	dimensions=lhs->get_num_features();
 	REQUIRE(centers.num_cols == k,
 			"Expected %d initial cluster centers, got %d", k, centers.num_cols);
-	REQUIRE(centers.num_rows == dimensions,
-			"Expected %d dimensionional cluster centers, got %d", dimensions, centers.num_rows);
+
+	/* without lhs, e.g. when training on a stream, the dimension is checked
+	 * once the training data is known */
+	CFeatures* features=distance ? distance->get_lhs() : NULL;
+	if (features)
+	{
+		CDenseFeatures<float64_t>* lhs=features->as<CDenseFeatures<float64_t>>();
+		dimensions=lhs->get_num_features();
+		REQUIRE(centers.num_rows == dimensions,
+				"Expected %d dimensionional cluster centers, got %d", dimensions, centers.num_rows);
+	}
+	else
+		dimensions=centers.num_rows;
 	mus_initial = centers;
-	SG_UNREF(lhs);
+	SG_UNREF(features);
 }
 
 void CKMeansBase::set_random_centers()
@@ -173,6 +183,8 @@ void CKMeansBase::initialize_training(CFeatures* data)
 
 	if (mus_initial.matrix)
 	{
+		REQUIRE(mus_initial.num_rows == dimensions,
+				"Expected %d dimensionional cluster centers, got %d", dimensions, mus_initial.num_rows);
 		mus = mus_initial;
 		observe<SGMatrix<float64_t>>(0, "mus");
 	}
@@ -232,19 +244,21 @@ SGMatrix<float64_t> CKMeansBase::kmeanspp()
 	SGVector<float64_t> min_dist=SGVector<float64_t>(lhs_size);
 	min_dist.zero();
 
+	/* the initialization draws from its own stream, seeded once from the
+	 * global generator, so parallel callers do not share draws with it */
+	RandomStream stream(CMath::random());
+
 	/* First center is chosen at random */
-	int32_t mu=CMath::random((int32_t) 0, lhs_size-1);
+	int32_t mu=stream.random((index_t) 0, lhs_size-1);
 	SGVector<float64_t> mu_first=lhs->get_feature_vector(mu);
 	for(int32_t j=0; j<dimensions; j++)
 		centers(j, 0)=mu_first[j];
 
 	distance->precompute_lhs();
 	distance->precompute_rhs();
-#pragma omp parallel for \
-	default(none) shared(min_dist, mu, lhs_size) \
-	schedule(static, CPU_CACHE_LINE_SIZE_BYTES)
+	distances_lhs(min_dist, 0, lhs_size-1, mu);
 	for(int32_t i=0; i<lhs_size; i++)
-		min_dist[i]=CMath::sq(distance->distance(i, mu));
+		min_dist[i]=CMath::sq(min_dist[i]);
 #ifdef HAVE_LINALG
 	float64_t sum=linalg::vector_sum(min_dist);
 #else //HAVE_LINALG
@@ -264,10 +278,9 @@ SGMatrix<float64_t> CKMeansBase::kmeanspp()
 		for(int32_t trial=0; trial<n_rands; trial++)
 		{
 			float64_t temp_sum=0.0;
-			float64_t temp_dist=0.0;
 			SGVector<float64_t> temp_min_dist=SGVector<float64_t>(lhs_size);
 			int32_t new_center=0;
-			float64_t prob=CMath::random(0.0, 1.0);
+			float64_t prob=stream.random_half_open();
 			prob=prob*sum;
 
 			for(int32_t j=0; j<lhs_size; j++)
@@ -280,14 +293,9 @@ SGMatrix<float64_t> CKMeansBase::kmeanspp()
 				}
 			}
 
-#pragma omp parallel for default(none) \
-			private(temp_dist) shared(temp_min_dist, min_dist, lhs_size, new_center) \
-			schedule(static, CPU_CACHE_LINE_SIZE_BYTES)
+			distances_lhs(temp_min_dist, 0, lhs_size-1, new_center);
 			for(int32_t j=0; j<lhs_size; j++)
-			{
-				temp_dist=CMath::sq(distance->distance(j, new_center));
-				temp_min_dist[j]=CMath::min(temp_dist, min_dist[j]);
-			}
+				temp_min_dist[j]=CMath::min(CMath::sq(temp_min_dist[j]), min_dist[j]);
 
 #ifdef HAVE_LINALG
 			temp_sum=linalg::vector_sum(temp_min_dist);
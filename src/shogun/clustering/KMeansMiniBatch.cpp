@@ -8,6 +8,7 @@
 #include <shogun/clustering/KMeansMiniBatch.h>
 #include <shogun/distance/Distance.h>
 #include <shogun/features/DenseFeatures.h>
+#include <shogun/features/streaming/StreamingDenseFeatures.h>
 #include <shogun/mathematics/Math.h>
 #include <shogun/lib/observers/ObservedValueTemplated.h>
 
@@ -54,7 +55,6 @@ void CKMeansMiniBatch::minibatch_KMeans()
 	auto rhs_mus=some<CDenseFeatures<float64_t>>(mus);
 	CFeatures* rhs_cache=distance->replace_rhs(rhs_mus);
 	int32_t XSize=lhs->get_num_vectors();
-	int32_t dims=lhs->get_num_features();
 
 	SGVector<float64_t> v=SGVector<float64_t>(k);
 	v.zero();
@@ -62,42 +62,99 @@ void CKMeansMiniBatch::minibatch_KMeans()
 	for (auto i : SG_PROGRESS(range(max_iter)))
 	{
 		SGVector<int32_t> M=mbchoose_rand(batch_size,XSize);
-		SGVector<int32_t> ncent=SGVector<int32_t>(batch_size);
-		for (int32_t j=0; j<batch_size; j++)
+		update_centers(M, lhs, rhs_mus, v);
+		mus = rhs_mus->get_feature_matrix();
+		observe<SGMatrix<float64_t>>(i, "mus");
+	}
+	SG_UNREF(lhs);
+	distance->replace_rhs(rhs_cache);
+}
+
+void CKMeansMiniBatch::streaming_minibatch_KMeans(
+	CStreamingDenseFeatures<float64_t>* features)
+{
+	REQUIRE(batch_size>0,
+		"batch size not set to positive value. Current batch size %d \n", batch_size);
+
+	features->start_parser();
+
+	/* the first batch initialises the centers like a non-streaming
+	 * training set would */
+	auto batch=some<CDenseFeatures<float64_t>>(
+		features->get_next_batch(batch_size));
+	REQUIRE(batch->get_num_vectors()>=k,
+		"First batch has %d examples, at least k=%d are needed to "
+		"initialise the centers\n", batch->get_num_vectors(), k);
+	initialize_training(batch);
+
+	auto rhs_mus=some<CDenseFeatures<float64_t>>(mus);
+	SGVector<float64_t> v=SGVector<float64_t>(k);
+	v.zero();
+
+	for (auto i : SG_PROGRESS(range(max_iter)))
+	{
+		if (i>0)
 		{
-			SGVector<float64_t> dists=SGVector<float64_t>(k);
-			for (int32_t p=0; p<k; p++)
-				dists[p]=distance->distance(M[j],p);
+			SGMatrix<float64_t> next=features->get_next_batch(batch_size);
+			if (!next.num_cols)
+				break;
+
+			REQUIRE(next.num_rows==dimensions,
+				"Dimension of streamed examples (%d) does not match "
+				"dimension of the centers (%d)\n", next.num_rows, dimensions);
+			batch=some<CDenseFeatures<float64_t>>(next);
+		}
 
-			int32_t imin=0;
-			float64_t min=dists[0];
-			for (int32_t p=1; p<k; p++)
+		/* every example of a batch is used exactly once */
+		SGVector<int32_t> M(batch->get_num_vectors());
+		M.range_fill();
+		distance->init(batch, rhs_mus);
+		update_centers(M, batch, rhs_mus, v);
+		mus = rhs_mus->get_feature_matrix();
+		observe<SGMatrix<float64_t>>(i, "mus");
+	}
+
+	features->end_parser();
+	distance->init(batch, batch);
+}
+
+void CKMeansMiniBatch::update_centers(SGVector<int32_t> chosen,
+	CDenseFeatures<float64_t>* lhs, CDenseFeatures<float64_t>* rhs_mus,
+	SGVector<float64_t> v)
+{
+	int32_t dims=lhs->get_num_features();
+
+	SGVector<int32_t> ncent=SGVector<int32_t>(chosen.vlen);
+	for (int32_t j=0; j<chosen.vlen; j++)
+	{
+		SGVector<float64_t> dists=SGVector<float64_t>(k);
+		for (int32_t p=0; p<k; p++)
+			dists[p]=distance->distance(chosen[j],p);
+
+		int32_t imin=0;
+		float64_t min=dists[0];
+		for (int32_t p=1; p<k; p++)
+		{
+			if (dists[p]<min)
 			{
-				if (dists[p]<min)
-				{
-					imin=p;
-					min=dists[p];
-				}
+				imin=p;
+				min=dists[p];
 			}
-			ncent[j]=imin;
 		}
-		for (int32_t j=0; j<batch_size; j++)
+		ncent[j]=imin;
+	}
+	for (int32_t j=0; j<chosen.vlen; j++)
+	{
+		int32_t near=ncent[j];
+		SGVector<float64_t> c_alive=rhs_mus->get_feature_vector(near);
+		SGVector<float64_t> x=lhs->get_feature_vector(chosen[j]);
+		v[near]+=1.0;
+		float64_t eta=1.0/v[near];
+		for (int32_t c=0; c<dims; c++)
 		{
-			int32_t near=ncent[j];
-			SGVector<float64_t> c_alive=rhs_mus->get_feature_vector(near);
-			SGVector<float64_t> x=lhs->get_feature_vector(M[j]);
-			v[near]+=1.0;
-			float64_t eta=1.0/v[near];
-			for (int32_t c=0; c<dims; c++)
-			{
-				c_alive[c]=(1.0-eta)*c_alive[c]+eta*x[c];
-			}
+			c_alive[c]=(1.0-eta)*c_alive[c]+eta*x[c];
 		}
-		mus = rhs_mus->get_feature_matrix();
-		observe<SGMatrix<float64_t>>(i, "mus");
 	}
-	SG_UNREF(lhs);
-	distance->replace_rhs(rhs_cache);
 }
 
 SGVector<int32_t> CKMeansMiniBatch::mbchoose_rand(int32_t b, int32_t num)
@@ -129,8 +186,19 @@ void CKMeansMiniBatch::init_mb_params()
 
 bool CKMeansMiniBatch::train_machine(CFeatures* data)
 {
-	initialize_training(data);
-	minibatch_KMeans();
+	if (data && data->get_feature_class()==C_STREAMING_DENSE)
+	{
+		REQUIRE(data->get_feature_type()==F_DREAL,
+			"Streaming features must be of type REAL (%d), got %d\n",
+			F_DREAL, data->get_feature_type());
+		streaming_minibatch_KMeans(
+			data->as<CStreamingDenseFeatures<float64_t>>());
+	}
+	else
+	{
+		initialize_training(data);
+		minibatch_KMeans();
+	}
 	compute_cluster_variances();
 	return true;
 }
@@ -18,6 +18,8 @@
 namespace shogun
 {
 class CKMeansBase;
+template <class T> class CDenseFeatures;
+template <class T> class CStreamingDenseFeatures;
 	
 /** Class for the mini batch KMeans */
 class CKMeansMiniBatch : public CKMeansBase
@@ -55,7 +57,9 @@ class CKMeansMiniBatch : public CKMeansBase
 		 *
 		 * @param data training data (parameter can be avoided if distance or
 		 * kernel-based classifiers are used and distance/kernels are
-		 * initialized with train data)
+		 * initialized with train data). Streaming dense features are
+		 * consumed in mini-batches of batch_size examples, one batch per
+		 * iteration, until the stream ends or max_iter is reached.
 		 *
 		 * @return whether training was successful
 		 */
@@ -65,6 +69,14 @@ class CKMeansMiniBatch : public CKMeansBase
 		 */
 		void minibatch_KMeans();
 
+		/** mini-batch KMeans on a stream, the centers are initialised
+		 * from the first batch
+		 *
+		 * @param features stream of dense examples
+		 */
+		void streaming_minibatch_KMeans(
+			CStreamingDenseFeatures<float64_t>* features);
+
 	private:
 
 		void init_mb_params();
@@ -74,6 +86,13 @@ class CKMeansMiniBatch : public CKMeansBase
 		 */
 		SGVector<int32_t> mbchoose_rand(int32_t b, int32_t num);
 
+		/* assign the chosen examples of the distance's lhs to their
+		 * nearest center and move the centers towards them. v counts the
+		 * examples assigned to each center so far */
+		void update_centers(SGVector<int32_t> chosen,
+			CDenseFeatures<float64_t>* lhs,
+			CDenseFeatures<float64_t>* rhs_mus, SGVector<float64_t> v);
+
 	protected:
 
 		/** Batch size for mini-batch KMeans */
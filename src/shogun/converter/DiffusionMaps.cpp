@@ -75,6 +75,7 @@ CFeatures* CDiffusionMaps::transform(CFeatures* features, bool inplace)
 CDenseFeatures<float64_t>* CDiffusionMaps::embed_distance(CDistance* distance)
 {
 	TAPKEE_PARAMETERS_FOR_SHOGUN parameters;
+	init_tapkee_parameters(parameters);
 	parameters.n_timesteps = m_t;
 	parameters.gaussian_kernel_width = m_width;
 	parameters.method = SHOGUN_DIFFUSION_MAPS;
@@ -8,6 +8,7 @@
 #include <shogun/converter/EmbeddingConverter.h>
 #include <shogun/kernel/LinearKernel.h>
 #include <shogun/distance/EuclideanDistance.h>
+#include <shogun/lib/tapkee/tapkee_shogun.hpp>
 
 using namespace shogun;
 
@@ -21,6 +22,9 @@ CEmbeddingConverter::CEmbeddingConverter()
 	SG_REF(m_distance);
 	m_kernel = new CLinearKernel();
 	SG_REF(m_kernel);
+	m_neighbors_method = NEIGHBORS_EXACT;
+	m_eigen_method = EMBEDDING_EIGEN_AUTO;
+	m_shared_neighbors = false;
 
 	init();
 }
@@ -68,6 +72,48 @@ CKernel* CEmbeddingConverter::get_kernel() const
 	return m_kernel;
 }
 
+void CEmbeddingConverter::set_neighbors_method(ENeighborsMethod method)
+{
+	m_neighbors_method = method;
+}
+
+ENeighborsMethod CEmbeddingConverter::get_neighbors_method() const
+{
+	return m_neighbors_method;
+}
+
+void CEmbeddingConverter::set_eigen_method(EEmbeddingEigenMethod method)
+{
+	m_eigen_method = method;
+}
+
+EEmbeddingEigenMethod CEmbeddingConverter::get_eigen_method() const
+{
+	return m_eigen_method;
+}
+
+void CEmbeddingConverter::set_neighbors(SGMatrix<index_t> neighbors)
+{
+	m_neighbors = neighbors;
+	m_shared_neighbors = (neighbors.num_cols>0);
+}
+
+SGMatrix<index_t> CEmbeddingConverter::get_neighbors() const
+{
+	return m_neighbors;
+}
+
+void CEmbeddingConverter::init_tapkee_parameters(TAPKEE_PARAMETERS_FOR_SHOGUN& parameters)
+{
+	// a graph computed by a previous transform might belong to other data
+	if (!m_shared_neighbors)
+		m_neighbors = SGMatrix<index_t>();
+
+	parameters.neighbors_method = m_neighbors_method;
+	parameters.neighbors = &m_neighbors;
+	parameters.eigen_method = m_eigen_method;
+}
+
 void CEmbeddingConverter::init()
 {
 	SG_ADD(&m_target_dim, "target_dim",
@@ -77,5 +123,13 @@ void CEmbeddingConverter::init()
 		ParameterProperties::HYPER);
 	SG_ADD(
 		&m_kernel, "kernel", "kernel to be used for embedding", ParameterProperties::HYPER);
+	SG_ADD_OPTIONS(
+		(machine_int_t*)&m_neighbors_method, "neighbors_method",
+		"neighbors search method", ParameterProperties::NONE,
+		SG_OPTIONS(NEIGHBORS_EXACT, NEIGHBORS_BRUTE_FORCE, NEIGHBORS_NN_DESCENT));
+	SG_ADD_OPTIONS(
+		(machine_int_t*)&m_eigen_method, "eigen_method", "eigensolver",
+		ParameterProperties::NONE,
+		SG_OPTIONS(EMBEDDING_EIGEN_AUTO, EMBEDDING_EIGEN_DENSE, EMBEDDING_EIGEN_RANDOMIZED));
 }
 }
@@ -21,6 +21,31 @@ namespace shogun
 class CFeatures;
 class CDistance;
 class CKernel;
+struct TAPKEE_PARAMETERS_FOR_SHOGUN;
+
+/** neighbors search methods of the converters based on a neighbors graph */
+enum ENeighborsMethod
+{
+	/** exact search with a cover tree if available, a vantage point tree
+	 * otherwise */
+	NEIGHBORS_EXACT,
+	/** exact search by sorting all distances, for debugging */
+	NEIGHBORS_BRUTE_FORCE,
+	/** approximate search by NN-descent, for large data sets */
+	NEIGHBORS_NN_DESCENT
+};
+
+/** eigensolvers of the spectral converters */
+enum EEmbeddingEigenMethod
+{
+	/** ARPACK if available, dense eigendecomposition otherwise */
+	EMBEDDING_EIGEN_AUTO,
+	/** dense eigendecomposition of the whole matrix */
+	EMBEDDING_EIGEN_DENSE,
+	/** randomized block Krylov method, only needs matrix products and
+	 * scales to large sparse problems */
+	EMBEDDING_EIGEN_RANDOMIZED
+};
 
 /** @brief class EmbeddingConverter (part of the Efficient Dimensionality
  * Reduction Toolkit) used to construct embeddings of
@@ -73,6 +98,44 @@ public:
 	 */
 	CKernel* get_kernel() const;
 
+	/** setter for the neighbors search method, only used by converters
+	 * based on a neighbors graph
+	 * @param method neighbors search method
+	 */
+	void set_neighbors_method(ENeighborsMethod method);
+
+	/** getter for the neighbors search method
+	 * @return neighbors search method
+	 */
+	ENeighborsMethod get_neighbors_method() const;
+
+	/** setter for the eigensolver, only used by spectral converters
+	 * @param method eigensolver
+	 */
+	void set_eigen_method(EEmbeddingEigenMethod method);
+
+	/** getter for the eigensolver
+	 * @return eigensolver
+	 */
+	EEmbeddingEigenMethod get_eigen_method() const;
+
+	/** setter for a precomputed neighbors graph, e.g. the one of another
+	 * converter applied to the same features with the same distance.
+	 * The graph is used instead of a neighbors search as long as it has
+	 * the number of neighbors and vectors the transform requires, and is
+	 * replaced by a search result otherwise. An empty matrix enables the
+	 * search again.
+	 * @param neighbors indices of the neighbors of every vector
+	 * (number of neighbors x number of vectors)
+	 */
+	void set_neighbors(SGMatrix<index_t> neighbors);
+
+	/** getter for the neighbors graph used by the last transform
+	 * @return indices of the neighbors of every vector, empty if the last
+	 * transform did not need them
+	 */
+	SGMatrix<index_t> get_neighbors() const;
+
 	virtual const char* get_name() const { return "EmbeddingConverter"; };
 
 protected:
@@ -80,6 +143,11 @@ protected:
 	/** default init */
 	void init();
 
+	/** passes the settings common to all converters to tapkee
+	 * @param parameters parameters of the embedding
+	 */
+	void init_tapkee_parameters(TAPKEE_PARAMETERS_FOR_SHOGUN& parameters);
+
 protected:
 
 	/** target dim of dimensionality reduction preprocessor */
@@ -90,6 +158,18 @@ protected:
 
 	/** kernel to be used */
 	CKernel* m_kernel;
+
+	/** neighbors search method */
+	ENeighborsMethod m_neighbors_method;
+
+	/** eigensolver */
+	EEmbeddingEigenMethod m_eigen_method;
+
+	/** neighbors graph, given or computed by the last transform */
+	SGMatrix<index_t> m_neighbors;
+
+	/** whether m_neighbors was given and has to be reused */
+	bool m_shared_neighbors;
 };
 }
 
@@ -32,6 +32,7 @@ CLocalityPreservingProjections::transform(CFeatures* features, bool inplace)
 	TAPKEE_PARAMETERS_FOR_SHOGUN parameters;
 	m_distance->init(features,features);
 	parameters.n_neighbors = m_k;
+	init_tapkee_parameters(parameters);
 	parameters.gaussian_kernel_width = m_tau;
 	parameters.method = SHOGUN_LOCALITY_PRESERVING_PROJECTIONS;
 	parameters.target_dimension = m_target_dim;
@@ -76,6 +76,7 @@ const char* CMultidimensionalScaling::get_name() const
 CDenseFeatures<float64_t>* CMultidimensionalScaling::embed_distance(CDistance* distance)
 {
 	TAPKEE_PARAMETERS_FOR_SHOGUN parameters;
+	init_tapkee_parameters(parameters);
 	if (m_landmark)
 	{
 		parameters.method = SHOGUN_LANDMARK_MULTIDIMENSIONAL_SCALING;
@@ -33,6 +33,7 @@ CNeighborhoodPreservingEmbedding::transform(CFeatures* features, bool inplace)
 	CKernel* kernel = new CLinearKernel((CDotFeatures*)features,(CDotFeatures*)features);
 	TAPKEE_PARAMETERS_FOR_SHOGUN parameters;
 	parameters.n_neighbors = m_k;
+	init_tapkee_parameters(parameters);
 	parameters.eigenshift = m_nullspace_shift;
 	parameters.method = SHOGUN_NEIGHBORHOOD_PRESERVING_EMBEDDING;
 	parameters.target_dimension = m_target_dim;
@@ -137,6 +137,7 @@ CDenseFeatures< float64_t >* CStochasticProximityEmbedding::embed_distance(CDist
 {
 	TAPKEE_PARAMETERS_FOR_SHOGUN parameters;
 	parameters.n_neighbors = m_k;
+	init_tapkee_parameters(parameters);
 	parameters.method = SHOGUN_STOCHASTIC_PROXIMITY_EMBEDDING;
 	parameters.target_dimension = m_target_dim;
 	parameters.spe_num_updates = m_nupdates;
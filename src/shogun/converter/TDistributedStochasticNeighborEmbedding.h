@@ -64,6 +64,21 @@ public:
 	 */
 	float64_t get_perplexity() const;
 
+	/** setter for interpolation. If enabled, the repulsive forces are
+	 * computed by FFT-accelerated interpolation on a grid instead of
+	 * Barnes-Hut, which is faster for large numbers of vectors. Only
+	 * used for 2D embeddings with theta > 0.
+	 *
+	 * @param interpolation whether to use interpolation
+	 */
+	void set_interpolation(const bool interpolation);
+
+	/** getter for interpolation
+	 *
+	 * @return whether interpolation is used
+	 */
+	bool get_interpolation() const;
+
 private:
 
 	/** default init */
@@ -77,6 +92,9 @@ private:
 	/** perplexity */
 	float64_t m_perplexity;
 
+	/** whether to compute repulsive forces by interpolation */
+	bool m_interpolation;
+
 }; /* class CTDistributedStochasticNeighborEmbedding */
 
 } /* namespace shogun */
@@ -0,0 +1,287 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: agent
+ */
+
+#include <shogun/base/macros.h>
+#include <shogun/distance/BatchDistances.h>
+#include <shogun/features/DenseFeatures.h>
+#include <shogun/io/SGIO.h>
+
+#include <algorithm>
+#include <cmath>
+
+using namespace shogun;
+
+/* the loops over the dimensions are reductions the compiler may reorder,
+ * the kernels are forced inline so that they are compiled for the
+ * instruction set of every entry point below */
+template <class T, EBatchMetric M>
+static SG_FORCED_INLINE void compute_batch(const T* x, const T* vectors,
+		index_t dim, index_t num_vectors, float64_t* result)
+{
+	T x_sq=0;
+	if (M==BM_COSINE)
+	{
+		#pragma omp simd reduction(+:x_sq)
+		for (index_t i=0; i<dim; i++)
+			x_sq+=x[i]*x[i];
+	}
+
+	for (index_t j=0; j<num_vectors; j++)
+	{
+		const T* y=vectors+int64_t(j)*dim;
+		T s1=0;
+		T s2=0;
+
+		switch (M)
+		{
+			case BM_DOT:
+				#pragma omp simd reduction(+:s1)
+				for (index_t i=0; i<dim; i++)
+					s1+=x[i]*y[i];
+				result[j]=s1;
+				break;
+			case BM_SQUARED_EUCLIDEAN:
+				#pragma omp simd reduction(+:s1)
+				for (index_t i=0; i<dim; i++)
+				{
+					const T diff=x[i]-y[i];
+					s1+=diff*diff;
+				}
+				result[j]=s1;
+				break;
+			case BM_MANHATTAN:
+				#pragma omp simd reduction(+:s1)
+				for (index_t i=0; i<dim; i++)
+					s1+=std::abs(x[i]-y[i]);
+				result[j]=s1;
+				break;
+			case BM_CHEBYSHEV:
+				#pragma omp simd reduction(max:s1)
+				for (index_t i=0; i<dim; i++)
+					s1=std::max(s1, std::abs(x[i]-y[i]));
+				result[j]=s1;
+				break;
+			case BM_COSINE:
+			{
+				#pragma omp simd reduction(+:s1,s2)
+				for (index_t i=0; i<dim; i++)
+				{
+					s1+=x[i]*y[i];
+					s2+=y[i]*y[i];
+				}
+				const float64_t norms=std::sqrt(float64_t(x_sq))*std::sqrt(float64_t(s2));
+				result[j]=norms==0 ? 0 : std::max(1-s1/norms, 0.0);
+				break;
+			}
+			case BM_CHI_SQUARE:
+				#pragma omp simd reduction(+:s1)
+				for (index_t i=0; i<dim; i++)
+				{
+					const T diff=x[i]-y[i];
+					const T sum=std::abs(x[i])+std::abs(y[i]);
+					s1+=sum!=0 ? diff*diff/sum : T(0);
+				}
+				result[j]=s1;
+				break;
+			case BM_BRAY_CURTIS:
+				#pragma omp simd reduction(+:s1,s2)
+				for (index_t i=0; i<dim; i++)
+				{
+					s1+=std::abs(x[i]-y[i]);
+					s2+=std::abs(x[i]+y[i]);
+				}
+				result[j]=s2==0 ? 0 : float64_t(s1)/s2;
+				break;
+			case BM_CANBERRA:
+				#pragma omp simd reduction(+:s1)
+				for (index_t i=0; i<dim; i++)
+				{
+					const T sum=std::abs(x[i])+std::abs(y[i]);
+					s1+=sum!=0 ? std::abs(x[i]-y[i])/sum : T(0);
+				}
+				result[j]=s1;
+				break;
+			case BM_NONE:
+				break;
+		}
+	}
+}
+
+template <class T>
+static SG_FORCED_INLINE void dispatch_metric(EBatchMetric metric,
+		const T* x, const T* vectors, index_t dim, index_t num_vectors,
+		float64_t* result)
+{
+	switch (metric)
+	{
+		case BM_DOT:
+			compute_batch<T, BM_DOT>(x, vectors, dim, num_vectors, result);
+			break;
+		case BM_SQUARED_EUCLIDEAN:
+			compute_batch<T, BM_SQUARED_EUCLIDEAN>(x, vectors, dim, num_vectors, result);
+			break;
+		case BM_MANHATTAN:
+			compute_batch<T, BM_MANHATTAN>(x, vectors, dim, num_vectors, result);
+			break;
+		case BM_CHEBYSHEV:
+			compute_batch<T, BM_CHEBYSHEV>(x, vectors, dim, num_vectors, result);
+			break;
+		case BM_COSINE:
+			compute_batch<T, BM_COSINE>(x, vectors, dim, num_vectors, result);
+			break;
+		case BM_CHI_SQUARE:
+			compute_batch<T, BM_CHI_SQUARE>(x, vectors, dim, num_vectors, result);
+			break;
+		case BM_BRAY_CURTIS:
+			compute_batch<T, BM_BRAY_CURTIS>(x, vectors, dim, num_vectors, result);
+			break;
+		case BM_CANBERRA:
+			compute_batch<T, BM_CANBERRA>(x, vectors, dim, num_vectors, result);
+			break;
+		case BM_NONE:
+			break;
+	}
+}
+
+template <class T>
+static void batch_distances_default(EBatchMetric metric, const T* x,
+		const T* vectors, index_t dim, index_t num_vectors, float64_t* result)
+{
+	dispatch_metric<T>(metric, x, vectors, dim, num_vectors, result);
+}
+
+#ifdef HAVE_CPU_DISPATCH
+template <class T>
+__attribute__((target("avx2,fma")))
+static void batch_distances_avx2(EBatchMetric metric, const T* x,
+		const T* vectors, index_t dim, index_t num_vectors, float64_t* result)
+{
+	dispatch_metric<T>(metric, x, vectors, dim, num_vectors, result);
+}
+
+template <class T>
+__attribute__((target("avx512f,avx512dq")))
+static void batch_distances_avx512(EBatchMetric metric, const T* x,
+		const T* vectors, index_t dim, index_t num_vectors, float64_t* result)
+{
+	dispatch_metric<T>(metric, x, vectors, dim, num_vectors, result);
+}
+#endif
+
+/* instruction sets of the entry points */
+enum EBatchISA
+{
+	BATCH_DEFAULT,
+	BATCH_AVX2,
+	BATCH_AVX512
+};
+
+static EBatchISA detect_isa()
+{
+#ifdef HAVE_CPU_DISPATCH
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512dq"))
+		return BATCH_AVX512;
+	if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+		return BATCH_AVX2;
+#endif
+	return BATCH_DEFAULT;
+}
+
+static EBatchISA get_isa()
+{
+	static const EBatchISA isa=detect_isa();
+	return isa;
+}
+
+template <class T>
+void shogun::batch_distances(EBatchMetric metric, const T* vector,
+		const T* vectors, index_t dim, index_t num_vectors, float64_t* result)
+{
+	switch (get_isa())
+	{
+#ifdef HAVE_CPU_DISPATCH
+		case BATCH_AVX512:
+			batch_distances_avx512<T>(metric, vector, vectors, dim, num_vectors, result);
+			break;
+		case BATCH_AVX2:
+			batch_distances_avx2<T>(metric, vector, vectors, dim, num_vectors, result);
+			break;
+#endif
+		default:
+			batch_distances_default<T>(metric, vector, vectors, dim, num_vectors, result);
+	}
+}
+
+template <class T>
+static bool batch_dense_distances(EBatchMetric metric, CFeatures* many,
+		int32_t start, int32_t stop, CFeatures* one, int32_t idx,
+		float64_t* result)
+{
+	auto many_features=(CDenseFeatures<T>*) many;
+	auto one_features=(CDenseFeatures<T>*) one;
+	if (many_features->get_subset_stack()->has_subsets())
+		return false;
+
+	SGMatrix<T> matrix=many_features->get_feature_matrix();
+	if (!matrix.matrix)
+		return false;
+
+	REQUIRE(start>=0 && start<=stop && stop<=matrix.num_cols,
+			"Range [%d, %d) must lie in [0, %d)\n", start, stop, matrix.num_cols);
+	REQUIRE(idx>=0 && idx<one_features->get_num_vectors(),
+			"Index (%d) must be in [0, %d)\n", idx, one_features->get_num_vectors());
+
+	int32_t len;
+	bool do_free;
+	T* vector=one_features->get_feature_vector(idx, len, do_free);
+	REQUIRE(len==matrix.num_rows, "Dimensions (%d and %d) must match\n",
+			len, matrix.num_rows);
+
+	batch_distances<T>(metric, vector, matrix.matrix+int64_t(start)*len,
+			len, stop-start, result);
+
+	one_features->free_feature_vector(vector, idx, do_free);
+	return true;
+}
+
+bool shogun::batch_distances(EBatchMetric metric, CFeatures* many,
+		int32_t start, int32_t stop, CFeatures* one, int32_t idx,
+		float64_t* result)
+{
+	if (metric==BM_NONE || !many || !one ||
+			many->get_feature_class()!=C_DENSE || one->get_feature_class()!=C_DENSE ||
+			many->get_feature_type()!=one->get_feature_type())
+		return false;
+
+	switch (many->get_feature_type())
+	{
+		case F_SHORTREAL:
+			return batch_dense_distances<float32_t>(metric, many, start, stop, one, idx, result);
+		case F_DREAL:
+			return batch_dense_distances<float64_t>(metric, many, start, stop, one, idx, result);
+		default:
+			return false;
+	}
+}
+
+const char* shogun::get_batch_distances_isa()
+{
+	switch (get_isa())
+	{
+		case BATCH_AVX512:
+			return "avx512";
+		case BATCH_AVX2:
+			return "avx2";
+		default:
+			return "default";
+	}
+}
+
+template void shogun::batch_distances<float32_t>(EBatchMetric, const float32_t*,
+		const float32_t*, index_t, index_t, float64_t*);
+template void shogun::batch_distances<float64_t>(EBatchMetric, const float64_t*,
+		const float64_t*, index_t, index_t, float64_t*);
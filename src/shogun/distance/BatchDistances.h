@@ -0,0 +1,83 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: agent
+ */
+
+#ifndef _BATCHDISTANCES_H___
+#define _BATCHDISTANCES_H___
+
+#include <shogun/lib/config.h>
+
+#include <shogun/lib/common.h>
+
+namespace shogun
+{
+
+class CFeatures;
+
+/** metrics with batched kernels */
+enum EBatchMetric
+{
+	/** no batched kernel */
+	BM_NONE,
+	/** dot product, e.g. for distances from precomputed norms */
+	BM_DOT,
+	/** squared Euclidean distance */
+	BM_SQUARED_EUCLIDEAN,
+	/** sum of absolute differences */
+	BM_MANHATTAN,
+	/** largest absolute difference */
+	BM_CHEBYSHEV,
+	/** one minus the cosine similarity, at least zero */
+	BM_COSINE,
+	/** chi-square distance */
+	BM_CHI_SQUARE,
+	/** Bray-Curtis dissimilarity */
+	BM_BRAY_CURTIS,
+	/** Canberra distance */
+	BM_CANBERRA
+};
+
+/** Computes the distances of one vector to many vectors.
+ *
+ * Every metric has a kernel whose loop over the dimensions is vectorized
+ * with SIMD reductions. The kernels are compiled for AVX-512, AVX2 and the
+ * baseline instruction set if the compiler supports that
+ * (HAVE_CPU_DISPATCH), and the best one the CPU supports is chosen at
+ * runtime.
+ *
+ * @param metric metric to compute
+ * @param vector vector of length dim
+ * @param vectors num_vectors contiguous vectors of length dim
+ * @param dim dimension of the vectors
+ * @param num_vectors number of vectors
+ * @param result num_vectors distances
+ */
+template <class T>
+void batch_distances(EBatchMetric metric, const T* vector, const T* vectors,
+		index_t dim, index_t num_vectors, float64_t* result);
+
+/** Computes the distances of feature vector idx of one to feature vectors
+ * start, ..., stop-1 of many with batch_distances(), if both are dense
+ * float32 or float64 features of the same type without subsets.
+ *
+ * @param metric metric to compute
+ * @param many features of the many vectors
+ * @param start first vector of many
+ * @param stop vector of many after the last one
+ * @param one features of the one vector
+ * @param idx index of the one vector
+ * @param result stop-start distances
+ * @return whether the distances were computed
+ */
+bool batch_distances(EBatchMetric metric, CFeatures* many, int32_t start,
+		int32_t stop, CFeatures* one, int32_t idx, float64_t* result);
+
+/** @return name of the instruction set of the kernels batch_distances()
+ * uses on this CPU
+ */
+const char* get_batch_distances_isa();
+
+}
+#endif
@@ -59,7 +59,7 @@ float64_t CCanberraMetric::compute(int32_t idx_a, int32_t idx_b)
 		{
 			absTmp=fabs(avec[i])+fabs(bvec[i]);
 			if(absTmp!=0)
-				result+=fabs(avec[i]-fabs(bvec[i]))/absTmp;
+				result+=fabs(avec[i]-bvec[i])/absTmp;
 		}
 
 	}
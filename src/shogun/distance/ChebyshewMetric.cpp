@@ -48,7 +48,7 @@ float64_t CChebyshewMetric::compute(int32_t idx_a, int32_t idx_b)
 
 	ASSERT(alen==blen)
 
-	float64_t result=DBL_MIN;
+	float64_t result=0;
 
 	for (int32_t i=0; i<alen; i++)
 		result=CMath::max(result, fabs(avec[i]-bvec[i]));
@@ -70,6 +70,9 @@ class CChiSquareDistance: public CDenseDistance<float64_t>
 		/// idx_{a,b} denote the index of the feature vectors
 		/// in the corresponding feature object
 		virtual float64_t compute(int32_t idx_a, int32_t idx_b);
+
+		/// batched kernel of the distance
+		virtual EBatchMetric get_batch_metric() const { return BM_CHI_SQUARE; }
 };
 
 } // namespace shogun
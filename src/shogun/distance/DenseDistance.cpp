@@ -21,6 +21,31 @@ template <class ST> bool CDenseDistance<ST>::init(CFeatures* l, CFeatures* r)
 	return true;
 }
 
+template <class ST>
+void CDenseDistance<ST>::distances_lhs(float64_t* result, int32_t idx_a_start,
+		int32_t idx_a_stop, int32_t idx_b)
+{
+	// precomputed distances are only known to distance()
+	if (precompute_matrix || !batch_distances(get_batch_metric(), lhs,
+			idx_a_start, idx_a_stop, rhs, idx_b, result))
+		CDistance::distances_lhs(result, idx_a_start, idx_a_stop, idx_b);
+}
+
+template <class ST>
+void CDenseDistance<ST>::distances_rhs(float64_t* result, int32_t idx_b_start,
+		int32_t idx_b_stop, int32_t idx_a)
+{
+	if (precompute_matrix || !batch_distances(get_batch_metric(), rhs,
+			idx_b_start, idx_b_stop, lhs, idx_a, result))
+		CDistance::distances_rhs(result, idx_b_start, idx_b_stop, idx_a);
+}
+
+/** get feature type the SHORTREAL distance can deal with
+ *
+ * @return feature type SHORTREAL
+ */
+template<> EFeatureType CDenseDistance<float32_t>::get_feature_type() { return F_SHORTREAL; }
+
 /** get feature type the DREAL distance can deal with
  *
  * @return feature type DREAL
@@ -69,5 +94,6 @@ template class CDenseDistance<int16_t>;
 template class CDenseDistance<uint16_t>;
 template class CDenseDistance<int32_t>;
 template class CDenseDistance<uint64_t>;
+template class CDenseDistance<float32_t>;
 template class CDenseDistance<float64_t>;
 }
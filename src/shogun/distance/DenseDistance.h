@@ -9,6 +9,7 @@
 
 #include <shogun/lib/config.h>
 
+#include <shogun/distance/BatchDistances.h>
 #include <shogun/distance/Distance.h>
 #include <shogun/features/FeatureTypes.h>
 #include <shogun/features/DenseFeatures.h>
@@ -16,7 +17,12 @@
 
 namespace shogun
 {
-/** @brief template class DenseDistance */
+/** @brief template class DenseDistance
+ *
+ * Distances that set a batched kernel with get_batch_metric() compute
+ * distances_lhs() and distances_rhs() of floating point features with
+ * batch_distances(), the others one pair at a time.
+ */
 template <class ST> class CDenseDistance : public CDistance
 {
 	public:
@@ -43,6 +49,28 @@ template <class ST> class CDenseDistance : public CDistance
 		 */
 		virtual EFeatureType get_feature_type();
 
+		/** get distances of lhs feature vectors to a rhs feature vector,
+		 * in a batch if the distance has a batched kernel
+		 *
+		 * @param result array of idx_a_stop-idx_a_start distances
+		 * @param idx_a_start first lhs feature vector
+		 * @param idx_a_stop lhs feature vector after the last one
+		 * @param idx_b rhs feature vector
+		 */
+		virtual void distances_lhs(float64_t* result, int32_t idx_a_start,
+				int32_t idx_a_stop, int32_t idx_b);
+
+		/** get distances of a lhs feature vector to rhs feature vectors,
+		 * in a batch if the distance has a batched kernel
+		 *
+		 * @param result array of idx_b_stop-idx_b_start distances
+		 * @param idx_b_start first rhs feature vector
+		 * @param idx_b_stop rhs feature vector after the last one
+		 * @param idx_a lhs feature vector
+		 */
+		virtual void distances_rhs(float64_t* result, int32_t idx_b_start,
+				int32_t idx_b_stop, int32_t idx_a);
+
 		/** Returns the name of the SGSerializable instance.  It MUST BE
 		 *  the CLASS NAME without the prefixed `C'.
 		 *
@@ -58,6 +86,14 @@ template <class ST> class CDenseDistance : public CDistance
 		 * @return distance type
 		 */
 		virtual EDistanceType get_distance_type()=0;
+
+	protected:
+		/** get metric of the batched kernel computing this distance
+		 *
+		 * @return metric, BM_NONE if there is no batched kernel
+		 */
+		virtual EBatchMetric get_batch_metric() const { return BM_NONE; }
+
 };
 } // namespace shogun
 #endif
@@ -218,16 +218,26 @@ float64_t CDistance::distance(int32_t idx_a, int32_t idx_b)
 	return compute(idx_a, idx_b);
 }
 
+void CDistance::distances_lhs(float64_t* result, int32_t idx_a_start, int32_t idx_a_stop, int32_t idx_b)
+{
+	for (int32_t i=idx_a_start; i<idx_a_stop; i++)
+		result[i-idx_a_start]=this->distance(i, idx_b);
+}
+
+void CDistance::distances_rhs(float64_t* result, int32_t idx_b_start, int32_t idx_b_stop, int32_t idx_a)
+{
+	for (int32_t j=idx_b_start; j<idx_b_stop; j++)
+		result[j-idx_b_start]=this->distance(idx_a, j);
+}
+
 void CDistance::run_distance_rhs(SGVector<float64_t>& result, const index_t idx_r_start, index_t idx_start, const index_t idx_stop, const index_t idx_a)
 {
-	for(index_t i=idx_r_start; idx_start < idx_stop; ++i,++idx_start)
-        result.vector[i] = this->distance(idx_a,idx_start);
+	distances_rhs(result.vector+idx_r_start, idx_start, idx_stop, idx_a);
 }
 
 void CDistance::run_distance_lhs(SGVector<float64_t>& result, const index_t idx_r_start, index_t idx_start, const index_t idx_stop, const index_t idx_b)
 {
-	for(index_t i=idx_r_start; idx_start < idx_stop; ++i,++idx_start)
-        result.vector[i] = this->distance(idx_start,idx_b);
+	distances_lhs(result.vector+idx_r_start, idx_start, idx_stop, idx_b);
 }
 
 void CDistance::do_precompute_matrix()
@@ -266,82 +276,70 @@ void CDistance::init()
 template <class T>
 SGMatrix<T> CDistance::get_distance_matrix()
 {
-	T* result = NULL;
-
 	REQUIRE(has_features(), "no features assigned to distance\n")
 	init(lhs, rhs);
 
 	int32_t m=get_num_vec_lhs();
 	int32_t n=get_num_vec_rhs();
 
-	int64_t total_num = int64_t(m)*n;
-	int64_t total=0;
-
 	// if lhs == rhs and sizes match assume k(i,j)=k(j,i)
 	bool symmetric= (lhs && lhs==rhs && m==n);
 
 	SG_DEBUG("returning distance matrix of size %dx%d\n", m, n)
 
-	result=SG_MALLOC(T, total_num);
+	SGMatrix<T> result(m, n);
 
-	PRange<int64_t> pb = PRange<int64_t>(
-	    range(total_num), *this->io, "PROGRESS: ", UTF8, []() { return true; });
-	int32_t num_threads;
-	int64_t step;
-	#pragma omp parallel shared(num_threads, step)
+	// every column is a batch of all lhs vectors against one rhs vector,
+	// symmetric matrices only compute the lower triangle
+	PRange<int32_t> pb = PRange<int32_t>(
+	    range(n), *this->io, "PROGRESS: ", UTF8, []() { return true; });
+	#pragma omp parallel
 	{
-#ifdef HAVE_OPENMP
-		#pragma omp single
-		{
-			num_threads=omp_get_num_threads();
-			step=total_num/num_threads;
-			num_threads--;
-		}
-		int32_t thread_num=omp_get_thread_num();
-#else
-		num_threads=0;
-		step=total_num;
-		int32_t thread_num=0;
-#endif
-		bool verbose=(thread_num == 0);
-
-		int32_t start=compute_row_start(thread_num*step, n, symmetric);
-		int32_t end=(thread_num==num_threads) ? m : compute_row_start((thread_num+1)*step, n, symmetric);
+		SGVector<float64_t> column(m);
 
-		for (int32_t i=start; i<end; i++)
+		#pragma omp for schedule(dynamic)
+		for (int32_t j=0; j<n; j++)
 		{
-			int32_t j_start=0;
-
-			if (symmetric)
-				j_start=i;
+			int32_t i_start=symmetric ? j : 0;
+			distances_lhs(column.vector+i_start, i_start, m, j);
 
-			for (int32_t j=j_start; j<n; j++)
+			for (int32_t i=i_start; i<m; i++)
 			{
-				float64_t v=this->distance(i,j);
-				result[i+j*m]=v;
-
-				if (symmetric && i!=j)
-					result[j+i*m]=v;
-
-				if (verbose)
-				{
-					total++;
-
-					if (symmetric && i!=j)
-						total++;
-
-					pb.print_progress();
-
-					// TODO: replace with new signal
-					// if (CSignal::cancel_computations())
-					//	break;
-				}
+				result(i, j)=column[i];
+				if (symmetric)
+					result(j, i)=column[i];
 			}
+
+			pb.print_progress();
 		}
 	}
 	pb.complete();
 
-	return SGMatrix<T>(result,m,n,true);
+	return result;
+}
+
+SGMatrix<float64_t> CDistance::get_distance_block(int32_t idx_a_start,
+		int32_t idx_a_stop, int32_t idx_b_start, int32_t idx_b_stop)
+{
+	REQUIRE(has_features(), "no features assigned to distance\n")
+	REQUIRE(idx_a_start>=0 && idx_a_start<=idx_a_stop && idx_a_stop<=get_num_vec_lhs(),
+			"Left hand side range [%d, %d) must lie in [0, %d)\n",
+			idx_a_start, idx_a_stop, get_num_vec_lhs());
+	REQUIRE(idx_b_start>=0 && idx_b_start<=idx_b_stop && idx_b_stop<=get_num_vec_rhs(),
+			"Right hand side range [%d, %d) must lie in [0, %d)\n",
+			idx_b_start, idx_b_stop, get_num_vec_rhs());
+
+	const int32_t num_rows=idx_a_stop-idx_a_start;
+	SGMatrix<float64_t> result(num_rows, idx_b_stop-idx_b_start);
+
+	#pragma omp parallel for schedule(dynamic)
+	for (int32_t j=idx_b_start; j<idx_b_stop; j++)
+	{
+		distances_lhs(result.matrix+int64_t(j-idx_b_start)*num_rows,
+				idx_a_start, idx_a_stop, j);
+	}
+
+	return result;
 }
 
 template SGMatrix<float64_t> CDistance::get_distance_matrix<float64_t>();
@@ -124,6 +124,32 @@ class CDistance : public CSGObject
 			return distance(idx_a, idx_b);
 		}
 
+		/** get distances of the lhs feature vectors idx_a_start, ...,
+		 * idx_a_stop-1 to the rhs feature vector idx_b. Distances with a
+		 * batched kernel override this, the default calls distance() for
+		 * every pair.
+		 *
+		 * @param result array of idx_a_stop-idx_a_start distances
+		 * @param idx_a_start first lhs feature vector
+		 * @param idx_a_stop lhs feature vector after the last one
+		 * @param idx_b rhs feature vector
+		 */
+		virtual void distances_lhs(float64_t* result, int32_t idx_a_start,
+				int32_t idx_a_stop, int32_t idx_b);
+
+		/** get distances of the lhs feature vector idx_a to the rhs feature
+		 * vectors idx_b_start, ..., idx_b_stop-1. Distances with a batched
+		 * kernel override this, the default calls distance() for every
+		 * pair.
+		 *
+		 * @param result array of idx_b_stop-idx_b_start distances
+		 * @param idx_b_start first rhs feature vector
+		 * @param idx_b_stop rhs feature vector after the last one
+		 * @param idx_a lhs feature vector
+		 */
+		virtual void distances_rhs(float64_t* result, int32_t idx_b_start,
+				int32_t idx_b_stop, int32_t idx_a);
+
 		/**
 		 * Precomputation related to features of right hand side
 		 * WARNING : Make sure to reset computations using reset_precompute()
@@ -162,6 +188,19 @@ class CDistance : public CSGObject
 		 */
 		template <class T> SGMatrix<T> get_distance_matrix();
 
+		/** get distances of the lhs feature vectors idx_a_start, ...,
+		 * idx_a_stop-1 to the rhs feature vectors idx_b_start, ...,
+		 * idx_b_stop-1, computed in parallel with distances_lhs()
+		 *
+		 * @param idx_a_start first lhs feature vector
+		 * @param idx_a_stop lhs feature vector after the last one
+		 * @param idx_b_start first rhs feature vector
+		 * @param idx_b_stop rhs feature vector after the last one
+		 * @return matrix of distances, lhs along the rows
+		 */
+		SGMatrix<float64_t> get_distance_block(int32_t idx_a_start,
+				int32_t idx_a_stop, int32_t idx_b_start, int32_t idx_b_stop);
+
 		/** compute row start offset for parallel kernel matrix computation
 		 *
 		 * @param offs offset
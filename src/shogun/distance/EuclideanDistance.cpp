@@ -6,6 +6,7 @@
  */
 
 #include <shogun/lib/common.h>
+#include <shogun/distance/BatchDistances.h>
 #include <shogun/distance/EuclideanDistance.h>
 #include <shogun/features/Features.h>
 #include <shogun/features/DotFeatures.h>
@@ -76,6 +77,40 @@ float64_t CEuclideanDistance::compute(int32_t idx_a, int32_t idx_b)
 	return std::sqrt(result);
 }
 
+void CEuclideanDistance::distances_lhs(float64_t* result, int32_t idx_a_start,
+		int32_t idx_a_stop, int32_t idx_b)
+{
+	if (precompute_matrix || !batch_distances(BM_SQUARED_EUCLIDEAN, lhs,
+			idx_a_start, idx_a_stop, rhs, idx_b, result))
+	{
+		CDistance::distances_lhs(result, idx_a_start, idx_a_stop, idx_b);
+		return;
+	}
+
+	if (!disable_sqrt)
+	{
+		for (int32_t i=0; i<idx_a_stop-idx_a_start; i++)
+			result[i]=std::sqrt(result[i]);
+	}
+}
+
+void CEuclideanDistance::distances_rhs(float64_t* result, int32_t idx_b_start,
+		int32_t idx_b_stop, int32_t idx_a)
+{
+	if (precompute_matrix || !batch_distances(BM_SQUARED_EUCLIDEAN, rhs,
+			idx_b_start, idx_b_stop, lhs, idx_a, result))
+	{
+		CDistance::distances_rhs(result, idx_b_start, idx_b_stop, idx_a);
+		return;
+	}
+
+	if (!disable_sqrt)
+	{
+		for (int32_t j=0; j<idx_b_stop-idx_b_start; j++)
+			result[j]=std::sqrt(result[j]);
+	}
+}
+
 void CEuclideanDistance::precompute_lhs()
 {
 	REQUIRE(lhs, "Left hand side feature cannot be NULL!\n");
@@ -130,6 +130,30 @@ public:
 	 */
 	virtual float64_t distance_upper_bounded(int32_t idx_a, int32_t idx_b, float64_t upper_bound);
 
+	/** get distances of lhs feature vectors to a rhs feature vector, in a
+	 * batch of squared differences if both sides are dense floating point
+	 * features
+	 *
+	 * @param result array of idx_a_stop-idx_a_start distances
+	 * @param idx_a_start first lhs feature vector
+	 * @param idx_a_stop lhs feature vector after the last one
+	 * @param idx_b rhs feature vector
+	 */
+	virtual void distances_lhs(float64_t* result, int32_t idx_a_start,
+			int32_t idx_a_stop, int32_t idx_b);
+
+	/** get distances of a lhs feature vector to rhs feature vectors, in a
+	 * batch of squared differences if both sides are dense floating point
+	 * features
+	 *
+	 * @param result array of idx_b_stop-idx_b_start distances
+	 * @param idx_b_start first rhs feature vector
+	 * @param idx_b_stop rhs feature vector after the last one
+	 * @param idx_a lhs feature vector
+	 */
+	virtual void distances_rhs(float64_t* result, int32_t idx_b_start,
+			int32_t idx_b_stop, int32_t idx_a);
+
 	/**
 	 * Precomputation of squared norms for features of right hand side
 	 * WARNING : Make sure to reset computations using reset_precompute()
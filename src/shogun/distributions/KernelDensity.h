@@ -53,10 +53,15 @@ enum EEvaluationMode
  * following formula : \\
  * \f$pdf(x')= \frac{1}{nh} \sum_{i=1}^n K(\frac{||x-x_i||}{h})\f$ \\
  * K() in the above formula is called the kernel function and is controlled by the parameter h called kernel bandwidth.
- * Presently, this class supports only Gaussian kernel which can be used with either Euclidean distance or Manhattan
- * distance. This class makes use of 2 tree structures KD-tree and Ball tree for fast calculation. KD-trees are
- * faster than ball trees at lower dimensions. In case of high dimensional data, ball tree tends to out-perform KD-tree.
- * By default, the class used is Ball tree.
+ * Supported kernels are the Gaussian (K_GAUSSIAN), Epanechnikov (K_EPANECHNIKOV), top-hat (K_TOPHAT) and triangular
+ * (K_TRIANGULAR, i.e. \f$1-||x-x_i||/h\f$) kernels, which can be used with either Euclidean distance or Manhattan distance.
+ * The kernels are normalized for Euclidean distance. This class makes use of 2 tree structures KD-tree and Ball tree
+ * for fast calculation. KD-trees are faster than ball trees at lower dimensions. In case of high dimensional data,
+ * ball tree tends to out-perform KD-tree. By default, the class used is Ball tree.
+ *
+ * The dual tree evaluation modes traverse subtrees of the query tree in parallel. With absolute tolerance atol and
+ * relative tolerance rtol, the estimated density at each query point differs from the exact one by at most
+ * atol plus rtol times the exact density. The compact kernels skip all pairs of nodes farther apart than h.
  */
 class CKernelDensity : public CDistribution
 {
@@ -138,6 +143,8 @@ public :
 	 */
 	inline static float64_t log_norm(EKernelType kernel, float64_t width, int32_t dim)
 	{
+		// log of the volume of the unit ball
+		float64_t log_volume=0.5*dim*std::log(CMath::PI)-std::lgamma(0.5*dim+1);
 		switch(kernel)
 		{
 			case K_GAUSSIAN:
@@ -146,6 +153,12 @@ public :
 				       dim * std::log(width);
 				break;
 			}
+			case K_TOPHAT:
+				return -log_volume-dim*std::log(width);
+			case K_EPANECHNIKOV:
+				return -log_volume-std::log(2.0/(dim+2))-dim*std::log(width);
+			case K_TRIANGULAR:
+				return -log_volume+std::log(dim+1.0)-dim*std::log(width);
 			default:
 				SG_SPRINT("kernel type not recognized\n");
 		}
@@ -169,6 +182,12 @@ public :
 				return -0.5*dist*dist/(width*width);
 				break;
 			}
+			case K_TOPHAT:
+				return dist<width ? 0 : -CMath::INFTY;
+			case K_EPANECHNIKOV:
+				return dist<width ? std::log(1-dist*dist/(width*width)) : -CMath::INFTY;
+			case K_TRIANGULAR:
+				return dist<width ? std::log(1-dist/width) : -CMath::INFTY;
 			default:
 				SG_SPRINT("kernel type not recognized\n");
 		}
@@ -0,0 +1,320 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: agent
+ */
+
+#include <shogun/evaluation/BinaryScores.h>
+#include <shogun/io/SGIO.h>
+#include <shogun/labels/BinaryLabels.h>
+#include <shogun/mathematics/Math.h>
+
+#include <cstring>
+#include <utility>
+
+#ifdef HAVE_OPENMP
+#include <omp.h>
+#endif
+
+using namespace shogun;
+
+/* bits per digit of the radix sort */
+static const int32_t radix_bits=11;
+static const index_t num_buckets=index_t(1)<<radix_bits;
+
+static void check_labels(CBinaryLabels* predicted, CBinaryLabels* ground_truth)
+{
+	REQUIRE(predicted, "No predicted labels provided.\n");
+	REQUIRE(ground_truth, "No ground truth labels provided.\n");
+	REQUIRE(predicted->get_num_labels()==ground_truth->get_num_labels(),
+			"Number of predicted labels (%d) must match number of ground "
+			"truth labels (%d).\n", predicted->get_num_labels(),
+			ground_truth->get_num_labels());
+	ground_truth->ensure_valid();
+}
+
+BinaryScores::BinaryScores(index_t num_bins)
+	: m_num_bins(0)
+{
+	set_num_bins(num_bins);
+}
+
+uint64_t BinaryScores::to_key(float64_t score)
+{
+	/* -0 and 0 are tied */
+	if (score==0)
+		score=0;
+
+	uint64_t bits;
+	std::memcpy(&bits, &score, sizeof(bits));
+
+	/* flip negative numbers, move positive ones above them, then reverse */
+	const uint64_t sign=uint64_t(1)<<63;
+	return (bits & sign) ? bits : ~(bits | sign);
+}
+
+float64_t BinaryScores::to_score(uint64_t key)
+{
+	const uint64_t sign=uint64_t(1)<<63;
+	const uint64_t bits=(key & sign) ? key : ~key & ~sign;
+
+	float64_t score;
+	std::memcpy(&score, &bits, sizeof(score));
+	return score;
+}
+
+void BinaryScores::sort(CBinaryLabels* predicted, CBinaryLabels* ground_truth)
+{
+	check_labels(predicted, ground_truth);
+
+	const index_t length=predicted->get_num_labels();
+	m_is_histogram=false;
+	m_sorted.resize(length);
+
+	int64_t num_positive=0;
+	#pragma omp parallel for reduction(+:num_positive)
+	for (index_t i=0; i<length; i++)
+	{
+		const bool positive=ground_truth->get_label(i)>0;
+		m_sorted[i].key=to_key(predicted->get_value(i));
+		m_sorted[i].positive=positive;
+		num_positive+=positive;
+	}
+
+	m_num_positive=num_positive;
+	m_num_negative=length-num_positive;
+
+	radix_sort();
+}
+
+void BinaryScores::radix_sort()
+{
+	const index_t length=m_sorted.size();
+	m_buffer.resize(length);
+
+	/* digits on which all keys agree, e.g. the sign and the exponent of
+	 * scores in a narrow range, need no pass */
+	uint64_t all_and=~uint64_t(0);
+	uint64_t all_or=0;
+	#pragma omp parallel for reduction(&:all_and) reduction(|:all_or)
+	for (index_t i=0; i<length; i++)
+	{
+		all_and&=m_sorted[i].key;
+		all_or|=m_sorted[i].key;
+	}
+	const uint64_t varying=all_and ^ all_or;
+
+	Example* source=m_sorted.data();
+	Example* target=m_buffer.data();
+	for (int32_t shift=0; shift<64; shift+=radix_bits)
+	{
+		if (!((varying >> shift) & (num_buckets-1)))
+			continue;
+
+		/* every thread counts the digits of a contiguous block, then
+		 * scatters the block behind the blocks of lower threads, which
+		 * keeps every pass stable */
+		#pragma omp parallel
+		{
+#ifdef HAVE_OPENMP
+			int32_t num_threads=omp_get_num_threads();
+			int32_t thread_num=omp_get_thread_num();
+#else
+			int32_t num_threads=1;
+			int32_t thread_num=0;
+#endif
+			#pragma omp single
+			m_digit_counts.assign(int64_t(num_threads)*num_buckets, 0);
+
+			const index_t begin=int64_t(length)*thread_num/num_threads;
+			const index_t end=int64_t(length)*(thread_num+1)/num_threads;
+			index_t* counts=m_digit_counts.data()+int64_t(thread_num)*num_buckets;
+
+			for (index_t i=begin; i<end; i++)
+				counts[(source[i].key >> shift) & (num_buckets-1)]++;
+
+			#pragma omp barrier
+			#pragma omp single
+			{
+				index_t offset=0;
+				for (index_t b=0; b<num_buckets; b++)
+				{
+					for (int32_t t=0; t<num_threads; t++)
+					{
+						index_t& count=m_digit_counts[int64_t(t)*num_buckets+b];
+						const index_t num=count;
+						count=offset;
+						offset+=num;
+					}
+				}
+			}
+
+			for (index_t i=begin; i<end; i++)
+				target[counts[(source[i].key >> shift) & (num_buckets-1)]++]=source[i];
+		}
+
+		std::swap(source, target);
+	}
+
+	if (source!=m_sorted.data())
+		m_sorted.swap(m_buffer);
+}
+
+void BinaryScores::add_to_histogram(CBinaryLabels* predicted, CBinaryLabels* ground_truth)
+{
+	check_labels(predicted, ground_truth);
+
+	if (!m_is_histogram)
+	{
+		clear();
+		m_is_histogram=true;
+	}
+
+	const index_t length=predicted->get_num_labels();
+	if (!length)
+		return;
+
+	float64_t min=predicted->get_value(0);
+	float64_t max=min;
+	#pragma omp parallel for reduction(min:min) reduction(max:max)
+	for (index_t i=0; i<length; i++)
+	{
+		const float64_t score=predicted->get_value(i);
+		min=CMath::min(min, score);
+		max=CMath::max(max, score);
+	}
+	REQUIRE(CMath::is_finite(min) && CMath::is_finite(max),
+			"Scores must be finite, they range from %f to %f.\n", min, max);
+
+	/* the first batch determines the resolution, the largest score lies in
+	 * the last bin */
+	if (m_width==0)
+	{
+		m_lower=min;
+		m_width=(max-min)/(m_num_bins-1);
+		if (m_width==0)
+			m_width=CMath::max(CMath::abs(min), 1.0)*1e-12;
+	}
+	extend_histogram(min, max);
+
+	int64_t num_positive=0;
+	#pragma omp parallel for reduction(+:num_positive)
+	for (index_t i=0; i<length; i++)
+	{
+		index_t bin=(predicted->get_value(i)-m_lower)/m_width;
+		bin=CMath::clamp<index_t>(bin, 0, m_num_bins-1);
+
+		if (ground_truth->get_label(i)>0)
+		{
+			#pragma omp atomic
+			m_positive[bin]++;
+			num_positive++;
+		}
+		else
+		{
+			#pragma omp atomic
+			m_negative[bin]++;
+		}
+	}
+
+	m_num_positive+=num_positive;
+	m_num_negative+=length-num_positive;
+}
+
+void BinaryScores::extend_histogram(float64_t min, float64_t max)
+{
+	while (min<m_lower || max>=m_lower+m_num_bins*m_width)
+	{
+		if (min<m_lower)
+		{
+			/* the bins move to the upper half */
+			for (index_t j=m_num_bins-1; j>=0; j--)
+			{
+				int64_t positive=0;
+				int64_t negative=0;
+				for (index_t i=2*j-m_num_bins; i<=2*j-m_num_bins+1; i++)
+				{
+					if (i>=0)
+					{
+						positive+=m_positive[i];
+						negative+=m_negative[i];
+					}
+				}
+				m_positive[j]=positive;
+				m_negative[j]=negative;
+			}
+			m_lower-=m_num_bins*m_width;
+		}
+		else
+		{
+			/* the bins move to the lower half */
+			for (index_t j=0; j<m_num_bins; j++)
+			{
+				int64_t positive=0;
+				int64_t negative=0;
+				for (index_t i=2*j; i<=2*j+1; i++)
+				{
+					if (i<m_num_bins)
+					{
+						positive+=m_positive[i];
+						negative+=m_negative[i];
+					}
+				}
+				m_positive[j]=positive;
+				m_negative[j]=negative;
+			}
+		}
+		m_width*=2;
+	}
+}
+
+void BinaryScores::clear()
+{
+	m_sorted.clear();
+	m_positive.assign(m_num_bins, 0);
+	m_negative.assign(m_num_bins, 0);
+	m_lower=0;
+	m_width=0;
+	m_is_histogram=false;
+	m_num_positive=0;
+	m_num_negative=0;
+}
+
+void BinaryScores::set_num_bins(index_t num_bins)
+{
+	REQUIRE(num_bins>1, "Number of bins (%d) must be at least 2.\n", num_bins);
+	m_num_bins=num_bins;
+	clear();
+}
+
+index_t BinaryScores::get_num_groups() const
+{
+	index_t num_groups=0;
+	if (m_is_histogram)
+	{
+		for (index_t i=0; i<m_num_bins; i++)
+			num_groups+=m_positive[i] || m_negative[i];
+	}
+	else
+	{
+		const index_t length=m_sorted.size();
+		for (index_t i=0; i<length; i++)
+			num_groups+=i==0 || m_sorted[i].key!=m_sorted[i-1].key;
+	}
+
+	return num_groups;
+}
+
+float64_t BinaryScores::get_auROC_error_bound() const
+{
+	if (!m_is_histogram || !m_num_positive || !m_num_negative)
+		return 0;
+
+	/* the pairs of positives and negatives in the same bin count half, but
+	 * could be ordered either way */
+	float64_t tied_pairs=0;
+	for (index_t i=0; i<m_num_bins; i++)
+		tied_pairs+=float64_t(m_positive[i])*m_negative[i];
+
+	return 0.5*tied_pairs/m_num_positive/m_num_negative;
+}
@@ -0,0 +1,191 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: agent
+ */
+
+#ifndef BINARYSCORES_H_
+#define BINARYSCORES_H_
+
+#include <shogun/lib/config.h>
+
+#include <shogun/lib/common.h>
+
+#include <vector>
+
+namespace shogun
+{
+
+class CBinaryLabels;
+
+/** how ranking measures (auROC, auPRC) are computed from the scores */
+enum EAUCMethod
+{
+	/** all scores are sorted, exact */
+	AUC_SORTED,
+	/** scores are counted in a histogram, approximate, constant memory and
+	 * the only method that supports adding batches one after the other
+	 */
+	AUC_HISTOGRAM
+};
+
+/** @brief Predicted scores and ground truth of binary predictions, grouped
+ * by score as needed by ranking measures such as auROC and auPRC.
+ *
+ * Predictions are either sorted, or counted in a histogram:
+ *
+ * sort() orders all examples by decreasing score with a parallel, stable
+ * least significant digit radix sort on the bit patterns of the scores,
+ * which takes linear time. Groups are the examples with equal scores.
+ *
+ * add_to_histogram() counts positive and negative examples in equal width
+ * score bins. The range is taken from the first batch and doubled when
+ * later scores fall outside, so batches can be added one after the other
+ * without retaining them. Groups are the non-empty bins, i.e. scores within
+ * a bin are treated as ties. That changes the auROC by at most
+ * get_auROC_error_bound().
+ *
+ * Buffers are kept between calls, so repeated evaluations of the same
+ * number of examples do not allocate.
+ */
+class BinaryScores
+{
+public:
+	/** constructor
+	 *
+	 * @param num_bins number of bins of the histogram
+	 */
+	BinaryScores(index_t num_bins=65536);
+
+	/** sorts predictions, replacing previous contents
+	 *
+	 * @param predicted predicted scores
+	 * @param ground_truth labels assumed to be correct
+	 */
+	void sort(CBinaryLabels* predicted, CBinaryLabels* ground_truth);
+
+	/** adds predictions to the histogram, sorted contents are dropped
+	 *
+	 * @param predicted predicted scores
+	 * @param ground_truth labels assumed to be correct
+	 */
+	void add_to_histogram(CBinaryLabels* predicted, CBinaryLabels* ground_truth);
+
+	/** removes all predictions */
+	void clear();
+
+	/** @return whether the contents are a histogram */
+	bool is_histogram() const { return m_is_histogram; }
+
+	/** @param num_bins number of bins of the histogram, clears it */
+	void set_num_bins(index_t num_bins);
+
+	/** @return number of bins of the histogram */
+	index_t get_num_bins() const { return m_num_bins; }
+
+	/** @return number of positive examples */
+	int64_t get_num_positive() const { return m_num_positive; }
+
+	/** @return number of negative examples */
+	int64_t get_num_negative() const { return m_num_negative; }
+
+	/** @return number of groups of tied examples */
+	index_t get_num_groups() const;
+
+	/** @return upper bound of the difference between the auROC computed
+	 * from the groups and the exact auROC, zero for sorted examples
+	 */
+	float64_t get_auROC_error_bound() const;
+
+	/** calls f(threshold, num_positive, num_negative) for each group of
+	 * tied examples by decreasing score. The threshold is the score of the
+	 * group, or the lower edge of the bin.
+	 */
+	template <class F>
+	void for_each_group(F f) const
+	{
+		if (m_is_histogram)
+		{
+			for (index_t i=m_num_bins-1; i>=0; i--)
+			{
+				if (m_positive[i] || m_negative[i])
+					f(m_lower+i*m_width, m_positive[i], m_negative[i]);
+			}
+			return;
+		}
+
+		const index_t length=m_sorted.size();
+		for (index_t i=0; i<length;)
+		{
+			int64_t num_positive=0;
+			index_t j=i;
+			for (; j<length && m_sorted[j].key==m_sorted[i].key; j++)
+				num_positive+=m_sorted[j].positive;
+
+			f(to_score(m_sorted[i].key), num_positive, j-i-num_positive);
+			i=j;
+		}
+	}
+
+	/** calls f(score, positive) for each sorted example by decreasing
+	 * score, requires sorted contents
+	 */
+	template <class F>
+	void for_each_example(F f) const
+	{
+		for (const auto& example : m_sorted)
+			f(to_score(example.key), example.positive!=0);
+	}
+
+private:
+	/** score and ground truth of an example */
+	struct Example
+	{
+		/** order preserving bit pattern of the negated score */
+		uint64_t key;
+		/** 1 if positive, 0 otherwise */
+		uint64_t positive;
+	};
+
+	/** @return key whose ascending order is the descending order of
+	 * scores
+	 */
+	static uint64_t to_key(float64_t score);
+
+	/** @return score of a key */
+	static float64_t to_score(uint64_t key);
+
+	/** sorts m_sorted by key, using m_buffer */
+	void radix_sort();
+
+	/** doubles the bin width until [min, max] is covered */
+	void extend_histogram(float64_t min, float64_t max);
+
+private:
+	/** sorted examples */
+	std::vector<Example> m_sorted;
+	/** buffer of the radix sort */
+	std::vector<Example> m_buffer;
+	/** per-thread digit counts of the radix sort */
+	std::vector<index_t> m_digit_counts;
+	/** positive counts of the bins */
+	std::vector<int64_t> m_positive;
+	/** negative counts of the bins */
+	std::vector<int64_t> m_negative;
+	/** number of bins */
+	index_t m_num_bins;
+	/** lower edge of the first bin */
+	float64_t m_lower;
+	/** width of the bins, 0 if the histogram is empty */
+	float64_t m_width;
+	/** whether the contents are a histogram */
+	bool m_is_histogram;
+	/** number of positive examples */
+	int64_t m_num_positive;
+	/** number of negative examples */
+	int64_t m_num_negative;
+};
+
+}
+
+#endif /* BINARYSCORES_H_ */
@@ -6,7 +6,6 @@
  */
 
 #include <shogun/evaluation/PRCEvaluation.h>
-#include <shogun/labels/RegressionLabels.h>
 #include <shogun/labels/BinaryLabels.h>
 #include <shogun/mathematics/Math.h>
 
@@ -19,69 +18,116 @@ CPRCEvaluation::~CPRCEvaluation()
 float64_t CPRCEvaluation::evaluate(CLabels* predicted, CLabels* ground_truth)
 {
 	ASSERT(predicted && ground_truth)
-	ASSERT(predicted->get_num_labels()==ground_truth->get_num_labels())
 	ASSERT(predicted->get_label_type()==LT_BINARY)
 	ASSERT(ground_truth->get_label_type()==LT_BINARY)
-	ground_truth->ensure_valid();
 
-	// number of true positive examples
-	float64_t tp = 0.0;
-	int32_t i;
+	m_scores.clear();
+	if (m_method==AUC_HISTOGRAM)
+		m_scores.add_to_histogram((CBinaryLabels*)predicted, (CBinaryLabels*)ground_truth);
+	else
+		m_scores.sort((CBinaryLabels*)predicted, (CBinaryLabels*)ground_truth);
 
-	// total number of positive labels in predicted
-	int32_t pos_count=0;
+	return compute_prc();
+}
 
-	// initialize number of labels and labels
-	SGVector<float64_t> orig_labels = predicted->get_values();
-	int32_t length = orig_labels.vlen;
-	float64_t* labels = SGVector<float64_t>::clone_vector(orig_labels.vector, length);
+void CPRCEvaluation::add_batch(CLabels* predicted, CLabels* ground_truth)
+{
+	ASSERT(predicted && ground_truth)
+	ASSERT(predicted->get_label_type()==LT_BINARY)
+	ASSERT(ground_truth->get_label_type()==LT_BINARY)
 
-	// get indexes for sort
-	int32_t* idxs = SG_MALLOC(int32_t, length);
-	for(i=0; i<length; i++)
-		idxs[i] = i;
+	m_scores.add_to_histogram((CBinaryLabels*)predicted, (CBinaryLabels*)ground_truth);
+}
 
-	// sort indexes by labels ascending
-	CMath::qsort_backward_index(labels,idxs,length);
+float64_t CPRCEvaluation::evaluate_batches()
+{
+	REQUIRE(m_scores.is_histogram(), "No batches added, please call "
+			"add_batch first.\n");
 
-	// clean and initialize graph and auPRC
-	SG_FREE(labels);
-	m_PRC_graph = SGMatrix<float64_t>(2,length);
-	m_thresholds = SGVector<float64_t>(length);
-	m_auPRC = 0.0;
+	return compute_prc();
+}
 
-	// get total numbers of positive and negative labels
-	for (i=0; i<length; i++)
-	{
-		if (ground_truth->get_value(i) > 0)
-			pos_count++;
-	}
+void CPRCEvaluation::reset_batches()
+{
+	m_scores.clear();
+}
 
-	// assure number of positive examples is >0
-	ASSERT(pos_count>0)
+float64_t CPRCEvaluation::compute_prc()
+{
+	// total number of positive labels in predicted
+	const int64_t pos_count=m_scores.get_num_positive();
 
-	// create PRC curve
-	for (i=0; i<length; i++)
-	{
-		// update number of true positive examples
-		if (ground_truth->get_value(idxs[i]) > 0)
-			tp += 1.0;
+	// assure number of positive examples is >0
+	REQUIRE(pos_count>0, "%s::evaluate(): Number of positive labels is "
+			"zero, PRC fails!\n", get_name());
 
-		// precision (x)
-		m_PRC_graph[2*i] = tp/float64_t(i+1);
-		// recall (y)
-		m_PRC_graph[2*i+1] = tp/float64_t(pos_count);
+	// sorted scores add a point per example, binned ones per bin
+	const bool per_example=!m_scores.is_histogram();
+	const index_t length=per_example ?
+		pos_count+m_scores.get_num_negative() : m_scores.get_num_groups();
 
-		m_thresholds[i]= predicted->get_value(idxs[i]);
+	if (m_compute_curve)
+	{
+		m_PRC_graph=SGMatrix<float64_t>(2,length);
+		m_thresholds=SGVector<float64_t>(length);
+	}
+	else
+	{
+		m_PRC_graph=SGMatrix<float64_t>();
+		m_thresholds=SGVector<float64_t>();
 	}
 
-	// calc auRPC using area under curve
-	m_auPRC = CMath::area_under_curve(m_PRC_graph.matrix,length,true);
+	// number of true positive and of all examples above the threshold
+	int64_t tp=0;
+	int64_t num_seen=0;
+	index_t i=0;
+	float64_t precision=0.0;
+	float64_t recall=0.0;
+	m_auPRC=0.0;
+
+	// precision (x) and recall (y) of a point, the area between two points
+	// is a trapezoid
+	auto add_point=[&](float64_t threshold)
+	{
+		const float64_t last_precision=precision;
+		const float64_t last_recall=recall;
+		precision=float64_t(tp)/num_seen;
+		recall=float64_t(tp)/pos_count;
+
+		if (i>0)
+			m_auPRC+=0.5*(recall-last_recall)*(precision+last_precision);
+
+		if (m_compute_curve)
+		{
+			m_PRC_graph[2*i]=precision;
+			m_PRC_graph[2*i+1]=recall;
+			m_thresholds[i]=threshold;
+		}
+		i++;
+	};
+
+	if (per_example)
+	{
+		m_scores.for_each_example([&](float64_t score, bool positive)
+		{
+			tp+=positive;
+			num_seen++;
+			add_point(score);
+		});
+	}
+	else
+	{
+		m_scores.for_each_group([&](float64_t threshold, int64_t num_pos, int64_t num_neg)
+		{
+			tp+=num_pos;
+			num_seen+=num_pos+num_neg;
+			add_point(threshold);
+		});
+	}
 
 	// set computed indicator
 	m_computed = true;
 
-	SG_FREE(idxs);
 	return m_auPRC;
 }
 
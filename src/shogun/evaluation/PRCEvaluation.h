@@ -11,6 +11,7 @@
 #include <shogun/lib/config.h>
 
 #include <shogun/evaluation/BinaryClassEvaluation.h>
+#include <shogun/evaluation/BinaryScores.h>
 
 namespace shogun
 {
@@ -20,13 +21,23 @@ class CLabels;
 /** @brief Class PRCEvaluation used to evaluate PRC
  * (Precision Recall Curve) and an area under PRC curve (auPRC).
  *
+ * By default (AUC_SORTED) the scores are sorted with a parallel radix sort
+ * and every example adds a point. With AUC_HISTOGRAM the scores are counted
+ * in a fixed number of bins, see BinaryScores, and every non-empty bin adds
+ * a point. Predictions too large to hold at once can be added with
+ * add_batch() and evaluated with evaluate_batches(), which always uses a
+ * histogram.
+ *
+ * If the PRC graph is not needed, set_compute_curve(false) skips it and
+ * repeated evaluations do not allocate.
  */
 class CPRCEvaluation: public CBinaryClassEvaluation
 {
 public:
 	/** constructor */
 	CPRCEvaluation() :
-		CBinaryClassEvaluation(), m_computed(false)
+		CBinaryClassEvaluation(), m_computed(false), m_method(AUC_SORTED),
+		m_compute_curve(true)
 	{
 		m_PRC_graph = SGMatrix<float64_t>();
 		m_thresholds = SGVector<float64_t>();
@@ -68,6 +79,59 @@ public:
 	 */
 	SGVector<float64_t> get_thresholds();
 
+	/** adds predictions to those evaluated by evaluate_batches(), without
+	 * retaining them
+	 * @param predicted labels
+	 * @param ground_truth labels assumed to be correct
+	 */
+	void add_batch(CLabels* predicted, CLabels* ground_truth);
+
+	/** evaluate PRC and auPRC of all batches added since the last
+	 * evaluate() or reset_batches()
+	 * @return auPRC
+	 */
+	float64_t evaluate_batches();
+
+	/** removes all batches */
+	void reset_batches();
+
+	/** set method
+	 * @param method how to compute the auPRC
+	 */
+	void set_method(EAUCMethod method) { m_method=method; }
+
+	/** get method
+	 * @return how the auPRC is computed
+	 */
+	EAUCMethod get_method() const { return m_method; }
+
+	/** set number of bins of the histogram, removes all batches
+	 * @param num_bins number of bins
+	 */
+	void set_num_bins(index_t num_bins) { m_scores.set_num_bins(num_bins); }
+
+	/** get number of bins of the histogram
+	 * @return number of bins
+	 */
+	index_t get_num_bins() const { return m_scores.get_num_bins(); }
+
+	/** set whether to compute the PRC graph and thresholds
+	 * @param compute_curve whether to compute the PRC graph
+	 */
+	void set_compute_curve(bool compute_curve) { m_compute_curve=compute_curve; }
+
+	/** get whether the PRC graph and thresholds are computed
+	 * @return whether the PRC graph is computed
+	 */
+	bool get_compute_curve() const { return m_compute_curve; }
+
+protected:
+
+	/** evaluate PRC and auPRC of m_scores
+	 * @return auPRC
+	 */
+	float64_t compute_prc();
+
 protected:
 
 	/** 2-d array used to store PRC graph */
@@ -81,6 +145,15 @@ protected:
 
 	/** indicator of PRC and auPRC being computed already */
 	bool m_computed;
+
+	/** how the auPRC is computed */
+	EAUCMethod m_method;
+
+	/** whether to compute the PRC graph and thresholds */
+	bool m_compute_curve;
+
+	/** sorted or binned scores */
+	BinaryScores m_scores;
 };
 
 }
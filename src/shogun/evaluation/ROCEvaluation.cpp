@@ -14,7 +14,7 @@ CROCEvaluation::~CROCEvaluation()
 {
 }
 
-float64_t CROCEvaluation::evaluate(CLabels* predicted, CLabels* ground_truth)
+static void check_binary(CLabels* predicted, CLabels* ground_truth)
 {
 	REQUIRE(predicted, "No predicted labels provided.\n");
 	REQUIRE(ground_truth, "No ground truth labels provided.\n");
@@ -26,67 +26,50 @@ float64_t CROCEvaluation::evaluate(CLabels* predicted, CLabels* ground_truth)
 	    ground_truth->get_label_type() == LT_BINARY,
 	    "Given ground truth labels (%d) must be binary (%d).\n",
 	    ground_truth->get_label_type(), LT_BINARY);
+}
+
+float64_t CROCEvaluation::evaluate(CLabels* predicted, CLabels* ground_truth)
+{
+	check_binary(predicted, ground_truth);
 
 	return evaluate_roc((CBinaryLabels*)predicted,(CBinaryLabels*)ground_truth);
 }
 
 float64_t CROCEvaluation::evaluate_roc(CBinaryLabels* predicted, CBinaryLabels* ground_truth)
 {
-	ASSERT(predicted && ground_truth)
-	ASSERT(predicted->get_num_labels()==ground_truth->get_num_labels())
-	ground_truth->ensure_valid();
-
-	// assume threshold as negative infinity
-	float64_t threshold = CMath::ALMOST_NEG_INFTY;
-	// false positive rate
-	float64_t fp = 0.0;
-	// true positive rate
-	float64_t tp=0.0;
-
-	int32_t i;
-	// total number of positive labels in predicted
-	int32_t pos_count=0;
-	int32_t neg_count=0;
-
-	// initialize number of labels and labels
-	SGVector<float64_t> orig_labels(predicted->get_num_labels());
-	int32_t length = orig_labels.vlen;
-	for (i=0; i<length; i++)
-		orig_labels[i] = predicted->get_value(i);
-	float64_t* labels = SGVector<float64_t>::clone_vector(orig_labels.vector, length);
-
-	// get sorted indexes
-	SGVector<int32_t> idxs(length);
-	for(i=0; i<length; i++)
-		idxs[i] = i;
-
-	CMath::qsort_backward_index(labels,idxs.vector,idxs.vlen);
-
-	// number of different predicted labels
-	int32_t diff_count=1;
-
-	// get number of different labels
-	for (i=0; i<length-1; i++)
-	{
-		if (labels[i] != labels[i+1])
-			diff_count++;
-	}
+	m_scores.clear();
+	if (m_method==AUC_HISTOGRAM)
+		m_scores.add_to_histogram(predicted, ground_truth);
+	else
+		m_scores.sort(predicted, ground_truth);
+
+	return compute_roc();
+}
 
-	SG_FREE(labels);
+void CROCEvaluation::add_batch(CLabels* predicted, CLabels* ground_truth)
+{
+	check_binary(predicted, ground_truth);
 
-	// initialize graph and auROC
-	m_ROC_graph = SGMatrix<float64_t>(2,diff_count+1);
-	m_thresholds = SGVector<float64_t>(length);
-	m_auROC = 0.0;
+	m_scores.add_to_histogram((CBinaryLabels*)predicted, (CBinaryLabels*)ground_truth);
+}
 
-	// get total numbers of positive and negative labels
-	for(i=0; i<length; i++)
-	{
-		if (ground_truth->get_label(i) >= 0)
-			pos_count++;
-		else
-			neg_count++;
-	}
+float64_t CROCEvaluation::evaluate_batches()
+{
+	REQUIRE(m_scores.is_histogram(), "No batches added, please call "
+			"add_batch first.\n");
+
+	return compute_roc();
+}
+
+void CROCEvaluation::reset_batches()
+{
+	m_scores.clear();
+}
+
+float64_t CROCEvaluation::compute_roc()
+{
+	const int64_t pos_count=m_scores.get_num_positive();
+	const int64_t neg_count=m_scores.get_num_negative();
 
 	// assure both number of positive and negative examples is >0
 	REQUIRE(pos_count>0, "%s::evaluate_roc(): Number of positive labels is "
@@ -94,40 +77,70 @@ float64_t CROCEvaluation::evaluate_roc(CBinaryLabels* predicted, CBinaryLabels*
 	REQUIRE(neg_count>0, "%s::evaluate_roc(): Number of negative labels is "
 			"zero, ROC fails!\n", get_name());
 
-	int32_t j = 0;
-	float64_t label;
-
-	// create ROC curve and calculate auROC
-	for(i=0; i<length; i++)
+	const bool per_example=!m_scores.is_histogram();
+	if (m_compute_curve)
 	{
-		label = predicted->get_value(idxs[i]);
+		const index_t num_groups=m_scores.get_num_groups();
+		m_ROC_graph=SGMatrix<float64_t>(2, num_groups+1);
+		m_thresholds=SGVector<float64_t>(per_example ? pos_count+neg_count : num_groups);
+	}
+	else
+	{
+		m_ROC_graph=SGMatrix<float64_t>();
+		m_thresholds=SGVector<float64_t>();
+	}
 
-		if (label != threshold)
+	// true and false positives above the current threshold
+	int64_t tp=0;
+	int64_t fp=0;
+	float64_t area=0.0;
+	index_t j=0;
+	index_t i=0;
+
+	// every group of tied scores adds a point (fp/N, tp/P) before it,
+	// the area between two points is a trapezoid
+	m_scores.for_each_group([&](float64_t threshold, int64_t num_pos, int64_t num_neg)
+	{
+		if (m_compute_curve)
 		{
-			threshold = label;
-			m_ROC_graph[2*j] = fp/neg_count;
-			m_ROC_graph[2*j+1] = tp/pos_count;
-			j++;
+			m_ROC_graph[2*j]=float64_t(fp)/neg_count;
+			m_ROC_graph[2*j+1]=float64_t(tp)/pos_count;
+
+			if (per_example)
+			{
+				for (index_t k=0; k<num_pos+num_neg; k++)
+					m_thresholds[i+k]=threshold;
+			}
+			else
+				m_thresholds[j]=threshold;
 		}
 
-		m_thresholds[i]=threshold;
+		area+=num_neg*(tp+0.5*num_pos);
+		tp+=num_pos;
+		fp+=num_neg;
+		i+=num_pos+num_neg;
+		j++;
+	});
 
-		if (ground_truth->get_label(idxs[i]) > 0)
-			tp+=1.0;
-		else
-			fp+=1.0;
+	// add (1,1) to ROC curve
+	if (m_compute_curve)
+	{
+		m_ROC_graph[2*j]=1.0;
+		m_ROC_graph[2*j+1]=1.0;
 	}
 
-	// add (1,1) to ROC curve
-	m_ROC_graph[2*diff_count] = 1.0;
-	m_ROC_graph[2*diff_count+1] = 1.0;
+	m_auROC=area/pos_count/neg_count;
+	m_computed=true;
 
-	// calc auROC using area under curve
-	m_auROC = CMath::area_under_curve(m_ROC_graph.matrix,diff_count+1,false);
+	return m_auROC;
+}
 
-	m_computed = true;
+float64_t CROCEvaluation::get_auROC_error_bound()
+{
+	if (!m_computed)
+		SG_ERROR("Uninitialized, please call evaluate first")
 
-	return m_auROC;
+	return m_scores.get_auROC_error_bound();
 }
 
 SGMatrix<float64_t> CROCEvaluation::get_ROC()
@@ -11,6 +11,7 @@
 #include <shogun/lib/config.h>
 
 #include <shogun/evaluation/BinaryClassEvaluation.h>
+#include <shogun/evaluation/BinaryScores.h>
 
 namespace shogun
 {
@@ -25,13 +26,24 @@ class CLabels;
  *
  * Fawcett, Tom (2004) ROC Graphs:
  * Notes and Practical Considerations for Researchers; Machine Learning, 2004
+ *
+ * By default (AUC_SORTED) the scores are sorted with a parallel radix sort
+ * and the auROC is exact. With AUC_HISTOGRAM the scores are counted in a
+ * fixed number of bins, see BinaryScores, and the auROC is off by at most
+ * get_auROC_error_bound(). Predictions too large to hold at once can be
+ * added with add_batch() and evaluated with evaluate_batches(), which
+ * always uses a histogram.
+ *
+ * If the ROC graph is not needed, set_compute_curve(false) skips it and
+ * repeated evaluations do not allocate.
  */
 class CROCEvaluation: public CBinaryClassEvaluation
 {
 public:
 	/** constructor */
 	CROCEvaluation() :
-		CBinaryClassEvaluation(), m_computed(false)
+		CBinaryClassEvaluation(), m_auROC(0.0), m_computed(false),
+		m_method(AUC_SORTED), m_compute_curve(true)
 	{
 		m_ROC_graph = SGMatrix<float64_t>();
 		m_thresholds = SGVector<float64_t>();
@@ -70,6 +82,58 @@ public:
 	 */
 	SGVector<float64_t> get_thresholds();
 
+	/** adds predictions to those evaluated by evaluate_batches(), without
+	 * retaining them
+	 * @param predicted labels
+	 * @param ground_truth labels assumed to be correct
+	 */
+	void add_batch(CLabels* predicted, CLabels* ground_truth);
+
+	/** evaluate ROC and auROC of all batches added since the last
+	 * evaluate() or reset_batches()
+	 * @return auROC
+	 */
+	float64_t evaluate_batches();
+
+	/** removes all batches */
+	void reset_batches();
+
+	/** get upper bound of the error of the auROC, zero unless computed from
+	 * a histogram
+	 * @return error bound
+	 */
+	float64_t get_auROC_error_bound();
+
+	/** set method
+	 * @param method how to compute the auROC
+	 */
+	void set_method(EAUCMethod method) { m_method=method; }
+
+	/** get method
+	 * @return how the auROC is computed
+	 */
+	EAUCMethod get_method() const { return m_method; }
+
+	/** set number of bins of the histogram, removes all batches
+	 * @param num_bins number of bins
+	 */
+	void set_num_bins(index_t num_bins) { m_scores.set_num_bins(num_bins); }
+
+	/** get number of bins of the histogram
+	 * @return number of bins
+	 */
+	index_t get_num_bins() const { return m_scores.get_num_bins(); }
+
+	/** set whether to compute the ROC graph and thresholds
+	 * @param compute_curve whether to compute the ROC graph
+	 */
+	void set_compute_curve(bool compute_curve) { m_compute_curve=compute_curve; }
+
+	/** get whether the ROC graph and thresholds are computed
+	 * @return whether the ROC graph is computed
+	 */
+	bool get_compute_curve() const { return m_compute_curve; }
+
 protected:
 
 	/** evaluate ROC and auROC
@@ -79,12 +143,19 @@ protected:
 	 */
 	float64_t evaluate_roc(CBinaryLabels* predicted, CBinaryLabels* ground_truth);
 
+	/** evaluate ROC and auROC of m_scores
+	 * @return auROC
+	 */
+	float64_t compute_roc();
+
 protected:
 
 	/** 2-d array used to store ROC graph */
 	SGMatrix<float64_t> m_ROC_graph;
 
-	/** vector with thresholds corresponding to points on the ROC graph */
+	/** vector with thresholds corresponding to points on the ROC graph,
+	 * one per example if sorted, one per point if binned
+	 */
 	SGVector<float64_t> m_thresholds;
 
 	/** area under ROC graph */
@@ -92,6 +163,15 @@ protected:
 
 	/** indicator of ROC and auROC being computed already */
 	bool m_computed;
+
+	/** how the auROC is computed */
+	EAUCMethod m_method;
+
+	/** whether to compute the ROC graph and thresholds */
+	bool m_compute_curve;
+
+	/** sorted or binned scores */
+	BinaryScores m_scores;
 };
 
 }
@@ -238,7 +238,6 @@ int32_t CBinnedDotFeatures::get_nnz_features_for_vector(int32_t num) const
 
 void* CBinnedDotFeatures::get_feature_iterator(int32_t vector_index)
 {
-	SG_NOTIMPLEMENTED
 	return NULL;
 }
 
@@ -193,6 +193,25 @@ template<class ST> SGVector<ST> CDenseFeatures<ST>::get_feature_vector(int32_t n
 	return SGVector<ST>(vector, vlen, do_free);
 }
 
+template<class ST> SGVectorView<const ST> CDenseFeatures<ST>::get_feature_vector_view(int32_t num) const
+{
+	REQUIRE(num>=0 && num<get_num_vectors(),
+		"get_feature_vector_view(num=%d): num exceeds [0;%d]\n",
+		num, get_num_vectors()-1);
+	REQUIRE(can_view_feature_vectors(),
+		"get_feature_vector_view(num=%d): feature matrix is not in memory "
+		"or preprocessors are attached\n", num);
+
+	int32_t real_num=m_subset_stack->subset_idx_conversion(num);
+	return SGVectorView<const ST>(
+		&feature_matrix.matrix[real_num * int64_t(num_features)], num_features);
+}
+
+template<class ST> bool CDenseFeatures<ST>::can_view_feature_vectors() const
+{
+	return feature_matrix.matrix && !get_num_preprocessors();
+}
+
 template<class ST> void CDenseFeatures<ST>::free_feature_vector(ST* feat_vec, int32_t num, bool dofree) const
 {
 	if (feature_cache)
@@ -412,6 +431,13 @@ template<class ST> float64_t CDenseFeatures<ST>::dot(int32_t vec_idx1, CDotFeatu
 	ASSERT(df->get_feature_class() == get_feature_class())
 	CDenseFeatures<ST>* sf = (CDenseFeatures<ST>*) df;
 
+	if (can_view_feature_vectors() && sf->can_view_feature_vectors())
+	{
+		return linalg::dot(
+			get_feature_vector_view(vec_idx1),
+			sf->get_feature_vector_view(vec_idx2));
+	}
+
 	int32_t len1, len2;
 	bool free1, free2;
 
@@ -677,6 +703,13 @@ template<> float64_t CDenseFeatures<float64_t>::dense_dot(
 {
 	ASSERT(vec2_len == num_features)
 
+	if (can_view_feature_vectors())
+	{
+		return linalg::dot(
+			get_feature_vector_view(vec_idx1),
+			SGVectorView<const float64_t>(vec2, vec2_len));
+	}
+
 	int32_t vlen;
 	bool vfree;
 	float64_t* vec1 = get_feature_vector(vec_idx1, vlen, vfree);
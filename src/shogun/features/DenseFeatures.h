@@ -134,6 +134,25 @@ public:
 	 */
 	SGVector<ST> get_feature_vector(int32_t num) const;
 
+#ifndef SWIG // SWIG should skip this part
+	/** get a view of feature vector num in the feature matrix
+	 *
+	 * Nothing is copied and no reference counter is touched. The view
+	 * is valid as long as the feature matrix is not replaced.
+	 *
+	 * possible with subset
+	 *
+	 * @param num index of vector
+	 * @return read-only view of the feature vector
+	 */
+	SGVectorView<const ST> get_feature_vector_view(int32_t num) const;
+
+	/** @return whether get_feature_vector_view() can be used, i.e. the
+	 * feature matrix is in memory and no preprocessors are attached
+	 */
+	bool can_view_feature_vectors() const;
+#endif
+
 	/** free feature vector
 	 *
 	 * possible with subset
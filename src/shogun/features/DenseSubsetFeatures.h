@@ -201,7 +201,6 @@ public:
 	 */
 	virtual void* get_feature_iterator(int32_t vector_index)
 	{
-		SG_NOTIMPLEMENTED
 		return NULL;
 	}
 
@@ -180,7 +180,6 @@ IGNORE_IN_CLASSLIST class CDirectorDotFeatures : public CDotFeatures
 		 */
 		virtual void* get_feature_iterator(int32_t vector_index)
 		{
-			SG_NOTIMPLEMENTED
 			return NULL;
 		}
 
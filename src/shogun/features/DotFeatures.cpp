@@ -14,14 +14,48 @@
 #include <shogun/lib/Signal.h>
 #include <shogun/lib/Time.h>
 #include <shogun/mathematics/Math.h>
+#include <shogun/mathematics/StatisticsAccumulator.h>
 #include <shogun/mathematics/linalg/LinalgNamespace.h>
 
+#include <vector>
+
 #ifdef HAVE_OPENMP
 #include <omp.h>
 #endif
 
 using namespace shogun;
 
+/** adds all vectors of features to sum, every thread adds a contiguous
+ * range of vectors into its own buffer and the buffers are added in order */
+static void add_vectors(const CDotFeatures* features, SGVector<float64_t> sum)
+{
+	const int32_t num=features->get_num_vectors();
+	std::vector<SGVector<float64_t> > partials;
+
+#pragma omp parallel shared(partials)
+	{
+#ifdef HAVE_OPENMP
+		int32_t num_threads=omp_get_num_threads();
+		int32_t thread_num=omp_get_thread_num();
+#else
+		int32_t num_threads=1;
+		int32_t thread_num=0;
+#endif
+		#pragma omp single
+		partials.resize(num_threads);
+
+		SGVector<float64_t> partial(sum.vlen);
+		partial.zero();
+		#pragma omp for schedule(static)
+		for (int32_t i=0; i<num; ++i)
+			features->add_to_dense_vec(1, i, partial.vector, partial.vlen);
+		partials[thread_num]=partial;
+	}
+
+	for (const auto& partial : partials)
+		linalg::add(sum, partial, sum);
+}
+
 
 CDotFeatures::CDotFeatures(int32_t size)
 	:CFeatures(size)
@@ -188,10 +222,7 @@ SGVector<float64_t> CDotFeatures::get_mean() const
 
 	SGVector<float64_t> mean(dim);
 	linalg::zero(mean);
-
-	for (int32_t i = 0; i < num; ++i)
-		add_to_dense_vec(1, i, mean.vector, dim);
-
+	add_vectors(this, mean);
 	linalg::scale(mean, mean, 1.0 / num);
 
 	return mean;
@@ -204,35 +235,30 @@ SGVector<float64_t> CDotFeatures::get_std(bool colwise) const
 	ASSERT(num>0)
 	ASSERT(dim>0)
 
-	auto mean = get_mean();
+	StatisticsAccumulator<float64_t> statistics(dim);
+	statistics.add(const_cast<CDotFeatures*>(this));
+
 	if (!colwise)
 	{
+		/* squared deviations from the mean of all entries, from the ones
+		 * of every dimension */
+		auto mean = statistics.get_mean();
+		auto sum_sq = statistics.get_sum_of_squares();
 		auto global_mean = linalg::sum(mean) / dim;
-		linalg::set_const(mean, global_mean);
-	}
 
-	linalg::scale(mean, mean, -1.0);
-	SGVector<float64_t> std(dim);
-	for (index_t i = 0; i < num; ++i)
-	{
-		auto m = mean.clone();
-		add_to_dense_vec(1, i, m.vector, dim);
-		linalg::element_prod(m, m, m);
-		linalg::add(m, std, std);
-	}
+		float64_t total_sum_sq = 0;
+		for (index_t i = 0; i < dim; ++i)
+		{
+			total_sum_sq += sum_sq[i] +
+			                num * CMath::sq(mean[i] - global_mean);
+		}
 
-	if (!colwise)
-	{
 		SGVector<float64_t> global_std(1);
-		global_std[0] = std::sqrt(linalg::sum(std) / (num*dim));
+		global_std[0] = std::sqrt(total_sum_sq / (num*dim));
 		return global_std;
 	}
 
-	linalg::scale(std, std, 1.0 / num);
-	for (index_t i = 0; i < num; ++i)
-		std[i] = std::sqrt(std[i]);
-
-	return std;
+	return statistics.get_std();
 }
 
 SGVector<float64_t>
@@ -250,13 +276,8 @@ CDotFeatures::compute_mean(CDotFeatures* lhs, CDotFeatures* rhs)
 
 	SGVector<float64_t> mean(dim);
 	linalg::zero(mean);
-
-	for (int i = 0; i < num_lhs; i++)
-		lhs->add_to_dense_vec(1, i, mean.vector, dim);
-
-	for (int i = 0; i < num_rhs; i++)
-		rhs->add_to_dense_vec(1, i, mean.vector, dim);
-
+	add_vectors(lhs, mean);
+	add_vectors(rhs, mean);
 	linalg::scale(mean, mean, 1.0 / (num_lhs + num_rhs));
 
 	return mean;
@@ -269,107 +290,27 @@ SGMatrix<float64_t> CDotFeatures::get_cov(bool copy_data_for_speed) const
 	ASSERT(num>0)
 	ASSERT(dim>0)
 
-	SGMatrix<float64_t> cov(dim, dim);
-	SGVector<float64_t> mean = get_mean();
-
-	if (copy_data_for_speed)
-	{
-		SGMatrix<float64_t> centered_data(dim, num);
-		for (int i = 0; i < num; i++)
-		{
-			SGVector<float64_t> v = get_computed_dot_feature_vector(i);
-			centered_data.set_column(i, linalg::add(v, mean, 1.0, -1.0));
-		}
-
-		cov = linalg::matrix_prod(centered_data, centered_data, false, true);
-	}
-	else
-	{
-		linalg::zero(cov);
-		for (int i = 0; i < num; i++)
-		{
-			SGVector<float64_t> v = get_computed_dot_feature_vector(i);
-			linalg::add(v, mean, v, 1.0, -1.0);
-			for (int m = 0; m < v.vlen; m++)
-				linalg::add_col_vec(cov, m, v, cov, 1.0, v.vector[m]);
-		}
-		for (int m = 0; m < dim - 1; m++)
-		{
-			for (int n = m + 1; n < dim; n++)
-			{
-				(cov.matrix)[m * dim + n] = (cov.matrix)[n * dim + m];
-			}
-		}
-	}
-	linalg::scale(cov, cov, 1.0 / num);
+	StatisticsAccumulator<float64_t> statistics(dim, true);
+	statistics.add(const_cast<CDotFeatures*>(this));
 
-	return cov;
+	return statistics.get_cov();
 }
 
 SGMatrix<float64_t> CDotFeatures::compute_cov(
     CDotFeatures* lhs, CDotFeatures* rhs, bool copy_data_for_speed)
 {
-	CDotFeatures* feats[2];
-	feats[0]=lhs;
-	feats[1]=rhs;
-
-	int32_t nums[2], dims[2], num=0;
-
-	for (int i = 0; i < 2; i++)
-	{
-		nums[i]=feats[i]->get_num_vectors();
-		dims[i]=feats[i]->get_dim_feature_space();
-		ASSERT(nums[i]>0)
-		ASSERT(dims[i]>0)
-		num += nums[i];
-	}
-
-	ASSERT(dims[0]==dims[1])
-	int32_t dim = dims[0];
-
-	SGMatrix<float64_t> cov(dim, dim);
-	SGVector<float64_t> mean = compute_mean(lhs, rhs);
-
-	if (copy_data_for_speed)
-	{
-		SGMatrix<float64_t> centered_data(dim, num);
-		for (int i = 0; i < num; i++)
-		{
-			SGVector<float64_t> v =
-			    i < nums[0] ? lhs->get_computed_dot_feature_vector(i)
-			                : rhs->get_computed_dot_feature_vector(i - nums[0]);
-
-			centered_data.set_column(i, linalg::add(v, mean, 1.0, -1.0));
-		}
-
-		cov = linalg::matrix_prod(centered_data, centered_data, false, true);
-	}
-	else
-	{
-		linalg::zero(cov);
-		for (int i = 0; i < 2; i++)
-		{
-			for (int j = 0; j < nums[i]; j++)
-			{
-				SGVector<float64_t> v =
-				    feats[i]->get_computed_dot_feature_vector(j);
-				linalg::add(v, mean, v, 1.0, -1.0);
-				for (int m = 0; m < v.vlen; m++)
-					linalg::add_col_vec(cov, m, v, cov, 1.0, v.vector[m]);
-			}
-		}
+	ASSERT(lhs && rhs)
+	ASSERT(lhs->get_num_vectors()>0)
+	ASSERT(rhs->get_num_vectors()>0)
+	ASSERT(lhs->get_dim_feature_space()>0)
+	ASSERT(lhs->get_dim_feature_space()==rhs->get_dim_feature_space())
 
-		for (int m = 0; m < dim - 1; m++)
-		{
-			for (int n = m + 1; n < dim; n++)
-			{
-				(cov.matrix[m * dim + n]) = (cov.matrix)[n * dim + m];
-			}
-		}
-	}
-	linalg::scale(cov, cov, 1.0 / num);
+	StatisticsAccumulator<float64_t> statistics(
+	    lhs->get_dim_feature_space(), true);
+	statistics.add(lhs);
+	statistics.add(rhs);
 
-	return cov;
+	return statistics.get_cov();
 }
 
 void CDotFeatures::init()
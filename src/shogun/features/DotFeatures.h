@@ -14,6 +14,7 @@
 #include <shogun/lib/common.h>
 #include <shogun/features/Features.h>
 #include <shogun/lib/SGMatrix.h>
+#include <shogun/lib/SGVectorView.h>
 
 namespace shogun
 {
@@ -102,6 +103,31 @@ class CDotFeatures : public CFeatures
 		 */
 		virtual void add_to_dense_vec(float64_t alpha, int32_t vec_idx1, float64_t* vec2, int32_t vec2_len, bool abs_val=false) const = 0;
 
+#ifndef SWIG // SWIG should skip this part
+		/** compute dot product between vector1 and a dense vector view.
+		 * Unlike dense_dot_sgvec(), no reference counting is involved.
+		 *
+		 * @param vec_idx1 index of first vector
+		 * @param vec2 dense vector
+		 */
+		float64_t dense_dot_view(int32_t vec_idx1, SGVectorView<const float64_t> vec2) const
+		{
+			return dense_dot(vec_idx1, vec2.data(), vec2.size());
+		}
+
+		/** add vector 1 multiplied with alpha to a dense vector view
+		 *
+		 * @param alpha scalar alpha
+		 * @param vec_idx1 index of first vector
+		 * @param vec2 dense vector
+		 * @param abs_val if true add the absolute value
+		 */
+		void add_to_dense_vec_view(float64_t alpha, int32_t vec_idx1, SGVectorView<float64_t> vec2, bool abs_val=false) const
+		{
+			add_to_dense_vec(alpha, vec_idx1, vec2.data(), vec2.size(), abs_val);
+		}
+#endif
+
 		/** Compute the dot product for a range of vectors. This function makes use of dense_dot
 		 * alphas[i] * sparse[i]^T * w + b
 		 *
@@ -159,7 +185,8 @@ class CDotFeatures : public CFeatures
 		 *
 		 * @param vector_index the index of the vector over whose components to
 		 *			iterate over
-		 * @return feature iterator (to be passed to get_next_feature)
+		 * @return feature iterator (to be passed to get_next_feature), NULL if
+		 *			the features cannot be iterated over
 		 */
 		virtual void* get_feature_iterator(int32_t vector_index)=0;
 
@@ -205,21 +232,17 @@ class CDotFeatures : public CFeatures
 
 		/** get covariance
 		 *
-		 * @param copy_data_for_speed if true, the method stores explicitly
-		 * the centered data matrix and the covariance is calculated by matrix
-		 * product of the centered data with its transpose, this make it
-		 * possible to take advantage of multithreaded matrix product,
-		 * this may not be possible if the data doesn't fit into memory,
-		 * in such case set this parameter to false to compute iteratively
-		 * the covariance matrix without storing the centered data.
-		 * [default = true]
+		 * The covariance is accumulated chunk by chunk in parallel, see
+		 * StatisticsAccumulator, without storing the centered data.
+		 *
+		 * @param copy_data_for_speed unused, kept for compatibility
 		 * @return covariance
 		 */
 		virtual SGMatrix<float64_t> get_cov(bool copy_data_for_speed = true) const;
 
 		/** compute the covariance of two CDotFeatures together
 		 *
-		 * @param copy_data_for_speed @see CDotFeatures::get_cov
+		 * @param copy_data_for_speed unused, kept for compatibility
 		 * @return covariance
 		 */
 		static SGMatrix<float64_t> compute_cov(
@@ -153,7 +153,6 @@ CFeatures* CExplicitSpecFeatures::duplicate() const
 
 void* CExplicitSpecFeatures::get_feature_iterator(int32_t vector_index)
 {
-	SG_NOTIMPLEMENTED
 	return NULL;
 }
 
@@ -78,7 +78,6 @@ int32_t CLBPPyrDotFeatures::get_num_vectors() const
 
 void* CLBPPyrDotFeatures::get_feature_iterator(int32_t vector_index)
 {
-	SG_NOTIMPLEMENTED
 	return NULL;
 }
 
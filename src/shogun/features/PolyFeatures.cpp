@@ -83,7 +83,6 @@ int32_t CPolyFeatures::get_num_vectors() const
 
 void* CPolyFeatures::get_feature_iterator(int32_t vector_index)
 {
-	SG_NOTIMPLEMENTED
 	return NULL;
 }
 
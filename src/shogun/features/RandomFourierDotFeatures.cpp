@@ -6,7 +6,13 @@
 
 #include <shogun/base/Parameter.h>
 #include <shogun/mathematics/Math.h>
+#include <shogun/mathematics/eigen3.h>
 #include <shogun/features/RandomFourierDotFeatures.h>
+#include <shogun/lib/external/falconn/ffht/fht.h>
+
+#include <random>
+
+using namespace Eigen;
 
 namespace shogun {
 
@@ -18,11 +24,16 @@ CRandomFourierDotFeatures::CRandomFourierDotFeatures()
 }
 
 CRandomFourierDotFeatures::CRandomFourierDotFeatures(CDotFeatures* features,
-	int32_t D, KernelName kernel_name, SGVector<float64_t> params)
+	int32_t D, KernelName kernel_name, SGVector<float64_t> params,
+	ERandomProjection random_projection)
 : CRandomKitchenSinksDotFeatures(features, D)
 {
 	init(kernel_name, params);
-	random_coeff = generate_random_coefficients();
+	projection = random_projection;
+	if (projection==RP_FASTFOOD)
+		generate_fastfood();
+	else
+		random_coeff = generate_random_coefficients();
 }
 
 CRandomFourierDotFeatures::CRandomFourierDotFeatures(CDotFeatures* features,
@@ -42,6 +53,13 @@ CRandomFourierDotFeatures::CRandomFourierDotFeatures(const CRandomFourierDotFeat
 : CRandomKitchenSinksDotFeatures(orig)
 {
 	init(orig.kernel, orig.kernel_params);
+	projection = orig.projection;
+	fastfood_dim = orig.fastfood_dim;
+	fastfood_signs = orig.fastfood_signs;
+	fastfood_permutation = orig.fastfood_permutation;
+	fastfood_gaussian = orig.fastfood_gaussian;
+	fastfood_scaling = orig.fastfood_scaling;
+	fastfood_offsets = orig.fastfood_offsets;
 }
 
 CRandomFourierDotFeatures::~CRandomFourierDotFeatures()
@@ -53,6 +71,8 @@ CRandomFourierDotFeatures::~CRandomFourierDotFeatures()
 	{
 		kernel = kernel_name;
 		kernel_params = params;
+		projection = RP_DENSE;
+		fastfood_dim = 0;
 
 		constant = num_samples > 0 ? std::sqrt(2.0 / num_samples) : 1;
 		SG_ADD(
@@ -62,6 +82,24 @@ CRandomFourierDotFeatures::~CRandomFourierDotFeatures()
 		SG_ADD_OPTIONS(
 		    (machine_int_t*)&kernel, "kernel", "The kernel to approximate",
 		    ParameterProperties::NONE, SG_OPTIONS(GAUSSIAN, NOT_SPECIFIED));
+		SG_ADD_OPTIONS(
+		    (machine_int_t*)&projection, "projection",
+		    "Representation of the random projection",
+		    ParameterProperties::NONE, SG_OPTIONS(RP_DENSE, RP_FASTFOOD));
+		SG_ADD(&fastfood_dim, "fastfood_dim", "Padded dimension of Fastfood blocks");
+		SG_ADD(&fastfood_signs, "fastfood_signs", "Random signs of Fastfood blocks");
+		SG_ADD(
+		    &fastfood_permutation, "fastfood_permutation",
+		    "Random permutations of Fastfood blocks");
+		SG_ADD(
+		    &fastfood_gaussian, "fastfood_gaussian",
+		    "Gaussian diagonals of Fastfood blocks");
+		SG_ADD(
+		    &fastfood_scaling, "fastfood_scaling",
+		    "Row scaling of Fastfood blocks");
+		SG_ADD(
+		    &fastfood_offsets, "fastfood_offsets",
+		    "Random offsets of Fastfood features");
 	}
 
 CFeatures* CRandomFourierDotFeatures::duplicate() const
@@ -74,12 +112,203 @@ const char* CRandomFourierDotFeatures::get_name() const
 	return "RandomFourierDotFeatures";
 }
 
+ERandomProjection CRandomFourierDotFeatures::get_projection() const
+{
+	return projection;
+}
+
 float64_t CRandomFourierDotFeatures::post_dot(float64_t dot_result, index_t par_idx) const
 {
-	dot_result += random_coeff(random_coeff.num_rows-1, par_idx);
+	if (projection==RP_FASTFOOD)
+		dot_result += fastfood_offsets[par_idx];
+	else
+		dot_result += random_coeff(random_coeff.num_rows-1, par_idx);
 	return std::cos(dot_result) * constant;
 }
 
+float64_t CRandomFourierDotFeatures::dot(index_t vec_idx, index_t par_idx) const
+{
+	if (projection!=RP_FASTFOOD)
+		return CRandomKitchenSinksDotFeatures::dot(vec_idx, par_idx);
+
+	SGVector<float64_t> x = feats->get_computed_dot_feature_vector(vec_idx);
+	SGVector<float64_t> projections(num_samples);
+	fastfood_project(x.vector, projections.vector);
+	return projections[par_idx];
+}
+
+float64_t CRandomFourierDotFeatures::dot(int32_t vec_idx1, CDotFeatures* df,
+	int32_t vec_idx2) const
+{
+	if (projection!=RP_FASTFOOD)
+		return CRandomKitchenSinksDotFeatures::dot(vec_idx1, df, vec_idx2);
+
+	ASSERT(df->get_name()==get_name())
+	CRandomFourierDotFeatures* other = (CRandomFourierDotFeatures*) df;
+	ASSERT(get_dim_feature_space()==other->get_dim_feature_space())
+
+	SGVector<float64_t> z1(num_samples);
+	SGVector<float64_t> z2(num_samples);
+	SGVector<float64_t> x1 = feats->get_computed_dot_feature_vector(vec_idx1);
+	SGVector<float64_t> x2 = other->feats->get_computed_dot_feature_vector(vec_idx2);
+	compute_feature_vector(x1.vector, z1.vector);
+	other->compute_feature_vector(x2.vector, z2.vector);
+	return Map<VectorXd>(z1.vector, num_samples).dot(
+		Map<VectorXd>(z2.vector, num_samples));
+}
+
+float64_t CRandomFourierDotFeatures::dense_dot(int32_t vec_idx1,
+	const float64_t* vec2, int32_t vec2_len) const
+{
+	if (projection!=RP_FASTFOOD)
+		return CRandomKitchenSinksDotFeatures::dense_dot(vec_idx1, vec2, vec2_len);
+
+	ASSERT(vec2_len==get_dim_feature_space())
+	SGVector<float64_t> x = feats->get_computed_dot_feature_vector(vec_idx1);
+	SGVector<float64_t> z(num_samples);
+	compute_feature_vector(x.vector, z.vector);
+	return Map<VectorXd>(z.vector, num_samples).dot(
+		Map<const VectorXd>(vec2, num_samples));
+}
+
+void CRandomFourierDotFeatures::add_to_dense_vec(float64_t alpha,
+	int32_t vec_idx1, float64_t* vec2, int32_t vec2_len, bool abs_val) const
+{
+	if (projection!=RP_FASTFOOD)
+	{
+		CRandomKitchenSinksDotFeatures::add_to_dense_vec(alpha, vec_idx1,
+			vec2, vec2_len, abs_val);
+		return;
+	}
+
+	ASSERT(vec2_len==get_dim_feature_space())
+	SGVector<float64_t> x = feats->get_computed_dot_feature_vector(vec_idx1);
+	SGVector<float64_t> z(num_samples);
+	compute_feature_vector(x.vector, z.vector);
+	for (index_t i=0; i<num_samples; i++)
+		vec2[i] += abs_val ? CMath::abs(alpha*z[i]) : alpha*z[i];
+}
+
+SGMatrix<float64_t> CRandomFourierDotFeatures::get_feature_vectors(
+	int32_t start, int32_t stop) const
+{
+	REQUIRE(start>=0 && start<=stop && stop<=get_num_vectors(),
+		"Range [%d, %d) must lie in [0, %d)\n", start, stop, get_num_vectors());
+
+	const int32_t dim = feats->get_dim_feature_space();
+	SGMatrix<float64_t> result(num_samples, stop-start);
+	if (projection==RP_FASTFOOD)
+	{
+		#pragma omp parallel for schedule(dynamic)
+		for (int32_t i=start; i<stop; i++)
+		{
+			SGVector<float64_t> x = feats->get_computed_dot_feature_vector(i);
+			compute_feature_vector(x.vector, result.get_column_vector(i-start));
+		}
+		return result;
+	}
+
+	/* one product of the coefficients with all vectors */
+	SGMatrix<float64_t> vectors(dim, stop-start);
+	#pragma omp parallel for schedule(dynamic)
+	for (int32_t i=start; i<stop; i++)
+	{
+		SGVector<float64_t> x = feats->get_computed_dot_feature_vector(i);
+		sg_memcpy(vectors.get_column_vector(i-start), x.vector, dim*sizeof(float64_t));
+	}
+
+	Map<MatrixXd> coeff(random_coeff.matrix, random_coeff.num_rows, random_coeff.num_cols);
+	Map<MatrixXd> map_vectors(vectors.matrix, dim, stop-start);
+	Map<MatrixXd> map_result(result.matrix, num_samples, stop-start);
+	map_result.noalias() = coeff.topRows(dim).transpose()*map_vectors;
+	map_result.colwise() += coeff.row(dim).transpose();
+	map_result = map_result.array().cos()*constant;
+	return result;
+}
+
+void CRandomFourierDotFeatures::generate_fastfood()
+{
+	REQUIRE(kernel==GAUSSIAN, "Fastfood approximates the Gaussian kernel only\n");
+
+	/* the AVX transform processes at least 8 values */
+	const int32_t dim = feats->get_dim_feature_space();
+	fastfood_dim = 8;
+	while (fastfood_dim<dim)
+		fastfood_dim *= 2;
+
+	const int32_t num_blocks = (num_samples+fastfood_dim-1)/fastfood_dim;
+	const int32_t len = num_blocks*fastfood_dim;
+	fastfood_signs = SGVector<float64_t>(len);
+	fastfood_permutation = SGVector<int32_t>(len);
+	fastfood_gaussian = SGVector<float64_t>(len);
+	fastfood_scaling = SGVector<float64_t>(len);
+	fastfood_offsets = SGVector<float64_t>(num_samples);
+
+	/* the rows of HG\Pi HB with orthonormal H have norm |G|/sqrt(d) and
+	 * are scaled to the lengths of Gaussian vectors with variance 2/width,
+	 * whose squares are chi-square distributed */
+	std::mt19937_64 prng(CMath::random());
+	std::gamma_distribution<float64_t> chi_square(fastfood_dim/2.0, 2.0);
+	const float64_t width_scale = std::sqrt(2.0/kernel_params[0]);
+	for (int32_t block=0; block<num_blocks; block++)
+	{
+		const int32_t first = block*fastfood_dim;
+		float64_t norm = 0;
+		for (int32_t i=0; i<fastfood_dim; i++)
+		{
+			fastfood_signs[first+i] = CMath::random(0.0, 1.0)<0.5 ? -1 : 1;
+			fastfood_gaussian[first+i] = CMath::normal_random(0.0, 1.0);
+			norm += CMath::sq(fastfood_gaussian[first+i]);
+			fastfood_permutation[first+i] = i;
+		}
+		for (int32_t i=fastfood_dim-1; i>0; i--)
+			CMath::swap(fastfood_permutation[first+i],
+				fastfood_permutation[first+CMath::random(0, i)]);
+		for (int32_t i=0; i<fastfood_dim; i++)
+		{
+			fastfood_scaling[first+i] =
+				std::sqrt(chi_square(prng)*fastfood_dim/norm)*width_scale;
+		}
+	}
+
+	for (int32_t i=0; i<num_samples; i++)
+		fastfood_offsets[i] = CMath::random(0.0, 2 * CMath::PI);
+}
+
+void CRandomFourierDotFeatures::fastfood_project(const float64_t* x,
+	float64_t* result) const
+{
+	const int32_t dim = feats->get_dim_feature_space();
+
+	/* Eigen aligns its vectors as the AVX transform requires */
+	VectorXd buffer(fastfood_dim);
+	VectorXd permuted(fastfood_dim);
+	for (int32_t first=0; first<num_samples; first+=fastfood_dim)
+	{
+		for (int32_t i=0; i<fastfood_dim; i++)
+			buffer[i] = i<dim ? fastfood_signs[first+i]*x[i] : 0;
+		int32_t status = FHTDouble(buffer.data(), fastfood_dim, fastfood_dim);
+
+		for (int32_t i=0; i<fastfood_dim; i++)
+			permuted[i] = fastfood_gaussian[first+i]*buffer[fastfood_permutation[first+i]];
+		status |= FHTDouble(permuted.data(), fastfood_dim, fastfood_dim);
+		REQUIRE(!status, "Hadamard transform failed, the Fastfood dimension "
+			"(%d) has to be a power of two of at least 8\n", fastfood_dim);
+
+		const int32_t stop = CMath::min(fastfood_dim, num_samples-first);
+		for (int32_t i=0; i<stop; i++)
+			result[first+i] = fastfood_scaling[first+i]*permuted[i];
+	}
+}
+
+void CRandomFourierDotFeatures::compute_feature_vector(const float64_t* x,
+	float64_t* result) const
+{
+	fastfood_project(x, result);
+	for (int32_t i=0; i<num_samples; i++)
+		result[i] = std::cos(result[i]+fastfood_offsets[i])*constant;
+}
+
 SGVector<float64_t> CRandomFourierDotFeatures::generate_random_parameter_vector()
 {
 	SGVector<float64_t> vec(feats->get_dim_feature_space()+1);
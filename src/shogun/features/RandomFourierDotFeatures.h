@@ -31,6 +31,18 @@ enum KernelName
 	NOT_SPECIFIED
 };
 
+/** representations of the random projection */
+enum ERandomProjection
+{
+	/** dense D x d matrix of random coefficients */
+	RP_DENSE,
+
+	/** Fastfood, products of Hadamard, permutation and diagonal matrices
+	 * that need O(D) memory and O(D log d) time per vector
+	 */
+	RP_FASTFOOD
+};
+
 /** @brief This class implements the random fourier features for the DotFeatures
  *  framework.
  *  Basically upon the object creation it computes the random coefficients, namely w and b,
@@ -38,8 +50,17 @@ enum KernelName
  *  based on the following formula z(x) = sqrt(2/D) * cos(w'*x + b), where D is the number
  *  of samples that are used.
  *
+ *  Instead of a dense matrix of Gaussian coefficients w, Fastfood uses blocks
+ *  \f$V = SHG\Pi HB\f$ of the size of the data dimension, padded to a power of two,
+ *  with Walsh-Hadamard matrices H, a random permutation \f$\Pi\f$ and random diagonal
+ *  matrices B (signs), G (Gaussian) and S (scaling of the rows to the lengths of
+ *  Gaussian vectors). The Hadamard products are computed with the fast
+ *  Walsh-Hadamard transform.
+ *
  *  For more detailed information you can take a look at this source:
  *  i) Random Features for Large-Scale Kernel Machines - Ali Rahimi and Ben Recht
+ *  ii) Fastfood - Approximating Kernel Expansions in Loglinear Time - Quoc Le,
+ *  Tamas Sarlos and Alex Smola
  */
 class CRandomFourierDotFeatures : public CRandomKitchenSinksDotFeatures
 {
@@ -55,9 +76,10 @@ public:
 	 * @param D the number of random fourier samples to draw / dimensionality of new feature space
 	 * @param kernel_name the name of the kernel to approximate
 	 * @param params kernel parameters (see kernel's description in KernelName to see what each kernel expects)
+	 * @param projection representation of the random projection
 	 */
 	CRandomFourierDotFeatures(CDotFeatures* features, int32_t D, KernelName kernel_name,
-			SGVector<float64_t> params);
+			SGVector<float64_t> params, ERandomProjection projection=RP_DENSE);
 
 	/** constructor that uses the specified random coefficients.
 	 *
@@ -88,8 +110,56 @@ public:
 	/** @return object name */
 	virtual const char* get_name() const;
 
+	/** @return representation of the random projection */
+	ERandomProjection get_projection() const;
+
+	/** compute dot product between vector1 and vector2,
+	 * appointed by their indices
+	 *
+	 * @param vec_idx1 index of first vector
+	 * @param df DotFeatures (of same kind) to compute dot product with
+	 * @param vec_idx2 index of second vector
+	 */
+	virtual float64_t dot(int32_t vec_idx1, CDotFeatures* df, int32_t vec_idx2) const;
+
+	/** compute dot product between vector1 and a dense vector
+	 *
+	 * @param vec_idx1 index of first vector
+	 * @param vec2 pointer to real valued vector
+	 * @param vec2_len length of real valued vector
+	 */
+	virtual float64_t dense_dot(int32_t vec_idx1, const float64_t* vec2, int32_t vec2_len) const;
+
+	/** add vector 1 multiplied with alpha to dense vector2
+	 *
+	 * @param alpha scalar alpha
+	 * @param vec_idx1 index of first vector
+	 * @param vec2 pointer to real valued vector
+	 * @param vec2_len length of real valued vector
+	 * @param abs_val if true add the absolute value
+	 */
+	virtual void add_to_dense_vec(float64_t alpha, int32_t vec_idx1,
+			float64_t* vec2, int32_t vec2_len, bool abs_val=false) const;
+
+	/** Computes the random features of vectors start, ..., stop-1 at once,
+	 * in parallel
+	 *
+	 * @param start first vector
+	 * @param stop vector after the last one
+	 * @return matrix with the D random features of every vector as columns
+	 */
+	SGMatrix<float64_t> get_feature_vectors(int32_t start, int32_t stop) const;
+
 protected:
 
+	/** dot product of a vector with the random parameter vector par_idx
+	 *
+	 * @param vec_idx index of vector
+	 * @param par_idx index of the parameter vector
+	 * @return the dot product
+	 */
+	virtual float64_t dot(index_t vec_idx, index_t par_idx) const;
+
 	/** subclass must override this to perform any operations
 	 * on the dot result between a feature vector and a parameter vector w
 	 *
@@ -108,7 +178,45 @@ protected:
 private:
 	void init(KernelName kernel_name, SGVector<float64_t> params);
 
+	/** draws the diagonal matrices and permutations of the Fastfood blocks */
+	void generate_fastfood();
+
+	/** computes the D random features of a vector
+	 *
+	 * @param x vector of the dimension of the features
+	 * @param result D random features
+	 */
+	void compute_feature_vector(const float64_t* x, float64_t* result) const;
+
+	/** computes the Fastfood projections of a vector, without offsets
+	 *
+	 * @param x vector of the dimension of the features
+	 * @param result D projections
+	 */
+	void fastfood_project(const float64_t* x, float64_t* result) const;
+
 private:
+	/** representation of the random projection */
+	ERandomProjection projection;
+
+	/** dimension of the features padded to a power of two */
+	int32_t fastfood_dim;
+
+	/** random signs B of the Fastfood blocks */
+	SGVector<float64_t> fastfood_signs;
+
+	/** random permutations of the Fastfood blocks */
+	SGVector<int32_t> fastfood_permutation;
+
+	/** Gaussian diagonals G of the Fastfood blocks */
+	SGVector<float64_t> fastfood_gaussian;
+
+	/** row scaling S of the Fastfood blocks, including the kernel width */
+	SGVector<float64_t> fastfood_scaling;
+
+	/** random offsets b of the Fastfood features */
+	SGVector<float64_t> fastfood_offsets;
+
 	/** the kernel to approximate */
 	KernelName kernel;
 
@@ -12,7 +12,8 @@
 namespace shogun
 {
 
-static std::shared_ptr<CRandomFourierDotFeatures> createRandomData(const benchmark::State& state)
+static std::shared_ptr<CRandomFourierDotFeatures> createRandomData(const benchmark::State& state,
+		ERandomProjection projection=RP_DENSE)
 {
 	index_t num_dim = state.range(0);
 	index_t num_vecs = 10000;
@@ -28,7 +29,8 @@ static std::shared_ptr<CRandomFourierDotFeatures> createRandomData(const benchma
 	auto dense_feats = new CDenseFeatures<float64_t>(mat);
 	SGVector<float64_t> params(1);
 	params[0] = num_dim - 20;
-	return std::make_shared<CRandomFourierDotFeatures>(dense_feats, state.range(1), KernelName::GAUSSIAN, params);
+	return std::make_shared<CRandomFourierDotFeatures>(dense_feats, state.range(1), KernelName::GAUSSIAN, params,
+			projection);
 }
 
 class RFFixture : public benchmark::Fixture
@@ -47,10 +49,33 @@ public:
 	SGVector<float64_t> w;
 };
 
+class RFFastfoodFixture : public RFFixture
+{
+public:
+	void SetUp(const ::benchmark::State& st)
+	{
+		f = createRandomData(st, RP_FASTFOOD);
+		w = SGVector<float64_t>(f->get_dim_feature_space());
+		w.range_fill(17.0);
+	}
+};
+
+#define RANDOMFOURIER_BENCHMARK_FEATUREVECTORS(FIXTURE, NAME)	\
+BENCHMARK_DEFINE_F(FIXTURE, NAME)(benchmark::State& state)	\
+{															\
+	for (auto _ : state)									\
+		f->get_feature_vectors(0, f->get_num_vectors());	\
+}															\
+BENCHMARK_REGISTER_F(FIXTURE, NAME)
+
 #define ADD_RANDOMFOURIER_ARGS(WHAT)	\
 	WHAT->RangeMultiplier(2)->Ranges({{128, 512}, {64, 512}})->Unit(benchmark::kMillisecond);
 
 ADD_RANDOMFOURIER_ARGS(DOTFEATURES_BENCHMARK_DENSEDOT(RFFixture, RandomFourierDotFeatures_DenseDot))
 ADD_RANDOMFOURIER_ARGS(DOTFEATURES_BENCHMARK_ADDDENSE(RFFixture, RandomFourierDotFeatures_AddDense))
+ADD_RANDOMFOURIER_ARGS(RANDOMFOURIER_BENCHMARK_FEATUREVECTORS(RFFixture, RandomFourierDotFeatures_FeatureVectors))
+ADD_RANDOMFOURIER_ARGS(DOTFEATURES_BENCHMARK_DENSEDOT(RFFastfoodFixture, RandomFourierDotFeatures_Fastfood_DenseDot))
+ADD_RANDOMFOURIER_ARGS(DOTFEATURES_BENCHMARK_ADDDENSE(RFFastfoodFixture, RandomFourierDotFeatures_Fastfood_AddDense))
+ADD_RANDOMFOURIER_ARGS(RANDOMFOURIER_BENCHMARK_FEATUREVECTORS(RFFastfoodFixture, RandomFourierDotFeatures_Fastfood_FeatureVectors))
 
 }
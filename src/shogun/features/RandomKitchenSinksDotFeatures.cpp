@@ -145,7 +145,6 @@ int32_t CRandomKitchenSinksDotFeatures::get_nnz_features_for_vector(int32_t num)
 
 void* CRandomKitchenSinksDotFeatures::get_feature_iterator(int32_t vector_index)
 {
-	SG_NOTIMPLEMENTED;
 	return NULL;
 }
 
@@ -85,7 +85,7 @@ template<class ST> ST CSparseFeatures<ST>::get_feature(int32_t num, int32_t inde
 		"get_feature(num=%d,index=%d): index exceeds [0;%d]\n",
 		num, index, get_num_features()-1);
 
-	SGSparseVector<ST> sv=get_sparse_feature_vector(num);
+	SGSparseVector<ST> sv=get_sparse_feature_vector_unowned(num);
 	ST ret = sv.get_feature(index);
 
 	free_sparse_feature_vector(num);
@@ -102,7 +102,7 @@ template<class ST> SGVector<ST> CSparseFeatures<ST>::get_full_feature_vector(int
 
 template<class ST> int32_t CSparseFeatures<ST>::get_nnz_features_for_vector(int32_t num) const
 {
-	SGSparseVector<ST> sv = get_sparse_feature_vector(num);
+	SGSparseVector<ST> sv = get_sparse_feature_vector_unowned(num);
 	int32_t len=sv.num_feat_entries;
 	free_sparse_feature_vector(num);
 	return len;
@@ -170,9 +170,44 @@ template<class ST> SGSparseVector<ST> CSparseFeatures<ST>::get_sparse_feature_ve
 	}
 }
 
+template<class ST> SGVectorView<const SGSparseVectorEntry<ST> >
+CSparseFeatures<ST>::get_sparse_feature_view(int32_t num) const
+{
+	REQUIRE(num>=0 && num<get_num_vectors(),
+		"get_sparse_feature_view(num=%d): num exceeds [0;%d]\n",
+		num, get_num_vectors()-1);
+	REQUIRE(can_view_feature_vectors(),
+		"get_sparse_feature_view(num=%d): sparse feature matrix is not in "
+		"memory\n", num);
+
+	index_t real_num=m_subset_stack->subset_idx_conversion(num);
+	const SGSparseVector<ST>& sv=sparse_feature_matrix.sparse_matrix[real_num];
+
+	return SGVectorView<const SGSparseVectorEntry<ST> >(
+		sv.features, sv.num_feat_entries);
+}
+
+template<class ST> bool CSparseFeatures<ST>::can_view_feature_vectors() const
+{
+	return sparse_feature_matrix.sparse_matrix!=NULL;
+}
+
+template<class ST> SGSparseVector<ST>
+CSparseFeatures<ST>::get_sparse_feature_vector_unowned(int32_t num) const
+{
+	if (!can_view_feature_vectors())
+		return get_sparse_feature_vector(num);
+
+	SGVectorView<const SGSparseVectorEntry<ST> > view=
+		get_sparse_feature_view(num);
+
+	return SGSparseVector<ST>(
+		const_cast<SGSparseVectorEntry<ST>*>(view.data()), view.size(), false);
+}
+
 template<class ST> ST CSparseFeatures<ST>::dense_dot(ST alpha, int32_t num, ST* vec, int32_t dim, ST b) const
 {
-	SGSparseVector<ST> sv=get_sparse_feature_vector(num);
+	SGSparseVector<ST> sv=get_sparse_feature_vector_unowned(num);
 	ST result = sv.dense_dot(alpha,vec,dim,b);
 	free_sparse_feature_vector(num);
 	return result;
@@ -186,7 +221,7 @@ template<class ST> void CSparseFeatures<ST>::add_to_dense_vec(float64_t alpha, i
 		"add_to_dense_vec(num=%d,dim=%d): dim should contain number of features %d\n",
 		num, dim, get_num_features());
 
-	SGSparseVector<ST> sv=get_sparse_feature_vector(num);
+	SGSparseVector<ST> sv=get_sparse_feature_vector_unowned(num);
 
 	if (sv.features)
 	{
@@ -350,7 +385,7 @@ template<class ST> float64_t* CSparseFeatures<ST>::compute_squared(float64_t* sq
 	for (int32_t i=0; i<num_vec; i++)
 	{
 		sq[i]=0;
-		SGSparseVector<ST> vec=get_sparse_feature_vector(i);
+		SGSparseVector<ST> vec=get_sparse_feature_vector_unowned(i);
 
 		for (int32_t j=0; j<vec.num_feat_entries; j++)
 			sq[i]+=vec.features[j].entry*vec.features[j].entry;
@@ -440,8 +475,8 @@ template<class ST> float64_t CSparseFeatures<ST>::dot(int32_t vec_idx1,
 	ASSERT(df->get_feature_class() == get_feature_class())
 	CSparseFeatures<ST>* sf = (CSparseFeatures<ST>*) df;
 
-	SGSparseVector<ST> avec=get_sparse_feature_vector(vec_idx1);
-	SGSparseVector<ST> bvec=sf->get_sparse_feature_vector(vec_idx2);
+	SGSparseVector<ST> avec=get_sparse_feature_vector_unowned(vec_idx1);
+	SGSparseVector<ST> bvec=sf->get_sparse_feature_vector_unowned(vec_idx2);
 
 	float64_t result = SGSparseVector<ST>::sparse_dot(avec, bvec);
 	free_sparse_feature_vector(vec_idx1);
@@ -466,7 +501,7 @@ template<class ST> float64_t CSparseFeatures<ST>::dense_dot(int32_t vec_idx1, co
 		vec_idx1, vec2_len, get_num_features());
 
 	float64_t result=0;
-	SGSparseVector<ST> sv=get_sparse_feature_vector(vec_idx1);
+	SGSparseVector<ST> sv=get_sparse_feature_vector_unowned(vec_idx1);
 
 	if (sv.features)
 	{
@@ -506,7 +541,7 @@ template<class ST> void* CSparseFeatures<ST>::get_feature_iterator(int32_t vecto
 		SG_ERROR("Requires a in-memory feature matrix\n")
 
 	sparse_feature_iterator* it=new sparse_feature_iterator();
-	it->sv=get_sparse_feature_vector(vector_index);
+	it->sv=get_sparse_feature_vector_unowned(vector_index);
 	it->index=0;
 	it->vector_index=vector_index;
 
@@ -138,6 +138,26 @@ template <class ST> class CSparseFeatures : public CDotFeatures
 		 */
 		SGSparseVector<ST> get_sparse_feature_vector(int32_t num) const;
 
+#ifndef SWIG // SWIG should skip this part
+		/** get a view of the entries of sparse feature vector num in the
+		 * feature matrix
+		 *
+		 * Nothing is copied and no reference counter is touched. The view
+		 * is valid as long as the feature matrix is not replaced.
+		 *
+		 * possible with subset
+		 *
+		 * @param num index of feature vector
+		 * @return read-only view of the sparse entries
+		 */
+		SGVectorView<const SGSparseVectorEntry<ST> > get_sparse_feature_view(int32_t num) const;
+
+		/** @return whether get_sparse_feature_view() can be used, i.e. the
+		 * sparse feature matrix is in memory
+		 */
+		bool can_view_feature_vectors() const;
+#endif
+
 		/** compute the dot product between dense weights and a sparse feature vector
 		 * alpha * sparse^T * w + b
 		 *
@@ -472,6 +492,19 @@ template <class ST> class CSparseFeatures : public CDotFeatures
 		virtual SGSparseVectorEntry<ST>* compute_sparse_feature_vector(int32_t num,
 			int32_t& len, SGSparseVectorEntry<ST>* target=NULL) const;
 
+		/** get sparse feature vector num for use within a method
+		 *
+		 * If the feature matrix is in memory, the returned vector shares
+		 * its entries without reference counting, which saves the atomic
+		 * counter updates of get_sparse_feature_vector() in hot loops.
+		 * Must not outlive the feature matrix, release with
+		 * free_sparse_feature_vector() as usual.
+		 *
+		 * @param num index of feature vector
+		 * @return sparse feature vector
+		 */
+		SGSparseVector<ST> get_sparse_feature_vector_unowned(int32_t num) const;
+
 	private:
 		void init();
 
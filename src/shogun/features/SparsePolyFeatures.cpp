@@ -90,7 +90,6 @@ int32_t CSparsePolyFeatures::get_num_vectors() const
 
 void* CSparsePolyFeatures::get_feature_iterator(int32_t vector_index)
 {
-	SG_NOTIMPLEMENTED
 	return NULL;
 }
 
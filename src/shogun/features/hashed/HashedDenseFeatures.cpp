@@ -213,7 +213,6 @@ int32_t CHashedDenseFeatures<ST>::get_nnz_features_for_vector(int32_t num) const
 template <class ST>
 void* CHashedDenseFeatures<ST>::get_feature_iterator(int32_t vector_index)
 {
-	SG_NOTIMPLEMENTED;
 	return NULL;
 }
 template <class ST>
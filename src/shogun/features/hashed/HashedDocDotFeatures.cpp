@@ -9,6 +9,9 @@
 #include <shogun/lib/Hash.h>
 #include <shogun/mathematics/Math.h>
 
+#include <algorithm>
+#include <vector>
+
 namespace shogun
 {
 CHashedDocDotFeatures::CHashedDocDotFeatures(int32_t hash_bits, CStringFeatures<char>* docs,
@@ -28,6 +31,11 @@ CHashedDocDotFeatures::CHashedDocDotFeatures(const CHashedDocDotFeatures& orig)
 {
 	init(orig.num_bits, orig.doc_collection, orig.tokenizer, orig.should_normalize,
 			orig.ngrams, orig.tokens_to_skip);
+
+	cache_offsets = orig.cache_offsets;
+	cache_indices = orig.cache_indices;
+	cache_counts = orig.cache_counts;
+	cache_scales = orig.cache_scales;
 }
 
 CHashedDocDotFeatures::CHashedDocDotFeatures(CFile* loader)
@@ -80,6 +88,26 @@ float64_t CHashedDocDotFeatures::dot(int32_t vec_idx1, CDotFeatures* df, int32_t
 
 	CHashedDocDotFeatures* hddf = (CHashedDocDotFeatures*) df;
 
+	if (has_index_cache() && hddf->has_index_cache())
+	{
+		/* merge of the increasing hashed indices of both vectors */
+		int64_t i1 = cache_offsets[vec_idx1];
+		int64_t i2 = hddf->cache_offsets[vec_idx2];
+		const int64_t end1 = cache_offsets[vec_idx1+1];
+		const int64_t end2 = hddf->cache_offsets[vec_idx2+1];
+		float64_t result = 0;
+		while (i1<end1 && i2<end2)
+		{
+			if (cache_indices[i1]<hddf->cache_indices[i2])
+				i1++;
+			else if (cache_indices[i1]>hddf->cache_indices[i2])
+				i2++;
+			else
+				result += float64_t(cache_counts[i1++])*hddf->cache_counts[i2++];
+		}
+		return result*cache_scales[vec_idx1]*hddf->cache_scales[vec_idx2];
+	}
+
 	SGVector<char> sv1 = doc_collection->get_feature_vector(vec_idx1);
 	SGVector<char> sv2 = hddf->doc_collection->get_feature_vector(vec_idx2);
 
@@ -101,24 +129,24 @@ float64_t CHashedDocDotFeatures::dense_dot_sgvec(int32_t vec_idx1, const SGVecto
 	return dense_dot(vec_idx1, vec2.vector, vec2.vlen);
 }
 
-float64_t CHashedDocDotFeatures::dense_dot(int32_t vec_idx1, const float64_t* vec2, int32_t vec2_len) const
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+/* tokenizes a document with a copy of the tokenizer and calls f with the
+ * hashed index of every token and of every combination of tokens */
+template <class F>
+static void for_each_hashed_index(CTokenizer* tokenizer, SGVector<char> sv,
+	int32_t num_bits, int32_t ngrams, int32_t tokens_to_skip, F f)
 {
-	ASSERT(vec2_len == CMath::pow(2,num_bits))
-
-	SGVector<char> sv = doc_collection->get_feature_vector(vec_idx1);
-
 	/** this vector will maintain the current n+k active tokens
 	 * in a circular manner */
 	SGVector<uint32_t> hashes(ngrams+tokens_to_skip);
 	index_t hashes_start = 0;
 	index_t hashes_end = 0;
-	int32_t len = hashes.vlen - 1;
+	index_t len = hashes.vlen - 1;
 
 	/** the combinations generated from the current active tokens will be
 	 * stored here to avoid creating new objects */
 	SGVector<index_t> hashed_indices((ngrams-1)*(tokens_to_skip+1) + 1);
 
-	float64_t result = 0;
 	CTokenizer* local_tzer = tokenizer->get_copy();
 
 	/** Reading n+k-1 tokens */
@@ -143,7 +171,7 @@ float64_t CHashedDocDotFeatures::dense_dot(int32_t vec_idx1, const float64_t* ve
 				num_bits, ngrams, tokens_to_skip);
 
 		for (index_t i=0; i<hashed_indices.vlen; i++)
-			result += vec2[hashed_indices[i]];
+			f(hashed_indices[i]);
 
 		hashes_start++;
 		hashes_end++;
@@ -162,18 +190,54 @@ float64_t CHashedDocDotFeatures::dense_dot(int32_t vec_idx1, const float64_t* ve
 					len, hashed_indices, num_bits, ngrams, tokens_to_skip);
 
 			for (index_t i=0; i<max_idx; i++)
-				result += vec2[hashed_indices[i]];
+				f(hashed_indices[i]);
 
 			hashes_start++;
 			if (hashes_start==hashes.vlen)
 				hashes_start = 0;
 		}
 	}
-	doc_collection->free_feature_vector(sv, vec_idx1);
 	SG_UNREF(local_tzer);
+}
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
+float64_t CHashedDocDotFeatures::dense_dot(int32_t vec_idx1, const float64_t* vec2, int32_t vec2_len) const
+{
+	ASSERT(vec2_len == CMath::pow(2,num_bits))
+
+	float64_t result = 0;
+	if (has_index_cache())
+	{
+		for (int64_t i=cache_offsets[vec_idx1]; i<cache_offsets[vec_idx1+1]; i++)
+			result += cache_counts[i]*vec2[cache_indices[i]];
+		return result*cache_scales[vec_idx1];
+	}
+
+	SGVector<char> sv = doc_collection->get_feature_vector(vec_idx1);
+	for_each_hashed_index(tokenizer, sv, num_bits, ngrams, tokens_to_skip,
+		[&](index_t idx) { result += vec2[idx]; });
+	doc_collection->free_feature_vector(sv, vec_idx1);
+
 	return should_normalize ? result / std::sqrt((float64_t)sv.size()) : result;
 }
 
+void CHashedDocDotFeatures::dense_dot_range(float64_t* output, int32_t start,
+	int32_t stop, float64_t* alphas, float64_t* vec, int32_t dim, float64_t b) const
+{
+	ASSERT(output)
+	ASSERT(start>=0)
+	ASSERT(start<=stop)
+	ASSERT(stop<=get_num_vectors())
+
+	/* documents differ in length, so threads take small chunks */
+	#pragma omp parallel for schedule(dynamic, 256)
+	for (int32_t i=start; i<stop; i++)
+	{
+		float64_t result = dense_dot(i, vec, dim);
+		output[i-start] = (alphas ? alphas[i-start]*result : result) + b;
+	}
+}
+
 void CHashedDocDotFeatures::add_to_dense_vec(float64_t alpha, int32_t vec_idx1,
 	float64_t* vec2, int32_t vec2_len, bool abs_val) const
 {
@@ -182,73 +246,109 @@ void CHashedDocDotFeatures::add_to_dense_vec(float64_t alpha, int32_t vec_idx1,
 	if (abs_val)
 		alpha = CMath::abs(alpha);
 
+	if (has_index_cache())
+	{
+		const float64_t value = alpha*cache_scales[vec_idx1];
+		for (int64_t i=cache_offsets[vec_idx1]; i<cache_offsets[vec_idx1+1]; i++)
+			vec2[cache_indices[i]] += cache_counts[i]*value;
+		return;
+	}
+
 	SGVector<char> sv = doc_collection->get_feature_vector(vec_idx1);
 	const float64_t value =
 		should_normalize ? alpha / std::sqrt((float64_t)sv.size()) : alpha;
 
-	/** this vector will maintain the current n+k active tokens
-	 * in a circular manner */
-	SGVector<uint32_t> hashes(ngrams+tokens_to_skip);
-	index_t hashes_start = 0;
-	index_t hashes_end = 0;
-	index_t len = hashes.vlen - 1;
-
-	/** the combinations generated from the current active tokens will be
-	 * stored here to avoid creating new objects */
-	SGVector<index_t> hashed_indices((ngrams-1)*(tokens_to_skip+1) + 1);
+	for_each_hashed_index(tokenizer, sv, num_bits, ngrams, tokens_to_skip,
+		[&](index_t idx) { vec2[idx] += value; });
 
-	CTokenizer* local_tzer = tokenizer->get_copy();
-
-	/** Reading n+k-1 tokens */
-	const int32_t seed = 0xdeadbeaf;
-	local_tzer->set_text(sv);
-	index_t start = 0;
-	while (hashes_end<ngrams-1+tokens_to_skip && local_tzer->has_next())
-	{
-		index_t end = local_tzer->next_token_idx(start);
-		uint32_t token_hash = CHash::MurmurHash3((uint8_t* ) &sv.vector[start], end-start, seed);
-		hashes[hashes_end++] = token_hash;
-	}
+	doc_collection->free_feature_vector(sv, vec_idx1);
+}
 
-	while (local_tzer->has_next())
+void CHashedDocDotFeatures::build_index_cache()
+{
+	const int32_t num_vectors = get_num_vectors();
+	const int32_t block_size = 4096;
+	const int32_t num_blocks = (num_vectors+block_size-1)/block_size;
+
+	/* the sorted distinct indices and their counts of every block of
+	 * documents, concatenated below */
+	std::vector<std::vector<int32_t>> block_indices(num_blocks);
+	std::vector<std::vector<float32_t>> block_counts(num_blocks);
+	SGVector<int64_t> offsets(num_vectors+1);
+	SGVector<float64_t> scales(num_vectors);
+	offsets[0] = 0;
+
+	#pragma omp parallel
 	{
-		index_t end = local_tzer->next_token_idx(start);
-		uint32_t token_hash = CHash::MurmurHash3((uint8_t* ) &sv.vector[start], end-start, seed);
-		hashes[hashes_end] = token_hash;
-
-		CHashedDocConverter::generate_ngram_hashes(hashes, hashes_start, len, hashed_indices,
-				num_bits, ngrams, tokens_to_skip);
+		std::vector<int32_t> doc_indices;
 
-		for (index_t i=0; i<hashed_indices.vlen; i++)
-			vec2[hashed_indices[i]] += value;
-
-		hashes_start++;
-		hashes_end++;
-		if (hashes_end==hashes.vlen)
-			hashes_end = 0;
-		if (hashes_start==hashes.vlen)
-			hashes_start = 0;
+		#pragma omp for schedule(dynamic)
+		for (int32_t block=0; block<num_blocks; block++)
+		{
+			const int32_t stop = CMath::min((block+1)*block_size, num_vectors);
+			for (int32_t v=block*block_size; v<stop; v++)
+			{
+				SGVector<char> sv = doc_collection->get_feature_vector(v);
+				doc_indices.clear();
+				for_each_hashed_index(tokenizer, sv, num_bits, ngrams, tokens_to_skip,
+					[&](index_t idx) { doc_indices.push_back(idx); });
+				scales[v] = should_normalize ? 1 / std::sqrt((float64_t)sv.size()) : 1;
+				doc_collection->free_feature_vector(sv, v);
+
+				std::sort(doc_indices.begin(), doc_indices.end());
+				int64_t nnz = 0;
+				for (size_t i=0; i<doc_indices.size(); i++)
+				{
+					if (i>0 && doc_indices[i]==doc_indices[i-1])
+						block_counts[block].back()++;
+					else
+					{
+						block_indices[block].push_back(doc_indices[i]);
+						block_counts[block].push_back(1);
+						nnz++;
+					}
+				}
+				offsets[v+1] = nnz;
+			}
+		}
 	}
 
-	if (ngrams>1)
+	for (int32_t v=0; v<num_vectors; v++)
+		offsets[v+1] += offsets[v];
+
+	SGVector<int32_t> indices(offsets[num_vectors]);
+	SGVector<float32_t> counts(offsets[num_vectors]);
+	#pragma omp parallel for schedule(dynamic)
+	for (int32_t block=0; block<num_blocks; block++)
 	{
-		while (hashes_start!=hashes_end)
-		{
-			len--;
-			index_t max_idx = CHashedDocConverter::generate_ngram_hashes(hashes,
-					hashes_start, len, hashed_indices, num_bits, ngrams, tokens_to_skip);
+		const int64_t first = offsets[block*block_size];
+		std::copy(block_indices[block].begin(), block_indices[block].end(),
+			indices.vector+first);
+		std::copy(block_counts[block].begin(), block_counts[block].end(),
+			counts.vector+first);
+		std::vector<int32_t>().swap(block_indices[block]);
+		std::vector<float32_t>().swap(block_counts[block]);
+	}
 
-			for (index_t i=0; i<max_idx; i++)
-				vec2[hashed_indices[i]] += value;
+	cache_offsets = offsets;
+	cache_indices = indices;
+	cache_counts = counts;
+	cache_scales = scales;
+	SG_DEBUG("Cached %ld hashed indices of %d documents\n",
+		(long)offsets[num_vectors], num_vectors);
+}
 
-			hashes_start++;
-			if (hashes_start==hashes.vlen)
-				hashes_start = 0;
-		}
-	}
+void CHashedDocDotFeatures::free_index_cache()
+{
+	cache_offsets = SGVector<int64_t>();
+	cache_indices = SGVector<int32_t>();
+	cache_counts = SGVector<float32_t>();
+	cache_scales = SGVector<float64_t>();
+}
 
-	doc_collection->free_feature_vector(sv, vec_idx1);
-	SG_UNREF(local_tzer);
+bool CHashedDocDotFeatures::has_index_cache() const
+{
+	return cache_offsets.vlen>0;
 }
 
 uint32_t CHashedDocDotFeatures::calculate_token_hash(char* token,
@@ -260,12 +360,16 @@ uint32_t CHashedDocDotFeatures::calculate_token_hash(char* token,
 
 void CHashedDocDotFeatures::set_doc_collection(CStringFeatures<char>* docs)
 {
+	free_index_cache();
 	SG_UNREF(doc_collection);
 	doc_collection = docs;
 }
 
 int32_t CHashedDocDotFeatures::get_nnz_features_for_vector(int32_t num) const
 {
+	if (has_index_cache())
+		return cache_offsets[num+1]-cache_offsets[num];
+
 	SGVector<char> sv = doc_collection->get_feature_vector(num);
 	int32_t num_nnz_features = sv.size();
 	doc_collection->free_feature_vector(sv, num);
@@ -274,7 +378,6 @@ int32_t CHashedDocDotFeatures::get_nnz_features_for_vector(int32_t num) const
 
 void* CHashedDocDotFeatures::get_feature_iterator(int32_t vector_index)
 {
-	SG_NOTIMPLEMENTED;
 	return NULL;
 }
 
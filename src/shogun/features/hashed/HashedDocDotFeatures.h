@@ -30,6 +30,10 @@ class CTokenizer;
  * The latter implements a k-skip n-grams approach, meaning that you can combine up to n tokens, while skipping up to k.
  * Eg. for the tokens ["a", "b", "c", "d"], with n_grams = 2 and skips = 2, one would get the following combinations :
  * ["a", "ab", "ac" (skipped 1), "ad" (skipped 2), "b", "bc", "bd" (skipped 1), "c", "cd", "d"].
+ *
+ * Algorithms that pass over the documents repeatedly can call build_index_cache() once, which keeps the
+ * sorted distinct hashed indices of every document with their counts (8 bytes per index and document).
+ * All products then read the cache instead of tokenizing and hashing the documents again.
  */
 class CHashedDocDotFeatures: public CDotFeatures
 {
@@ -93,6 +97,20 @@ public:
 	 */
 	virtual float64_t dense_dot(int32_t vec_idx1, const float64_t* vec2, int32_t vec2_len) const;
 
+	/** compute dot products of vectors start, ..., stop-1 with a dense
+	 * vector in parallel
+	 *
+	 * @param output result for the given vector range
+	 * @param start start vector range from this idx
+	 * @param stop stop vector range at this idx
+	 * @param alphas scalars to multiply the results with (may be NULL)
+	 * @param vec dense vector to compute the dot products with
+	 * @param dim length of the dense vector
+	 * @param b bias to add to the results
+	 */
+	virtual void dense_dot_range(float64_t* output, int32_t start, int32_t stop,
+			float64_t* alphas, float64_t* vec, int32_t dim, float64_t b) const;
+
 	/** add vector 1 multiplied with alpha to dense vector2
 	 *
 	 * @param alpha scalar alpha
@@ -151,6 +169,19 @@ public:
 	 */
 	void set_doc_collection(CStringFeatures<char>* docs);
 
+	/** tokenize and hash all documents once and keep the hashed indices
+	 * of every document with their counts. Changing the document
+	 * collection frees the cache, changing its subsets requires building
+	 * the cache again.
+	 */
+	void build_index_cache();
+
+	/** free the hashed indices of the documents */
+	void free_index_cache();
+
+	/** @return whether the hashed indices of the documents are cached */
+	bool has_index_cache() const;
+
 	virtual const char* get_name() const;
 
 	/** duplicate feature object
@@ -210,6 +241,18 @@ protected:
 
 	/** tokens to skip when combining tokens */
 	int32_t tokens_to_skip;
+
+	/** start of the cached indices of every document and their end */
+	SGVector<int64_t> cache_offsets;
+
+	/** increasing distinct hashed indices of every document */
+	SGVector<int32_t> cache_indices;
+
+	/** number of times every cached index occurs in its document */
+	SGVector<float32_t> cache_counts;
+
+	/** factor of the counts of every document, due to normalization */
+	SGVector<float64_t> cache_scales;
 };
 }
 
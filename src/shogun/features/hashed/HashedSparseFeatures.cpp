@@ -283,7 +283,6 @@ int32_t CHashedSparseFeatures<ST>::get_nnz_features_for_vector(int32_t num) cons
 template <class ST>
 void* CHashedSparseFeatures<ST>::get_feature_iterator(int32_t vector_index)
 {
-	SG_NOTIMPLEMENTED;
 	return NULL;
 }
 template <class ST>
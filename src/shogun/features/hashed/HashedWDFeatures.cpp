@@ -287,7 +287,6 @@ int32_t CHashedWDFeatures::get_nnz_features_for_vector(int32_t num) const
 
 void* CHashedWDFeatures::get_feature_iterator(int32_t vector_index)
 {
-	SG_NOTIMPLEMENTED
 	return NULL;
 }
 
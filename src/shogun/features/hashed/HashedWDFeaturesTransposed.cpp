@@ -594,7 +594,6 @@ CFeatures* CHashedWDFeaturesTransposed::duplicate() const
 
 void* CHashedWDFeaturesTransposed::get_feature_iterator(int32_t vector_index)
 {
-	SG_NOTIMPLEMENTED
 	return NULL;
 }
 
@@ -10,6 +10,8 @@
 #include <shogun/features/streaming/StreamingDenseFeatures.h>
 #include <shogun/io/streaming/StreamingFileFromDenseFeatures.h>
 
+#include <vector>
+
 namespace shogun
 {
 template<class T>
@@ -299,63 +301,115 @@ CFeatures* CStreamingDenseFeatures<T>::get_streamed_features(
 	REQUIRE(num_elements>0, "Requested number of feature vectors (%d) must be "
 			"positive\n", num_elements);
 
-	/* init matrix empty, as we dont know the dimension yet */
-	SGMatrix<T> matrix;
-
-	for (index_t i=0; i<num_elements; ++i)
+	SGMatrix<T> matrix=get_next_batch(num_elements);
+	if (matrix.num_cols<num_elements)
 	{
-		/* check if we run out of data */
-		if (!get_next_example())
-		{
-			SG_WARNING("Ran out of streaming data, reallocating matrix and "
-					"returning!\n");
+		SG_WARNING("Ran out of streaming data, returning %d of %d "
+				"requested vectors!\n", matrix.num_cols, num_elements);
+	}
 
-			/* allocating space for data so far, not this mighe be 0 bytes */
-			SGMatrix<T> so_far(matrix.num_rows, i);
+	/* create new feature object from collected data */
+	CDenseFeatures<T>* result=new CDenseFeatures<T>(matrix);
 
-			/* copy */
-			sg_memcpy(so_far.matrix, matrix.matrix,
-					so_far.num_rows*so_far.num_cols*sizeof(T));
+	SG_DEBUG("leaving returning %dx%d matrix\n", matrix.num_rows,
+			matrix.num_cols);
 
-			matrix=so_far;
-			break;
-		}
-		else
-		{
-			/* allocate matrix memory in first iteration */
-			if (!matrix.matrix)
-			{
-				SG_DEBUG("Allocating %dx%d matrix\n",
-						current_vector.vlen, num_elements);
-				matrix=SGMatrix<T>(current_vector.vlen, num_elements);
-			}
+	return result;
+}
+
+template<class T>
+SGMatrix<T> CStreamingDenseFeatures<T>::get_next_batch(index_t num_examples)
+{
+	REQUIRE(num_examples>0, "Requested number of examples (%d) must be "
+			"positive\n", num_examples);
 
-			/* get an example from stream and copy to feature matrix */
+	/* allocate the matrix once the dimension is known */
+	SGMatrix<T> batch;
+	current_batch_labels=SGVector<float64_t>();
+	if (has_labels)
+		current_batch_labels=SGVector<float64_t>(num_examples);
+
+	index_t num_fetched=0;
+	if (!working_file)
+	{
+		/* no parser, examples are produced by get_next_example() of a
+		 * subclass, e.g. a data generator */
+		for (; num_fetched<num_examples && get_next_example(); num_fetched++)
+		{
 			SGVector<T> vec=get_vector();
+			if (!batch.matrix)
+				batch=SGMatrix<T>(vec.vlen, num_examples);
 
-			/* check for inconsistent dimensions */
-			REQUIRE(vec.vlen==matrix.num_rows,
+			REQUIRE(vec.vlen==batch.num_rows,
 					"Dimension of streamed vector (%d) does not match "
 					"dimensions of previous vectors (%d)\n",
-					vec.vlen, matrix.num_rows);
+					vec.vlen, batch.num_rows);
 
-			/* copy vector into matrix */
-			sg_memcpy(&matrix.matrix[current_vector.vlen*i], vec.vector,
-					vec.vlen*sizeof(T));
+			sg_memcpy(batch.get_column_vector(num_fetched), vec.vector,
+					batch.num_rows*sizeof(T));
+			if (has_labels)
+				current_batch_labels[num_fetched]=get_label();
 
-			/* clean up */
 			release_example();
 		}
+	}
+	else
+	{
+		/* the parser hands out at most a ring of examples at once */
+		const index_t max_chunk=CMath::min(num_examples, parser.get_ring_size());
+		std::vector<Example<T>*> examples(max_chunk);
+
+		while (num_fetched<num_examples)
+		{
+			const index_t num_chunk=parser.get_next_batch(
+					CMath::min(num_examples-num_fetched, max_chunk),
+					examples.data());
+			if (!num_chunk)
+				break;
 
+			if (!batch.matrix)
+				batch=SGMatrix<T>(examples[0]->length, num_examples);
+
+			for (index_t i=0; i<num_chunk; i++)
+			{
+				const Example<T>* ex=examples[i];
+				REQUIRE(ex->length==batch.num_rows,
+						"Dimension of streamed vector (%d) does not match "
+						"dimensions of previous vectors (%d)\n",
+						ex->length, batch.num_rows);
+
+				sg_memcpy(batch.get_column_vector(num_fetched+i), ex->fv,
+						batch.num_rows*sizeof(T));
+				if (has_labels)
+					current_batch_labels[num_fetched+i]=ex->label;
+			}
+
+			parser.finalize_batch(num_chunk);
+			num_fetched+=num_chunk;
+		}
 	}
 
-	/* create new feature object from collected data */
-	CDenseFeatures<T>* result=new CDenseFeatures<T>(matrix);
+	if (num_fetched<num_examples)
+	{
+		SGMatrix<T> so_far(batch.num_rows, num_fetched);
+		if (num_fetched)
+		{
+			sg_memcpy(so_far.matrix, batch.matrix,
+					so_far.num_rows*so_far.num_cols*sizeof(T));
+		}
+		batch=so_far;
 
-	SG_DEBUG("leaving returning %dx%d matrix\n", matrix.num_rows,
-			matrix.num_cols);
+		if (has_labels)
+			current_batch_labels.resize_vector(num_fetched);
+	}
 
-	return result;
+	return batch;
+}
+
+template<class T>
+SGVector<float64_t> CStreamingDenseFeatures<T>::get_batch_labels() const
+{
+	return current_batch_labels;
 }
 
 template class CStreamingDenseFeatures<bool> ;
@@ -266,6 +266,25 @@ public:
 	 */
 	virtual CFeatures* get_streamed_features(index_t num_elements);
 
+	/** Fetches up to num_examples examples from the stream at once and
+	 * returns them as the columns of a contiguous matrix. Examples are
+	 * taken from the parser's ring in chunks, so the synchronisation cost
+	 * of get_next_example()/release_example() is paid once per chunk
+	 * rather than once per example. An example of get_next_example() that
+	 * was not released yet is released first.
+	 *
+	 * @param num_examples maximum number of examples to fetch
+	 * @return matrix with one example per column. It has less than
+	 * num_examples columns if the stream ended, none if it had ended
+	 * already.
+	 */
+	virtual SGMatrix<T> get_next_batch(index_t num_examples);
+
+	/** @return labels of the examples returned by the last call of
+	 * get_next_batch(), empty if the stream is not labelled
+	 */
+	SGVector<float64_t> get_batch_labels() const;
+
 private:
 	/**
 	 * Initializes members to null values.
@@ -295,6 +314,9 @@ protected:
 
 	/// The current example's label.
 	float64_t current_label;
+
+	/// Labels of the last batch
+	SGVector<float64_t> current_batch_labels;
 };
 }
 #endif // _STREAMINGDENSEFEATURES__H__
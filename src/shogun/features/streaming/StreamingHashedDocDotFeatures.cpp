@@ -9,6 +9,8 @@
 #include <shogun/features/hashed/HashedDocDotFeatures.h>
 #include <shogun/mathematics/Math.h>
 
+#include <vector>
+
 using namespace shogun;
 
 CStreamingHashedDocDotFeatures::CStreamingHashedDocDotFeatures(CStreamingFile* file,
@@ -155,6 +157,64 @@ bool CStreamingHashedDocDotFeatures::get_next_example()
 	return false;
 }
 
+SGSparseMatrix<float64_t> CStreamingHashedDocDotFeatures::get_next_batch(
+	index_t num_examples)
+{
+	REQUIRE(num_examples>0, "Requested number of examples (%d) must be "
+		"positive\n", num_examples);
+
+	/* the parser hands out at most a ring of documents at once */
+	const index_t max_chunk=CMath::min(num_examples, parser.get_ring_size());
+	std::vector<Example<char>*> examples(max_chunk);
+
+	SGSparseMatrix<float64_t> batch(get_dim_feature_space(), num_examples);
+	current_batch_labels=SGVector<float64_t>();
+	if (has_labels)
+		current_batch_labels=SGVector<float64_t>(num_examples);
+
+	index_t num_fetched=0;
+	while (num_fetched<num_examples)
+	{
+		const index_t num_chunk=parser.get_next_batch(
+			CMath::min(num_examples-num_fetched, max_chunk), examples.data());
+		if (!num_chunk)
+			break;
+
+		for (index_t i=0; i<num_chunk; i++)
+		{
+			const Example<char>* ex=examples[i];
+			ASSERT(ex->fv)
+			ASSERT(ex->length > 0)
+
+			SGVector<char> doc(ex->fv, ex->length, false);
+			batch.sparse_matrix[num_fetched+i]=converter->apply(doc);
+			if (has_labels)
+				current_batch_labels[num_fetched+i]=ex->label;
+		}
+
+		parser.finalize_batch(num_chunk);
+		num_fetched+=num_chunk;
+	}
+
+	if (num_fetched<num_examples)
+	{
+		SGSparseMatrix<float64_t> so_far(batch.num_features, num_fetched);
+		for (index_t i=0; i<num_fetched; i++)
+			so_far.sparse_matrix[i]=batch.sparse_matrix[i];
+		batch=so_far;
+
+		if (has_labels)
+			current_batch_labels.resize_vector(num_fetched);
+	}
+
+	return batch;
+}
+
+SGVector<float64_t> CStreamingHashedDocDotFeatures::get_batch_labels() const
+{
+	return current_batch_labels;
+}
+
 void CStreamingHashedDocDotFeatures::release_example()
 {
 	parser.finalize_example();
@@ -14,6 +14,7 @@
 #include <shogun/converter/HashedDocConverter.h>
 #include <shogun/io/streaming/InputParser.h>
 #include <shogun/io/streaming/StreamingFileFromStringFeatures.h>
+#include <shogun/lib/SGSparseMatrix.h>
 
 namespace shogun
 {
@@ -208,6 +209,24 @@ public:
 	 */
 	SGSparseVector<float64_t> get_vector();
 
+	/** Fetches up to num_examples documents from the stream at once and
+	 * hashes them. Documents are taken from the parser's ring in chunks,
+	 * so the synchronisation cost of get_next_example()/release_example()
+	 * is paid once per chunk rather than once per document. An example
+	 * of get_next_example() that was not released yet is released first.
+	 *
+	 * @param num_examples maximum number of documents to fetch
+	 * @return sparse matrix with one hashed document per vector. It has
+	 * less than num_examples vectors if the stream ended, none if it had
+	 * ended already.
+	 */
+	SGSparseMatrix<float64_t> get_next_batch(index_t num_examples);
+
+	/** @return labels of the documents returned by the last call of
+	 * get_next_batch(), empty if the stream is not labelled
+	 */
+	SGVector<float64_t> get_batch_labels() const;
+
 	/** specify whether hashed vector should be normalized or not
 	 *
 	 * @param normalize  whether to normalize
@@ -246,6 +265,9 @@ protected:
 
 	/** The current example's label */
 	float64_t current_label;
+
+	/** Labels of the last batch */
+	SGVector<float64_t> current_batch_labels;
 };
 }
 
@@ -8,6 +8,8 @@
 #include <shogun/features/streaming/StreamingSparseFeatures.h>
 #include <shogun/mathematics/Math.h>
 
+#include <vector>
+
 namespace shogun
 {
 
@@ -368,6 +370,66 @@ EFeatureClass CStreamingSparseFeatures<T>::get_feature_class() const
 	return C_STREAMING_SPARSE;
 }
 
+template <class T>
+SGSparseMatrix<T> CStreamingSparseFeatures<T>::get_next_batch(index_t num_examples)
+{
+	REQUIRE(num_examples>0, "Requested number of examples (%d) must be "
+			"positive\n", num_examples);
+
+	/* the parser hands out at most a ring of examples at once */
+	const index_t max_chunk=CMath::min(num_examples, parser.get_ring_size());
+	std::vector<Example<SGSparseVectorEntry<T> >*> examples(max_chunk);
+	std::vector<SGSparseVector<T> > vectors;
+	vectors.reserve(num_examples);
+
+	current_batch_labels=SGVector<float64_t>();
+	if (has_labels)
+		current_batch_labels=SGVector<float64_t>(num_examples);
+
+	while ((index_t) vectors.size()<num_examples)
+	{
+		const index_t num_fetched=vectors.size();
+		const index_t num_chunk=parser.get_next_batch(
+				CMath::min(num_examples-num_fetched, max_chunk),
+				examples.data());
+		if (!num_chunk)
+			break;
+
+		for (index_t i=0; i<num_chunk; i++)
+		{
+			const Example<SGSparseVectorEntry<T> >* ex=examples[i];
+			SGSparseVector<T> vec(ex->length);
+			sg_memcpy(vec.features, ex->fv,
+					ex->length*sizeof(SGSparseVectorEntry<T>));
+
+			current_num_features=CMath::max(current_num_features,
+					vec.get_num_dimensions());
+			if (has_labels)
+				current_batch_labels[num_fetched+i]=ex->label;
+
+			vectors.push_back(vec);
+		}
+
+		parser.finalize_batch(num_chunk);
+		current_vec_index+=num_chunk;
+	}
+
+	SGSparseMatrix<T> batch(current_num_features, vectors.size());
+	for (index_t i=0; i<batch.num_vectors; i++)
+		batch.sparse_matrix[i]=vectors[i];
+
+	if (has_labels)
+		current_batch_labels.resize_vector(batch.num_vectors);
+
+	return batch;
+}
+
+template <class T>
+SGVector<float64_t> CStreamingSparseFeatures<T>::get_batch_labels() const
+{
+	return current_batch_labels;
+}
+
 template class CStreamingSparseFeatures<bool>;
 template class CStreamingSparseFeatures<char>;
 template class CStreamingSparseFeatures<int8_t>;
@@ -13,6 +13,7 @@
 #include <shogun/features/streaming/StreamingDotFeatures.h>
 #include <shogun/io/streaming/InputParser.h>
 #include <shogun/lib/SGSparseVector.h>
+#include <shogun/lib/SGSparseMatrix.h>
 #include <shogun/features/FeatureTypes.h>
 
 namespace shogun
@@ -319,6 +320,25 @@ public:
 	 */
 	virtual int32_t get_num_vectors() const;
 
+	/** Fetches up to num_examples examples from the stream at once.
+	 * Examples are taken from the parser's ring in chunks, so the
+	 * synchronisation cost of get_next_example()/release_example() is
+	 * paid once per chunk rather than once per example. An example
+	 * of get_next_example() that was not released yet is released first,
+	 * and the number of features is updated.
+	 *
+	 * @param num_examples maximum number of examples to fetch
+	 * @return sparse matrix with one example per vector. It has less than
+	 * num_examples vectors if the stream ended, none if it had ended
+	 * already.
+	 */
+	virtual SGSparseMatrix<T> get_next_batch(index_t num_examples);
+
+	/** @return labels of the examples returned by the last call of
+	 * get_next_batch(), empty if the stream is not labelled
+	 */
+	SGVector<float64_t> get_batch_labels() const;
+
 private:
 	/**
 	 * Initializes members to null values.
@@ -350,6 +370,9 @@ protected:
 
 	/// Number of features in current vector (as seen so far upto the current vector)
 	int32_t current_num_features;
+
+	/// Labels of the last batch
+	SGVector<float64_t> current_batch_labels;
 };
 
 }
@@ -0,0 +1,324 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: agent
+ */
+
+#include <shogun/io/SerializableBinaryFile.h>
+#include <shogun/io/SerializableBinaryReader00.h>
+
+#define SERIALIZABLE_BINARY_VERSION_00 0
+
+using namespace shogun;
+
+CSerializableBinaryFile::CSerializableBinaryFile()
+	:CSerializableFile() { init(); }
+
+CSerializableBinaryFile::CSerializableBinaryFile(FILE* fstream, char rw)
+	:CSerializableFile(fstream, rw) { init(); }
+
+CSerializableBinaryFile::CSerializableBinaryFile(
+	const char* fname, char rw)
+	:CSerializableFile(fname, rw) { init(); }
+
+CSerializableBinaryFile::~CSerializableBinaryFile() {}
+
+int64_t
+CSerializableBinaryFile::tell(FILE* fstream)
+{
+#ifdef _MSC_VER
+	return _ftelli64(fstream);
+#else
+	return ftello(fstream);
+#endif
+}
+
+bool
+CSerializableBinaryFile::seek(FILE* fstream, int64_t pos, int whence)
+{
+#ifdef _MSC_VER
+	return _fseeki64(fstream, pos, whence) == 0;
+#else
+	return fseeko(fstream, (off_t) pos, whence) == 0;
+#endif
+}
+
+bool
+CSerializableBinaryFile::has_block_support(const TSGDataType* type) const
+{
+	return type->m_ptype != PT_SGOBJECT && type->m_ptype != PT_UNDEFINED;
+}
+
+CSerializableFile::TSerializableReader*
+CSerializableBinaryFile::new_reader(char* dest_version, size_t n)
+{
+	REQUIRE(m_fstream != NULL, "Provided fstream should be != NULL\n");
+
+	SerializableBinaryHeader header;
+	if (!seek(m_fstream, 0)
+		|| fread(&header, sizeof(header), 1, m_fstream) != 1)
+		return NULL;
+
+	if (memcmp(header.magic, SERIALIZABLE_BINARY_MAGIC,
+			   sizeof(header.magic)) != 0)
+		return NULL;
+
+	snprintf(dest_version, n, "%.8s_V_%02" PRIu32, header.magic,
+			 header.version);
+
+	if (header.byte_order != SERIALIZABLE_BINARY_BYTE_ORDER
+		|| header.sizeof_index != sizeof(index_t)
+		|| header.sizeof_floatmax != sizeof(floatmax_t))
+	{
+		SG_WARNING("`%s' was written on a platform with different byte "
+				   "order or type sizes!\n", m_filename);
+		return NULL;
+	}
+
+	if (header.version == SERIALIZABLE_BINARY_VERSION_00)
+	{
+		SerializableBinaryReader00* reader =
+			new SerializableBinaryReader00(this);
+		if (reader->is_valid())
+			return reader;
+
+		delete reader;
+	}
+
+	return NULL;
+}
+
+void
+CSerializableBinaryFile::init()
+{
+	if (m_fstream == NULL) return;
+
+	switch (m_task) {
+	case 'w':
+	{
+		SerializableBinaryHeader header;
+		memset(&header, 0, sizeof(header));
+		memcpy(header.magic, SERIALIZABLE_BINARY_MAGIC,
+			   sizeof(header.magic));
+		header.version = SERIALIZABLE_BINARY_VERSION_00;
+		header.byte_order = SERIALIZABLE_BINARY_BYTE_ORDER;
+		header.sizeof_index = sizeof(index_t);
+		header.sizeof_floatmax = sizeof(floatmax_t);
+		header.alignment = SERIALIZABLE_BINARY_ALIGNMENT;
+
+		if (!write_bytes(&header, sizeof(header))) {
+			close(); return;
+		}
+		break;
+	}
+	case 'r': break;
+	default:
+		SG_WARNING("Could not open file `%s', unknown mode!\n",
+				   m_filename);
+		close(); return;
+	}
+}
+
+bool
+CSerializableBinaryFile::write_bytes(const void* data, size_t num_bytes)
+{
+	if (num_bytes == 0) return true;
+
+	return fwrite(data, num_bytes, 1, m_fstream) == 1;
+}
+
+bool
+CSerializableBinaryFile::write_name(const char* name)
+{
+	uint32_t len = strlen(name);
+
+	return write_bytes(&len, sizeof(len)) && write_bytes(name, len);
+}
+
+bool
+CSerializableBinaryFile::write_size_begin()
+{
+	m_stack_fpos.push_back(tell(m_fstream));
+
+	uint64_t size = 0;
+	return write_bytes(&size, sizeof(size));
+}
+
+bool
+CSerializableBinaryFile::write_size_end()
+{
+	int64_t size_pos = m_stack_fpos.back();
+	m_stack_fpos.pop_back();
+
+	int64_t end_pos = tell(m_fstream);
+	if (size_pos < 0 || end_pos < 0) return false;
+	uint64_t size = end_pos - size_pos - sizeof(size);
+
+	if (!seek(m_fstream, size_pos)) return false;
+	if (!write_bytes(&size, sizeof(size))) return false;
+	if (!seek(m_fstream, end_pos)) return false;
+
+	return true;
+}
+
+bool
+CSerializableBinaryFile::write_scalar_wrapped(
+	const TSGDataType* type, const void* param)
+{
+	switch (type->m_ptype) {
+	case PT_UNDEFINED:
+	case PT_SGOBJECT:
+		SG_ERROR("write_scalar_wrapped(): Implementation error during"
+				 " writing BinaryFile!");
+		return false;
+	default: break;
+	}
+
+	return write_bytes(param, type->sizeof_ptype());
+}
+
+bool
+CSerializableBinaryFile::write_cont_begin_wrapped(
+	const TSGDataType* type, index_t len_real_y, index_t len_real_x)
+{
+	return write_bytes(&len_real_y, sizeof(len_real_y))
+		&& write_bytes(&len_real_x, sizeof(len_real_x));
+}
+
+bool
+CSerializableBinaryFile::write_cont_end_wrapped(
+	const TSGDataType* type, index_t len_real_y, index_t len_real_x)
+{
+	return true;
+}
+
+bool
+CSerializableBinaryFile::write_string_begin_wrapped(
+	const TSGDataType* type, index_t length)
+{
+	return write_bytes(&length, sizeof(length));
+}
+
+bool
+CSerializableBinaryFile::write_string_end_wrapped(
+	const TSGDataType* type, index_t length)
+{
+	return true;
+}
+
+bool
+CSerializableBinaryFile::write_stringentry_begin_wrapped(
+	const TSGDataType* type, index_t y)
+{
+	return true;
+}
+
+bool
+CSerializableBinaryFile::write_stringentry_end_wrapped(
+	const TSGDataType* type, index_t y)
+{
+	return true;
+}
+
+bool
+CSerializableBinaryFile::write_sparse_begin_wrapped(
+	const TSGDataType* type, index_t length)
+{
+	return write_bytes(&length, sizeof(length));
+}
+
+bool
+CSerializableBinaryFile::write_sparse_end_wrapped(
+	const TSGDataType* type, index_t length)
+{
+	return true;
+}
+
+bool
+CSerializableBinaryFile::write_sparseentry_begin_wrapped(
+	const TSGDataType* type, const SGSparseVectorEntry<char>* first_entry,
+	index_t feat_index, index_t y)
+{
+	return write_bytes(&feat_index, sizeof(feat_index));
+}
+
+bool
+CSerializableBinaryFile::write_sparseentry_end_wrapped(
+	const TSGDataType* type, const SGSparseVectorEntry<char>* first_entry,
+	index_t feat_index, index_t y)
+{
+	return true;
+}
+
+bool
+CSerializableBinaryFile::write_item_begin_wrapped(
+	const TSGDataType* type, index_t y, index_t x)
+{
+	return true;
+}
+
+bool
+CSerializableBinaryFile::write_item_end_wrapped(
+	const TSGDataType* type, index_t y, index_t x)
+{
+	return true;
+}
+
+bool
+CSerializableBinaryFile::write_sgserializable_begin_wrapped(
+	const TSGDataType* type, const char* sgserializable_name,
+	EPrimitiveType generic)
+{
+	if (!write_name(sgserializable_name)) return false;
+
+	if (*sgserializable_name == '\0') return true;
+
+	int32_t generic_int = generic;
+	if (!write_bytes(&generic_int, sizeof(generic_int))) return false;
+
+	return write_size_begin();
+}
+
+bool
+CSerializableBinaryFile::write_sgserializable_end_wrapped(
+	const TSGDataType* type, const char* sgserializable_name,
+	EPrimitiveType generic)
+{
+	if (*sgserializable_name == '\0') return true;
+
+	return write_size_end();
+}
+
+bool
+CSerializableBinaryFile::write_type_begin_wrapped(
+	const TSGDataType* type, const char* name, const char* prefix)
+{
+	string_t buf;
+	type->to_string(buf, STRING_LEN);
+
+	return write_name(name) && write_name(buf) && write_size_begin();
+}
+
+bool
+CSerializableBinaryFile::write_type_end_wrapped(
+	const TSGDataType* type, const char* name, const char* prefix)
+{
+	return write_size_end();
+}
+
+bool
+CSerializableBinaryFile::write_block_wrapped(
+	const TSGDataType* type, const void* data, size_t num_bytes)
+{
+	const char padding[SERIALIZABLE_BINARY_ALIGNMENT] = {0};
+
+	int64_t pos = tell(m_fstream);
+	if (pos < 0) return false;
+
+	size_t num_padding = (SERIALIZABLE_BINARY_ALIGNMENT
+		- pos % SERIALIZABLE_BINARY_ALIGNMENT)
+		% SERIALIZABLE_BINARY_ALIGNMENT;
+
+	return write_bytes(padding, num_padding)
+		&& write_bytes(data, num_bytes);
+}
@@ -0,0 +1,180 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: agent
+ */
+#ifndef __SERIALIZABLE_BINARY_FILE_H__
+#define __SERIALIZABLE_BINARY_FILE_H__
+
+#include <shogun/lib/config.h>
+
+#include <shogun/io/SerializableFile.h>
+#include <shogun/base/DynArray.h>
+#include <shogun/lib/DataType.h>
+#include <shogun/lib/common.h>
+
+#define SERIALIZABLE_BINARY_MAGIC      "SGBINSER"
+#define SERIALIZABLE_BINARY_BYTE_ORDER 0x01020304
+#define SERIALIZABLE_BINARY_ALIGNMENT  64
+
+namespace shogun
+{
+template <class T> struct SGSparseVectorEntry;
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+/** header at the very beginning of every binary serializable file */
+struct SerializableBinaryHeader
+{
+	/** SERIALIZABLE_BINARY_MAGIC, without terminating zero */
+	char magic[8];
+	/** format version, selects the reader */
+	uint32_t version;
+	/** SERIALIZABLE_BINARY_BYTE_ORDER as written by the producer */
+	uint32_t byte_order;
+	/** sizeof(index_t) of the producer */
+	uint32_t sizeof_index;
+	/** sizeof(floatmax_t) of the producer */
+	uint32_t sizeof_floatmax;
+	/** alignment of data blocks, relative to the file start */
+	uint32_t alignment;
+	/** reserved, zero */
+	uint32_t reserved;
+};
+#endif
+
+/** @brief serializable binary file
+ *
+ * Compact binary counterpart of CSerializableAsciiFile. Every parameter
+ * is stored as a record of its name, its type string and the size of
+ * its payload, so parameters can be looked up by name and unknown ones
+ * skipped without parsing them. Scalars are stored in native byte order.
+ *
+ * Dense containers, strings and sparse vectors of non-object type are
+ * stored as one raw block each, aligned to SERIALIZABLE_BINARY_ALIGNMENT
+ * bytes relative to the start of the file (see
+ * CSerializableFile::has_block_support()). For loading, the whole file
+ * is memory mapped and each block is copied into its container with a
+ * single memcpy, so there is no per element parsing.
+ *
+ * The file starts with a versioned SerializableBinaryHeader. Files are
+ * only portable between machines with identical byte order and type
+ * sizes, which is checked when the file is opened for reading.
+ */
+class CSerializableBinaryFile :public CSerializableFile
+{
+	friend class SerializableBinaryReader00;
+
+	/** file positions of the size fields still to be filled in */
+	DynArray<int64_t> m_stack_fpos;
+
+	void init();
+
+	/** ftell and fseek with 64 bit file positions */
+	static int64_t tell(FILE* fstream);
+	static bool seek(FILE* fstream, int64_t pos, int whence=SEEK_SET);
+
+	bool write_bytes(const void* data, size_t num_bytes);
+	bool write_name(const char* name);
+	bool write_size_begin();
+	bool write_size_end();
+
+protected:
+
+	/** new reader
+	 * @param dest_version
+	 * @param n
+	 */
+	virtual TSerializableReader* new_reader(
+		char* dest_version, size_t n);
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+	virtual bool write_scalar_wrapped(
+		const TSGDataType* type, const void* param);
+
+	virtual bool write_cont_begin_wrapped(
+		const TSGDataType* type, index_t len_real_y,
+		index_t len_real_x);
+	virtual bool write_cont_end_wrapped(
+		const TSGDataType* type, index_t len_real_y,
+		index_t len_real_x);
+
+	virtual bool write_string_begin_wrapped(
+		const TSGDataType* type, index_t length);
+	virtual bool write_string_end_wrapped(
+		const TSGDataType* type, index_t length);
+
+	virtual bool write_stringentry_begin_wrapped(
+		const TSGDataType* type, index_t y);
+	virtual bool write_stringentry_end_wrapped(
+		const TSGDataType* type, index_t y);
+
+	virtual bool write_sparse_begin_wrapped(
+		const TSGDataType* type, index_t length);
+	virtual bool write_sparse_end_wrapped(
+		const TSGDataType* type, index_t length);
+
+	virtual bool write_sparseentry_begin_wrapped(
+		const TSGDataType* type, const SGSparseVectorEntry<char>* first_entry,
+		index_t feat_index, index_t y);
+	virtual bool write_sparseentry_end_wrapped(
+		const TSGDataType* type, const SGSparseVectorEntry<char>* first_entry,
+		index_t feat_index, index_t y);
+
+	virtual bool write_item_begin_wrapped(
+		const TSGDataType* type, index_t y, index_t x);
+	virtual bool write_item_end_wrapped(
+		const TSGDataType* type, index_t y, index_t x);
+
+	virtual bool write_sgserializable_begin_wrapped(
+		const TSGDataType* type, const char* sgserializable_name,
+		EPrimitiveType generic);
+	virtual bool write_sgserializable_end_wrapped(
+		const TSGDataType* type, const char* sgserializable_name,
+		EPrimitiveType generic);
+
+	virtual bool write_type_begin_wrapped(
+		const TSGDataType* type, const char* name,
+		const char* prefix);
+	virtual bool write_type_end_wrapped(
+		const TSGDataType* type, const char* name,
+		const char* prefix);
+
+	virtual bool write_block_wrapped(
+		const TSGDataType* type, const void* data, size_t num_bytes);
+#endif
+public:
+	/** default constructor */
+	explicit CSerializableBinaryFile();
+
+	/** constructor
+	 *
+	 * @param fstream already opened file
+	 * @param rw
+	 */
+	explicit CSerializableBinaryFile(FILE* fstream, char rw);
+
+	/** constructor
+	 *
+	 * @param fname filename to open
+	 * @param rw mode, 'r' or 'w'
+	 */
+	explicit CSerializableBinaryFile(const char* fname, char rw='r');
+
+	/** default destructor */
+	virtual ~CSerializableBinaryFile();
+
+	/** all primitive types but objects are stored as raw blocks
+	 *
+	 * @param type type of the elements
+	 * @return whether blocks of this type are supported
+	 */
+	virtual bool has_block_support(const TSGDataType* type) const;
+
+	/** @return object name */
+	virtual const char* get_name() const {
+		return "SerializableBinaryFile";
+	}
+};
+}
+
+#endif /* __SERIALIZABLE_BINARY_FILE_H__  */
@@ -0,0 +1,306 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: agent
+ */
+
+#include <shogun/io/SerializableBinaryReader00.h>
+#include <shogun/io/SerializableBinaryFile.h>
+#include <shogun/lib/common.h>
+
+#ifndef _MSC_VER
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace shogun;
+
+SerializableBinaryReader00::SerializableBinaryReader00(
+	CSerializableBinaryFile* file)
+	: m_file(file), m_data(NULL), m_size(0), m_mapped(false), m_pos(0)
+{
+	FILE* fstream = m_file->m_fstream;
+
+#ifndef _MSC_VER
+	int fd = fileno(fstream);
+	struct stat sb;
+	if (fd < 0 || fstat(fd, &sb) != 0)
+		return;
+	m_size = sb.st_size;
+
+	if (m_size >= (int64_t) sizeof(SerializableBinaryHeader))
+	{
+		void* mapped = mmap(NULL, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+		if (mapped != MAP_FAILED)
+		{
+			m_data = (char*) mapped;
+			m_mapped = true;
+		}
+	}
+#else
+	if (CSerializableBinaryFile::seek(fstream, 0, SEEK_END))
+		m_size = CSerializableBinaryFile::tell(fstream);
+#endif
+
+	if (m_size < (int64_t) sizeof(SerializableBinaryHeader))
+		return;
+
+	if (!m_mapped)
+	{
+		/* not mappable (e.g. a pipe), read everything at once */
+		m_data = SG_MALLOC(char, m_size);
+		if (!CSerializableBinaryFile::seek(fstream, 0)
+			|| fread(m_data, m_size, 1, fstream) != 1)
+		{
+			SG_FREE(m_data);
+			m_data = NULL;
+			return;
+		}
+	}
+
+	m_pos = sizeof(SerializableBinaryHeader);
+	m_stack_scope_begin.push_back(m_pos);
+	m_stack_scope_end.push_back(m_size);
+}
+
+SerializableBinaryReader00::~SerializableBinaryReader00()
+{
+#ifndef _MSC_VER
+	if (m_mapped)
+	{
+		munmap(m_data, m_size);
+		return;
+	}
+#endif
+	SG_FREE(m_data);
+}
+
+bool
+SerializableBinaryReader00::read_bytes(void* dest, size_t num_bytes)
+{
+	if (m_pos + (int64_t) num_bytes > m_size) return false;
+
+	memcpy(dest, m_data + m_pos, num_bytes);
+	m_pos += num_bytes;
+
+	return true;
+}
+
+bool
+SerializableBinaryReader00::skip_bytes(size_t num_bytes)
+{
+	if (m_pos + (int64_t) num_bytes > m_size) return false;
+
+	m_pos += num_bytes;
+
+	return true;
+}
+
+bool
+SerializableBinaryReader00::read_scalar_wrapped(
+	const TSGDataType* type, void* param)
+{
+	switch (type->m_ptype) {
+	case PT_UNDEFINED:
+	case PT_SGOBJECT:
+		SG_ERROR("read_scalar_wrapped(): Implementation error during"
+				 " reading BinaryFile!");
+		return false;
+	default: break;
+	}
+
+	return read_bytes(param, type->sizeof_ptype());
+}
+
+bool
+SerializableBinaryReader00::read_cont_begin_wrapped(
+	const TSGDataType* type, index_t* len_read_y, index_t* len_read_x)
+{
+	return read_bytes(len_read_y, sizeof(index_t))
+		&& read_bytes(len_read_x, sizeof(index_t))
+		&& *len_read_y >= 0 && *len_read_x >= 0;
+}
+
+bool
+SerializableBinaryReader00::read_cont_end_wrapped(
+	const TSGDataType* type, index_t len_read_y, index_t len_read_x)
+{
+	return true;
+}
+
+bool
+SerializableBinaryReader00::read_string_begin_wrapped(
+	const TSGDataType* type, index_t* length)
+{
+	return read_bytes(length, sizeof(index_t)) && *length >= 0;
+}
+
+bool
+SerializableBinaryReader00::read_string_end_wrapped(
+	const TSGDataType* type, index_t length)
+{
+	return true;
+}
+
+bool
+SerializableBinaryReader00::read_stringentry_begin_wrapped(
+	const TSGDataType* type, index_t y)
+{
+	return true;
+}
+
+bool
+SerializableBinaryReader00::read_stringentry_end_wrapped(
+	const TSGDataType* type, index_t y)
+{
+	return true;
+}
+
+bool
+SerializableBinaryReader00::read_sparse_begin_wrapped(
+	const TSGDataType* type, index_t* length)
+{
+	return read_bytes(length, sizeof(index_t)) && *length >= 0;
+}
+
+bool
+SerializableBinaryReader00::read_sparse_end_wrapped(
+	const TSGDataType* type, index_t length)
+{
+	return true;
+}
+
+bool
+SerializableBinaryReader00::read_sparseentry_begin_wrapped(
+	const TSGDataType* type, SGSparseVectorEntry<char>* first_entry,
+	index_t* feat_index, index_t y)
+{
+	return read_bytes(feat_index, sizeof(index_t));
+}
+
+bool
+SerializableBinaryReader00::read_sparseentry_end_wrapped(
+	const TSGDataType* type, SGSparseVectorEntry<char>* first_entry,
+	index_t* feat_index, index_t y)
+{
+	return true;
+}
+
+bool
+SerializableBinaryReader00::read_item_begin_wrapped(
+	const TSGDataType* type, index_t y, index_t x)
+{
+	return true;
+}
+
+bool
+SerializableBinaryReader00::read_item_end_wrapped(
+	const TSGDataType* type, index_t y, index_t x)
+{
+	return true;
+}
+
+bool
+SerializableBinaryReader00::read_sgserializable_begin_wrapped(
+	const TSGDataType* type, char* sgserializable_name,
+	EPrimitiveType* generic)
+{
+	uint32_t len;
+	if (!read_bytes(&len, sizeof(len)) || len >= STRING_LEN)
+		return false;
+	if (!read_bytes(sgserializable_name, len)) return false;
+	sgserializable_name[len] = '\0';
+
+	if (len == 0) return true;
+
+	int32_t generic_int;
+	uint64_t size;
+	if (!read_bytes(&generic_int, sizeof(generic_int))) return false;
+	if (!read_bytes(&size, sizeof(size))) return false;
+	if (m_pos + (int64_t) size > m_stack_scope_end.back()) return false;
+
+	*generic = (EPrimitiveType) generic_int;
+
+	m_stack_scope_begin.push_back(m_pos);
+	m_stack_scope_end.push_back(m_pos + size);
+
+	return true;
+}
+
+bool
+SerializableBinaryReader00::read_sgserializable_end_wrapped(
+	const TSGDataType* type, const char* sgserializable_name,
+	EPrimitiveType generic)
+{
+	if (*sgserializable_name == '\0') return true;
+
+	m_pos = m_stack_scope_end.back();
+	m_stack_scope_begin.pop_back();
+	m_stack_scope_end.pop_back();
+
+	return true;
+}
+
+bool
+SerializableBinaryReader00::read_type_begin_wrapped(
+	const TSGDataType* type, const char* name, const char* prefix)
+{
+	string_t type_str;
+	type->to_string(type_str, STRING_LEN);
+
+	size_t name_len = strlen(name);
+	size_t type_len = strlen(type_str);
+	int64_t scope_end = m_stack_scope_end.back();
+
+	/* records are skipped by their size, so only the record headers of
+	 * the current object are touched while searching */
+	m_pos = m_stack_scope_begin.back();
+	while (m_pos < scope_end) {
+		uint32_t r_name_len, r_type_len;
+		uint64_t size;
+
+		if (!read_bytes(&r_name_len, sizeof(r_name_len))) return false;
+		const char* r_name = m_data + m_pos;
+		if (!skip_bytes(r_name_len)) return false;
+
+		if (!read_bytes(&r_type_len, sizeof(r_type_len))) return false;
+		const char* r_type = m_data + m_pos;
+		if (!skip_bytes(r_type_len)) return false;
+
+		if (!read_bytes(&size, sizeof(size))) return false;
+		int64_t record_end = m_pos + size;
+		if (record_end > scope_end) return false;
+
+		if (r_name_len == name_len && memcmp(r_name, name, name_len) == 0
+			&& r_type_len == type_len
+			&& memcmp(r_type, type_str, type_len) == 0) {
+			m_stack_record_end.push_back(record_end);
+			return true;
+		}
+
+		m_pos = record_end;
+	}
+
+	return false;
+}
+
+bool
+SerializableBinaryReader00::read_type_end_wrapped(
+	const TSGDataType* type, const char* name, const char* prefix)
+{
+	m_pos = m_stack_record_end.back();
+	m_stack_record_end.pop_back();
+
+	return true;
+}
+
+bool
+SerializableBinaryReader00::read_block_wrapped(
+	const TSGDataType* type, void* data, size_t num_bytes)
+{
+	m_pos = (m_pos + SERIALIZABLE_BINARY_ALIGNMENT - 1)
+		/ SERIALIZABLE_BINARY_ALIGNMENT * SERIALIZABLE_BINARY_ALIGNMENT;
+
+	return read_bytes(data, num_bytes);
+}
@@ -0,0 +1,123 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: agent
+ */
+#ifndef __SERIALIZABLE_BINARY_READER_00_H__
+#define __SERIALIZABLE_BINARY_READER_00_H__
+
+#include <shogun/lib/config.h>
+
+#include <shogun/io/SerializableFile.h>
+#include <shogun/base/DynArray.h>
+
+namespace shogun
+{
+class CSerializableBinaryFile;
+template <class T> struct SGSparseVectorEntry;
+
+/** @brief Serializable binary reader
+ *
+ * Maps the whole file into memory (or, if that fails, reads it at once)
+ * and walks it with a cursor. Parameters are looked up by name within
+ * the record range of the object currently being loaded.
+ */
+class SerializableBinaryReader00
+	: public CSerializableFile::TSerializableReader {
+
+	CSerializableBinaryFile* m_file;
+
+	/** file contents */
+	char* m_data;
+	/** size of the file contents */
+	int64_t m_size;
+	/** whether m_data is a memory mapping, else it is SG_MALLOC'ed */
+	bool m_mapped;
+	/** read cursor */
+	int64_t m_pos;
+
+	/** begin and end of the records of the objects being loaded */
+	DynArray<int64_t> m_stack_scope_begin;
+	DynArray<int64_t> m_stack_scope_end;
+	/** ends of the records of the parameters being loaded */
+	DynArray<int64_t> m_stack_record_end;
+
+	bool read_bytes(void* dest, size_t num_bytes);
+	bool skip_bytes(size_t num_bytes);
+
+public:
+	/** constructor
+	 * @param file
+	 */
+	explicit SerializableBinaryReader00(CSerializableBinaryFile* file);
+
+	/** destructor */
+	virtual ~SerializableBinaryReader00();
+
+	/** @return whether the file contents could be made available */
+	bool is_valid() const { return m_data != NULL; }
+
+	/** @return object name */
+	virtual const char* get_name() const {
+		return "SerializableBinaryReader00";
+	}
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+	virtual bool read_scalar_wrapped(
+		const TSGDataType* type, void* param);
+
+	virtual bool read_cont_begin_wrapped(
+		const TSGDataType* type, index_t* len_read_y,
+		index_t* len_read_x);
+	virtual bool read_cont_end_wrapped(
+		const TSGDataType* type, index_t len_read_y,
+		index_t len_read_x);
+
+	virtual bool read_string_begin_wrapped(
+		const TSGDataType* type, index_t* length);
+	virtual bool read_string_end_wrapped(
+		const TSGDataType* type, index_t length);
+
+	virtual bool read_stringentry_begin_wrapped(
+		const TSGDataType* type, index_t y);
+	virtual bool read_stringentry_end_wrapped(
+		const TSGDataType* type, index_t y);
+
+	virtual bool read_sparse_begin_wrapped(
+		const TSGDataType* type, index_t* length);
+	virtual bool read_sparse_end_wrapped(
+		const TSGDataType* type, index_t length);
+
+	virtual bool read_sparseentry_begin_wrapped(
+		const TSGDataType* type, SGSparseVectorEntry<char>* first_entry,
+		index_t* feat_index, index_t y);
+	virtual bool read_sparseentry_end_wrapped(
+		const TSGDataType* type, SGSparseVectorEntry<char>* first_entry,
+		index_t* feat_index, index_t y);
+
+	virtual bool read_item_begin_wrapped(
+		const TSGDataType* type, index_t y, index_t x);
+	virtual bool read_item_end_wrapped(
+		const TSGDataType* type, index_t y, index_t x);
+
+	virtual bool read_sgserializable_begin_wrapped(
+		const TSGDataType* type, char* sgserializable_name,
+		EPrimitiveType* generic);
+	virtual bool read_sgserializable_end_wrapped(
+		const TSGDataType* type, const char* sgserializable_name,
+		EPrimitiveType generic);
+
+	virtual bool read_type_begin_wrapped(
+		const TSGDataType* type, const char* name,
+		const char* prefix);
+	virtual bool read_type_end_wrapped(
+		const TSGDataType* type, const char* name,
+		const char* prefix);
+
+	virtual bool read_block_wrapped(
+		const TSGDataType* type, void* data, size_t num_bytes);
+#endif
+};
+}
+
+#endif /* __SERIALIZABLE_BINARY_READER_00_H__  */
@@ -79,6 +79,11 @@ public:
 			const TSGDataType* type, const char* name,
 			const char* prefix) = 0;
 
+		virtual bool read_block_wrapped(
+			const TSGDataType* type, void* data, size_t num_bytes)
+		{
+			return false;
+		}
 #endif
 		/* End of abstract write methods  */
 		/* ******************************************************** */
@@ -164,6 +169,12 @@ protected:
 	virtual bool write_type_end_wrapped(
 		const TSGDataType* type, const char* name,
 		const char* prefix) = 0;
+
+	virtual bool write_block_wrapped(
+		const TSGDataType* type, const void* data, size_t num_bytes)
+	{
+		return false;
+	}
 #endif
 
 	/* End of abstract write methods  */
@@ -196,6 +207,20 @@ public:
 	/** is opened */
 	virtual bool is_opened();
 
+	/** whether the format can store the elements of the given type as
+	 * one contiguous block of memory, see write_block() and
+	 * read_block(). If so, TParameter hands over whole containers,
+	 * strings and sparse vectors at once instead of walking them item
+	 * by item.
+	 *
+	 * @param type type of the elements
+	 * @return whether blocks of this type are supported
+	 */
+	virtual bool has_block_support(const TSGDataType* type) const
+	{
+		return false;
+	}
+
 	/* ************************************************************ */
 	/* Begin of public wrappers  */
 
@@ -318,6 +343,13 @@ public:
 		const TSGDataType* type, const char* name, const char* prefix);
 	virtual bool read_type_end(
 		const TSGDataType* type, const char* name, const char* prefix);
+
+	virtual bool write_block(
+		const TSGDataType* type, const char* name, const char* prefix,
+		const void* data, size_t num_bytes);
+	virtual bool read_block(
+		const TSGDataType* type, const char* name, const char* prefix,
+		void* data, size_t num_bytes);
 #endif
 	/* End of public wrappers  */
 	/* ************************************************************ */
@@ -225,6 +225,18 @@ public:
      */
     Example<T>* retrieve_example();
 
+    /**
+     * Retrieves up to max_examples examples from the buffer.
+     * Has to be called with the state lock held, like
+     * retrieve_example().
+     *
+     * @param max_examples maximum number of examples
+     * @param examples array to fill
+     *
+     * @return number of examples retrieved
+     */
+    index_t retrieve_batch(index_t max_examples, Example<T>** examples);
+
     /**
      * Gets the next example, assuming it to be labelled.
      *
@@ -261,6 +273,31 @@ public:
      */
     void finalize_example();
 
+    /**
+     * Gets up to max_examples consecutive examples at once.
+     *
+     * Waits until at least one example is ready and then hands out
+     * everything that has been parsed so far, so the state lock is
+     * taken once per batch rather than once per example. The examples
+     * stay in the ring and must be released with finalize_batch().
+     * An example from get_next_example() that was not finalized yet is
+     * finalized first, so its feature vector must not be used anymore.
+     *
+     * @param max_examples maximum number of examples to get, at most
+     * the ring size are returned
+     * @param examples array of at least max_examples pointers to fill
+     *
+     * @return number of examples fetched, 0 if reading is done
+     */
+    index_t get_next_batch(index_t max_examples, Example<T>** examples);
+
+    /**
+     * Finalize the examples returned by the last get_next_batch() call.
+     *
+     * @param num_examples number of examples to finalize
+     */
+    void finalize_batch(index_t num_examples);
+
     /**
      * End the parser, waiting for the parse thread to complete.
      *
@@ -344,6 +381,9 @@ protected:
     /// Whether to SG_FREE() vector after it is used
     bool free_after_release;
 
+    /// Whether an example from get_next_example() is not finalized yet
+    bool example_in_use;
+
     /// Size of the ring of examples
     int32_t ring_size;
 
@@ -411,6 +451,7 @@ template <class T>
     current_feature_vector = NULL;
 
     free_after_release=true;
+    example_in_use=false;
     ring_size=size;
 }
 
@@ -585,6 +626,28 @@ template <class T> Example<T>* CInputParser<T>::retrieve_example()
     return ex;
 }
 
+template <class T> index_t CInputParser<T>::retrieve_batch(
+        index_t max_examples, Example<T>** examples)
+{
+    if (parsing_done && number_of_vectors_read == number_of_vectors_parsed)
+    {
+        reading_done = true;
+        examples_state_changed.notify_one();
+        return 0;
+    }
+
+    index_t num_ready = number_of_vectors_parsed - number_of_vectors_read;
+    if (num_ready > max_examples)
+        num_ready = max_examples;
+    if (num_ready <= 0)
+        return 0;
+
+    index_t num_examples = examples_ring->get_unused_examples(num_ready, examples);
+    number_of_vectors_read += num_examples;
+
+    return num_examples;
+}
+
 template <class T> int32_t CInputParser<T>::get_next_example(T* &fv,
         int32_t &length, float64_t &label)
 {
@@ -627,6 +690,7 @@ template <class T> int32_t CInputParser<T>::get_next_example(T* &fv,
     fv = ex->fv;
     length = ex->length;
     label = ex->label;
+    example_in_use = true;
 
     return 1;
 }
@@ -643,6 +707,41 @@ template <class T>
     void CInputParser<T>::finalize_example()
 {
     examples_ring->finalize_example(free_after_release);
+    example_in_use = false;
+}
+
+template <class T> index_t CInputParser<T>::get_next_batch(
+        index_t max_examples, Example<T>** examples)
+{
+    /* an example that is still held occupies the read position of the
+     * ring, the batch starts after it */
+    if (example_in_use)
+        finalize_example();
+
+    while (keep_running.load(std::memory_order_acquire))
+    {
+        if (reading_done)
+            return 0;
+
+        std::unique_lock<std::mutex> lock(examples_state_lock);
+        index_t num_examples = retrieve_batch(max_examples, examples);
+
+        if (num_examples > 0)
+            return num_examples;
+
+        if (reading_done)
+            return 0;
+
+        examples_state_changed.wait(lock);
+    }
+
+    return 0;
+}
+
+template <class T>
+    void CInputParser<T>::finalize_batch(index_t num_examples)
+{
+    examples_ring->finalize_examples(num_examples, free_after_release);
 }
 
 template <class T> void CInputParser<T>::end_parser()
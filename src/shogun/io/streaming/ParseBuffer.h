@@ -122,6 +122,19 @@ public:
 	 */
 	Example<T>* get_unused_example();
 
+	/**
+	 * Returns up to max_examples consecutive unused examples, starting
+	 * at the 'read' position, under a single acquisition of the read
+	 * lock. The read position is not advanced, call finalize_examples()
+	 * once the examples have been processed.
+	 *
+	 * @param max_examples maximum number of examples to return
+	 * @param examples array of at least max_examples pointers to fill
+	 *
+	 * @return number of examples returned
+	 */
+	index_t get_unused_examples(index_t max_examples, Example<T>** examples);
+
 	/**
 	 * Copies an example into the buffer, waiting for the
 	 * destination example to be used if necessary.
@@ -141,6 +154,15 @@ public:
 	 */
 	void finalize_example(bool free_after_release);
 
+	/**
+	 * Mark num_examples examples starting at the 'read' position as
+	 * 'used', taking the read lock only once.
+	 *
+	 * @param num_examples number of examples to finalize
+	 * @param free_after_release whether to SG_FREE() the vectors or not
+	 */
+	void finalize_examples(index_t num_examples, bool free_after_release);
+
 	/**
 	 * Set whether all vectors are to be freed
 	 * on destruction. This is true by default.
@@ -320,6 +342,28 @@ Example<T>* CParseBuffer<T>::get_unused_example()
 	return ex;
 }
 
+template <class T>
+index_t CParseBuffer<T>::get_unused_examples(index_t max_examples,
+		Example<T>** examples)
+{
+	std::lock_guard<std::mutex> read_lk(*read_mutex);
+
+	index_t num_examples=0;
+	int32_t current_index=ex_read_index;
+
+	while (num_examples<max_examples && num_examples<ring_size)
+	{
+		std::lock_guard<std::mutex> current_ex_lk(*ex_in_use_mutex[current_index]);
+		if (ex_used[current_index] != E_NOT_USED)
+			break;
+
+		examples[num_examples++]=&ex_ring[current_index];
+		current_index=(current_index + 1) % ring_size;
+	}
+
+	return num_examples;
+}
+
 template <class T>
 int32_t CParseBuffer<T>::copy_example(Example<T> *ex)
 {
@@ -359,5 +403,28 @@ void CParseBuffer<T>::finalize_example(bool free_after_release)
 	inc_read_index();
 }
 
+template <class T>
+void CParseBuffer<T>::finalize_examples(index_t num_examples,
+		bool free_after_release)
+{
+	std::lock_guard<std::mutex> read_lk(*read_mutex);
+
+	for (index_t i=0; i<num_examples; i++)
+	{
+		std::unique_lock<std::mutex> current_ex_lock(*ex_in_use_mutex[ex_read_index]);
+		ex_used[ex_read_index] = E_USED;
+
+		if (free_after_release)
+		{
+			SG_FREE(ex_ring[ex_read_index].fv);
+			ex_ring[ex_read_index].fv=NULL;
+		}
+
+		ex_in_use_cond[ex_read_index]->notify_one();
+		current_ex_lock.unlock();
+		inc_read_index();
+	}
+}
+
 }
 #endif // __PARSEBUFFER_H__
@@ -14,6 +14,7 @@
 #include <shogun/kernel/Kernel.h>
 #include <shogun/kernel/CombinedKernel.h>
 #include <shogun/kernel/CustomKernel.h>
+#include <shogun/kernel/normalizer/IdentityKernelNormalizer.h>
 #include <shogun/features/CombinedFeatures.h>
 #include <string.h>
 #include <shogun/mathematics/Math.h>
@@ -39,6 +40,7 @@ CCombinedKernel::~CCombinedKernel()
 	subkernel_weights_buffer=NULL;
 
 	cleanup();
+	clear_subkernel_cache();
 	SG_UNREF(kernel_array);
 }
 
@@ -187,6 +189,8 @@ bool CCombinedKernel::init(CFeatures* l, CFeatures* r)
 		init_subkernel_weights();
 	}
 
+	clear_subkernel_cache();
+
 	if (!l)
 		SG_ERROR("LHS features are NULL");
 	if (!r)
@@ -259,6 +263,7 @@ bool CCombinedKernel::init(CFeatures* l, CFeatures* r)
 void CCombinedKernel::remove_lhs()
 {
 	delete_optimization();
+	clear_subkernel_cache();
 
 	for (index_t k_idx=0; k_idx<get_num_kernels(); k_idx++)
 	{
@@ -276,6 +281,7 @@ void CCombinedKernel::remove_lhs()
 void CCombinedKernel::remove_rhs()
 {
 	delete_optimization();
+	clear_subkernel_cache();
 
 	for (index_t k_idx=0; k_idx<get_num_kernels(); k_idx++)
 	{
@@ -293,6 +299,7 @@ void CCombinedKernel::remove_rhs()
 void CCombinedKernel::remove_lhs_and_rhs()
 {
 	delete_optimization();
+	clear_subkernel_cache();
 
 	for (index_t k_idx=0; k_idx<get_num_kernels(); k_idx++)
 	{
@@ -311,6 +318,8 @@ void CCombinedKernel::remove_lhs_and_rhs()
 
 void CCombinedKernel::cleanup()
 {
+	clear_subkernel_cache();
+
 	for (index_t k_idx=0; k_idx<get_num_kernels(); k_idx++)
 	{
 		CKernel* k = get_kernel(k_idx);
@@ -343,6 +352,20 @@ void CCombinedKernel::list_kernels()
 float64_t CCombinedKernel::compute(int32_t x, int32_t y)
 {
 	float64_t result=0;
+
+	if (subkernel_cache)
+	{
+		const int64_t offs=subkernel_cache_offset(x, y);
+		for (index_t k_idx=0; k_idx<subkernel_cache_num_kernels; k_idx++)
+		{
+			float64_t weight=subkernel_weight(k_idx);
+			if (weight!=0)
+				result += weight * subkernel_cache[subkernel_cache_block*k_idx+offs];
+		}
+
+		return result;
+	}
+
 	for (index_t k_idx=0; k_idx<get_num_kernels(); k_idx++)
 	{
 		CKernel* k = get_kernel(k_idx);
@@ -727,12 +750,191 @@ bool CCombinedKernel::precompute_subkernels()
 	return true;
 }
 
+bool CCombinedKernel::precompute_subkernel_cache()
+{
+	REQUIRE(!append_subkernel_weights, "%s::precompute_subkernel_cache(): "
+		"not supported with appended subkernel weights\n", get_name());
+
+	clear_subkernel_cache();
+
+	if (get_num_kernels()==0 || !initialized || !num_lhs || !num_rhs)
+		return false;
+
+	// cached entries are the weighted sums that compute() returns, a
+	// normalizer of the combined kernel would have to be applied on top
+	if (!dynamic_cast<CIdentityKernelNormalizer*>(normalizer))
+	{
+		SG_WARNING("%s::precompute_subkernel_cache(): not caching with "
+			"normalizer %s\n", get_name(), normalizer ? normalizer->get_name() : "NULL");
+		return false;
+	}
+
+	const int32_t num_kernels=get_num_kernels();
+	const bool symmetric=lhs_equals_rhs && num_lhs==num_rhs;
+	const int64_t block=symmetric ? int64_t(num_lhs)*(num_lhs+1)/2
+		: int64_t(num_lhs)*num_rhs;
+	float32_t* cache=SG_MALLOC(float32_t, block*num_kernels);
+
+	SG_DEBUG("Caching %d subkernel Gram matrices of size %dx%d%s\n",
+		num_kernels, num_lhs, num_rhs, symmetric ? " (upper triangle)" : "")
+
+	subkernel_cache_symmetric=symmetric;
+	subkernel_cache_block=block;
+
+	for (index_t k_idx=0; k_idx<num_kernels; k_idx++)
+	{
+		CKernel* k=get_kernel(k_idx);
+		float32_t* gram=cache+block*k_idx;
+		const int32_t n_lhs=num_lhs;
+		const int32_t n_rhs=num_rhs;
+
+		// rows are independent, for symmetric kernels only the upper part
+		// of every row is stored
+#pragma omp parallel for schedule(dynamic)
+		for (int32_t x=0; x<n_lhs; x++)
+		{
+			float32_t* row=gram+subkernel_cache_offset(x, symmetric ? x : 0);
+			for (int32_t y=symmetric ? x : 0; y<n_rhs; y++)
+				*row++=k->kernel(x, y);
+		}
+
+		SG_UNREF(k);
+	}
+
+	subkernel_cache=cache;
+	subkernel_cache_num_kernels=num_kernels;
+
+	return true;
+}
+
+void CCombinedKernel::clear_subkernel_cache()
+{
+	SG_FREE(subkernel_cache);
+	subkernel_cache=NULL;
+	subkernel_cache_num_kernels=0;
+	subkernel_cache_block=0;
+	subkernel_cache_symmetric=false;
+}
+
+float64_t CCombinedKernel::compute_subkernel(int32_t k_idx, int32_t x, int32_t y)
+{
+	REQUIRE(k_idx>=0 && k_idx<get_num_kernels(), "%s::compute_subkernel(): "
+		"kernel index %d out of range\n", get_name(), k_idx);
+
+	if (subkernel_cache)
+		return subkernel_cache[subkernel_cache_block*k_idx+subkernel_cache_offset(x, y)];
+
+	CKernel* k=get_kernel(k_idx);
+	float64_t result=k->kernel(x, y);
+	SG_UNREF(k);
+
+	return result;
+}
+
+SGVector<float64_t> CCombinedKernel::get_kernel_col(int32_t j)
+{
+	if (!subkernel_cache)
+		return CKernel::get_kernel_col(j);
+
+	REQUIRE(j>=0 && j<num_rhs, "%s::get_kernel_col(): index %d out of range\n",
+		get_name(), j);
+
+	// a symmetric matrix has equal rows and columns
+	if (subkernel_cache_symmetric)
+		return get_kernel_row(j);
+
+	SGVector<float64_t> col(num_lhs);
+	Map<VectorXd> eigen_col(col.vector, col.vlen);
+	eigen_col.setZero();
+
+	for (index_t k_idx=0; k_idx<subkernel_cache_num_kernels; k_idx++)
+	{
+		float64_t weight=subkernel_weight(k_idx);
+		if (weight==0)
+			continue;
+
+		Map<MatrixXf> gram(subkernel_cache+subkernel_cache_block*k_idx, num_rhs, num_lhs);
+		eigen_col+=weight*gram.row(j).transpose().cast<float64_t>();
+	}
+
+	for (int32_t i=0; i<num_lhs; i++)
+		col[i]=normalizer->normalize(col[i], i, j);
+
+	return col;
+}
+
+SGVector<float64_t> CCombinedKernel::get_kernel_row(int32_t i)
+{
+	if (!subkernel_cache)
+		return CKernel::get_kernel_row(i);
+
+	REQUIRE(i>=0 && i<num_lhs, "%s::get_kernel_row(): index %d out of range\n",
+		get_name(), i);
+
+	SGVector<float64_t> row(num_rhs);
+	row.zero();
+
+	for (index_t k_idx=0; k_idx<subkernel_cache_num_kernels; k_idx++)
+	{
+		float64_t weight=subkernel_weight(k_idx);
+		if (weight!=0)
+			add_cached_subkernel_row(k_idx, i, weight, row.vector);
+	}
+
+	for (int32_t j=0; j<num_rhs; j++)
+		row[j]=normalizer->normalize(row[j], i, j);
+
+	return row;
+}
+
+#ifdef USE_SVMLIGHT
+void CCombinedKernel::get_subkernel_row(int32_t k_idx, int32_t docnum, float64_t* buffer)
+{
+	REQUIRE(k_idx>=0 && k_idx<get_num_kernels(), "%s::get_subkernel_row(): "
+		"kernel index %d out of range\n", get_name(), k_idx);
+
+	if (!subkernel_cache)
+	{
+		CKernel* k=get_kernel(k_idx);
+		k->get_kernel_row(docnum, NULL, buffer, true);
+		SG_UNREF(k);
+		return;
+	}
+
+	if (docnum>=num_lhs)
+		docnum=2*num_lhs-1-docnum;
+
+	SGVector<float64_t>::fill_vector(buffer, num_rhs, 0.0);
+	add_cached_subkernel_row(k_idx, docnum, 1.0, buffer);
+}
+#endif //USE_SVMLIGHT
+
+void CCombinedKernel::add_cached_subkernel_row(int32_t k_idx, int32_t i,
+	float64_t weight, float64_t* row) const
+{
+	// contiguous part of the stored row, in the upper triangle the part
+	// left of the diagonal is gathered from the rows above
+	const int32_t first=subkernel_cache_symmetric ? i : 0;
+	const float32_t* gram=subkernel_cache+subkernel_cache_block*k_idx;
+
+	Map<VectorXd> eigen_row(row+first, num_rhs-first);
+	Map<const VectorXf> sub_row(gram+subkernel_cache_offset(i, first), num_rhs-first);
+	eigen_row+=weight*sub_row.cast<float64_t>();
+
+	for (int32_t j=0; j<first; j++)
+		row[j]+=weight*gram[subkernel_cache_offset(j, i)];
+}
+
 void CCombinedKernel::init()
 {
 	sv_count=0;
 	sv_idx=NULL;
 	sv_weight=NULL;
 	subkernel_weights_buffer=NULL;
+	subkernel_cache=NULL;
+	subkernel_cache_num_kernels=0;
+	subkernel_cache_block=0;
+	subkernel_cache_symmetric=false;
 	initialized=false;
 	append_subkernel_weights = false;
 
@@ -158,6 +158,7 @@ class CCombinedKernel : public CKernel
 			if (!(k->has_property(KP_LINADD)))
 				unset_property(KP_LINADD);
 
+			clear_subkernel_cache();
 			return kernel_array->insert_element(k, idx);
 		}
 
@@ -201,6 +202,7 @@ class CCombinedKernel : public CKernel
 				unset_property(KP_LINADD);
 
 			int n = get_num_kernels();
+			clear_subkernel_cache();
 			kernel_array->push_back(k);
 
 			if(enable_subkernel_weight_opt && n+1==get_num_kernels())
@@ -217,6 +219,7 @@ class CCombinedKernel : public CKernel
 		 */
 		inline bool delete_kernel(int32_t idx)
 		{
+			clear_subkernel_cache();
 			bool succesful_deletion = kernel_array->delete_element(idx);
 
 			if (get_num_kernels()==0)
@@ -386,6 +389,64 @@ class CCombinedKernel : public CKernel
 		/** precompute all sub-kernels */
 		bool precompute_subkernels();
 
+		/** precompute the Gram matrices of all sub-kernels into a single
+		 * float32 store, in parallel. In contrast to precompute_subkernels()
+		 * the sub-kernels are kept and their weights may still change, which
+		 * makes this suitable for MKL: kernel entries and rows are formed as
+		 * weighted sums of the cached sub-kernel entries and rows.
+		 *
+		 * If lhs and rhs are the same only the upper triangle of every
+		 * Gram matrix is stored. The cache is dropped whenever features or
+		 * sub-kernels change. Only supported if subkernel weights are not
+		 * appended and the combined kernel uses the identity normalizer.
+		 *
+		 * @return whether the cache was built
+		 */
+		bool precompute_subkernel_cache();
+
+		/** drop the sub-kernel Gram matrix cache */
+		void clear_subkernel_cache();
+
+		/** @return whether sub-kernel Gram matrices are cached */
+		inline bool has_subkernel_cache() const
+		{
+			return subkernel_cache!=NULL;
+		}
+
+		/** compute an (unweighted) entry of a sub-kernel, served from the
+		 * sub-kernel cache if present
+		 *
+		 * @param k_idx index of the sub-kernel
+		 * @param x x
+		 * @param y y
+		 * @return sub-kernel value
+		 */
+		float64_t compute_subkernel(int32_t k_idx, int32_t x, int32_t y);
+
+#ifdef USE_SVMLIGHT
+		/** get a full (unweighted) row of a sub-kernel as the svmlight solvers
+		 * request it, served from the sub-kernel cache if present
+		 *
+		 * @param k_idx index of the sub-kernel
+		 * @param docnum row, indices beyond num_lhs are mirrored as in
+		 * CKernel::get_kernel_row(int32_t, int32_t*, float64_t*, bool)
+		 * @param buffer of length num_rhs to hold the row
+		 */
+		void get_subkernel_row(int32_t k_idx, int32_t docnum, float64_t* buffer);
+#endif //USE_SVMLIGHT
+
+		/** get column j, formed from the sub-kernel cache if present
+		 *
+		 * @return the jth column of the kernel matrix
+		 */
+		virtual SGVector<float64_t> get_kernel_col(int32_t j);
+
+		/** get row i, formed from the sub-kernel cache if present
+		 *
+		 * @return the ith row of the kernel matrix
+		 */
+		virtual SGVector<float64_t> get_kernel_row(int32_t i);
+
 		/** Returns a  casted version of the given kernel. Throws an error
 		 * if parameter is not of class CombinedKernel. SG_REF's the returned
 		 * kernel
@@ -526,6 +587,37 @@ class CCombinedKernel : public CKernel
 		bool enable_subkernel_weight_opt;
 		/** update the weight for subkernels */
 		bool weight_update;
+
+		/** weight of a sub-kernel, without touching its reference count */
+		inline float64_t subkernel_weight(int32_t k_idx) const
+		{
+			return ((CKernel*) kernel_array->get_array()[k_idx])->get_combined_kernel_weight();
+		}
+
+		/** add a weighted row of a cached sub-kernel Gram matrix to row */
+		void add_cached_subkernel_row(int32_t k_idx, int32_t i, float64_t weight,
+			float64_t* row) const;
+
+		/** offset of entry (x,y) in a cached sub-kernel Gram matrix */
+		inline int64_t subkernel_cache_offset(int32_t x, int32_t y) const
+		{
+			if (!subkernel_cache_symmetric)
+				return int64_t(x)*num_rhs+y;
+
+			if (x>y)
+				CMath::swap(x, y);
+			return int64_t(x)*num_lhs-int64_t(x)*(x-1)/2+(y-x);
+		}
+
+		/** sub-kernel Gram matrices, each stored row by row, or as packed
+		 * upper triangle if symmetric */
+		float32_t* subkernel_cache;
+		/** number of sub-kernels in the cache */
+		int32_t subkernel_cache_num_kernels;
+		/** number of cached entries per sub-kernel */
+		int64_t subkernel_cache_block;
+		/** whether only the upper triangles are cached */
+		bool subkernel_cache_symmetric;
 };
 }
 #endif /* _COMBINEDKERNEL_H__ */
@@ -14,9 +14,31 @@
 #include <shogun/io/SGIO.h>
 #include <shogun/mathematics/linalg/LinalgNamespace.h>
 
+#include <string.h>
+
 using namespace shogun;
 using namespace linalg;
 
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+namespace
+{
+/** header of a tiled upper triangle kernel matrix file */
+struct CustomKernelFileHeader
+{
+	char magic[4];
+	int32_t version;
+	int32_t num_vectors;
+	int32_t tile_size;
+	int32_t element_size;
+};
+
+const char CUSTOM_KERNEL_FILE_MAGIC[4]={'S', 'G', 'K', 'M'};
+const int32_t CUSTOM_KERNEL_FILE_VERSION=1;
+/** tiles start on a page boundary */
+const int64_t CUSTOM_KERNEL_FILE_DATA_OFFSET=4096;
+}
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
 void CCustomKernel::init()
 {
 	m_row_subset_stack=new CSubsetStack();
@@ -25,6 +47,12 @@ void CCustomKernel::init()
 	SG_REF(m_col_subset_stack)
 	m_is_symmetric=false;
 	m_free_km=true;
+	m_mapped_file=NULL;
+	m_mapped_tiles=NULL;
+	m_mapped_num=0;
+	m_mapped_tile_size=0;
+	m_mapped_num_tiles=0;
+	m_mapped_float16=false;
 
 	SG_ADD((CSGObject**)&m_row_subset_stack, "row_subset_stack",
 			"Subset stack of rows");
@@ -35,6 +63,12 @@ void CCustomKernel::init()
 	SG_ADD(&m_is_symmetric, "is_symmetric", "Whether kernel matrix is symmetric");
 	SG_ADD(&kmatrix, "kmatrix", "Kernel matrix.");
 	SG_ADD(&upper_diagonal, "upper_diagonal", "Upper diagonal");
+	SG_ADD(&m_mapped_fname, "mapped_fname",
+			"File the kernel matrix is memory mapped from");
+	SG_ADD(&m_mapped_tile_size, "mapped_tile_size",
+			"Edge length of the tiles in the mapped file");
+	SG_ADD(&m_mapped_float16, "mapped_float16",
+			"Whether the mapped file holds 16bit floats");
 }
 
 CCustomKernel::CCustomKernel()
@@ -51,7 +85,7 @@ CCustomKernel::CCustomKernel(CKernel* k)
 	init();
 
 	/* if constructed from a custom kernel, use same kernel matrix */
-	if (k->get_kernel_type()==K_CUSTOM)
+	if (k->get_kernel_type()==K_CUSTOM && !((CCustomKernel*)k)->is_memory_mapped())
 	{
 		CCustomKernel* casted=(CCustomKernel*)k;
 		m_is_symmetric=casted->m_is_symmetric;
@@ -145,10 +179,12 @@ bool CCustomKernel::init(CFeatures* l, CFeatures* r)
 
 	lhs_equals_rhs=m_is_symmetric;
 
-	SG_DEBUG("num_vec_lhs: %d vs num_rows %d\n", l->get_num_vectors(), kmatrix.num_rows)
-	SG_DEBUG("num_vec_rhs: %d vs num_cols %d\n", r->get_num_vectors(), kmatrix.num_cols)
-	ASSERT(l->get_num_vectors()==kmatrix.num_rows)
-	ASSERT(r->get_num_vectors()==kmatrix.num_cols)
+	int32_t num_rows=m_mapped_file ? m_mapped_num : kmatrix.num_rows;
+	int32_t num_cols=m_mapped_file ? m_mapped_num : kmatrix.num_cols;
+	SG_DEBUG("num_vec_lhs: %d vs num_rows %d\n", l->get_num_vectors(), num_rows)
+	SG_DEBUG("num_vec_rhs: %d vs num_cols %d\n", r->get_num_vectors(), num_cols)
+	ASSERT(l->get_num_vectors()==num_rows)
+	ASSERT(r->get_num_vectors()==num_cols)
 	return init_normalizer();
 }
 
@@ -157,9 +193,11 @@ float64_t CCustomKernel::sum_symmetric_block(index_t block_begin,
 {
 	SG_DEBUG("Entering\n");
 
-	if (m_row_subset_stack->has_subsets() || m_col_subset_stack->has_subsets())
+	if (m_mapped_file || m_row_subset_stack->has_subsets() ||
+			m_col_subset_stack->has_subsets())
 	{
-		SG_INFO("Row/col subsets initialized! Falling back to "
+		SG_INFO("Kernel matrix is memory mapped or row/col subsets "
+				"initialized! Falling back to "
 				"CKernel::sum_symmetric_block (slower)!\n");
 		return CKernel::sum_symmetric_block(block_begin, block_size, no_diag);
 	}
@@ -185,9 +223,11 @@ float64_t CCustomKernel::sum_block(index_t block_begin_row,
 {
 	SG_DEBUG("Entering\n");
 
-	if (m_row_subset_stack->has_subsets() || m_col_subset_stack->has_subsets())
+	if (m_mapped_file || m_row_subset_stack->has_subsets() ||
+			m_col_subset_stack->has_subsets())
 	{
-		SG_INFO("Row/col subsets initialized! Falling back to "
+		SG_INFO("Kernel matrix is memory mapped or row/col subsets "
+				"initialized! Falling back to "
 				"CKernel::sum_block (slower)!\n");
 		return CKernel::sum_block(block_begin_row, block_begin_col,
 				block_size_row, block_size_col, no_diag);
@@ -224,9 +264,11 @@ SGVector<float64_t> CCustomKernel::row_wise_sum_symmetric_block(index_t
 {
 	SG_DEBUG("Entering\n");
 
-	if (m_row_subset_stack->has_subsets() || m_col_subset_stack->has_subsets())
+	if (m_mapped_file || m_row_subset_stack->has_subsets() ||
+			m_col_subset_stack->has_subsets())
 	{
-		SG_INFO("Row/col subsets initialized! Falling back to "
+		SG_INFO("Kernel matrix is memory mapped or row/col subsets "
+				"initialized! Falling back to "
 				"CKernel::row_wise_sum_symmetric_block (slower)!\n");
 		return CKernel::row_wise_sum_symmetric_block(block_begin, block_size,
 				no_diag);
@@ -259,9 +301,11 @@ SGMatrix<float64_t> CCustomKernel::row_wise_sum_squared_sum_symmetric_block(
 {
 	SG_DEBUG("Entering\n");
 
-	if (m_row_subset_stack->has_subsets() || m_col_subset_stack->has_subsets())
+	if (m_mapped_file || m_row_subset_stack->has_subsets() ||
+			m_col_subset_stack->has_subsets())
 	{
-		SG_INFO("Row/col subsets initialized! Falling back to "
+		SG_INFO("Kernel matrix is memory mapped or row/col subsets "
+				"initialized! Falling back to "
 				"CKernel::row_wise_sum_squared_sum_symmetric_block (slower)!\n");
 		return CKernel::row_wise_sum_squared_sum_symmetric_block(block_begin,
 				block_size, no_diag);
@@ -305,9 +349,11 @@ SGVector<float64_t> CCustomKernel::row_col_wise_sum_block(index_t
 {
 	SG_DEBUG("Entering\n");
 
-	if (m_row_subset_stack->has_subsets() || m_col_subset_stack->has_subsets())
+	if (m_mapped_file || m_row_subset_stack->has_subsets() ||
+			m_col_subset_stack->has_subsets())
 	{
-		SG_INFO("Row/col subsets initialized! Falling back to "
+		SG_INFO("Kernel matrix is memory mapped or row/col subsets "
+				"initialized! Falling back to "
 				"CKernel::row_col_wise_sum_block (slower)!\n");
 		return CKernel::row_col_wise_sum_block(block_begin_row, block_begin_col,
 				block_size_row, block_size_col, no_diag);
@@ -366,6 +412,14 @@ void CCustomKernel::cleanup_custom()
 	kmatrix=SGMatrix<float32_t>();
 	upper_diagonal=false;
 
+	SG_UNREF(m_mapped_file);
+	m_mapped_fname=SGVector<char>();
+	m_mapped_tiles=NULL;
+	m_mapped_num=0;
+	m_mapped_tile_size=0;
+	m_mapped_num_tiles=0;
+	m_mapped_float16=false;
+
 	SG_DEBUG("Leaving\n")
 }
 
@@ -404,7 +458,7 @@ void CCustomKernel::row_subset_changed_post()
 	if (m_row_subset_stack->has_subsets())
 		num_lhs=m_row_subset_stack->get_size();
 	else
-		num_lhs=kmatrix.num_rows;
+		num_lhs=m_mapped_file ? m_mapped_num : kmatrix.num_rows;
 }
 
 void CCustomKernel::add_col_subset(SGVector<index_t> subset)
@@ -436,5 +490,271 @@ void CCustomKernel::col_subset_changed_post()
 	if (m_col_subset_stack->has_subsets())
 		num_rhs=m_col_subset_stack->get_size();
 	else
-		num_rhs=kmatrix.num_cols;
+		num_rhs=m_mapped_file ? m_mapped_num : kmatrix.num_cols;
+}
+
+bool CCustomKernel::set_triangle_kernel_matrix_from_file(const char* fname)
+{
+	if (m_row_subset_stack->has_subsets() || m_col_subset_stack->has_subsets())
+	{
+		SG_ERROR("%s::set_triangle_kernel_matrix_from_file not possible "
+				"with subset. Remove first\n", get_name());
+	}
+
+	cleanup_custom();
+	map_triangle_kernel_matrix_file(fname);
+
+	int32_t len=strlen(fname);
+	m_mapped_fname=SGVector<char>(len+1);
+	memcpy(m_mapped_fname.vector, fname, len+1);
+
+	m_is_symmetric=true;
+	dummy_init(m_mapped_num, m_mapped_num);
+	return true;
+}
+
+void CCustomKernel::map_triangle_kernel_matrix_file(const char* fname)
+{
+	CMemoryMappedFile<char>* file=new CMemoryMappedFile<char>(fname, 'r');
+	SG_REF(file);
+
+	CustomKernelFileHeader header;
+	if (file->get_size()<uint64_t(CUSTOM_KERNEL_FILE_DATA_OFFSET))
+	{
+		SG_UNREF(file);
+		SG_ERROR("%s::set_triangle_kernel_matrix_from_file(): %s is too small\n",
+				get_name(), fname);
+	}
+	memcpy(&header, file->get_map(), sizeof(header));
+
+	if (memcmp(header.magic, CUSTOM_KERNEL_FILE_MAGIC, 4) ||
+		header.version!=CUSTOM_KERNEL_FILE_VERSION ||
+		(header.element_size!=sizeof(float32_t) && header.element_size!=sizeof(uint16_t)) ||
+		header.num_vectors<=0 || header.tile_size<=0)
+	{
+		SG_UNREF(file);
+		SG_ERROR("%s::set_triangle_kernel_matrix_from_file(): %s is not a "
+				"kernel matrix file of version %d\n", get_name(), fname,
+				CUSTOM_KERNEL_FILE_VERSION);
+	}
+
+	int64_t t=header.tile_size;
+	int64_t num_tiles=(header.num_vectors+t-1)/t;
+	int64_t size=CUSTOM_KERNEL_FILE_DATA_OFFSET+
+		num_tiles*(num_tiles+1)/2*t*t*header.element_size;
+	if (file->get_size()<uint64_t(size))
+	{
+		SG_UNREF(file);
+		SG_ERROR("%s::set_triangle_kernel_matrix_from_file(): %s is truncated, "
+				"expected %" PRId64 " bytes\n", get_name(), fname, size);
+	}
+
+	SG_UNREF(m_mapped_file);
+	m_mapped_file=file;
+	m_mapped_tiles=file->get_map()+CUSTOM_KERNEL_FILE_DATA_OFFSET;
+	m_mapped_num=header.num_vectors;
+	m_mapped_tile_size=header.tile_size;
+	m_mapped_num_tiles=num_tiles;
+	m_mapped_float16=header.element_size==sizeof(uint16_t);
+
+	SG_DEBUG("using memory mapped custom kernel of size %dx%d\n",
+			m_mapped_num, m_mapped_num)
+}
+
+void CCustomKernel::load_serializable_post() noexcept(false)
+{
+	CKernel::load_serializable_post();
+
+	if (!m_mapped_fname.vlen)
+		return;
+
+	// only the name and format of a mapped file are serialized, map it again
+	const int32_t tile_size=m_mapped_tile_size;
+	const bool use_float16=m_mapped_float16;
+	map_triangle_kernel_matrix_file(m_mapped_fname.vector);
+
+	REQUIRE(m_mapped_tile_size==tile_size && m_mapped_float16==use_float16,
+			"%s::load_serializable_post(): format of %s changed since the "
+			"kernel was saved\n", get_name(), m_mapped_fname.vector);
+
+	row_subset_changed_post();
+	col_subset_changed_post();
+}
+
+bool CCustomKernel::save_triangle_kernel_matrix_to_file(CKernel* k,
+	const char* fname, int32_t tile_size, bool use_float16)
+{
+	REQUIRE(k, "Kernel must not be NULL\n");
+	REQUIRE(k->has_features(), "Kernel %s is not initialized\n", k->get_name());
+	REQUIRE(k->get_num_vec_lhs()==k->get_num_vec_rhs(), "Kernel matrix of "
+			"%s is not square (%dx%d)\n", k->get_name(), k->get_num_vec_lhs(),
+			k->get_num_vec_rhs());
+	REQUIRE(tile_size>0, "Tile size (%d) must be positive\n", tile_size);
+
+	CustomKernelFileHeader header;
+	memcpy(header.magic, CUSTOM_KERNEL_FILE_MAGIC, 4);
+	header.version=CUSTOM_KERNEL_FILE_VERSION;
+	header.num_vectors=k->get_num_vec_lhs();
+	header.tile_size=tile_size;
+	header.element_size=use_float16 ? sizeof(uint16_t) : sizeof(float32_t);
+
+	const int64_t n=header.num_vectors;
+	const int64_t t=tile_size;
+	const int64_t num_tiles=(n+t-1)/t;
+	const int64_t tile_elems=t*t;
+	const int64_t size=CUSTOM_KERNEL_FILE_DATA_OFFSET+
+		num_tiles*(num_tiles+1)/2*tile_elems*header.element_size;
+
+	CMemoryMappedFile<char>* file=new CMemoryMappedFile<char>(fname, 'w', size);
+	SG_REF(file);
+	file->set_truncate_size(size);
+
+	char* map=file->get_map();
+	memset(map, 0, CUSTOM_KERNEL_FILE_DATA_OFFSET);
+	memcpy(map, &header, sizeof(header));
+	float32_t* tiles32=(float32_t*) (map+CUSTOM_KERNEL_FILE_DATA_OFFSET);
+	uint16_t* tiles16=(uint16_t*) (map+CUSTOM_KERNEL_FILE_DATA_OFFSET);
+
+	// tiles of a tile row are stored consecutively, entries within a tile
+	// row by row, diagonal tiles are stored completely
+#pragma omp parallel for schedule(dynamic)
+	for (int64_t ti=0; ti<num_tiles; ti++)
+	{
+		int64_t offs=(ti*num_tiles-ti*(ti-1)/2)*tile_elems;
+		for (int64_t tj=ti; tj<num_tiles; tj++, offs+=tile_elems)
+		{
+			for (int64_t a=0; a<t; a++)
+			{
+				for (int64_t b=0; b<t; b++)
+				{
+					int64_t i=ti*t+a;
+					int64_t j=tj*t+b;
+					int64_t idx=offs+a*t+b;
+
+					float32_t v=0;
+					if (ti==tj && b<a)
+						v=use_float16 ? half_to_float(tiles16[offs+b*t+a]) : tiles32[offs+b*t+a];
+					else if (i<n && j<n)
+						v=k->kernel(i, j);
+
+					if (use_float16)
+						tiles16[idx]=float_to_half(v);
+					else
+						tiles32[idx]=v;
+				}
+			}
+		}
+	}
+
+	SG_UNREF(file);
+	return true;
+}
+
+void CCustomKernel::prefetch_rows(const int32_t* rows, int32_t num_rows)
+{
+#ifndef _MSC_VER
+	if (!m_mapped_file)
+		return;
+
+	const int64_t page_size=sysconf(_SC_PAGESIZE);
+	const int64_t elem_size=m_mapped_float16 ? sizeof(uint16_t) : sizeof(float32_t);
+	const int64_t tile_bytes=int64_t(m_mapped_tile_size)*m_mapped_tile_size*elem_size;
+
+	// advise a byte range of the tiles, aligned to page boundaries
+	auto advise=[&](int64_t begin, int64_t end)
+	{
+		const char* first=m_mapped_tiles+begin;
+		char* aligned=(char*) (uintptr_t(first) & ~uintptr_t(page_size-1));
+		madvise(aligned, (m_mapped_tiles+end)-aligned, MADV_WILLNEED);
+	};
+
+	for (int32_t r=0; r<num_rows; r++)
+	{
+		int64_t row=m_row_subset_stack->subset_idx_conversion(rows[r]);
+		int64_t ti=row/m_mapped_tile_size;
+
+		// row ti of tiles holds all columns right of the diagonal tile and is
+		// contiguous, columns left of it are found in tile column ti
+		advise(mapped_tile_offset(ti, ti)*elem_size,
+				mapped_tile_offset(ti, m_mapped_num_tiles-1)*elem_size+tile_bytes);
+		for (int64_t tj=0; tj<ti; tj++)
+		{
+			int64_t offs=mapped_tile_offset(tj, ti)*elem_size;
+			advise(offs, offs+tile_bytes);
+		}
+	}
+#endif
+}
+
+float32_t CCustomKernel::half_to_float(uint16_t h)
+{
+	uint32_t sign=uint32_t(h & 0x8000) << 16;
+	uint32_t exp=(h >> 10) & 0x1f;
+	uint32_t mant=h & 0x3ff;
+	uint32_t bits;
+
+	if (exp==0)
+	{
+		if (mant==0)
+			bits=sign;
+		else
+		{
+			// subnormal, normalize the mantissa
+			exp=127-15+1;
+			while (!(mant & 0x400))
+			{
+				mant<<=1;
+				exp--;
+			}
+			bits=sign | (exp << 23) | ((mant & 0x3ff) << 13);
+		}
+	}
+	else if (exp==0x1f)
+		bits=sign | 0x7f800000 | (mant << 13);
+	else
+		bits=sign | ((exp+127-15) << 23) | (mant << 13);
+
+	float32_t f;
+	memcpy(&f, &bits, sizeof(f));
+	return f;
+}
+
+uint16_t CCustomKernel::float_to_half(float32_t f)
+{
+	uint32_t bits;
+	memcpy(&bits, &f, sizeof(bits));
+
+	uint32_t sign=(bits >> 16) & 0x8000;
+	int32_t float_exp=(bits >> 23) & 0xff;
+	int32_t exp=float_exp-127+15;
+	uint32_t mant=bits & 0x7fffff;
+
+	if (float_exp==0xff)
+		return sign | 0x7c00 | (mant ? 0x200 : 0);
+	if (exp>=0x1f)
+		return sign | 0x7c00;
+
+	if (exp<=0)
+	{
+		if (exp<-10)
+			return sign;
+
+		// subnormal, round to nearest even
+		mant|=0x800000;
+		uint32_t shift=14-exp;
+		uint32_t half_mant=mant >> shift;
+		uint32_t rem=mant & ((1u << shift)-1);
+		uint32_t halfway=1u << (shift-1);
+		if (rem>halfway || (rem==halfway && (half_mant & 1)))
+			half_mant++;
+
+		return sign | half_mant;
+	}
+
+	uint32_t half=sign | (exp << 10) | (mant >> 13);
+	uint32_t rem=mant & 0x1fff;
+	if (rem>0x1000 || (rem==0x1000 && (half & 1)))
+		half++;
+
+	return half;
 }
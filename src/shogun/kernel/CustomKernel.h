@@ -14,6 +14,7 @@
 #include <shogun/lib/common.h>
 #include <shogun/kernel/Kernel.h>
 #include <shogun/features/Features.h>
+#include <shogun/io/MemoryMappedFile.h>
 
 namespace shogun
 {
@@ -27,6 +28,11 @@ namespace shogun
  * The custom kernel supports subsets each on the rows and the columns. See
  * documentation in CFeatures, CLabels how this works. The interface is similar.
  *
+ * Symmetric kernel matrices that do not fit into memory can be written to
+ * disk with save_triangle_kernel_matrix_to_file() and attached via
+ * set_triangle_kernel_matrix_from_file(). The upper triangle is stored in
+ * square tiles (optionally as 16bit floats) and memory mapped, so only the
+ * pages holding requested entries are read from disk.
  *
  */
 class CCustomKernel: public CKernel
@@ -539,6 +545,47 @@ class CCustomKernel: public CKernel
 			return (get_num_vec_lhs()>0) && (get_num_vec_rhs()>0);
 		}
 
+		/** attach to an upper triangle kernel matrix stored in a file written
+		 * by save_triangle_kernel_matrix_to_file(). The file is memory mapped,
+		 * entries are read from disk on demand. Serializing the kernel stores
+		 * only the file name and format, the file is mapped again on loading.
+		 *
+		 * @param fname name of the kernel matrix file
+		 * @return if setting was successful
+		 */
+		bool set_triangle_kernel_matrix_from_file(const char* fname);
+
+		/** write the upper triangle of a symmetric kernel matrix to a file
+		 * that can be attached by set_triangle_kernel_matrix_from_file().
+		 * The kernel is evaluated tile by tile in parallel, the full matrix is
+		 * never held in memory.
+		 *
+		 * @param k initialized kernel with equal number of lhs and rhs vectors
+		 * @param fname name of the kernel matrix file
+		 * @param tile_size edge length of the square tiles
+		 * @param use_float16 store entries as 16bit floats
+		 * @return if writing was successful
+		 */
+		static bool save_triangle_kernel_matrix_to_file(CKernel* k,
+			const char* fname, int32_t tile_size=64, bool use_float16=false);
+
+		/** @return whether the kernel matrix is memory mapped from a file */
+		inline bool is_memory_mapped() const
+		{
+			return m_mapped_file!=NULL;
+		}
+
+		/** read ahead the tiles holding the given rows of a memory mapped
+		 * kernel matrix, see CKernel::prefetch_rows()
+		 *
+		 * This only schedules the reads with madvise(MADV_WILLNEED) and
+		 * returns, it does not wait for them. It does nothing on Windows.
+		 *
+		 * @param rows row indices
+		 * @param num_rows number of rows
+		 */
+		virtual void prefetch_rows(const int32_t* rows, int32_t num_rows);
+
 		/** returns kernel matrix as is (not possible with subset)
 		 *
 		 * @return kernel matrix
@@ -560,6 +607,9 @@ class CCustomKernel: public CKernel
 			return kmatrix;
 		}
 
+		/** map the file of a memory mapped kernel matrix again */
+		virtual void load_serializable_post() noexcept(false);
+
 	protected:
 
 		/** compute kernel function
@@ -572,12 +622,15 @@ class CCustomKernel: public CKernel
 		 */
 		virtual float64_t compute(int32_t row, int32_t col)
 		{
-			REQUIRE(kmatrix.matrix, "%s::compute(%d, %d): No kenrel matrix "
-					"set!\n", get_name(), row, col);
+			REQUIRE(kmatrix.matrix || m_mapped_file, "%s::compute(%d, %d): "
+					"No kenrel matrix set!\n", get_name(), row, col);
 
 			index_t real_row=m_row_subset_stack->subset_idx_conversion(row);
 			index_t real_col=m_col_subset_stack->subset_idx_conversion(col);
 
+			if (m_mapped_file)
+				return get_mapped_entry(real_row, real_col);
+
 			if (upper_diagonal)
 			{
 				if (real_row <= real_col)
@@ -595,6 +648,46 @@ class CCustomKernel: public CKernel
 				return kmatrix(real_row, real_col);
 		}
 
+		/** entry of the memory mapped kernel matrix
+		 *
+		 * @param row row index
+		 * @param col column index
+		 * @return kernel matrix entry
+		 */
+		inline float64_t get_mapped_entry(int64_t row, int64_t col) const
+		{
+			if (row>col)
+				CMath::swap(row, col);
+
+			const int64_t t=m_mapped_tile_size;
+			const int64_t idx=mapped_tile_offset(row/t, col/t)+(row%t)*t+col%t;
+
+			if (m_mapped_float16)
+				return half_to_float(((const uint16_t*) m_mapped_tiles)[idx]);
+
+			return ((const float32_t*) m_mapped_tiles)[idx];
+		}
+
+		/** offset (in elements) of tile (ti, tj), ti<=tj, in the mapped file */
+		inline int64_t mapped_tile_offset(int64_t ti, int64_t tj) const
+		{
+			const int64_t t=m_mapped_tile_size;
+			return (ti*m_mapped_num_tiles-ti*(ti-1)/2+tj-ti)*t*t;
+		}
+
+		/** map an upper triangle kernel matrix file, see
+		 * set_triangle_kernel_matrix_from_file()
+		 *
+		 * @param fname name of the kernel matrix file
+		 */
+		void map_triangle_kernel_matrix_file(const char* fname);
+
+		/** convert IEEE half precision float to float32 */
+		static float32_t half_to_float(uint16_t h);
+
+		/** convert float32 to IEEE half precision float (round to nearest) */
+		static uint16_t float_to_half(float32_t f);
+
 	protected:
 
 		/** kernel matrix */
@@ -614,6 +707,27 @@ class CCustomKernel: public CKernel
 
 		/** indicates whether kernel matrix is to be freed in destructor */
 		bool m_free_km;
+
+		/** memory mapped kernel matrix file */
+		CMemoryMappedFile<char>* m_mapped_file;
+
+		/** first tile in the memory mapped file */
+		const char* m_mapped_tiles;
+
+		/** number of rows (and columns) of the mapped kernel matrix */
+		int32_t m_mapped_num;
+
+		/** edge length of the tiles in the mapped file */
+		int32_t m_mapped_tile_size;
+
+		/** number of tiles per row in the mapped file */
+		int32_t m_mapped_num_tiles;
+
+		/** whether entries of the mapped file are 16bit floats */
+		bool m_mapped_float16;
+
+		/** name of the mapped file, null terminated */
+		SGVector<char> m_mapped_fname;
 };
 
 }
@@ -363,6 +363,23 @@ void CKernel::cache_multiple_kernel_rows(int32_t* rows, int32_t num_rows)
 
 	if (nthreads<2)
 	{
+		int32_t num_vec=get_num_vec_lhs();
+		int32_t* uncached_rows=SG_MALLOC(int32_t, num_rows);
+		int32_t num=0;
+		for (int32_t i=0; i<num_rows; i++)
+		{
+			int32_t idx=rows[i];
+			if (idx>=num_vec)
+				idx=2*num_vec-1-idx;
+
+			if (!kernel_cache_check(idx))
+				uncached_rows[num++]=idx;
+		}
+
+		// later rows are read ahead while the first ones are computed
+		prefetch_rows(uncached_rows, num);
+		SG_FREE(uncached_rows);
+
 		for(int32_t i=0;i<num_rows;i++)
 			cache_kernel_row(rows[i]);
 	}
@@ -403,6 +420,7 @@ void CKernel::cache_multiple_kernel_rows(int32_t* rows, int32_t num_rows)
 
 		if (num>0)
 		{
+			prefetch_rows(uncached_rows, num);
 			step = num/nthreads;
 
 			if (step<1)
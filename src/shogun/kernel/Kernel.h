@@ -112,7 +112,10 @@ enum EKernelType
 	K_GAUSSIANARD = 510,
 	K_GAUSSIANARDSPARSE = 511,
 	K_STREAMING = 520,
-	K_PERIODIC = 530
+	K_PERIODIC = 530,
+	K_EPANECHNIKOV = 540,
+	K_TOPHAT = 550,
+	K_TRIANGULAR = 560
 };
 
 /** kernel property */
@@ -282,6 +285,22 @@ class CKernel : public CSGObject
 			return row;
 		}
 
+		/** hint that the given rows will be requested soon, e.g. by the
+		 * kernel cache of a solver. Kernels backed by storage that is slow
+		 * to access may use this to read ahead, the default does nothing.
+		 *
+		 * The hint only helps if it is given before the rows are needed:
+		 * libsvm hints the next row of the gradient loops and the second row
+		 * of a working pair while computing the current one, svmlight hints
+		 * all rows of a cache fill before computing them.
+		 *
+		 * @param rows row indices
+		 * @param num_rows number of rows
+		 */
+		virtual void prefetch_rows(const int32_t* rows, int32_t num_rows)
+		{
+		}
+
 		/**
 		 * Computes sum from a symmetric part of the kernel matrix that always
 		 * is supposed to contain the main upper diagonal.
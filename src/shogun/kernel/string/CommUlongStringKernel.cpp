@@ -9,6 +9,7 @@
 #include <shogun/features/StringFeatures.h>
 #include <shogun/io/SGIO.h>
 #include <shogun/kernel/string/CommUlongStringKernel.h>
+#include <shogun/kernel/string/SpectrumGram.h>
 #include <shogun/lib/common.h>
 
 #include <shogun/kernel/normalizer/SqrtDiagKernelNormalizer.h>
@@ -158,6 +159,21 @@ float64_t CCommUlongStringKernel::compute(int32_t idx_a, int32_t idx_b)
 	return result;
 }
 
+SGMatrix<float64_t> CCommUlongStringKernel::compute_gram_matrix()
+{
+	REQUIRE(has_features(), "%s::compute_gram_matrix(): No features assigned!\n", get_name())
+
+	CSpectrumGram<uint64_t> engine((CStringFeatures<uint64_t>*) lhs,
+			(CStringFeatures<uint64_t>*) rhs, use_sign);
+
+	SGMatrix<float64_t> gram(num_lhs, num_rhs);
+	gram.zero();
+	engine.add_to(gram);
+	CSpectrumGram<uint64_t>::normalize(gram, normalizer);
+
+	return gram;
+}
+
 void CCommUlongStringKernel::add_to_normal(int32_t vec_idx, float64_t weight)
 {
 	int32_t t=0;
@@ -188,6 +188,15 @@ class CCommUlongStringKernel: public CStringKernel<uint64_t>
 			dict=dictionary.vector;
 			dweights = dictionary_weights.vector;
 		}
+
+		/** compute the kernel matrix from an inverted index of the k-mers
+		 * of all lhs strings instead of merging every pair of sorted
+		 * strings, see CSpectrumGram. The result equals get_kernel_matrix().
+		 *
+		 * @return kernel matrix
+		 */
+		SGMatrix<float64_t> compute_gram_matrix();
+
 	private:
 		void init_params();
 
@@ -12,6 +12,7 @@
 
 #include <shogun/features/StringFeatures.h>
 #include <shogun/kernel/string/CommWordStringKernel.h>
+#include <shogun/kernel/string/SpectrumGram.h>
 
 #include <shogun/kernel/normalizer/SqrtDiagKernelNormalizer.h>
 
@@ -223,6 +224,21 @@ float64_t CCommWordStringKernel::compute_helper(
 	return result;
 }
 
+SGMatrix<float64_t> CCommWordStringKernel::compute_gram_matrix()
+{
+	REQUIRE(has_features(), "%s::compute_gram_matrix(): No features assigned!\n", get_name())
+
+	CSpectrumGram<uint16_t> engine((CStringFeatures<uint16_t>*) lhs,
+			(CStringFeatures<uint16_t>*) rhs, use_sign);
+
+	SGMatrix<float64_t> gram(num_lhs, num_rhs);
+	gram.zero();
+	engine.add_to(gram);
+	CSpectrumGram<uint16_t>::normalize(gram, normalizer);
+
+	return gram;
+}
+
 void CCommWordStringKernel::add_to_normal(int32_t vec_idx, float64_t weight)
 {
 	int32_t len=-1;
@@ -199,6 +199,14 @@ class CCommWordStringKernel : public CStringKernel<uint16_t>
 			return use_dict_diagonal_optimization;
 		}
 
+		/** compute the kernel matrix from an inverted index of the k-mers
+		 * of all lhs strings instead of merging every pair of sorted
+		 * strings, see CSpectrumGram. The result equals get_kernel_matrix().
+		 *
+		 * @return kernel matrix
+		 */
+		virtual SGMatrix<float64_t> compute_gram_matrix();
+
 	protected:
 		/** compute kernel function for features a and b
 		 * idx_{a,b} denote the index of the feature vectors
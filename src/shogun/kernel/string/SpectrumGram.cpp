@@ -0,0 +1,201 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: agent
+ */
+
+#include <shogun/features/StringFeatures.h>
+#include <shogun/io/SGIO.h>
+#include <shogun/kernel/Kernel.h>
+#include <shogun/kernel/string/SpectrumGram.h>
+
+#include <algorithm>
+
+using namespace shogun;
+
+template <class ST>
+CSpectrumGram<ST>::CSpectrumGram(CStringFeatures<ST>* lhs,
+		CStringFeatures<ST>* rhs, bool use_sign, ST mask)
+{
+	REQUIRE(lhs && rhs, "Features of both sides are required!\n")
+
+	symmetric=(lhs==rhs);
+	num_lhs=lhs->get_num_vectors();
+	num_rhs=rhs->get_num_vectors();
+
+	std::vector<int64_t> lhs_offsets;
+	std::vector<ST> lhs_kmers;
+	std::vector<int32_t> lhs_counts;
+	compute_runs(lhs, use_sign, mask, lhs_offsets, lhs_kmers, lhs_counts);
+
+	vocabulary=lhs_kmers;
+	std::sort(vocabulary.begin(), vocabulary.end());
+	vocabulary.erase(std::unique(vocabulary.begin(), vocabulary.end()),
+			vocabulary.end());
+
+	// invert the lhs runs, filling the index in the order of the vectors
+	// keeps the entries of every k-mer sorted by vector
+	std::vector<int32_t> lhs_ids(lhs_kmers.size());
+	index_offsets.assign(vocabulary.size()+1, 0);
+	for (size_t r=0; r<lhs_kmers.size(); r++)
+	{
+		lhs_ids[r]=std::lower_bound(vocabulary.begin(), vocabulary.end(),
+				lhs_kmers[r])-vocabulary.begin();
+		index_offsets[lhs_ids[r]+1]++;
+	}
+	for (size_t v=0; v<vocabulary.size(); v++)
+		index_offsets[v+1]+=index_offsets[v];
+
+	index_vectors.resize(lhs_kmers.size());
+	index_counts.resize(lhs_kmers.size());
+	std::vector<int64_t> fill(index_offsets.begin(), index_offsets.end()-1);
+	for (int32_t i=0; i<num_lhs; i++)
+	{
+		for (int64_t r=lhs_offsets[i]; r<lhs_offsets[i+1]; r++)
+		{
+			int64_t pos=fill[lhs_ids[r]]++;
+			index_vectors[pos]=i;
+			index_counts[pos]=lhs_counts[r];
+		}
+	}
+
+	if (symmetric)
+	{
+		rhs_offsets.swap(lhs_offsets);
+		rhs_ids.swap(lhs_ids);
+		rhs_counts.swap(lhs_counts);
+	}
+	else
+	{
+		std::vector<ST> rhs_kmers;
+		compute_runs(rhs, use_sign, mask, rhs_offsets, rhs_kmers, rhs_counts);
+
+		rhs_ids.resize(rhs_kmers.size());
+		for (size_t r=0; r<rhs_kmers.size(); r++)
+		{
+			auto it=std::lower_bound(vocabulary.begin(), vocabulary.end(),
+					rhs_kmers[r]);
+			if (it!=vocabulary.end() && *it==rhs_kmers[r])
+				rhs_ids[r]=it-vocabulary.begin();
+			else
+				rhs_ids[r]=-1;
+		}
+	}
+
+	SG_SDEBUG("spectrum index of %d distinct k-mers in %d strings\n",
+			get_num_kmers(), num_lhs)
+}
+
+template <class ST>
+CSpectrumGram<ST>::~CSpectrumGram()
+{
+}
+
+template <class ST>
+void CSpectrumGram<ST>::compute_runs(CStringFeatures<ST>* features,
+		bool use_sign, ST mask, std::vector<int64_t>& offsets,
+		std::vector<ST>& kmers, std::vector<int32_t>& counts)
+{
+	const int32_t num=features->get_num_vectors();
+	offsets.assign(1, 0);
+	kmers.clear();
+	counts.clear();
+
+	std::vector<ST> sorted;
+	for (int32_t i=0; i<num; i++)
+	{
+		int32_t len=0;
+		bool free_vec;
+		ST* vec=features->get_feature_vector(i, len, free_vec);
+		sorted.resize(len);
+		for (int32_t k=0; k<len; k++)
+			sorted[k]=vec[k] & mask;
+		features->free_feature_vector(vec, i, free_vec);
+
+		// the strings are usually sorted already (see CSortWordString),
+		// masking only keeps a prefix of every k-mer
+		if (!std::is_sorted(sorted.begin(), sorted.end()))
+			std::sort(sorted.begin(), sorted.end());
+
+		for (int32_t k=0; k<len; k++)
+		{
+			if (k>0 && sorted[k]==sorted[k-1])
+			{
+				if (!use_sign)
+					counts.back()++;
+				continue;
+			}
+			kmers.push_back(sorted[k]);
+			counts.push_back(1);
+		}
+		offsets.push_back(kmers.size());
+	}
+}
+
+template <class ST>
+void CSpectrumGram<ST>::add_to(SGMatrix<float64_t> gram, float64_t weight) const
+{
+	REQUIRE(gram.num_rows==num_lhs && gram.num_cols==num_rhs,
+		"Kernel matrix has to be of size %dx%d (was %dx%d)!\n",
+		num_lhs, num_rhs, gram.num_rows, gram.num_cols)
+
+	const int32_t m=num_lhs;
+	const int32_t n=num_rhs;
+
+#pragma omp parallel
+	{
+		std::vector<float64_t> column(m, 0.0);
+
+		// every column is the sum over the k-mers of rhs vector j of the
+		// index entries of that k-mer, for a symmetric matrix only the part
+		// up to the diagonal is accumulated and mirrored
+#pragma omp for schedule(dynamic, 16)
+		for (int32_t j=0; j<n; j++)
+		{
+			const int32_t last=symmetric ? j : m-1;
+			for (int64_t r=rhs_offsets[j]; r<rhs_offsets[j+1]; r++)
+			{
+				const int32_t id=rhs_ids[r];
+				if (id<0)
+					continue;
+
+				const float64_t count=rhs_counts[r];
+				for (int64_t e=index_offsets[id]; e<index_offsets[id+1]; e++)
+				{
+					const int32_t i=index_vectors[e];
+					if (i>last)
+						break;
+					column[i]+=count*index_counts[e];
+				}
+			}
+
+			for (int32_t i=0; i<=last; i++)
+			{
+				const float64_t v=weight*column[i];
+				gram(i, j)+=v;
+				if (symmetric && i!=j)
+					gram(j, i)+=v;
+				column[i]=0;
+			}
+		}
+	}
+}
+
+template <class ST>
+void CSpectrumGram<ST>::normalize(SGMatrix<float64_t> gram,
+		CKernelNormalizer* normalizer)
+{
+	REQUIRE(normalizer, "No kernel normalizer provided!\n")
+
+	const int32_t m=gram.num_rows;
+	const int32_t n=gram.num_cols;
+#pragma omp parallel for schedule(dynamic, 16)
+	for (int32_t j=0; j<n; j++)
+	{
+		for (int32_t i=0; i<m; i++)
+			gram(i, j)=normalizer->normalize(gram(i, j), i, j);
+	}
+}
+
+template class shogun::CSpectrumGram<uint16_t>;
+template class shogun::CSpectrumGram<uint64_t>;
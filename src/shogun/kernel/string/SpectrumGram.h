@@ -0,0 +1,111 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: agent
+ */
+
+#ifndef _SPECTRUMGRAM_H___
+#define _SPECTRUMGRAM_H___
+
+#include <shogun/lib/config.h>
+
+#include <shogun/lib/common.h>
+#include <shogun/lib/SGMatrix.h>
+
+#include <vector>
+
+namespace shogun
+{
+template <class ST> class CStringFeatures;
+class CKernelNormalizer;
+
+/** @brief Gram matrix engine for spectrum string kernels, i.e. kernels that
+ * count the common k-mers of two strings such as CCommWordStringKernel,
+ * CWeightedCommWordStringKernel and CCommUlongStringKernel.
+ *
+ * Every string is first reduced to its (k-mer, count) runs. The runs of all
+ * left hand side strings are then inverted into an index that lists for
+ * every k-mer the strings that contain it, and the Gram matrix is the sparse
+ * product of the count matrices: every column of the Gram matrix is obtained
+ * by walking the index entries of the k-mers of one right hand side string.
+ * The work is proportional to the number of pairs of strings that actually
+ * share k-mers instead of all pairs of sorted arrays that have to be merged.
+ * Columns are computed in parallel.
+ */
+template <class ST> class CSpectrumGram
+{
+	public:
+		/** constructor, builds the runs and the index
+		 *
+		 * @param lhs features of the left hand side, k-mer strings
+		 * @param rhs features of the right hand side, k-mer strings
+		 * @param use_sign if every common k-mer counts once
+		 * @param mask bit mask that is applied to every k-mer
+		 */
+		CSpectrumGram(CStringFeatures<ST>* lhs, CStringFeatures<ST>* rhs,
+				bool use_sign=false, ST mask=ST(~ST(0)));
+
+		/** destructor */
+		~CSpectrumGram();
+
+		/** add the weighted, unnormalized spectrum kernel to a matrix
+		 *
+		 * @param gram matrix of size number of lhs times number of rhs
+		 *        vectors
+		 * @param weight weight of the counts
+		 */
+		void add_to(SGMatrix<float64_t> gram, float64_t weight=1.0) const;
+
+		/** apply a kernel normalizer to every entry of a kernel matrix
+		 *
+		 * @param gram kernel matrix
+		 * @param normalizer normalizer of the kernel
+		 */
+		static void normalize(SGMatrix<float64_t> gram,
+				CKernelNormalizer* normalizer);
+
+		/** @return number of distinct k-mers of the left hand side */
+		inline int32_t get_num_kmers() const
+		{
+			return vocabulary.size();
+		}
+
+		/** @return number of (k-mer, count) runs of the right hand side */
+		inline int64_t get_num_runs() const
+		{
+			return rhs_ids.size();
+		}
+
+	private:
+		/** computes the (k-mer, count) runs of all strings, the runs of
+		 * string i are [offsets[i], offsets[i+1]) */
+		static void compute_runs(CStringFeatures<ST>* features,
+				bool use_sign, ST mask, std::vector<int64_t>& offsets,
+				std::vector<ST>& kmers, std::vector<int32_t>& counts);
+
+	private:
+		/** if lhs and rhs are the same */
+		bool symmetric;
+		/** number of lhs vectors */
+		int32_t num_lhs;
+		/** number of rhs vectors */
+		int32_t num_rhs;
+
+		/** sorted distinct k-mers of the lhs */
+		std::vector<ST> vocabulary;
+		/** index entries of k-mer v are [index_offsets[v], index_offsets[v+1]) */
+		std::vector<int64_t> index_offsets;
+		/** lhs vector of every index entry, ascending per k-mer */
+		std::vector<int32_t> index_vectors;
+		/** count of the k-mer in the lhs vector of every index entry */
+		std::vector<int32_t> index_counts;
+
+		/** runs of rhs vector j are [rhs_offsets[j], rhs_offsets[j+1]) */
+		std::vector<int64_t> rhs_offsets;
+		/** vocabulary id of every rhs run, -1 if not in the lhs */
+		std::vector<int32_t> rhs_ids;
+		/** count of every rhs run */
+		std::vector<int32_t> rhs_counts;
+};
+}
+#endif // _SPECTRUMGRAM_H___
@@ -6,6 +6,7 @@
 
 #include <shogun/lib/common.h>
 #include <shogun/kernel/string/WeightedCommWordStringKernel.h>
+#include <shogun/kernel/string/SpectrumGram.h>
 #include <shogun/features/StringFeatures.h>
 #include <shogun/io/SGIO.h>
 
@@ -174,6 +175,31 @@ float64_t CWeightedCommWordStringKernel::compute_helper(
 	return result;
 }
 
+SGMatrix<float64_t> CWeightedCommWordStringKernel::compute_gram_matrix()
+{
+	REQUIRE(has_features(), "%s::compute_gram_matrix(): No features assigned!\n", get_name())
+
+	CStringFeatures<uint16_t>* l = (CStringFeatures<uint16_t>*) lhs;
+	CStringFeatures<uint16_t>* r = (CStringFeatures<uint16_t>*) rhs;
+
+	SGMatrix<float64_t> gram(num_lhs, num_rhs);
+	gram.zero();
+
+	// one index per degree, the masks keep prefixes of the k-mers
+	uint8_t mask=0;
+	for (int32_t d=0; d<degree; d++)
+	{
+		mask = mask | (1 << (degree-d-1));
+		uint16_t masked=l->get_masked_symbols(0xffff, mask);
+
+		CSpectrumGram<uint16_t> engine(l, r, false, masked);
+		engine.add_to(gram, weights[d]*weights[d]);
+	}
+	CSpectrumGram<uint16_t>::normalize(gram, normalizer);
+
+	return gram;
+}
+
 void CWeightedCommWordStringKernel::add_to_normal(
 	int32_t vec_idx, float64_t weight)
 {
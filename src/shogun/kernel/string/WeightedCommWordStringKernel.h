@@ -146,6 +146,14 @@ class CWeightedCommWordStringKernel: public CCommWordStringKernel
 			float64_t* target, int32_t num_suppvec, int32_t* IDX,
 			float64_t* alphas, bool do_init=true);
 
+		/** compute the kernel matrix from an inverted index of the masked
+		 * k-mers of every degree, see CSpectrumGram. The result equals
+		 * get_kernel_matrix().
+		 *
+		 * @return kernel matrix
+		 */
+		virtual SGMatrix<float64_t> compute_gram_matrix();
+
 	protected:
 		/** helper for compute
 		 *
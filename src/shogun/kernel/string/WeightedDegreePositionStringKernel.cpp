@@ -19,34 +19,10 @@
 
 #include <shogun/classifier/svm/SVM.h>
 
-#ifdef HAVE_PTHREAD
-#include <pthread.h>
-
-#endif
-
 using namespace shogun;
 
 #define TRIES(X) ((use_poim_tries) ? (poim_tries.X) : (tries.X))
 
-#ifndef DOXYGEN_SHOULD_SKIP_THIS
-template <class Trie> struct S_THREAD_PARAM_WDS
-{
-	int32_t* vec;
-	float64_t* result;
-	float64_t* weights;
-	CWeightedDegreePositionStringKernel* kernel;
-	CTrie<Trie>* tries;
-	float64_t factor;
-	int32_t j;
-	int32_t start;
-	int32_t end;
-	int32_t length;
-	int32_t max_shift;
-	int32_t* shift;
-	int32_t* vec_idx;
-};
-#endif // DOXYGEN_SHOULD_SKIP_THIS
-
 CWeightedDegreePositionStringKernel::CWeightedDegreePositionStringKernel(
 	void)
 : CStringKernel<char>()
@@ -1163,64 +1139,6 @@ bool CWeightedDegreePositionStringKernel::init_block_weights()
 
 
 
-void* CWeightedDegreePositionStringKernel::compute_batch_helper(void* p)
-{
-	S_THREAD_PARAM_WDS<DNATrie>* params = (S_THREAD_PARAM_WDS<DNATrie>*) p;
-	int32_t j=params->j;
-	CWeightedDegreePositionStringKernel* wd=params->kernel;
-	CTrie<DNATrie>* tries=params->tries;
-	float64_t* weights=params->weights;
-	int32_t length=params->length;
-	int32_t max_shift=params->max_shift;
-	int32_t* vec=params->vec;
-	float64_t* result=params->result;
-	float64_t factor=params->factor;
-	int32_t* shift=params->shift;
-	int32_t* vec_idx=params->vec_idx;
-
-	for (int32_t i=params->start; i<params->end; i++)
-	{
-		int32_t len=0;
-		CStringFeatures<char>* rhs_feat=((CStringFeatures<char>*) wd->get_rhs());
-		CAlphabet* alpha=wd->alphabet;
-
-		bool free_vec;
-		char* char_vec=rhs_feat->get_feature_vector(vec_idx[i], len, free_vec);
-		for (int32_t k=CMath::max(0,j-max_shift); k<CMath::min(len,j+wd->get_degree()+max_shift); k++)
-			vec[k]=alpha->remap_to_bin(char_vec[k]);
-		rhs_feat->free_feature_vector(char_vec, vec_idx[i], free_vec);
-
-		SG_UNREF(rhs_feat);
-
-		result[i] += factor*wd->normalizer->normalize_rhs(tries->compute_by_tree_helper(vec, len, j, j, j, weights, (length!=0)), vec_idx[i]);
-
-		if (wd->get_optimization_type()==SLOWBUTMEMEFFICIENT)
-		{
-			for (int32_t q=CMath::max(0,j-max_shift); q<CMath::min(len,j+max_shift+1); q++)
-			{
-				int32_t s=j-q ;
-				if ((s>=1) && (s<=shift[q]) && (q+s<len))
-				{
-					result[i] +=
-						wd->normalizer->normalize_rhs(tries->compute_by_tree_helper(vec,
-								len, q, q+s, q, weights, (length!=0)),
-								vec_idx[i])/(2.0*s);
-				}
-			}
-
-			for (int32_t s=1; (s<=shift[j]) && (j+s<len); s++)
-			{
-				result[i] +=
-					wd->normalizer->normalize_rhs(tries->compute_by_tree_helper(vec,
-								len, j+s, j, j+s, weights, (length!=0)),
-								vec_idx[i])/(2.0*s);
-			}
-		}
-	}
-
-	return NULL;
-}
-
 void CWeightedDegreePositionStringKernel::compute_batch(
 	int32_t num_vec, int32_t* vec_idx, float64_t* result, int32_t num_suppvec,
 	int32_t* IDX, float64_t* alphas, float64_t factor)
@@ -1236,97 +1154,95 @@ void CWeightedDegreePositionStringKernel::compute_batch(
 	ASSERT(result)
 	create_empty_tries();
 
-	int32_t num_feat=((CStringFeatures<char>*) rhs)->get_max_vector_length();
+	CStringFeatures<char>* rhs_feat=(CStringFeatures<char>*) rhs;
+	int32_t num_feat=rhs_feat->get_max_vector_length();
 	ASSERT(num_feat>0)
-	// TODO: port to use OpenMP backend instead of pthread
-#ifdef HAVE_PTHREAD
-	int32_t num_threads=parallel->get_num_threads();
-#else
-	int32_t num_threads=1;
-#endif
-	ASSERT(num_threads>0)
-	int32_t* vec=SG_MALLOC(int32_t, num_threads*num_feat);
-
-	if (num_threads < 2)
-	{
-		// TODO: replace with the new signal
-		// for (int32_t j=0; j<num_feat && !CSignal::cancel_computations(); j++)
-		for (auto j : SG_PROGRESS(range(num_feat)))
-		{
-			init_optimization(num_suppvec, IDX, alphas, j);
-			S_THREAD_PARAM_WDS<DNATrie> params;
-			params.vec = vec;
-			params.result = result;
-			params.weights = weights;
-			params.kernel = this;
-			params.tries = &tries;
-			params.factor = factor;
-			params.j = j;
-			params.start = 0;
-			params.end = num_vec;
-			params.length = length;
-			params.max_shift = max_shift;
-			params.shift = shift;
-			params.vec_idx = vec_idx;
-			compute_batch_helper((void*)&params);
-		    }
-	}
-#ifdef HAVE_PTHREAD
-	else
+
+	// sequences are scored in chunks, every chunk is one task for the threads
+	const int32_t chunk_size=64;
+	const int32_t num_chunks=(num_vec+chunk_size-1)/chunk_size;
+	CFlatTrie flat;
+	auto pb = SG_PROGRESS(range(num_feat));
+
+	// the threads are started once, every thread keeps its buffers for all
+	// positions
+#pragma omp parallel
 	{
+		SGVector<int32_t> vec(chunk_size*num_feat);
+		const int32_t* vecs[chunk_size];
+		int32_t lens[chunk_size];
+		float64_t scores[chunk_size];
+
 		// TODO: replace with the new signal
 		// for (int32_t j=0; j<num_feat && !CSignal::cancel_computations(); j++)
-		for (auto j : SG_PROGRESS(range(num_feat)))
+		for (int32_t j = 0; j < num_feat; j++)
 		{
-			init_optimization(num_suppvec, IDX, alphas, j);
-			pthread_t* threads = SG_MALLOC(pthread_t, num_threads-1);
-			S_THREAD_PARAM_WDS<DNATrie>* params = SG_MALLOC(S_THREAD_PARAM_WDS<DNATrie>, num_threads);
-			int32_t step= num_vec/num_threads;
-			int32_t t;
+#pragma omp single
+			{
+				init_optimization(num_suppvec, IDX, alphas, j);
+				tries.flatten(j, flat);
+			}
 
-			for (t=0; t<num_threads-1; t++)
+#pragma omp for schedule(dynamic)
+			for (int32_t c=0; c<num_chunks; c++)
 			{
-				params[t].vec=&vec[num_feat*t];
-				params[t].result=result;
-				params[t].weights=weights;
-				params[t].kernel=this;
-				params[t].tries=&tries;
-				params[t].factor=factor;
-				params[t].j=j;
-				params[t].start = t*step;
-				params[t].end = (t+1)*step;
-				params[t].length=length;
-				params[t].max_shift=max_shift;
-				params[t].shift=shift;
-				params[t].vec_idx=vec_idx;
-				pthread_create(&threads[t], NULL, CWeightedDegreePositionStringKernel::compute_batch_helper, (void*)&params[t]);
+				int32_t start=c*chunk_size;
+				int32_t num=CMath::min(chunk_size, num_vec-start);
+				int32_t max_len=0;
+
+				for (int32_t i=0; i<num; i++)
+				{
+					int32_t* v=&vec[i*num_feat];
+					int32_t len=0;
+					bool free_vec;
+					char* char_vec=rhs_feat->get_feature_vector(vec_idx[start+i], len, free_vec);
+					for (int32_t k=CMath::max(0,j-max_shift); k<CMath::min(len,j+degree+max_shift); k++)
+						v[k]=alphabet->remap_to_bin(char_vec[k]);
+					rhs_feat->free_feature_vector(char_vec, vec_idx[start+i], free_vec);
+
+					vecs[i]=v;
+					lens[i]=len;
+					max_len=CMath::max(max_len, len);
+				}
+
+				flat.compute_by_tree_batch(vecs, lens, num, j, j, weights, (length!=0), scores);
+				for (int32_t i=0; i<num; i++)
+					result[start+i]+=factor*normalizer->normalize_rhs(scores[i], vec_idx[start+i]);
+
+				if (opt_type!=SLOWBUTMEMEFFICIENT)
+					continue;
+
+				// the tree of position j also scores the shifted matches
+				for (int32_t q=CMath::max(0,j-max_shift); q<CMath::min(max_len,j+max_shift+1); q++)
+				{
+					int32_t s=j-q;
+					if ((s<1) || (s>shift[q]))
+						continue;
+
+					flat.compute_by_tree_batch(vecs, lens, num, q, q, weights, (length!=0), scores);
+					for (int32_t i=0; i<num; i++)
+					{
+						if ((q<lens[i]) && (q+s<lens[i]))
+							result[start+i]+=normalizer->normalize_rhs(scores[i], vec_idx[start+i])/(2.0*s);
+					}
+				}
+
+				for (int32_t s=1; (s<=shift[j]) && (j+s<max_len); s++)
+				{
+					flat.compute_by_tree_batch(vecs, lens, num, j+s, j+s, weights, (length!=0), scores);
+					for (int32_t i=0; i<num; i++)
+					{
+						if (j+s<lens[i])
+							result[start+i]+=normalizer->normalize_rhs(scores[i], vec_idx[start+i])/(2.0*s);
+					}
+				}
 			}
 
-			params[t].vec=&vec[num_feat*t];
-			params[t].result=result;
-			params[t].weights=weights;
-			params[t].kernel=this;
-			params[t].tries=&tries;
-			params[t].factor=factor;
-			params[t].j=j;
-			params[t].start=t*step;
-			params[t].end=num_vec;
-			params[t].length=length;
-			params[t].max_shift=max_shift;
-			params[t].shift=shift;
-			params[t].vec_idx=vec_idx;
-			compute_batch_helper((void*) &params[t]);
-
-			for (t=0; t<num_threads-1; t++)
-				pthread_join(threads[t], NULL);
-
-			SG_FREE(params);
-			SG_FREE(threads);
+#pragma omp master
+			pb.print_progress();
 		}
 	}
-#endif
-
-	SG_FREE(vec);
+	pb.complete();
 
 	//really also free memory as this can be huge on testing especially when
 	//using the combined kernel
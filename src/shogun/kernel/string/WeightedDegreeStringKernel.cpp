@@ -18,31 +18,8 @@
 #include <shogun/features/Features.h>
 #include <shogun/features/StringFeatures.h>
 
-#ifdef HAVE_PTHREAD
-#include <pthread.h>
-
-#endif
-
 using namespace shogun;
 
-#ifndef DOXYGEN_SHOULD_SKIP_THIS
-struct S_THREAD_PARAM_WD
-{
-
-	int32_t* vec;
-	float64_t* result;
-	float64_t* weights;
-	CWeightedDegreeStringKernel* kernel;
-	CTrie<DNATrie>* tries;
-	float64_t factor;
-	int32_t j;
-	int32_t start;
-	int32_t end;
-	int32_t length;
-	int32_t* vec_idx;
-};
-#endif // DOXYGEN_SHOULD_SKIP_THIS
-
 CWeightedDegreeStringKernel::CWeightedDegreeStringKernel ()
 : CStringKernel<char>()
 {
@@ -817,42 +794,6 @@ bool CWeightedDegreeStringKernel::init_block_weights()
 }
 
 
-void* CWeightedDegreeStringKernel::compute_batch_helper(void* p)
-{
-	S_THREAD_PARAM_WD* params = (S_THREAD_PARAM_WD*) p;
-	int32_t j=params->j;
-	CWeightedDegreeStringKernel* wd=params->kernel;
-	CTrie<DNATrie>* tries=params->tries;
-	float64_t* weights=params->weights;
-	int32_t length=params->length;
-	int32_t* vec=params->vec;
-	float64_t* result=params->result;
-	float64_t factor=params->factor;
-	int32_t* vec_idx=params->vec_idx;
-
-	CStringFeatures<char>* rhs_feat=((CStringFeatures<char>*) wd->get_rhs());
-	CAlphabet* alpha=wd->alphabet;
-
-	for (int32_t i=params->start; i<params->end; i++)
-	{
-		int32_t len=0;
-		bool free_vec;
-		char* char_vec=rhs_feat->get_feature_vector(vec_idx[i], len, free_vec);
-		for (int32_t k=j; k<CMath::min(len,j+wd->get_degree()); k++)
-			vec[k]=alpha->remap_to_bin(char_vec[k]);
-		rhs_feat->free_feature_vector(char_vec, vec_idx[i], free_vec);
-
-		ASSERT(tries)
-
-		result[i]+=factor*
-			wd->normalizer->normalize_rhs(tries->compute_by_tree_helper(vec, len, j, j, j, weights, (length!=0)), vec_idx[i]);
-	}
-
-	SG_UNREF(rhs_feat);
-
-	return NULL;
-}
-
 void CWeightedDegreeStringKernel::compute_batch(
 	int32_t num_vec, int32_t* vec_idx, float64_t* result, int32_t num_suppvec,
 	int32_t* IDX, float64_t* alphas, float64_t factor)
@@ -867,96 +808,66 @@ void CWeightedDegreeStringKernel::compute_batch(
 	ASSERT(result)
 	create_empty_tries();
 
-	int32_t num_feat=((CStringFeatures<char>*) rhs)->get_max_vector_length();
+	CStringFeatures<char>* rhs_feat=(CStringFeatures<char>*) rhs;
+	int32_t num_feat=rhs_feat->get_max_vector_length();
 	ASSERT(num_feat>0)
-	// TODO: port to use OpenMP backend instead of pthread
-#ifdef HAVE_PTHREAD
-	int32_t num_threads=parallel->get_num_threads();
-#else
-	int32_t num_threads=1;
-#endif
-	ASSERT(num_threads>0)
-	int32_t* vec=SG_MALLOC(int32_t, num_threads*num_feat);
+
+	// sequences are scored in chunks, every chunk is one task for the threads
+	const int32_t chunk_size=64;
+	const int32_t num_chunks=(num_vec+chunk_size-1)/chunk_size;
+	CFlatTrie flat;
 	auto pb = SG_PROGRESS(range(num_feat));
 
-	if (num_threads < 2)
+	// the threads are started once, every thread keeps its buffers for all
+	// positions
+#pragma omp parallel
 	{
-		// TODO: replace with the new signal
-		// for (int32_t j=0; j<num_feat && !CSignal::cancel_computations(); j++)
-		for (int32_t j = 0; j < num_feat; j++)
-		{
-			init_optimization(num_suppvec, IDX, alphas, j);
-			S_THREAD_PARAM_WD params;
-			params.vec=vec;
-			params.result=result;
-			params.weights=weights;
-			params.kernel=this;
-			params.tries=tries;
-			params.factor=factor;
-			params.j=j;
-			params.start=0;
-			params.end=num_vec;
-			params.length=length;
-			params.vec_idx=vec_idx;
-			compute_batch_helper((void*) &params);
+		SGVector<int32_t> vec(chunk_size*num_feat);
+		const int32_t* vecs[chunk_size];
+		int32_t lens[chunk_size];
+		float64_t scores[chunk_size];
 
-			pb.print_progress();
-		}
-		pb.complete();
-	}
-#ifdef HAVE_PTHREAD
-	else
-	{
 		// TODO: replace with the new signal
 		// for (int32_t j=0; j<num_feat && !CSignal::cancel_computations(); j++)
 		for (int32_t j = 0; j < num_feat; j++)
 		{
-			init_optimization(num_suppvec, IDX, alphas, j);
-			pthread_t* threads = SG_MALLOC(pthread_t, num_threads-1);
-			S_THREAD_PARAM_WD* params = SG_MALLOC(S_THREAD_PARAM_WD, num_threads);
-			int32_t step= num_vec/num_threads;
-			int32_t t;
+#pragma omp single
+			{
+				init_optimization(num_suppvec, IDX, alphas, j);
+				tries->flatten(j, flat);
+			}
 
-			for (t=0; t<num_threads-1; t++)
+#pragma omp for schedule(dynamic)
+			for (int32_t c=0; c<num_chunks; c++)
 			{
-				params[t].vec=&vec[num_feat*t];
-				params[t].result=result;
-				params[t].weights=weights;
-				params[t].kernel=this;
-				params[t].tries=tries;
-				params[t].factor=factor;
-				params[t].j=j;
-				params[t].start = t*step;
-				params[t].end = (t+1)*step;
-				params[t].length=length;
-				params[t].vec_idx=vec_idx;
-				pthread_create(&threads[t], NULL, CWeightedDegreeStringKernel::compute_batch_helper, (void*)&params[t]);
+				int32_t start=c*chunk_size;
+				int32_t num=CMath::min(chunk_size, num_vec-start);
+
+				for (int32_t i=0; i<num; i++)
+				{
+					int32_t* v=&vec[i*num_feat];
+					int32_t len=0;
+					bool free_vec;
+					char* char_vec=rhs_feat->get_feature_vector(vec_idx[start+i], len, free_vec);
+					for (int32_t k=j; k<CMath::min(len,j+degree); k++)
+						v[k]=alphabet->remap_to_bin(char_vec[k]);
+					rhs_feat->free_feature_vector(char_vec, vec_idx[start+i], free_vec);
+
+					vecs[i]=v;
+					lens[i]=len;
+				}
+
+				flat.compute_by_tree_batch(vecs, lens, num, j, j, weights, (length!=0), scores);
+
+				for (int32_t i=0; i<num; i++)
+					result[start+i]+=factor*normalizer->normalize_rhs(scores[i], vec_idx[start+i]);
 			}
-			params[t].vec=&vec[num_feat*t];
-			params[t].result=result;
-			params[t].weights=weights;
-			params[t].kernel=this;
-			params[t].tries=tries;
-			params[t].factor=factor;
-			params[t].j=j;
-			params[t].start=t*step;
-			params[t].end=num_vec;
-			params[t].length=length;
-			params[t].vec_idx=vec_idx;
-			compute_batch_helper((void*) &params[t]);
-
-			for (t=0; t<num_threads-1; t++)
-				pthread_join(threads[t], NULL);
-			pb.print_progress();
 
-			SG_FREE(params);
-			SG_FREE(threads);
+#pragma omp master
+			pb.print_progress();
 		}
-		pb.complete();
 	}
-#endif
-
-	SG_FREE(vec);
+	pb.complete();
 
 	//really also free memory as this can be huge on testing especially when
 	//using the combined kernel
@@ -164,13 +164,10 @@ class CWeightedDegreeStringKernel: public CStringKernel<char>
 			return 0;
 		}
 
-		/** helper for compute batch
-		 *
-		 * @param p thread parameter
-		 */
-		static void* compute_batch_helper(void* p);
-
 		/** compute batch
+		 *
+		 * Builds the tree of one position at a time, copies it into a
+		 * CFlatTrie and scores chunks of the vectors in parallel.
 		 *
 		 * @param num_vec number of vectors
 		 * @param vec_idx vector index
@@ -0,0 +1,105 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: agent
+ */
+
+#include <shogun/lib/FlatTrie.h>
+#include <shogun/mathematics/Math.h>
+
+using namespace shogun;
+
+CFlatTrie::CFlatTrie() : degree(0), position_weights(NULL)
+{
+}
+
+CFlatTrie::~CFlatTrie()
+{
+}
+
+void CFlatTrie::clear(int32_t d, const float64_t* p_position_weights)
+{
+	degree=d;
+	position_weights=p_position_weights;
+	nodes.clear();
+}
+
+int32_t CFlatTrie::add_node(float64_t fixed, float64_t scaled)
+{
+	FlatTrieNode node;
+	for (int32_t q=0; q<4; q++)
+		node.children[q]=-1;
+	node.fixed=fixed;
+	node.scaled=scaled;
+	nodes.push_back(node);
+	return nodes.size()-1;
+}
+
+void CFlatTrie::compute_by_tree_batch(
+	const int32_t* const* vecs, const int32_t* lens, int32_t num,
+	int32_t seq_pos, int32_t weight_pos, const float64_t* weights,
+	bool degree_times_position_weights, float64_t* result) const
+{
+	float64_t factor=1.0;
+	if (position_weights!=NULL)
+		factor=position_weights[weight_pos];
+
+	if (factor==0 || nodes.empty())
+	{
+		for (int32_t i=0; i<num; i++)
+			result[i]=0;
+		return;
+	}
+
+	const float64_t* weights_column=weights;
+	if (degree_times_position_weights)
+		weights_column=&weights[weight_pos*degree];
+
+	const FlatTrieNode* tree=nodes.data();
+	int32_t node[BATCH_SIZE];
+	float64_t sum[BATCH_SIZE];
+
+	for (int32_t start=0; start<num; start+=BATCH_SIZE)
+	{
+		const int32_t size=CMath::min(BATCH_SIZE, num-start);
+		const int32_t* const* batch=&vecs[start];
+
+		for (int32_t b=0; b<size; b++)
+		{
+			node[b]=0;
+			sum[b]=0;
+		}
+
+		// all walks descend one level at a time, walks that ran out of
+		// children or symbols park at -1
+		for (int32_t j=0; j<degree; j++)
+		{
+			bool active=false;
+			for (int32_t b=0; b<size; b++)
+			{
+				if (node[b]<0)
+					continue;
+
+				if (seq_pos+j>=lens[start+b])
+				{
+					node[b]=-1;
+					continue;
+				}
+
+				const int32_t child=tree[node[b]].children[batch[b][seq_pos+j]];
+				node[b]=child;
+				if (child>=0)
+				{
+					sum[b]+=tree[child].fixed+tree[child].scaled*weights_column[j];
+					active=true;
+				}
+			}
+
+			if (!active)
+				break;
+		}
+
+		for (int32_t b=0; b<size; b++)
+			result[start+b]=sum[b]*factor;
+	}
+}
@@ -0,0 +1,121 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: agent
+ */
+
+#ifndef _FLAT_TRIE_H___
+#define _FLAT_TRIE_H___
+
+#include <shogun/lib/config.h>
+#include <shogun/lib/common.h>
+
+#include <vector>
+
+namespace shogun
+{
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+/** node of a flattened trie */
+struct FlatTrieNode
+{
+	/** children, negative if there is none */
+	int32_t children[4];
+	/** weight that is added as it is */
+	float64_t fixed;
+	/** weight that is multiplied with the weight of its level */
+	float64_t scaled;
+};
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
+/** @brief Read-only copy of a single tree of a CTrie in one contiguous array
+ * of nodes in level order.
+ *
+ * The nodes that are visited at the same depth lie next to each other, and
+ * the compact terminal nodes of the trie are expanded into chains of regular
+ * nodes, so that a lookup is a single loop over the levels without any
+ * special cases. Lookups for many sequences are done in interleaved batches,
+ * i.e. all walks advance one level at a time, which lets the memory accesses
+ * of the independent walks overlap instead of chasing one pointer after the
+ * other.
+ *
+ * It is filled by CTrie::flatten() and used by the batch computation of
+ * CWeightedDegreeStringKernel and CWeightedDegreePositionStringKernel.
+ */
+class CFlatTrie
+{
+	public:
+		/** default constructor */
+		CFlatTrie();
+
+		/** destructor */
+		~CFlatTrie();
+
+		/** remove all nodes, but keep the memory
+		 *
+		 * @param degree degree of the trie
+		 * @param position_weights position weights or NULL
+		 */
+		void clear(int32_t degree, const float64_t* position_weights=NULL);
+
+		/** add node without children
+		 *
+		 * @param fixed weight that is added as it is
+		 * @param scaled weight that is multiplied with the weight of its level
+		 * @return index of the node
+		 */
+		int32_t add_node(float64_t fixed=0.0, float64_t scaled=0.0);
+
+		/** set child of a node
+		 *
+		 * @param node parent node
+		 * @param sym symbol
+		 * @param child child node
+		 */
+		inline void set_child(int32_t node, int32_t sym, int32_t child)
+		{
+			nodes[node].children[sym]=child;
+		}
+
+		/** @return number of nodes */
+		inline int32_t get_num_nodes() const
+		{
+			return nodes.size();
+		}
+
+		/** @return degree */
+		inline int32_t get_degree() const
+		{
+			return degree;
+		}
+
+		/** compute the tree contributions of a batch of sequences, the
+		 * equivalent of CTrie::compute_by_tree_helper() for every sequence
+		 *
+		 * @param vecs sequences remapped to symbols 0..3
+		 * @param lens lengths of the sequences
+		 * @param num number of sequences
+		 * @param seq_pos sequence position
+		 * @param weight_pos weight position
+		 * @param weights weights
+		 * @param degree_times_position_weights if degree times position
+		 *                                      weights shall be applied
+		 * @param result computed values, one per sequence
+		 */
+		void compute_by_tree_batch(
+			const int32_t* const* vecs, const int32_t* lens, int32_t num,
+			int32_t seq_pos, int32_t weight_pos, const float64_t* weights,
+			bool degree_times_position_weights, float64_t* result) const;
+
+	private:
+		/** number of sequences that are walked interleaved */
+		static const int32_t BATCH_SIZE=16;
+
+		/** degree */
+		int32_t degree;
+		/** position weights */
+		const float64_t* position_weights;
+		/** nodes in level order, the root is the first */
+		std::vector<FlatTrieNode> nodes;
+};
+}
+#endif // _FLAT_TRIE_H___
@@ -6,7 +6,14 @@
 
 #include <benchmark/benchmark.h>
 
+#include "shogun/features/DenseFeatures.h"
+#include "shogun/features/SparseFeatures.h"
+#include "shogun/kernel/LinearKernel.h"
 #include "shogun/lib/RefCount.h"
+#include "shogun/lib/SGVector.h"
+#include "shogun/lib/SGVectorView.h"
+#include "shogun/mathematics/Math.h"
+#include "shogun/mathematics/linalg/LinalgNamespace.h"
 
 namespace shogun
 {
@@ -20,4 +27,178 @@ static void BM_RefCount(benchmark::State& state)
 
 BENCHMARK(BM_RefCount);
 
+/* what passing a vector by value costs: one atomic increment and one
+ * decrement per copy */
+static void BM_SGVector_copy(benchmark::State& state)
+{
+	SGVector<float64_t> vec(16);
+	for (auto _ : state)
+	{
+		SGVector<float64_t> copy(vec);
+		benchmark::DoNotOptimize(copy.vector);
+	}
+}
+
+static void BM_SGVectorView_copy(benchmark::State& state)
+{
+	SGVector<float64_t> vec(16);
+	SGVectorView<float64_t> view(vec);
+	for (auto _ : state)
+	{
+		SGVectorView<float64_t> copy(view);
+		benchmark::DoNotOptimize(copy.data());
+	}
+}
+
+BENCHMARK(BM_SGVector_copy);
+BENCHMARK(BM_SGVectorView_copy);
+
+static SGMatrix<float64_t> createRandomData(index_t num_dim, index_t num_vecs)
+{
+	SGMatrix<float64_t> mat(num_dim, num_vecs);
+	for (index_t i=0; i<num_vecs; i++)
+	{
+		for (index_t j=0; j<num_dim; j++)
+		{
+			/* about a third of the entries are zero */
+			float64_t v = CMath::random(0.0, 1.5);
+			mat(j,i) = v < 0.5 ? 0 : v;
+		}
+	}
+	return mat;
+}
+
+class RefCountFeaturesFixture : public benchmark::Fixture
+{
+public:
+	void SetUp(const ::benchmark::State& st)
+	{
+		SGMatrix<float64_t> mat = createRandomData(st.range(0), 1000);
+		dense = new CDenseFeatures<float64_t>(mat);
+		sparse = new CSparseFeatures<float64_t>(mat);
+		SG_REF(dense);
+		SG_REF(sparse);
+		w = SGVector<float64_t>(st.range(0));
+		w.range_fill(1.0);
+	}
+
+	void TearDown(const ::benchmark::State&)
+	{
+		SG_UNREF(dense);
+		SG_UNREF(sparse);
+	}
+
+	CDenseFeatures<float64_t>* dense;
+	CSparseFeatures<float64_t>* sparse;
+	SGVector<float64_t> w;
+};
+
+/* feature loops through the reference counted accessors ... */
+BENCHMARK_DEFINE_F(RefCountFeaturesFixture, DenseFeatures_SGVectorLoop)(benchmark::State& state)
+{
+	for (auto _ : state)
+	{
+		float64_t sum = 0;
+		for (index_t i = 0; i < dense->get_num_vectors(); ++i)
+		{
+			SGVector<float64_t> vec = dense->get_feature_vector(i);
+			sum += linalg::dot(vec, w);
+		}
+		benchmark::DoNotOptimize(sum);
+	}
+}
+
+BENCHMARK_DEFINE_F(RefCountFeaturesFixture, SparseFeatures_SGSparseVectorLoop)(benchmark::State& state)
+{
+	for (auto _ : state)
+	{
+		float64_t sum = 0;
+		for (index_t i = 0; i < sparse->get_num_vectors(); ++i)
+		{
+			SGSparseVector<float64_t> vec = sparse->get_sparse_feature_vector(i);
+			for (index_t j = 0; j < vec.num_feat_entries; ++j)
+				sum += vec.features[j].entry * w[vec.features[j].feat_index];
+		}
+		benchmark::DoNotOptimize(sum);
+	}
+}
+
+/* ... and through views */
+BENCHMARK_DEFINE_F(RefCountFeaturesFixture, DenseFeatures_ViewLoop)(benchmark::State& state)
+{
+	SGVectorView<const float64_t> w_view(w);
+	for (auto _ : state)
+	{
+		float64_t sum = 0;
+		for (index_t i = 0; i < dense->get_num_vectors(); ++i)
+			sum += linalg::dot(dense->get_feature_vector_view(i), w_view);
+		benchmark::DoNotOptimize(sum);
+	}
+}
+
+BENCHMARK_DEFINE_F(RefCountFeaturesFixture, SparseFeatures_ViewLoop)(benchmark::State& state)
+{
+	for (auto _ : state)
+	{
+		float64_t sum = 0;
+		for (index_t i = 0; i < sparse->get_num_vectors(); ++i)
+		{
+			for (const auto& entry : sparse->get_sparse_feature_view(i))
+				sum += entry.entry * w[entry.feat_index];
+		}
+		benchmark::DoNotOptimize(sum);
+	}
+}
+
+/* the DotFeatures hot paths, which use views internally */
+BENCHMARK_DEFINE_F(RefCountFeaturesFixture, SparseFeatures_DenseDot)(benchmark::State& state)
+{
+	for (auto _ : state)
+	{
+		float64_t sum = 0;
+		for (index_t i = 0; i < sparse->get_num_vectors(); ++i)
+			sum += sparse->dense_dot_view(i, w);
+		benchmark::DoNotOptimize(sum);
+	}
+}
+
+BENCHMARK_DEFINE_F(RefCountFeaturesFixture, LinearKernel_Dense)(benchmark::State& state)
+{
+	CLinearKernel* kernel = new CLinearKernel(dense, dense);
+	for (auto _ : state)
+	{
+		float64_t sum = 0;
+		for (index_t i = 0; i < 100; ++i)
+			for (index_t j = 0; j < dense->get_num_vectors(); ++j)
+				sum += kernel->kernel(i, j);
+		benchmark::DoNotOptimize(sum);
+	}
+	SG_UNREF(kernel);
+}
+
+BENCHMARK_DEFINE_F(RefCountFeaturesFixture, LinearKernel_Sparse)(benchmark::State& state)
+{
+	CLinearKernel* kernel = new CLinearKernel(sparse, sparse);
+	for (auto _ : state)
+	{
+		float64_t sum = 0;
+		for (index_t i = 0; i < 100; ++i)
+			for (index_t j = 0; j < sparse->get_num_vectors(); ++j)
+				sum += kernel->kernel(i, j);
+		benchmark::DoNotOptimize(sum);
+	}
+	SG_UNREF(kernel);
+}
+
+#define ADD_REFCOUNT_FEATURES_ARGS(WHAT) \
+	BENCHMARK_REGISTER_F(RefCountFeaturesFixture, WHAT)->Range(16, 1024)->Unit(benchmark::kMicrosecond);
+
+ADD_REFCOUNT_FEATURES_ARGS(DenseFeatures_SGVectorLoop)
+ADD_REFCOUNT_FEATURES_ARGS(DenseFeatures_ViewLoop)
+ADD_REFCOUNT_FEATURES_ARGS(SparseFeatures_SGSparseVectorLoop)
+ADD_REFCOUNT_FEATURES_ARGS(SparseFeatures_ViewLoop)
+ADD_REFCOUNT_FEATURES_ARGS(SparseFeatures_DenseDot)
+ADD_REFCOUNT_FEATURES_ARGS(LinearKernel_Dense)
+ADD_REFCOUNT_FEATURES_ARGS(LinearKernel_Sparse)
+
 }
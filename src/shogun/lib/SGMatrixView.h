@@ -0,0 +1,126 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: agent
+ */
+#ifndef __SGMATRIXVIEW_H__
+#define __SGMATRIXVIEW_H__
+
+#include <shogun/lib/config.h>
+
+#include <shogun/lib/common.h>
+#include <shogun/lib/SGMatrix.h>
+#include <shogun/lib/SGVectorView.h>
+
+#include <type_traits>
+
+namespace shogun
+{
+
+/** @brief Non-owning view of a column-major matrix.
+ *
+ * Matrix counterpart of SGVectorView: no allocation and no reference
+ * counting, columns are handed out as SGVectorView. The element type may
+ * be const, in which case the view is read-only.
+ */
+template <class T> class SGMatrixView
+{
+	public:
+		/** The element type of the view */
+		typedef T Scalar;
+
+		/** Empty view */
+		SGMatrixView() : m_data(NULL), m_num_rows(0), m_num_cols(0)
+		{
+		}
+
+		/** View of a column-major memory range
+		 *
+		 * @param data first element
+		 * @param num_rows number of rows
+		 * @param num_cols number of columns
+		 */
+		SGMatrixView(T* data, index_t num_rows, index_t num_cols)
+			: m_data(data), m_num_rows(num_rows), m_num_cols(num_cols)
+		{
+		}
+
+		/** View of the memory of a matrix. The matrix keeps owning it.
+		 *
+		 * @param mat matrix on the CPU
+		 */
+		template <class U, typename = typename std::enable_if<std::is_same<
+			typename std::remove_const<T>::type, U>::value>::type>
+		SGMatrixView(const SGMatrix<U>& mat)
+			: m_data(mat.matrix), m_num_rows(mat.num_rows),
+			  m_num_cols(mat.num_cols)
+		{
+			REQUIRE(!mat.on_gpu(), "Cannot view a matrix on GPU.\n");
+		}
+
+		/** Read-only view of a mutable view
+		 *
+		 * @param other view to convert
+		 */
+		template <class U, typename = typename std::enable_if<
+			std::is_same<T, const U>::value>::type>
+		SGMatrixView(const SGMatrixView<U>& other)
+			: m_data(other.data()), m_num_rows(other.num_rows()),
+			  m_num_cols(other.num_cols())
+		{
+		}
+
+		/** @return first element */
+		SG_FORCED_INLINE T* data() const
+		{
+			return m_data;
+		}
+
+		/** @return number of rows */
+		SG_FORCED_INLINE index_t num_rows() const
+		{
+			return m_num_rows;
+		}
+
+		/** @return number of columns */
+		SG_FORCED_INLINE index_t num_cols() const
+		{
+			return m_num_cols;
+		}
+
+		/** @return number of elements */
+		SG_FORCED_INLINE int64_t size() const
+		{
+			return int64_t(m_num_rows) * m_num_cols;
+		}
+
+		/** @param i_row row index, not checked
+		 * @param i_col column index, not checked
+		 * @return element
+		 */
+		SG_FORCED_INLINE T& operator()(index_t i_row, index_t i_col) const
+		{
+			return m_data[int64_t(i_col) * m_num_rows + i_row];
+		}
+
+		/** @param i_col column index, not checked
+		 * @return view of the column
+		 */
+		SG_FORCED_INLINE SGVectorView<T> col(index_t i_col) const
+		{
+			return SGVectorView<T>(
+				m_data + int64_t(i_col) * m_num_rows, m_num_rows);
+		}
+
+	private:
+		/** first element */
+		T* m_data;
+		/** number of rows */
+		index_t m_num_rows;
+		/** number of columns */
+		index_t m_num_cols;
+};
+
+}
+
+#endif // __SGMATRIXVIEW_H__
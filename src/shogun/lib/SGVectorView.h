@@ -0,0 +1,137 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: agent
+ */
+#ifndef __SGVECTORVIEW_H__
+#define __SGVECTORVIEW_H__
+
+#include <shogun/lib/config.h>
+
+#include <shogun/lib/common.h>
+#include <shogun/lib/SGVector.h>
+
+#include <type_traits>
+
+namespace shogun
+{
+
+/** @brief Non-owning view of a contiguous range of elements.
+ *
+ * Unlike SGVector, a view neither allocates nor touches a reference
+ * counter when it is created, copied or destroyed. It is meant to be
+ * passed by value into hot loops (kernel rows, dot products, feature
+ * iteration) where the memory is known to outlive the view, e.g. a
+ * column of a feature matrix that is owned by the features.
+ *
+ * The element type may be const, in which case the view is read-only.
+ * A view of T converts implicitly into a view of const T.
+ */
+template <class T> class SGVectorView
+{
+	public:
+		/** The element type of the view */
+		typedef T Scalar;
+		/** iterator */
+		typedef T* iterator;
+
+		/** Empty view */
+		SGVectorView() : m_data(NULL), m_size(0)
+		{
+		}
+
+		/** View of a memory range
+		 *
+		 * @param data first element
+		 * @param size number of elements
+		 */
+		SGVectorView(T* data, index_t size) : m_data(data), m_size(size)
+		{
+		}
+
+		/** View of the memory of a vector. The vector keeps owning it.
+		 *
+		 * @param vec vector on the CPU
+		 */
+		template <class U, typename = typename std::enable_if<std::is_same<
+			typename std::remove_const<T>::type, U>::value>::type>
+		SGVectorView(const SGVector<U>& vec)
+			: m_data(vec.vector), m_size(vec.vlen)
+		{
+			REQUIRE(!vec.on_gpu(), "Cannot view a vector on GPU.\n");
+		}
+
+		/** Read-only view of a mutable view
+		 *
+		 * @param other view to convert
+		 */
+		template <class U, typename = typename std::enable_if<
+			std::is_same<T, const U>::value>::type>
+		SGVectorView(const SGVectorView<U>& other)
+			: m_data(other.data()), m_size(other.size())
+		{
+		}
+
+		/** @return first element */
+		SG_FORCED_INLINE T* data() const
+		{
+			return m_data;
+		}
+
+		/** @return number of elements */
+		SG_FORCED_INLINE index_t size() const
+		{
+			return m_size;
+		}
+
+		/** @return whether the view has no elements */
+		SG_FORCED_INLINE bool empty() const
+		{
+			return m_size == 0;
+		}
+
+		/** @param index index of element, not checked
+		 * @return element
+		 */
+		SG_FORCED_INLINE T& operator[](index_t index) const
+		{
+			return m_data[index];
+		}
+
+		/** @return iterator to the first element */
+		SG_FORCED_INLINE iterator begin() const
+		{
+			return m_data;
+		}
+
+		/** @return iterator past the last element */
+		SG_FORCED_INLINE iterator end() const
+		{
+			return m_data + m_size;
+		}
+
+		/** View of a sub range
+		 *
+		 * @param start index of the first element
+		 * @param len number of elements
+		 * @return view of elements start, ..., start+len-1
+		 */
+		SGVectorView<T> slice(index_t start, index_t len) const
+		{
+			REQUIRE(
+				start >= 0 && len >= 0 && start + len <= m_size,
+				"Slice [%d, %d) exceeds view of size %d.\n", start,
+				start + len, m_size);
+			return SGVectorView<T>(m_data + start, len);
+		}
+
+	private:
+		/** first element */
+		T* m_data;
+		/** number of elements */
+		index_t m_size;
+};
+
+}
+
+#endif // __SGVECTORVIEW_H__
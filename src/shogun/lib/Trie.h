@@ -15,6 +15,9 @@
 #include <shogun/base/DynArray.h>
 #include <shogun/mathematics/Math.h>
 #include <shogun/base/SGObject.h>
+#include <shogun/lib/FlatTrie.h>
+
+#include <vector>
 
 namespace shogun
 {
@@ -301,6 +304,13 @@ IGNORE_IN_CLASSLIST template <class Trie> class CTrie : public CSGObject
 			int32_t mkl_stepsize, float64_t * weights,
 			bool degree_times_position_weights);
 
+		/** copy a single tree into a flattened trie for batched lookups
+		 *
+		 * @param tree_pos tree position
+		 * @param flat flattened trie, its previous content is removed
+		 */
+		void flatten(int32_t tree_pos, CFlatTrie& flat) const;
+
 		/** compute scoring helper
 		 *
 		 * @param tree tree
@@ -2151,5 +2161,81 @@ void CTrie<Trie>::fill_backtracking_table(
 		}
 	}
 }
+
+	template <class Trie>
+void CTrie<Trie>::flatten(int32_t tree_pos, CFlatTrie& flat) const
+{
+	ASSERT(trees && tree_pos>=0 && tree_pos<length)
+	flat.clear(degree, position_weights);
+
+	// node of this trie, its depth, its copy and for compact terminal
+	// nodes the offset into their sequence (-1 for regular nodes)
+	struct FlattenEntry
+	{
+		int32_t node;
+		int32_t depth;
+		int32_t flat_node;
+		int32_t seq_offset;
+	};
+
+	// breadth first, so that the copies end up in level order
+	std::vector<FlattenEntry> queue;
+	queue.push_back({trees[tree_pos], 0, flat.add_node(), -1});
+
+	for (size_t head=0; head<queue.size(); head++)
+	{
+		const FlattenEntry entry=queue[head];
+		const Trie& node=TreeMem[entry.node];
+
+		if (entry.seq_offset>=0)
+		{
+			// continue the chain of a compact terminal node until its
+			// sequence ends, each link is weighted with its level
+			const int32_t k=entry.seq_offset+1;
+			if ((entry.depth<degree) && (k<16) && (node.seq[k]<4))
+			{
+				int32_t child=flat.add_node(0.0, node.weight);
+				flat.set_child(entry.flat_node, node.seq[k], child);
+				queue.push_back({entry.node, entry.depth+1, child, k});
+			}
+		}
+		else if (entry.depth==degree-1)
+		{
+			// last level, the child weights become leaves
+			for (int32_t q=0; q<4; q++)
+			{
+				float64_t w=node.child_weights[q];
+				int32_t child=weights_in_tree ? flat.add_node(w, 0.0) : flat.add_node(0.0, w);
+				flat.set_child(entry.flat_node, q, child);
+			}
+		}
+		else
+		{
+			for (int32_t q=0; q<4; q++)
+			{
+				int32_t tree=node.children[q];
+				if (tree==NO_CHILD)
+					continue;
+
+				if (tree<0)
+				{
+					tree=-tree;
+					TRIE_ASSERT_EVERYTHING(TreeMem[tree].has_seq)
+					TRIE_ASSERT(TreeMem[tree].seq[0]==q)
+					int32_t child=flat.add_node(0.0, TreeMem[tree].weight);
+					flat.set_child(entry.flat_node, q, child);
+					queue.push_back({tree, entry.depth+1, child, 0});
+				}
+				else
+				{
+					float64_t w=TreeMem[tree].weight;
+					int32_t child=weights_in_tree ? flat.add_node(w, 0.0) : flat.add_node(0.0, w);
+					flat.set_child(entry.flat_node, q, child);
+					queue.push_back({tree, entry.depth+1, child, -1});
+				}
+			}
+		}
+	}
+}
 }
 #endif // _TRIE_H___
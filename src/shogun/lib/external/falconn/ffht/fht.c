@@ -0,0 +1,2 @@
+#include "fht.h"
+#include "fht_impl.h"
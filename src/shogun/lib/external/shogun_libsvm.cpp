@@ -87,6 +87,8 @@ public:
 	// return some position p where [p,len) need to be filled
 	// (p >= len if nothing needs to be filled)
 	int32_t get_data(const int32_t index, Qfloat **data, int32_t len);
+	// whether data [0,len) is cached
+	bool has_data(const int32_t index, int32_t len) const { return head[index].len >= len; }
 	void swap_index(int32_t i, int32_t j);	// future_option
 
 private:
@@ -210,6 +212,8 @@ public:
 	virtual Qfloat *get_Q(int32_t column, int32_t len) const = 0;
 	virtual Qfloat *get_QD() const = 0;
 	virtual void swap_index(int32_t i, int32_t j) const = 0;
+	// hint that get_Q(column,len) follows soon
+	virtual void prefetch_Q(int32_t column, int32_t len) const {}
 	virtual ~QMatrix() {}
 
 	float64_t max_train_time;
@@ -232,6 +236,13 @@ public:
 		if(x_square) CMath::swap(x_square[i],x_square[j]);
 	}
 
+	// let the kernel read ahead row i unless [0,len) of it is cached
+	void prefetch_row(const Cache* cache, int32_t i, int32_t len) const
+	{
+		if (!cache->has_data(i,len))
+			kernel->prefetch_rows(&x[i]->index, 1);
+	}
+
 	void compute_Q_parallel(Qfloat* data, float64_t* lab, int32_t i, int32_t start, int32_t len) const
 	{
 		if (lab) // two class
@@ -424,6 +435,9 @@ void Solver::reconstruct_gradient()
 	{
 		for(i=active_size;i<l;i++)
 		{
+			// read ahead the next row while this one is computed
+			if(i+1<l)
+				Q->prefetch_Q(i+1,active_size);
 			const Qfloat *Q_i = Q->get_Q(i,active_size);
 			for(j=0;j<active_size;j++)
 				if(is_free(j))
@@ -432,9 +446,14 @@ void Solver::reconstruct_gradient()
 	}
 	else
 	{
+		int32_t next=0;
 		for(i=0;i<active_size;i++)
 			if(is_free(i))
 			{
+				for(next=CMath::max(next,i+1); next<active_size && !is_free(next); next++);
+				if(next<active_size)
+					Q->prefetch_Q(next,l);
+
 				const Qfloat *Q_i = Q->get_Q(i,l);
 				float64_t alpha_i = alpha[i];
 				for(j=active_size;j<l;j++)
@@ -490,10 +509,16 @@ void Solver::Solve(
 		}
 		SG_SINFO("Computing gradient for initial set of non-zero alphas\n")
 		//CMath::display_vector(alpha, l, "alphas");
+		int32_t next = 0;
 		for (i = 0; i < l && !cancel_computation(); i++)
 		{
 			if(!is_lower_bound(i))
 			{
+				// read ahead the next row needed while this one is computed
+				for(next=CMath::max(next,i+1); next<l && is_lower_bound(next); next++);
+				if(next<l)
+					Q->prefetch_Q(next,l);
+
 				const Qfloat *Q_i = Q->get_Q(i,l);
 				float64_t alpha_i = alpha[i];
 				int32_t j;
@@ -549,6 +574,8 @@ void Solver::Solve(
 
 		// update alpha[i] and alpha[j], handle bounds carefully
 
+		// read ahead Q_j while Q_i is computed
+		Q->prefetch_Q(j,active_size);
 		const Qfloat *Q_i = Q->get_Q(i,active_size);
 		const Qfloat *Q_j = Q->get_Q(j,active_size);
 
@@ -1324,6 +1351,11 @@ public:
 			return -Q;
 	}
 
+	void prefetch_Q(int32_t i, int32_t len) const
+	{
+		prefetch_row(cache, i, len);
+	}
+
 	Qfloat *get_QD() const
 	{
 		return QD;
@@ -1685,6 +1717,11 @@ public:
 		return data;
 	}
 
+	void prefetch_Q(int32_t i, int32_t len) const
+	{
+		prefetch_row(cache, i, len);
+	}
+
 	Qfloat *get_QD() const
 	{
 		return QD;
@@ -1733,6 +1770,11 @@ public:
 		return data;
 	}
 
+	void prefetch_Q(int32_t i, int32_t len) const
+	{
+		prefetch_row(cache, i, len);
+	}
+
 	Qfloat *get_QD() const
 	{
 		return QD;
@@ -1803,6 +1845,11 @@ public:
 		return buf;
 	}
 
+	void prefetch_Q(int32_t i, int32_t len) const
+	{
+		prefetch_row(cache, index[i], l);
+	}
+
 	Qfloat *get_QD() const
 	{
 		return QD;
@@ -12,6 +12,8 @@
 #include <shogun/lib/tapkee/stichwort/keywords.hpp>
 /* End of Tapkee includes */
 
+#include <vector>
+
 namespace tapkee
 {
 	namespace {
@@ -82,6 +84,8 @@ namespace tapkee
 		 * - @ref tapkee::ManifoldSculpting
 		 *
 		 * Default value is @ref tapkee::CoverTree if available, @ref tapkee::Brute otherwise.
+		 * For large data sets @ref tapkee::NNDescent gives an approximate
+		 * neighbors graph much faster.
 		 *
 		 * The corresponding value should have type
 		 * @ref tapkee::NeighborsMethod.
@@ -89,6 +93,24 @@ namespace tapkee
 		const stichwort::ParameterKeyword<NeighborsMethod>
 			neighbors_method("nearest neighbors method", default_neighbors_method);
 
+		/** The keyword for the value that stores a pointer to a
+		 * neighbors graph shared by several embeddings of the same data.
+		 *
+		 * If the graph contains the required number of neighbors of every
+		 * vector it is used instead of searching for neighbors, otherwise
+		 * it is replaced with the result of the search. The graph has to
+		 * be computed with the same distance.
+		 *
+		 * Used by the methods listed for @ref tapkee::neighbors_method.
+		 *
+		 * Default value is NULL (nothing is shared).
+		 *
+		 * The corresponding value should have type
+		 * @code std::vector<std::vector<tapkee::IndexType> >* @endcode
+		 */
+		const stichwort::ParameterKeyword<std::vector<std::vector<IndexType> >*>
+			neighbors_cache("neighbors cache", NULL);
+
 		/** The keyword for the value that stores the number of neighbors.
 		 *
 		 * Used by all local methods such as:
@@ -353,6 +375,19 @@ namespace tapkee
 		 */
 		const stichwort::ParameterKeyword<ScalarType> sne_theta("SNE theta", 0.5);
 
+		/** The keyword for the value that indicates whether
+		 * the repulsive forces of t-SNE are computed by FFT-accelerated
+		 * interpolation instead of Barnes-Hut. Only used for 2D
+		 * embeddings with theta > 0.
+		 *
+		 * Used by @ref tapkee::tDistributedStochasticNeighborEmbedding.
+		 *
+		 * Default value is false.
+		 *
+		 * The corresponding value should have type bool.
+		 */
+		const stichwort::ParameterKeyword<bool> sne_interpolation("SNE interpolation", false);
+
 		/** The keyword for the value that stores the squishingRate
 		 * parameter of the Manifold Sculpting algorithm.
 		 *
@@ -137,6 +137,10 @@ namespace tapkee
 	static const NeighborsMethod Brute("Brute-force");
 	//! Vantage point tree -based method.
 	static const NeighborsMethod VpTree("Vantage point tree");
+	//! Approximate NN-descent method, runs in roughly \f$ O(N^{1.14}) \f$
+	//! time in practice. Recommended for large data sets where exact
+	//! search is too slow.
+	static const NeighborsMethod NNDescent("NN-descent");
 #ifdef TAPKEE_USE_LGPL_COVERTREE
 	//! Covertree-based method with approximate \f$ O(\log N) \f$ time complexity.
 	//! Recommended to be used as a default method.
@@ -162,8 +166,9 @@ namespace tapkee
 	//! default method. Supports both generalized and standard eigenproblems.
 	static const EigenMethod Arpack("Arpack");
 #endif
-	//! Randomized method (implementation taken from the redsvd lib).
-	//! Supports only standard but not generalized eigenproblems.
+	//! Randomized block Krylov method, only needs matrix products and
+	//! is recommended for large sparse problems. Supports standard
+	//! eigenproblems and the generalized eigenproblem of Laplacian eigenmaps.
 	static const EigenMethod Randomized("Randomized");
 	//! Eigen library dense method (could be useful for debugging). Computes
 	//! all eigenvectors thus can be very slow doing large-scale.
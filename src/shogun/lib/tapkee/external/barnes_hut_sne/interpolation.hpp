@@ -0,0 +1,272 @@
+/* This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Copyright (c) 2026 agent
+ *
+ * Interpolation based repulsive forces for 2D t-SNE, following
+ * G. C. Linderman et al., "Fast interpolation-based t-SNE for improved
+ * visualization of single-cell RNA-seq data", Nature Methods 16, 2019.
+ */
+
+#ifndef TSNE_INTERPOLATION_H
+#define TSNE_INTERPOLATION_H
+
+/* Tapkee includes */
+#include <shogun/lib/tapkee/defines.hpp>
+/* End of Tapkee includes */
+
+#include <math.h>
+#include <float.h>
+#include <algorithm>
+#include <complex>
+#include <vector>
+
+namespace tsne
+{
+
+using tapkee::ScalarType;
+
+typedef std::complex<ScalarType> ComplexType;
+
+//! In-place radix-2 FFT, the length must be a power of two. The twiddle
+//! factors of the stage with butterflies of half length h are expected at
+//! twiddles[h], ..., twiddles[2h-1]. The inverse transform is scaled by 1/n.
+inline void fft(ComplexType* x, int n, const ComplexType* twiddles, bool inverse)
+{
+	for (int i = 1, j = 0; i < n; i++) {
+		int bit = n >> 1;
+		for (; j & bit; bit >>= 1) j ^= bit;
+		j ^= bit;
+		if (i < j) std::swap(x[i], x[j]);
+	}
+
+	const ScalarType sign = inverse ? -1.0 : 1.0;
+	for (int half = 1; half < n; half <<= 1) {
+		const ComplexType* w = twiddles + half;
+		for (int i = 0; i < n; i += 2 * half) {
+			for (int j = 0; j < half; j++) {
+				// spelled out, std::complex multiplication checks for infinities
+				const ScalarType w_re = w[j].real();
+				const ScalarType w_im = sign * w[j].imag();
+				const ComplexType a = x[i + j + half];
+				const ComplexType v(a.real() * w_re - a.imag() * w_im, a.real() * w_im + a.imag() * w_re);
+				const ComplexType u = x[i + j];
+				x[i + j] = u + v;
+				x[i + j + half] = u - v;
+			}
+		}
+	}
+
+	if (inverse) {
+		const ScalarType scale = 1.0 / n;
+		for (int i = 0; i < n; i++) x[i] *= scale;
+	}
+}
+
+//! Computes the t-SNE repulsive forces of a 2D embedding by interpolating
+//! the points onto an equispaced grid, where the kernel sums become
+//! convolutions that are evaluated with the FFT. Costs O(N) plus
+//! O(M log M) for a grid of M nodes, instead of the O(N log N) of
+//! Barnes-Hut. The grid only depends on the extent of the embedding, so
+//! this pays off for large data sets (roughly above 10^5 points).
+class InterpolationGrid
+{
+public:
+
+	/** @param n_interpolation_points Lagrange nodes per interval and dimension
+	 *  @param min_num_intervals minimum number of intervals per dimension
+	 *  @param intervals_per_integer intervals per unit length of the embedding
+	 */
+	InterpolationGrid(int n_interpolation_points = 3, int min_num_intervals = 50,
+	                  ScalarType intervals_per_integer = 1.0) :
+		p(n_interpolation_points), min_intervals(min_num_intervals),
+		intervals_per_unit(intervals_per_integer), L(0), twiddles(), kernels(), grid_1(), grid_2()
+	{
+	}
+
+	//! Fills neg_f (N x 2, row-major) with sum_j q_ij^2 (y_i - y_j) and
+	//! returns the normalization sum_{i != j} q_ij in sum_Q, where
+	//! q_ij = 1 / (1 + |y_i - y_j|^2).
+	void computeRepulsiveForces(const ScalarType* Y, int N, ScalarType* neg_f, ScalarType* sum_Q)
+	{
+		// Square bounding box, so the grid spacing is the same in both dimensions
+		ScalarType min_c = DBL_MAX, max_c = -DBL_MAX;
+		for (int i = 0; i < N * 2; i++) {
+			min_c = std::min(min_c, Y[i]);
+			max_c = std::max(max_c, Y[i]);
+		}
+		const ScalarType span = std::max(max_c - min_c, (ScalarType) 1e-5);
+		int n_boxes = std::max(min_intervals, (int) ceil(span / intervals_per_unit));
+
+		// The FFT length is a power of two, use the intervals that fit for free
+		L = 1;
+		while (L < 2 * n_boxes * p) L <<= 1;
+		n_boxes = L / (2 * p);
+
+		const ScalarType box_width = span / n_boxes;
+		const ScalarType h = box_width / p;
+		const int m = n_boxes * p;
+		twiddles.resize(L);
+		for (int half = 1; half < L; half <<= 1)
+			for (int j = 0; j < half; j++)
+				twiddles[half + j] = std::polar((ScalarType) 1.0, (ScalarType) (-M_PI * j / half));
+
+		// Fourier transforms of the kernels q and q^2 embedded in circulant
+		// matrices. Both are real and even, so their transforms are real and
+		// one complex transform gives both: q in the real part, q^2 in the
+		// imaginary part.
+		kernels.assign(L * L, ComplexType());
+		for (int dx = -(m - 1); dx < m; dx++) {
+			for (int dy = -(m - 1); dy < m; dy++) {
+				const ScalarType q = 1.0 / (1.0 + h * h * (dx * dx + dy * dy));
+				kernels[((dx + L) % L) * L + (dy + L) % L] = ComplexType(q, q * q);
+			}
+		}
+		fft2(kernels.data(), L, false);
+
+		// Lagrange weights of every point for the nodes of its interval
+		std::vector<int> box_x(N), box_y(N);
+		std::vector<ScalarType> weights_x(N * p), weights_y(N * p);
+		#pragma omp parallel for
+		for (int i = 0; i < N; i++) {
+			lagrangeWeights((Y[i * 2] - min_c) / box_width, n_boxes, &box_x[i], &weights_x[i * p]);
+			lagrangeWeights((Y[i * 2 + 1] - min_c) / box_width, n_boxes, &box_y[i], &weights_y[i * p]);
+		}
+
+		// Charges: 1 for the kernel q, and 1, y_x, y_y for the kernel q^2.
+		// Two real charges share one complex grid: 1 and y_y in the first,
+		// 1 and y_x in the second.
+		grid_1.assign(L * L, ComplexType());
+		grid_2.assign(L * L, ComplexType());
+		for (int i = 0; i < N; i++) {
+			for (int k = 0; k < p; k++) {
+				for (int l = 0; l < p; l++) {
+					const int ind = (box_x[i] * p + k) * L + box_y[i] * p + l;
+					const ScalarType w = weights_x[i * p + k] * weights_y[i * p + l];
+					grid_1[ind] += ComplexType(w, w * Y[i * 2 + 1]);
+					grid_2[ind] += ComplexType(w, w * Y[i * 2]);
+				}
+			}
+		}
+
+		// Potentials at the grid nodes, only the first m rows of the
+		// zero padded grids are nonzero or needed
+		fft2(grid_1.data(), m, false);
+		fft2(grid_2.data(), m, false);
+
+		// With Z the transform of a + ib, the transforms of the real grids
+		// are A(k) = (Z(k) + conj(Z(-k))) / 2 and B(k) = (Z(k) - conj(Z(-k))) / 2i,
+		// so the transform of a * q + i b * q^2 is
+		// (Z(k) (F1 + F2) + conj(Z(-k)) (F1 - F2)) / 2.
+		#pragma omp parallel for
+		for (int kx = 0; kx < L; kx++) {
+			for (int ky = 0; ky < L; ky++) {
+				const int ind = kx * L + ky;
+				const int neg_ind = ((L - kx) % L) * L + (L - ky) % L;
+				if (neg_ind < ind) continue;
+
+				const ScalarType f1 = kernels[ind].real(), f2 = kernels[ind].imag();
+				const ComplexType z = grid_1[ind], z_neg = grid_1[neg_ind];
+				grid_1[ind] = .5 * ((f1 + f2) * z + (f1 - f2) * std::conj(z_neg));
+				grid_1[neg_ind] = .5 * ((f1 + f2) * z_neg + (f1 - f2) * std::conj(z));
+				grid_2[ind] *= f2;
+				if (neg_ind != ind) grid_2[neg_ind] *= f2;
+			}
+		}
+
+		fft2(grid_1.data(), m, true);
+		fft2(grid_2.data(), m, true);
+
+		// Interpolate the potentials back to the points
+		ScalarType sum = .0;
+		#pragma omp parallel for reduction(+:sum)
+		for (int i = 0; i < N; i++) {
+			ComplexType phi_1, phi_2;
+			for (int k = 0; k < p; k++) {
+				for (int l = 0; l < p; l++) {
+					const int ind = (box_x[i] * p + k) * L + box_y[i] * p + l;
+					const ScalarType w = weights_x[i * p + k] * weights_y[i * p + l];
+					phi_1 += w * grid_1[ind];
+					phi_2 += w * grid_2[ind];
+				}
+			}
+
+			// The self interaction q_ii = 1 is contained in the sums
+			sum += phi_1.real() - 1.0;
+			neg_f[i * 2] = Y[i * 2] * phi_2.real() - phi_2.imag();
+			neg_f[i * 2 + 1] = Y[i * 2 + 1] * phi_2.real() - phi_1.imag();
+		}
+		*sum_Q = sum;
+	}
+
+private:
+
+	//! Finds the interval of a coordinate (in units of intervals) and the
+	//! Lagrange weights of the interval's nodes at (k + 0.5) / p
+	void lagrangeWeights(ScalarType pos, int n_boxes, int* box, ScalarType* weights) const
+	{
+		int b = std::min((int) pos, n_boxes - 1);
+		b = std::max(b, 0);
+		const ScalarType u = pos - b;
+		for (int k = 0; k < p; k++) {
+			ScalarType w = 1.0;
+			for (int j = 0; j < p; j++) {
+				if (j != k)
+					w *= (u - (j + .5) / p) / ((ScalarType) (k - j) / p);
+			}
+			weights[k] = w;
+		}
+		*box = b;
+	}
+
+	//! 2D FFT of a row-major L x L array. Only the first n_rows rows are
+	//! transformed along the rows: for the forward transform the others
+	//! have to be zero, for the inverse transform they are not computed.
+	void fft2(ComplexType* x, int n_rows, bool inverse) const
+	{
+		// Columns are transformed in blocks, so the strided copies use
+		// whole cache lines
+		const int block = std::min(L, 8);
+
+		#pragma omp parallel
+		{
+			std::vector<ComplexType> columns(block * L);
+
+			if (!inverse) {
+				#pragma omp for
+				for (int r = 0; r < n_rows; r++)
+					fft(x + r * L, L, twiddles.data(), inverse);
+			}
+
+			#pragma omp for
+			for (int c = 0; c < L; c += block) {
+				for (int r = 0; r < L; r++)
+					for (int b = 0; b < block; b++) columns[b * L + r] = x[r * L + c + b];
+				for (int b = 0; b < block; b++)
+					fft(&columns[b * L], L, twiddles.data(), inverse);
+				for (int r = 0; r < L; r++)
+					for (int b = 0; b < block; b++) x[r * L + c + b] = columns[b * L + r];
+			}
+
+			if (inverse) {
+				#pragma omp for
+				for (int r = 0; r < n_rows; r++)
+					fft(x + r * L, L, twiddles.data(), inverse);
+			}
+		}
+	}
+
+	int p;
+	int min_intervals;
+	ScalarType intervals_per_unit;
+	int L;
+	std::vector<ComplexType> twiddles;
+
+	// Buffers, kept between calls to avoid reallocations
+	std::vector<ComplexType> kernels;
+	std::vector<ComplexType> grid_1;
+	std::vector<ComplexType> grid_2;
+};
+
+}
+
+#endif
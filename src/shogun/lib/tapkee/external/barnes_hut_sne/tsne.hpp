@@ -36,6 +36,7 @@
 #include <shogun/lib/tapkee/utils/logging.hpp>
 #include <shogun/lib/tapkee/utils/time.hpp>
 #include <shogun/lib/tapkee/external/barnes_hut_sne/quadtree.hpp>
+#include <shogun/lib/tapkee/external/barnes_hut_sne/interpolation.hpp>
 #include <shogun/lib/tapkee/external/barnes_hut_sne/vptree.hpp>
 /* End of Tapkee includes */
 
@@ -45,6 +46,7 @@
 #include <stdio.h>
 #include <cstring>
 #include <time.h>
+#include <vector>
 
 //! Namespace containing implementation of t-SNE algorithm
 namespace tsne
@@ -57,12 +59,23 @@ static inline ScalarType sign(ScalarType x) { return (x == .0 ? .0 : (x < .0 ? -
 class TSNE
 {
 public:
-	void run(tapkee::DenseMatrix& X, int N, int D, ScalarType* Y, int no_dims, ScalarType perplexity, ScalarType theta)
+	// If interpolation is set, the repulsive forces of the approximate
+	// (theta > 0) algorithm are computed by FFT-accelerated interpolation
+	// instead of Barnes-Hut. Only available for 2D embeddings.
+	void run(tapkee::DenseMatrix& X, int N, int D, ScalarType* Y, int no_dims, ScalarType perplexity, ScalarType theta,
+	         bool interpolation = false)
 	{
 		// Determine whether we are using an exact algorithm
 		bool exact = (theta == .0) ? true : false;
+		if (!exact && interpolation && no_dims != 2)
+		{
+			tapkee::LoggingSingleton::instance().message_warning("Interpolation is only available for 2D embeddings");
+			interpolation = false;
+		}
 		if (exact)
 			tapkee::LoggingSingleton::instance().message_info("Using exact t-SNE algorithm");
+		else if (interpolation)
+			tapkee::LoggingSingleton::instance().message_info("Using FFT-accelerated interpolation t-SNE algorithm");
 		else
 			tapkee::LoggingSingleton::instance().message_info("Using Barnes-Hut-SNE algorithm");
 
@@ -129,11 +142,13 @@ public:
 
 		{
 			tapkee::tapkee_internal::timed_context context("Main t-SNE loop");
+			InterpolationGrid interpolation_grid;
+			InterpolationGrid* grid = interpolation ? &interpolation_grid : NULL;
 			for(int iter = 0; iter < max_iter; iter++) {
 
 				// Compute (approximate) gradient
 				if(exact) computeExactGradient(P.data(), Y, N, no_dims, dY.data());
-				else computeGradient(P.data(), row_P, col_P, val_P, Y, N, no_dims, dY.data(), theta);
+				else computeGradient(P.data(), row_P, col_P, val_P, Y, N, no_dims, dY.data(), theta, grid);
 
 				// Update gains
 				for(int i = 0; i < N * no_dims; i++) gains.data()[i] = (sign(dY.data()[i]) != sign(uY.data()[i])) ? (gains.data()[i] + .2) : (gains.data()[i] * .8);
@@ -161,7 +176,7 @@ public:
 				if((iter > 0) && ((iter % 50 == 0) || (iter == max_iter - 1))) {
 					ScalarType C = .0;
 					if(exact) C = evaluateError(P.data(), Y, N);
-					else      C = evaluateError(row_P, col_P, val_P, Y, N, theta);  // doing approximate computation here!
+					else      C = evaluateError(row_P, col_P, val_P, Y, N, theta, grid);  // doing approximate computation here!
 					tapkee::LoggingSingleton::instance().message_info(
 							formatting::format("Iteration {}: error is {}\n", iter, C));
 				}
@@ -264,26 +279,56 @@ public:
 
 private:
 
-	void computeGradient(ScalarType* /*P*/, int* inp_row_P, int* inp_col_P, ScalarType* inp_val_P, ScalarType* Y, int N, int D, ScalarType* dC, ScalarType theta)
+	void computeGradient(ScalarType* /*P*/, int* inp_row_P, int* inp_col_P, ScalarType* inp_val_P, ScalarType* Y, int N, int D, ScalarType* dC, ScalarType theta,
+	                     InterpolationGrid* grid)
 	{
-		// Construct quadtree on current map
-		QuadTree* tree = new QuadTree(Y, N);
-
 		// Compute all terms required for t-SNE gradient
-		ScalarType sum_Q = .0;
-		ScalarType* pos_f = (ScalarType*) calloc(N * D, sizeof(ScalarType));
-		ScalarType* neg_f = (ScalarType*) calloc(N * D, sizeof(ScalarType));
-		if(pos_f == NULL || neg_f == NULL) { printf("Memory allocation failed!\n"); exit(1); }
-		tree->computeEdgeForces(inp_row_P, inp_col_P, inp_val_P, N, pos_f);
-		for(int n = 0; n < N; n++) tree->computeNonEdgeForces(n, theta, neg_f + n * D, &sum_Q);
+		std::vector<ScalarType> pos_f(N * D, .0);
+		std::vector<ScalarType> neg_f(N * D, .0);
+		computeEdgeForces(inp_row_P, inp_col_P, inp_val_P, Y, N, D, pos_f.data());
+		ScalarType sum_Q = computeNonEdgeForces(Y, N, D, neg_f.data(), theta, grid);
 
 		// Compute final t-SNE gradient
 		for(int i = 0; i < N * D; i++) {
 			dC[i] = pos_f[i] - (neg_f[i] / sum_Q);
 		}
-		free(pos_f);
-		free(neg_f);
-		delete tree;
+	}
+
+	void computeEdgeForces(int* row_P, int* col_P, ScalarType* val_P, ScalarType* Y, int N, int D, ScalarType* pos_f)
+	{
+		// Rows are independent, every thread writes the forces of its own points
+		#pragma omp parallel for
+		for(int n = 0; n < N; n++) {
+			int ind1 = n * D;
+			for(int i = row_P[n]; i < row_P[n + 1]; i++) {
+
+				// Compute pairwise distance and Q-value
+				ScalarType Q = .0;
+				int ind2 = col_P[i] * D;
+				for(int d = 0; d < D; d++) Q += (Y[ind1 + d] - Y[ind2 + d]) * (Y[ind1 + d] - Y[ind2 + d]);
+				Q = val_P[i] / (1.0 + Q);
+
+				// Sum positive force
+				for(int d = 0; d < D; d++) pos_f[ind1 + d] += Q * (Y[ind1 + d] - Y[ind2 + d]);
+			}
+		}
+	}
+
+	// Computes the (unnormalized) repulsive forces and returns their normalization,
+	// by interpolation if a grid is given and by Barnes-Hut otherwise
+	ScalarType computeNonEdgeForces(ScalarType* Y, int N, int D, ScalarType* neg_f, ScalarType theta, InterpolationGrid* grid)
+	{
+		ScalarType sum_Q = .0;
+		if (grid) {
+			grid->computeRepulsiveForces(Y, N, neg_f, &sum_Q);
+			return sum_Q;
+		}
+
+		// Construct quadtree on current map, which is only read afterwards
+		QuadTree tree(Y, N);
+		#pragma omp parallel for reduction(+:sum_Q)
+		for(int n = 0; n < N; n++) tree.computeNonEdgeForces(n, theta, neg_f + n * D, &sum_Q);
+		return sum_Q;
 	}
 
 	void computeExactGradient(ScalarType* P, ScalarType* Y, int N, int D, ScalarType* dC)
@@ -300,6 +345,7 @@ private:
 		ScalarType* Q    = (ScalarType*) malloc(N * N * sizeof(ScalarType));
 		if(Q == NULL) { printf("Memory allocation failed!\n"); exit(1); }
 		ScalarType sum_Q = .0;
+		#pragma omp parallel for reduction(+:sum_Q)
 		for(int n = 0; n < N; n++) {
 			for(int m = 0; m < N; m++) {
 				if(n != m) {
@@ -310,6 +356,7 @@ private:
 		}
 
 		// Perform the computation of the gradient
+		#pragma omp parallel for
 		for(int n = 0; n < N; n++) {
 			for(int m = 0; m < N; m++) {
 				if(n != m) {
@@ -361,14 +408,13 @@ private:
 		return C;
 	}
 
-	ScalarType evaluateError(int* row_P, int* col_P, ScalarType* val_P, ScalarType* Y, int N, ScalarType theta)
+	ScalarType evaluateError(int* row_P, int* col_P, ScalarType* val_P, ScalarType* Y, int N, ScalarType theta, InterpolationGrid* grid)
 	{
 		// Get estimate of normalization term
 		const int QT_NO_DIMS = 2;
-		QuadTree* tree = new QuadTree(Y, N);
+		std::vector<ScalarType> neg_f(N * QT_NO_DIMS, .0);
+		ScalarType sum_Q = computeNonEdgeForces(Y, N, QT_NO_DIMS, neg_f.data(), theta, grid);
 		ScalarType buff[QT_NO_DIMS] = {.0, .0};
-		ScalarType sum_Q = .0;
-		for(int n = 0; n < N; n++) tree->computeNonEdgeForces(n, theta, buff, &sum_Q);
 
 		// Loop over all edges to compute t-SNE error
 		int ind1, ind2;
@@ -490,8 +536,6 @@ private:
 		int* row_P = *_row_P;
 		int* col_P = *_col_P;
 		ScalarType* val_P = *_val_P;
-		ScalarType* cur_P = (ScalarType*) malloc((N - 1) * sizeof(ScalarType));
-		if(cur_P == NULL) { printf("Memory allocation failed!\n"); exit(1); }
 		row_P[0] = 0;
 		for(int n = 0; n < N; n++) row_P[n + 1] = row_P[n] + K;
 
@@ -501,14 +545,16 @@ private:
 		for(int n = 0; n < N; n++) obj_X[n] = DataPoint(D, n, X + n * D);
 		tree->create(obj_X);
 
-		// Loop over all points to find nearest neighbors
-		//printf("Building tree...\n");
+		// Loop over all points to find nearest neighbors, the tree is only
+		// read and every point writes its own row of P
+		#pragma omp parallel
+		{
 		std::vector<DataPoint> indices;
 		std::vector<ScalarType> distances;
+		std::vector<ScalarType> cur_P(K);
+		#pragma omp for
 		for(int n = 0; n < N; n++) {
 
-			//if(n % 10000 == 0) printf(" - point %d of %d\n", n, N);
-
 			// Find nearest neighbors
 			indices.clear();
 			distances.clear();
@@ -568,10 +614,10 @@ private:
 				val_P[row_P[n] + m] = cur_P[m];
 			}
 		}
+		}
 
 		// Clean up memory
 		obj_X.clear();
-		free(cur_P);
 		delete tree;
 	}
 
@@ -107,10 +107,10 @@ public:
 		plain_distance(PlainDistance<RandomAccessIterator,DistanceCallback>(distance)),
 		kernel_distance(KernelDistance<RandomAccessIterator,KernelCallback>(kernel)),
 		begin(b), end(e), p_computation_strategy(),
-		p_eigen_method(), p_neighbors_method(), p_eigenshift(), p_traceshift(),
+		p_eigen_method(), p_neighbors_method(), p_neighbors_cache(), p_eigenshift(), p_traceshift(),
 		p_check_connectivity(), p_n_neighbors(), p_width(), p_timesteps(),
 		p_ratio(), p_max_iteration(), p_tolerance(), p_n_updates(), p_perplexity(),
-		p_theta(), p_squishing_rate(), p_global_strategy(), p_epsilon(), p_target_dimension(),
+		p_theta(), p_interpolation(), p_squishing_rate(), p_global_strategy(), p_epsilon(), p_target_dimension(),
 		n_vectors(0), current_dimension(0)
 	{
 		n_vectors = (end-begin);
@@ -130,6 +130,7 @@ public:
 		p_computation_strategy = parameters[computation_strategy];
 		p_eigen_method = parameters[eigen_method];
 		p_neighbors_method = parameters[neighbors_method];
+		p_neighbors_cache = parameters[neighbors_cache];
 		p_check_connectivity = parameters[check_connectivity];
 		p_width = parameters[gaussian_kernel_width].checked().satisfies(Positivity<ScalarType>());
 		p_timesteps = parameters[diffusion_map_timesteps].checked().satisfies(Positivity<IndexType>());
@@ -139,6 +140,7 @@ public:
 		p_tolerance = parameters[spe_tolerance].checked().satisfies(Positivity<ScalarType>());
 		p_n_updates = parameters[spe_num_updates].checked().satisfies(Positivity<IndexType>());
 		p_theta = parameters[sne_theta].checked().satisfies(NonNegativity<ScalarType>());
+		p_interpolation = parameters[sne_interpolation];
 		p_squishing_rate = parameters[squishing_rate];
 		p_global_strategy = parameters[spe_global_strategy];
 		p_epsilon = parameters[fa_epsilon].checked().satisfies(NonNegativity<ScalarType>());
@@ -215,6 +217,7 @@ private:
 	Parameter p_computation_strategy;
 	Parameter p_eigen_method;
 	Parameter p_neighbors_method;
+	Parameter p_neighbors_cache;
 	Parameter p_eigenshift;
 	Parameter p_traceshift;
 	Parameter p_check_connectivity;
@@ -227,6 +230,7 @@ private:
 	Parameter p_n_updates;
 	Parameter p_perplexity;
 	Parameter p_theta;
+	Parameter p_interpolation;
 	Parameter p_squishing_rate;
 	Parameter p_global_strategy;
 	Parameter p_epsilon;
@@ -238,7 +242,27 @@ private:
 	template<class Distance>
 	Neighbors findNeighborsWith(Distance d)
 	{
-		return find_neighbors(p_neighbors_method,begin,end,d,p_n_neighbors,p_check_connectivity);
+		Neighbors* cache = p_neighbors_cache;
+		if (cache && cache->size() == static_cast<size_t>(n_vectors))
+		{
+			const IndexType k = std::min(static_cast<IndexType>(p_n_neighbors), n_vectors-1);
+			bool usable = true;
+			for (Neighbors::const_iterator it=cache->begin(); it!=cache->end() && usable; ++it)
+				usable = (static_cast<IndexType>(it->size()) == k);
+			if (usable)
+			{
+				LoggingSingleton::instance().message_info("Using the shared neighbors graph.");
+				return *cache;
+			}
+		}
+		if (cache && !cache->empty())
+			LoggingSingleton::instance().message_warning("The shared neighbors graph does not fit, "
+			                                             "searching for neighbors again.");
+
+		Neighbors neighbors = find_neighbors(p_neighbors_method,begin,end,d,p_n_neighbors,p_check_connectivity);
+		if (cache)
+			*cache = neighbors;
+		return neighbors;
 	}
 
 	static tapkee::ProjectingFunction unimplementedProjectingFunction()
@@ -530,7 +554,7 @@ private:
 
 		DenseMatrix embedding(static_cast<IndexType>(p_target_dimension),n_vectors);
 		tsne::TSNE tsne;
-		tsne.run(data,data.cols(),data.rows(),embedding.data(),p_target_dimension,p_perplexity,p_theta);
+		tsne.run(data,data.cols(),data.rows(),embedding.data(),p_target_dimension,p_perplexity,p_theta,p_interpolation);
 
 		return TapkeeOutput(embedding.transpose(), unimplementedProjectingFunction());
 	}
@@ -124,11 +124,14 @@ Neighbors find_neighbors_bruteforce_impl(const RandomAccessIterator& begin, cons
 	typedef std::pair<RandomAccessIterator, ScalarType> DistanceRecord;
 	typedef std::vector<DistanceRecord> Distances;
 
-	Neighbors neighbors;
-	neighbors.reserve(end-begin);
-	for (RandomAccessIterator iter=begin; iter!=end; ++iter)
+	const IndexType n_vectors = end-begin;
+	Neighbors neighbors(n_vectors);
+#pragma omp parallel for schedule(dynamic, 16)
+	for (IndexType i=0; i<n_vectors; ++i)
 	{
+		RandomAccessIterator iter = begin+i;
 		Distances distances;
+		distances.reserve(n_vectors);
 		for (RandomAccessIterator around_iter=begin; around_iter!=end; ++around_iter)
 			distances.push_back(std::make_pair(around_iter, callback.distance(iter,around_iter)));
 
@@ -143,7 +146,7 @@ Neighbors find_neighbors_bruteforce_impl(const RandomAccessIterator& begin, cons
 			if (neighbors_iter->first != iter)
 				local_neighbors.push_back(neighbors_iter->first - begin);
 		}
-		neighbors.push_back(local_neighbors);
+		neighbors[i] = local_neighbors;
 	}
 	return neighbors;
 }
@@ -154,18 +157,202 @@ Neighbors find_neighbors_vptree_impl(const RandomAccessIterator& begin, const Ra
 {
 	timed_context context("VP-Tree based neighbors search");
 
-	Neighbors neighbors;
-	neighbors.reserve(end-begin);
+	const IndexType n_vectors = end-begin;
+	Neighbors neighbors(n_vectors);
 
 	VantagePointTree<RandomAccessIterator,Callback> tree(begin,end,callback);
 
-	for (RandomAccessIterator i=begin; i!=end; ++i)
+#pragma omp parallel for schedule(dynamic, 16)
+	for (IndexType i=0; i<n_vectors; ++i)
+	{
+		LocalNeighbors local_neighbors = tree.search(begin+i,k+1);
+		local_neighbors.erase(std::remove(local_neighbors.begin(),local_neighbors.end(),i),
+		                      local_neighbors.end());
+		// the query point might tie with other points and not be found
+		if (static_cast<IndexType>(local_neighbors.size()) > k)
+			local_neighbors.resize(k);
+		neighbors[i] = local_neighbors;
+	}
+
+	return neighbors;
+}
+
+//! Candidate neighbor of the NN-descent heaps, flagged as new
+//! until it has taken part in a local join
+struct NNDescentCandidate
+{
+	NNDescentCandidate(IndexType i, ScalarType d) :
+		index(i), distance(d), is_new(true) {}
+	inline bool operator<(const NNDescentCandidate& other) const
+	{
+		return distance < other.distance;
+	}
+	IndexType index;
+	ScalarType distance;
+	bool is_new;
+};
+
+//! Tries to put a candidate into a max-heap of neighbors
+inline bool nndescent_update(std::vector<NNDescentCandidate>& heap, IndexType index, ScalarType distance)
+{
+	if (distance >= heap.front().distance)
+		return false;
+	for (std::vector<NNDescentCandidate>::const_iterator it=heap.begin(); it!=heap.end(); ++it)
 	{
-		LocalNeighbors local_neighbors = tree.search(i,k+1);
-		std::remove(local_neighbors.begin(),local_neighbors.end(),i-begin);
-		neighbors.push_back(local_neighbors);
+		if (it->index == index)
+			return false;
 	}
+	std::pop_heap(heap.begin(),heap.end());
+	heap.back() = NNDescentCandidate(index,distance);
+	std::push_heap(heap.begin(),heap.end());
+	return true;
+}
 
+//! Approximate neighbors search by NN-descent, see
+//! W. Dong, M. Charikar, K. Li, "Efficient k-nearest neighbor graph
+//! construction for generic similarity measures", WWW 2011.
+//!
+//! Starts from a random graph and repeatedly compares all pairs of
+//! neighbors (and reverse neighbors) of every point, relying on a
+//! neighbor of a neighbor being likely a neighbor. The distances are
+//! computed in parallel over blocks of points, the graph is updated
+//! sequentially in a fixed order, so the result does not depend on
+//! the number of threads.
+template <class RandomAccessIterator, class Callback>
+Neighbors find_neighbors_nndescent_impl(const RandomAccessIterator& begin, const RandomAccessIterator& end,
+                                        Callback callback, IndexType k)
+{
+	timed_context context("NN-descent based approximate neighbors search");
+
+	// stop when less than this fraction of the graph changes
+	const ScalarType delta = 0.001;
+	const IndexType max_iteration = 20;
+	const IndexType block_size = 4096;
+
+	const IndexType n_vectors = end-begin;
+	typedef std::vector<NNDescentCandidate> Heap;
+	std::vector<Heap> heaps(n_vectors);
+
+	// random initial graph
+	for (IndexType i=0; i<n_vectors; ++i)
+	{
+		heaps[i].reserve(k);
+		while (static_cast<IndexType>(heaps[i].size()) < k)
+		{
+			IndexType j = uniform_random_index_bounded(n_vectors);
+			bool duplicate = (j == i);
+			for (typename Heap::const_iterator it=heaps[i].begin(); it!=heaps[i].end() && !duplicate; ++it)
+				duplicate = (it->index == j);
+			if (!duplicate)
+				heaps[i].push_back(NNDescentCandidate(j,0.0));
+		}
+	}
+#pragma omp parallel for
+	for (IndexType i=0; i<n_vectors; ++i)
+	{
+		for (typename Heap::iterator it=heaps[i].begin(); it!=heaps[i].end(); ++it)
+			it->distance = callback.distance(begin+i,begin+it->index);
+		std::make_heap(heaps[i].begin(),heaps[i].end());
+	}
+
+	typedef std::pair<IndexType, ScalarType> Update;
+	for (IndexType iteration=0; iteration<max_iteration; ++iteration)
+	{
+		// new and old neighbors of every point, both directions
+		Neighbors new_neighbors(n_vectors), old_neighbors(n_vectors);
+		Neighbors new_reverse(n_vectors), old_reverse(n_vectors);
+		for (IndexType i=0; i<n_vectors; ++i)
+		{
+			for (typename Heap::iterator it=heaps[i].begin(); it!=heaps[i].end(); ++it)
+			{
+				if (it->is_new)
+				{
+					new_neighbors[i].push_back(it->index);
+					new_reverse[it->index].push_back(i);
+					it->is_new = false;
+				}
+				else
+				{
+					old_neighbors[i].push_back(it->index);
+					old_reverse[it->index].push_back(i);
+				}
+			}
+		}
+		// at most k reverse neighbors are sampled, hubs would
+		// make the local joins quadratic otherwise
+		for (IndexType i=0; i<n_vectors; ++i)
+		{
+			Neighbors* lists[2][2] = {{&new_neighbors,&new_reverse},{&old_neighbors,&old_reverse}};
+			for (int l=0; l<2; ++l)
+			{
+				LocalNeighbors& reverse = (*lists[l][1])[i];
+				LocalNeighbors& forward = (*lists[l][0])[i];
+				const IndexType n_sampled = std::min<IndexType>(k,reverse.size());
+				for (IndexType s=0; s<n_sampled; ++s)
+					std::swap(reverse[s],reverse[s+uniform_random_index_bounded(reverse.size()-s)]);
+				forward.insert(forward.end(),reverse.begin(),reverse.begin()+n_sampled);
+				std::sort(forward.begin(),forward.end());
+				forward.erase(std::unique(forward.begin(),forward.end()),forward.end());
+				LocalNeighbors().swap(reverse);
+			}
+		}
+
+		IndexType n_updates = 0;
+		for (IndexType block_begin=0; block_begin<n_vectors; block_begin+=block_size)
+		{
+			const IndexType block_end = std::min(block_begin+block_size,n_vectors);
+			std::vector< std::vector< std::pair<IndexType,Update> > > updates(block_end-block_begin);
+
+			// local joins, the heaps are only read here
+#pragma omp parallel for schedule(dynamic, 16)
+			for (IndexType i=block_begin; i<block_end; ++i)
+			{
+				const LocalNeighbors& new_i = new_neighbors[i];
+				const LocalNeighbors& old_i = old_neighbors[i];
+				const IndexType n_new = new_i.size();
+				const IndexType n_all = n_new + old_i.size();
+				std::vector< std::pair<IndexType,Update> >& local_updates = updates[i-block_begin];
+				for (IndexType a=0; a<n_new; ++a)
+				{
+					const IndexType u = new_i[a];
+					for (IndexType b=a+1; b<n_all; ++b)
+					{
+						const IndexType v = (b<n_new) ? new_i[b] : old_i[b-n_new];
+						if (u == v)
+							continue;
+						ScalarType d = callback.distance(begin+u,begin+v);
+						if (d < heaps[u].front().distance || d < heaps[v].front().distance)
+							local_updates.push_back(std::make_pair(u,Update(v,d)));
+					}
+				}
+			}
+
+			for (IndexType i=0; i<block_end-block_begin; ++i)
+			{
+				for (typename std::vector< std::pair<IndexType,Update> >::const_iterator it=updates[i].begin();
+						it!=updates[i].end(); ++it)
+				{
+					n_updates += nndescent_update(heaps[it->first],it->second.first,it->second.second);
+					n_updates += nndescent_update(heaps[it->second.first],it->first,it->second.second);
+				}
+			}
+		}
+
+		LoggingSingleton::instance().message_debug(formatting::format("NN-descent iteration {}: {} updates",
+		                                                              iteration,n_updates));
+		if (n_updates <= delta*n_vectors*k)
+			break;
+	}
+
+	Neighbors neighbors(n_vectors);
+#pragma omp parallel for
+	for (IndexType i=0; i<n_vectors; ++i)
+	{
+		std::sort_heap(heaps[i].begin(),heaps[i].end());
+		neighbors[i].reserve(k);
+		for (typename Heap::const_iterator it=heaps[i].begin(); it!=heaps[i].end(); ++it)
+			neighbors[i].push_back(it->index);
+	}
 	return neighbors;
 }
 
@@ -187,6 +374,8 @@ Neighbors find_neighbors(NeighborsMethod method, const RandomAccessIterator& beg
 		neighbors = find_neighbors_bruteforce_impl(begin,end,callback,k);
 	if (method.is(VpTree))
 		neighbors = find_neighbors_vptree_impl(begin,end,callback,k);
+	if (method.is(NNDescent))
+		neighbors = find_neighbors_nndescent_impl(begin,end,callback,k);
 #ifdef TAPKEE_USE_LGPL_COVERTREE
 	if (method.is(CoverTree))
 		neighbors = find_neighbors_covertree_impl(begin,end,callback,k);
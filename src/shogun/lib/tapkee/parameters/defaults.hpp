@@ -28,12 +28,14 @@ const stichwort::ParametersSet defaults = (
 	tapkee::nullspace_shift = stichwort::by_default,
 	tapkee::klle_shift = stichwort::by_default,
 	tapkee::check_connectivity = stichwort::by_default,
+	tapkee::neighbors_cache = stichwort::by_default,
 	tapkee::fa_epsilon = stichwort::by_default,
 	tapkee::progress_function = stichwort::by_default,
 	tapkee::cancel_function = stichwort::by_default,
 	tapkee::sne_perplexity = stichwort::by_default,
 	tapkee::squishing_rate = stichwort::by_default,
-	tapkee::sne_theta = stichwort::by_default);
+	tapkee::sne_theta = stichwort::by_default,
+	tapkee::sne_interpolation = stichwort::by_default);
 }
 
 }
@@ -20,6 +20,8 @@
 #include <shogun/lib/tapkee/defines.hpp>
 /* End of Tapkee includes */
 
+#include <limits>
+
 namespace tapkee
 {
 namespace tapkee_internal
@@ -82,62 +84,95 @@ EigendecompositionResult eigendecomposition_impl_dense(const MatrixType& wm, Ind
 	return EigendecompositionResult();
 }
 
-//! Randomized redsvd-like implementation of eigendecomposition-based embedding
-template <class MatrixType, class MatrixOperationType>
-EigendecompositionResult eigendecomposition_impl_randomized(const MatrixType& wm, IndexType target_dimension, unsigned int skip)
+//! Randomized block Krylov method, see C. Musco, C. Musco, "Randomized
+//! Block Krylov Methods for Stronger and Faster Approximate Singular Value
+//! Decomposition", NIPS 2015.
+//!
+//! Only needs products of the operation with blocks of vectors, so the
+//! matrix is never decomposed (or even formed) as a whole. The Krylov
+//! basis of a random block is orthonormalized block by block, and the
+//! Rayleigh-Ritz values and vectors of the operation on that basis are
+//! returned for the n_wanted largest values, in increasing order.
+template <class MatrixOperationType>
+EigendecompositionResult randomized_block_krylov(MatrixOperationType& operation, IndexType n,
+                                                 IndexType n_wanted)
 {
-	timed_context context("Randomized eigendecomposition");
+	const IndexType oversampling = 10;
+	const IndexType max_depth = 4;
+
+	const IndexType block = std::min(n, n_wanted+oversampling);
+	const IndexType depth = std::max<IndexType>(1, std::min(max_depth, n/block));
+	const IndexType n_basis = block*depth;
 
-	DenseMatrix O(wm.rows(), target_dimension+skip);
-	for (IndexType i=0; i<O.rows(); ++i)
+	DenseMatrix basis(n, n_basis);
+	DenseMatrix products(n, n_basis);
+	DenseMatrix current(n, block);
+	for (IndexType i=0; i<n; ++i)
 	{
-		for (IndexType j=0; j<O.cols(); j++)
-		{
-			O(i,j) = tapkee::gaussian_random();
-		}
+		for (IndexType j=0; j<block; ++j)
+			current(i,j) = tapkee::gaussian_random();
 	}
-	MatrixOperationType operation(wm);
 
-	DenseMatrix Y = operation(O);
-	for (IndexType i=0; i<Y.cols(); i++)
+	for (IndexType d=0; d<depth; ++d)
 	{
-		for (IndexType j=0; j<i; j++)
-		{
-			ScalarType r = Y.col(i).dot(Y.col(j));
-			Y.col(i) -= r*Y.col(j);
-		}
-		ScalarType norm = Y.col(i).norm();
-		if (norm < 1e-4)
+		// twice is enough to orthogonalize against the previous blocks
+		if (d > 0)
 		{
-			for (int k = i; k<Y.cols(); k++)
-				Y.col(k).setZero();
+			for (int pass=0; pass<2; ++pass)
+				current -= basis.leftCols(d*block)*(basis.leftCols(d*block).transpose()*current);
 		}
-		Y.col(i) *= (1.f / norm);
+		Eigen::HouseholderQR<DenseMatrix> qr(current);
+		basis.middleCols(d*block,block) = qr.householderQ()*DenseMatrix::Identity(n,block);
+		current = operation(basis.middleCols(d*block,block));
+		products.middleCols(d*block,block) = current;
 	}
 
-	DenseMatrix B1 = operation(Y);
-	DenseMatrix B = Y.householderQr().solve(B1);
-	DenseSelfAdjointEigenSolver eigenOfB(B);
+	// The basis might be rank deficient if the Krylov space was exhausted,
+	// the Rayleigh-Ritz problem is restricted to its well conditioned part
+	DenseSelfAdjointEigenSolver gram(basis.transpose()*basis);
+	const ScalarType threshold = gram.eigenvalues().maxCoeff()*n_basis*std::numeric_limits<ScalarType>::epsilon();
+	IndexType rank = 0;
+	while (rank < n_basis && gram.eigenvalues()(n_basis-rank-1) > threshold)
+		++rank;
+	DenseMatrix transform = gram.eigenvectors().rightCols(rank)*
+		gram.eigenvalues().tail(rank).cwiseSqrt().cwiseInverse().asDiagonal();
+
+	DenseMatrix projected = transform.transpose()*(basis.transpose()*products)*transform;
+	projected = 0.5*(projected+projected.transpose()).eval();
+	DenseSelfAdjointEigenSolver ritz(projected);
+	if (ritz.info() != Eigen::Success)
+		throw eigendecomposition_error("eigendecomposition failed");
+
+	const IndexType n_found = std::min(n_wanted, rank);
+	DenseMatrix vectors = basis*(transform*ritz.eigenvectors().rightCols(n_found));
+	return EigendecompositionResult(vectors, ritz.eigenvalues().tail(n_found));
+}
 
-	if (eigenOfB.info() == Eigen::Success)
+//! Randomized implementation of eigendecomposition-based embedding. Smallest
+//! eigenvalues are found as the largest ones of the inverse matrix.
+template <class MatrixType, class MatrixOperationType>
+EigendecompositionResult eigendecomposition_impl_randomized(const MatrixType& wm, IndexType target_dimension, unsigned int skip)
+{
+	timed_context context("Randomized eigendecomposition");
+
+	MatrixOperationType operation(wm);
+	EigendecompositionResult ritz = randomized_block_krylov(operation, wm.rows(), target_dimension+skip);
+	// a Krylov space of low numerical rank yields fewer Ritz pairs than asked
+	if (ritz.second.size() < static_cast<IndexType>(target_dimension+skip))
+		throw eigendecomposition_error("matrix has lower numerical rank than the number of requested eigenvectors");
+
+	if (MatrixOperationType::largest)
 	{
-		if (MatrixOperationType::largest)
-		{
-			assert(skip==0);
-			DenseMatrix selected_eigenvectors = (Y*eigenOfB.eigenvectors()).rightCols(target_dimension);
-			return EigendecompositionResult(selected_eigenvectors,eigenOfB.eigenvalues());
-		}
-		else
-		{
-			DenseMatrix selected_eigenvectors = (Y*eigenOfB.eigenvectors()).leftCols(target_dimension+skip).rightCols(target_dimension);
-			return EigendecompositionResult(selected_eigenvectors,eigenOfB.eigenvalues());
-		}
+		assert(skip==0);
+		return ritz;
 	}
 	else
 	{
-		throw eigendecomposition_error("eigendecomposition failed");
+		// largest eigenvalues of the inverse, in decreasing order
+		DenseMatrix selected_eigenvectors = ritz.first.rowwise().reverse().rightCols(target_dimension);
+		DenseVector selected_eigenvalues = ritz.second.reverse().tail(target_dimension).cwiseInverse();
+		return EigendecompositionResult(selected_eigenvectors,selected_eigenvalues);
 	}
-	return EigendecompositionResult();
 }
 
 template <typename MatrixType>
@@ -11,6 +11,7 @@
 	#include <shogun/lib/tapkee/utils/arpack_wrapper.hpp>
 #endif
 #include <shogun/lib/tapkee/routines/matrix_operations.hpp>
+#include <shogun/lib/tapkee/routines/eigendecomposition.hpp>
 /* End of Tapkee includes */
 
 namespace tapkee
@@ -76,6 +77,31 @@ EigendecompositionResult generalized_eigendecomposition_impl_dense(const LMatrix
 	return EigendecompositionResult();
 }
 
+//! Randomized implementation of the Laplacian eigenproblem L x = lambda D x
+//! with diagonal D, solved as the standard eigenproblem of the normalized
+//! Laplacian D^{-1/2} L D^{-1/2}. The normalized Laplacian stays sparse
+//! while the other methods densify it.
+inline EigendecompositionResult generalized_eigendecomposition_impl_randomized(const SparseWeightMatrix& lhs,
+		const DenseDiagonalMatrix& rhs, IndexType target_dimension, unsigned int skip)
+{
+	timed_context context("Randomized generalized eigendecomposition");
+
+	// the Laplacian is singular, a small shift makes it factorizable
+	const ScalarType shift = 1e-6;
+
+	DenseVector inverse_sqrt_degrees = rhs.diagonal().cwiseSqrt().cwiseInverse();
+	SparseWeightMatrix normalized = inverse_sqrt_degrees.asDiagonal()*lhs*inverse_sqrt_degrees.asDiagonal();
+	for (IndexType i=0; i<normalized.rows(); ++i)
+		normalized.coeffRef(i,i) += shift;
+
+	EigendecompositionResult result =
+		eigendecomposition_impl_randomized<SparseWeightMatrix,SparseInverseMatrixOperation>
+		(normalized,target_dimension,skip);
+	result.first = inverse_sqrt_degrees.asDiagonal()*result.first;
+	result.second.array() -= shift;
+	return result;
+}
+
 template <typename LMatrixType, typename RMatrixType>
 struct generalized_eigendecomposition_impl
 {
@@ -89,6 +115,10 @@ struct generalized_eigendecomposition_impl
                                    const ComputationStrategy& strategy,
                                    const EigendecompositionStrategy& eigen_strategy,
                                    IndexType target_dimension);
+	EigendecompositionResult randomized(const LMatrixType& lhs, const RMatrixType& rhs,
+                                        const ComputationStrategy& strategy,
+                                        const EigendecompositionStrategy& eigen_strategy,
+                                        IndexType target_dimension);
 };
 
 template <>
@@ -128,6 +158,21 @@ struct generalized_eigendecomposition_impl<SparseWeightMatrix, DenseDiagonalMatr
 		unsupported();
 		return EigendecompositionResult();
 	}
+	EigendecompositionResult randomized(const SparseWeightMatrix& lhs, const DenseDiagonalMatrix& rhs,
+                                        const ComputationStrategy& strategy,
+                                        const EigendecompositionStrategy& eigen_strategy,
+                                        IndexType target_dimension)
+	{
+		if (strategy.is(HomogeneousCPUStrategy))
+		{
+			if (eigen_strategy.is(SmallestEigenvalues))
+				return generalized_eigendecomposition_impl_randomized
+					(lhs,rhs,target_dimension,eigen_strategy.skip());
+			unsupported();
+		}
+		unsupported();
+		return EigendecompositionResult();
+	}
 	inline void unsupported() const
 	{
 		throw unsupported_method_error("Unsupported method");
@@ -171,6 +216,15 @@ struct generalized_eigendecomposition_impl<DenseMatrix, DenseMatrix>
 		unsupported();
 		return EigendecompositionResult();
 	}
+	//! The matrices are as large as the dimension of the features,
+	//! so they are decomposed densely
+	EigendecompositionResult randomized(const DenseMatrix& lhs, const DenseMatrix& rhs,
+                                        const ComputationStrategy& strategy,
+                                        const EigendecompositionStrategy& eigen_strategy,
+                                        IndexType target_dimension)
+	{
+		return dense(lhs, rhs, strategy, eigen_strategy, target_dimension);
+	}
 	inline void unsupported() const
 	{
 		throw unsupported_method_error("Unsupported method");
@@ -193,7 +247,8 @@ EigendecompositionResult generalized_eigendecomposition(const EigenMethod& metho
 		return generalized_eigendecomposition_impl<LMatrixType, RMatrixType>()
 			.dense(lhs, rhs, strategy, eigen_strategy, target_dimension);
 	if (method.is(Randomized))
-		throw unsupported_method_error("Randomized method is not supported for generalized eigenproblems");
+		return generalized_eigendecomposition_impl<LMatrixType, RMatrixType>()
+			.randomized(lhs, rhs, strategy, eigen_strategy, target_dimension);
 	return EigendecompositionResult();
 }
 
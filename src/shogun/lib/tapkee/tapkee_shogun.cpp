@@ -82,11 +82,33 @@ CDenseFeatures<float64_t>* shogun::tapkee_embed(const shogun::TAPKEE_PARAMETERS_
 #else
 	tapkee::EigenMethod eigen_method = tapkee::Dense;
 #endif
+	switch (parameters.eigen_method)
+	{
+		case EMBEDDING_EIGEN_AUTO:
+			break;
+		case EMBEDDING_EIGEN_DENSE:
+			eigen_method = tapkee::Dense;
+			break;
+		case EMBEDDING_EIGEN_RANDOMIZED:
+			eigen_method = tapkee::Randomized;
+			break;
+	}
 #ifdef TAPKEE_USE_LGPL_COVERTREE
 	tapkee::NeighborsMethod neighbors_method = tapkee::CoverTree;
 #else
 	tapkee::NeighborsMethod neighbors_method = tapkee::VpTree;
 #endif
+	switch (parameters.neighbors_method)
+	{
+		case NEIGHBORS_EXACT:
+			break;
+		case NEIGHBORS_BRUTE_FORCE:
+			neighbors_method = tapkee::Brute;
+			break;
+		case NEIGHBORS_NN_DESCENT:
+			neighbors_method = tapkee::NNDescent;
+			break;
+	}
 	size_t N = 0;
 
 	switch (parameters.method)
@@ -162,6 +184,15 @@ CDenseFeatures<float64_t>* shogun::tapkee_embed(const shogun::TAPKEE_PARAMETERS_
 	for (size_t i=0; i<N; i++)
 		indices[i] = i;
 
+	tapkee::tapkee_internal::Neighbors neighbors;
+	if (parameters.neighbors)
+	{
+		const SGMatrix<index_t>& graph = *parameters.neighbors;
+		neighbors.resize(graph.num_cols);
+		for (index_t i=0; i<graph.num_cols; i++)
+			neighbors[i].assign(graph.get_column_vector(i), graph.get_column_vector(i)+graph.num_rows);
+	}
+
 	tapkee::ParametersSet parameters_set =
 		(tapkee::method=method,
 		 tapkee::eigen_method=eigen_method,
@@ -179,7 +210,9 @@ CDenseFeatures<float64_t>* shogun::tapkee_embed(const shogun::TAPKEE_PARAMETERS_
 		 tapkee::fa_epsilon = parameters.fa_epsilon,
 		 tapkee::sne_perplexity = parameters.sne_perplexity,
 		 tapkee::sne_theta = parameters.sne_theta,
-		 tapkee::squishing_rate = parameters.squishing_rate
+		 tapkee::sne_interpolation = parameters.sne_interpolation,
+		 tapkee::squishing_rate = parameters.squishing_rate,
+		 tapkee::neighbors_cache = parameters.neighbors ? &neighbors : NULL
 		 );
 
 	tapkee::TapkeeOutput output = tapkee::embed(indices.begin(),indices.end(),
@@ -188,6 +221,14 @@ CDenseFeatures<float64_t>* shogun::tapkee_embed(const shogun::TAPKEE_PARAMETERS_
 	// destroy projecting function
 	output.projection.clear();
 
+	if (parameters.neighbors && !neighbors.empty())
+	{
+		SGMatrix<index_t> graph(neighbors[0].size(), N);
+		for (size_t i=0; i<N; i++)
+			std::copy(neighbors[i].begin(), neighbors[i].end(), graph.get_column_vector(i));
+		*parameters.neighbors = graph;
+	}
+
 	SGMatrix<float64_t> feature_matrix(parameters.target_dimension,N);
 	// TODO avoid copying
 	for (uint32_t i=0; i<N; i++)
@@ -200,3 +241,33 @@ CDenseFeatures<float64_t>* shogun::tapkee_embed(const shogun::TAPKEE_PARAMETERS_
 	return new CDenseFeatures<float64_t>(feature_matrix);
 }
 
+/* adapts a shogun block product to the operation of the Krylov method */
+struct ShogunBlockOperation
+{
+	std::function<void(SGMatrix<float64_t>, SGMatrix<float64_t>)> operation;
+
+	tapkee::DenseMatrix operator()(const tapkee::DenseMatrix& block)
+	{
+		tapkee::DenseMatrix rhs = block;
+		tapkee::DenseMatrix result(rhs.rows(), rhs.cols());
+		operation(SGMatrix<float64_t>(rhs.data(), rhs.rows(), rhs.cols(), false),
+				SGMatrix<float64_t>(result.data(), result.rows(), result.cols(), false));
+		return result;
+	}
+};
+
+void shogun::tapkee_randomized_eigenpairs(
+		std::function<void(SGMatrix<float64_t>, SGMatrix<float64_t>)> operation,
+		index_t n, index_t n_wanted, SGVector<float64_t>& eigenvalues,
+		SGMatrix<float64_t>& eigenvectors)
+{
+	ShogunBlockOperation block_operation = {operation};
+	tapkee::tapkee_internal::EigendecompositionResult ritz =
+		tapkee::tapkee_internal::randomized_block_krylov(block_operation, n, n_wanted);
+
+	const index_t n_found = ritz.second.size();
+	eigenvalues = SGVector<float64_t>(n_found);
+	eigenvectors = SGMatrix<float64_t>(n, n_found);
+	std::copy(ritz.second.data(), ritz.second.data()+n_found, eigenvalues.vector);
+	std::copy(ritz.first.data(), ritz.first.data()+int64_t(n)*n_found, eigenvectors.matrix);
+}
@@ -13,6 +13,9 @@
 #include <shogun/kernel/Kernel.h>
 #include <shogun/distance/Distance.h>
 #include <shogun/features/DenseFeatures.h>
+#include <shogun/converter/EmbeddingConverter.h>
+
+#include <functional>
 
 using namespace shogun;
 
@@ -50,7 +53,9 @@ struct TAPKEE_PARAMETERS_FOR_SHOGUN
 		gaussian_kernel_width(1.0), spe_tolerance(1e-5),
 		spe_global_strategy(false), max_iteration(100),
 		fa_epsilon(1e-5), sne_theta(0.5),
-		sne_perplexity(30.0), squishing_rate(0.99),
+		sne_perplexity(30.0), sne_interpolation(false), squishing_rate(0.99),
+		neighbors_method(NEIGHBORS_EXACT), neighbors(NULL),
+		eigen_method(EMBEDDING_EIGEN_AUTO),
 		kernel(NULL), distance(NULL), features(NULL)
 	{
 	}
@@ -68,13 +73,36 @@ struct TAPKEE_PARAMETERS_FOR_SHOGUN
 	float64_t fa_epsilon;
 	float64_t sne_theta;
 	float64_t sne_perplexity;
+	bool sne_interpolation;
 	float64_t squishing_rate;
+	ENeighborsMethod neighbors_method;
+	/** neighbors graph shared between embeddings, used if it fits and
+	 * replaced with the computed one otherwise, may be NULL */
+	SGMatrix<index_t>* neighbors;
+	EEmbeddingEigenMethod eigen_method;
 	CKernel* kernel;
 	CDistance* distance;
 	CDotFeatures* features;
 };
 
 CDenseFeatures<float64_t>* tapkee_embed(const TAPKEE_PARAMETERS_FOR_SHOGUN& parameters);
+
+/** Largest eigenpairs of a symmetric operator with the randomized block
+ * Krylov method of tapkee, the operator is only used through products with
+ * blocks of vectors.
+ *
+ * @param operation computes the product of the operator with a block of
+ *        vectors (first argument) into a matrix of the same size
+ * @param n size of the operator
+ * @param n_wanted number of wanted eigenpairs
+ * @param eigenvalues eigenvalues in increasing order, fewer than n_wanted if
+ *        the Krylov basis has a lower rank
+ * @param eigenvectors eigenvectors as columns
+ */
+void tapkee_randomized_eigenpairs(
+		std::function<void(SGMatrix<float64_t>, SGMatrix<float64_t>)> operation,
+		index_t n, index_t n_wanted, SGVector<float64_t>& eigenvalues,
+		SGMatrix<float64_t>& eigenvectors);
 }
 
 #endif
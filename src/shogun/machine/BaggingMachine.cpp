@@ -9,10 +9,13 @@
 #include <shogun/ensemble/CombinationRule.h>
 #include <shogun/ensemble/MeanRule.h>
 #include <shogun/machine/BaggingMachine.h>
+#include <shogun/mathematics/RandomStream.h>
 #include <shogun/mathematics/linalg/LinalgNamespace.h>
 
 #include <shogun/evaluation/Evaluation.h>
 
+#include <vector>
+
 using namespace shogun;
 
 CBaggingMachine::CBaggingMachine()
@@ -174,9 +177,11 @@ bool CBaggingMachine::train_machine(CFeatures* data)
 	SG_UNREF(m_oob_indices);
 	m_oob_indices = new CDynamicObjectArray();
 
-	SGMatrix<index_t> rnd_indicies(m_bag_size, m_num_bags);
-	for (index_t i = 0; i < m_num_bags*m_bag_size; ++i)
-		rnd_indicies.matrix[i] = CMath::random(0, m_bag_size-1);
+	// every bag draws its bootstrap sample and the randomness of its machine
+	// from its own stream, so the bags do not depend on the thread schedule
+	const uint64_t seed=CMath::random();
+	std::vector<CMachine*> bags(m_num_bags);
+	std::vector<CDynamicArray<index_t>*> oob_indices(m_num_bags);
 
 	auto pb = SG_PROGRESS(range(m_num_bags));
 #pragma omp parallel for
@@ -184,7 +189,11 @@ bool CBaggingMachine::train_machine(CFeatures* data)
 	{
 		CMachine* c=dynamic_cast<CMachine*>(m_machine->clone());
 		ASSERT(c != NULL);
-		SGVector<index_t> idx(rnd_indicies.get_column_vector(i), m_bag_size, false);
+
+		RandomStream stream(seed, i);
+		SGVector<index_t> idx(m_bag_size);
+		for (index_t j = 0; j < m_bag_size; ++j)
+			idx[j] = stream.random(0, m_bag_size-1);
 
 		CFeatures* features;
 		CLabels* labels;
@@ -218,21 +227,16 @@ bool CBaggingMachine::train_machine(CFeatures* data)
 		}
 		*/
 		features->add_subset(idx);
-		set_machine_parameters(c,idx);
+		set_machine_parameters(c, idx, stream.split(0));
 		c->set_labels(labels);
 		c->train(features);
 		features->remove_subset();
 		labels->remove_subset();
 
-		#pragma omp critical
-		{
-		// get out of bag indexes
-		CDynamicArray<index_t>* oob = get_oob_indices(idx);
-		m_oob_indices->push_back(oob);
-
-		// add trained machine to bag array
-		m_bags->push_back(c);
-		}
+		// get out of bag indexes, the bags are stored in the order of the
+		// streams below
+		oob_indices[i] = get_oob_indices(idx);
+		bags[i] = c;
 
 		if (get_global_parallel()->get_num_threads()!=1)
 		{
@@ -240,15 +244,22 @@ bool CBaggingMachine::train_machine(CFeatures* data)
 			SG_UNREF(labels);
 		}
 
-		SG_UNREF(c);
 		pb.print_progress();
 	}
+	for (int32_t i = 0; i < m_num_bags; ++i)
+	{
+		m_oob_indices->push_back(oob_indices[i]);
+		// add trained machine to bag array
+		m_bags->push_back(bags[i]);
+		SG_UNREF(bags[i]);
+	}
 	pb.complete();
 
 	return true;
 }
 
-void CBaggingMachine::set_machine_parameters(CMachine* m, SGVector<index_t> idx)
+void CBaggingMachine::set_machine_parameters(
+    CMachine* m, SGVector<index_t> idx, const RandomStream& stream)
 {
 }
 
@@ -17,6 +17,7 @@ namespace shogun
 {
 	class CCombinationRule;
 	class CEvaluation;
+	class RandomStream;
 
 	/**
 	 * @brief: Bagging algorithm
@@ -126,8 +127,10 @@ namespace shogun
 			 *
 			 * @param m machine
 			 * @param idx indices of training vectors chosen in current bag
+			 * @param stream random stream of the current bag
 			 */
-			virtual void set_machine_parameters(CMachine* m, SGVector<index_t> idx);
+			virtual void set_machine_parameters(
+			    CMachine* m, SGVector<index_t> idx, const RandomStream& stream);
 
 			/** helper function for the apply_{regression,..} functions that
 			 * computes the output
@@ -8,6 +8,7 @@
 
 #include <shogun/machine/OnlineLinearMachine.h>
 #include <shogun/base/Parameter.h>
+#include <shogun/features/streaming/StreamingDenseFeatures.h>
 #include <shogun/labels/RegressionLabels.h>
 #include <shogun/mathematics/Math.h>
 #include <shogun/mathematics/linalg/LinalgNamespace.h>
@@ -16,6 +17,30 @@
 
 using namespace shogun;
 
+namespace
+{
+/* number of examples that are fetched and applied to at once */
+const index_t APPLY_BATCH_SIZE=1024;
+
+/* one matrix-vector product per batch of dense examples instead of a
+ * dense_dot() per example */
+template <class T>
+void apply_dense_batches(CStreamingDenseFeatures<T>* features,
+		const SGVector<T>& w, float64_t bias, std::vector<float64_t>& outputs)
+{
+	while (true)
+	{
+		SGMatrix<T> batch=features->get_next_batch(APPLY_BATCH_SIZE);
+		if (!batch.num_cols)
+			break;
+
+		SGVector<T> batch_outputs=linalg::matrix_prod(batch, w, true);
+		for (index_t i=0; i<batch_outputs.vlen; i++)
+			outputs.push_back(batch_outputs[i]+bias);
+	}
+}
+}
+
 COnlineLinearMachine::COnlineLinearMachine()
 : CMachine(), bias(0), features(NULL)
 {
@@ -57,12 +82,33 @@ SGVector<float64_t> COnlineLinearMachine::apply_get_outputs(CFeatures* data)
 
 	std::vector<float64_t> labels;
 	features->start_parser();
-	while (features->get_next_example())
+	if (features->get_feature_class()==C_STREAMING_DENSE &&
+		features->get_feature_type()==F_SHORTREAL)
+	{
+		apply_dense_batches(
+			features->as<CStreamingDenseFeatures<float32_t>>(), m_w, bias,
+			labels);
+	}
+	else if (features->get_feature_class()==C_STREAMING_DENSE &&
+		features->get_feature_type()==F_DREAL)
 	{
-		float64_t current_lab=features->dense_dot(m_w.vector, m_w.vlen) + bias;
+		SGVector<float64_t> w(m_w.vlen);
+		for (index_t i=0; i<m_w.vlen; i++)
+			w[i]=m_w[i];
 
-		labels.push_back(current_lab);
-		features->release_example();
+		apply_dense_batches(
+			features->as<CStreamingDenseFeatures<float64_t>>(), w, bias,
+			labels);
+	}
+	else
+	{
+		while (features->get_next_example())
+		{
+			float64_t current_lab=features->dense_dot(m_w.vector, m_w.vlen) + bias;
+
+			labels.push_back(current_lab);
+			features->release_example();
+		}
 	}
 	features->end_parser();
 
@@ -139,7 +139,8 @@ int32_t CRandomForest::get_num_random_features() const
 	return dynamic_cast<CRandomCARTree*>(m_machine)->get_feature_subset_size();
 }
 
-void CRandomForest::set_machine_parameters(CMachine* m, SGVector<index_t> idx)
+void CRandomForest::set_machine_parameters(
+    CMachine* m, SGVector<index_t> idx, const RandomStream& stream)
 {
 	REQUIRE(m,"Machine supplied is NULL\n")
 	REQUIRE(m_machine,"Reference Machine is NULL\n")
@@ -160,6 +161,7 @@ void CRandomForest::set_machine_parameters(CMachine* m, SGVector<index_t> idx)
 
 	tree->set_weights(weights);
 	tree->set_sorted_features(m_sorted_transposed_feats, m_sorted_indices);
+	tree->set_random_stream(stream);
 	// equate the machine problem types - cloning does not do this
 	tree->set_machine_problem_type(dynamic_cast<CRandomCARTree*>(m_machine)->get_machine_problem_type());
 }
@@ -141,12 +141,15 @@ public:
 protected:
 
 	virtual bool train_machine(CFeatures* data=NULL);
-	/** sets parameters of CARTree - sets machine labels and weights here
+	/** sets parameters of CARTree - sets machine labels, weights and the
+	 * stream of the feature subsets here
 	 *
 	 * @param m machine
 	 * @param idx indices of training vectors chosen in current bag
+	 * @param stream random stream of the current bag
 	 */
-	virtual void set_machine_parameters(CMachine* m, SGVector<index_t> idx);
+	virtual void set_machine_parameters(
+	    CMachine* m, SGVector<index_t> idx, const RandomStream& stream);
 
 private:
 	/** initialize parameters */
@@ -0,0 +1,113 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: agent
+ */
+
+#include <shogun/mathematics/RandomStream.h>
+#include <shogun/io/SGIO.h>
+
+#include <bitset>
+#include <cmath>
+
+using namespace shogun;
+
+/* 2^64 divided by the golden ratio, the increment of the seeding sequence */
+static const uint64_t GOLDEN_GAMMA=0x9e3779b97f4a7c15ULL;
+
+RandomStream::RandomStream(uint64_t seed, uint64_t stream_id)
+{
+	/* the stream is what a SplitMix64 generator seeded with seed would hand
+	 * out as its stream_id-th child, without drawing all previous ones */
+	m_state=mix(seed+(2*stream_id+1)*GOLDEN_GAMMA);
+	m_increment=mix_increment(seed+(2*stream_id+2)*GOLDEN_GAMMA);
+	m_key=mix(m_state^m_increment);
+}
+
+RandomStream RandomStream::split(uint64_t stream_id) const
+{
+	return RandomStream(m_key, stream_id);
+}
+
+uint64_t RandomStream::mix_increment(uint64_t z)
+{
+	z=(z^(z>>33))*0xff51afd7ed558ccdULL;
+	z=(z^(z>>33))*0xc4ceb9fe1a85ec53ULL;
+	z=(z^(z>>33))|1ULL;
+
+	/* avoid increments with long runs of equal bits */
+	if (std::bitset<64>(z^(z>>1)).count()<24)
+		z^=0xaaaaaaaaaaaaaaaaULL;
+
+	return z;
+}
+
+index_t RandomStream::random(index_t min_value, index_t max_value)
+{
+	REQUIRE(min_value<=max_value, "Lower bound (%d) exceeds upper bound (%d).\n",
+			min_value, max_value);
+
+	const uint64_t range=uint64_t(int64_t(max_value)-min_value)+1;
+	/* reject the lowest 2^64 mod range outputs, so the modulo is unbiased */
+	const uint64_t threshold=(0-range)%range;
+	uint64_t r;
+	do
+	{
+		r=random_64();
+	} while (r<threshold);
+
+	return index_t(min_value+int64_t(r%range));
+}
+
+float64_t RandomStream::std_normal_distrib()
+{
+	const float64_t u1=random_open();
+	const float64_t u2=random_half_open();
+	return std::sqrt(-2.0*std::log(u1))*std::cos(2.0*M_PI*u2);
+}
+
+void RandomStream::fill_array(uint64_t* array, index_t size)
+{
+	const uint64_t state=m_state;
+	const uint64_t increment=m_increment;
+
+	#pragma omp simd
+	for (index_t i=0; i<size; ++i)
+		array[i]=mix(state+uint64_t(i+1)*increment);
+
+	m_state+=uint64_t(size)*increment;
+}
+
+void RandomStream::fill_array_co(float64_t* array, index_t size)
+{
+	const uint64_t state=m_state;
+	const uint64_t increment=m_increment;
+
+	#pragma omp simd
+	for (index_t i=0; i<size; ++i)
+		array[i]=to_half_open(mix(state+uint64_t(i+1)*increment));
+
+	m_state+=uint64_t(size)*increment;
+}
+
+void RandomStream::fill_array_normal(float64_t* array, index_t size,
+		float64_t mu, float64_t sigma)
+{
+	const uint64_t state=m_state;
+	const uint64_t increment=m_increment;
+	const index_t num_pairs=size/2;
+
+	#pragma omp simd
+	for (index_t i=0; i<num_pairs; ++i)
+	{
+		const float64_t u1=to_open(mix(state+uint64_t(2*i+1)*increment));
+		const float64_t u2=to_half_open(mix(state+uint64_t(2*i+2)*increment));
+		const float64_t r=sigma*std::sqrt(-2.0*std::log(u1));
+		array[2*i]=mu+r*std::cos(2.0*M_PI*u2);
+		array[2*i+1]=mu+r*std::sin(2.0*M_PI*u2);
+	}
+	m_state+=uint64_t(2*num_pairs)*increment;
+
+	if (size%2)
+		array[size-1]=normal_distrib(mu, sigma);
+}
@@ -0,0 +1,215 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: agent
+ */
+
+#ifndef __RANDOMSTREAM_H__
+#define __RANDOMSTREAM_H__
+
+#include <shogun/lib/config.h>
+
+#include <shogun/lib/common.h>
+#include <shogun/lib/SGVector.h>
+
+#include <limits>
+
+namespace shogun
+{
+
+/** @brief Splittable pseudo random number stream.
+ *
+ * Counter based SplitMix64 generator: the state is advanced by a constant
+ * odd increment and every output is a bijective mix of the state. A stream
+ * is fully determined by a (seed, stream id) pair, so parallel code can give
+ * every task its own stream, e.g. RandomStream(seed, task_index), and the
+ * drawn numbers do not depend on the number of threads or on the order in
+ * which the tasks are scheduled.
+ *
+ * Unlike CRandom, a stream has no lock and is not shared: each thread or
+ * task owns its stream (usually on the stack). The k-th output of a stream
+ * can be computed without the previous ones, which is what makes the bulk
+ * fill methods vectorizable.
+ *
+ * Models the standard UniformRandomBitGenerator concept, so it can be
+ * passed to the <random> distributions.
+ */
+class RandomStream
+{
+	public:
+		/** type of the raw output */
+		typedef uint64_t result_type;
+
+		/** ctor
+		 *
+		 * @param seed seed, e.g. drawn once from the global generator
+		 * @param stream_id index of the stream, e.g. the task index
+		 */
+		RandomStream(uint64_t seed=0, uint64_t stream_id=0);
+
+		/** Child stream of this stream. Children with different ids are
+		 * independent of each other and of the parent, and do not depend
+		 * on how many numbers were drawn from the parent.
+		 *
+		 * @param stream_id index of the child stream
+		 * @return child stream
+		 */
+		RandomStream split(uint64_t stream_id) const;
+
+		/** @return smallest raw output */
+		static constexpr result_type min()
+		{
+			return 0;
+		}
+
+		/** @return largest raw output */
+		static constexpr result_type max()
+		{
+			return std::numeric_limits<result_type>::max();
+		}
+
+		/** @return next raw output */
+		inline result_type operator()()
+		{
+			return random_64();
+		}
+
+		/** @return unsigned 64-bit random integer */
+		inline uint64_t random_64()
+		{
+			m_state+=m_increment;
+			return mix(m_state);
+		}
+
+		/** @return unsigned 32-bit random integer */
+		inline uint32_t random_32()
+		{
+			return uint32_t(random_64()>>32);
+		}
+
+		/** @return random number in [0, 1) */
+		inline float64_t random_half_open()
+		{
+			return to_half_open(random_64());
+		}
+
+		/** @return random number in (0, 1) */
+		inline float64_t random_open()
+		{
+			return to_open(random_64());
+		}
+
+		/** Uniform integer in the closed interval [min_value, max_value]
+		 *
+		 * @param min_value lower bound
+		 * @param max_value upper bound
+		 * @return random integer
+		 */
+		index_t random(index_t min_value, index_t max_value);
+
+		/** Uniform number in [min_value, max_value)
+		 *
+		 * @param min_value lower bound
+		 * @param max_value upper bound
+		 * @return random number
+		 */
+		inline float64_t random(float64_t min_value, float64_t max_value)
+		{
+			return min_value+(max_value-min_value)*random_half_open();
+		}
+
+		/** @return sample from the standard normal distribution */
+		float64_t std_normal_distrib();
+
+		/** Sample from a normal distribution
+		 *
+		 * @param mu mean
+		 * @param sigma standard deviation
+		 * @return sample
+		 */
+		inline float64_t normal_distrib(float64_t mu, float64_t sigma)
+		{
+			return mu+sigma*std_normal_distrib();
+		}
+
+		/** Fill an array with random numbers in [0, 1). Gives the same
+		 * numbers as size calls of random_half_open().
+		 *
+		 * @param array array to fill
+		 * @param size number of elements
+		 */
+		void fill_array_co(float64_t* array, index_t size);
+
+		/** Fill an array with raw 64-bit outputs. Gives the same numbers as
+		 * size calls of random_64().
+		 *
+		 * @param array array to fill
+		 * @param size number of elements
+		 */
+		void fill_array(uint64_t* array, index_t size);
+
+		/** Fill an array with normal samples. Both Box-Muller outputs are
+		 * used, so the numbers differ from size calls of normal_distrib().
+		 *
+		 * @param array array to fill
+		 * @param size number of elements
+		 * @param mu mean
+		 * @param sigma standard deviation
+		 */
+		void fill_array_normal(float64_t* array, index_t size,
+				float64_t mu=0.0, float64_t sigma=1.0);
+
+		/** Fisher-Yates shuffle. The permutation only depends on the stream,
+		 * not on the standard library implementation.
+		 *
+		 * @param v vector to permute in place
+		 */
+		template <class T>
+		void permute(SGVector<T> v)
+		{
+			for (index_t i=v.vlen-1; i>0; --i)
+			{
+				index_t j=random(0, i);
+				T tmp=v[i];
+				v[i]=v[j];
+				v[j]=tmp;
+			}
+		}
+
+	private:
+		/** SplitMix64 output function */
+		static inline uint64_t mix(uint64_t z)
+		{
+			z=(z^(z>>30))*0xbf58476d1ce4e5b9ULL;
+			z=(z^(z>>27))*0x94d049bb133111ebULL;
+			return z^(z>>31);
+		}
+
+		/** @return uniform number in [0, 1) from the upper 53 bits */
+		static inline float64_t to_half_open(uint64_t z)
+		{
+			return (z>>11)*(1.0/9007199254740992.0);
+		}
+
+		/** @return uniform number in (0, 1) from the upper 52 bits */
+		static inline float64_t to_open(uint64_t z)
+		{
+			return ((z>>12)+0.5)*(1.0/4503599627370496.0);
+		}
+
+		/** @return odd increment with well spread bits */
+		static uint64_t mix_increment(uint64_t z);
+
+		/** current counter */
+		uint64_t m_state;
+
+		/** odd increment of the counter */
+		uint64_t m_increment;
+
+		/** key from which child streams are derived */
+		uint64_t m_key;
+};
+
+}
+
+#endif // __RANDOMSTREAM_H__
@@ -14,6 +14,7 @@
 #include <shogun/lib/external/cdflib.hpp>
 #include <shogun/mathematics/Math.h>
 #include <shogun/mathematics/Statistics.h>
+#include <shogun/mathematics/StatisticsAccumulator.h>
 #include <shogun/mathematics/eigen3.h>
 #include <shogun/mathematics/linalg/LinalgNamespace.h>
 
@@ -46,31 +47,20 @@ SGVector<float64_t> CStatistics::matrix_mean(SGMatrix<float64_t> values,
 	ASSERT(values.num_cols>0)
 	ASSERT(values.matrix)
 
-	SGVector<float64_t> result;
-
-	if (col_wise)
+	if (!col_wise)
 	{
-		result=SGVector<float64_t>(values.num_cols);
-		for (index_t j=0; j<values.num_cols; ++j)
-		{
-			result[j]=0;
-			for (index_t i=0; i<values.num_rows; ++i)
-				result[j]+=values(i,j);
-
-			result[j]/=values.num_rows;
-		}
+		StatisticsAccumulator<float64_t> statistics(values.num_rows);
+		statistics.add(values);
+		return statistics.get_mean();
 	}
-	else
-	{
-		result=SGVector<float64_t>(values.num_rows);
-		for (index_t j=0; j<values.num_rows; ++j)
-		{
-			result[j]=0;
-			for (index_t i=0; i<values.num_cols; ++i)
-				result[j]+=values(j,i);
 
-			result[j]/=values.num_cols;
-		}
+	/* columns are contiguous and independent */
+	SGVector<float64_t> result(values.num_cols);
+#pragma omp parallel for
+	for (index_t j=0; j<values.num_cols; ++j)
+	{
+		Map<VectorXd> column(values.get_column_vector(j), values.num_rows);
+		result[j]=column.mean();
 	}
 
 	return result;
@@ -83,34 +73,21 @@ SGVector<float64_t> CStatistics::matrix_variance(SGMatrix<float64_t> values,
 	ASSERT(values.num_cols>0)
 	ASSERT(values.matrix)
 
-	/* first compute mean */
-	SGVector<float64_t> mean=CStatistics::matrix_mean(values, col_wise);
-
-	SGVector<float64_t> result;
-
-	if (col_wise)
+	if (!col_wise)
 	{
-		result=SGVector<float64_t>(values.num_cols);
-		for (index_t j=0; j<values.num_cols; ++j)
-		{
-			result[j]=0;
-			for (index_t i=0; i<values.num_rows; ++i)
-				result[j]+=CMath::pow(values(i,j)-mean[j], 2);
-
-			result[j]/=(values.num_rows-1);
-		}
+		StatisticsAccumulator<float64_t> statistics(values.num_rows);
+		statistics.add(values);
+		return statistics.get_variance(true);
 	}
-	else
-	{
-		result=SGVector<float64_t>(values.num_rows);
-		for (index_t j=0; j<values.num_rows; ++j)
-		{
-			result[j]=0;
-			for (index_t i=0; i<values.num_cols; ++i)
-				result[j]+=CMath::pow(values(j,i)-mean[j], 2);
 
-			result[j]/=(values.num_cols-1);
-		}
+	/* columns are contiguous and independent, two passes over each */
+	SGVector<float64_t> result(values.num_cols);
+#pragma omp parallel for
+	for (index_t j=0; j<values.num_cols; ++j)
+	{
+		Map<VectorXd> column(values.get_column_vector(j), values.num_rows);
+		const float64_t mean=column.mean();
+		result[j]=(column.array()-mean).square().sum()/(values.num_rows-1);
 	}
 
 	return result;
@@ -141,27 +118,21 @@ SGMatrix<float64_t> CStatistics::covariance_matrix(
 	REQUIRE(N>1, "Number of observations (%d) must be at least 2.\n", N);
 	REQUIRE(D>0, "Number of dimensions (%d) must be at least 1.\n", D);
 
-	SGMatrix<float64_t> centered=in_place ? observations :
-					SGMatrix<float64_t>(D, N);
+	/* the scatter matrix is accumulated chunk by chunk, so no centered copy
+	 * of the observations is needed */
+	SG_SDEBUG("Computing squared differences\n");
+	StatisticsAccumulator<float64_t> statistics(D, true);
+	statistics.add(observations);
 
-	/* center observations, potentially in-place */
-	if (!in_place)
+	if (in_place)
 	{
-		int64_t num_elements = N*D;
-		sg_memcpy(centered.matrix, observations.matrix,
-				sizeof(float64_t)*num_elements);
+		SG_SDEBUG("Centering observations\n");
+		auto mean = statistics.get_mean();
+		Map<MatrixXd> eigen_observations(observations.matrix, D, N);
+		eigen_observations.colwise() -= Map<VectorXd>(mean.vector, D);
 	}
-	SG_SDEBUG("Centering observations\n");
-	Map<MatrixXd> eigen_centered(centered.matrix, D, N);
-	eigen_centered.colwise() -= eigen_centered.rowwise().mean();
-
-	/* compute and store 1/(N-1) * X * X.T */
-	SG_SDEBUG("Computing squared differences\n");
-	SGMatrix<float64_t> cov(D, D);
-	Map<MatrixXd> eigen_cov(cov.matrix, D, D);
-	eigen_cov = (eigen_centered * eigen_centered.adjoint()) / double(N - 1);
 
-	return cov;
+	return statistics.get_cov(true);
 }
 
 SGVector<float64_t> CStatistics::fishers_exact_test_for_multiple_2x3_tables(
@@ -111,12 +111,14 @@ public:
 	 * data which is organized as num_cols variables with num_rows observations.
 	 * Normalizes by N-1 for N observations
 	 *
-	 * Data is centered before matrix is computed. May be done in place.
-	 * In this case, the observation matrix is changed (centered).
+	 * The covariance is accumulated in parallel chunks of centered
+	 * observations, see StatisticsAccumulator, which works for data that does
+	 * not fit in memory as well. Observations can be centered in place in
+	 * addition, then the observation matrix is changed (centered).
 	 *
 	 * @param observations Data matrix
 	 * @param in_place Optional, if set to true, observations matrix will be
-	 * centered, if false, a copy will be created an centered.
+	 * centered, if false, it is not changed.
 	 * @return DxD covariance matrix
 	 */
 	static SGMatrix<float64_t> covariance_matrix(
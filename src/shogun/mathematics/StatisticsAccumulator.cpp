@@ -0,0 +1,588 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: agent
+ */
+
+#include <shogun/mathematics/StatisticsAccumulator.h>
+#include <shogun/features/DenseFeatures.h>
+#include <shogun/features/DotFeatures.h>
+#include <shogun/features/SparseFeatures.h>
+#include <shogun/features/streaming/StreamingDenseFeatures.h>
+#include <shogun/features/streaming/StreamingSparseFeatures.h>
+#include <shogun/io/SGIO.h>
+#include <shogun/mathematics/eigen3.h>
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+#ifdef HAVE_OPENMP
+#include <omp.h>
+#endif
+
+using namespace shogun;
+using namespace Eigen;
+
+/* number of chunks fetched from a stream at once */
+static const index_t STREAM_NUM_CHUNKS=16;
+
+template <class T>
+StatisticsAccumulator<T>::StatisticsAccumulator(index_t dim, bool compute_cov)
+	: m_dim(dim), m_compute_cov(compute_cov)
+{
+	REQUIRE(dim>=0, "Dimension (%d) cannot be negative\n", dim);
+	reset();
+}
+
+template <class T>
+void StatisticsAccumulator<T>::reset()
+{
+	m_num_vectors=0;
+	m_mean=SGVector<T>(m_dim);
+	m_sum_sq=SGVector<T>(m_dim);
+	m_min=SGVector<T>(m_dim);
+	m_max=SGVector<T>(m_dim);
+	m_mean.zero();
+	m_sum_sq.zero();
+	m_min.set_const(std::numeric_limits<T>::max());
+	m_max.set_const(std::numeric_limits<T>::lowest());
+
+	if (m_compute_cov)
+	{
+		m_scatter=SGMatrix<T>(m_dim, m_dim);
+		if (m_dim)
+			m_scatter.zero();
+	}
+}
+
+template <class T>
+void StatisticsAccumulator<T>::check_dim(index_t dim)
+{
+	/* the dimension of an empty accumulator is taken from its first data */
+	if (!m_num_vectors && !m_dim && dim)
+	{
+		m_dim=dim;
+		reset();
+	}
+
+	REQUIRE(dim==m_dim, "Dimension of the data (%d) does not match the "
+			"dimension of the accumulator (%d)\n", dim, m_dim);
+}
+
+template <class T>
+void StatisticsAccumulator<T>::merge_moments(int64_t num_vectors,
+		const T* mean, const T* sum_sq, const T* scatter, const T* min,
+		const T* max)
+{
+	typedef Matrix<T, Dynamic, 1> VectorT;
+	typedef Matrix<T, Dynamic, Dynamic> MatrixT;
+
+	if (!num_vectors)
+		return;
+
+	Map<VectorT> cur_mean(m_mean.vector, m_dim);
+	Map<VectorT> cur_sum_sq(m_sum_sq.vector, m_dim);
+	Map<const VectorT> new_mean(mean, m_dim);
+	Map<const VectorT> new_sum_sq(sum_sq, m_dim);
+
+	const T num_total=T(m_num_vectors)+T(num_vectors);
+	const T weight=T(m_num_vectors)*T(num_vectors)/num_total;
+	VectorT delta=new_mean-cur_mean;
+
+	cur_mean+=delta*(T(num_vectors)/num_total);
+	cur_sum_sq+=new_sum_sq+delta.cwiseAbs2()*weight;
+
+	if (m_compute_cov)
+	{
+		Map<MatrixT> cur_scatter(m_scatter.matrix, m_dim, m_dim);
+		Map<const MatrixT> new_scatter(scatter, m_dim, m_dim);
+		cur_scatter.template triangularView<Lower>()+=new_scatter;
+		cur_scatter.template selfadjointView<Lower>().rankUpdate(delta, weight);
+	}
+
+	for (index_t i=0; i<m_dim; ++i)
+	{
+		m_min[i]=CMath::min(m_min[i], min[i]);
+		m_max[i]=CMath::max(m_max[i], max[i]);
+	}
+
+	m_num_vectors+=num_vectors;
+}
+
+template <class T>
+void StatisticsAccumulator<T>::add_dense_chunk(const T* data, index_t num_vectors)
+{
+	typedef Matrix<T, Dynamic, 1> VectorT;
+	typedef Matrix<T, Dynamic, Dynamic> MatrixT;
+
+	if (!num_vectors)
+		return;
+
+	Map<const MatrixT> chunk(data, m_dim, num_vectors);
+	VectorT mean=chunk.rowwise().sum()/T(num_vectors);
+	MatrixT centered=chunk.colwise()-mean;
+	VectorT sum_sq=centered.rowwise().squaredNorm();
+	VectorT min=chunk.rowwise().minCoeff();
+	VectorT max=chunk.rowwise().maxCoeff();
+
+	MatrixT scatter;
+	if (m_compute_cov)
+	{
+		scatter=MatrixT::Zero(m_dim, m_dim);
+		scatter.template selfadjointView<Lower>().rankUpdate(centered);
+	}
+
+	merge_moments(num_vectors, mean.data(), sum_sq.data(), scatter.data(),
+			min.data(), max.data());
+}
+
+template <class T>
+void StatisticsAccumulator<T>::add_sparse_chunk(
+		const SGSparseVector<T>* vectors, index_t num_vectors)
+{
+	if (!num_vectors)
+		return;
+
+	/* the scatter matrix is dense anyway, so is the chunk */
+	if (m_compute_cov)
+	{
+		SGMatrix<T> chunk(m_dim, num_vectors);
+		chunk.zero();
+		for (index_t i=0; i<num_vectors; ++i)
+		{
+			for (index_t k=0; k<vectors[i].num_feat_entries; ++k)
+			{
+				const SGSparseVectorEntry<T>& e=vectors[i].features[k];
+				chunk(e.feat_index, i)+=e.entry;
+			}
+		}
+		add_dense_chunk(chunk.matrix, num_vectors);
+		return;
+	}
+
+	SGVector<T> mean(m_dim);
+	SGVector<T> sum_sq(m_dim);
+	SGVector<T> min(m_dim);
+	SGVector<T> max(m_dim);
+	SGVector<index_t> num_nonzero(m_dim);
+	mean.zero();
+	sum_sq.zero();
+	min.zero();
+	max.zero();
+	num_nonzero.zero();
+
+	for (index_t i=0; i<num_vectors; ++i)
+	{
+		for (index_t k=0; k<vectors[i].num_feat_entries; ++k)
+		{
+			const SGSparseVectorEntry<T>& e=vectors[i].features[k];
+			mean[e.feat_index]+=e.entry;
+			num_nonzero[e.feat_index]++;
+		}
+	}
+
+	for (index_t j=0; j<m_dim; ++j)
+	{
+		mean[j]/=num_vectors;
+		sum_sq[j]=T(num_vectors-num_nonzero[j])*mean[j]*mean[j];
+	}
+
+	/* min and max start at zero, which is right unless every vector has an
+	 * entry in that dimension */
+	for (index_t j=0; j<m_dim; ++j)
+	{
+		if (num_nonzero[j]==num_vectors)
+		{
+			min[j]=std::numeric_limits<T>::max();
+			max[j]=std::numeric_limits<T>::lowest();
+		}
+	}
+
+	for (index_t i=0; i<num_vectors; ++i)
+	{
+		for (index_t k=0; k<vectors[i].num_feat_entries; ++k)
+		{
+			const SGSparseVectorEntry<T>& e=vectors[i].features[k];
+			const T diff=e.entry-mean[e.feat_index];
+			sum_sq[e.feat_index]+=diff*diff;
+			min[e.feat_index]=CMath::min(min[e.feat_index], e.entry);
+			max[e.feat_index]=CMath::max(max[e.feat_index], e.entry);
+		}
+	}
+
+	merge_moments(num_vectors, mean.vector, sum_sq.vector, NULL, min.vector,
+			max.vector);
+}
+
+template <class T>
+template <class Processor>
+void StatisticsAccumulator<T>::add_chunks(index_t num_chunks, Processor process)
+{
+	if (num_chunks<=1)
+	{
+		if (num_chunks)
+			process(*this, 0);
+		return;
+	}
+
+	std::vector<StatisticsAccumulator<T> > partials;
+
+#pragma omp parallel
+	{
+#ifdef HAVE_OPENMP
+		int32_t num_threads=omp_get_num_threads();
+		int32_t thread_num=omp_get_thread_num();
+#else
+		int32_t num_threads=1;
+		int32_t thread_num=0;
+#endif
+
+		/* every partial gets its own buffers */
+		#pragma omp single
+		{
+			partials.reserve(num_threads);
+			for (int32_t i=0; i<num_threads; ++i)
+				partials.emplace_back(m_dim, m_compute_cov);
+		}
+
+		#pragma omp for schedule(static)
+		for (index_t c=0; c<num_chunks; ++c)
+			process(partials[thread_num], c);
+	}
+
+	for (const auto& partial : partials)
+		merge(partial);
+}
+
+template <class T>
+void StatisticsAccumulator<T>::add(const SGVector<T>& vector)
+{
+	check_dim(vector.vlen);
+	add_dense_chunk(vector.vector, 1);
+}
+
+template <class T>
+void StatisticsAccumulator<T>::add(const SGMatrix<T>& data)
+{
+	check_dim(data.num_rows);
+
+	const index_t num_vectors=data.num_cols;
+	const index_t num_chunks=(num_vectors+chunk_size-1)/chunk_size;
+	const int64_t dim=m_dim;
+	const T* matrix=data.matrix;
+
+	add_chunks(num_chunks, [=](StatisticsAccumulator<T>& partial, index_t c)
+	{
+		const index_t first=c*chunk_size;
+		partial.add_dense_chunk(matrix+first*dim,
+				CMath::min(chunk_size, num_vectors-first));
+	});
+}
+
+template <class T>
+void StatisticsAccumulator<T>::add(const SGMatrix<T>& data,
+		const SGVector<index_t>& indices)
+{
+	check_dim(data.num_rows);
+
+	const index_t num_vectors=indices.vlen;
+	const index_t num_chunks=(num_vectors+chunk_size-1)/chunk_size;
+	const index_t dim=m_dim;
+
+	for (index_t i=0; i<num_vectors; ++i)
+	{
+		REQUIRE(indices[i]>=0 && indices[i]<data.num_cols,
+				"Index %d is out of range [0, %d)\n", indices[i], data.num_cols);
+	}
+
+	add_chunks(num_chunks, [&](StatisticsAccumulator<T>& partial, index_t c)
+	{
+		const index_t first=c*chunk_size;
+		const index_t size=CMath::min(chunk_size, num_vectors-first);
+
+		SGMatrix<T> chunk(dim, size);
+		for (index_t i=0; i<size; ++i)
+		{
+			sg_memcpy(chunk.get_column_vector(i),
+					data.get_column_vector(indices[first+i]), dim*sizeof(T));
+		}
+		partial.add_dense_chunk(chunk.matrix, size);
+	});
+}
+
+template <class T>
+void StatisticsAccumulator<T>::add(const SGSparseMatrix<T>& data)
+{
+	check_dim(data.num_features);
+
+	const index_t num_vectors=data.num_vectors;
+	const index_t num_chunks=(num_vectors+chunk_size-1)/chunk_size;
+	const SGSparseVector<T>* vectors=data.sparse_matrix;
+
+	add_chunks(num_chunks, [=](StatisticsAccumulator<T>& partial, index_t c)
+	{
+		const index_t first=c*chunk_size;
+		partial.add_sparse_chunk(vectors+first,
+				CMath::min(chunk_size, num_vectors-first));
+	});
+}
+
+template <class T>
+void StatisticsAccumulator<T>::add(CFeatures* features)
+{
+	REQUIRE(features, "No features provided\n");
+
+	/* features of another type than T can only be read as dot features */
+	if (auto dense=dynamic_cast<CDenseFeatures<T>*>(features))
+	{
+		add(dense->get_feature_matrix());
+	}
+	else if (auto sparse=dynamic_cast<CSparseFeatures<T>*>(features))
+	{
+		check_dim(sparse->get_num_features());
+
+		const index_t num_vectors=sparse->get_num_vectors();
+		const index_t num_chunks=(num_vectors+chunk_size-1)/chunk_size;
+		add_chunks(num_chunks, [&](StatisticsAccumulator<T>& partial, index_t c)
+		{
+			const index_t first=c*chunk_size;
+			const index_t size=CMath::min(chunk_size, num_vectors-first);
+
+			std::vector<SGSparseVector<T> > chunk(size);
+			for (index_t i=0; i<size; ++i)
+				chunk[i]=sparse->get_sparse_feature_vector(first+i);
+			partial.add_sparse_chunk(chunk.data(), size);
+			for (index_t i=0; i<size; ++i)
+				sparse->free_sparse_feature_vector(first+i);
+		});
+	}
+	else if (auto stream=dynamic_cast<CStreamingDenseFeatures<T>*>(features))
+	{
+		stream->start_parser();
+		for (auto batch=stream->get_next_batch(STREAM_NUM_CHUNKS*chunk_size);
+				batch.num_cols;
+				batch=stream->get_next_batch(STREAM_NUM_CHUNKS*chunk_size))
+			add(batch);
+		stream->end_parser();
+	}
+	else if (auto sparse_stream=dynamic_cast<CStreamingSparseFeatures<T>*>(features))
+	{
+		sparse_stream->start_parser();
+		for (auto batch=sparse_stream->get_next_batch(STREAM_NUM_CHUNKS*chunk_size);
+				batch.num_vectors;
+				batch=sparse_stream->get_next_batch(STREAM_NUM_CHUNKS*chunk_size))
+		{
+			/* the dimension of a sparse stream is the largest index seen
+			 * so far, the batches are padded to the accumulator's */
+			REQUIRE(!m_dim || batch.num_features<=m_dim,
+					"Streamed vectors have %d dimensions, more than the %d "
+					"of the accumulator\n", batch.num_features, m_dim);
+			if (m_dim)
+				batch.num_features=m_dim;
+			add(batch);
+		}
+		sparse_stream->end_parser();
+	}
+	else
+	{
+		auto dot=features->as<CDotFeatures>();
+		check_dim(dot->get_dim_feature_space());
+
+		const index_t num_vectors=dot->get_num_vectors();
+		const index_t num_chunks=(num_vectors+chunk_size-1)/chunk_size;
+		const index_t dim=m_dim;
+		if (m_compute_cov)
+		{
+			/* the scatter matrix is dense anyway, so is the chunk */
+			add_chunks(num_chunks, [&](StatisticsAccumulator<T>& partial, index_t c)
+			{
+				const index_t first=c*chunk_size;
+				const index_t size=CMath::min(chunk_size, num_vectors-first);
+
+				SGVector<float64_t> vec(dim);
+				SGMatrix<T> chunk(dim, size);
+				for (index_t i=0; i<size; ++i)
+				{
+					vec.zero();
+					dot->add_to_dense_vec(1.0, first+i, vec.vector, dim);
+					for (index_t j=0; j<dim; ++j)
+						chunk(j, i)=T(vec[j]);
+				}
+				partial.add_dense_chunk(chunk.matrix, size);
+			});
+			return;
+		}
+
+		/* high dimensional dot features, such as WD ones, are sparse: the
+		 * non-zero entries of every vector are taken from the feature
+		 * iterator. Features without iterator are expanded into a single
+		 * buffer which is scanned for non-zeros. The iterator of combined
+		 * features returns the indices within the subfeatures. */
+		const bool iterable=dot->get_feature_class()!=C_COMBINED_DOT;
+		add_chunks(num_chunks, [&](StatisticsAccumulator<T>& partial, index_t c)
+		{
+			const index_t first=c*chunk_size;
+			const index_t size=CMath::min(chunk_size, num_vectors-first);
+
+			SGVector<float64_t> vec;
+			std::vector<SGSparseVectorEntry<float64_t> > entries;
+			std::vector<SGSparseVector<T> > chunk(size);
+			for (index_t i=0; i<size; ++i)
+			{
+				entries.clear();
+				void* iterator=iterable ? dot->get_feature_iterator(first+i) : NULL;
+				if (iterator)
+				{
+					int32_t index;
+					float64_t value;
+					while (dot->get_next_feature(index, value, iterator))
+					{
+						SGSparseVectorEntry<float64_t> e={index, value};
+						entries.push_back(e);
+					}
+					dot->free_feature_iterator(iterator);
+				}
+				else
+				{
+					if (!vec.vlen)
+					{
+						vec=SGVector<float64_t>(dim);
+						vec.zero();
+					}
+					dot->add_to_dense_vec(1.0, first+i, vec.vector, dim);
+					for (index_t j=0; j<dim; ++j)
+					{
+						if (vec[j]!=0)
+						{
+							SGSparseVectorEntry<float64_t> e={j, vec[j]};
+							entries.push_back(e);
+							vec[j]=0;
+						}
+					}
+				}
+
+				/* an index may be returned more than once */
+				std::sort(entries.begin(), entries.end(),
+					[](const SGSparseVectorEntry<float64_t>& a,
+						const SGSparseVectorEntry<float64_t>& b)
+					{ return a.feat_index<b.feat_index; });
+				index_t num_entries=0;
+				for (const auto& e : entries)
+				{
+					if (num_entries && entries[num_entries-1].feat_index==e.feat_index)
+						entries[num_entries-1].entry+=e.entry;
+					else
+						entries[num_entries++]=e;
+				}
+
+				chunk[i]=SGSparseVector<T>(num_entries);
+				for (index_t k=0; k<num_entries; ++k)
+				{
+					chunk[i].features[k].feat_index=entries[k].feat_index;
+					chunk[i].features[k].entry=T(entries[k].entry);
+				}
+			}
+			partial.add_sparse_chunk(chunk.data(), size);
+		});
+	}
+}
+
+template <class T>
+void StatisticsAccumulator<T>::merge(const StatisticsAccumulator<T>& other)
+{
+	if (!other.m_num_vectors)
+		return;
+
+	check_dim(other.m_dim);
+	REQUIRE(!m_compute_cov || other.m_compute_cov,
+			"Cannot merge an accumulator without covariance into one with\n");
+
+	merge_moments(other.m_num_vectors, other.m_mean.vector,
+			other.m_sum_sq.vector, other.m_scatter.matrix, other.m_min.vector,
+			other.m_max.vector);
+}
+
+template <class T>
+SGVector<T> StatisticsAccumulator<T>::get_mean() const
+{
+	REQUIRE(m_num_vectors>0, "No vectors were added\n");
+	return m_mean.clone();
+}
+
+template <class T>
+SGVector<T> StatisticsAccumulator<T>::get_sum_of_squares() const
+{
+	REQUIRE(m_num_vectors>0, "No vectors were added\n");
+	return m_sum_sq.clone();
+}
+
+template <class T>
+SGVector<T> StatisticsAccumulator<T>::get_variance(bool unbiased) const
+{
+	REQUIRE(m_num_vectors>(unbiased ? 1 : 0), "%d vectors are not enough "
+			"for the variance\n", m_num_vectors);
+
+	SGVector<T> variance=m_sum_sq.clone();
+	const T normalizer=T(unbiased ? m_num_vectors-1 : m_num_vectors);
+	for (index_t i=0; i<m_dim; ++i)
+		variance[i]/=normalizer;
+
+	return variance;
+}
+
+template <class T>
+SGVector<T> StatisticsAccumulator<T>::get_std(bool unbiased) const
+{
+	SGVector<T> std=get_variance(unbiased);
+	for (index_t i=0; i<m_dim; ++i)
+		std[i]=CMath::sqrt(std[i]);
+
+	return std;
+}
+
+template <class T>
+SGMatrix<T> StatisticsAccumulator<T>::get_scatter() const
+{
+	REQUIRE(m_compute_cov, "Covariance was not accumulated\n");
+	REQUIRE(m_num_vectors>0, "No vectors were added\n");
+
+	SGMatrix<T> scatter=m_scatter.clone();
+	for (index_t j=0; j<m_dim; ++j)
+		for (index_t i=0; i<j; ++i)
+			scatter(i, j)=scatter(j, i);
+
+	return scatter;
+}
+
+template <class T>
+SGMatrix<T> StatisticsAccumulator<T>::get_cov(bool unbiased) const
+{
+	REQUIRE(m_num_vectors>(unbiased ? 1 : 0), "%d vectors are not enough "
+			"for the covariance\n", m_num_vectors);
+
+	SGMatrix<T> cov=get_scatter();
+	const T normalizer=T(unbiased ? m_num_vectors-1 : m_num_vectors);
+	for (index_t i=0; i<cov.size(); ++i)
+		cov[i]/=normalizer;
+
+	return cov;
+}
+
+template <class T>
+SGVector<T> StatisticsAccumulator<T>::get_min() const
+{
+	REQUIRE(m_num_vectors>0, "No vectors were added\n");
+	return m_min.clone();
+}
+
+template <class T>
+SGVector<T> StatisticsAccumulator<T>::get_max() const
+{
+	REQUIRE(m_num_vectors>0, "No vectors were added\n");
+	return m_max.clone();
+}
+
+template class StatisticsAccumulator<float32_t>;
+template class StatisticsAccumulator<float64_t>;
+template class StatisticsAccumulator<floatmax_t>;
@@ -0,0 +1,181 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: agent
+ */
+
+#ifndef __STATISTICSACCUMULATOR_H__
+#define __STATISTICSACCUMULATOR_H__
+
+#include <shogun/lib/config.h>
+
+#include <shogun/lib/common.h>
+#include <shogun/lib/SGMatrix.h>
+#include <shogun/lib/SGSparseMatrix.h>
+#include <shogun/lib/SGVector.h>
+
+namespace shogun
+{
+
+class CFeatures;
+
+/** @brief Running mean, variance, covariance and range of vectors.
+ *
+ * Vectors are added in chunks. The moments of every chunk are computed with
+ * two passes over the chunk and merged into the running moments with the
+ * pairwise update of Chan, Golub and LeVeque, which is as stable as
+ * Welford's algorithm but vectorizes and needs a single merge per chunk.
+ * Large inputs are split between threads, each thread accumulates its own
+ * partial moments and the partials are merged in a fixed order at the end,
+ * so results only depend on the number of threads.
+ *
+ * Dense, sparse and streaming features can be added without holding more
+ * than a chunk of dense vectors in memory, and accumulators of separate
+ * data sets can be merged, which gives the moments of the union.
+ *
+ * The covariance (co-moment matrix) is optional as it costs
+ * \f$O(D^2)\f$ memory and time per vector.
+ */
+template <class T>
+class StatisticsAccumulator
+{
+	public:
+		/** ctor
+		 *
+		 * @param dim dimension of the vectors, if 0 it is taken from the
+		 * first data added
+		 * @param compute_cov whether to accumulate the covariance as well
+		 */
+		StatisticsAccumulator(index_t dim=0, bool compute_cov=false);
+
+		/** adds a vector
+		 *
+		 * @param vector vector of dimension get_dim()
+		 */
+		void add(const SGVector<T>& vector);
+
+		/** adds the columns of a matrix
+		 *
+		 * @param data matrix with get_dim() rows
+		 */
+		void add(const SGMatrix<T>& data);
+
+		/** adds a subset of the columns of a matrix
+		 *
+		 * @param data matrix with get_dim() rows
+		 * @param indices indices of the columns to add
+		 */
+		void add(const SGMatrix<T>& data, const SGVector<index_t>& indices);
+
+		/** adds the vectors of a sparse matrix
+		 *
+		 * @param data sparse matrix of vectors of dimension get_dim()
+		 */
+		void add(const SGSparseMatrix<T>& data);
+
+		/** adds all vectors of features. Streaming features are consumed
+		 * until the stream ends. Without covariance, other dot features
+		 * are walked with their feature iterator in O(nnz) per vector and
+		 * the chunks are sparse.
+		 *
+		 * @param features dense, sparse, streaming dense, streaming sparse
+		 * or (for float64_t) any dot features
+		 */
+		void add(CFeatures* features);
+
+		/** adds the moments of another accumulator
+		 *
+		 * @param other accumulator of the same dimension
+		 */
+		void merge(const StatisticsAccumulator<T>& other);
+
+		/** @return dimension of the vectors */
+		index_t get_dim() const { return m_dim; }
+
+		/** @return number of vectors added */
+		int64_t get_num_vectors() const { return m_num_vectors; }
+
+		/** @return mean */
+		SGVector<T> get_mean() const;
+
+		/** @param unbiased normalize by N-1 rather than N
+		 * @return variance of every dimension
+		 */
+		SGVector<T> get_variance(bool unbiased=false) const;
+
+		/** @param unbiased normalize by N-1 rather than N
+		 * @return standard deviation of every dimension
+		 */
+		SGVector<T> get_std(bool unbiased=false) const;
+
+		/** @return sum of squared deviations from the mean of every
+		 * dimension
+		 */
+		SGVector<T> get_sum_of_squares() const;
+
+		/** @param unbiased normalize by N-1 rather than N
+		 * @return covariance matrix, requires compute_cov
+		 */
+		SGMatrix<T> get_cov(bool unbiased=false) const;
+
+		/** @return scatter matrix, i.e. the sum of outer products of the
+		 * centered vectors, requires compute_cov
+		 */
+		SGMatrix<T> get_scatter() const;
+
+		/** @return smallest value of every dimension */
+		SGVector<T> get_min() const;
+
+		/** @return largest value of every dimension */
+		SGVector<T> get_max() const;
+
+		/** number of vectors per chunk */
+		static const index_t chunk_size=256;
+
+	private:
+		/** adds the moments of a chunk of contiguous dense vectors */
+		void add_dense_chunk(const T* data, index_t num_vectors);
+
+		/** adds the moments of a chunk of sparse vectors */
+		void add_sparse_chunk(const SGSparseVector<T>* vectors, index_t num_vectors);
+
+		/** runs process(partial, chunk) for all chunks, in parallel into
+		 * per-thread partials that are merged afterwards
+		 */
+		template <class Processor>
+		void add_chunks(index_t num_chunks, Processor process);
+
+		/** merges the moments of num_vectors vectors */
+		void merge_moments(int64_t num_vectors, const T* mean, const T* sum_sq,
+				const T* scatter, const T* min, const T* max);
+
+		/** allocates the moments of an empty accumulator */
+		void reset();
+
+		/** checks the dimension of data to add, an accumulator constructed
+		 * without dimension takes it from its first data
+		 */
+		void check_dim(index_t dim);
+
+	private:
+		/** dimension */
+		index_t m_dim;
+		/** whether to accumulate the scatter matrix */
+		bool m_compute_cov;
+		/** number of vectors */
+		int64_t m_num_vectors;
+		/** mean */
+		SGVector<T> m_mean;
+		/** sum of squared deviations from the mean */
+		SGVector<T> m_sum_sq;
+		/** lower triangle of the scatter matrix */
+		SGMatrix<T> m_scatter;
+		/** smallest values */
+		SGVector<T> m_min;
+		/** largest values */
+		SGVector<T> m_max;
+};
+
+}
+
+#endif /* __STATISTICSACCUMULATOR_H__ */
@@ -36,6 +36,10 @@
 #include <shogun/mathematics/linalg/LinalgBackendBase.h>
 #include <shogun/mathematics/linalg/LinalgEnums.h>
 #include <shogun/mathematics/linalg/SGLinalg.h>
+#include <shogun/lib/SGMatrixView.h>
+#include <shogun/lib/SGVectorView.h>
+
+#include <type_traits>
 
 namespace shogun
 {
@@ -1965,6 +1969,167 @@ namespace shogun
 		{
 			infer_backend(a)->zero(a);
 		}
+
+		/**
+		 * Wraps the memory of a view into a SGVector without reference
+		 * counting, so that it can be passed on to a backend. Views always
+		 * live on the CPU.
+		 *
+		 * @param a SGVectorView
+		 * @return SGVector sharing the memory of a
+		 */
+		template <typename T>
+		SGVector<typename std::remove_const<T>::type>
+		view_as_vector(const SGVectorView<T>& a)
+		{
+			typedef typename std::remove_const<T>::type U;
+			return SGVector<U>(const_cast<U*>(a.data()), a.size(), false);
+		}
+
+		/**
+		 * Wraps the memory of a view into a SGMatrix without reference
+		 * counting, so that it can be passed on to a backend.
+		 *
+		 * @param A SGMatrixView
+		 * @return SGMatrix sharing the memory of A
+		 */
+		template <typename T>
+		SGMatrix<typename std::remove_const<T>::type>
+		view_as_matrix(const SGMatrixView<T>& A)
+		{
+			typedef typename std::remove_const<T>::type U;
+			return SGMatrix<U>(
+			    const_cast<U*>(A.data()), A.num_rows(), A.num_cols(), false);
+		}
+
+		/**
+		 * Vector dot-product on views, see
+		 * dot(const SGVector<T>&, const SGVector<U>&, Tag).
+		 * Views are dispatched to the CPU backend directly.
+		 *
+		 * @param a First vector
+		 * @param b Second vector
+		 * @return The dot product of \f$\mathbf{a}\f$ and \f$\mathbf{b}\f$
+		 */
+		template <typename T, typename U>
+		typename std::remove_const<T>::type
+		dot(const SGVectorView<T>& a, const SGVectorView<U>& b)
+		{
+			static_assert(
+			    std::is_same<
+			        typename std::remove_const<T>::type,
+			        typename std::remove_const<U>::type>::value,
+			    "LinalgNamespace::dot: Error. unmatching view types");
+			REQUIRE(
+			    a.size() == b.size(),
+			    "Length of vector a (%d) doesn't match vector b (%d).\n",
+			    a.size(), b.size());
+
+			return sg_linalg->get_cpu_backend()->dot(
+			    view_as_vector(a), view_as_vector(b));
+		}
+
+		/**
+		 * Euclidean norm of a view.
+		 *
+		 * @param a SGVectorView
+		 * @return The vector norm
+		 */
+		template <typename T>
+		typename std::remove_const<T>::type norm(const SGVectorView<T>& a)
+		{
+			REQUIRE(a.size() > 0, "Vector cannot be empty!\n");
+			return std::sqrt(dot(a, a));
+		}
+
+		/**
+		 * Performs the operation result = alpha * a + beta * b on views.
+		 * result may alias a or b.
+		 *
+		 * @param a First vector
+		 * @param b Second vector
+		 * @param result The vector that saves the result
+		 * @param alpha Constant to be multiplied by the first vector
+		 * @param beta Constant to be multiplied by the second vector
+		 */
+		template <typename T, typename U, typename V>
+		void
+		add(const SGVectorView<T>& a, const SGVectorView<U>& b,
+		    const SGVectorView<V>& result, V alpha = 1, V beta = 1)
+		{
+			static_assert(
+			    !std::is_const<V>::value,
+			    "LinalgNamespace::add: Error. result view is read-only");
+			REQUIRE(
+			    a.size() == b.size(),
+			    "Length of vector a (%d) doesn't match vector b (%d).\n",
+			    a.size(), b.size());
+			REQUIRE(
+			    result.size() == b.size(),
+			    "Length of vector result (%d) doesn't match vector a (%d).\n",
+			    result.size(), a.size());
+
+			SGVector<V> r = view_as_vector(result);
+			sg_linalg->get_cpu_backend()->add(
+			    view_as_vector(a), view_as_vector(b), alpha, beta, r);
+		}
+
+		/**
+		 * Performs the operation result = alpha * a on views.
+		 * result may alias a.
+		 *
+		 * @param a First vector
+		 * @param result The vector of alpha * a
+		 * @param alpha Scale factor
+		 */
+		template <typename T, typename V>
+		void scale(
+		    const SGVectorView<T>& a, const SGVectorView<V>& result,
+		    V alpha = 1)
+		{
+			static_assert(
+			    !std::is_const<V>::value,
+			    "LinalgNamespace::scale: Error. result view is read-only");
+			REQUIRE(
+			    result.size() == a.size(),
+			    "Length of vector result (%d) doesn't match vector a (%d).\n",
+			    result.size(), a.size());
+
+			SGVector<V> r = view_as_vector(result);
+			sg_linalg->get_cpu_backend()->scale(view_as_vector(a), alpha, r);
+		}
+
+		/**
+		 * Matrix-vector product \f$x = Ab\f$ on views.
+		 *
+		 * @param A The matrix
+		 * @param b The vector
+		 * @param result Result vector
+		 * @param transpose Whether to transpose the matrix. Default false
+		 */
+		template <typename T, typename U, typename V>
+		void matrix_prod(
+		    const SGMatrixView<T>& A, const SGVectorView<U>& b,
+		    const SGVectorView<V>& result, bool transpose = false)
+		{
+			static_assert(
+			    !std::is_const<V>::value,
+			    "LinalgNamespace::matrix_prod: Error. result view is "
+			    "read-only");
+			REQUIRE(
+			    (transpose ? A.num_rows() : A.num_cols()) == b.size(),
+			    "Matrix A (%d x %d) doesn't match length of vector b (%d).\n",
+			    A.num_rows(), A.num_cols(), b.size());
+			REQUIRE(
+			    (transpose ? A.num_cols() : A.num_rows()) == result.size(),
+			    "Matrix A (%d x %d) doesn't match length of vector result "
+			    "(%d).\n",
+			    A.num_rows(), A.num_cols(), result.size());
+
+			SGVector<V> r = view_as_vector(result);
+			sg_linalg->get_cpu_backend()->matrix_prod(
+			    view_as_matrix(A), view_as_vector(b), r, transpose, false);
+		}
 	} // namespace linalg
 } // namespace shogun
 
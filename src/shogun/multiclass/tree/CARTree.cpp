@@ -300,6 +300,12 @@ void CCARTree::set_sorted_features(SGMatrix<float64_t>& sorted_feats, SGMatrix<i
 	m_sorted_indices=sorted_indices;
 }
 
+void CCARTree::set_random_stream(const RandomStream& stream)
+{
+	m_random_stream=stream;
+	m_random_stream_set=true;
+}
+
 void CCARTree::pre_sort_features(CFeatures* data, SGMatrix<float64_t>& sorted_feats, SGMatrix<index_t>& sorted_indices)
 {
 	SGMatrix<float64_t> mat=(data)->as<CDenseFeatures<float64_t>>()->get_feature_matrix();
@@ -568,7 +574,10 @@ index_t CCARTree::compute_best_attribute(const SGMatrix<float64_t>& mat, const S
 	if (subset_size)
 	{
 		num_feats=subset_size;
-		CMath::permute(idx);
+		if (m_random_stream_set)
+			m_random_stream.permute(idx);
+		else
+			CMath::permute(idx);
 	}
 
 	float64_t max_gain=MIN_SPLIT_GAIN;
@@ -1488,6 +1497,7 @@ void CCARTree::init()
 	m_label_epsilon=1e-7;
 	m_sorted_features=SGMatrix<float64_t>();
 	m_sorted_indices=SGMatrix<index_t>();
+	m_random_stream_set=false;
 
 	SG_ADD(&m_pre_sort, "pre_sort", "presort");
 	SG_ADD(&m_sorted_features, "sorted_features", "sorted feats");
@@ -37,6 +37,7 @@
 #include <shogun/multiclass/tree/TreeMachine.h>
 #include <shogun/multiclass/tree/CARTreeNodeData.h>
 #include <shogun/features/DenseFeatures.h>
+#include <shogun/mathematics/RandomStream.h>
 
 namespace shogun
 {
@@ -232,6 +233,13 @@ public:
 
 	void set_sorted_features(SGMatrix<float64_t>& sorted_feats, SGMatrix<index_t>& sorted_indices);
 
+	/** set the stream the feature subsets are drawn from, e.g. one stream
+	 * per tree of a forest. Without a stream the global generator is used.
+	 *
+	 * @param stream random stream
+	 */
+	void set_random_stream(const RandomStream& stream);
+
 protected:
 	/** train machine - build CART from training data
 	 * @param data training data
@@ -464,6 +472,12 @@ protected:
 
 	/** minimum number of feature vectors required in a node **/
 	int32_t m_min_node_size;
+
+	/** stream of the feature subsets **/
+	RandomStream m_random_stream;
+
+	/** flag storing whether the feature subsets are drawn from m_random_stream **/
+	bool m_random_stream_set;
 };
 } /* namespace shogun */
 
@@ -29,8 +29,11 @@
  */
 
 #include <shogun/multiclass/tree/NbodyTree.h>
+#include <shogun/base/Parallel.h>
 #include <shogun/distributions/KernelDensity.h>
 
+#include <vector>
+
 using namespace shogun;
 
 CNbodyTree::CNbodyTree(int32_t leaf_size, EDistanceType d)
@@ -92,6 +95,7 @@ SGVector<float64_t> CNbodyTree::log_kernel_density(SGMatrix<float64_t> test, EKe
 	float64_t log_rtol = std::log(rtol);
 	float64_t log_kernel_norm=CKernelDensity::log_norm(kernel,h,dim);
 	SGVector<float64_t> log_density(test.num_cols);
+	#pragma omp parallel for schedule(dynamic)
 	for (int32_t i=0;i<test.num_cols;i++)
 	{
 		bnode_t* root=NULL;
@@ -121,25 +125,45 @@ SGVector<float64_t> CNbodyTree::log_kernel_density_dual(SGMatrix<float64_t> test
 	int32_t dim=m_data.num_rows;
 	REQUIRE(test.num_rows==dim,"dimensions of training data and test data should be the same\n")
 
-	float64_t log_atol = std::log(atol * m_data.num_cols * test.num_cols);
-	float64_t log_rtol = std::log(rtol);
+	// pruning a pair of nodes may change the kernel sum of each query point
+	// by atol/norm per reference point and by rtol relative to the sum
 	float64_t log_kernel_norm=CKernelDensity::log_norm(kernel,h,dim);
+	float64_t log_atol=std::log(atol)-log_kernel_norm;
+	float64_t log_rtol=std::log(rtol);
 	SGVector<float64_t> log_density(test.num_cols);
-	log_density.fill_vector(log_density.vector,log_density.vlen,-CMath::INFTY);
+	log_density.set_const(-CMath::INFTY);
 
 	bnode_t* rroot=NULL;
 	if (m_root)
 		rroot=dynamic_cast<bnode_t*>(m_root);
 
-	float64_t upper_dist=max_dist_dual(rroot,qroot);
-	float64_t lower_dist=min_dist_dual(rroot,qroot);
-	float64_t min_bound = std::log(test.num_cols) + std::log(m_data.num_cols) +
-	                      CKernelDensity::log_kernel(kernel, upper_dist, h);
-	float64_t max_bound = std::log(test.num_cols) + std::log(m_data.num_cols) +
-	                      CKernelDensity::log_kernel(kernel, lower_dist, h);
-	float64_t spread=logdiffexp(max_bound,min_bound);
+	// the query tree is split into subtrees that are traversed in parallel,
+	// each against the whole reference tree
+	index_t max_task_size=test.num_cols/(16*get_global_parallel()->get_num_threads())+1;
+	std::vector<bnode_t*> tasks;
+	std::vector<bnode_t*> stack(1, qroot);
+	SG_REF(qroot);
+	while (!stack.empty())
+	{
+		bnode_t* node=stack.back();
+		stack.pop_back();
+		if (node->data.is_leaf || node->data.end_idx-node->data.start_idx+1<=max_task_size)
+		{
+			tasks.push_back(node);
+			continue;
+		}
 
-	kde_dual(rroot,qroot,qid,test,log_density,kernel,h,log_atol,log_rtol,log_kernel_norm,min_bound,spread,min_bound,spread);
+		stack.push_back(node->left());
+		stack.push_back(node->right());
+		SG_UNREF(node);
+	}
+
+	#pragma omp parallel for schedule(dynamic, 1)
+	for (index_t i=0; i<index_t(tasks.size()); i++)
+	{
+		kde_dual(rroot,tasks[i],qid,test,log_density,kernel,h,log_atol,log_rtol);
+		SG_UNREF(tasks[i]);
+	}
 
 	float64_t log_n = std::log(m_data.num_cols);
 	for (int32_t i=0;i<test.num_cols;i++)
@@ -301,230 +325,76 @@ void CNbodyTree::get_kde_single(bnode_t* node,float64_t* data, EKernelType kerne
 	SG_UNREF(rchild);
 }
 
-void CNbodyTree::kde_dual(bnode_t* refnode, bnode_t* querynode, SGVector<index_t> qid, SGMatrix<float64_t> qdata, SGVector<float64_t> log_density, EKernelType kernel_type, float64_t h, float64_t log_atol, float64_t log_rtol, float64_t log_norm, float64_t min_bound_node, float64_t spread_node, float64_t &min_bound_global, float64_t &spread_global)
+void CNbodyTree::kde_dual(bnode_t* refnode, bnode_t* querynode, SGVector<index_t> qid, SGMatrix<float64_t> qdata, SGVector<float64_t> log_density, EKernelType kernel_type, float64_t h, float64_t log_atol, float64_t log_rtol)
 {
 	int32_t dim=m_data.num_rows;
-	float64_t n_node =
-	    std::log(refnode->data.end_idx - refnode->data.start_idx + 1) +
-	    std::log(querynode->data.end_idx - querynode->data.start_idx + 1);
-	float64_t n_total = std::log(m_data.num_cols * qdata.num_cols);
 
-	bool global_criterion=(log_norm+spread_global)<=logsumexp(log_atol,log_rtol+log_norm+min_bound_global);
-	bool local_criterion=(log_norm+spread_node+n_total-n_node)<=logsumexp(log_atol,log_rtol+log_norm+min_bound_node);
+	// bounds of the kernel between any query and reference point
+	float64_t log_kernel_max=CKernelDensity::log_kernel(kernel_type,min_dist_dual(querynode,refnode),h);
+	if (log_kernel_max==-CMath::INFTY)
+		return;
+
+	float64_t log_kernel_min=CKernelDensity::log_kernel(kernel_type,max_dist_dual(querynode,refnode),h);
+	index_t ref_n=refnode->data.end_idx-refnode->data.start_idx+1;
 
-	// global bound criterion met || local bound criterion met
-	if (global_criterion || local_criterion)
+	// the mean of the bounds is off by at most half their difference, which
+	// is within the tolerances for every query point
+	if (logdiffexp(log_kernel_max,log_kernel_min)-std::log(2)<=logsumexp(log_atol,log_rtol+log_kernel_min))
 	{
-		// log density of all query points in the node is increased by K(mean + spread/2)
-		float64_t center_density =
-		    logsumexp(min_bound_node, spread_node - std::log(2)) -
-		    std::log(querynode->data.end_idx - querynode->data.start_idx + 1);
+		float64_t contribution=std::log(ref_n)+logsumexp(log_kernel_max,log_kernel_min)-std::log(2);
 		for (int32_t i=querynode->data.start_idx;i<=querynode->data.end_idx;i++)
-			log_density[qid[i]]=logsumexp(log_density[qid[i]],center_density);
+			log_density[qid[i]]=logsumexp(log_density[qid[i]],contribution);
 
 		return;
 	}
 
-	// both are leaves
+	// both are leaves - point by point evaluation of density
 	if (refnode->data.is_leaf && querynode->data.is_leaf)
 	{
-		min_bound_global=logdiffexp(min_bound_global,min_bound_node);
-		spread_global=logdiffexp(spread_global,spread_node);
-
-		// point by point evavuation of density
+		SGVector<float64_t> log_kernels(ref_n);
 		for (int32_t i=querynode->data.start_idx;i<=querynode->data.end_idx;i++)
 		{
-			float64_t q=-CMath::INFTY;
-			for (int32_t j=refnode->data.start_idx;j<=refnode->data.end_idx;j++)
+			float64_t* query=qdata.matrix+int64_t(dim)*qid[i];
+			float64_t max=-CMath::INFTY;
+			for (int32_t j=0;j<ref_n;j++)
 			{
-				float64_t pt_eval=CKernelDensity::log_kernel(kernel_type,distance(m_vec_id[j],qdata.matrix+dim*qid[i],dim),h);
-				q=logsumexp(q,pt_eval);
+				log_kernels[j]=CKernelDensity::log_kernel(kernel_type,distance(m_vec_id[refnode->data.start_idx+j],query,dim),h);
+				max=CMath::max(max,log_kernels[j]);
 			}
 
-			min_bound_global=logsumexp(min_bound_global,q);
-			log_density[qid[i]]=logsumexp(log_density[qid[i]],q);
+			if (max==-CMath::INFTY)
+				continue;
+
+			float64_t sum=0;
+			for (int32_t j=0;j<ref_n;j++)
+				sum+=std::exp(log_kernels[j]-max);
+
+			log_density[qid[i]]=logsumexp(log_density[qid[i]],max+std::log(sum));
 		}
 
 		return;
 	}
 
-	// if query node is leaf - just recurse on the reference tree
-	if (querynode->data.is_leaf)
+	// split the larger node, or the one that is not a leaf
+	index_t query_n=querynode->data.end_idx-querynode->data.start_idx+1;
+	if (querynode->data.is_leaf || (!refnode->data.is_leaf && ref_n>=query_n))
 	{
 		bnode_t* lchild=refnode->left();
 		bnode_t* rchild=refnode->right();
-		int32_t queryn=querynode->data.end_idx-querynode->data.start_idx+1;
-
-		// compute bounds for query node and left child of ref node
-		float64_t lower_dist=min_dist_dual(querynode,lchild);
-		float64_t upper_dist=max_dist_dual(querynode,lchild);
-		int32_t refn_l=lchild->data.end_idx-lchild->data.start_idx+1;
-		float64_t lower_bound_childl =
-		    std::log(queryn) + std::log(refn_l) +
-		    CKernelDensity::log_kernel(kernel_type, upper_dist, h);
-		float64_t spread_childl = logdiffexp(
-		    std::log(queryn) + std::log(refn_l) +
-		        CKernelDensity::log_kernel(kernel_type, lower_dist, h),
-		    lower_bound_childl);
-
-		// compute bounds for query node and right child of ref node
-		lower_dist=min_dist_dual(querynode,rchild);
-		upper_dist=max_dist_dual(querynode,rchild);
-		int32_t refn_r=rchild->data.end_idx-rchild->data.start_idx+1;
-		float64_t lower_bound_childr =
-		    std::log(queryn) + std::log(refn_r) +
-		    CKernelDensity::log_kernel(kernel_type, upper_dist, h);
-		float64_t spread_childr = logdiffexp(
-		    std::log(queryn) + std::log(refn_r) +
-		        CKernelDensity::log_kernel(kernel_type, lower_dist, h),
-		    lower_bound_childr);
-
-		// update global bounds
-		min_bound_global=logdiffexp(min_bound_global,min_bound_node);
-		min_bound_global=logsumexp(min_bound_global,lower_bound_childl);
-		min_bound_global=logsumexp(min_bound_global,lower_bound_childr);
-
-		spread_global=logdiffexp(spread_global,spread_node);
-		spread_global=logsumexp(spread_global,spread_childl);
-		spread_global=logsumexp(spread_global,spread_childr);
-
-		kde_dual(lchild,querynode,qid,qdata,log_density,kernel_type,h,log_atol,log_rtol,log_norm,lower_bound_childl,spread_childl, min_bound_global,spread_global);
-		kde_dual(rchild,querynode,qid,qdata,log_density,kernel_type,h,log_atol,log_rtol,log_norm,lower_bound_childr,spread_childr, min_bound_global,spread_global);
-
+		kde_dual(lchild,querynode,qid,qdata,log_density,kernel_type,h,log_atol,log_rtol);
+		kde_dual(rchild,querynode,qid,qdata,log_density,kernel_type,h,log_atol,log_rtol);
 		SG_UNREF(lchild);
 		SG_UNREF(rchild);
-		return;
 	}
-
-	// if reference node is leaf - just recurse on the query tree
-	if (refnode->data.is_leaf)
+	else
 	{
-		int32_t ref_n=refnode->data.end_idx-refnode->data.start_idx+1;
 		bnode_t* lchild=querynode->left();
 		bnode_t* rchild=querynode->right();
-
-		int32_t query_nl=lchild->data.end_idx-lchild->data.start_idx+1;
-		int32_t query_nr=rchild->data.end_idx-rchild->data.start_idx+1;
-
-		// compute bounds for left child of query node and ref node
-		float64_t lower_dist=min_dist_dual(refnode,lchild);
-		float64_t upper_dist=max_dist_dual(refnode,lchild);
-		float64_t lower_bound_childl =
-		    std::log(query_nl) + std::log(ref_n) +
-		    CKernelDensity::log_kernel(kernel_type, upper_dist, h);
-		float64_t spread_childl = logdiffexp(
-		    std::log(query_nl) + std::log(ref_n) +
-		        CKernelDensity::log_kernel(kernel_type, lower_dist, h),
-		    lower_bound_childl);
-
-		// compute bounds for right child of query node and ref node
-		lower_dist=min_dist_dual(querynode,rchild);
-		upper_dist=max_dist_dual(querynode,rchild);
-		float64_t lower_bound_childr =
-		    std::log(query_nr) + std::log(ref_n) +
-		    CKernelDensity::log_kernel(kernel_type, upper_dist, h);
-		float64_t spread_childr = logdiffexp(
-		    std::log(query_nr) + std::log(ref_n) +
-		        CKernelDensity::log_kernel(kernel_type, lower_dist, h),
-		    lower_bound_childr);
-
-		// update global bounds
-		min_bound_global=logdiffexp(min_bound_global,min_bound_node);
-		min_bound_global=logsumexp(min_bound_global,lower_bound_childl);
-		min_bound_global=logsumexp(min_bound_global,lower_bound_childr);
-
-		spread_global=logdiffexp(spread_global,spread_node);
-		spread_global=logsumexp(spread_global,spread_childl);
-		spread_global=logsumexp(spread_global,spread_childr);
-
-		kde_dual(refnode,lchild,qid,qdata,log_density,kernel_type,h,log_atol,log_rtol,log_norm,lower_bound_childl,spread_childl,min_bound_global,spread_global);
-		kde_dual(refnode,rchild,qid,qdata,log_density,kernel_type,h,log_atol,log_rtol,log_norm,lower_bound_childr,spread_childr,min_bound_global,spread_global);
-
+		kde_dual(refnode,lchild,qid,qdata,log_density,kernel_type,h,log_atol,log_rtol);
+		kde_dual(refnode,rchild,qid,qdata,log_density,kernel_type,h,log_atol,log_rtol);
 		SG_UNREF(lchild);
 		SG_UNREF(rchild);
-		return;
 	}
-
-	// if none of above -  apply 4 way recursion in both trees: left-left, left-right, right-left, right-right
-	bnode_t* refchildl=refnode->left();
-	bnode_t* refchildr=refnode->right();
-	bnode_t* querychildl=querynode->left();
-	bnode_t* querychildr=querynode->right();
-
-	float64_t refn_l=refchildl->data.end_idx-refchildl->data.start_idx+1;
-	float64_t refn_r=refchildr->data.end_idx-refchildr->data.start_idx+1;
-	float64_t queryn_l=querychildl->data.end_idx-querychildl->data.start_idx+1;
-	float64_t queryn_r=querychildr->data.end_idx-querychildr->data.start_idx+1;
-
-	// left child-left child bounds
-	float64_t lower_dist=min_dist_dual(querychildl,refchildl);
-	float64_t upper_dist=max_dist_dual(querychildl,refchildl);
-	float64_t lower_bound_ll =
-	    std::log(queryn_l) + std::log(refn_l) +
-	    CKernelDensity::log_kernel(kernel_type, upper_dist, h);
-	float64_t spread_ll = logdiffexp(
-	    std::log(queryn_l) + std::log(refn_l) +
-	        CKernelDensity::log_kernel(kernel_type, lower_dist, h),
-	    lower_bound_ll);
-
-	// left-right bounds
-	lower_dist=min_dist_dual(querychildl,refchildr);
-	upper_dist=max_dist_dual(querychildl,refchildr);
-	float64_t lower_bound_lr =
-	    std::log(queryn_l) + std::log(refn_r) +
-	    CKernelDensity::log_kernel(kernel_type, upper_dist, h);
-	float64_t spread_lr = logdiffexp(
-	    std::log(queryn_l) + std::log(refn_r) +
-	        CKernelDensity::log_kernel(kernel_type, lower_dist, h),
-	    lower_bound_lr);
-
-	// right-left bounds
-	lower_dist=min_dist_dual(querychildr,refchildl);
-	upper_dist=max_dist_dual(querychildr,refchildl);
-	float64_t lower_bound_rl =
-	    std::log(queryn_r) + std::log(refn_l) +
-	    CKernelDensity::log_kernel(kernel_type, upper_dist, h);
-	float64_t spread_rl = logdiffexp(
-	    std::log(queryn_r) + std::log(refn_l) +
-	        CKernelDensity::log_kernel(kernel_type, lower_dist, h),
-	    lower_bound_rl);
-
-	// right-right bounds
-	lower_dist=min_dist_dual(querychildr,refchildr);
-	upper_dist=max_dist_dual(querychildr,refchildr);
-	float64_t lower_bound_rr =
-	    std::log(queryn_r) + std::log(refn_r) +
-	    CKernelDensity::log_kernel(kernel_type, upper_dist, h);
-	float64_t spread_rr = logdiffexp(
-	    std::log(queryn_r) + std::log(refn_r) +
-	        CKernelDensity::log_kernel(kernel_type, lower_dist, h),
-	    lower_bound_rr);
-
-	// update global bound and spread
-	min_bound_global=logdiffexp(min_bound_global,min_bound_node);
-	min_bound_global=logsumexp(min_bound_global,lower_bound_ll);
-	min_bound_global=logsumexp(min_bound_global,lower_bound_lr);
-	min_bound_global=logsumexp(min_bound_global,lower_bound_rl);
-	min_bound_global=logsumexp(min_bound_global,lower_bound_rr);
-
-	spread_global=logdiffexp(spread_global,spread_node);
-	spread_global=logsumexp(spread_global,spread_ll);
-	spread_global=logsumexp(spread_global,spread_lr);
-	spread_global=logsumexp(spread_global,spread_rl);
-	spread_global=logsumexp(spread_global,spread_rr);
-
-	// left-left and left-right recursions
-	kde_dual(refchildl,querychildl,qid,qdata,log_density,kernel_type,h,log_atol,log_rtol,log_norm,lower_bound_ll,spread_ll, min_bound_global,spread_global);
-	kde_dual(refchildr,querychildl,qid,qdata,log_density,kernel_type,h,log_atol,log_rtol,log_norm,lower_bound_lr,spread_lr, min_bound_global,spread_global);
-
-	// right-left and right-right recursions
-	kde_dual(refchildl,querychildr,qid,qdata,log_density,kernel_type,h,log_atol,log_rtol,log_norm,lower_bound_rl,spread_rl, min_bound_global,spread_global);
-	kde_dual(refchildr,querychildr,qid,qdata,log_density,kernel_type,h,log_atol,log_rtol,log_norm,lower_bound_rr,spread_rr, min_bound_global, spread_global);
-
-	SG_UNREF(refchildl);
-	SG_UNREF(refchildr);
-	SG_UNREF(querychildl);
-	SG_UNREF(querychildr);
 }
 
 void CNbodyTree::partition(index_t dim, index_t start, index_t end, index_t mid)
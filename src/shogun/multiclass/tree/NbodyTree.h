@@ -95,7 +95,10 @@ public:
 	 */
 	SGVector<float64_t> log_kernel_density(SGMatrix<float64_t> test, EKernelType kernel, float64_t h, float64_t atol, float64_t rtol);
 
-	/** get log of kernel density at query points
+	/** get log of kernel density at query points with a dual-tree
+	 * traversal. Subtrees of the query tree are traversed in parallel. The
+	 * error of the density at each query point is at most atol plus rtol
+	 * times the density.
 	 *
 	 * @param test query points at which kernel density is to be calculated
 	 * @param qid id vector of the query tree
@@ -232,26 +235,23 @@ private:
 	void get_kde_single(bnode_t* node,float64_t* data, EKernelType kernel, float64_t h, float64_t log_atol, float64_t log_rtol,
 	float64_t log_norm, float64_t min_bound_node, float64_t spread_node, float64_t &min_bound_global, float64_t &spread_global);
 
-	/** depth-first traversal in dual trees for KDE
+	/** depth-first traversal in dual trees for KDE, adds the kernel sums
+	 * of the points of the reference node to the query points of the query
+	 * node. Pairs of nodes whose kernel bounds are close enough for all
+	 * their points are approximated by the mean of the bounds.
 	 *
 	 * @param refnode current node from reference tree
 	 * @param querynode current node from query tree
 	 * @param qid id vector of query tree
 	 * @param qdata query data matrix
-	 * @param log_density stores log of kernel density at each query point
+	 * @param log_density stores log of kernel sum at each query point
 	 * @param kernel_type kernel type used
 	 * @param h kernel bandwidth
-	 * @param log_atol log absolute tolerance
+	 * @param log_atol log of the absolute error allowed per reference point
 	 * @param log_rtol log relative tolerance
-	 * @param log_norm log of kernel norm
-	 * @param min_bound_node min evaluated kernel in node
-	 * @param spread_node spread of kernel values in node
-	 * @param min_bound_global stores the globally calculated min kernel density for all query points
-	 * @param spread_global spread of kernel values accross entire reference tree for all query points in query tree
 	 */
 	void kde_dual(bnode_t* refnode, bnode_t* querynode, SGVector<index_t> qid, SGMatrix<float64_t> qdata, SGVector<float64_t> log_density,
-	EKernelType kernel_type, float64_t h, float64_t log_atol, float64_t log_rtol, float64_t log_norm, float64_t min_bound_node,
-	float64_t spread_node, float64_t &min_bound_global, float64_t &spread_global);
+	EKernelType kernel_type, float64_t h, float64_t log_atol, float64_t log_rtol);
 
 	/** recursive build
 	 *
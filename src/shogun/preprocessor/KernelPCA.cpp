@@ -16,10 +16,45 @@
 #include <shogun/features/Features.h>
 #include <shogun/io/SGIO.h>
 #include <shogun/kernel/Kernel.h>
+#include <shogun/lib/tapkee/tapkee_shogun.hpp>
 #include <shogun/lib/common.h>
 #include <shogun/mathematics/linalg/LinalgNamespace.h>
+#include <shogun/mathematics/eigen3.h>
 
 using namespace shogun;
+using namespace Eigen;
+
+/* Product of the kernel matrix with a block of vectors, the kernel rows are
+ * computed on the fly. Row sums of the kernel matrix are stored if requested.
+ */
+static void kernel_matrix_product(
+    CKernel* kernel, const MatrixXd& rhs, MatrixXd& result,
+    SGVector<float64_t>* row_sums)
+{
+	const index_t n = rhs.rows();
+	const index_t rows_per_block = 16;
+	result.resize(n, rhs.cols());
+
+#pragma omp parallel
+	{
+		MatrixXd kernel_rows(rows_per_block, n);
+#pragma omp for schedule(dynamic)
+		for (index_t begin = 0; begin < n; begin += rows_per_block)
+		{
+			const index_t size = std::min(rows_per_block, n - begin);
+			for (index_t j = 0; j < n; j++)
+				for (index_t i = 0; i < size; i++)
+					kernel_rows(i, j) = kernel->kernel(begin + i, j);
+
+			result.middleRows(begin, size) = kernel_rows.topRows(size) * rhs;
+			if (row_sums)
+			{
+				for (index_t i = 0; i < size; i++)
+					(*row_sums)[begin + i] = kernel_rows.row(i).sum();
+			}
+		}
+	}
+}
 
 CKernelPCA::CKernelPCA() : CPreprocessor()
 {
@@ -40,6 +75,7 @@ void CKernelPCA::init()
 	m_bias_vector = SGVector<float64_t>();
 	m_target_dim = 1;
 	m_kernel = NULL;
+	m_method = KPCA_DENSE;
 
 	SG_ADD(&m_transformation_matrix, "transformation_matrix",
 		"matrix used to transform data");
@@ -49,6 +85,9 @@ void CKernelPCA::init()
 	    &m_target_dim, "target_dim", "target dimensionality of preprocessor",
 	    ParameterProperties::HYPER);
 	SG_ADD(&m_kernel, "kernel", "kernel to be used", ParameterProperties::HYPER);
+	SG_ADD_OPTIONS(
+	    (machine_int_t*)&m_method, "method", "eigensolver to be used",
+	    ParameterProperties::NONE, SG_OPTIONS(KPCA_DENSE, KPCA_RANDOMIZED));
 }
 
 void CKernelPCA::cleanup()
@@ -79,11 +118,7 @@ void CKernelPCA::fit(CFeatures* features)
 	m_init_features = features;
 
 	m_kernel->init(features, features);
-	SGMatrix<float64_t> kernel_matrix = m_kernel->get_kernel_matrix();
-	m_kernel->cleanup();
-	int32_t n = kernel_matrix.num_cols;
-	int32_t m = kernel_matrix.num_rows;
-	ASSERT(n == m)
+	int32_t n = m_kernel->get_num_vec_lhs();
 	if (m_target_dim > n)
 	{
 		SG_SWARNING(
@@ -94,20 +129,30 @@ void CKernelPCA::fit(CFeatures* features)
 		m_target_dim = n;
 	}
 
-	auto bias_tmp = linalg::rowwise_sum(kernel_matrix);
+	SGVector<float64_t> eigenvalues(m_target_dim);
+	SGMatrix<float64_t> eigenvectors(n, m_target_dim);
+	SGVector<float64_t> bias_tmp;
+	if (m_method == KPCA_RANDOMIZED)
+	{
+		bias_tmp = SGVector<float64_t>(n);
+		compute_randomized_eigenpairs(eigenvalues, eigenvectors, bias_tmp);
+		m_kernel->cleanup();
+	}
+	else
+	{
+		SGMatrix<float64_t> kernel_matrix = m_kernel->get_kernel_matrix();
+		m_kernel->cleanup();
+		bias_tmp = linalg::rowwise_sum(kernel_matrix);
+		linalg::center_matrix(kernel_matrix);
+		linalg::eigen_solver_symmetric(
+		    kernel_matrix, eigenvalues, eigenvectors, m_target_dim);
+	}
+
 	linalg::scale(bias_tmp, bias_tmp, -1.0 / n);
 	auto s = linalg::sum(bias_tmp) / n;
 	linalg::add_scalar(bias_tmp, -s);
 
-	linalg::center_matrix(kernel_matrix);
-
-	SGVector<float64_t> eigenvalues(m_target_dim);
-	SGMatrix<float64_t> eigenvectors(kernel_matrix.num_rows, m_target_dim);
-	linalg::eigen_solver_symmetric(
-	    kernel_matrix, eigenvalues, eigenvectors, m_target_dim);
-
-	m_transformation_matrix =
-	    SGMatrix<float64_t>(kernel_matrix.num_rows, m_target_dim);
+	m_transformation_matrix = SGMatrix<float64_t>(n, m_target_dim);
 	// eigenvalues are in increasing order
 	for (int32_t i = 0; i < m_target_dim; i++)
 	{
@@ -126,6 +171,43 @@ void CKernelPCA::fit(CFeatures* features)
 	SG_INFO("Done\n")
 }
 
+void CKernelPCA::compute_randomized_eigenpairs(
+    SGVector<float64_t>& eigenvalues, SGMatrix<float64_t>& eigenvectors,
+    SGVector<float64_t>& row_sums)
+{
+	/* The centered kernel matrix H K H, H = I - 11'/n, is only used through
+	 * products with blocks, the row sums are stored with the first one. */
+	const index_t n = eigenvectors.num_rows;
+	bool first_block = true;
+	auto centered_product = [&](
+	    SGMatrix<float64_t> block, SGMatrix<float64_t> result) {
+		MatrixXd current = Map<MatrixXd>(block.matrix, n, block.num_cols);
+		current.rowwise() -= current.colwise().mean();
+		MatrixXd product;
+		kernel_matrix_product(
+		    m_kernel, current, product, first_block ? &row_sums : NULL);
+		first_block = false;
+		product.rowwise() -= product.colwise().mean();
+		Map<MatrixXd>(result.matrix, n, block.num_cols) = product;
+	};
+
+	SGVector<float64_t> ritz_values;
+	SGMatrix<float64_t> ritz_vectors;
+	tapkee_randomized_eigenpairs(
+	    centered_product, n, m_target_dim, ritz_values, ritz_vectors);
+	REQUIRE(
+	    ritz_values.vlen >= m_target_dim,
+	    "Kernel matrix has numerical rank %d, less than the target dimension "
+	    "(%d)\n",
+	    ritz_values.vlen, m_target_dim);
+
+	Map<VectorXd>(eigenvalues.vector, m_target_dim) =
+	    Map<VectorXd>(ritz_values.vector, ritz_values.vlen).tail(m_target_dim);
+	Map<MatrixXd>(eigenvectors.matrix, n, m_target_dim) =
+	    Map<MatrixXd>(ritz_vectors.matrix, n, ritz_vectors.num_cols)
+	        .rightCols(m_target_dim);
+}
+
 CFeatures* CKernelPCA::transform(CFeatures* features, bool inplace)
 {
 	assert_fitted();
@@ -243,3 +325,13 @@ CKernel* CKernelPCA::get_kernel() const
 	SG_REF(m_kernel);
 	return m_kernel;
 }
+
+void CKernelPCA::set_method(EKernelPCAMethod method)
+{
+	m_method = method;
+}
+
+EKernelPCAMethod CKernelPCA::get_method() const
+{
+	return m_method;
+}
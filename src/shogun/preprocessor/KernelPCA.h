@@ -20,6 +20,20 @@ namespace shogun
 class CFeatures;
 class CKernel;
 
+/** eigensolvers of KernelPCA */
+enum EKernelPCAMethod
+{
+	/** eigendecomposition of the full kernel matrix.
+	 * Needs O(N^2) memory and O(N^3) time (N-number of vectors)
+	 */
+	KPCA_DENSE,
+	/** randomized block Krylov method on kernel matrix products that are
+	 * computed on the fly. Needs O(Nk) memory and about 5 kernel matrix
+	 * passes (k-target dimension), suitable for large N
+	 */
+	KPCA_RANDOMIZED
+};
+
 /** @brief Preprocessor KernelPCA performs kernel principal component analysis
  *
  * Schoelkopf, B., Smola, A. J., & Mueller, K. R. (1999).
@@ -111,11 +125,33 @@ public:
 		 */
 		CKernel* get_kernel() const;
 
+		/** setter for the eigensolver
+		 * @param method eigensolver
+		 */
+		void set_method(EKernelPCAMethod method);
+
+		/** getter for the eigensolver
+		 * @return eigensolver
+		 */
+		EKernelPCAMethod get_method() const;
+
 	protected:
 
 		/** default init */
 		void init();
 
+		/** computes the leading eigenpairs of the centered kernel matrix
+		 * with the randomized block Krylov method, the kernel has to be
+		 * initialized
+		 *
+		 * @param eigenvalues eigenvalues in increasing order
+		 * @param eigenvectors corresponding eigenvectors
+		 * @param row_sums row sums of the uncentered kernel matrix
+		 */
+		void compute_randomized_eigenpairs(
+		    SGVector<float64_t>& eigenvalues, SGMatrix<float64_t>& eigenvectors,
+		    SGVector<float64_t>& row_sums);
+
 	protected:
 
 		/** features used by init. needed for apply */
@@ -132,6 +168,9 @@ public:
 
 		/** kernel to be used */
 		CKernel* m_kernel;
+
+		/** eigensolver */
+		EKernelPCAMethod m_method;
 };
 }
 #endif
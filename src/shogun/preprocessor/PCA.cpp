@@ -7,6 +7,7 @@
 #include <shogun/lib/config.h>
 
 #include <shogun/features/Features.h>
+#include <shogun/features/streaming/StreamingDenseFeatures.h>
 #include <shogun/io/SGIO.h>
 #include <shogun/mathematics/Math.h>
 #include <shogun/mathematics/eigen3.h>
@@ -16,6 +17,13 @@
 using namespace shogun;
 using namespace Eigen;
 
+/** @return orthonormal basis of the column space of a tall matrix */
+static MatrixXd orthonormal_basis(const MatrixXd& matrix)
+{
+	HouseholderQR<MatrixXd> qr(matrix);
+	return qr.householderQ() * MatrixXd::Identity(matrix.rows(), matrix.cols());
+}
+
 CPCA::CPCA(
     bool do_whitening, EPCAMode mode, float64_t thresh, EPCAMethod method,
     EPCAMemoryMode mem_mode)
@@ -51,6 +59,12 @@ void CPCA::init()
 	m_method = AUTO;
 	m_eigenvalue_zero_tolerance = 1e-15;
 	m_target_dim = 1;
+	m_batch_size = 1000;
+	m_oversampling = 10;
+	m_num_power_iterations = 4;
+	m_singular_values = SGVector<float64_t>();
+	m_components = SGMatrix<float64_t>();
+	m_num_seen = 0;
 
 	SG_ADD(
 	    &m_transformation_matrix, "transformation_matrix",
@@ -83,7 +97,25 @@ void CPCA::init()
 	SG_ADD_OPTIONS(
 	    (machine_int_t*)&m_method, "method",
 	    "Method used for PCA calculation", ParameterProperties::NONE,
-	    SG_OPTIONS(AUTO, SVD, EVD));
+	    SG_OPTIONS(AUTO, SVD, EVD, RANDOMIZED, INCREMENTAL));
+	SG_ADD(
+	    &m_batch_size, "batch_size",
+	    "Number of vectors per batch of incremental PCA");
+	SG_ADD(
+	    &m_oversampling, "oversampling",
+	    "Extra random directions of randomized PCA");
+	SG_ADD(
+	    &m_num_power_iterations, "num_power_iterations",
+	    "Power iterations of randomized PCA");
+	SG_ADD(
+	    &m_singular_values, "singular_values",
+	    "Singular values of the data seen by incremental PCA");
+	SG_ADD(
+	    &m_components, "components",
+	    "Unwhitened basis of the data seen by incremental PCA");
+	SG_ADD(
+	    &m_num_seen, "num_seen",
+	    "Number of vectors seen by incremental PCA");
 }
 
 CPCA::~CPCA()
@@ -95,6 +127,21 @@ void CPCA::fit(CFeatures* features)
 	if (m_fitted)
 		cleanup();
 
+	if (m_method == INCREMENTAL)
+	{
+		partial_fit(features);
+		REQUIRE(
+		    num_dim == m_target_dim,
+		    "target dimension (%d) should be less or equal to than minimum "
+		    "of N (%d) and D (%d)\n",
+		    m_target_dim, m_num_seen, num_old_dim)
+		return;
+	}
+
+	REQUIRE(
+	    m_method != RANDOMIZED || m_mode == FIXED_NUMBER,
+	    "Randomized PCA is only available in FIXED_NUMBER mode\n")
+
 	auto feature_matrix =
 	    features->as<CDenseFeatures<float64_t>>()->get_feature_matrix();
 	auto num_vectors = feature_matrix.num_cols;
@@ -124,6 +171,8 @@ void CPCA::fit(CFeatures* features)
 
 	if (m_method == EVD)
 		init_with_evd(feature_matrix, max_dim_allowed);
+	else if (m_method == RANDOMIZED)
+		init_with_randomized(feature_matrix);
 	else
 		init_with_svd(feature_matrix, max_dim_allowed);
 
@@ -268,24 +317,219 @@ void CPCA::init_with_svd(const SGMatrix<float64_t> &feature_matrix, int32_t max_
 	transformMatrix = svd.matrixV().block(0, 0, num_features, num_dim);
 
 	if (m_whitening)
+		whiten(num_vectors);
+}
+
+void CPCA::init_with_randomized(const SGMatrix<float64_t>& feature_matrix)
+{
+	int32_t num_vectors = feature_matrix.num_cols;
+	int32_t num_features = feature_matrix.num_rows;
+	int32_t num_samples = std::min(
+	    m_target_dim + m_oversampling, std::min(num_vectors, num_features));
+
+	Map<MatrixXd> fmatrix(feature_matrix.matrix, num_features, num_vectors);
+
+	// the image of a gaussian test matrix samples the range of the data
+	MatrixXd test_matrix(num_vectors, num_samples);
+	for (index_t j = 0; j < num_samples; j++)
+		for (index_t i = 0; i < num_vectors; i++)
+			test_matrix(i, j) = CMath::randn_double();
+
+	MatrixXd range = orthonormal_basis(fmatrix * test_matrix);
+
+	// power iterations sharpen the decay of the sampled spectrum, the bases
+	// are orthonormalized in between so small directions do not get lost
+	for (int32_t i = 0; i < m_num_power_iterations; i++)
 	{
-		for (int32_t i = 0; i < num_dim; i++)
+		MatrixXd co_range = orthonormal_basis(fmatrix.transpose() * range);
+		range = orthonormal_basis(fmatrix * co_range);
+	}
+
+	SG_INFO("Computing SVD of %d sampled directions\n", num_samples)
+	MatrixXd projected = range.transpose() * fmatrix;
+	JacobiSVD<MatrixXd> svd(projected, ComputeThinU);
+
+	num_dim = m_target_dim;
+	num_old_dim = num_features;
+	SG_INFO("Reducing from %i to %i features...\n", num_features, num_dim)
+
+	m_eigenvalues_vector = SGVector<float64_t>(num_dim);
+	Map<VectorXd> eigenValues(m_eigenvalues_vector.vector, num_dim);
+	eigenValues = svd.singularValues().head(num_dim);
+	eigenValues = eigenValues.cwiseProduct(eigenValues) / (num_vectors - 1);
+
+	m_transformation_matrix = SGMatrix<float64_t>(num_features, num_dim);
+	Map<MatrixXd> transformMatrix(m_transformation_matrix.matrix, num_features, num_dim);
+	transformMatrix = range * svd.matrixU().leftCols(num_dim);
+
+	if (m_whitening)
+		whiten(num_vectors);
+}
+
+void CPCA::partial_fit(CFeatures* features)
+{
+	REQUIRE(features, "No features provided\n")
+	REQUIRE(
+	    m_mode == FIXED_NUMBER,
+	    "Incremental PCA is only available in FIXED_NUMBER mode\n")
+	REQUIRE(
+	    !m_fitted || m_num_seen,
+	    "PCA was fitted with a non incremental method, call cleanup() "
+	    "first\n")
+	REQUIRE(
+	    m_batch_size > 0, "Batch size (%d) should be positive\n",
+	    m_batch_size)
+
+	if (features->get_feature_class() == C_STREAMING_DENSE)
+	{
+		auto stream = features->as<CStreamingDenseFeatures<float64_t>>();
+		stream->start_parser();
+		for (auto batch = stream->get_next_batch(m_batch_size); batch.num_cols;
+		     batch = stream->get_next_batch(m_batch_size))
+			update_incremental(batch);
+		stream->end_parser();
+	}
+	else
+	{
+		auto feature_matrix =
+		    features->as<CDenseFeatures<float64_t>>()->get_feature_matrix();
+		for (index_t i = 0; i < feature_matrix.num_cols; i += m_batch_size)
 		{
-			if (CMath::fequals_abs<float64_t>(0.0, eigenValues[i], m_eigenvalue_zero_tolerance))
-			{
+			auto num_vectors =
+			    std::min(m_batch_size, feature_matrix.num_cols - i);
+			update_incremental(SGMatrix<float64_t>(
+			    feature_matrix.get_column_vector(i), feature_matrix.num_rows,
+			    num_vectors, false));
+		}
+	}
 
-				SG_WARNING("Covariance matrix has almost zero Eigenvalue (ie "
-					"Eigenvalue within a tolerance of %E around 0) at "
-					"dimension %d. Consider reducing its dimension.",
-					m_eigenvalue_zero_tolerance, i + 1)
+	REQUIRE(
+	    m_num_seen > 1, "At least two vectors are needed, got %d\n",
+	    m_num_seen)
 
-				transformMatrix.col(i) = MatrixXd::Zero(num_features, 1);
-				continue;
-			}
+	set_incremental_transformation();
+	m_fitted = true;
+}
 
-			transformMatrix.col(i) /=
-			    std::sqrt(eigenValues[i] * (num_vectors - 1));
+void CPCA::update_incremental(const SGMatrix<float64_t>& batch)
+{
+	int32_t num_vectors = batch.num_cols;
+	int32_t num_features = batch.num_rows;
+	int32_t num_components = m_singular_values.vlen;
+	if (!num_vectors)
+		return;
+
+	if (m_num_seen)
+	{
+		REQUIRE(
+		    num_features == m_mean_vector.vlen,
+		    "Dimension of the data (%d) does not match the dimension the "
+		    "basis was fitted on (%d)\n",
+		    num_features, m_mean_vector.vlen)
+	}
+	else
+	{
+		m_mean_vector = SGVector<float64_t>(num_features);
+		m_mean_vector.zero();
+	}
+
+	Map<MatrixXd> data(batch.matrix, num_features, num_vectors);
+	Map<VectorXd> mean(m_mean_vector.vector, num_features);
+	VectorXd batch_mean = data.rowwise().sum() / (float64_t)num_vectors;
+	float64_t num_total = (float64_t)m_num_seen + num_vectors;
+
+	// the scaled basis has the same scatter as the data seen so far, the
+	// last row accounts for the shift between the two means
+	int32_t num_rows = num_components + num_vectors + (m_num_seen ? 1 : 0);
+	MatrixXd stacked(num_rows, num_features);
+	if (num_components)
+	{
+		Map<VectorXd> singular_values(m_singular_values.vector, num_components);
+		Map<MatrixXd> components(m_components.matrix, num_features, num_components);
+		stacked.topRows(num_components) =
+		    singular_values.asDiagonal() * components.transpose();
+	}
+	stacked.middleRows(num_components, num_vectors) =
+	    (data.colwise() - batch_mean).transpose();
+	if (m_num_seen)
+	{
+		stacked.bottomRows(1) =
+		    std::sqrt(m_num_seen * num_vectors / num_total) *
+		    (mean - batch_mean).transpose();
+	}
+	mean = (m_num_seen * mean + num_vectors * batch_mean) / num_total;
+	m_num_seen += num_vectors;
+
+	// right singular vectors of the stacked matrix, from the SVD of the
+	// triangular factor of a QR decomposition along its longer side
+	num_components = std::min(m_target_dim, std::min(num_rows, num_features));
+	m_singular_values = SGVector<float64_t>(num_components);
+	m_components = SGMatrix<float64_t>(num_features, num_components);
+	Map<VectorXd> singular_values(m_singular_values.vector, num_components);
+	Map<MatrixXd> components(m_components.matrix, num_features, num_components);
+
+	if (num_rows < num_features)
+	{
+		HouseholderQR<MatrixXd> qr(stacked.transpose());
+		MatrixXd r = qr.matrixQR().topRows(num_rows).triangularView<Upper>();
+		JacobiSVD<MatrixXd> svd(r.transpose(), ComputeThinV);
+
+		MatrixXd basis = MatrixXd::Zero(num_features, num_components);
+		basis.topRows(num_rows) = svd.matrixV().leftCols(num_components);
+		basis.applyOnTheLeft(qr.householderQ());
+		components = basis;
+		singular_values = svd.singularValues().head(num_components);
+	}
+	else
+	{
+		HouseholderQR<MatrixXd> qr(stacked);
+		MatrixXd r = qr.matrixQR().topRows(num_features).triangularView<Upper>();
+		JacobiSVD<MatrixXd> svd(r, ComputeThinV);
+
+		components = svd.matrixV().leftCols(num_components);
+		singular_values = svd.singularValues().head(num_components);
+	}
+}
+
+void CPCA::set_incremental_transformation()
+{
+	num_dim = m_singular_values.vlen;
+	num_old_dim = m_components.num_rows;
+	SG_INFO("Reducing from %i to %i features...\n", num_old_dim, num_dim)
+
+	m_eigenvalues_vector = SGVector<float64_t>(num_dim);
+	for (index_t i = 0; i < num_dim; i++)
+	{
+		m_eigenvalues_vector[i] = m_singular_values[i] * m_singular_values[i] /
+		                          (m_num_seen - 1);
+	}
+
+	m_transformation_matrix = m_components.clone();
+	if (m_whitening)
+		whiten(m_num_seen);
+}
+
+void CPCA::whiten(int32_t num_vectors)
+{
+	Map<MatrixXd> transformMatrix(m_transformation_matrix.matrix,
+		m_transformation_matrix.num_rows, m_transformation_matrix.num_cols);
+
+	for (int32_t i = 0; i < num_dim; i++)
+	{
+		if (CMath::fequals_abs<float64_t>(0.0, m_eigenvalues_vector[i], m_eigenvalue_zero_tolerance))
+		{
+
+			SG_WARNING("Covariance matrix has almost zero Eigenvalue (ie "
+				"Eigenvalue within a tolerance of %E around 0) at "
+				"dimension %d. Consider reducing its dimension.",
+				m_eigenvalue_zero_tolerance, i + 1)
+
+			transformMatrix.col(i) = MatrixXd::Zero(transformMatrix.rows(), 1);
+			continue;
 		}
+
+		transformMatrix.col(i) /=
+		    std::sqrt(m_eigenvalues_vector[i] * (num_vectors - 1));
 	}
 }
 
@@ -294,6 +538,9 @@ void CPCA::cleanup()
 	m_transformation_matrix=SGMatrix<float64_t>();
         m_mean_vector = SGVector<float64_t>();
         m_eigenvalues_vector = SGVector<float64_t>();
+	m_singular_values = SGVector<float64_t>();
+	m_components = SGMatrix<float64_t>();
+	m_num_seen = 0;
 	    m_fitted = false;
 }
 
@@ -409,3 +656,36 @@ int32_t CPCA::get_target_dim() const
 {
 	return m_target_dim;
 }
+
+void CPCA::set_batch_size(int32_t batch_size)
+{
+	ASSERT(batch_size > 0)
+	m_batch_size = batch_size;
+}
+
+int32_t CPCA::get_batch_size() const
+{
+	return m_batch_size;
+}
+
+void CPCA::set_oversampling(int32_t oversampling)
+{
+	ASSERT(oversampling >= 0)
+	m_oversampling = oversampling;
+}
+
+int32_t CPCA::get_oversampling() const
+{
+	return m_oversampling;
+}
+
+void CPCA::set_num_power_iterations(int32_t num_power_iterations)
+{
+	ASSERT(num_power_iterations >= 0)
+	m_num_power_iterations = num_power_iterations;
+}
+
+int32_t CPCA::get_num_power_iterations() const
+{
+	return m_num_power_iterations;
+}
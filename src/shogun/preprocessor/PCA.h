@@ -29,7 +29,20 @@ enum EPCAMethod
 	/** Eigenvalue decomposition of covariance matrix.
 	 * Time complexity ~10d^3 (d-dimensions n-number of vectors)
 	 */
-	EVD = 30
+	EVD = 30,
+	/** Randomized SVD of the data matrix (Halko et al., 2011) for the target
+	 * dimension t. Time complexity ~(2q+4)dnk for k=t+oversampling and q
+	 * power iterations, neither the covariance nor a full SVD is formed.
+	 * Only available in FIXED_NUMBER mode.
+	 */
+	RANDOMIZED = 40,
+	/** Incremental PCA (Ross et al., 2008). The data are consumed in
+	 * batches and the basis is updated after each one, so only a batch and
+	 * the current basis are kept in memory. Accepts streaming features.
+	 * Time complexity ~dn(t+b) for batch size b. Only available in
+	 * FIXED_NUMBER mode.
+	 */
+	INCREMENTAL = 50
 };
 
 /** mode of pca */
@@ -86,6 +99,21 @@ enum EPCAMemoryMode
  * <em>AUTO</em> : This mode automagically chooses one of the above modes for the user
  * based on whether N > D (chooses EVD) or N < D (chooses SVD).
  *
+ * Two more methods only compute the leading T eigenvectors and are meant for
+ * large data, they require the FIXED_NUMBER mode and return the eigenvalues
+ * in descending order :
+ *
+ * <em>RANDOMIZED</em> : The range of X is sampled with a Gaussian test matrix
+ * of T+oversampling columns, refined by a few power iterations, and the SVD
+ * is computed in that subspace (Halko, Martinsson, Tropp, 2011).
+ *
+ * <em>INCREMENTAL</em> : X is processed in batches of columns. Each batch is
+ * stacked below the current basis scaled by its singular values, together with
+ * a row correcting for the shift of the mean, and the SVD of that small matrix
+ * gives the updated basis (Ross et al., 2008). fit() accepts
+ * CStreamingDenseFeatures, which are consumed batch by batch, and
+ * partial_fit() updates an existing basis with another chunk of data.
+ *
  * This class provides 3 modes to determine the value of T :
  *
  * <em>FIXED_NUMBER</em> : T is supplied by user directly using set_target_dims method
@@ -132,6 +160,15 @@ class CPCA : public CDensePreprocessor<float64_t>
 
 		virtual void fit(CFeatures* features);
 
+		/** updates the basis with more data, as in INCREMENTAL method. Starts
+		 * from scratch if the preprocessor is not fitted yet. Dense features
+		 * are processed in batches, streaming features are consumed until
+		 * the stream ends. Requires FIXED_NUMBER mode.
+		 *
+		 * @param features CDenseFeatures or CStreamingDenseFeatures
+		 */
+		void partial_fit(CFeatures* features);
+
 		/** cleanup */
 		virtual void cleanup();
 
@@ -188,6 +225,38 @@ class CPCA : public CDensePreprocessor<float64_t>
 		 */
 		int32_t get_target_dim() const;
 
+		/** setter for the number of vectors per batch of INCREMENTAL method
+		 * @param batch_size batch size
+		 */
+		void set_batch_size(int32_t batch_size);
+
+		/** getter for the number of vectors per batch of INCREMENTAL method
+		 * @return batch size
+		 */
+		int32_t get_batch_size() const;
+
+		/** setter for the number of extra random directions of RANDOMIZED
+		 * method
+		 * @param oversampling oversampling
+		 */
+		void set_oversampling(int32_t oversampling);
+
+		/** getter for the number of extra random directions of RANDOMIZED
+		 * method
+		 * @return oversampling
+		 */
+		int32_t get_oversampling() const;
+
+		/** setter for the number of power iterations of RANDOMIZED method
+		 * @param num_power_iterations number of power iterations
+		 */
+		void set_num_power_iterations(int32_t num_power_iterations);
+
+		/** getter for the number of power iterations of RANDOMIZED method
+		 * @return number of power iterations
+		 */
+		int32_t get_num_power_iterations() const;
+
 	protected:
 
 		void init();
@@ -225,11 +294,35 @@ class CPCA : public CDensePreprocessor<float64_t>
 		/** target dimension */
 		int32_t m_target_dim;
 
+		/** number of vectors per batch of INCREMENTAL method */
+		int32_t m_batch_size;
+		/** extra random directions of RANDOMIZED method */
+		int32_t m_oversampling;
+		/** power iterations of RANDOMIZED method */
+		int32_t m_num_power_iterations;
+
+		/** singular values of the data seen so far, INCREMENTAL method */
+		SGVector<float64_t> m_singular_values;
+		/** unwhitened basis of the data seen so far, INCREMENTAL method */
+		SGMatrix<float64_t> m_components;
+		/** number of vectors seen so far, INCREMENTAL method */
+		int32_t m_num_seen;
+
 	private:
 		/** Computes the transformation matrix using an eigenvalue decomposition. */
 		void init_with_evd(const SGMatrix<float64_t>& feature_matrix, int32_t max_dim_allowed);
 		/** Computes the transformation matrix using svd */
 		void init_with_svd(const SGMatrix<float64_t>& feature_matrix, int32_t max_dim_allowed);
+		/** Computes the transformation matrix using randomized svd */
+		void init_with_randomized(const SGMatrix<float64_t>& feature_matrix);
+		/** Updates the incremental basis with a batch of vectors */
+		void update_incremental(const SGMatrix<float64_t>& batch);
+		/** Sets the transformation matrix from the incremental basis */
+		void set_incremental_transformation();
+		/** Scales the columns of the transformation matrix to unit variance,
+		 * for eigenvalues in descending order
+		 */
+		void whiten(int32_t num_vectors);
 };
 }
 #endif // PCA_H_
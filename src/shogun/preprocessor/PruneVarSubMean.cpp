@@ -8,6 +8,7 @@
 #include <shogun/features/Features.h>
 #include <shogun/io/SGIO.h>
 #include <shogun/mathematics/Math.h>
+#include <shogun/mathematics/StatisticsAccumulator.h>
 #include <shogun/mathematics/linalg/LinalgNamespace.h>
 #include <shogun/preprocessor/DensePreprocessor.h>
 #include <shogun/preprocessor/PruneVarSubMean.h>
@@ -32,39 +33,21 @@ void CPruneVarSubMean::fit(CFeatures* features)
 	if (m_fitted)
 		cleanup();
 
-	auto simple_features = features->as<CDenseFeatures<float64_t>>();
-	auto num_examples = simple_features->get_num_vectors();
-	auto num_features = simple_features->get_num_features();
-
 	m_idx = SGVector<int32_t>();
 	m_std = SGVector<float64_t>();
 
-	SGVector<float64_t> var(num_features);
-
-	auto feature_matrix = simple_features->get_feature_matrix();
+	StatisticsAccumulator<float64_t> statistics;
+	statistics.add(features);
+	auto num_features = statistics.get_dim();
 
-	// compute mean
-	m_mean = linalg::rowwise_sum(feature_matrix);
-	linalg::scale(m_mean, m_mean, 1.0 / num_examples);
-
-	// compute var
-	for (auto i : range(num_examples))
-	{
-		for (auto j : range(num_features))
-		{
-			auto diff =
-			    linalg::add(m_mean, feature_matrix.get_column(i), 1.0, -1.0);
-			var[j] += linalg::dot(diff, diff);
-		}
-	}
+	m_mean = statistics.get_mean();
+	auto var = statistics.get_variance();
 
 	int32_t num_ok = 0;
 	auto idx_ok = SGVector<int32_t>(num_features);
 
 	for (auto j : range(num_features))
 	{
-		var[j] /= num_examples;
-
 		if (var[j] >= 1e-14)
 		{
 			idx_ok[num_ok] = j;
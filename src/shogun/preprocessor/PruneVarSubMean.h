@@ -35,7 +35,7 @@ class CPruneVarSubMean : public CDensePreprocessor<float64_t>
 		/** destructor */
 		virtual ~CPruneVarSubMean();
 
-		/// Fit preprocessor into features
+		/// Fit preprocessor into dense or streaming dense features
 		virtual void fit(CFeatures* features);
 
 		/// cleanup
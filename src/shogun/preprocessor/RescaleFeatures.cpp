@@ -6,6 +6,7 @@
 
 #include <algorithm>
 #include <shogun/base/range.h>
+#include <shogun/mathematics/StatisticsAccumulator.h>
 #include <shogun/mathematics/linalg/LinalgNamespace.h>
 #include <shogun/preprocessor/RescaleFeatures.h>
 
@@ -26,35 +27,24 @@ void CRescaleFeatures::fit(CFeatures* features)
 	if (m_fitted)
 		cleanup();
 
-	auto simple_features = features->as<CDenseFeatures<float64_t>>();
-	int32_t num_examples = simple_features->get_num_vectors();
-	int32_t num_features = simple_features->get_num_features();
+	StatisticsAccumulator<float64_t> statistics;
+	statistics.add(features);
+	int32_t num_features = statistics.get_dim();
 	REQUIRE(
-	    num_examples > 1, "number of feature vectors should be at least 2!\n");
+	    statistics.get_num_vectors() > 1,
+	    "number of feature vectors should be at least 2!\n");
 
 	SG_INFO("Extracting min and range values for each feature\n")
 
-	m_min = SGVector<float64_t>(num_features);
+	m_min = statistics.get_min();
 	m_range = SGVector<float64_t>(num_features);
-	auto feature_matrix = simple_features->get_feature_matrix();
+	auto max = statistics.get_max();
 	for (index_t i = 0; i < num_features; i++)
 	{
-		SGVector<float64_t> vec = feature_matrix.get_row_vector(i);
-		float64_t cur_min = vec[0];
-		float64_t cur_max = vec[0];
-
-		/* find the max and min values in one loop */
-		for (index_t j = 1; j < vec.vlen; j++)
-		{
-			cur_min = std::min(vec[j], cur_min);
-			cur_max = std::max(vec[j], cur_max);
-		}
-
 		/* only rescale if range > 0 */
-		if ((cur_max - cur_min) > 0)
+		if ((max[i] - m_min[i]) > 0)
 		{
-			m_min[i] = cur_min;
-			m_range[i] = 1.0 / (cur_max - cur_min);
+			m_range[i] = 1.0 / (max[i] - m_min[i]);
 		}
 		else
 		{
@@ -36,7 +36,7 @@ namespace shogun
 		 * Fit preprocessor into features
 		 *
 		 * @param features the features to derive the min and max values
-		 * from.
+		 * from, dense or streaming dense.
 		 */
 		virtual void fit(CFeatures* features);
 
@@ -31,13 +31,114 @@
 
 #include <limits>
 #include <shogun/regression/KRRNystrom.h>
+#include <shogun/features/DenseFeatures.h>
+#include <shogun/features/streaming/StreamingDenseFeatures.h>
 #include <shogun/labels/RegressionLabels.h>
 #include <shogun/mathematics/eigen3.h>
 #include <shogun/mathematics/Math.h>
 
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
 using namespace shogun;
 using namespace Eigen;
 
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+/* kernel between the points rows and cols, one column per point of rows */
+static void kernel_block(CKernel* kernel, const int32_t* rows, index_t num_rows,
+		const int32_t* cols, index_t num_cols, MatrixXd& block)
+{
+	block.resize(num_cols, num_rows);
+	#pragma omp parallel for schedule(static)
+	for (index_t i=0; i<num_rows; ++i)
+	{
+		for (index_t j=0; j<num_cols; ++j)
+			block(j,i)=kernel->kernel(rows[i], cols[j]);
+	}
+}
+
+/* ridge parameter for which about k points of the weighted sample have a
+ * large leverage, i.e. the mass of its spectrum beyond the k largest
+ * eigenvalues divided by k */
+static float64_t ridge_parameter(CKernel* kernel,
+		const std::vector<int32_t>& sample, const VectorXd& weights, index_t k)
+{
+	const float64_t min_ridge=1e-5;
+	const index_t num=sample.size();
+	if (k>=num)
+		return min_ridge;
+
+	MatrixXd K_ss;
+	kernel_block(kernel, sample.data(), num, sample.data(), num, K_ss);
+	K_ss=weights.asDiagonal()*K_ss*weights.asDiagonal();
+	SelfAdjointEigenSolver<MatrixXd> solver(K_ss, EigenvaluesOnly);
+	float64_t ridge=K_ss.trace()-solver.eigenvalues().tail(k).cwiseAbs().sum();
+	return CMath::max(ridge/k, min_ridge);
+}
+
+/* ridge leverage scores of points with respect to the weighted sample,
+ * (k(x,x)-k_xS (K_SS+lambda W^-2)^-1 k_Sx)/lambda */
+static void ridge_leverage_scores(CKernel* kernel, const int32_t* points,
+		index_t num_points, const std::vector<int32_t>& sample,
+		const VectorXd& weights, float64_t lambda, index_t block_size,
+		float64_t* scores)
+{
+	const index_t num=sample.size();
+	MatrixXd K_ss;
+	kernel_block(kernel, sample.data(), num, sample.data(), num, K_ss);
+	K_ss.diagonal()+=lambda*weights.cwiseAbs2().cwiseInverse();
+	LLT<MatrixXd> llt(K_ss);
+
+	MatrixXd block;
+	for (index_t start=0; start<num_points; start+=block_size)
+	{
+		const index_t len=CMath::min(block_size, num_points-start);
+		kernel_block(kernel, points+start, len, sample.data(), num, block);
+		llt.matrixL().solveInPlace(block);
+
+		#pragma omp parallel for schedule(static)
+		for (index_t i=0; i<len; ++i)
+		{
+			const int32_t point=points[start+i];
+			float64_t residual=kernel->kernel(point, point)-block.col(i).squaredNorm();
+			scores[start+i]=CMath::max(residual, 0.0)/lambda;
+		}
+	}
+}
+
+/* alpha=Kplus^+ K_mn_y, applying the pseudoinverse in the eigenbasis of
+ * Kplus, of which only the lower triangle is read */
+static bool solve_pseudoinverse(MatrixXd& Kplus, const VectorXd& K_mn_y,
+		SGVector<float64_t>& alpha)
+{
+	const index_t m=Kplus.rows();
+	SelfAdjointEigenSolver<MatrixXd> solver(Kplus);
+	if (solver.info()!=Success)
+	{
+		SG_SWARNING("Eigendecomposition failed.\n")
+		return false;
+	}
+	Kplus.resize(0, 0);
+
+	const VectorXd& D=solver.eigenvalues();
+	float64_t dbl_epsilon=std::numeric_limits<float64_t>::epsilon();
+	const float64_t tolerance=m*dbl_epsilon*D.maxCoeff();
+	VectorXd projected=solver.eigenvectors().transpose()*K_mn_y;
+	for (index_t i=0; i<m; ++i)
+	{
+		if (D(i)<tolerance)
+			projected(i)=0;
+		else
+			projected(i)/=D(i);
+	}
+
+	alpha=SGVector<float64_t>(m);
+	Map<VectorXd>(alpha.vector, m)=solver.eigenvectors()*projected;
+	return true;
+}
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
 CKRRNystrom::CKRRNystrom() : CKernelRidgeRegression()
 {
 	init();
@@ -54,13 +155,25 @@ CKRRNystrom::CKRRNystrom(float64_t tau, int32_t m, CKernel* k, CLabels* lab)
 void CKRRNystrom::init()
 {
 	m_num_rkhs_basis=0;
+	m_landmark_sampling=LANDMARKS_UNIFORM;
+	m_block_size=1024;
 	SG_ADD(
 	    &m_num_rkhs_basis, "num_rkhs_basis", "Number of rows/columns to sample",
 	    ParameterProperties::HYPER);
+	SG_ADD_OPTIONS(
+	    (machine_int_t*)&m_landmark_sampling, "landmark_sampling",
+	    "How rows/columns are sampled", ParameterProperties::NONE,
+	    SG_OPTIONS(LANDMARKS_UNIFORM, LANDMARKS_RIDGE_LEVERAGE));
+	SG_ADD(
+	    &m_block_size, "block_size",
+	    "Number of training points whose kernel rows are computed at once");
 }
 
 SGVector<int32_t> CKRRNystrom::subsample_indices()
 {
+	if (m_landmark_sampling==LANDMARKS_RIDGE_LEVERAGE)
+		return ridge_leverage_indices();
+
 	int32_t n=kernel->get_num_vec_lhs();
 	SGVector<int32_t> temp(n);
 	temp.range_fill();
@@ -73,6 +186,77 @@ SGVector<int32_t> CKRRNystrom::subsample_indices()
 	return col;
 }
 
+SGVector<int32_t> CKRRNystrom::ridge_leverage_indices()
+{
+	const index_t n=kernel->get_num_vec_lhs();
+	const index_t m=m_num_rkhs_basis;
+	SGVector<int32_t> perm(n);
+	perm.range_fill();
+	if (m>=n)
+		return perm;
+	CMath::permute(perm);
+
+	/* the first size points of the permutation for halving sizes, the
+	 * smallest with at most m points */
+	std::vector<index_t> sizes(1, n);
+	while (sizes.back()>m)
+		sizes.push_back((sizes.back()+1)/2);
+
+	const float64_t oversample=CMath::max(std::log(float64_t(m)), 1.0);
+	const index_t k=CMath::max(index_t(std::ceil(m/(4*oversample))), 1);
+
+	std::vector<int32_t> sample(perm.vector, perm.vector+sizes.back());
+	VectorXd weights=VectorXd::Ones(sample.size());
+	SGVector<float64_t> scores(n);
+	for (auto level=sizes.size()-1; level-->0; )
+	{
+		const index_t num=sizes[level];
+		float64_t lambda=ridge_parameter(kernel, sample, weights, k);
+		ridge_leverage_scores(kernel, perm.vector, num, sample, weights,
+				lambda, m_block_size, scores.vector);
+		if (level==0)
+			break;
+
+		/* keep every point with its oversampled score as probability,
+		 * weighted by its inverse square root */
+		std::vector<int32_t> next;
+		std::vector<float64_t> next_weights;
+		for (index_t i=0; i<num; ++i)
+		{
+			float64_t p=CMath::min(oversample*scores[i], 1.0);
+			if (p>0 && CMath::random(0.0, 1.0)<p)
+			{
+				next.push_back(perm[i]);
+				next_weights.push_back(1/std::sqrt(p));
+			}
+		}
+		if (next.empty())
+		{
+			next.assign(perm.vector, perm.vector+CMath::min(num, m));
+			next_weights.assign(next.size(), 1.0);
+		}
+		sample.swap(next);
+		weights=Map<VectorXd>(next_weights.data(), next_weights.size());
+	}
+
+	/* m points without replacement with probabilities proportional to the
+	 * scores, i.e. the largest keys log(u)/score for uniform u */
+	const float64_t min_score=std::numeric_limits<float64_t>::min();
+	for (index_t i=0; i<n; ++i)
+		scores[i]=std::log(CMath::random(0.0, 1.0))/CMath::max(scores[i], min_score);
+	std::vector<index_t> order(n);
+	std::iota(order.begin(), order.end(), 0);
+	std::nth_element(order.begin(), order.begin()+m, order.end(),
+			[&scores](index_t a, index_t b) { return scores[a]>scores[b]; });
+
+	SGVector<int32_t> col(m);
+	for (index_t i=0; i<m; ++i)
+		col[i]=perm[order[i]];
+	CMath::qsort(col.vector, m);
+
+	return col;
+}
+
 bool CKRRNystrom::train_machine(CFeatures* data)
 {
 	REQUIRE(data, "No features provided.\n");
@@ -99,54 +283,113 @@ bool CKRRNystrom::solve_krr_system()
 	if (!y.data())
 		SG_ERROR("Labels not set.\n");
 	SGVector<int32_t> col=subsample_indices();
-	SGMatrix<float64_t> K_mm(m_num_rkhs_basis, m_num_rkhs_basis);
-	SGMatrix<float64_t> K_nm(n, m_num_rkhs_basis);
-	#pragma omp parallel for
-	for (index_t j=0; j<m_num_rkhs_basis; ++j)
-	{
-		for (index_t i=0; i<n; ++i)
-			K_nm(i,j)=kernel->kernel(i,col[j]);
-	}
-	#pragma omp parallel for
-	for (index_t i=0; i<m_num_rkhs_basis; ++i)
-		sg_memcpy(K_mm.matrix+i*m_num_rkhs_basis, K_nm.get_row_vector(col[i]), m_num_rkhs_basis*sizeof(float64_t));
+	const index_t m=m_num_rkhs_basis;
 
-	Map<MatrixXd> K_mm_eig(K_mm.matrix, m_num_rkhs_basis, m_num_rkhs_basis);
-	Map<MatrixXd> K_nm_eig(K_nm.matrix, n, m_num_rkhs_basis);
-	MatrixXd K_mn_eig = K_nm_eig.transpose();
+	/* tau*K_mm+K_mn*K_nm and K_mn*y, the rows of K_nm are computed for a
+	 * block of training points at a time. Only the lower triangle of
+	 * Kplus is updated, which is all the eigensolver reads */
+	MatrixXd Kplus;
+	kernel_block(kernel, col.vector, m, col.vector, m, Kplus);
+	Kplus*=m_tau;
+	VectorXd K_mn_y=VectorXd::Zero(m);
 	Map<VectorXd> y_eig(y.vector, n);
-	VectorXd alphas_eig(m_num_rkhs_basis);
 
-	/* Calculate the Moore-Penrose pseudoinverse */
-	MatrixXd Kplus=K_mn_eig*K_nm_eig+m_tau*K_mm_eig;
-	SelfAdjointEigenSolver<MatrixXd> solver(Kplus);
-	if (solver.info()!=Success)
+	std::vector<int32_t> rows(m_block_size);
+	MatrixXd block;
+	for (index_t start=0; start<n; start+=m_block_size)
 	{
-		SG_WARNING("Eigendecomposition failed.\n")
+		const index_t len=CMath::min(m_block_size, n-start);
+		std::iota(rows.begin(), rows.begin()+len, start);
+		kernel_block(kernel, rows.data(), len, col.vector, m, block);
+		Kplus.selfadjointView<Lower>().rankUpdate(block);
+		K_mn_y.noalias()+=block*y_eig.segment(start, len);
+	}
+
+	if (!solve_pseudoinverse(Kplus, K_mn_y, m_alpha))
 		return false;
+
+	/* The sampled training points are the support vectors */
+	m_svs=col;
+
+	return true;
+}
+
+bool CKRRNystrom::train_streaming(CStreamingDenseFeatures<float64_t>* data)
+{
+	REQUIRE(data, "No features provided.\n");
+	REQUIRE(kernel, "Kernel not set.\n");
+	REQUIRE(m_num_rkhs_basis>0, "Number of sampled rows has to be set "
+			"when training on a stream.\n");
+	REQUIRE(m_landmark_sampling==LANDMARKS_UNIFORM, "Only uniform sampling "
+			"of the rows is supported when training on a stream.\n");
+	const index_t m=m_num_rkhs_basis;
+
+	data->start_parser();
+
+	/* the first m examples are the sampled training points */
+	SGMatrix<float64_t> batch=data->get_next_batch(m);
+	SGVector<float64_t> y=data->get_batch_labels();
+	if (batch.num_cols<m)
+	{
+		data->end_parser();
+		SG_ERROR("Number of sampled rows (%d) must be less than number of "
+				"data points (%d).\n", m, batch.num_cols);
+	}
+	if (y.vlen!=batch.num_cols)
+	{
+		data->end_parser();
+		SG_ERROR("Labels not set.\n");
 	}
 
-	/* Solve the system for alphas */
-	MatrixXd D=solver.eigenvalues().asDiagonal();
-	MatrixXd eigvec=solver.eigenvectors();
-	float64_t dbl_epsilon=std::numeric_limits<float64_t>::epsilon();
-	const float64_t tolerance=m_num_rkhs_basis*dbl_epsilon*D.maxCoeff();
-	for (index_t i=0; i<m_num_rkhs_basis; ++i)
+	CDenseFeatures<float64_t>* landmarks=new CDenseFeatures<float64_t>(batch);
+	SG_REF(landmarks);
+	kernel->init(landmarks, landmarks);
+
+	std::vector<int32_t> col(m);
+	std::iota(col.begin(), col.end(), 0);
+	MatrixXd Kplus;
+	kernel_block(kernel, col.data(), m, col.data(), m, Kplus);
+
+	/* the sampled points are training points as well */
+	MatrixXd block=Kplus;
+	Kplus*=m_tau;
+	Kplus.selfadjointView<Lower>().rankUpdate(block);
+	VectorXd K_mn_y=block*Map<VectorXd>(y.vector, y.vlen);
+	int64_t num_seen=m;
+
+	/* every further block of examples is dropped once its kernel rows
+	 * are accumulated */
+	std::vector<int32_t> rows(m_block_size);
+	std::iota(rows.begin(), rows.end(), 0);
+	while ((batch=data->get_next_batch(m_block_size)).num_cols)
 	{
-		if (D(i,i)<tolerance)
-			D(i,i)=0;
-		else
-			D(i,i)=1/D(i,i);
+		y=data->get_batch_labels();
+		if (y.vlen!=batch.num_cols)
+		{
+			data->end_parser();
+			SG_UNREF(landmarks);
+			SG_ERROR("Labels not set.\n");
+		}
+
+		CDenseFeatures<float64_t>* points=new CDenseFeatures<float64_t>(batch);
+		kernel->init(points, landmarks);
+		kernel_block(kernel, rows.data(), batch.num_cols, col.data(), m, block);
+		Kplus.selfadjointView<Lower>().rankUpdate(block);
+		K_mn_y.noalias()+=block*Map<VectorXd>(y.vector, y.vlen);
+		num_seen+=batch.num_cols;
 	}
-	MatrixXd pseudoinv=eigvec*D*eigvec.transpose();
-	alphas_eig=pseudoinv*K_mn_eig*y_eig;
+	data->end_parser();
+	SG_DEBUG("Accumulated %" PRId64 " training points\n", num_seen);
 
-	/* Expand alpha with zeros to size n */
-	SGVector<float64_t> alpha_n(n);
-	alpha_n.zero();
-	for (index_t i=0; i<m_num_rkhs_basis; ++i)
-		alpha_n[col[i]]=alphas_eig[i];
-	m_alpha=alpha_n;
+	/* the model is the sampled points, which are the kernel's lhs */
+	kernel->init(landmarks, landmarks);
+	SG_UNREF(landmarks);
+
+	if (!solve_pseudoinverse(Kplus, K_mn_y, m_alpha))
+		return false;
+
+	m_svs=SGVector<int32_t>(m);
+	m_svs.range_fill();
 
 	return true;
 }
@@ -36,6 +36,19 @@
 
 namespace shogun {
 
+template <class T> class CStreamingDenseFeatures;
+
+/** how the rows/columns of the kernel matrix are sampled */
+enum ELandmarkSampling
+{
+	/** uniformly without replacement */
+	LANDMARKS_UNIFORM,
+	/** proportionally to approximate ridge leverage scores, which are
+	 * computed by recursive ridge leverage score sampling
+	 */
+	LANDMARKS_RIDGE_LEVERAGE
+};
+
 /** @brief Class KRRNystrom implements the Nyström method for kernel ridge
  * regression, using a low-rank approximation to the kernel matrix.
  *
@@ -57,9 +70,28 @@ namespace shogun {
  * corresponding to the training examples chosen. \f$+\f$ indicates the
  * Moore-Penrose pseudoinverse. The complexity is \f$O(m^2n)\f$.
  *
- * Several ways to subsample columns/rows have been proposed. Here they are
- * subsampled uniformly. To implement another sampling method one has to
- * override the method 'subsample_indices'.
+ * Several ways to subsample columns/rows have been proposed. By default
+ * they are subsampled uniformly. Alternatively, they are sampled
+ * proportionally to approximate ridge leverage scores, which are computed
+ * by recursively sampling halves of the data, see
+ *
+ * Musco, C., & Musco, C. (2017). Recursive sampling for the Nyström method.
+ * Advances in Neural Information Processing Systems 30.
+ *
+ * Both need the kernel only between the training points and a weighted
+ * sample of them.
+ *
+ * \f$K_{m,n}K_{n,m}\f$ and \f$K_{m,n} {\bf y}\f$ are accumulated over
+ * blocks of training points, so that the \f$n\times m\f$ matrix
+ * \f$K_{n,m}\f$ is never stored and the memory is \f$O(m^2)\f$ besides
+ * the features. After training, the chosen training points are the support
+ * vectors, with one alpha each.
+ *
+ * train() needs all training features in memory, since the kernel is
+ * computed between them. For data that does not fit into memory,
+ * train_streaming() reads the training points from a stream one block at a
+ * time, and only the sampled points and the \f$m\times m\f$ matrices are
+ * kept.
  */
 class CKRRNystrom : public CKernelRidgeRegression
 {
@@ -99,8 +131,53 @@ less than number of data points (%d)\n", m_num_rkhs_basis, n);
 
 	};
 
+	/** @param sampling how to sample the rows/columns */
+	void set_landmark_sampling(ELandmarkSampling sampling)
+	{
+		m_landmark_sampling=sampling;
+	}
+
+	/** @return how the rows/columns are sampled */
+	ELandmarkSampling get_landmark_sampling() const
+	{
+		return m_landmark_sampling;
+	}
+
+	/** Set the number of training points whose kernel rows are computed at
+	 * once. Memory for the block is block_size times the number of
+	 * sampled rows/columns.
+	 *
+	 * @param block_size new block size
+	 */
+	void set_block_size(int32_t block_size)
+	{
+		REQUIRE(block_size>0, "Block size (%d) must be positive\n", block_size);
+		m_block_size=block_size;
+	}
+
+	/** @return number of training points whose kernel rows are computed
+	 * at once
+	 */
+	int32_t get_block_size() const
+	{
+		return m_block_size;
+	}
+
 	bool train_machine(CFeatures *data) override;
 
+	/** Train on a labelled stream of training points, without holding
+	 * the training features in memory. The first m examples of the stream
+	 * are the sampled rows/columns, so they are a uniform sample only if
+	 * the stream is in random order, and ridge leverage sampling is not
+	 * supported. The following examples are read in blocks of
+	 * get_block_size() points. Memory is \f$O(m^2)\f$ and the m sampled
+	 * points, which become the kernel's left hand side features.
+	 *
+	 * @param data stream of labelled training points
+	 * @return boolean to indicate success
+	 */
+	bool train_streaming(CStreamingDenseFeatures<float64_t>* data);
+
 	/** @return object name */
 	virtual const char* get_name() const override { return "KRRNystrom"; }
 
@@ -120,9 +197,23 @@ protected:
 	/** Number of columns/rows to be sampled */
 	int32_t m_num_rkhs_basis;
 
+	/** How the columns/rows are sampled */
+	ELandmarkSampling m_landmark_sampling;
+
+	/** Number of training points whose kernel rows are computed at once */
+	int32_t m_block_size;
+
 private:
 	void init();
 
+	/** Samples indices proportionally to ridge leverage scores, which are
+	 * approximated from a weighted sample of a uniformly chosen half of
+	 * the points, recursively.
+	 *
+	 * @return SGVector<int32_t> with sampled indices
+	 */
+	SGVector<int32_t> ridge_leverage_indices();
+
 };
 
 }
@@ -83,13 +83,11 @@ bool CKernelRidgeRegression::train_machine(CFeatures *data)
 	// allocate alpha vector
 	set_alphas(SGVector<float64_t>(m_labels->get_num_labels()));
 
-	if(!solve_krr_system())
-		return false;
-
 	/* tell kernel machine that all alphas are needed as'support vectors' */
 	m_svs = SGVector<index_t>(m_alpha.vlen);
 	m_svs.range_fill();
-	return true;
+
+	return solve_krr_system();
 }
 
 bool CKernelRidgeRegression::load(FILE* srcfile)
@@ -116,7 +116,8 @@ class CKernelRidgeRegression : public CKernelMachine
 		virtual bool train_machine(CFeatures* data=NULL);
 
 		/** Train regression using Cholesky decomposition.
-		 * Assumes that m_alpha is already allocated.
+		 * Assumes that m_alpha is already allocated, with all training
+		 * points as support vectors. Approximations may replace both.
 		 *
 		 *
 		 * @return boolean to indicate success
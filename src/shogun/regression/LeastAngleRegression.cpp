@@ -41,6 +41,7 @@ CLeastAngleRegression::CLeastAngleRegression(bool lasso)
 void CLeastAngleRegression::init()
 {
 	m_lasso = true;
+	m_use_gram = false;
 	m_max_nonz = 0;
 	m_max_l1_norm = 0;
 	m_epsilon = CMath::MACHINE_EPSILON;
@@ -48,6 +49,7 @@ void CLeastAngleRegression::init()
 	SG_ADD(&m_max_nonz, "max_nonz", "Max number of non-zero variables", ParameterProperties::HYPER);
 	SG_ADD(&m_max_l1_norm, "max_l1_norm", "Max l1-norm of estimator", ParameterProperties::HYPER);
 	SG_ADD(&m_lasso, "lasso", "Max l1-norm of estimator", ParameterProperties::HYPER);
+	SG_ADD(&m_use_gram, "use_gram", "Precompute the Gram matrix of the features");
 	watch_method("path_size", &CLeastAngleRegression::get_path_size);
 }
 
@@ -103,6 +105,84 @@ void CLeastAngleRegression::plane_rot(ST x0, ST x1,
 	}
 }
 
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+/* number of vectors per block when computing the Gram matrix */
+static const index_t gram_block_size = 1024;
+
+/* gram = X*X' and Xy = X*y in one pass over the vectors, i.e. the columns
+ * of X. Every thread sums its blocks at the precision of float64_t or
+ * more. */
+template <typename ST>
+static void compute_gram(const typename SGMatrix<ST>::EigenMatrixXtMap& X,
+	const typename SGVector<ST>::EigenVectorXtMap& y, SGMatrix<ST>& gram,
+	vector<ST>& Xy)
+{
+	typedef decltype(ST() + float64_t()) AT;
+	typedef Matrix<AT, Dynamic, Dynamic> MatrixXa;
+	typedef Matrix<ST, Dynamic, Dynamic> MatrixXs;
+	const index_t n_fea = X.rows();
+	const index_t n_vec = X.cols();
+
+	MatrixXa sum_gram = MatrixXa::Zero(n_fea, n_fea);
+	Matrix<AT, Dynamic, 1> sum_Xy = Matrix<AT, Dynamic, 1>::Zero(n_fea);
+
+	#pragma omp parallel
+	{
+		MatrixXa local_gram = MatrixXa::Zero(n_fea, n_fea);
+		Matrix<AT, Dynamic, 1> local_Xy = Matrix<AT, Dynamic, 1>::Zero(n_fea);
+		MatrixXs block_gram(n_fea, n_fea);
+
+		#pragma omp for schedule(dynamic)
+		for (index_t start = 0; start < n_vec; start += gram_block_size)
+		{
+			index_t len = CMath::min(gram_block_size, n_vec - start);
+			block_gram.setZero();
+			block_gram.template selfadjointView<Lower>().rankUpdate(
+				X.middleCols(start, len));
+			local_gram.template triangularView<Lower>() +=
+				block_gram.template cast<AT>();
+			local_Xy += (X.middleCols(start, len) * y.segment(start, len))
+				.template cast<AT>();
+		}
+
+		#pragma omp critical
+		{
+			sum_gram.template triangularView<Lower>() += local_gram;
+			sum_Xy += local_Xy;
+		}
+	}
+
+	sum_gram.template triangularView<StrictlyUpper>() = sum_gram.transpose();
+	gram = SGMatrix<ST>(n_fea, n_fea);
+	typename SGMatrix<ST>::EigenMatrixXtMap map_gram(gram.matrix, n_fea, n_fea);
+	map_gram = sum_gram.template cast<ST>();
+	for (index_t i = 0; i < n_fea; ++i)
+		Xy[i] = sum_Xy[i];
+}
+
+/* appends column R_k, and R_kk from the squared norm diag_k, to the upper
+ * triangular R */
+template <typename ST>
+static SGMatrix<ST> append_cholesky_column(SGMatrix<ST>& R,
+	typename SGVector<ST>::EigenVectorXt& R_k, ST diag_k, int32_t num_active)
+{
+	typename SGMatrix<ST>::EigenMatrixXtMap map_R(R.matrix, R.num_rows, R.num_cols);
+
+	// R' * R_k = (X' * X)_k = col_k, solving to get R_k
+	map_R.transpose().template triangularView<Lower>().template solveInPlace<OnTheLeft>(R_k);
+	ST R_kk = std::sqrt(diag_k - R_k.dot(R_k));
+
+	SGMatrix<ST> R_new(num_active+1, num_active+1);
+	typename SGMatrix<ST>::EigenMatrixXtMap map_R_new(R_new.matrix, R_new.num_rows, R_new.num_cols);
+
+	map_R_new.block(0, 0, num_active, num_active) = map_R;
+	sg_memcpy(R_new.matrix+num_active*(num_active+1), R_k.data(), sizeof(ST)*(num_active));
+	map_R_new.row(num_active).setZero();
+	map_R_new(num_active, num_active) = R_kk;
+	return R_new;
+}
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
 template <typename ST, typename U>
 bool CLeastAngleRegression::train_machine_templated(CDenseFeatures<ST>* data)
 {
@@ -125,27 +205,40 @@ bool CLeastAngleRegression::train_machine_templated(CDenseFeatures<ST>* data)
 	SGVector<ST> y = regression_labels(m_labels)->template get_labels_t<ST>();
 	typename SGVector<ST>::EigenVectorXtMap map_y(y.vector, y.size());
 
+	typename SGMatrix<ST>::EigenMatrixXtMap map_Xr = data->get_feature_matrix();
+	vector<ST> Xy(n_fea);
+	typename SGVector<ST>::EigenVectorXtMap map_Xy(&Xy[0], n_fea);
+
 	// transpose(X) is more convenient to work with since we care
 	// about features here. After transpose, each row will be a data
-	// point while each column corresponds to a feature
-	SGMatrix<ST> X (n_vec, n_fea);
-	typename SGMatrix<ST>::EigenMatrixXtMap map_Xr = data->get_feature_matrix();
-	typename SGMatrix<ST>::EigenMatrixXtMap map_X(X.matrix, n_vec, n_fea);
-	map_X = map_Xr.transpose();
+	// point while each column corresponds to a feature.
+	// With the Gram matrix, neither X nor the prediction are needed.
+	SGMatrix<ST> X;
+	SGMatrix<ST> X_active;
+	SGMatrix<ST> gram;
+	if (m_use_gram)
+		compute_gram<ST>(map_Xr, map_y, gram, Xy);
+	else
+	{
+		X = SGMatrix<ST>(n_vec, n_fea);
+		X_active = SGMatrix<ST>(n_vec, n_fea);
+	}
+	typename SGMatrix<ST>::EigenMatrixXtMap map_X(X.matrix, X.num_rows, X.num_cols);
+	if (!m_use_gram)
+	{
+		map_X = map_Xr.transpose();
 
-	SGMatrix<ST> X_active(n_vec, n_fea);
+		// Xy = X' * y
+		map_Xy=map_Xr*map_y;
+	}
 
 	// beta is the estimator
 	SGVector<ST> beta(n_fea);
 	beta.set_const(0);
 
-	vector<ST> Xy(n_fea);
-	typename SGVector<ST>::EigenVectorXtMap map_Xy(&Xy[0], n_fea);
-	// Xy = X' * y
-	map_Xy=map_Xr*map_y;
-
 	// mu is the prediction
-	vector<ST> mu(n_vec);
+	vector<ST> mu(m_use_gram ? 0 : n_vec);
+	typename SGVector<ST>::EigenVectorXtMap map_mu(mu.data(), mu.size());
 
 	// correlation
 	vector<ST> corr(n_fea);
@@ -175,15 +268,23 @@ bool CLeastAngleRegression::train_machine_templated(CDenseFeatures<ST>* data)
 	{
 		COMPUTATION_CONTROLLERS
 
-		// corr = X' * (y-mu) = - X'*mu + Xy
-		typename SGVector<ST>::EigenVectorXtMap map_corr(&corr[0], n_fea);
-		typename SGVector<ST>::EigenVectorXtMap map_mu(&mu[0], n_vec);
-		
-		map_corr = map_Xy - (map_Xr*map_mu);
-		
-		// corr_sign = sign(corr)
-		for (size_t i=0; i < corr.size(); ++i)
+		// corr = X' * (y-mu) = - X'*mu + Xy, where X'*mu = gram*beta
+		#pragma omp parallel for
+		for (index_t i=0; i < n_fea; ++i)
+		{
+			if (m_use_gram)
+			{
+				ST c = Xy[i];
+				for (auto j : m_active_set)
+					c -= gram(j, i) * beta[j];
+				corr[i] = c;
+			}
+			else
+				corr[i] = Xy[i] - map_X.col(i).dot(map_mu);
+
+			// corr_sign = sign(corr)
 			corr_sign[i] = CMath::sign(corr[i]);
+		}
 
 		// find max absolute correlation in inactive set
 		find_max_abs(corr, m_is_active, i_max_corr, max_corr);
@@ -195,19 +296,23 @@ bool CLeastAngleRegression::train_machine_templated(CDenseFeatures<ST>* data)
 			{ 
 				// R isn't allocated yet
 				R=SGMatrix<ST>(1,1);
-				ST diag_k = map_X.col(i_max_corr).dot(map_X.col(i_max_corr));
+				ST diag_k = m_use_gram ? gram(i_max_corr, i_max_corr) :
+					map_X.col(i_max_corr).dot(map_X.col(i_max_corr));
 				R(0, 0) = std::sqrt(diag_k);
 			}
+			else if (m_use_gram)
+				R=cholesky_insert(gram, R, i_max_corr, m_num_active);
 			else
 				R=cholesky_insert(X, X_active, R, i_max_corr, m_num_active);
 			activate_variable(i_max_corr);
 		}
 
 		// Active variables
-		typename SGMatrix<ST>::EigenMatrixXtMap map_Xa(X_active.matrix, n_vec, m_num_active);
-		if (!lasso_cond)
+		typename SGMatrix<ST>::EigenMatrixXtMap map_Xa(X_active.matrix,
+			X_active.num_rows, m_use_gram ? 0 : m_num_active);
+		if (!lasso_cond && !m_use_gram)
 			map_Xa.col(m_num_active-1)=map_X.col(i_max_corr);
-		
+
 		SGVector<ST> corr_sign_a(m_num_active);
 		for (index_t i=0; i < m_num_active; ++i)
 			corr_sign_a[i] = corr_sign[m_active_set[i]];
@@ -225,32 +330,37 @@ bool CLeastAngleRegression::train_machine_templated(CDenseFeatures<ST>* data)
 		typename SGVector<ST>::EigenVectorXt wA = AA*GA1;
 
 		// equiangular direction (unit vector)
-		vector<ST> u(n_vec);
-		typename SGVector<ST>::EigenVectorXtMap map_u(&u[0], n_vec);
-		
-		map_u = map_Xa*wA;
+		vector<ST> u(m_use_gram ? 0 : n_vec);
+		typename SGVector<ST>::EigenVectorXtMap map_u(u.data(), u.size());
+
+		if (!m_use_gram)
+			map_u = map_Xa*wA;
 
 		ST gamma = max_corr / AA;
 		if (m_num_active < n_fea)
 		{
-			#pragma omp parallel for shared(gamma)
+			#pragma omp parallel for reduction(min:gamma)
 			for (index_t i=0; i < n_fea; ++i)
 			{
 				if (m_is_active[i])
 					continue;
 
 				// correlation between X[:,i] and u
-				ST dir_corr = map_u.dot(map_X.col(i));
+				ST dir_corr = 0;
+				if (m_use_gram)
+				{
+					for (index_t j=0; j < m_num_active; ++j)
+						dir_corr += gram(m_active_set[j], i) * wA(j);
+				}
+				else
+					dir_corr = map_u.dot(map_X.col(i));
 
 				ST tmp1 = (max_corr-corr[i])/(AA-dir_corr);
 				ST tmp2 = (max_corr+corr[i])/(AA+dir_corr);
-				#pragma omp critical
-				{
 				if (tmp1 > CMath::MACHINE_EPSILON && tmp1 < gamma)
 					gamma = tmp1;
 				if (tmp2 > CMath::MACHINE_EPSILON && tmp2 < gamma)
 					gamma = tmp2;
-				}
 			}
 		}
 		
@@ -281,7 +391,8 @@ bool CLeastAngleRegression::train_machine_templated(CDenseFeatures<ST>* data)
 		}
 
 		// update prediction: mu = mu + gamma * u
-		map_mu += gamma*map_u;
+		if (!m_use_gram)
+			map_mu += gamma*map_u;
 
 		// update estimator
 		for (index_t i=0; i < m_num_active; ++i)
@@ -318,7 +429,7 @@ bool CLeastAngleRegression::train_machine_templated(CDenseFeatures<ST>* data)
 			// Remove column from active set
 			int32_t numRows = map_Xa.rows();
 			int32_t numCols = map_Xa.cols()-1;
-			if( i_kick < numCols )
+			if (!m_use_gram && i_kick < numCols)
 				map_Xa.block(0, i_kick, numRows, numCols-i_kick) = 
 					map_Xa.block(0, i_kick+1, numRows, numCols-i_kick).eval();			
 		}
@@ -378,20 +489,20 @@ SGMatrix<ST> CLeastAngleRegression::cholesky_insert(const SGMatrix<ST>& X,
 	// col_k is the k-th column of (X'X)
 	typename SGVector<ST>::EigenVectorXtMap map_i_max(X.get_column_vector(i_max_corr), X.num_rows);
 	typename SGVector<ST>::EigenVectorXt R_k = map_X_active.transpose()*map_i_max;
-	typename SGMatrix<ST>::EigenMatrixXtMap map_R(R.matrix, R.num_rows, R.num_cols);
 
-	// R' * R_k = (X' * X)_k = col_k, solving to get R_k
-	map_R.transpose().template triangularView<Lower>().template solveInPlace<OnTheLeft>(R_k);
-	ST R_kk = std::sqrt(diag_k - R_k.dot(R_k));
+	return append_cholesky_column(R, R_k, diag_k, num_active);
+}
 
-	SGMatrix<ST> R_new(num_active+1, num_active+1);
-	typename SGMatrix<ST>::EigenMatrixXtMap map_R_new(R_new.matrix, R_new.num_rows, R_new.num_cols);
+template <typename ST>
+SGMatrix<ST> CLeastAngleRegression::cholesky_insert(const SGMatrix<ST>& gram,
+		SGMatrix<ST>& R, int32_t i_max_corr, int32_t num_active)
+{
+	// col_k is the k-th column of (X'X) in the rows of the active set
+	typename SGVector<ST>::EigenVectorXt R_k(num_active);
+	for (index_t i=0; i < num_active; ++i)
+		R_k(i) = gram(m_active_set[i], i_max_corr);
 
-	map_R_new.block(0, 0, num_active, num_active) = map_R;
-	sg_memcpy(R_new.matrix+num_active*(num_active+1), R_k.data(), sizeof(ST)*(num_active));
-	map_R_new.row(num_active).setZero();
-	map_R_new(num_active, num_active) = R_kk;
-	return R_new;
+	return append_cholesky_column(R, R_k, gram(i_max_corr, i_max_corr), num_active);
 }
 
 template <typename ST>
@@ -435,3 +546,6 @@ template bool CLeastAngleRegression::train_machine_templated<float32_t>(CDenseFe
 template SGMatrix<float32_t> CLeastAngleRegression::cholesky_insert(const SGMatrix<float32_t>& X, const SGMatrix<float32_t>& X_active, SGMatrix<float32_t>& R, int32_t i_max_corr, int32_t num_active);
 template SGMatrix<float64_t> CLeastAngleRegression::cholesky_insert(const SGMatrix<float64_t>& X, const SGMatrix<float64_t>& X_active, SGMatrix<float64_t>& R, int32_t i_max_corr, int32_t num_active);
 template SGMatrix<floatmax_t> CLeastAngleRegression::cholesky_insert(const SGMatrix<floatmax_t>& X, const SGMatrix<floatmax_t>& X_active, SGMatrix<floatmax_t>& R, int32_t i_max_corr, int32_t num_active);
+template SGMatrix<float32_t> CLeastAngleRegression::cholesky_insert(const SGMatrix<float32_t>& gram, SGMatrix<float32_t>& R, int32_t i_max_corr, int32_t num_active);
+template SGMatrix<float64_t> CLeastAngleRegression::cholesky_insert(const SGMatrix<float64_t>& gram, SGMatrix<float64_t>& R, int32_t i_max_corr, int32_t num_active);
+template SGMatrix<floatmax_t> CLeastAngleRegression::cholesky_insert(const SGMatrix<floatmax_t>& gram, SGMatrix<floatmax_t>& R, int32_t i_max_corr, int32_t num_active);
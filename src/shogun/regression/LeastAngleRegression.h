@@ -53,6 +53,12 @@ class CFeatures;
  *
  * When no constraints is provided, the full path is generated.
  *
+ * For many more vectors than features, the Gram matrix \f$XX^T\f$ and
+ * \f$Xy\f$ can be computed in a single pass over the data, see
+ * set_use_gram(). All further steps then only need the Gram matrix, and
+ * their cost no longer depends on the number of vectors.
+ *
+ *
  * Please see the following paper for more details.
  *
  * @code
@@ -135,6 +141,23 @@ public:
 			m_beta_path[m_beta_idx[num_var]].vector, w.vlen, false);
 	}
 
+	/** set whether to precompute the Gram matrix of the features, which
+	 * takes memory quadratic in the number of features instead of a copy
+	 * of the data
+	 *
+	 * @param use_gram whether to precompute the Gram matrix
+	 */
+	void set_use_gram(bool use_gram)
+	{
+		m_use_gram = use_gram;
+	}
+
+	/** @return whether the Gram matrix of the features is precomputed */
+	bool get_use_gram() const
+	{
+		return m_use_gram;
+	}
+
 	/** get classifier type
 	 *
 	 * @return classifier type LinearRidgeRegression
@@ -153,6 +176,10 @@ protected:
 	SGMatrix<ST> cholesky_insert(const SGMatrix<ST>& X, 
 			const SGMatrix<ST>& X_active, SGMatrix<ST>& R, int32_t i_max_corr, int32_t num_active);
 
+	template <typename ST>
+	SGMatrix<ST> cholesky_insert(const SGMatrix<ST>& gram,
+			SGMatrix<ST>& R, int32_t i_max_corr, int32_t num_active);
+
 	template <typename ST>
 	SGMatrix<ST> cholesky_delete(SGMatrix<ST>& R, int32_t i_kick);
 
@@ -194,6 +221,7 @@ private:
 	}
 	
 	bool m_lasso; //!< enable lasso modification
+	bool m_use_gram; //!< precompute the Gram matrix of the features
 
 	int32_t m_max_nonz;  //!< max number of non-zero variables for early stopping
 	float64_t m_max_l1_norm; //!< max l1-norm of beta (estimator) for early stopping
@@ -518,17 +518,15 @@ void CSVRLight::update_linear_component_mkl(
 
 		for (index_t k_idx=0; k_idx<k->get_num_kernels(); k_idx++)
 		{
-			CKernel* kn = k->get_kernel(k_idx);
 			for(i=0;i<num;i++)
 			{
 				if(a[i] != a_old[i])
 				{
-					kn->get_kernel_row(i,NULL,aicache, true);
+					k->get_subkernel_row(k_idx, i, aicache);
 					for(j=0;j<num;j++)
 						W[j*num_kernels+n]+=(a[i]-a_old[i])*aicache[regression_fix_index(j)]*(float64_t)label[i];
 				}
 			}
-			SG_UNREF(kn);
 			n++ ;
 		}
 	}
@@ -37,6 +37,7 @@
 #include <shogun/features/DenseFeatures.h>
 #include <shogun/labels/MulticlassLabels.h>
 #include <shogun/lib/config.h>
+#include <shogun/mathematics/StatisticsAccumulator.h>
 #include <shogun/mathematics/linalg/LinalgNamespace.h>
 #include <vector>
 
@@ -71,6 +72,9 @@ namespace shogun
 		 */
 		virtual void compute_within_cov();
 
+		/** @return the indices of the data points of each class */
+		std::vector<SGVector<index_t>> get_class_indices() const;
+
 	public:
 		LDASolver(
 		    CDenseFeatures<T>* features, CMulticlassLabels* labels,
@@ -107,76 +111,82 @@ namespace shogun
 	};
 
 	template <typename T>
-	void LDASolver<T>::compute_means()
+	std::vector<SGVector<index_t>> LDASolver<T>::get_class_indices() const
 	{
 		index_t num_class = m_labels->get_num_classes();
-		auto data = m_features->get_feature_matrix();
+		index_t num_vectors = m_features->get_num_vectors();
 
-		m_class_mean = std::vector<SGVector<T>>(num_class);
-		m_class_count = std::vector<index_t>(num_class);
+		std::vector<index_t> class_count(num_class);
+		for (index_t i = 0; i < num_vectors; ++i)
+			++class_count[(index_t)m_labels->get_label(i)];
+
+		std::vector<SGVector<index_t>> class_indices(num_class);
 		for (index_t i = 0; i < num_class; ++i)
 		{
-			m_class_mean[i] = SGVector<T>(data.num_rows);
-			linalg::zero(m_class_mean[i]);
+			class_indices[i] = SGVector<index_t>(class_count[i]);
+			class_count[i] = 0;
 		}
-		m_mean = SGVector<T>(data.num_rows);
-		linalg::zero(m_mean);
-
-		// calculate the total mean and the classes' mean.
-		for (index_t i = 0; i < data.num_cols; ++i)
+		for (index_t i = 0; i < num_vectors; ++i)
 		{
 			index_t c = (index_t)m_labels->get_label(i);
-			++m_class_count[c];
-			linalg::add_col_vec(data, i, m_class_mean[c], m_class_mean[c]);
+			class_indices[c][class_count[c]++] = i;
 		}
+
+		return class_indices;
+	}
+
+	template <typename T>
+	void LDASolver<T>::compute_means()
+	{
+		index_t num_class = m_labels->get_num_classes();
+		auto data = m_features->get_feature_matrix();
+		auto class_indices = get_class_indices();
+
+		m_class_mean = std::vector<SGVector<T>>(num_class);
+		m_class_count = std::vector<index_t>(num_class);
+
+		// calculate the classes' mean, their moments give the total mean.
+		StatisticsAccumulator<T> total(data.num_rows);
 		for (index_t i = 0; i < num_class; ++i)
 		{
-			linalg::add(m_mean, m_class_mean[i], m_mean);
-			linalg::scale(
-			    m_class_mean[i], m_class_mean[i], 1 / (T)m_class_count[i]);
+			StatisticsAccumulator<T> statistics(data.num_rows);
+			statistics.add(data, class_indices[i]);
+			total.merge(statistics);
+
+			m_class_count[i] = class_indices[i].vlen;
+			if (m_class_count[i])
+				m_class_mean[i] = statistics.get_mean();
+			else
+			{
+				m_class_mean[i] = SGVector<T>(data.num_rows);
+				linalg::zero(m_class_mean[i]);
+			}
 		}
-		linalg::scale(m_mean, m_mean, 1 / (T)data.num_cols);
+		m_mean = total.get_mean();
 	}
 
 	template <typename T>
 	void LDASolver<T>::compute_within_cov()
 	{
 		index_t num_features = m_features->get_num_features();
-		index_t num_vectors = m_features->get_num_vectors();
 		index_t num_class = m_labels->get_num_classes();
 
-		auto data = m_features->get_feature_matrix().clone();
-
-		// Center data with respect to each data point's class
-		for (index_t i = 0; i < data.num_cols; ++i)
-			linalg::add_col_vec(
-			    data, i, m_class_mean[m_labels->get_label(i)], data, (T)1.0,
-			    (T)-1.0);
-
-		// holds the feature matrix for each class
-		std::vector<SGMatrix<T>> centered_class(num_class);
-		std::vector<index_t> centered_class_col(num_class);
+		auto data = m_features->get_feature_matrix();
+		auto class_indices = get_class_indices();
 
+		// the scatter of each class is accumulated from chunks of its data
+		// points, centered with respect to the class mean
 		m_within_cov = SGMatrix<T>(num_features, num_features);
 		linalg::zero(m_within_cov);
-		for (auto i = 0; i < num_class; ++i)
-		{
-			centered_class[i] = SGMatrix<T>(num_features, m_class_count[i]);
-			linalg::zero(centered_class[i]);
-		}
-		for (index_t i = 0; i < num_vectors; ++i)
-		{
-			index_t c = (index_t)m_labels->get_label(i);
-			centered_class[c].set_column(
-			    centered_class_col[c], data.get_column(i));
-			++centered_class_col[c];
-		}
 		for (index_t i = 0; i < num_class; ++i)
 		{
-			auto tmp = linalg::matrix_prod(
-			    centered_class[i], centered_class[i], false, true);
+			if (m_class_count[i] < 2)
+				continue;
+
+			StatisticsAccumulator<T> statistics(num_features, true);
+			statistics.add(data, class_indices[i]);
 			linalg::add(
-			    m_within_cov, tmp, m_within_cov, (T)1.0,
+			    m_within_cov, statistics.get_scatter(), m_within_cov, (T)1.0,
 			    ((T)m_class_count[i] / (m_class_count[i] - 1)));
 		}
 
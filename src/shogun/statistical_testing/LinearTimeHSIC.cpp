@@ -0,0 +1,492 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: agent
+ */
+
+#include <vector>
+#include <functional>
+#include <shogun/io/SGIO.h>
+#include <shogun/lib/SGMatrix.h>
+#include <shogun/lib/SGVector.h>
+#include <shogun/kernel/Kernel.h>
+#include <shogun/kernel/GaussianKernel.h>
+#include <shogun/features/Features.h>
+#include <shogun/features/DotFeatures.h>
+#include <shogun/features/RandomFourierDotFeatures.h>
+#include <shogun/mathematics/Math.h>
+#include <shogun/mathematics/RandomStream.h>
+#include <shogun/mathematics/Statistics.h>
+#include <shogun/mathematics/eigen3.h>
+#include <shogun/statistical_testing/LinearTimeHSIC.h>
+#include <shogun/statistical_testing/internals/NextSamples.h>
+#include <shogun/statistical_testing/internals/DataManager.h>
+#include <shogun/statistical_testing/internals/KernelManager.h>
+#include <shogun/statistical_testing/internals/ComputationManager.h>
+#include <shogun/statistical_testing/internals/hsic/WithinBlockHSIC.h>
+
+using namespace shogun;
+using namespace internal;
+using namespace hsic;
+
+struct CLinearTimeHSIC::Self
+{
+	typedef std::function<float32_t(SGMatrix<float32_t>, index_t)> job_t;
+
+	Self(CLinearTimeHSIC& hsic);
+	~Self();
+
+	void reset_feature_maps();
+	bool feature_maps_valid(CFeatures* block_p, CFeatures* block_q) const;
+	void init_feature_maps(CFeatures* block_p, CFeatures* block_q);
+	SGMatrix<float64_t> compute_features(index_t k, CFeatures* block) const;
+	void compute_blocks(ComputationManager& cm, NextSamples& next_burst);
+	void compute_jobs(const std::function<std::vector<job_t>(index_t)>& create_jobs,
+		const std::function<void(ComputationManager&)>& collect);
+
+	std::pair<float64_t, float64_t> compute_statistic_variance();
+	SGVector<float64_t> sample_null();
+
+	CLinearTimeHSIC& owner;
+
+	EFeatureMapMethod feature_map_method;
+	index_t num_features;
+	index_t num_null_samples;
+	ENullApproximationMethod null_approximation_method;
+
+	/* the kernels, their widths and the feature dimensions the feature
+	 * maps were drawn for */
+	CKernel* map_kernels[2];
+	SGVector<float64_t> widths;
+	index_t dims[2];
+	/* random Fourier features */
+	SGMatrix<float64_t> coefficients[2];
+	/* Nystrom features */
+	CFeatures* landmarks[2];
+	SGMatrix<float64_t> projections[2];
+
+	static constexpr EFeatureMapMethod DEFAULT_FEATURE_MAP_METHOD = FMM_RANDOM_FOURIER;
+	static constexpr index_t DEFAULT_NUM_FEATURES = 100;
+	static constexpr index_t DEFAULT_NUM_NULL_SAMPLES = 250;
+	static constexpr ENullApproximationMethod DEFAULT_NULL_APPROXIMATION_METHOD = NAM_MMD1_GAUSSIAN;
+};
+
+CLinearTimeHSIC::Self::Self(CLinearTimeHSIC& hsic) : owner(hsic),
+	feature_map_method(DEFAULT_FEATURE_MAP_METHOD),
+	num_features(DEFAULT_NUM_FEATURES),
+	num_null_samples(DEFAULT_NUM_NULL_SAMPLES),
+	null_approximation_method(DEFAULT_NULL_APPROXIMATION_METHOD),
+	widths(2)
+{
+	map_kernels[0]=map_kernels[1]=nullptr;
+	landmarks[0]=landmarks[1]=nullptr;
+	dims[0]=dims[1]=0;
+}
+
+/* width of a Gaussian kernel, zero for other kernels */
+static float64_t kernel_width(CKernel* kernel)
+{
+	if (kernel->get_kernel_type()==K_GAUSSIAN)
+		return static_cast<CGaussianKernel*>(kernel)->get_width();
+	return 0;
+}
+
+/* dimension of dot features, zero for other features */
+static index_t feature_dim(CFeatures* features)
+{
+	auto dot_features=dynamic_cast<CDotFeatures*>(features);
+	return dot_features!=nullptr ? dot_features->get_dim_feature_space() : 0;
+}
+
+CLinearTimeHSIC::Self::~Self()
+{
+	reset_feature_maps();
+}
+
+void CLinearTimeHSIC::Self::reset_feature_maps()
+{
+	for (index_t k=0; k<2; ++k)
+	{
+		SG_UNREF(map_kernels[k]);
+		dims[k]=0;
+		coefficients[k]=SGMatrix<float64_t>();
+		projections[k]=SGMatrix<float64_t>();
+		SG_UNREF(landmarks[k]);
+	}
+}
+
+bool CLinearTimeHSIC::Self::feature_maps_valid(CFeatures* block_p, CFeatures* block_q) const
+{
+	const KernelManager& kernel_mgr=owner.get_kernel_mgr();
+	CFeatures* blocks[]={block_p, block_q};
+	for (index_t k=0; k<2; ++k)
+	{
+		/* the cached kernels are referenced, so their addresses are not reused */
+		auto kernel=kernel_mgr.kernel_at(k);
+		if (map_kernels[k]==nullptr || map_kernels[k]!=kernel ||
+			widths[k]!=kernel_width(kernel) || dims[k]!=feature_dim(blocks[k]))
+			return false;
+	}
+	return true;
+}
+
+void CLinearTimeHSIC::Self::init_feature_maps(CFeatures* block_p, CFeatures* block_q)
+{
+	if (feature_maps_valid(block_p, block_q))
+		return;
+
+	const KernelManager& kernel_mgr=owner.get_kernel_mgr();
+
+	reset_feature_maps();
+	CFeatures* blocks[]={block_p, block_q};
+	for (index_t k=0; k<2; ++k)
+	{
+		auto kernel=kernel_mgr.kernel_at(k);
+		REQUIRE(kernel!=nullptr, "Kernel for samples from %s is not set!\n", k==0 ? "p" : "q");
+		REQUIRE(kernel->get_kernel_type()!=K_CUSTOM, "Underlying kernel cannot be custom!\n");
+
+		if (feature_map_method==FMM_RANDOM_FOURIER)
+		{
+			REQUIRE(kernel->get_kernel_type()==K_GAUSSIAN,
+				"Random Fourier features approximate Gaussian kernels only, "
+				"use Nystrom features for %s!\n", kernel->get_name());
+			auto features=dynamic_cast<CDotFeatures*>(blocks[k]);
+			REQUIRE(features!=nullptr,
+				"Random Fourier features need dot features (were %s)!\n", blocks[k]->get_name());
+
+			SGVector<float64_t> params(1);
+			params[0]=kernel_width(kernel);
+			auto random_features=some<CRandomFourierDotFeatures>(features, num_features, GAUSSIAN, params);
+			coefficients[k]=random_features->get_random_coefficients();
+		}
+		else
+		{
+			/* landmarks are a random subset of the first block */
+			const index_t num_vectors=blocks[k]->get_num_vectors();
+			const index_t num_landmarks=CMath::min(num_features, num_vectors);
+			SGVector<index_t> inds(num_vectors);
+			inds.range_fill();
+			CMath::permute(inds);
+			SGVector<index_t> landmark_inds(num_landmarks);
+			std::copy(inds.vector, inds.vector+num_landmarks, landmark_inds.vector);
+			landmarks[k]=blocks[k]->copy_subset(landmark_inds);
+
+			auto kernel_clone=std::unique_ptr<CKernel>(static_cast<CKernel*>(kernel->clone()));
+			kernel_clone->init(landmarks[k], landmarks[k]);
+			SGMatrix<float64_t> km=kernel_clone->get_kernel_matrix<float64_t>();
+			kernel_clone->remove_lhs_and_rhs();
+
+			/* K_mm^(-1/2) on the numerically non-zero eigenvalues */
+			Eigen::Map<Eigen::MatrixXd> map(km.matrix, km.num_rows, km.num_cols);
+			Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> solver(map);
+			REQUIRE(solver.info()==Eigen::Success, "Eigendecomposition failed!\n");
+			const Eigen::VectorXd& eigenvalues=solver.eigenvalues();
+			const float64_t tol=eigenvalues.maxCoeff()*num_landmarks*CMath::MACHINE_EPSILON;
+			index_t rank=0;
+			for (index_t i=0; i<num_landmarks; ++i)
+				rank+=eigenvalues[i]>tol;
+			REQUIRE(rank>0, "Kernel matrix of the landmarks is zero!\n");
+
+			projections[k]=SGMatrix<float64_t>(num_landmarks, rank);
+			Eigen::Map<Eigen::MatrixXd> projection(projections[k].matrix, num_landmarks, rank);
+			projection=solver.eigenvectors().rightCols(rank)*
+				eigenvalues.tail(rank).cwiseSqrt().cwiseInverse().asDiagonal();
+		}
+		SG_REF(kernel);
+		map_kernels[k]=kernel;
+		widths[k]=kernel_width(kernel);
+		dims[k]=feature_dim(blocks[k]);
+	}
+}
+
+SGMatrix<float64_t> CLinearTimeHSIC::Self::compute_features(index_t k, CFeatures* block) const
+{
+	if (feature_map_method==FMM_RANDOM_FOURIER)
+	{
+		auto features=dynamic_cast<CDotFeatures*>(block);
+		REQUIRE(features!=nullptr,
+			"Random Fourier features need dot features (were %s)!\n", block->get_name());
+		SGVector<float64_t> params(1);
+		params[0]=widths[k];
+		auto random_features=some<CRandomFourierDotFeatures>(features, num_features,
+			GAUSSIAN, params, coefficients[k]);
+		return random_features->get_feature_vectors(0, random_features->get_num_vectors());
+	}
+
+	auto kernel_clone=std::unique_ptr<CKernel>(static_cast<CKernel*>(map_kernels[k]->clone()));
+	kernel_clone->init(landmarks[k], block);
+	SGMatrix<float64_t> km=kernel_clone->get_kernel_matrix<float64_t>();
+	kernel_clone->remove_lhs_and_rhs();
+
+	SGMatrix<float64_t> result(projections[k].num_cols, km.num_cols);
+	Eigen::Map<Eigen::MatrixXd> map_km(km.matrix, km.num_rows, km.num_cols);
+	Eigen::Map<Eigen::MatrixXd> projection(projections[k].matrix, projections[k].num_rows,
+		projections[k].num_cols);
+	Eigen::Map<Eigen::MatrixXd>(result.matrix, result.num_rows, result.num_cols).noalias()=
+		projection.transpose()*map_km;
+	return result;
+}
+
+void CLinearTimeHSIC::Self::compute_blocks(ComputationManager& cm, NextSamples& next_burst)
+{
+	const index_t num_blocks=next_burst.num_blocks();
+	init_feature_maps(next_burst[0][0], next_burst[1][0]);
+
+	cm.num_data(num_blocks);
+#pragma omp parallel for
+	for (index_t i=0; i<num_blocks; ++i)
+	{
+		try
+		{
+			auto phi=compute_features(0, next_burst[0][i]);
+			auto psi=compute_features(1, next_burst[1][i]);
+			ASSERT(phi.num_cols==psi.num_cols);
+
+			/* the features of the pairs are stacked in the columns */
+			SGMatrix<float32_t> block(phi.num_rows+psi.num_rows, phi.num_cols);
+			for (index_t j=0; j<block.num_cols; ++j)
+			{
+				std::copy(phi.get_column_vector(j), phi.get_column_vector(j)+phi.num_rows,
+					block.get_column_vector(j));
+				std::copy(psi.get_column_vector(j), psi.get_column_vector(j)+psi.num_rows,
+					block.get_column_vector(j)+phi.num_rows);
+			}
+			cm.data(i)=block;
+		}
+		catch (ShogunException& e)
+		{
+			SG_SERROR("%s, Try using less number of blocks per burst!\n", e.what());
+		}
+	}
+	next_burst.clear();
+}
+
+void CLinearTimeHSIC::Self::compute_jobs(const std::function<std::vector<job_t>(index_t)>& create_jobs,
+	const std::function<void(ComputationManager&)>& collect)
+{
+	DataManager& data_mgr=owner.get_data_mgr();
+	REQUIRE(data_mgr.num_samples_at(0)==data_mgr.num_samples_at(1),
+		"Number of samples from p (%d) and q (%d) must be the same!\n",
+		data_mgr.num_samples_at(0), data_mgr.num_samples_at(1));
+	REQUIRE(data_mgr.blocksize_at(0)>0, "Blocksize is not set!\n");
+
+	ComputationManager cm;
+	data_mgr.start();
+	auto next_burst=data_mgr.next();
+	bool jobs_created=false;
+	while (!next_burst.empty())
+	{
+		compute_blocks(cm, next_burst);
+		if (!jobs_created)
+		{
+			/* the number of features from p is known once the maps are drawn */
+			const index_t dim_p=feature_map_method==FMM_RANDOM_FOURIER ?
+				num_features : projections[0].num_cols;
+			for (auto& job : create_jobs(dim_p))
+				cm.enqueue_job(job);
+			jobs_created=true;
+		}
+		cm.use_cpu().compute_data_parallel_jobs();
+		collect(cm);
+		next_burst=data_mgr.next();
+	}
+	cm.done();
+	data_mgr.end();
+}
+
+std::pair<float64_t, float64_t> CLinearTimeHSIC::Self::compute_statistic_variance()
+{
+	float64_t mean=0;
+	float64_t m2=0;
+	index_t term_counter=0;
+
+	compute_jobs([](index_t dim_p)
+	{
+		return std::vector<job_t>(1, WithinBlockHSIC(dim_p));
+	},
+	[&](ComputationManager& cm)
+	{
+		for (auto hsic : cm.result(0))
+		{
+			term_counter++;
+			auto delta=hsic-mean;
+			mean+=delta/term_counter;
+			m2+=delta*(hsic-mean);
+		}
+	});
+	REQUIRE(term_counter>1, "At least two blocks are needed (was %d)!\n", term_counter);
+
+	/* the statistic is B times the mean of the block estimates */
+	const index_t B=owner.get_data_mgr().blocksize_at(0);
+	const float64_t statistic=B*mean;
+	const float64_t variance=float64_t(B)*B*m2/(term_counter-1)/term_counter;
+	SG_SDEBUG("statistic=%f, variance=%f from %d blocks!\n", statistic, variance, term_counter);
+	return std::make_pair(statistic, variance);
+}
+
+SGVector<float64_t> CLinearTimeHSIC::Self::sample_null()
+{
+	SGVector<float64_t> null_samples(num_null_samples);
+	null_samples.zero();
+	index_t term_counter=0;
+
+	RandomStream seeds(CMath::random());
+	compute_jobs([&](index_t dim_p)
+	{
+		std::vector<job_t> jobs;
+		for (index_t j=0; j<num_null_samples; ++j)
+			jobs.push_back(WithinBlockHSIC(dim_p, true, seeds.random_64()));
+		return jobs;
+	},
+	[&](ComputationManager& cm)
+	{
+		const index_t num_blocks=cm.result(0).size();
+		for (index_t j=0; j<num_null_samples; ++j)
+		{
+			for (index_t i=0; i<num_blocks; ++i)
+				null_samples[j]+=(cm.result(j)[i]-null_samples[j])/(term_counter+i+1);
+		}
+		term_counter+=num_blocks;
+	});
+
+	const index_t B=owner.get_data_mgr().blocksize_at(0);
+	for (index_t j=0; j<num_null_samples; ++j)
+		null_samples[j]*=B;
+	return null_samples;
+}
+
+CLinearTimeHSIC::CLinearTimeHSIC() : CIndependenceTest()
+{
+#if EIGEN_VERSION_AT_LEAST(3,1,0)
+	Eigen::initParallel();
+#endif
+	self=std::unique_ptr<Self>(new Self(*this));
+}
+
+CLinearTimeHSIC::~CLinearTimeHSIC()
+{
+}
+
+void CLinearTimeHSIC::set_blocksize(index_t blocksize)
+{
+	auto& data_mgr=get_data_mgr();
+	const auto& const_data_mgr=data_mgr;
+	REQUIRE(const_data_mgr.num_samples_at(0)==const_data_mgr.num_samples_at(1),
+		"Number of samples from p (%d) and q (%d) must be the same!\n",
+		const_data_mgr.num_samples_at(0), const_data_mgr.num_samples_at(1));
+	REQUIRE(blocksize>=4, "Blocksize (%d) has to be at least 4!\n", blocksize);
+	data_mgr.set_blocksize(2*blocksize);
+}
+
+void CLinearTimeHSIC::set_num_blocks_per_burst(index_t num_blocks_per_burst)
+{
+	get_data_mgr().set_num_blocks_per_burst(num_blocks_per_burst);
+}
+
+void CLinearTimeHSIC::set_feature_map_method(EFeatureMapMethod method)
+{
+	if (method!=self->feature_map_method)
+		self->reset_feature_maps();
+	self->feature_map_method=method;
+}
+
+EFeatureMapMethod CLinearTimeHSIC::get_feature_map_method() const
+{
+	return self->feature_map_method;
+}
+
+void CLinearTimeHSIC::set_num_features(index_t num_features)
+{
+	REQUIRE(num_features>0, "Number of features (%d) has to be positive!\n", num_features);
+	if (num_features!=self->num_features)
+		self->reset_feature_maps();
+	self->num_features=num_features;
+}
+
+index_t CLinearTimeHSIC::get_num_features() const
+{
+	return self->num_features;
+}
+
+void CLinearTimeHSIC::set_num_null_samples(index_t null_samples)
+{
+	REQUIRE(null_samples>0, "Number of null samples (%d) has to be positive!\n", null_samples);
+	self->num_null_samples=null_samples;
+}
+
+index_t CLinearTimeHSIC::get_num_null_samples() const
+{
+	return self->num_null_samples;
+}
+
+void CLinearTimeHSIC::set_null_approximation_method(ENullApproximationMethod nmethod)
+{
+	REQUIRE(nmethod==NAM_MMD1_GAUSSIAN || nmethod==NAM_PERMUTATION,
+		"Null approximation method (%d) has to be either Gaussian or permutation!\n", nmethod);
+	self->null_approximation_method=nmethod;
+}
+
+ENullApproximationMethod CLinearTimeHSIC::get_null_approximation_method() const
+{
+	return self->null_approximation_method;
+}
+
+float64_t CLinearTimeHSIC::compute_statistic()
+{
+	return self->compute_statistic_variance().first;
+}
+
+float64_t CLinearTimeHSIC::compute_variance()
+{
+	return self->compute_statistic_variance().second;
+}
+
+SGVector<float64_t> CLinearTimeHSIC::sample_null()
+{
+	return self->sample_null();
+}
+
+float64_t CLinearTimeHSIC::compute_p_value(float64_t statistic)
+{
+	float64_t result=0;
+	switch (get_null_approximation_method())
+	{
+		case NAM_MMD1_GAUSSIAN:
+		{
+			float64_t std_dev=std::sqrt(compute_variance());
+			result=1.0-CStatistics::normal_cdf(statistic, std_dev);
+			break;
+		}
+		default:
+		{
+			result=CHypothesisTest::compute_p_value(statistic);
+			break;
+		}
+	}
+	return result;
+}
+
+float64_t CLinearTimeHSIC::compute_threshold(float64_t alpha)
+{
+	float64_t result=0;
+	switch (get_null_approximation_method())
+	{
+		case NAM_MMD1_GAUSSIAN:
+		{
+			float64_t std_dev=std::sqrt(compute_variance());
+			result=CStatistics::inverse_normal_cdf(1-alpha, 0, std_dev);
+			break;
+		}
+		default:
+		{
+			result=CHypothesisTest::compute_threshold(alpha);
+			break;
+		}
+	}
+	return result;
+}
+
+const char* CLinearTimeHSIC::get_name() const
+{
+	return "LinearTimeHSIC";
+}
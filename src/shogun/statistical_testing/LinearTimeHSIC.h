@@ -0,0 +1,152 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: agent
+ */
+
+#ifndef LINEAR_TIME_HSIC_H_
+#define LINEAR_TIME_HSIC_H_
+
+#include <memory>
+#include <shogun/statistical_testing/IndependenceTest.h>
+#include <shogun/statistical_testing/TestEnums.h>
+
+namespace shogun
+{
+
+/**
+ * @brief Linear time independence test based on the Hilbert-Schmidt
+ * independence criterion (HSIC), for streaming data.
+ *
+ * The samples \f$(x_i,y_i)\f$ are fetched in bursts of blocks of B pairs,
+ * i.e. the i-th samples from p and q form a pair. Both kernels are
+ * approximated by explicit feature maps, which are drawn once from the first
+ * block and then applied to every block:
+ *
+ * - random Fourier features (see CRandomFourierDotFeatures) for Gaussian
+ *   kernels on dense features, or
+ * - Nystrom features \f$K_{nm}U\Lambda^{-1/2}\f$ for any kernel, with
+ *   landmarks sampled from the first block.
+ *
+ * Every block gives the unbiased HSIC estimate of [1], computed from the
+ * features in \f$O(BD_pD_q)\f$ time without forming the Gram matrices, and
+ * the statistic is B times the average of the block estimates. The blocks
+ * are processed in parallel, so the test takes linear time in the number of
+ * samples and memory that depends on the block size and the number of
+ * features only.
+ *
+ * The block estimates are unbiased and their mean is zero under the null
+ * hypothesis, so the null distribution is approximated by a Gaussian with
+ * the variance of the block estimates (NAM_MMD1_GAUSSIAN, default).
+ * Alternatively, the null distribution is sampled by shuffling the pairs
+ * within every block (NAM_PERMUTATION), all null samples in a single pass
+ * over the data.
+ *
+ * [1]: Song, L., Smola, A., Gretton, A., Bedo, J., & Borgwardt, K. (2012).
+ * Feature Selection via Dependence Maximization. Journal of Machine Learning
+ * Research, 13, 1393-1434.
+ */
+class CLinearTimeHSIC : public CIndependenceTest
+{
+public:
+	/** Default constructor */
+	CLinearTimeHSIC();
+
+	/** Destructor */
+	virtual ~CLinearTimeHSIC();
+
+	/**
+	 * Method that sets the number of pairs per block. The number of samples
+	 * from p and q has to be the same and divisible by the blocksize.
+	 *
+	 * @param blocksize The number of pairs per block, at least 4
+	 */
+	void set_blocksize(index_t blocksize);
+
+	/**
+	 * Method that sets the number of blocks that are fetched and processed
+	 * at once.
+	 *
+	 * @param num_blocks_per_burst The number of blocks per burst
+	 */
+	void set_num_blocks_per_burst(index_t num_blocks_per_burst);
+
+	/** @param method The feature map approximating the kernels */
+	void set_feature_map_method(EFeatureMapMethod method);
+
+	/** @return The feature map approximating the kernels */
+	EFeatureMapMethod get_feature_map_method() const;
+
+	/**
+	 * @param num_features The number of random features, or landmarks for
+	 * the Nystrom features, per kernel
+	 */
+	void set_num_features(index_t num_features);
+
+	/** @return The number of features per kernel */
+	index_t get_num_features() const;
+
+	/** @param null_samples Number of null-samples for the permutation test */
+	void set_num_null_samples(index_t null_samples);
+
+	/** @return Number of null-samples for the permutation test */
+	index_t get_num_null_samples() const;
+
+	/**
+	 * @param nmethod The null approximation method, either NAM_MMD1_GAUSSIAN
+	 * or NAM_PERMUTATION
+	 */
+	void set_null_approximation_method(ENullApproximationMethod nmethod);
+
+	/** @return The null approximation method */
+	ENullApproximationMethod get_null_approximation_method() const;
+
+	/**
+	 * Method that computes the statistic, i.e. the blocksize times the
+	 * average of the unbiased HSIC estimates of the blocks.
+	 *
+	 * @return The test statistic
+	 */
+	virtual float64_t compute_statistic();
+
+	/**
+	 * Method that estimates the variance of the statistic under the null
+	 * hypothesis from the variance of the block estimates.
+	 *
+	 * @return The variance estimate of the statistic
+	 */
+	float64_t compute_variance();
+
+	/**
+	 * Method that samples the statistic under the null hypothesis by
+	 * shuffling the pairs within the blocks.
+	 *
+	 * @return The null samples
+	 */
+	virtual SGVector<float64_t> sample_null();
+
+	/**
+	 * Method that computes the p-value from the provided statistic.
+	 *
+	 * @param statistic The test statistic
+	 * @return The p-value computed using the null-approximation method specified.
+	 */
+	virtual float64_t compute_p_value(float64_t statistic);
+
+	/**
+	 * Method that computes the threshold from the provided significance level (alpha).
+	 *
+	 * @param alpha The significance level (value should be between 0 and 1)
+	 * @return The threshold computed using the null-approximation method specified.
+	 */
+	virtual float64_t compute_threshold(float64_t alpha);
+
+	/** @return The name of the class */
+	virtual const char* get_name() const;
+private:
+	struct Self;
+	std::unique_ptr<Self> self;
+};
+
+}
+#endif // LINEAR_TIME_HSIC_H_
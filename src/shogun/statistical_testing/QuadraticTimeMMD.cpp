@@ -60,6 +60,7 @@ struct CQuadraticTimeMMD::Self
 	void init_permutation_job();
 	void init_variance_h1_job();
 	void init_kernel();
+	bool use_kernel_matrix();
 	SGMatrix<float32_t> get_kernel_matrix();
 
 	SGVector<float64_t> sample_null_spectrum();
@@ -161,6 +162,16 @@ void CQuadraticTimeMMD::Self::init_kernel()
 	}
 }
 
+/* a memory mapped CCustomKernel is read through the kernel instead of
+ * holding its Gram matrix in memory */
+bool CQuadraticTimeMMD::Self::use_kernel_matrix()
+{
+	auto kernel=owner.get_kernel();
+	if (kernel->get_kernel_type()==K_CUSTOM && static_cast<CCustomKernel*>(kernel)->is_memory_mapped())
+		return false;
+	return precompute;
+}
+
 SGMatrix<float32_t> CQuadraticTimeMMD::Self::get_kernel_matrix()
 {
 	ASSERT(precompute);
@@ -315,7 +326,7 @@ float64_t CQuadraticTimeMMD::compute_statistic()
 	self->init_kernel();
 
 	float64_t statistic=0;
-	if (self->precompute)
+	if (self->use_kernel_matrix())
 	{
 		SGMatrix<float32_t> kernel_matrix=self->get_kernel_matrix();
 		statistic=self->statistic_job(kernel_matrix);
@@ -344,7 +355,7 @@ SGVector<float64_t> CQuadraticTimeMMD::Self::sample_null_permutation()
 	init_kernel();
 
 	SGVector<float32_t> result;
-	if (precompute)
+	if (use_kernel_matrix())
 	{
 		SGMatrix<float32_t> kernel_matrix=get_kernel_matrix();
 		result=permutation_job(kernel_matrix);
@@ -510,7 +521,7 @@ float64_t CQuadraticTimeMMD::compute_variance_h1()
 	self->init_kernel();
 	self->init_variance_h1_job();
 	float64_t variance_estimate=0;
-	if (self->precompute)
+	if (self->use_kernel_matrix())
 	{
 		SGMatrix<float32_t> kernel_matrix=self->get_kernel_matrix();
 		variance_estimate=self->variance_h1_job(kernel_matrix);
@@ -82,6 +82,13 @@ template <typename> class SGVector;
  * the lower triangular part of the Gram matrix is stored, in order to exploit
  * the symmetry.
  *
+ * The permutation test computes the null samples for batches of permutations
+ * at once, by products of blocks of columns of the Gram matrix with the
+ * indicator vectors of the permuted samples. For large numbers of samples,
+ * the Gram matrix can be kept on disk as a memory mapped CCustomKernel (see
+ * CCustomKernel::save_triangle_kernel_matrix_to_file(), optionally with 16 bit
+ * floats), which is then read block by block instead of being held in memory.
+ *
  * Since the methods modifies the object's state, using the methods of this
  * class from multiple threads may result in undesired/incorrect results/behavior.
  *
@@ -66,5 +66,11 @@ enum EKernelSelectionMethod
 	KSM_CROSS_VALIDATION,
 	KSM_AUTO = KSM_MAXIMIZE_POWER
 };
+
+enum EFeatureMapMethod
+{
+	FMM_RANDOM_FOURIER,
+	FMM_NYSTROM
+};
 }
 #endif // TEST_ENUMS_H_
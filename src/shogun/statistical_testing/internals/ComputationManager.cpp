@@ -34,7 +34,7 @@
 using namespace shogun;
 using namespace internal;
 
-ComputationManager::ComputationManager()
+ComputationManager::ComputationManager() : num_blocks_computed(0)
 {
 }
 
@@ -53,6 +53,14 @@ SGMatrix<float32_t>& ComputationManager::data(index_t i)
 }
 
 void ComputationManager::enqueue_job(std::function<float32_t(SGMatrix<float32_t>)> job)
+{
+	job_array.push_back([job](const SGMatrix<float32_t>& block, index_t)
+	{
+		return job(block);
+	});
+}
+
+void ComputationManager::enqueue_job(std::function<float32_t(SGMatrix<float32_t>, index_t)> job)
 {
 	job_array.push_back(job);
 }
@@ -82,7 +90,7 @@ void ComputationManager::compute_data_parallel_jobs()
 			for (size_t j=0; j<job_array.size(); ++j)
 			{
 				const auto& compute_job=job_array[j];
-				current_data_results[j]=compute_job(data_array[i]);
+				current_data_results[j]=compute_job(data_array[i], num_blocks_computed+i);
 			}
 			// data is no more required, less cache miss when we just have to
 			// store the results
@@ -90,6 +98,7 @@ void ComputationManager::compute_data_parallel_jobs()
 				result_array[j][i]=current_data_results[j];
 		}
 	}
+	num_blocks_computed+=data_array.size();
 }
 
 void ComputationManager::compute_task_parallel_jobs()
@@ -114,13 +123,15 @@ void ComputationManager::compute_task_parallel_jobs()
 			const auto& compute_job=job_array[j];
 			// result_array[j][i] is contiguous, cache miss is minimized
 			for (size_t i=0; i<data_array.size(); ++i)
-				result_array[j][i]=compute_job(data_array[i]);
+				result_array[j][i]=compute_job(data_array[i], num_blocks_computed+i);
 		}
 	}
+	num_blocks_computed+=data_array.size();
 }
 
 void ComputationManager::done()
 {
+	num_blocks_computed=0;
 	job_array.resize(0);
 	result_array.resize(0);
 }
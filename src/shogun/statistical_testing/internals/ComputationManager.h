@@ -53,6 +53,9 @@ public:
 	SGMatrix<float32_t>& data(index_t i);
 
 	void enqueue_job(std::function<float32_t(SGMatrix<float32_t>)> job);
+	// jobs that also get the index of the block, counted over all calls to
+	// compute since the last call to done()
+	void enqueue_job(std::function<float32_t(SGMatrix<float32_t>, index_t)> job);
 	void compute_data_parallel_jobs();
 	void compute_task_parallel_jobs();
 	void done();
@@ -62,8 +65,9 @@ public:
 	ComputationManager& use_gpu();
 private:
 	bool gpu;
+	index_t num_blocks_computed;
 	std::vector<SGMatrix<float32_t> > data_array;
-	std::vector<std::function<float32_t(const SGMatrix<float32_t>&)> > job_array;
+	std::vector<std::function<float32_t(const SGMatrix<float32_t>&, index_t)> > job_array;
 	std::vector<std::vector<float32_t> > result_array;
 };
 #endif // DOXYGEN_SHOULD_SKIP_THIS
@@ -0,0 +1,68 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: agent
+ */
+
+#include <numeric>
+#include <shogun/io/SGIO.h>
+#include <shogun/lib/SGMatrix.h>
+#include <shogun/lib/SGVector.h>
+#include <shogun/mathematics/RandomStream.h>
+#include <shogun/mathematics/eigen3.h>
+#include <shogun/statistical_testing/internals/hsic/WithinBlockHSIC.h>
+
+using namespace shogun;
+using namespace internal;
+using namespace hsic;
+
+WithinBlockHSIC::WithinBlockHSIC(index_t dim_p, bool permute, uint64_t seed)
+: m_dim_p(dim_p), m_permute(permute), m_seed(seed)
+{
+}
+
+float32_t WithinBlockHSIC::operator()(const SGMatrix<float32_t>& block,
+	index_t block_index) const
+{
+	const index_t m=block.num_cols;
+	const index_t dim_q=block.num_rows-m_dim_p;
+	REQUIRE(m>=4, "Blocks need at least 4 samples (was %d)!\n", m);
+	REQUIRE(m_dim_p>0 && dim_q>0,
+		"Blocks (%d rows) must hold features of both samples (%d from p)!\n",
+		block.num_rows, m_dim_p);
+
+	Eigen::Map<const Eigen::MatrixXf> map(block.matrix, block.num_rows, m);
+	const Eigen::MatrixXd phi=map.topRows(m_dim_p).cast<float64_t>();
+	Eigen::MatrixXd psi=map.bottomRows(dim_q).cast<float64_t>();
+
+	if (m_permute)
+	{
+		SGVector<index_t> inds(m);
+		std::iota(inds.vector, inds.vector+m, 0);
+		RandomStream(m_seed, block_index).permute(inds);
+		Eigen::MatrixXd permuted(dim_q, m);
+		for (index_t i=0; i<m; ++i)
+			permuted.col(i)=psi.col(inds[i]);
+		psi.swap(permuted);
+	}
+
+	/* K=phi'*phi and L=psi'*psi with zeroed diagonals, i.e.
+	 * tr(KL)=||phi*psi'||^2, K1=phi'*(phi*1)-diag(K) */
+	const Eigen::VectorXd k_diag=phi.colwise().squaredNorm().transpose();
+	const Eigen::VectorXd l_diag=psi.colwise().squaredNorm().transpose();
+	const Eigen::VectorXd phi_sum=phi.rowwise().sum();
+	const Eigen::VectorXd psi_sum=psi.rowwise().sum();
+	const Eigen::VectorXd k_1=phi.transpose()*phi_sum-k_diag;
+	const Eigen::VectorXd l_1=psi.transpose()*psi_sum-l_diag;
+
+	const float64_t trace_kl=(phi*psi.transpose()).squaredNorm()-k_diag.dot(l_diag);
+	const float64_t sum_k=phi_sum.squaredNorm()-k_diag.sum();
+	const float64_t sum_l=psi_sum.squaredNorm()-l_diag.sum();
+	const float64_t sum_kl=k_1.dot(l_1);
+
+	/* Song et al. (2012), Feature Selection via Dependence Maximization */
+	float64_t result=trace_kl+sum_k*sum_l/(m-1)/(m-2)-2.0*sum_kl/(m-2);
+	result/=float64_t(m)*(m-3);
+	SG_SDEBUG("block HSIC = %f!\n", result);
+	return result;
+}
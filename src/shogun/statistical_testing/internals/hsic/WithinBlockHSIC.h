@@ -0,0 +1,53 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: agent
+ */
+
+#ifndef WITHIN_BLOCK_HSIC_H_
+#define WITHIN_BLOCK_HSIC_H_
+
+#include <shogun/lib/common.h>
+
+namespace shogun
+{
+
+template <typename T> class SGMatrix;
+
+namespace internal
+{
+
+namespace hsic
+{
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+/**
+ * Unbiased HSIC estimate of a block from explicit feature maps. The columns
+ * of the block hold the samples, the first dim_p rows the features of the
+ * samples from p and the remaining rows the features of the samples from q.
+ * The Gram matrices are never formed, so a block of B samples with D_p and
+ * D_q features takes O(B D_p D_q) time.
+ *
+ * With permute set, the pairs are shuffled within the block before, i.e.
+ * this is a sample of the block statistic under the null. The shuffle is
+ * drawn from the stream of the block index of the given seed, so the null
+ * samples do not depend on which thread computes which block.
+ */
+class WithinBlockHSIC
+{
+	typedef float32_t return_type;
+public:
+	WithinBlockHSIC(index_t dim_p, bool permute=false, uint64_t seed=0);
+	return_type operator()(const SGMatrix<return_type>& block, index_t block_index) const;
+private:
+	const index_t m_dim_p;
+	const bool m_permute;
+	const uint64_t m_seed;
+};
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+}
+
+}
+
+}
+
+#endif // WITHIN_BLOCK_HSIC_H_
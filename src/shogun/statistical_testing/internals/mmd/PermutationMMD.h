@@ -33,10 +33,13 @@
 #define PERMUTATION_MMD_H_
 
 #include <algorithm>
+#include <functional>
 #include <numeric>
+#include <vector>
 #include <shogun/lib/SGVector.h>
 #include <shogun/lib/SGMatrix.h>
 #include <shogun/mathematics/Math.h>
+#include <shogun/mathematics/RandomStream.h>
 #include <shogun/statistical_testing/internals/mmd/ComputeMMD.h>
 
 namespace shogun
@@ -50,7 +53,7 @@ namespace mmd
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
 struct PermutationMMD : ComputeMMD
 {
-	PermutationMMD() : m_save_inds(false)
+	PermutationMMD() : m_save_inds(false), m_block_size(64), m_batch_size(64)
 	{
 	}
 
@@ -62,28 +65,33 @@ struct PermutationMMD : ComputeMMD
 		precompute_permutation_inds();
 
 		const index_t size=m_n_x+m_n_y;
-		SGVector<float32_t> null_samples(m_num_null_samples);
-#pragma omp parallel for
-		for (auto n=0; n<m_num_null_samples; ++n)
+		return compute_null_samples([&kernel, size](index_t begin, index_t len, float64_t* columns)
 		{
-			terms_t terms;
-			for (auto j=0; j<size; ++j)
+			for (index_t c=0; c<len; ++c)
 			{
-				auto inverted_col=m_inverted_permuted_inds(j, n);
-				for (auto i=j; i<size; ++i)
-				{
-					auto inverted_row=m_inverted_permuted_inds(i, n);
-
-					if (inverted_row>=inverted_col)
-						add_term_lower(terms, kernel(i, j), inverted_row, inverted_col);
-					else
-						add_term_lower(terms, kernel(i, j), inverted_col, inverted_row);
-				}
+				for (index_t i=0; i<size; ++i)
+					columns[int64_t(c)*size+i]=kernel(i, begin+c);
 			}
-			null_samples[n]=compute(terms);
-			SG_SDEBUG("null_samples[%d] = %f!\n", n, null_samples[n]);
-		}
-		return null_samples;
+		});
+	}
+
+	template <typename T>
+	SGVector<float32_t> operator()(const SGMatrix<T>& kernel_matrix)
+	{
+		ASSERT(m_n_x>0 && m_n_y>0);
+		ASSERT(m_num_null_samples>0);
+		const index_t size=m_n_x+m_n_y;
+		REQUIRE(kernel_matrix.num_rows==size && kernel_matrix.num_cols==size,
+			"Kernel matrix (%dx%d) must be of the size of the total number "
+			"of samples from both distributions (%d)\n",
+			kernel_matrix.num_rows, kernel_matrix.num_cols, size);
+		precompute_permutation_inds();
+
+		return compute_null_samples([&kernel_matrix, size](index_t begin, index_t len, float64_t* columns)
+		{
+			const T* first=kernel_matrix.matrix+int64_t(begin)*size;
+			std::copy(first, first+int64_t(len)*size, columns);
+		});
 	}
 
 	SGMatrix<float32_t> operator()(const KernelManager& kernel_mgr)
@@ -108,27 +116,9 @@ struct PermutationMMD : ComputeMMD
 				}
 			}
 
-#pragma omp parallel for
-			for (auto n=0; n<m_num_null_samples; ++n)
-			{
-				terms_t null_terms;
-				for (auto i=0; i<size; ++i)
-				{
-					auto inverted_row=m_inverted_permuted_inds(i, n);
-					auto index_base=i*size-i*(i+1)/2;
-					for (auto j=i; j<size; ++j)
-					{
-						auto index=index_base+j;
-						auto inverted_col=m_inverted_permuted_inds(j, n);
-
-						if (inverted_row<=inverted_col)
-							add_term_upper(null_terms, km[index], inverted_row, inverted_col);
-						else
-							add_term_upper(null_terms, km[index], inverted_col, inverted_row);
-					}
-				}
-				null_samples(n, k)=compute(null_terms);
-			}
+			auto kernel_null_samples=compute_null_samples(packed_columns(km, size));
+			std::copy(kernel_null_samples.data(), kernel_null_samples.data()+m_num_null_samples,
+				null_samples.get_column_vector(k));
 		}
 		return null_samples;
 	}
@@ -148,7 +138,7 @@ struct PermutationMMD : ComputeMMD
 		precompute_permutation_inds();
 
 		const index_t size=m_n_x+m_n_y;
-		SGVector<float32_t> null_samples(m_num_null_samples);
+		SGVector<float32_t> null_samples;
 		SGVector<float64_t> result(kernel_mgr.num_kernels());
 
 		SGVector<float32_t> km(size*(size+1)/2);
@@ -168,49 +158,185 @@ struct PermutationMMD : ComputeMMD
 			float32_t statistic=compute(terms);
 			SG_SDEBUG("Kernel(%d): statistic=%f\n", k, statistic);
 
-#pragma omp parallel for
-			for (auto n=0; n<m_num_null_samples; ++n)
+			null_samples=compute_null_samples(packed_columns(km, size));
+			result[k]=compute_p_value(null_samples, statistic);
+			SG_SDEBUG("Kernel(%d): p_value=%f\n", k, result[k]);
+		}
+
+		return result;
+	}
+
+	/* The null samples are quadratic forms of the Gram matrix K with the
+	 * indicator vectors s of the samples that a permutation moves to p, e.g.
+	 * the sum of the permuted block of p is s'Ks and the sum of the block
+	 * between p and q is s'K1-s'Ks. The indicators of a batch of permutations
+	 * are the columns of a matrix S, so each block of columns of K is used
+	 * for a whole batch in one product with S. The products are accumulated
+	 * in 64 bit. fill_columns(begin, len, columns) writes columns begin, ...,
+	 * begin+len-1 of K to the column-major buffer columns. */
+	template <class ColumnBlock>
+	SGVector<float32_t> compute_null_samples(const ColumnBlock& fill_columns) const
+	{
+		const index_t size=m_n_x+m_n_y;
+		const index_t block_size=std::min(m_block_size, size);
+		const index_t batch_size=std::min(m_batch_size, m_num_null_samples);
+		const index_t num_blocks=(size+block_size-1)/block_size;
+		const bool incomplete=m_stype==ST_UNBIASED_INCOMPLETE;
+
+		SGVector<float64_t> quadratic(m_num_null_samples);
+		SGVector<float64_t> diag_xy(m_num_null_samples);
+		SGVector<float64_t> col_sums(size);
+		SGVector<float64_t> diag(size);
+		quadratic.zero();
+		diag_xy.zero();
+
+#pragma omp parallel
+		{
+			Eigen::MatrixXd columns(size, block_size);
+			Eigen::MatrixXd indicators(size, batch_size);
+			Eigen::MatrixXd products(block_size, batch_size);
+			std::vector<index_t> permuted_inds(incomplete ? int64_t(size)*batch_size : 0);
+			std::vector<float64_t> local_quadratic(m_num_null_samples, 0);
+			std::vector<float64_t> local_diag_xy(m_num_null_samples, 0);
+
+#pragma omp for schedule(dynamic)
+			for (index_t b=0; b<num_blocks; ++b)
 			{
-				terms_t null_terms;
-				for (auto i=0; i<size; ++i)
+				const index_t begin=b*block_size;
+				const index_t len=std::min(block_size, size-begin);
+				fill_columns(begin, len, columns.data());
+				for (index_t c=0; c<len; ++c)
+				{
+					col_sums[begin+c]=columns.col(c).sum();
+					diag[begin+c]=columns(begin+c, c);
+				}
+
+				for (index_t first=0; first<m_num_null_samples; first+=batch_size)
 				{
-					auto inverted_row=m_inverted_permuted_inds(i, n);
-					auto index_base=i*size-i*(i+1)/2;
-					for (auto j=i; j<size; ++j)
+					const index_t num=std::min(batch_size, m_num_null_samples-first);
+					for (index_t n=0; n<num; ++n)
 					{
-						auto index=index_base+j;
-						auto inverted_col=m_inverted_permuted_inds(j, n);
+						for (index_t i=0; i<size; ++i)
+						{
+							auto inverted=m_inverted_permuted_inds(i, first+n);
+							indicators(i, n)=inverted<m_n_x ? 1 : 0;
+							if (incomplete)
+								permuted_inds[int64_t(n)*size+inverted]=i;
+						}
+					}
+
+					products.topLeftCorner(len, num).noalias()=
+						columns.leftCols(len).transpose()*indicators.leftCols(num);
 
-						if (inverted_row<=inverted_col)
-							add_term_upper(null_terms, km[index], inverted_row, inverted_col);
-						else
-							add_term_upper(null_terms, km[index], inverted_col, inverted_row);
+					for (index_t n=0; n<num; ++n)
+					{
+						float64_t sum=0;
+						for (index_t c=0; c<len; ++c)
+							sum+=indicators(begin+c, n)*products(c, n);
+						local_quadratic[first+n]+=sum;
+
+						/* K(i, j) for sample i at position p<n_x and
+						 * sample j at position p+n_x */
+						if (incomplete)
+						{
+							for (index_t c=0; c<len; ++c)
+							{
+								auto inverted=m_inverted_permuted_inds(begin+c, first+n);
+								if (inverted<m_n_x)
+									local_diag_xy[first+n]+=columns(permuted_inds[int64_t(n)*size+inverted+m_n_x], c);
+							}
+						}
 					}
 				}
-				null_samples[n]=compute(null_terms);
 			}
-			result[k]=compute_p_value(null_samples, statistic);
-			SG_SDEBUG("Kernel(%d): p_value=%f\n", k, result[k]);
+
+#pragma omp critical
+			for (index_t n=0; n<m_num_null_samples; ++n)
+			{
+				quadratic[n]+=local_quadratic[n];
+				diag_xy[n]+=local_diag_xy[n];
+			}
 		}
 
-		return result;
+		float64_t total=0;
+		float64_t trace=0;
+		for (index_t i=0; i<size; ++i)
+		{
+			total+=col_sums[i];
+			trace+=diag[i];
+		}
+
+		SGVector<float32_t> null_samples(m_num_null_samples);
+#pragma omp parallel for
+		for (index_t n=0; n<m_num_null_samples; ++n)
+		{
+			float64_t sum_x=0;
+			float64_t diag_x=0;
+			for (index_t i=0; i<size; ++i)
+			{
+				if (m_inverted_permuted_inds(i, n)<m_n_x)
+				{
+					sum_x+=col_sums[i];
+					diag_x+=diag[i];
+				}
+			}
+
+			/* the terms hold the sums of the upper triangles with diagonals */
+			const float64_t xx=quadratic[n];
+			const float64_t yy=total-2*sum_x+xx;
+			terms_t terms;
+			terms.diag[0]=diag_x;
+			terms.diag[1]=trace-diag_x;
+			terms.diag[2]=diag_xy[n];
+			terms.term[0]=(xx-terms.diag[0])/2+terms.diag[0];
+			terms.term[1]=(yy-terms.diag[1])/2+terms.diag[1];
+			terms.term[2]=sum_x-xx;
+			null_samples[n]=compute(terms);
+			SG_SDEBUG("null_samples[%d] = %f!\n", n, null_samples[n]);
+		}
+		return null_samples;
+	}
+
+	/* column blocks of a Gram matrix whose upper triangle is stored row-wise */
+	static std::function<void(index_t, index_t, float64_t*)> packed_columns(
+		const SGVector<float32_t>& km, index_t size)
+	{
+		return [km, size](index_t begin, index_t len, float64_t* columns)
+		{
+			for (index_t c=0; c<len; ++c)
+			{
+				const int64_t j=begin+c;
+				for (int64_t i=0; i<size; ++i)
+				{
+					auto index=i<=j ? i*size-i*(i+1)/2+j : j*size-j*(j+1)/2+i;
+					columns[c*size+i]=km[index];
+				}
+			}
+		};
 	}
 
 	inline void precompute_permutation_inds()
 	{
 		ASSERT(m_num_null_samples>0);
 		allocate_permutation_inds();
+
+		/* every null sample draws from its own stream, so the permutations
+		 * do not depend on the number of threads */
+		const uint64_t seed=CMath::random();
+		const index_t size=m_n_x+m_n_y;
+#pragma omp parallel for
 		for (auto n=0; n<m_num_null_samples; ++n)
 		{
-			std::iota(m_permuted_inds.data(), m_permuted_inds.data()+m_permuted_inds.size(), 0);
-			CMath::permute(m_permuted_inds);
+			SGVector<index_t> permuted_inds(size);
+			std::iota(permuted_inds.data(), permuted_inds.data()+size, 0);
+			RandomStream(seed, n).permute(permuted_inds);
 			if (m_save_inds)
 			{
-				auto offset=n*m_permuted_inds.size();
-				std::copy(m_permuted_inds.data(), m_permuted_inds.data()+m_permuted_inds.size(), &m_all_inds.matrix[offset]);
+				auto offset=int64_t(n)*size;
+				std::copy(permuted_inds.data(), permuted_inds.data()+size, &m_all_inds.matrix[offset]);
 			}
-			for (index_t i=0; i<m_permuted_inds.size(); ++i)
-				m_inverted_permuted_inds(m_permuted_inds[i], n)=i;
+			for (index_t i=0; i<size; ++i)
+				m_inverted_permuted_inds(permuted_inds[i], n)=i;
 		}
 	}
 
@@ -224,9 +350,6 @@ struct PermutationMMD : ComputeMMD
 	inline void allocate_permutation_inds()
 	{
 		const index_t size=m_n_x+m_n_y;
-		if (m_permuted_inds.size()!=size)
-			m_permuted_inds=SGVector<index_t>(size);
-
 		if (m_inverted_permuted_inds.num_cols!=m_num_null_samples || m_inverted_permuted_inds.num_rows!=size)
 			m_inverted_permuted_inds=SGMatrix<index_t>(size, m_num_null_samples);
 
@@ -236,7 +359,10 @@ struct PermutationMMD : ComputeMMD
 
 	index_t m_num_null_samples;
 	bool m_save_inds;
-	SGVector<index_t> m_permuted_inds;
+	/* number of columns of the Gram matrix per block */
+	index_t m_block_size;
+	/* number of permutations per product with a block */
+	index_t m_batch_size;
 	SGMatrix<index_t> m_inverted_permuted_inds;
 	SGMatrix<index_t> m_all_inds;
 };
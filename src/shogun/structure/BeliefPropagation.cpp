@@ -7,6 +7,7 @@
 #include <shogun/structure/BeliefPropagation.h>
 #include <shogun/lib/DynamicObjectArray.h>
 #include <shogun/io/SGIO.h>
+#include <shogun/mathematics/Math.h>
 #include <numeric>
 #include <algorithm>
 #include <functional>
@@ -551,3 +552,410 @@ void CTreeMaxProduct::top_down_pass()
 	SG_DEBUG("***leave top_down_pass().\n");
 }
 
+
+// -----------------------------------------------------------------
+
+// log(exp(a) + exp(b)), CMath::logarithmic_sum() is only approximate and
+// returns the max unless the log table is set up
+static inline float64_t log_add(float64_t a, float64_t b)
+{
+	float64_t hi = CMath::max(a, b);
+	float64_t lo = CMath::min(a, b);
+	if (lo == -std::numeric_limits<float64_t>::infinity())
+		return hi;
+
+	return hi + std::log1p(std::exp(lo - hi));
+}
+
+CLoopyMaxProduct::CLoopyMaxProduct()
+	: CBeliefPropagation(), m_num_iter(0), m_converged(false)
+{
+	SG_UNSTABLE("CLoopyMaxProduct::CLoopyMaxProduct()", "\n");
+}
+
+CLoopyMaxProduct::CLoopyMaxProduct(CFactorGraph* fg, Parameter param)
+	: CBeliefPropagation(fg), m_param(param), m_num_iter(0), m_converged(false)
+{
+	ASSERT(m_fg != NULL);
+	REQUIRE(m_param.m_damping >= 0 && m_param.m_damping < 1,
+		"%s::CLoopyMaxProduct(): damping should be in [0, 1)!\n", get_name());
+
+	init();
+}
+
+CLoopyMaxProduct::~CLoopyMaxProduct()
+{
+}
+
+void CLoopyMaxProduct::init()
+{
+	SGVector<int32_t> cards = m_fg->get_cardinalities();
+	CDynamicObjectArray* facs = m_fg->get_factors();
+	int32_t num_vars = cards.size();
+	int32_t num_facs = facs->get_num_elements();
+
+	m_var_offset.assign(num_vars + 1, 0);
+	for (int32_t vi = 0; vi < num_vars; vi++)
+		m_var_offset[vi + 1] = m_var_offset[vi] + cards[vi];
+
+	// lay out the edges factor by factor, the first variable of a factor
+	// table is the fastest running one
+	m_fac_edge_begin.assign(num_facs + 1, 0);
+	m_fac_energy_offset.assign(num_facs + 1, 0);
+	m_edge_var.clear();
+	m_edge_stride.clear();
+	m_edge_offset.assign(1, 0);
+	m_var_fac_begin.assign(num_vars + 1, 0);
+
+	for (int32_t fi = 0; fi < num_facs; fi++)
+	{
+		CFactor* fac = dynamic_cast<CFactor*>(facs->get_element(fi));
+		SGVector<int32_t> fvars = fac->get_variables();
+		SG_UNREF(fac);
+
+		int32_t stride = 1;
+		for (int32_t vi = 0; vi < fvars.size(); vi++)
+		{
+			int32_t var_id = fvars[vi];
+			m_edge_var.push_back(var_id);
+			m_edge_stride.push_back(stride);
+			m_edge_offset.push_back(m_edge_offset.back() + cards[var_id]);
+			m_var_fac_begin[var_id + 1]++;
+			stride *= cards[var_id];
+		}
+
+		m_fac_edge_begin[fi + 1] = m_edge_var.size();
+		m_fac_energy_offset[fi + 1] = m_fac_energy_offset[fi] + stride;
+	}
+	SG_UNREF(facs);
+
+	// adjacency from variables to factors in CSR form
+	for (int32_t vi = 0; vi < num_vars; vi++)
+		m_var_fac_begin[vi + 1] += m_var_fac_begin[vi];
+
+	m_var_facs.resize(m_edge_var.size());
+	std::vector<int32_t> fill_pos(m_var_fac_begin.begin(), m_var_fac_begin.end() - 1);
+	for (int32_t fi = 0; fi < num_facs; fi++)
+	{
+		for (int32_t ei = m_fac_edge_begin[fi]; ei < m_fac_edge_begin[fi + 1]; ei++)
+			m_var_facs[fill_pos[m_edge_var[ei]]++] = fi;
+	}
+
+	m_energies.resize(m_fac_energy_offset.back());
+	m_msgs.resize(m_edge_offset.back());
+	m_new_msgs.resize(m_edge_offset.back());
+	m_var_msgs.resize(m_edge_offset.back());
+	m_beliefs.resize(m_var_offset.back());
+	m_residuals.resize(num_facs);
+
+	m_order.reserve(num_facs);
+	m_batch.reserve(num_facs);
+	m_dirty.reserve(num_facs);
+	m_var_stamp.resize(num_vars);
+	m_fac_stamp.resize(num_facs);
+}
+
+void CLoopyMaxProduct::load_energies()
+{
+	CDynamicObjectArray* facs = m_fg->get_factors();
+	REQUIRE(facs->get_num_elements() == (int32_t)m_residuals.size(),
+		"%s::load_energies(): factor graph has been modified!\n", get_name());
+
+	for (int32_t fi = 0; fi < facs->get_num_elements(); fi++)
+	{
+		CFactor* fac = dynamic_cast<CFactor*>(facs->get_element(fi));
+		SGVector<float64_t> fenrgs = fac->get_energies();
+		SG_UNREF(fac);
+
+		REQUIRE(fenrgs.size() == m_fac_energy_offset[fi + 1] - m_fac_energy_offset[fi],
+			"%s::load_energies(): energies of factor %d have not been computed!\n",
+			get_name(), fi);
+
+		std::copy(fenrgs.vector, fenrgs.vector + fenrgs.vlen,
+			m_energies.begin() + m_fac_energy_offset[fi]);
+	}
+	SG_UNREF(facs);
+}
+
+float64_t CLoopyMaxProduct::compute_factor_messages(int32_t fac_id)
+{
+	const int32_t e_begin = m_fac_edge_begin[fac_id];
+	const int32_t e_end = m_fac_edge_begin[fac_id + 1];
+	const int32_t e_num_assigns = m_fac_energy_offset[fac_id + 1] - m_fac_energy_offset[fac_id];
+	const float64_t* fenrgs = m_energies.data() + m_fac_energy_offset[fac_id];
+
+	// q_v2f = sum_{g!=f} r_g2v, i.e. the belief of v without the msg of f
+	for (int32_t ei = e_begin; ei < e_end; ei++)
+	{
+		int32_t var_id = m_edge_var[ei];
+		const float64_t* belief = m_beliefs.data() + m_var_offset[var_id];
+		const float64_t* r_f2v = m_msgs.data() + m_edge_offset[ei];
+		float64_t* q_v2f = m_var_msgs.data() + m_edge_offset[ei];
+		float64_t* r_f2v_new = m_new_msgs.data() + m_edge_offset[ei];
+
+		for (int32_t si = 0; si < m_edge_offset[ei + 1] - m_edge_offset[ei]; si++)
+		{
+			if (r_f2v[si] == -std::numeric_limits<float64_t>::infinity())
+				q_v2f[si] = sum_var_msgs(var_id, si, ei);
+			else
+				q_v2f[si] = belief[si] - r_f2v[si];
+			r_f2v_new[si] = -std::numeric_limits<float64_t>::infinity();
+		}
+	}
+
+	// r_f2v = max(-fenrg + sum_{u!=v} q_u2f[adj_var_state]), where the max is
+	// replaced by log-sum-exp for sum-product
+	for (int32_t ai = 0; ai < e_num_assigns; ai++)
+	{
+		float64_t score = -fenrgs[ai];
+		for (int32_t ei = e_begin; ei < e_end; ei++)
+		{
+			int32_t card = m_edge_offset[ei + 1] - m_edge_offset[ei];
+			int32_t state = (ai / m_edge_stride[ei]) % card;
+			score += m_var_msgs[m_edge_offset[ei] + state];
+		}
+
+		for (int32_t ei = e_begin; ei < e_end; ei++)
+		{
+			int32_t card = m_edge_offset[ei + 1] - m_edge_offset[ei];
+			int32_t idx = m_edge_offset[ei] + (ai / m_edge_stride[ei]) % card;
+			float64_t val = score - m_var_msgs[idx];
+			if (m_var_msgs[idx] == -std::numeric_limits<float64_t>::infinity())
+			{
+				val = -fenrgs[ai];
+				for (int32_t ej = e_begin; ej < e_end; ej++)
+				{
+					int32_t card_j = m_edge_offset[ej + 1] - m_edge_offset[ej];
+					if (ej != ei)
+						val += m_var_msgs[m_edge_offset[ej] + (ai / m_edge_stride[ej]) % card_j];
+				}
+			}
+
+			if (m_param.m_sum_product)
+				m_new_msgs[idx] = log_add(m_new_msgs[idx], val);
+			else if (val > m_new_msgs[idx])
+				m_new_msgs[idx] = val;
+		}
+	}
+
+	// normalize, damp and measure the change w.r.t. the current msgs
+	float64_t residual = 0;
+	for (int32_t ei = e_begin; ei < e_end; ei++)
+	{
+		int32_t card = m_edge_offset[ei + 1] - m_edge_offset[ei];
+		const float64_t* r_f2v = m_msgs.data() + m_edge_offset[ei];
+		float64_t* r_f2v_new = m_new_msgs.data() + m_edge_offset[ei];
+
+		float64_t norm = *std::max_element(r_f2v_new, r_f2v_new + card);
+		if (norm == -std::numeric_limits<float64_t>::infinity())
+		{
+			// no state of the variable is feasible given the other msgs,
+			// send a uniform msg instead of NaNs
+			std::fill(r_f2v_new, r_f2v_new + card, 0.0);
+			norm = 0;
+		}
+
+		if (m_param.m_sum_product)
+		{
+			float64_t sum = 0;
+			for (int32_t si = 0; si < card; si++)
+				sum += std::exp(r_f2v_new[si] - norm);
+			norm += std::log(sum);
+		}
+
+		for (int32_t si = 0; si < card; si++)
+		{
+			r_f2v_new[si] -= norm;
+			if (m_param.m_damping > 0)
+			{
+				r_f2v_new[si] = (1 - m_param.m_damping) * r_f2v_new[si]
+					+ m_param.m_damping * r_f2v[si];
+			}
+
+			if (r_f2v_new[si] != r_f2v[si])
+				residual = CMath::max(residual, CMath::abs(r_f2v_new[si] - r_f2v[si]));
+		}
+	}
+
+	return residual;
+}
+
+void CLoopyMaxProduct::commit_factor_messages(int32_t fac_id)
+{
+	for (int32_t ei = m_fac_edge_begin[fac_id]; ei < m_fac_edge_begin[fac_id + 1]; ei++)
+	{
+		int32_t var_id = m_edge_var[ei];
+		float64_t* belief = m_beliefs.data() + m_var_offset[var_id];
+		float64_t* r_f2v = m_msgs.data() + m_edge_offset[ei];
+		const float64_t* r_f2v_new = m_new_msgs.data() + m_edge_offset[ei];
+
+		for (int32_t si = 0; si < m_edge_offset[ei + 1] - m_edge_offset[ei]; si++)
+		{
+			if (r_f2v_new[si] == r_f2v[si])
+				continue;
+
+			float64_t r_f2v_old = r_f2v[si];
+			r_f2v[si] = r_f2v_new[si];
+
+			if (r_f2v_old == -std::numeric_limits<float64_t>::infinity())
+				belief[si] = sum_var_msgs(var_id, si, -1);
+			else
+				belief[si] += r_f2v_new[si] - r_f2v_old;
+		}
+	}
+}
+
+float64_t CLoopyMaxProduct::sum_var_msgs(int32_t var_id, int32_t state, int32_t skip_edge) const
+{
+	float64_t sum = 0;
+	for (int32_t ai = m_var_fac_begin[var_id]; ai < m_var_fac_begin[var_id + 1]; ai++)
+	{
+		// a factor is listed once per occurrence of the variable
+		int32_t fac_id = m_var_facs[ai];
+		if (ai > m_var_fac_begin[var_id] && m_var_facs[ai - 1] == fac_id)
+			continue;
+
+		for (int32_t ei = m_fac_edge_begin[fac_id]; ei < m_fac_edge_begin[fac_id + 1]; ei++)
+		{
+			if (ei != skip_edge && m_edge_var[ei] == var_id)
+				sum += m_msgs[m_edge_offset[ei] + state];
+		}
+	}
+
+	return sum;
+}
+
+float64_t CLoopyMaxProduct::inference(SGVector<int32_t> assignment)
+{
+	int32_t num_vars = m_var_offset.size() - 1;
+	int32_t num_facs = m_residuals.size();
+
+	REQUIRE(assignment.size() == num_vars,
+		"%s::inference(): the output assignment should be prepared as"
+		"the same size as variables!\n", get_name());
+
+	load_energies();
+	std::fill(m_msgs.begin(), m_msgs.end(), 0);
+	std::fill(m_beliefs.begin(), m_beliefs.end(), 0);
+	std::fill(m_var_stamp.begin(), m_var_stamp.end(), -1);
+	std::fill(m_fac_stamp.begin(), m_fac_stamp.end(), -1);
+	m_converged = false;
+
+	#pragma omp parallel for
+	for (int32_t fi = 0; fi < num_facs; fi++)
+		m_residuals[fi] = compute_factor_messages(fi);
+
+	for (m_num_iter = 0; m_num_iter < m_param.m_max_iter; m_num_iter++)
+	{
+		// pending updates ordered by residual, largest first
+		m_order.clear();
+		for (int32_t fi = 0; fi < num_facs; fi++)
+		{
+			if (m_residuals[fi] > m_param.m_tolerance)
+				m_order.push_back(fi);
+		}
+
+		if (m_order.empty())
+		{
+			m_converged = true;
+			break;
+		}
+
+		std::sort(m_order.begin(), m_order.end(),
+			[this](int32_t a, int32_t b) { return m_residuals[a] > m_residuals[b]; });
+
+		// greedily pick factors without shared variables, their msgs and the
+		// beliefs they touch are disjoint so they can be committed concurrently
+		m_batch.clear();
+		for (uint32_t oi = 0; oi < m_order.size(); oi++)
+		{
+			int32_t fac_id = m_order[oi];
+			bool is_free = true;
+			for (int32_t ei = m_fac_edge_begin[fac_id]; ei < m_fac_edge_begin[fac_id + 1] && is_free; ei++)
+				is_free = m_var_stamp[m_edge_var[ei]] != m_num_iter;
+
+			if (!is_free)
+				continue;
+
+			for (int32_t ei = m_fac_edge_begin[fac_id]; ei < m_fac_edge_begin[fac_id + 1]; ei++)
+				m_var_stamp[m_edge_var[ei]] = m_num_iter;
+
+			m_batch.push_back(fac_id);
+		}
+
+		int32_t batch_size = m_batch.size();
+		#pragma omp parallel for
+		for (int32_t bi = 0; bi < batch_size; bi++)
+			commit_factor_messages(m_batch[bi]);
+
+		// pending msgs of all factors adjacent to updated variables are stale
+		m_dirty.clear();
+		for (int32_t bi = 0; bi < batch_size; bi++)
+		{
+			int32_t fac_id = m_batch[bi];
+			for (int32_t ei = m_fac_edge_begin[fac_id]; ei < m_fac_edge_begin[fac_id + 1]; ei++)
+			{
+				int32_t var_id = m_edge_var[ei];
+				for (int32_t ai = m_var_fac_begin[var_id]; ai < m_var_fac_begin[var_id + 1]; ai++)
+				{
+					int32_t adj_fac_id = m_var_facs[ai];
+					if (m_fac_stamp[adj_fac_id] == m_num_iter)
+						continue;
+
+					m_fac_stamp[adj_fac_id] = m_num_iter;
+					m_dirty.push_back(adj_fac_id);
+				}
+			}
+		}
+
+		int32_t num_dirty = m_dirty.size();
+		#pragma omp parallel for
+		for (int32_t di = 0; di < num_dirty; di++)
+			m_residuals[m_dirty[di]] = compute_factor_messages(m_dirty[di]);
+	}
+
+	if (!m_converged)
+		SG_DEBUG("%s::inference(): not converged after %d rounds.\n", get_name(), m_num_iter);
+
+	// decode by maximizing the beliefs of each variable
+	for (int32_t vi = 0; vi < num_vars; vi++)
+	{
+		const float64_t* belief = m_beliefs.data() + m_var_offset[vi];
+		int32_t card = m_var_offset[vi + 1] - m_var_offset[vi];
+		assignment[vi] = static_cast<int32_t>(
+			std::max_element(belief, belief + card) - belief);
+	}
+
+	return m_fg->evaluate_energy(assignment);
+}
+
+SGVector<float64_t> CLoopyMaxProduct::get_log_beliefs(int32_t var_id) const
+{
+	REQUIRE(var_id >= 0 && var_id < (int32_t)m_var_offset.size() - 1,
+		"%s::get_log_beliefs(): variable index out of range!\n", get_name());
+
+	int32_t card = m_var_offset[var_id + 1] - m_var_offset[var_id];
+	const float64_t* belief = m_beliefs.data() + m_var_offset[var_id];
+
+	SGVector<float64_t> log_beliefs(card);
+	float64_t norm = *std::max_element(belief, belief + card);
+	if (norm == -std::numeric_limits<float64_t>::infinity())
+	{
+		// no feasible state, all states are equally (un)likely
+		log_beliefs.set_const(m_param.m_sum_product ? -std::log(card) : 0);
+		return log_beliefs;
+	}
+
+	if (m_param.m_sum_product)
+	{
+		float64_t sum = 0;
+		for (int32_t si = 0; si < card; si++)
+			sum += std::exp(belief[si] - norm);
+		norm += std::log(sum);
+	}
+
+	for (int32_t si = 0; si < card; si++)
+		log_beliefs[si] = belief[si] - norm;
+
+	return log_beliefs;
+}
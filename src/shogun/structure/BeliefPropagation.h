@@ -132,6 +132,152 @@ private:
 	msgset_map_type m_msgset_map_var;
 };
 
+/** loopy belief propagation for general factor graphs
+ *
+ * Factor-to-variable messages of all edges are kept in flat arrays that are
+ * allocated once at construction. Updates are scheduled by their residual,
+ * i.e. the largest change a pending factor update would make to its outgoing
+ * messages, see [1]. In each round the factors with the largest residuals
+ * that do not share any variable are committed concurrently, after which only
+ * the factors adjacent to the touched variables are re-evaluated.
+ *
+ * Both max-product (MAP decoding, the default) and sum-product (marginal
+ * beliefs) message updates are supported. On tree graphs the result is exact.
+ *
+ * [1] G. Elidan, I. McGraw and D. Koller,
+ * Residual Belief Propagation: Informed Scheduling for Asynchronous Message
+ * Passing, UAI 2006.
+ */
+IGNORE_IN_CLASSLIST class CLoopyMaxProduct : public CBeliefPropagation
+{
+public:
+	/** Parameter for loopy belief propagation */
+	struct Parameter
+	{
+		Parameter(const int32_t max_iter = 1000,
+		          const float64_t tolerance = 1e-8,
+		          const float64_t damping = 0.0,
+		          const bool sum_product = false)
+			: m_max_iter(max_iter),
+			  m_tolerance(tolerance),
+			  m_damping(damping),
+			  m_sum_product(sum_product)
+		{}
+
+		/** maximum number of scheduling rounds */
+		int32_t m_max_iter;
+		/** messages are converged if no residual exceeds this value */
+		float64_t m_tolerance;
+		/** weight of the old message in the update, in [0, 1) */
+		float64_t m_damping;
+		/** use sum-product instead of max-product updates */
+		bool m_sum_product;
+	};
+
+public:
+	CLoopyMaxProduct();
+
+	/** constructor
+	 *
+	 * @param fg factor graph
+	 * @param param parameters
+	 */
+	CLoopyMaxProduct(CFactorGraph* fg, Parameter param = Parameter());
+
+	virtual ~CLoopyMaxProduct();
+
+	/** @return class name */
+	virtual const char* get_name() const { return "LoopyMaxProduct"; }
+
+	virtual float64_t inference(SGVector<int32_t> assignment);
+
+	/** @return number of scheduling rounds used by the last inference */
+	int32_t get_num_iterations() const { return m_num_iter; }
+
+	/** @return whether the last inference converged */
+	bool is_converged() const { return m_converged; }
+
+	/** normalized log-beliefs of a variable after inference, i.e. the log
+	 * max-marginals (max-product) or log-marginals (sum-product)
+	 *
+	 * @param var_id variable index
+	 * @return beliefs of each state of the variable
+	 */
+	SGVector<float64_t> get_log_beliefs(int32_t var_id) const;
+
+protected:
+	/** copy the current factor energies into the flat energy table */
+	void load_energies();
+
+	/** compute the pending messages of a factor towards all its variables
+	 *
+	 * @param fac_id factor index
+	 * @return residual, i.e. the largest change w.r.t. the current messages
+	 */
+	float64_t compute_factor_messages(int32_t fac_id);
+
+	/** replace the messages of a factor by its pending messages and update
+	 * the beliefs of its variables accordingly
+	 *
+	 * @param fac_id factor index
+	 */
+	void commit_factor_messages(int32_t fac_id);
+
+	/** sum of the current messages from the factors of a variable to one of
+	 * its states. Used instead of subtracting a message from the belief
+	 * where both are -inf, e.g. for states ruled out by infinite energies.
+	 *
+	 * @param var_id variable index
+	 * @param state state of the variable
+	 * @param skip_edge edge whose message is left out, -1 for none
+	 * @return sum of the messages
+	 */
+	float64_t sum_var_msgs(int32_t var_id, int32_t state, int32_t skip_edge) const;
+
+private:
+	void init();
+
+private:
+	Parameter m_param;
+	int32_t m_num_iter;
+	bool m_converged;
+
+	/** offsets of the states of each variable, size num_vars+1 */
+	std::vector<int32_t> m_var_offset;
+	/** first edge of each factor, size num_factors+1 */
+	std::vector<int32_t> m_fac_edge_begin;
+	/** offsets of the energy table of each factor, size num_factors+1 */
+	std::vector<int32_t> m_fac_energy_offset;
+	/** first adjacent factor of each variable, size num_vars+1 */
+	std::vector<int32_t> m_var_fac_begin;
+	/** factors adjacent to each variable */
+	std::vector<int32_t> m_var_facs;
+	/** variable of each edge */
+	std::vector<int32_t> m_edge_var;
+	/** stride of the variable of each edge within its factor table */
+	std::vector<int32_t> m_edge_stride;
+	/** offsets of the messages of each edge, size num_edges+1 */
+	std::vector<int32_t> m_edge_offset;
+
+	std::vector<float64_t> m_energies;
+	/** current factor-to-variable messages */
+	std::vector<float64_t> m_msgs;
+	/** pending factor-to-variable messages */
+	std::vector<float64_t> m_new_msgs;
+	/** variable-to-factor messages */
+	std::vector<float64_t> m_var_msgs;
+	/** sum of incoming messages of each variable */
+	std::vector<float64_t> m_beliefs;
+	std::vector<float64_t> m_residuals;
+
+	/** scheduling work space */
+	std::vector<int32_t> m_order;
+	std::vector<int32_t> m_batch;
+	std::vector<int32_t> m_dirty;
+	std::vector<int32_t> m_var_stamp;
+	std::vector<int32_t> m_fac_stamp;
+};
+
 }
 
 #endif /* DOXYGEN_SHOULD_SKIP_THIS */
@@ -39,8 +39,7 @@ CMAPInference::CMAPInference(CFactorGraph* fg, EMAPInferType inference_method)
 			m_infer_impl = new CGEMPLP(fg);
 			break;
 		case LOOPY_MAX_PROD:
-			SG_ERROR("%s::CMAPInference(): LoopyMaxProduct has not been implemented!\n",
-				get_name());
+			m_infer_impl = new CLoopyMaxProduct(fg);
 			break;
 		case LP_RELAXATION:
 			SG_ERROR("%s::CMAPInference(): LPRelaxation has not been implemented!\n",
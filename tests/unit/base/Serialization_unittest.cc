@@ -6,12 +6,19 @@
  */
 
 #include <gtest/gtest.h>
+#include <shogun/base/some.h>
 #include <shogun/labels/BinaryLabels.h>
 #include <shogun/labels/MulticlassLabels.h>
 #include <shogun/io/SerializableAsciiFile.h>
+#include <shogun/io/SerializableBinaryFile.h>
 #include <shogun/classifier/svm/LibLinear.h>
 #include <shogun/features/DataGenerator.h>
 #include <shogun/features/DenseFeatures.h>
+#include <shogun/features/SparseFeatures.h>
+#include <shogun/features/StringFeatures.h>
+#include "utils/Utils.h"
+
+#include <unistd.h>
 
 using namespace shogun;
 
@@ -69,6 +76,71 @@ TEST(Serialization,multiclass_labels)
 	SG_UNREF(labels);
 }
 
+TEST(Serialization, binary_file)
+{
+	char filename[] = "binary_serialization-XXXXXX";
+	generate_temp_filename(filename);
+
+	SGMatrix<float64_t> dense(5, 17);
+	SGMatrix<int32_t> sparse(7, 11);
+	for (index_t i = 0; i < dense.num_rows * dense.num_cols; ++i)
+		dense.matrix[i] = CMath::randn_double();
+	for (index_t i = 0; i < sparse.num_rows * sparse.num_cols; ++i)
+		sparse.matrix[i] = i % 3 ? 0 : i;
+
+	auto dense_feats = some<CDenseFeatures<float64_t>>(dense);
+	auto sparse_feats = some<CSparseFeatures<int32_t>>(sparse);
+	auto string_feats = some<CStringFeatures<char>>(
+		generateRandomStringData<char>(9, 30, 1), RAWBYTE);
+
+	auto file = some<CSerializableBinaryFile>(filename, 'w');
+	ASSERT_TRUE(dense_feats->save_serializable(file));
+	file->close();
+	auto dense_loaded = some<CDenseFeatures<float64_t>>();
+	file = some<CSerializableBinaryFile>(filename, 'r');
+	ASSERT_TRUE(dense_loaded->load_serializable(file));
+	file->close();
+	EXPECT_TRUE(dense_loaded->get_feature_matrix().equals(dense));
+
+	file = some<CSerializableBinaryFile>(filename, 'w');
+	ASSERT_TRUE(sparse_feats->save_serializable(file));
+	file->close();
+	auto sparse_loaded = some<CSparseFeatures<int32_t>>();
+	file = some<CSerializableBinaryFile>(filename, 'r');
+	ASSERT_TRUE(sparse_loaded->load_serializable(file));
+	file->close();
+	EXPECT_TRUE(sparse_loaded->get_full_feature_matrix().equals(sparse));
+
+	/* string features hold their alphabet as a nested object */
+	file = some<CSerializableBinaryFile>(filename, 'w');
+	ASSERT_TRUE(string_feats->save_serializable(file));
+	file->close();
+	auto string_loaded = some<CStringFeatures<char>>();
+	file = some<CSerializableBinaryFile>(filename, 'r');
+	ASSERT_TRUE(string_loaded->load_serializable(file));
+	file->close();
+	ASSERT_EQ(
+		string_loaded->get_num_vectors(), string_feats->get_num_vectors());
+	CAlphabet* alphabet = string_feats->get_alphabet();
+	CAlphabet* alphabet_loaded = string_loaded->get_alphabet();
+	EXPECT_EQ(alphabet_loaded->get_alphabet(), alphabet->get_alphabet());
+	SG_UNREF(alphabet_loaded);
+	SG_UNREF(alphabet);
+	for (index_t i = 0; i < string_feats->get_num_vectors(); ++i)
+		EXPECT_TRUE(string_loaded->get_feature_vector(i).equals(
+			string_feats->get_feature_vector(i)));
+
+	/* other formats are rejected */
+	auto ascii = some<CSerializableAsciiFile>(filename, 'w');
+	ASSERT_TRUE(dense_feats->save_serializable(ascii));
+	ascii->close();
+	file = some<CSerializableBinaryFile>(filename, 'r');
+	EXPECT_FALSE(dense_loaded->load_serializable(file));
+	file->close();
+
+	unlink(filename);
+}
+
 #ifdef HAVE_LAPACK
 TEST(Serialization, liblinear)
 {
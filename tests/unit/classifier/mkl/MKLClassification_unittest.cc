@@ -0,0 +1,114 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: agent
+ */
+
+#include <gtest/gtest.h>
+#include <shogun/classifier/mkl/MKLClassification.h>
+#include <shogun/classifier/svm/LibSVM.h>
+#include <shogun/features/CombinedFeatures.h>
+#include <shogun/features/DenseFeatures.h>
+#include <shogun/kernel/CombinedKernel.h>
+#include <shogun/kernel/GaussianKernel.h>
+#include <shogun/kernel/normalizer/SqrtDiagKernelNormalizer.h>
+#include <shogun/labels/BinaryLabels.h>
+#include <shogun/mathematics/Math.h>
+
+using namespace shogun;
+
+/* 1/2*alpha'*K_n*alpha by setting a single sub-kernel weight at a time */
+static SGVector<float64_t> sum_beta_reference(CMKL* mkl, CKernel* kernel)
+{
+	int32_t num_kernels=kernel->get_num_subkernels();
+	SGVector<float64_t> old_beta=kernel->get_subkernel_weights().clone();
+	SGVector<float64_t> sumw(num_kernels);
+	sumw.zero();
+
+	for (int32_t n=0; n<num_kernels; n++)
+	{
+		SGVector<float64_t> beta(num_kernels);
+		beta.zero();
+		beta[n]=1.0;
+		kernel->set_subkernel_weights(beta);
+
+		for (int32_t i=0; i<mkl->get_num_support_vectors(); i++)
+		{
+			int32_t ii=mkl->get_support_vector(i);
+			for (int32_t j=0; j<mkl->get_num_support_vectors(); j++)
+			{
+				int32_t jj=mkl->get_support_vector(j);
+				sumw[n]+=0.5*mkl->get_alpha(i)*mkl->get_alpha(j)*
+					kernel->kernel(ii, jj);
+			}
+		}
+	}
+
+	kernel->set_subkernel_weights(old_beta);
+	return sumw;
+}
+
+static void check_sum_beta(bool normalize)
+{
+	const index_t num_vectors=40;
+	const index_t dim=3;
+
+	CMath::init_random(17);
+	SGMatrix<float64_t> data(dim, num_vectors);
+	SGVector<float64_t> lab(num_vectors);
+	for (index_t j=0; j<num_vectors; j++)
+	{
+		lab[j]=j%2 ? 1 : -1;
+		for (index_t i=0; i<dim; i++)
+			data(i, j)=CMath::randn_double()+lab[j];
+	}
+
+	CCombinedFeatures* features=new CCombinedFeatures();
+	SG_REF(features);
+	features->append_feature_obj(new CDenseFeatures<float64_t>(data));
+	features->append_feature_obj(new CDenseFeatures<float64_t>(data));
+
+	CCombinedKernel* kernel=new CCombinedKernel();
+	kernel->append_kernel(new CGaussianKernel(10, 0.5));
+	kernel->append_kernel(new CGaussianKernel(10, 4));
+	if (normalize)
+		kernel->set_normalizer(new CSqrtDiagKernelNormalizer());
+
+	CMKLClassification* mkl=new CMKLClassification(new CLibSVM());
+	mkl->set_interleaved_optimization_enabled(false);
+	mkl->set_solver_type(ST_DIRECT);
+	mkl->set_mkl_norm(2);
+	mkl->set_kernel(kernel);
+	mkl->set_labels(new CBinaryLabels(lab));
+	mkl->train(features);
+	ASSERT_GT(mkl->get_num_support_vectors(), 0);
+
+	/* the weights after training are not all one, so a normalizer on the
+	 * combined kernel does not cancel out */
+	SGVector<float64_t> beta=kernel->get_subkernel_weights().clone();
+	kernel->init(features, features);
+
+	SGVector<float64_t> expected=sum_beta_reference(mkl, kernel);
+	SGVector<float64_t> sumw(kernel->get_num_subkernels());
+	mkl->compute_sum_beta(sumw.vector);
+
+	for (index_t n=0; n<sumw.vlen; n++)
+		EXPECT_NEAR(sumw[n], expected[n], 1e-10);
+
+	SGVector<float64_t> restored=kernel->get_subkernel_weights();
+	for (index_t n=0; n<beta.vlen; n++)
+		EXPECT_EQ(restored[n], beta[n]);
+
+	SG_UNREF(mkl);
+	SG_UNREF(features);
+}
+
+TEST(MKLClassification, compute_sum_beta)
+{
+	check_sum_beta(false);
+}
+
+TEST(MKLClassification, compute_sum_beta_normalizer)
+{
+	check_sum_beta(true);
+}
@@ -0,0 +1,149 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: agent
+ */
+
+#include <gtest/gtest.h>
+#include <shogun/clustering/GMM.h>
+#include <shogun/features/DenseFeatures.h>
+#include <shogun/mathematics/Math.h>
+
+using namespace shogun;
+
+/* two well separated clusters with different covariances */
+static SGMatrix<float64_t> two_clusters(index_t num)
+{
+	SGMatrix<float64_t> data(2, num);
+	for (index_t i=0; i<num; i++)
+	{
+		if (i%4==0)
+		{
+			data(0, i)=10+0.5*CMath::randn_double();
+			data(1, i)=10+2*CMath::randn_double();
+		}
+		else
+		{
+			data(0, i)=CMath::randn_double();
+			data(1, i)=data(0, i)+0.5*CMath::randn_double();
+		}
+	}
+	return data;
+}
+
+TEST(GMM, train_em)
+{
+	SGMatrix<float64_t> data=two_clusters(4000);
+
+	ECovType cov_types[]={FULL, DIAG, SPHERICAL};
+	for (auto cov_type : cov_types)
+	{
+		auto features=some<CDenseFeatures<float64_t>>(data);
+		auto gmm=some<CGMM>(2, cov_type);
+		gmm->train(features);
+		float64_t log_likelihood=gmm->train_em(1e-9, 100, 1e-9);
+		EXPECT_TRUE(CMath::is_finite(log_likelihood));
+
+		/* the component of the smaller cluster */
+		index_t small=gmm->get_nth_mean(0)[0]>5 ? 0 : 1;
+		SGVector<float64_t> coefficients=gmm->get_coef();
+		EXPECT_NEAR(coefficients[small], 0.25, 0.01);
+		EXPECT_NEAR(gmm->get_nth_mean(small)[0], 10, 0.1);
+		EXPECT_NEAR(gmm->get_nth_mean(small)[1], 10, 0.3);
+		EXPECT_NEAR(gmm->get_nth_mean(1-small)[0], 0, 0.1);
+		EXPECT_NEAR(gmm->get_nth_mean(1-small)[1], 0, 0.1);
+
+		if (cov_type==FULL)
+		{
+			SGMatrix<float64_t> cov=gmm->get_nth_cov(1-small);
+			EXPECT_NEAR(cov(0, 0), 1, 0.1);
+			EXPECT_NEAR(cov(0, 1), 1, 0.1);
+			EXPECT_NEAR(cov(1, 1), 1.25, 0.15);
+		}
+		else if (cov_type==DIAG)
+		{
+			SGMatrix<float64_t> cov=gmm->get_nth_cov(small);
+			EXPECT_NEAR(cov(0, 0), 0.25, 0.05);
+			EXPECT_NEAR(cov(1, 1), 4, 0.5);
+		}
+
+		/* the log likelihood is the sum of the example log likelihoods */
+		float64_t sum=0;
+		for (index_t i=0; i<data.num_cols; i++)
+		{
+			SGVector<float64_t> point(data.get_column_vector(i), 2, false);
+			sum+=gmm->cluster(point)[2];
+		}
+		EXPECT_NEAR(log_likelihood, sum, 1e-3*CMath::abs(sum));
+	}
+}
+
+TEST(GMM, train_em_float32)
+{
+	SGMatrix<float64_t> data=two_clusters(2000);
+	SGMatrix<float32_t> data32(data.num_rows, data.num_cols);
+	for (index_t i=0; i<data.num_rows*data.num_cols; i++)
+		data32.matrix[i]=data.matrix[i];
+
+	/* both start from the same components */
+	SGVector<float64_t> coefficients(2);
+	coefficients.set_const(0.5);
+	std::vector<CGaussian*> components;
+	for (index_t k=0; k<2; k++)
+	{
+		SGVector<float64_t> mean(2);
+		mean.set_const(k*5);
+		SGMatrix<float64_t> cov(2, 2);
+		cov(0, 0)=1;
+		cov(1, 1)=1;
+		auto component=new CGaussian(mean, cov);
+		SG_REF(component);
+		components.push_back(component);
+	}
+
+	auto gmm=some<CGMM>(components, coefficients, true);
+	auto gmm32=some<CGMM>(components, coefficients, true);
+	for (auto component : components)
+		SG_UNREF(component);
+
+	gmm->train(new CDenseFeatures<float64_t>(data));
+	gmm32->train(new CDenseFeatures<float32_t>(data32));
+	float64_t log_likelihood=gmm->train_em(1e-9, 20, 0);
+	float64_t log_likelihood32=gmm32->train_em(1e-9, 20, 0);
+
+	EXPECT_NEAR(log_likelihood32, log_likelihood, 1e-4*CMath::abs(log_likelihood));
+	for (index_t k=0; k<2; k++)
+	{
+		EXPECT_NEAR(gmm32->get_coef()[k], gmm->get_coef()[k], 1e-4);
+		for (index_t i=0; i<2; i++)
+			EXPECT_NEAR(gmm32->get_nth_mean(k)[i], gmm->get_nth_mean(k)[i], 1e-3);
+	}
+}
+
+TEST(GMM, train_em_empty_initial_component)
+{
+	/* two distinct points for three components, the initial assignment
+	 * leaves at least one component without vectors */
+	SGMatrix<float64_t> data(2, 40);
+	for (index_t i=0; i<data.num_cols; i++)
+	{
+		data(0, i)=(i%2)*5;
+		data(1, i)=(i%2)*5;
+	}
+
+	auto gmm=some<CGMM>(3, FULL);
+	gmm->train(new CDenseFeatures<float64_t>(data));
+	float64_t log_likelihood=gmm->train_em(1e-3, 10, 0);
+	EXPECT_FALSE(std::isnan(log_likelihood));
+
+	float64_t sum_coefficients=0;
+	for (index_t k=0; k<3; k++)
+	{
+		SGVector<float64_t> mean=gmm->get_nth_mean(k);
+		ASSERT_EQ(mean.vlen, 2);
+		for (index_t i=0; i<2; i++)
+			EXPECT_FALSE(std::isnan(mean[i]));
+		sum_coefficients+=gmm->get_coef()[k];
+	}
+	EXPECT_NEAR(sum_coefficients, 1, 1e-12);
+}
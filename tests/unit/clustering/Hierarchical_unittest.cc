@@ -0,0 +1,167 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: agent
+ */
+
+#include <gtest/gtest.h>
+#include <shogun/clustering/Hierarchical.h>
+#include <shogun/distance/EuclideanDistance.h>
+#include <shogun/distance/MinkowskiMetric.h>
+#include <shogun/features/DenseFeatures.h>
+#include <shogun/mathematics/Math.h>
+
+#include <vector>
+
+using namespace shogun;
+
+/* merge distances of merging the clusters with minimum linkage, computed
+ * from all their elements */
+static std::vector<float64_t> brute_force_merges(SGMatrix<float64_t> data,
+		ELinkage linkage, int32_t num_merges)
+{
+	const index_t num=data.num_cols;
+	std::vector<std::vector<index_t>> clusters(num);
+	for (index_t i=0; i<num; i++)
+		clusters[i].push_back(i);
+
+	auto dist=[&data](index_t i, index_t j)
+	{
+		float64_t sum=0;
+		for (index_t k=0; k<data.num_rows; k++)
+			sum+=CMath::sq(data(k, i)-data(k, j));
+		return CMath::sqrt(sum);
+	};
+
+	auto link=[&](const std::vector<index_t>& a, const std::vector<index_t>& b)
+	{
+		if (linkage==LINKAGE_WARD)
+		{
+			float64_t sum=0;
+			for (index_t k=0; k<data.num_rows; k++)
+			{
+				float64_t diff=0;
+				for (auto i : a)
+					diff+=data(k, i)/a.size();
+				for (auto j : b)
+					diff-=data(k, j)/b.size();
+				sum+=diff*diff;
+			}
+			return CMath::sqrt(2.0*a.size()*b.size()/(a.size()+b.size())*sum);
+		}
+
+		float64_t result=linkage==LINKAGE_SINGLE ? CMath::INFTY : 0;
+		for (auto i : a)
+		{
+			for (auto j : b)
+			{
+				if (linkage==LINKAGE_SINGLE)
+					result=CMath::min(result, dist(i, j));
+				else if (linkage==LINKAGE_COMPLETE)
+					result=CMath::max(result, dist(i, j));
+				else
+					result+=dist(i, j)/(a.size()*b.size());
+			}
+		}
+		return result;
+	};
+
+	std::vector<float64_t> merges;
+	for (int32_t l=0; l<num_merges; l++)
+	{
+		index_t best_a=0;
+		index_t best_b=1;
+		float64_t best=CMath::INFTY;
+		for (index_t a=0; a<index_t(clusters.size()); a++)
+		{
+			for (index_t b=a+1; b<index_t(clusters.size()); b++)
+			{
+				float64_t d=link(clusters[a], clusters[b]);
+				if (d<best)
+				{
+					best=d;
+					best_a=a;
+					best_b=b;
+				}
+			}
+		}
+		merges.push_back(best);
+		clusters[best_a].insert(clusters[best_a].end(),
+				clusters[best_b].begin(), clusters[best_b].end());
+		clusters.erase(clusters.begin()+best_b);
+	}
+	return merges;
+}
+
+TEST(Hierarchical, linkages)
+{
+	/* with these numbers, the getters return all merges */
+	const index_t num=41;
+	const int32_t merges=21;
+
+	SGMatrix<float64_t> data(2, num);
+	for (index_t i=0; i<num; i++)
+	{
+		data(0, i)=CMath::randn_double();
+		data(1, i)=CMath::randn_double();
+	}
+
+	auto features=some<CDenseFeatures<float64_t>>(data);
+	ELinkage linkages[]={LINKAGE_SINGLE, LINKAGE_COMPLETE, LINKAGE_AVERAGE, LINKAGE_WARD};
+	for (auto linkage : linkages)
+	{
+		auto expected=brute_force_merges(data, linkage, merges);
+
+		/* Ward linkage merges centroids for Euclidean distance, and
+		 * updates the distances between clusters otherwise */
+		CDistance* distances[]={new CEuclideanDistance(features, features),
+			new CMinkowskiMetric(features, features, 2)};
+		for (auto distance : distances)
+		{
+			auto clustering=some<CHierarchical>(merges, distance);
+			clustering->set_linkage(linkage);
+			clustering->train();
+
+			SGVector<float64_t> merge_distances=clustering->get_merge_distances();
+			SGMatrix<int32_t> pairs=clustering->get_cluster_pairs();
+			for (int32_t l=0; l<merges; l++)
+			{
+				EXPECT_NEAR(merge_distances[l], expected[l], 1e-10);
+				EXPECT_LT(pairs(0, l), pairs(1, l));
+				EXPECT_LT(pairs(1, l), num+l);
+			}
+		}
+	}
+}
+
+TEST(Hierarchical, single_linkage_assignment)
+{
+	/* two groups of points on a line */
+	SGMatrix<float64_t> data(1, 6);
+	float64_t positions[]={0, 1, 2.5, 10, 11.25, 12};
+	for (index_t i=0; i<6; i++)
+		data(0, i)=positions[i];
+
+	auto features=some<CDenseFeatures<float64_t>>(data);
+	auto distance=new CEuclideanDistance(features, features);
+	auto clustering=some<CHierarchical>(3, distance);
+	clustering->train();
+
+	/* four merges leave two clusters, the ids of merged clusters follow
+	 * the ids of the points */
+	SGMatrix<int32_t> pairs=clustering->get_cluster_pairs();
+	SGVector<float64_t> merge_distances=clustering->get_merge_distances();
+	int32_t expected_pairs[]={4, 5, 0, 1, 3, 6};
+	float64_t expected_distances[]={0.75, 1, 1.25};
+	for (index_t l=0; l<3; l++)
+	{
+		EXPECT_EQ(pairs(0, l), expected_pairs[2*l]);
+		EXPECT_EQ(pairs(1, l), expected_pairs[2*l+1]);
+		EXPECT_EQ(merge_distances[l], expected_distances[l]);
+	}
+
+	/* the first group is the last merge */
+	SGVector<int32_t> assignment=clustering->get_assignment();
+	for (index_t i=0; i<assignment.vlen; i++)
+		EXPECT_EQ(assignment[i], 9);
+}
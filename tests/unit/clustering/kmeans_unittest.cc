@@ -10,6 +10,7 @@
 #include <shogun/clustering/KMeansMiniBatch.h>
 #include <shogun/distance/EuclideanDistance.h>
 #include <shogun/features/DenseFeatures.h>
+#include <shogun/features/streaming/StreamingDenseFeatures.h>
 #include <shogun/labels/MulticlassLabels.h>
 #include <shogun/lib/observers/ParameterObserver.h>
 #include <shogun/lib/observers/ParameterObserverLogger.h>
@@ -178,6 +179,45 @@ TEST(KMeans, minibatch_training_test)
 	}
 }
 
+TEST(KMeans, minibatch_streaming_training_test)
+{
+	/* the rectangle (0,0) (0,1000) (2,0) (2,1000), repeated */
+	index_t num_repeats=250;
+	SGMatrix<float64_t> rect(2, 4*num_repeats);
+	for (index_t i=0; i<num_repeats; ++i)
+	{
+		rect(0,4*i)=0;
+		rect(1,4*i)=0;
+		rect(0,4*i+1)=0;
+		rect(1,4*i+1)=1000;
+		rect(0,4*i+2)=2;
+		rect(1,4*i+2)=0;
+		rect(0,4*i+3)=2;
+		rect(1,4*i+3)=1000;
+	}
+
+	SGMatrix<float64_t> initial_centers(2,1);
+	initial_centers(0,0)=0;
+	initial_centers(1,0)=0;
+
+	auto features=some<CDenseFeatures<float64_t>>(rect);
+	auto stream=some<CStreamingDenseFeatures<float64_t>>(features.get());
+	auto distance=some<CEuclideanDistance>();
+	auto clustering=some<CKMeansMiniBatch>(1, distance, initial_centers);
+
+	/* the stream ends before max_iter batches are consumed, and with a
+	 * single center every example moves it towards the running mean */
+	clustering->put<int32_t>("max_iter", 1000);
+	clustering->put<int32_t>("batch_size", 64);
+	clustering->train(stream);
+
+	auto learnt_centers=wrap(distance->get_lhs()->as<CDenseFeatures<float64_t>>());
+	SGMatrix<float64_t> learnt_centers_matrix=learnt_centers->get_feature_matrix();
+
+	EXPECT_NEAR(1, learnt_centers_matrix(0,0), 1e-8);
+	EXPECT_NEAR(500, learnt_centers_matrix(1,0), 1e-8);
+}
+
 TEST(KMeans, fixed_centers)
 {
 	/*create a rectangle with four points as (0,0) (0,10) (20,0) (20,10)*/
@@ -144,6 +144,62 @@ TEST(DISABLED_IsomapTest,neighbors_preserving)
 	SG_UNREF(low_dimensional_dist);
 }
 
+TEST(IsomapTest,nn_descent_shared_neighbors)
+{
+	const index_t n_samples = 500;
+	const index_t n_dimensions = 5;
+	const index_t n_neighbors = 10;
+
+	/* noisy helix, the neighbors graph of unstructured data is usually not
+	 * connected and Isomap cannot embed it */
+	SGMatrix<float64_t> matrix(n_dimensions, n_samples);
+	for (index_t i=0; i<n_samples; ++i)
+	{
+		float64_t t = 4*M_PI*(i+CMath::random(0.0, 0.5))/n_samples;
+		matrix(0,i) = std::cos(t);
+		matrix(1,i) = std::sin(t);
+		matrix(2,i) = t;
+		for (index_t j=3; j<n_dimensions; ++j)
+			matrix(j,i) = 0.001*CMath::randn_double();
+	}
+	CDenseFeatures<float64_t>* features = new CDenseFeatures<float64_t>(matrix);
+	SG_REF(features);
+	CDistance* distance = new CEuclideanDistance(features, features);
+
+	CIsomap* approximate = new CIsomap();
+	approximate->set_k(n_neighbors);
+	approximate->set_neighbors_method(NEIGHBORS_NN_DESCENT);
+	CFeatures* embedding = approximate->transform(features);
+	SG_UNREF(embedding);
+
+	SGMatrix<index_t> neighbors = approximate->get_neighbors();
+	ASSERT_EQ(n_neighbors, neighbors.num_rows);
+	ASSERT_EQ(n_samples, neighbors.num_cols);
+
+	index_t n_found = 0;
+	for (index_t i=0; i<n_samples; ++i)
+	{
+		std::set<index_t> exact = get_neighbors_indices(distance, i, n_neighbors);
+		for (index_t j=0; j<n_neighbors; ++j)
+			n_found += exact.count(neighbors(j,i));
+	}
+	EXPECT_GE(n_found, 0.95*n_samples*n_neighbors);
+
+	/* the graph is reused as is by another converter */
+	CIsomap* shared = new CIsomap();
+	shared->set_k(n_neighbors);
+	shared->set_neighbors(neighbors);
+	embedding = shared->transform(features);
+	SG_UNREF(embedding);
+	SGMatrix<index_t> shared_neighbors = shared->get_neighbors();
+	EXPECT_TRUE(shared_neighbors.equals(neighbors));
+
+	SG_UNREF(shared);
+	SG_UNREF(approximate);
+	SG_UNREF(distance);
+	SG_UNREF(features);
+}
+
 std::set<index_t> get_neighbors_indices(CDistance* distance_object, index_t feature_vector_index, index_t n_neighbors)
 {
 	index_t n_vectors = distance_object->get_num_vec_lhs();
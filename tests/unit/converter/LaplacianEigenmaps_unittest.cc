@@ -0,0 +1,72 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: agent
+ */
+#include <gtest/gtest.h>
+#include <cmath>
+
+#include <shogun/converter/LaplacianEigenmaps.h>
+#include <shogun/features/DenseFeatures.h>
+#include <shogun/mathematics/Math.h>
+#include <shogun/lib/SGMatrix.h>
+
+using namespace shogun;
+
+#ifdef HAVE_LAPACK
+/* noisy samples along a spiral, a single connected manifold */
+static SGMatrix<float64_t> generate_spiral(index_t n_samples)
+{
+	SGMatrix<float64_t> data(3, n_samples);
+	for (index_t j=0; j<n_samples; j++)
+	{
+		float64_t t = 3.0*CMath::PI*j/n_samples;
+		data(0,j) = t*std::cos(t)+0.01*CMath::randn_double();
+		data(1,j) = t*std::sin(t)+0.01*CMath::randn_double();
+		data(2,j) = 0.1*t+0.01*CMath::randn_double();
+	}
+	return data;
+}
+
+static SGMatrix<float64_t> embed(CFeatures* features, EEmbeddingEigenMethod method)
+{
+	CLaplacianEigenmaps* converter = new CLaplacianEigenmaps();
+	converter->set_target_dim(2);
+	converter->set_k(6);
+	converter->set_tau(2.0);
+	converter->set_eigen_method(method);
+	CDenseFeatures<float64_t>* embedding =
+		converter->transform(features, false)->as<CDenseFeatures<float64_t>>();
+	SGMatrix<float64_t> result = embedding->get_feature_matrix();
+	SG_UNREF(embedding);
+	SG_UNREF(converter);
+	return result;
+}
+
+TEST(LaplacianEigenmapsTest,randomized_matches_dense)
+{
+	const index_t n_samples = 60;
+	CDenseFeatures<float64_t>* features =
+		new CDenseFeatures<float64_t>(generate_spiral(n_samples));
+	SG_REF(features);
+
+	SGMatrix<float64_t> dense_matrix = embed(features, EMBEDDING_EIGEN_DENSE);
+	SGMatrix<float64_t> randomized_matrix = embed(features, EMBEDDING_EIGEN_RANDOMIZED);
+	ASSERT_EQ(dense_matrix.num_rows, randomized_matrix.num_rows);
+	ASSERT_EQ(dense_matrix.num_cols, randomized_matrix.num_cols);
+
+	// generalized eigenvectors agree up to sign (the randomized solver works
+	// on a slightly shifted Laplacian, hence the looser tolerance)
+	for (index_t i=0; i<dense_matrix.num_rows; i++)
+	{
+		float64_t dot = 0;
+		for (index_t j=0; j<dense_matrix.num_cols; j++)
+			dot += dense_matrix(i,j)*randomized_matrix(i,j);
+		float64_t sign = dot < 0 ? -1 : 1;
+		for (index_t j=0; j<dense_matrix.num_cols; j++)
+			EXPECT_NEAR(dense_matrix(i,j), sign*randomized_matrix(i,j), 1e-4);
+	}
+
+	SG_UNREF(features);
+}
+#endif // HAVE_LAPACK
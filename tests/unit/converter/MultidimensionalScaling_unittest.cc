@@ -49,5 +49,49 @@ TEST(MultidimensionaScalingTest,distance_preserving)
 	SG_UNREF(euclidean_distance);
 	SG_UNREF(euclidean_distance_for_embedding);
 }
+
+TEST(MultidimensionaScalingTest,randomized_matches_dense)
+{
+	const index_t n_samples = 20;
+	const index_t n_gaussians = 3;
+	const index_t n_dimensions = 5;
+	const index_t target_dim = 2;
+	CDenseFeatures<float64_t>* features =
+		new CDenseFeatures<float64_t>(CDataGenerator::generate_gaussians(n_samples, n_gaussians, n_dimensions));
+	CDistance* distance = new CEuclideanDistance(features, features);
+	SG_REF(distance);
+
+	CMultidimensionalScaling* dense_mds = new CMultidimensionalScaling();
+	dense_mds->set_target_dim(target_dim);
+	dense_mds->set_eigen_method(EMBEDDING_EIGEN_DENSE);
+	CDenseFeatures<float64_t>* dense_embedding = dense_mds->embed_distance(distance);
+
+	CMultidimensionalScaling* randomized_mds = new CMultidimensionalScaling();
+	randomized_mds->set_target_dim(target_dim);
+	randomized_mds->set_eigen_method(EMBEDDING_EIGEN_RANDOMIZED);
+	CDenseFeatures<float64_t>* randomized_embedding = randomized_mds->embed_distance(distance);
+
+	SGMatrix<float64_t> dense_matrix = dense_embedding->get_feature_matrix();
+	SGMatrix<float64_t> randomized_matrix = randomized_embedding->get_feature_matrix();
+	ASSERT_EQ(dense_matrix.num_rows, randomized_matrix.num_rows);
+	ASSERT_EQ(dense_matrix.num_cols, randomized_matrix.num_cols);
+
+	// coordinates agree up to the sign of each eigenvector
+	for (index_t i=0; i<dense_matrix.num_rows; i++)
+	{
+		float64_t dot = 0;
+		for (index_t j=0; j<dense_matrix.num_cols; j++)
+			dot += dense_matrix(i,j)*randomized_matrix(i,j);
+		float64_t sign = dot < 0 ? -1 : 1;
+		for (index_t j=0; j<dense_matrix.num_cols; j++)
+			EXPECT_NEAR(dense_matrix(i,j), sign*randomized_matrix(i,j), 1e-6);
+	}
+
+	SG_UNREF(dense_embedding);
+	SG_UNREF(randomized_embedding);
+	SG_UNREF(dense_mds);
+	SG_UNREF(randomized_mds);
+	SG_UNREF(distance);
+}
 #endif // HAVE_LAPACK
 
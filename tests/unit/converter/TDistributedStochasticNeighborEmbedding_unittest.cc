@@ -7,6 +7,9 @@
 #include <shogun/converter/TDistributedStochasticNeighborEmbedding.h>
 #include <shogun/features/DenseFeatures.h>
 #include <shogun/features/DataGenerator.h>
+#include <shogun/mathematics/Math.h>
+#include <shogun/lib/tapkee/defines.hpp>
+#include <shogun/lib/tapkee/external/barnes_hut_sne/interpolation.hpp>
 
 using namespace shogun;
 
@@ -44,3 +47,37 @@ TEST(TDistributedStochasticNeighborEmbeddingTest,basic)
 }
 #endif // HAVE_LAPACK
 
+
+/* Repulsive forces by interpolation against the exact sums */
+TEST(TDistributedStochasticNeighborEmbeddingTest,interpolation_repulsive_forces)
+{
+	const index_t n_samples = 500;
+	SGMatrix<float64_t> Y(2, n_samples);
+	for (index_t i = 0; i < 2 * n_samples; i++)
+		Y.matrix[i] = CMath::normal_random(0.0, 1.0);
+
+	SGVector<float64_t> neg_f(2 * n_samples);
+	float64_t sum_Q;
+	tsne::InterpolationGrid grid;
+	grid.computeRepulsiveForces(Y.matrix, n_samples, neg_f.vector, &sum_Q);
+
+	float64_t exact_sum_Q = 0;
+	for (index_t i = 0; i < n_samples; i++)
+	{
+		float64_t exact_f[2] = {0, 0};
+		for (index_t j = 0; j < n_samples; j++)
+		{
+			if (i == j)
+				continue;
+			float64_t dx = Y(0, i) - Y(0, j);
+			float64_t dy = Y(1, i) - Y(1, j);
+			float64_t q = 1.0 / (1.0 + dx * dx + dy * dy);
+			exact_sum_Q += q;
+			exact_f[0] += q * q * dx;
+			exact_f[1] += q * q * dy;
+		}
+		EXPECT_NEAR(exact_f[0], neg_f[2 * i], 1e-2);
+		EXPECT_NEAR(exact_f[1], neg_f[2 * i + 1], 1e-2);
+	}
+	EXPECT_NEAR(exact_sum_Q, sum_Q, exact_sum_Q * 1e-4);
+}
@@ -6,9 +6,17 @@
 
 #include <gtest/gtest.h>
 
+#include <shogun/distance/BrayCurtisDistance.h>
+#include <shogun/distance/CanberraMetric.h>
+#include <shogun/distance/ChebyshewMetric.h>
+#include <shogun/distance/ChiSquareDistance.h>
+#include <shogun/distance/CosineDistance.h>
 #include <shogun/distance/CustomMahalanobisDistance.h>
+#include <shogun/distance/EuclideanDistance.h>
+#include <shogun/distance/ManhattanMetric.h>
 #include <shogun/features/DenseFeatures.h>
 #include <shogun/lib/SGMatrix.h>
+#include <shogun/mathematics/Math.h>
 
 using namespace shogun;
 
@@ -37,3 +45,63 @@ TEST(Distance, custom_mahalanobis)
 
 	SG_UNREF(distance)
 }
+
+template <class D>
+static void check_batch(CDenseFeatures<float64_t>* lhs, CDenseFeatures<float64_t>* rhs)
+{
+	auto distance=some<D>(lhs, rhs);
+	const index_t num_lhs=lhs->get_num_vectors();
+	const index_t num_rhs=rhs->get_num_vectors();
+
+	SGVector<float64_t> result(num_lhs);
+	distance->distances_lhs(result.vector, 0, num_lhs, 1);
+	for (index_t i=0; i<num_lhs; i++)
+		EXPECT_NEAR(result[i], distance->distance(i, 1), 1e-12) << distance->get_name();
+
+	distance->distances_rhs(result.vector, 1, num_rhs, 2);
+	for (index_t j=1; j<num_rhs; j++)
+		EXPECT_NEAR(result[j-1], distance->distance(2, j), 1e-12) << distance->get_name();
+
+	auto block=distance->get_distance_block(1, num_lhs, 2, num_rhs);
+	EXPECT_EQ(block.num_rows, num_lhs-1);
+	EXPECT_EQ(block.num_cols, num_rhs-2);
+	for (index_t j=0; j<block.num_cols; j++)
+	{
+		for (index_t i=0; i<block.num_rows; i++)
+			EXPECT_NEAR(block(i, j), distance->distance(i+1, j+2), 1e-12) << distance->get_name();
+	}
+
+	/* symmetric matrices compute half of the pairs */
+	distance->init(lhs, lhs);
+	auto matrix=distance->get_distance_matrix();
+	for (index_t j=0; j<num_lhs; j++)
+	{
+		for (index_t i=0; i<num_lhs; i++)
+			EXPECT_NEAR(matrix(i, j), distance->distance(i, j), 1e-12) << distance->get_name();
+	}
+}
+
+TEST(Distance, batch_kernels)
+{
+	const index_t dim=13;
+	SGMatrix<float64_t> lhs_mat(dim, 20);
+	SGMatrix<float64_t> rhs_mat(dim, 7);
+	for (index_t i=0; i<lhs_mat.size(); i++)
+		lhs_mat[i]=CMath::randn_double();
+	for (index_t i=0; i<rhs_mat.size(); i++)
+		rhs_mat[i]=CMath::randn_double();
+	/* zeros, where some kernels skip dimensions */
+	lhs_mat(3, 1)=0;
+	rhs_mat(3, 1)=0;
+
+	auto lhs=some<CDenseFeatures<float64_t>>(lhs_mat);
+	auto rhs=some<CDenseFeatures<float64_t>>(rhs_mat);
+
+	check_batch<CEuclideanDistance>(lhs, rhs);
+	check_batch<CManhattanMetric>(lhs, rhs);
+	check_batch<CChebyshewMetric>(lhs, rhs);
+	check_batch<CCosineDistance>(lhs, rhs);
+	check_batch<CChiSquareDistance>(lhs, rhs);
+	check_batch<CBrayCurtisDistance>(lhs, rhs);
+	check_batch<CCanberraMetric>(lhs, rhs);
+}
@@ -0,0 +1,65 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: agent
+ */
+
+#include <shogun/labels/BinaryLabels.h>
+#include <shogun/evaluation/PRCEvaluation.h>
+#include <shogun/mathematics/Math.h>
+#include <gtest/gtest.h>
+
+using namespace shogun;
+
+TEST(PRCEvaluation,sorted_and_histogram)
+{
+	index_t num_labels=1000;
+	auto predicted=some<CBinaryLabels>(num_labels);
+	auto gt=some<CBinaryLabels>(num_labels);
+	for (index_t i=0; i<num_labels; i++)
+	{
+		float64_t l=CMath::random(0, 2)==0 ? 1 : -1;
+		gt->set_value(l, i);
+		gt->set_label(i, l);
+		predicted->set_value(CMath::randn_double()+l, i);
+	}
+
+	auto prc=some<CPRCEvaluation>();
+	float64_t auc=prc->evaluate(predicted, gt);
+
+	/* precision and recall after every example, by decreasing score */
+	auto graph=prc->get_PRC();
+	auto thresholds=prc->get_thresholds();
+	ASSERT_EQ(graph.num_cols, num_labels);
+	EXPECT_EQ(graph(1, num_labels-1), 1);
+	for (index_t i=1; i<num_labels; i++)
+	{
+		EXPECT_LE(thresholds[i], thresholds[i-1]);
+		EXPECT_GE(graph(1, i), graph(1, i-1));
+	}
+	EXPECT_NEAR(CMath::area_under_curve(graph.matrix, num_labels, true), auc, 1e-12);
+
+	prc->set_compute_curve(false);
+	EXPECT_EQ(prc->evaluate(predicted, gt), auc);
+
+	/* fine bins, a single batch or several */
+	prc->set_method(AUC_HISTOGRAM);
+	float64_t approx_auc=prc->evaluate(predicted, gt);
+	EXPECT_NEAR(approx_auc, auc, 1e-2);
+
+	index_t batch_size=num_labels/2;
+	for (index_t b=0; b<2; b++)
+	{
+		auto batch_predicted=some<CBinaryLabels>(batch_size);
+		auto batch_gt=some<CBinaryLabels>(batch_size);
+		for (index_t i=0; i<batch_size; i++)
+		{
+			float64_t l=gt->get_label(b*batch_size+i);
+			batch_gt->set_value(l, i);
+			batch_gt->set_label(i, l);
+			batch_predicted->set_value(predicted->get_value(b*batch_size+i), i);
+		}
+		prc->add_batch(batch_predicted, batch_gt);
+	}
+	EXPECT_NEAR(prc->evaluate_batches(), auc, 1e-2);
+}
@@ -6,6 +6,7 @@
 
 #include <shogun/labels/BinaryLabels.h>
 #include <shogun/evaluation/ROCEvaluation.h>
+#include <shogun/mathematics/Math.h>
 #include <gtest/gtest.h>
 
 using namespace shogun;
@@ -29,3 +30,128 @@ TEST(ROCEvaluation,one)
 	SG_UNREF(roc);
 	SG_UNREF(gt);
 }
+
+/* noisy scores, rounded to get ties */
+static void generate_scores(index_t num_labels, CBinaryLabels* predicted,
+		CBinaryLabels* ground_truth, float64_t resolution)
+{
+	for (index_t i=0; i<num_labels; i++)
+	{
+		float64_t l=CMath::random(0, 2)==0 ? 1 : -1;
+		float64_t score=CMath::randn_double()+l;
+		if (resolution>0)
+			score=CMath::round(score/resolution)*resolution;
+
+		ground_truth->set_value(l, i);
+		ground_truth->set_label(i, l);
+		predicted->set_value(score, i);
+	}
+}
+
+/* fraction of correctly ordered pairs, ties count half */
+static float64_t pairwise_auc(CBinaryLabels* predicted, CBinaryLabels* ground_truth)
+{
+	float64_t correct=0;
+	int64_t num_pairs=0;
+	for (index_t i=0; i<predicted->get_num_labels(); i++)
+	{
+		for (index_t j=0; j<predicted->get_num_labels(); j++)
+		{
+			if (ground_truth->get_label(i)>0 && ground_truth->get_label(j)<0)
+			{
+				float64_t diff=predicted->get_value(i)-predicted->get_value(j);
+				correct+=diff>0 ? 1 : (diff==0 ? 0.5 : 0);
+				num_pairs++;
+			}
+		}
+	}
+
+	return correct/num_pairs;
+}
+
+TEST(ROCEvaluation,sorted_ties)
+{
+	index_t num_labels=500;
+	auto predicted=some<CBinaryLabels>(num_labels);
+	auto gt=some<CBinaryLabels>(num_labels);
+	generate_scores(num_labels, predicted, gt, 0.25);
+
+	auto roc=some<CROCEvaluation>();
+	float64_t auc=roc->evaluate(predicted, gt);
+	EXPECT_NEAR(auc, pairwise_auc(predicted, gt), 1e-12);
+	EXPECT_EQ(roc->get_auROC_error_bound(), 0);
+
+	/* a point per distinct score, thresholds decrease along the curve */
+	auto graph=roc->get_ROC();
+	auto thresholds=roc->get_thresholds();
+	EXPECT_EQ(thresholds.vlen, num_labels);
+	EXPECT_EQ(graph(0, 0), 0);
+	EXPECT_EQ(graph(1, 0), 0);
+	EXPECT_EQ(graph(0, graph.num_cols-1), 1);
+	EXPECT_EQ(graph(1, graph.num_cols-1), 1);
+	for (index_t i=1; i<num_labels; i++)
+		EXPECT_LE(thresholds[i], thresholds[i-1]);
+
+	EXPECT_NEAR(CMath::area_under_curve(graph.matrix, graph.num_cols, false),
+			auc, 1e-12);
+
+	roc->set_compute_curve(false);
+	EXPECT_EQ(roc->evaluate(predicted, gt), auc);
+}
+
+TEST(ROCEvaluation,histogram)
+{
+	index_t num_labels=2000;
+	auto predicted=some<CBinaryLabels>(num_labels);
+	auto gt=some<CBinaryLabels>(num_labels);
+	generate_scores(num_labels, predicted, gt, 0);
+
+	auto roc=some<CROCEvaluation>();
+	float64_t auc=roc->evaluate(predicted, gt);
+
+	roc->set_method(AUC_HISTOGRAM);
+	roc->set_num_bins(32);
+	float64_t approx_auc=roc->evaluate(predicted, gt);
+	float64_t error_bound=roc->get_auROC_error_bound();
+	EXPECT_GT(error_bound, 0);
+	EXPECT_LE(CMath::abs(approx_auc-auc), error_bound);
+	EXPECT_LE(roc->get_thresholds().vlen, 32);
+}
+
+TEST(ROCEvaluation,batches)
+{
+	index_t num_labels=1000;
+	index_t num_batches=4;
+	auto predicted=some<CBinaryLabels>(num_labels);
+	auto gt=some<CBinaryLabels>(num_labels);
+	generate_scores(num_labels, predicted, gt, 0);
+
+	auto roc=some<CROCEvaluation>();
+	float64_t auc=roc->evaluate(predicted, gt);
+
+	/* later batches fall outside the range of the first one */
+	roc->set_num_bins(256);
+	index_t batch_size=num_labels/num_batches;
+	for (index_t b=0; b<num_batches; b++)
+	{
+		auto batch_predicted=some<CBinaryLabels>(batch_size);
+		auto batch_gt=some<CBinaryLabels>(batch_size);
+		for (index_t i=0; i<batch_size; i++)
+		{
+			float64_t l=gt->get_label(b*batch_size+i);
+			batch_gt->set_value(l, i);
+			batch_gt->set_label(i, l);
+			batch_predicted->set_value(predicted->get_value(b*batch_size+i)*(b+1), i);
+			predicted->set_value(batch_predicted->get_value(i), b*batch_size+i);
+		}
+		roc->add_batch(batch_predicted, batch_gt);
+	}
+
+	float64_t approx_auc=roc->evaluate_batches();
+	float64_t error_bound=roc->get_auROC_error_bound();
+	auc=roc->evaluate(predicted, gt);
+	EXPECT_LE(CMath::abs(approx_auc-auc), error_bound);
+
+	roc->reset_batches();
+	EXPECT_THROW(roc->evaluate_batches(), ShogunException);
+}
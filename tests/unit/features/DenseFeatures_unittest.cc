@@ -11,6 +11,7 @@
 #include <shogun/base/some.h>
 #include <shogun/features/DenseFeatures.h>
 #include <shogun/lib/View.h>
+#include <shogun/mathematics/linalg/LinalgNamespace.h>
 
 namespace shogun
 {
@@ -288,3 +289,40 @@ TEST(DenseFeaturesTest, view)
 			    feature_matrix_subset2(i, j), data(i, subset1[subset2[j]]));
 	}
 }
+
+TEST(DenseFeaturesTest, feature_vector_view)
+{
+	const index_t num_feats = 3;
+	const index_t num_vectors = 5;
+	SGMatrix<float64_t> data(num_feats, num_vectors);
+	std::iota(data.data(), data.data() + data.size(), 1);
+
+	auto feats = some<CDenseFeatures<float64_t>>(data);
+	ASSERT_TRUE(feats->can_view_feature_vectors());
+
+	SGVector<index_t> subset{4, 1};
+	feats->add_subset(subset);
+	for (auto j : range(subset.vlen))
+	{
+		auto view = feats->get_feature_vector_view(j);
+		ASSERT_EQ(view.size(), num_feats);
+		EXPECT_EQ(view.data(), data.get_column_vector(subset[j]));
+	}
+
+	SGVector<float64_t> w{1, -1, 2};
+	for (auto j : range(subset.vlen))
+	{
+		EXPECT_EQ(
+		    feats->dense_dot_view(j, w),
+		    feats->dense_dot(j, w.vector, w.vlen));
+		EXPECT_EQ(
+		    feats->dot(j, feats.get(), 1 - j),
+		    linalg::dot(
+		        feats->get_feature_vector(j),
+		        feats->get_feature_vector(1 - j)));
+	}
+	feats->remove_subset();
+
+	EXPECT_THROW(feats->get_feature_vector_view(num_vectors), ShogunException);
+	EXPECT_FALSE(some<CDenseFeatures<float64_t>>()->can_view_feature_vectors());
+}
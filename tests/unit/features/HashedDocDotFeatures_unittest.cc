@@ -305,3 +305,69 @@ TEST(HashedDocDotFeaturesTest, quadratic_add_to_dense)
 	SG_UNREF(hddf);
 	SG_FREE(hashes);
 }
+
+TEST(HashedDocDotFeaturesTest, index_cache)
+{
+	const char* docs[] = {"You're never too old to rock and roll, if you're too young to die",
+		"Give me some rope, tie me to dream, give me the hope to run out of steam",
+		"Thank you Jack Daniels, Old Number Seven, Tennessee Whiskey got me drinking in heaven",
+		"to"};
+
+	SGStringList<char> list(4, 85);
+	for (index_t i=0; i<4; i++)
+	{
+		index_t len = strlen(docs[i]);
+		list.strings[i] = SGString<char>(len);
+		for (index_t j=0; j<len; j++)
+			list.strings[i].string[j] = docs[i][j];
+	}
+
+	int32_t dimension = 64;
+	int32_t hash_bits = 6;
+
+	CDelimiterTokenizer* tokenizer = new CDelimiterTokenizer();
+	tokenizer->delimiters[' '] = 1;
+	tokenizer->delimiters['\''] = 1;
+	tokenizer->delimiters[','] = 1;
+
+	auto doc_collection = new CStringFeatures<char>(list, RAWBYTE);
+	auto hddf = some<CHashedDocDotFeatures>(hash_bits, doc_collection,
+			tokenizer, true, 2, 1);
+	auto cached = some<CHashedDocDotFeatures>(*hddf);
+	cached->build_index_cache();
+	EXPECT_TRUE(cached->has_index_cache());
+	EXPECT_FALSE(hddf->has_index_cache());
+
+	SGVector<float64_t> vec(dimension);
+	for (index_t i=0; i<dimension; i++)
+		vec[i] = CMath::random(-dimension, dimension);
+
+	SGVector<float64_t> output(4);
+	SGVector<float64_t> alphas(4);
+	alphas.range_fill();
+	cached->dense_dot_range(output.vector, 0, 4, alphas.vector, vec.vector, dimension, 1);
+
+	for (index_t i=0; i<4; i++)
+	{
+		float64_t expected = hddf->dense_dot(i, vec.vector, dimension);
+		EXPECT_NEAR(cached->dense_dot(i, vec.vector, dimension), expected, 1E-12);
+		EXPECT_NEAR(output[i], i*expected+1, 1E-12);
+
+		SGVector<float64_t> added(dimension);
+		SGVector<float64_t> added_cached(dimension);
+		added.zero();
+		added_cached.zero();
+		hddf->add_to_dense_vec(-2, i, added.vector, dimension);
+		cached->add_to_dense_vec(-2, i, added_cached.vector, dimension);
+		for (index_t j=0; j<dimension; j++)
+			EXPECT_NEAR(added_cached[j], added[j], 1E-12);
+
+		for (index_t j=0; j<4; j++)
+			EXPECT_NEAR(cached->dot(i, cached, j), hddf->dot(i, hddf, j), 1E-12);
+	}
+
+	cached->free_index_cache();
+	EXPECT_FALSE(cached->has_index_cache());
+	EXPECT_EQ(cached->dense_dot(0, vec.vector, dimension),
+		hddf->dense_dot(0, vec.vector, dimension));
+}
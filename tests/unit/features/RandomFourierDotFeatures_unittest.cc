@@ -176,3 +176,79 @@ TEST(RandomFourierDotFeatures, add_to_dense_test)
 	SG_UNREF(r_feats);
 }
 
+
+TEST(RandomFourierDotFeatures, fastfood_gaussian_kernel)
+{
+	int32_t num_dims = 5;
+	int32_t vecs = 6;
+	int32_t D = 4096;
+	float64_t width = 2;
+
+	SGMatrix<float64_t> data(num_dims, vecs);
+	for (index_t i=0; i<vecs; i++)
+	{
+		for (index_t j=0; j<num_dims; j++)
+			data(j,i) = 0.6*CMath::randn_double();
+	}
+
+	auto d_feats = new CDenseFeatures<float64_t>(data);
+	SGVector<float64_t> params(1);
+	params[0] = width;
+	auto r_feats = some<CRandomFourierDotFeatures>(
+			d_feats, D, GAUSSIAN, params, RP_FASTFOOD);
+	EXPECT_EQ(r_feats->get_projection(), RP_FASTFOOD);
+	EXPECT_EQ(r_feats->get_random_coefficients().num_cols, 0);
+
+	for (index_t i=0; i<vecs; i++)
+	{
+		for (index_t j=0; j<vecs; j++)
+		{
+			float64_t dist = 0;
+			for (index_t k=0; k<num_dims; k++)
+				dist += CMath::sq(data(k,i)-data(k,j));
+			EXPECT_NEAR(r_feats->dot(i,r_feats,j), std::exp(-dist/width), 0.06);
+		}
+	}
+}
+
+TEST(RandomFourierDotFeatures, feature_vectors)
+{
+	int32_t num_dims = 20;
+	int32_t vecs = 7;
+	int32_t D = 50;
+
+	SGMatrix<float64_t> data(num_dims, vecs);
+	for (index_t i=0; i<num_dims*vecs; i++)
+		data.matrix[i] = CMath::randn_double();
+
+	auto d_feats = some<CDenseFeatures<float64_t>>(data);
+	SGVector<float64_t> params(1);
+	params[0] = 8;
+	SGVector<float64_t> w(D);
+	for (index_t i=0; i<D; i++)
+		w[i] = CMath::randn_double();
+
+	ERandomProjection projections[] = {RP_DENSE, RP_FASTFOOD};
+	for (auto projection : projections)
+	{
+		auto r_feats = some<CRandomFourierDotFeatures>(
+				d_feats, D, GAUSSIAN, params, projection);
+
+		SGMatrix<float64_t> features = r_feats->get_feature_vectors(2, vecs);
+		ASSERT_EQ(features.num_rows, D);
+		ASSERT_EQ(features.num_cols, vecs-2);
+		for (index_t i=2; i<vecs; i++)
+		{
+			float64_t dot = 0;
+			for (index_t k=0; k<D; k++)
+				dot += features(k,i-2)*w[k];
+			EXPECT_NEAR(r_feats->dense_dot(i, w.vector, D), dot, 1e-12);
+
+			SGVector<float64_t> added(D);
+			added.zero();
+			r_feats->add_to_dense_vec(2, i, added.vector, D);
+			for (index_t k=0; k<D; k++)
+				EXPECT_NEAR(added[k], 2*features(k,i-2), 1e-12);
+		}
+	}
+}
@@ -397,3 +397,51 @@ TEST(SparseFeaturesTest,subset_get_full_feature_vector_smaller)
 
 	SG_UNREF(features);
 }
+
+TEST(SparseFeaturesTest, sparse_feature_view)
+{
+	SGMatrix<float64_t> data(4, 6);
+	for (index_t i=0; i<data.num_rows*data.num_cols; ++i)
+		data.matrix[i]=i%3 ? i : 0;
+
+	CSparseFeatures<float64_t>* feats=new CSparseFeatures<float64_t>(data);
+	ASSERT_TRUE(feats->can_view_feature_vectors());
+
+	SGVector<index_t> subset(2);
+	subset[0]=5;
+	subset[1]=2;
+	feats->add_subset(subset);
+
+	SGVector<float64_t> w(4);
+	w.range_fill(1.0);
+	for (index_t j=0; j<subset.vlen; ++j)
+	{
+		SGSparseVector<float64_t> sv=feats->get_sparse_feature_vector(j);
+		SGVectorView<const SGSparseVectorEntry<float64_t> > view=
+			feats->get_sparse_feature_view(j);
+		ASSERT_EQ(view.size(), sv.num_feat_entries);
+		EXPECT_EQ(view.data(), sv.features);
+
+		float64_t expected=0;
+		for (index_t i=0; i<data.num_rows; ++i)
+			expected+=w[i]*data(i, subset[j]);
+		EXPECT_EQ(feats->dense_dot_view(j, w), expected);
+		EXPECT_EQ(feats->get_nnz_features_for_vector(j), sv.num_feat_entries);
+
+		SGVector<float64_t> added(4);
+		added.zero();
+		feats->add_to_dense_vec_view(2.0, j, added);
+		for (index_t i=0; i<data.num_rows; ++i)
+			EXPECT_EQ(added[i], 2*data(i, subset[j]));
+	}
+	float64_t expected_dot=0;
+	for (index_t i=0; i<data.num_rows; ++i)
+		expected_dot+=data(i, 5)*data(i, 2);
+	EXPECT_EQ(feats->dot(0, feats, 1), expected_dot);
+	feats->remove_subset();
+
+	CSparseFeatures<float64_t>* empty=new CSparseFeatures<float64_t>();
+	EXPECT_FALSE(empty->can_view_feature_vectors());
+	SG_UNREF(empty);
+	SG_UNREF(feats);
+}
@@ -123,3 +123,106 @@ TEST(StreamingDenseFeaturesTest, reset_stream)
 	feats->end_parser();
 	SG_UNREF(feats);
 }
+
+TEST(StreamingDenseFeaturesTest, get_next_batch)
+{
+	index_t n=20;
+	index_t dim=3;
+	index_t batch_size=7;
+
+	SGMatrix<float64_t> data(dim,n);
+	SGVector<float64_t> labels(n);
+	for (index_t i=0; i<dim*n; ++i)
+		data.matrix[i]=sg_rand->std_normal_distrib();
+	for (index_t i=0; i<n; ++i)
+		labels[i]=i;
+
+	CDenseFeatures<float64_t>* orig_feats=new CDenseFeatures<float64_t>(data);
+	CStreamingDenseFeatures<float64_t>* feats=
+		new CStreamingDenseFeatures<float64_t>(orig_feats, labels.vector);
+
+	feats->start_parser();
+
+	index_t num_seen=0;
+	while (true)
+	{
+		SGMatrix<float64_t> batch=feats->get_next_batch(batch_size);
+		if (!batch.num_cols)
+			break;
+
+		EXPECT_EQ(CMath::min(batch_size, n-num_seen), batch.num_cols);
+		ASSERT_EQ(dim, batch.num_rows);
+
+		SGVector<float64_t> batch_labels=feats->get_batch_labels();
+		ASSERT_EQ(batch.num_cols, batch_labels.vlen);
+
+		for (index_t i=0; i<batch.num_cols; ++i)
+		{
+			EXPECT_EQ(num_seen+i, batch_labels[i]);
+			for (index_t j=0; j<dim; ++j)
+				EXPECT_EQ(data(j,num_seen+i), batch(j,i));
+		}
+		num_seen+=batch.num_cols;
+	}
+	EXPECT_EQ(n, num_seen);
+
+	feats->end_parser();
+	SG_UNREF(feats);
+}
+
+TEST(StreamingDenseFeaturesTest, get_next_batch_mixed_with_examples)
+{
+	index_t n=20;
+	index_t dim=2;
+
+	SGMatrix<float64_t> data(dim,n);
+	SGVector<float64_t> labels(n);
+	for (index_t i=0; i<dim*n; ++i)
+		data.matrix[i]=sg_rand->std_normal_distrib();
+	for (index_t i=0; i<n; ++i)
+		labels[i]=i;
+
+	CDenseFeatures<float64_t>* orig_feats=new CDenseFeatures<float64_t>(data);
+	CStreamingDenseFeatures<float64_t>* feats=
+		new CStreamingDenseFeatures<float64_t>(orig_feats, labels.vector);
+
+	feats->start_parser();
+
+	ASSERT_TRUE(feats->get_next_example());
+	EXPECT_EQ(0, feats->get_label());
+	feats->release_example();
+
+	/* the batch releases the example that is still held */
+	ASSERT_TRUE(feats->get_next_example());
+	EXPECT_EQ(1, feats->get_label());
+	SGMatrix<float64_t> batch=feats->get_next_batch(5);
+	ASSERT_EQ(5, batch.num_cols);
+	SGVector<float64_t> batch_labels=feats->get_batch_labels();
+	for (index_t i=0; i<batch.num_cols; ++i)
+	{
+		EXPECT_EQ(2+i, batch_labels[i]);
+		for (index_t j=0; j<dim; ++j)
+			EXPECT_EQ(data(j,2+i), batch(j,i));
+	}
+
+	/* the vector of an example refers to the stream's memory, it must not
+	 * outlive the stream */
+	ASSERT_TRUE(feats->get_next_example());
+	EXPECT_EQ(7, feats->get_label());
+	{
+		SGVector<float64_t> example=feats->get_vector();
+		for (index_t j=0; j<dim; ++j)
+			EXPECT_EQ(data(j,7), example[j]);
+	}
+	feats->release_example();
+
+	batch=feats->get_next_batch(n);
+	ASSERT_EQ(n-8, batch.num_cols);
+	batch_labels=feats->get_batch_labels();
+	for (index_t i=0; i<batch.num_cols; ++i)
+		EXPECT_EQ(8+i, batch_labels[i]);
+
+	EXPECT_FALSE(feats->get_next_example());
+	feats->end_parser();
+	SG_UNREF(feats);
+}
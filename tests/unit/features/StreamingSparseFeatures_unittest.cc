@@ -78,3 +78,73 @@ TEST(StreamingSparseFeaturesTest, parse_file)
 
   std::remove(fname);
 }
+
+TEST(StreamingSparseFeaturesTest, get_next_batch)
+{
+  char fname[] = "StreamingSparseFeatures_get_next_batch.XXXXXX";
+  generate_temp_filename(fname);
+
+  int32_t num_vec=30;
+  int32_t num_feat=0;
+  int32_t batch_size=8;
+
+  SGSparseVector<float64_t>* data=SG_MALLOC(SGSparseVector<float64_t>, num_vec);
+  float64_t* labels=SG_MALLOC(float64_t, num_vec);
+  for (int32_t i=0; i<num_vec; i++)
+  {
+    data[i]=SGSparseVector<float64_t>(i%5+1);
+    labels[i]=i%2 ? 1 : -1;
+    for (int32_t j=0; j<data[i].num_feat_entries; j++)
+    {
+      int32_t feat_index=(j+1)*3;
+      if (feat_index>num_feat)
+        num_feat=feat_index;
+
+      data[i].features[j].feat_index=feat_index-1;
+      data[i].features[j].entry=i+0.5*j;
+    }
+  }
+  CLibSVMFile* fout = new CLibSVMFile(fname, 'w', NULL);
+  fout->set_sparse_matrix(data, num_feat, num_vec, labels);
+  SG_UNREF(fout);
+
+  /* a ring smaller than the batch size */
+  CStreamingAsciiFile *file = new CStreamingAsciiFile(fname);
+  CStreamingSparseFeatures<float64_t> *stream_features =
+    new CStreamingSparseFeatures<float64_t>(file, true, 5);
+
+  stream_features->start_parser();
+  index_t num_seen=0;
+  while (true)
+  {
+    SGSparseMatrix<float64_t> batch=stream_features->get_next_batch(batch_size);
+    if (!batch.num_vectors)
+      break;
+
+    EXPECT_EQ(CMath::min(batch_size, num_vec-num_seen), batch.num_vectors);
+    SGVector<float64_t> batch_labels=stream_features->get_batch_labels();
+    ASSERT_EQ(batch.num_vectors, batch_labels.vlen);
+
+    for (index_t i=0; i<batch.num_vectors; i++)
+    {
+      const SGSparseVector<float64_t>& expected=data[num_seen+i];
+      EXPECT_EQ(labels[num_seen+i], batch_labels[i]);
+      ASSERT_EQ(expected.num_feat_entries, batch[i].num_feat_entries);
+      for (index_t j=0; j<expected.num_feat_entries; j++)
+      {
+        EXPECT_EQ(expected.features[j].feat_index, batch[i].features[j].feat_index);
+        EXPECT_DOUBLE_EQ(expected.features[j].entry, batch[i].features[j].entry);
+      }
+    }
+    num_seen+=batch.num_vectors;
+  }
+  EXPECT_EQ(num_vec, num_seen);
+  EXPECT_EQ(num_feat, stream_features->get_num_features());
+  stream_features->end_parser();
+
+  SG_UNREF(stream_features);
+  SG_FREE(data);
+  SG_FREE(labels);
+
+  std::remove(fname);
+}
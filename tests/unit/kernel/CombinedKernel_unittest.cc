@@ -6,6 +6,7 @@
 #include <shogun/kernel/CombinedKernel.h>
 #include <shogun/kernel/CustomKernel.h>
 #include <shogun/kernel/GaussianKernel.h>
+#include <shogun/kernel/normalizer/SqrtDiagKernelNormalizer.h>
 #include <shogun/mathematics/Math.h>
 
 using namespace shogun;
@@ -349,3 +350,121 @@ TEST(CombinedKernelTest,combination)
 	SG_UNREF(combined_list);
 	SG_UNREF(kernel_list);
 }
+
+TEST(CombinedKernelTest, subkernel_cache)
+{
+	const index_t num_vectors = 15;
+
+	auto gen = some<CMeanShiftDataGenerator>(0, 2);
+	auto feats = wrap(gen->get_streamed_features(num_vectors));
+
+	auto combined = some<CCombinedKernel>();
+	combined->append_kernel(new CGaussianKernel(10, 0.5));
+	combined->append_kernel(new CGaussianKernel(10, 2));
+	combined->append_kernel(new CGaussianKernel(10, 8));
+	combined->init(feats, feats);
+
+	SGMatrix<float64_t> expected = combined->get_kernel_matrix();
+
+	EXPECT_FALSE(combined->has_subkernel_cache());
+	EXPECT_TRUE(combined->precompute_subkernel_cache());
+	EXPECT_TRUE(combined->has_subkernel_cache());
+
+	SGMatrix<float64_t> cached = combined->get_kernel_matrix();
+	for (index_t i = 0; i < num_vectors; ++i)
+	{
+		for (index_t j = 0; j < num_vectors; ++j)
+			EXPECT_NEAR(expected(i, j), cached(i, j), 1e-6);
+	}
+
+	// weights may still change once the subkernels are cached
+	SGVector<float64_t> weights(3);
+	weights[0] = 0.2;
+	weights[1] = 0.0;
+	weights[2] = 0.8;
+	combined->set_subkernel_weights(weights);
+
+	SGMatrix<float64_t> sub_0, sub_2;
+	{
+		auto k0 = wrap(combined->get_kernel(0));
+		auto k2 = wrap(combined->get_kernel(2));
+		sub_0 = k0->get_kernel_matrix();
+		sub_2 = k2->get_kernel_matrix();
+	}
+
+#ifdef USE_SVMLIGHT
+	SGVector<float64_t> sub_row(num_vectors);
+	SGVector<float64_t> mirrored_row(num_vectors);
+#endif //USE_SVMLIGHT
+	for (index_t i = 0; i < num_vectors; ++i)
+	{
+		SGVector<float64_t> row = combined->get_kernel_row(i);
+		SGVector<float64_t> col = combined->get_kernel_col(i);
+		EXPECT_EQ(row.vlen, num_vectors);
+		EXPECT_EQ(col.vlen, num_vectors);
+
+#ifdef USE_SVMLIGHT
+		// rows as requested by the svmlight solvers, beyond num_lhs mirrored
+		combined->get_subkernel_row(2, i, sub_row.vector);
+		combined->get_subkernel_row(
+		    2, 2 * num_vectors - 1 - i, mirrored_row.vector);
+#endif //USE_SVMLIGHT
+
+		for (index_t j = 0; j < num_vectors; ++j)
+		{
+			float64_t k_ij = 0.2 * sub_0(i, j) + 0.8 * sub_2(i, j);
+			EXPECT_NEAR(k_ij, combined->kernel(i, j), 1e-6);
+			EXPECT_NEAR(k_ij, row[j], 1e-6);
+			EXPECT_NEAR(0.2 * sub_0(j, i) + 0.8 * sub_2(j, i), col[j], 1e-6);
+			EXPECT_NEAR(sub_2(i, j), combined->compute_subkernel(2, i, j), 1e-6);
+#ifdef USE_SVMLIGHT
+			EXPECT_NEAR(sub_2(i, j), sub_row[j], 1e-6);
+			EXPECT_NEAR(sub_2(i, j), mirrored_row[j], 1e-6);
+#endif //USE_SVMLIGHT
+		}
+	}
+
+	// changing the features drops the cache
+	combined->init(feats, feats);
+	EXPECT_FALSE(combined->has_subkernel_cache());
+}
+
+TEST(CombinedKernelTest, subkernel_cache_asymmetric)
+{
+	auto gen = some<CMeanShiftDataGenerator>(0, 2);
+	auto feats_a = wrap(gen->get_streamed_features(12));
+	auto feats_b = wrap(gen->get_streamed_features(7));
+
+	auto combined = some<CCombinedKernel>();
+	combined->append_kernel(new CGaussianKernel(10, 0.5));
+	combined->append_kernel(new CGaussianKernel(10, 2));
+	combined->init(feats_a, feats_b);
+
+	SGMatrix<float64_t> expected = combined->get_kernel_matrix();
+	EXPECT_TRUE(combined->precompute_subkernel_cache());
+
+	for (index_t i = 0; i < 12; ++i)
+	{
+		SGVector<float64_t> row = combined->get_kernel_row(i);
+		EXPECT_EQ(row.vlen, 7);
+		for (index_t j = 0; j < 7; ++j)
+		{
+			EXPECT_NEAR(expected(i, j), combined->kernel(i, j), 1e-6);
+			EXPECT_NEAR(expected(i, j), row[j], 1e-6);
+		}
+	}
+
+	for (index_t j = 0; j < 7; ++j)
+	{
+		SGVector<float64_t> col = combined->get_kernel_col(j);
+		EXPECT_EQ(col.vlen, 12);
+		for (index_t i = 0; i < 12; ++i)
+			EXPECT_NEAR(expected(i, j), col[i], 1e-6);
+	}
+
+	// the cache holds unnormalized sums, other normalizers are not cached
+	combined->set_normalizer(new CSqrtDiagKernelNormalizer());
+	combined->init(feats_a, feats_a);
+	EXPECT_FALSE(combined->precompute_subkernel_cache());
+	EXPECT_FALSE(combined->has_subkernel_cache());
+}
@@ -10,6 +10,7 @@
 #include <shogun/lib/NGramTokenizer.h>
 #include <shogun/lib/SGStringList.h>
 #include <shogun/features/hashed/HashedDocDotFeatures.h>
+#include <shogun/mathematics/Math.h>
 
 using namespace shogun;
 
@@ -69,3 +70,37 @@ TEST(CommUlongStringKernel, kernel_matrix)
 			EXPECT_EQ(feat_matrix(i,j), kernel_matrix(i,j));
 	}
 }
+
+TEST(CommUlongStringKernel, compute_gram_matrix)
+{
+	const index_t num_vec=50;
+	const char* acgt="ACGT";
+
+	sg_rand->set_seed(17);
+	SGStringList<char> list(num_vec, 60);
+	for (index_t i=0; i<num_vec; i++)
+	{
+		index_t len=CMath::random(8, 60);
+		list.strings[i]=SGString<char>(len);
+		for (index_t k=0; k<len; k++)
+			list.strings[i].string[k]=acgt[CMath::random(0, 3)];
+	}
+
+	auto s_feats=some<CStringFeatures<char>>(list, DNA);
+	auto l_feats=some<CStringFeatures<uint64_t>>(s_feats->get_alphabet());
+	l_feats->obtain_from_char(s_feats, 8-1, 8, 0, false);
+	auto preproc=some<CSortUlongString>();
+	preproc->fit(l_feats);
+	l_feats=
+	    wrap(preproc->transform(l_feats)->as<CStringFeatures<uint64_t>>());
+
+	bool signs[]={false, true};
+	for (auto use_sign : signs)
+	{
+		auto kernel=some<CCommUlongStringKernel>(l_feats, l_feats, use_sign);
+		SGMatrix<float64_t> expected=kernel->get_kernel_matrix();
+		SGMatrix<float64_t> gram=kernel->compute_gram_matrix();
+		for (index_t i=0; i<expected.num_rows*expected.num_cols; i++)
+			EXPECT_NEAR(gram[i], expected[i], 1E-12);
+	}
+}
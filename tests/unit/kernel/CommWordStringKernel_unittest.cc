@@ -0,0 +1,80 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: agent
+ */
+#include <gtest/gtest.h>
+#include <shogun/base/some.h>
+#include <shogun/features/StringFeatures.h>
+#include <shogun/kernel/string/CommWordStringKernel.h>
+#include <shogun/kernel/string/WeightedCommWordStringKernel.h>
+#include <shogun/lib/SGStringList.h>
+#include <shogun/mathematics/Math.h>
+#include <shogun/preprocessor/SortWordString.h>
+
+using namespace shogun;
+
+static Some<CStringFeatures<uint16_t>> create_kmer_features(index_t num_vec,
+		int32_t order)
+{
+	const char* acgt="ACGT";
+	SGStringList<char> list(num_vec, 40);
+	for (index_t i=0; i<num_vec; i++)
+	{
+		index_t len=CMath::random(order, 40);
+		list.strings[i]=SGString<char>(len);
+		for (index_t k=0; k<len; k++)
+			list.strings[i].string[k]=acgt[CMath::random(0, 3)];
+	}
+
+	auto s_feats=some<CStringFeatures<char>>(list, DNA);
+	auto w_feats=some<CStringFeatures<uint16_t>>(s_feats->get_alphabet());
+	w_feats->obtain_from_char(s_feats, order-1, order, 0, false);
+	auto preproc=some<CSortWordString>();
+	preproc->fit(w_feats);
+	return wrap(preproc->transform(w_feats)->as<CStringFeatures<uint16_t>>());
+}
+
+TEST(CommWordStringKernel, compute_gram_matrix)
+{
+	sg_rand->set_seed(17);
+	auto feats_a=create_kmer_features(60, 3);
+	auto feats_b=create_kmer_features(45, 3);
+
+	bool signs[]={false, true};
+	for (auto use_sign : signs)
+	{
+		auto kernel=some<CCommWordStringKernel>(feats_a, feats_a, use_sign);
+		SGMatrix<float64_t> expected=kernel->get_kernel_matrix();
+		SGMatrix<float64_t> gram=kernel->compute_gram_matrix();
+		for (index_t i=0; i<expected.num_rows*expected.num_cols; i++)
+			EXPECT_NEAR(gram[i], expected[i], 1E-12);
+
+		kernel->init(feats_a, feats_b);
+		expected=kernel->get_kernel_matrix();
+		gram=kernel->compute_gram_matrix();
+		ASSERT_EQ(gram.num_rows, 60);
+		ASSERT_EQ(gram.num_cols, 45);
+		for (index_t i=0; i<expected.num_rows*expected.num_cols; i++)
+			EXPECT_NEAR(gram[i], expected[i], 1E-12);
+	}
+}
+
+TEST(WeightedCommWordStringKernel, compute_gram_matrix)
+{
+	sg_rand->set_seed(17);
+	auto feats_a=create_kmer_features(60, 4);
+	auto feats_b=create_kmer_features(45, 4);
+
+	auto kernel=some<CWeightedCommWordStringKernel>(feats_a, feats_a, false);
+	SGMatrix<float64_t> expected=kernel->get_kernel_matrix();
+	SGMatrix<float64_t> gram=kernel->compute_gram_matrix();
+	for (index_t i=0; i<expected.num_rows*expected.num_cols; i++)
+		EXPECT_NEAR(gram[i], expected[i], 1E-12);
+
+	kernel->init(feats_a, feats_b);
+	expected=kernel->get_kernel_matrix();
+	gram=kernel->compute_gram_matrix();
+	for (index_t i=0; i<expected.num_rows*expected.num_cols; i++)
+		EXPECT_NEAR(gram[i], expected[i], 1E-12);
+}
@@ -7,13 +7,17 @@
 
 #include <gtest/gtest.h>
 
+#include <shogun/classifier/svm/LibSVM.h>
 #include <shogun/kernel/GaussianKernel.h>
 #include <shogun/kernel/CustomKernel.h>
 #include <shogun/features/DenseFeatures.h>
 #include <shogun/features/IndexFeatures.h>
+#include <shogun/labels/BinaryLabels.h>
 #include <shogun/features/streaming/generators/MeanShiftDataGenerator.h>
+#include <shogun/io/SerializableAsciiFile.h>
 #include <shogun/mathematics/eigen3.h>
 #include <shogun/mathematics/Math.h>
+#include "utils/Utils.h"
 
 using namespace shogun;
 using namespace Eigen;
@@ -635,3 +639,165 @@ TEST(CustomKernelTest, row_col_wise_sum_block_no_diag)
 	SG_UNREF(feats_p);
 	SG_UNREF(feats_q);
 }
+
+TEST(CustomKernelTest,memory_mapped_triangle_file)
+{
+	index_t m=10;
+	CMeanShiftDataGenerator* gen=new CMeanShiftDataGenerator(0, 2);
+	CFeatures* feats=gen->get_streamed_features(m);
+	SG_REF(feats);
+
+	CGaussianKernel* gauss=new CGaussianKernel(10, 3);
+	gauss->init(feats, feats);
+	SGMatrix<float64_t> expected=gauss->get_kernel_matrix();
+
+	for (int32_t use_float16=0; use_float16<2; use_float16++)
+	{
+		char filename[]="CustomKernel-mmap.XXXXXX";
+		generate_temp_filename(filename);
+
+		/* tile size that does not divide the number of vectors */
+		EXPECT_TRUE(CCustomKernel::save_triangle_kernel_matrix_to_file(gauss,
+				filename, 4, use_float16));
+
+		CCustomKernel* custom=new CCustomKernel();
+		EXPECT_TRUE(custom->set_triangle_kernel_matrix_from_file(filename));
+		EXPECT_TRUE(custom->is_memory_mapped());
+		EXPECT_EQ(custom->get_num_vec_lhs(), m);
+		EXPECT_EQ(custom->get_num_vec_rhs(), m);
+
+		SGVector<int32_t> rows(2);
+		rows[0]=1;
+		rows[1]=9;
+		custom->prefetch_rows(rows.vector, rows.vlen);
+
+		float64_t eps=use_float16 ? 1e-3 : 1e-6;
+		SGMatrix<float64_t> km=custom->get_kernel_matrix();
+		for (index_t i=0; i<m; i++)
+		{
+			for (index_t j=0; j<m; j++)
+				EXPECT_NEAR(km(i,j), expected(i,j), eps);
+		}
+
+		/* subsets work on the mapped matrix as well */
+		SGVector<index_t> subset(3);
+		subset[0]=7;
+		subset[1]=2;
+		subset[2]=5;
+		custom->add_row_subset(subset);
+		custom->add_col_subset(subset);
+		for (index_t i=0; i<subset.vlen; i++)
+		{
+			for (index_t j=0; j<subset.vlen; j++)
+				EXPECT_NEAR(custom->kernel(i,j), expected(subset[i],subset[j]), eps);
+		}
+
+		SG_UNREF(custom);
+		unlink(filename);
+	}
+
+	SG_UNREF(gauss);
+	SG_UNREF(feats);
+	SG_UNREF(gen);
+}
+
+TEST(CustomKernelTest,memory_mapped_serialization)
+{
+	index_t m=10;
+	CMeanShiftDataGenerator* gen=new CMeanShiftDataGenerator(0, 2);
+	CFeatures* feats=gen->get_streamed_features(m);
+	SG_REF(feats);
+
+	CGaussianKernel* gauss=new CGaussianKernel(10, 3);
+	gauss->init(feats, feats);
+
+	char filename[]="CustomKernel-mmap.XXXXXX";
+	generate_temp_filename(filename);
+	EXPECT_TRUE(CCustomKernel::save_triangle_kernel_matrix_to_file(gauss,
+			filename, 4, true));
+
+	CCustomKernel* custom=new CCustomKernel();
+	EXPECT_TRUE(custom->set_triangle_kernel_matrix_from_file(filename));
+	SGVector<index_t> subset(3);
+	subset[0]=7;
+	subset[1]=2;
+	subset[2]=5;
+	custom->add_row_subset(subset);
+
+	char serialized[]="CustomKernel-serialized.XXXXXX";
+	generate_temp_filename(serialized);
+	CSerializableAsciiFile* outfile=new CSerializableAsciiFile(serialized, 'w');
+	custom->save_serializable(outfile);
+	SG_UNREF(outfile);
+
+	/* only the file name and format are stored, the file is mapped again */
+	CCustomKernel* loaded=new CCustomKernel();
+	CSerializableAsciiFile* infile=new CSerializableAsciiFile(serialized, 'r');
+	loaded->load_serializable(infile);
+	SG_UNREF(infile);
+
+	EXPECT_TRUE(loaded->is_memory_mapped());
+	EXPECT_EQ(loaded->get_num_vec_lhs(), subset.vlen);
+	EXPECT_EQ(loaded->get_num_vec_rhs(), m);
+	for (index_t i=0; i<subset.vlen; i++)
+	{
+		for (index_t j=0; j<m; j++)
+			EXPECT_EQ(loaded->kernel(i,j), custom->kernel(i,j));
+	}
+
+	SG_UNREF(loaded);
+	SG_UNREF(custom);
+	unlink(serialized);
+	unlink(filename);
+
+	SG_UNREF(gauss);
+	SG_UNREF(feats);
+	SG_UNREF(gen);
+}
+
+TEST(CustomKernelTest,memory_mapped_libsvm)
+{
+	index_t m=20;
+	CMeanShiftDataGenerator* gen=new CMeanShiftDataGenerator(1, 2);
+	CFeatures* feats=gen->get_streamed_features(m);
+	SG_REF(feats);
+
+	CGaussianKernel* gauss=new CGaussianKernel(10, 3);
+	gauss->init(feats, feats);
+
+	char filename[]="CustomKernel-mmap.XXXXXX";
+	generate_temp_filename(filename);
+	EXPECT_TRUE(CCustomKernel::save_triangle_kernel_matrix_to_file(gauss,
+			filename, 4, false));
+
+	CCustomKernel* mapped=new CCustomKernel();
+	EXPECT_TRUE(mapped->set_triangle_kernel_matrix_from_file(filename));
+	CCustomKernel* in_memory=new CCustomKernel(gauss);
+
+	SGVector<float64_t> lab(m);
+	for (index_t i=0; i<m; i++)
+		lab[i]=i%2 ? 1 : -1;
+	CBinaryLabels* labels=new CBinaryLabels(lab);
+
+	/* the solver reads ahead rows of the mapped matrix, the result must not
+	 * depend on it */
+	CLibSVM* svm_mapped=new CLibSVM(1, mapped, labels);
+	CLibSVM* svm_in_memory=new CLibSVM(1, in_memory, labels);
+	svm_mapped->train();
+	svm_in_memory->train();
+
+	SGVector<float64_t> alphas=svm_mapped->get_alphas();
+	SGVector<float64_t> expected=svm_in_memory->get_alphas();
+	ASSERT_EQ(alphas.vlen, expected.vlen);
+	for (index_t i=0; i<alphas.vlen; i++)
+		EXPECT_NEAR(alphas[i], expected[i], 1e-10);
+	EXPECT_NEAR(svm_mapped->get_bias(), svm_in_memory->get_bias(), 1e-10);
+
+	SG_UNREF(svm_mapped);
+	SG_UNREF(svm_in_memory);
+	unlink(filename);
+
+	SG_UNREF(gauss);
+	SG_UNREF(feats);
+	SG_UNREF(gen);
+}
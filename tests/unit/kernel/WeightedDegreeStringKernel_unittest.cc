@@ -0,0 +1,56 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: agent
+ */
+#include <gtest/gtest.h>
+#include <shogun/base/some.h>
+#include <shogun/features/StringFeatures.h>
+#include <shogun/kernel/string/WeightedDegreeStringKernel.h>
+#include <shogun/lib/SGStringList.h>
+#include <shogun/mathematics/Math.h>
+
+using namespace shogun;
+
+TEST(WeightedDegreeStringKernel, compute_batch)
+{
+	const index_t num_vec=150;
+	const index_t len=30;
+	const index_t num_suppvec=40;
+	const char* acgt="ACGT";
+
+	sg_rand->set_seed(17);
+	SGStringList<char> list(num_vec, len);
+	for (index_t i=0; i<num_vec; i++)
+	{
+		list.strings[i]=SGString<char>(len);
+		for (index_t k=0; k<len; k++)
+			list.strings[i].string[k]=acgt[CMath::random(0, 3)];
+	}
+
+	auto feats=some<CStringFeatures<char>>(list, DNA);
+	auto kernel=some<CWeightedDegreeStringKernel>(8);
+	kernel->init(feats, feats);
+
+	SGVector<int32_t> idx(num_suppvec);
+	SGVector<float64_t> alphas(num_suppvec);
+	for (index_t i=0; i<num_suppvec; i++)
+	{
+		idx[i]=CMath::random(0, num_vec-1);
+		alphas[i]=CMath::random(-1.0, 1.0);
+	}
+
+	SGVector<int32_t> vec_idx(num_vec);
+	vec_idx.range_fill();
+	SGVector<float64_t> batch(num_vec);
+	batch.zero();
+	kernel->compute_batch(num_vec, vec_idx.vector, batch.vector, num_suppvec,
+			idx.vector, alphas.vector);
+
+	/* the batch walks the flattened tree of every position, which has to
+	 * give the same as the complete tries */
+	kernel->init_optimization(num_suppvec, idx.vector, alphas.vector);
+	for (index_t i=0; i<num_vec; i++)
+		EXPECT_NEAR(batch[i], kernel->compute_optimized(i), 1E-8);
+	kernel->delete_optimization();
+}
@@ -0,0 +1,97 @@
+#include <gtest/gtest.h>
+#include <shogun/lib/SGMatrix.h>
+#include <shogun/lib/SGMatrixView.h>
+#include <shogun/lib/SGVector.h>
+#include <shogun/lib/SGVectorView.h>
+#include <shogun/mathematics/linalg/LinalgNamespace.h>
+
+using namespace shogun;
+
+TEST(SGVectorViewTest, view_of_vector)
+{
+	SGVector<float64_t> a(5);
+	a.range_fill(1.0);
+
+	SGVectorView<float64_t> view(a);
+	EXPECT_EQ(view.data(), a.vector);
+	EXPECT_EQ(view.size(), a.vlen);
+	EXPECT_FALSE(view.empty());
+	/* views do not take part in reference counting */
+	EXPECT_EQ(a.ref_count(), 1);
+
+	view[2] = 42;
+	EXPECT_EQ(a[2], 42);
+
+	float64_t sum = 0;
+	for (auto v : view)
+		sum += v;
+	EXPECT_EQ(sum, 1 + 2 + 42 + 4 + 5);
+
+	SGVectorView<const float64_t> const_view = view.slice(1, 3);
+	EXPECT_EQ(const_view.size(), 3);
+	EXPECT_EQ(const_view[0], 2);
+	EXPECT_EQ(const_view[1], 42);
+	EXPECT_THROW(view.slice(3, 3), ShogunException);
+
+	EXPECT_TRUE(SGVectorView<int32_t>().empty());
+}
+
+TEST(SGVectorViewTest, view_of_matrix)
+{
+	SGMatrix<float64_t> A(3, 4);
+	for (index_t i = 0; i < A.num_rows * A.num_cols; ++i)
+		A.matrix[i] = i;
+
+	SGMatrixView<const float64_t> view(A);
+	EXPECT_EQ(view.num_rows(), 3);
+	EXPECT_EQ(view.num_cols(), 4);
+	EXPECT_EQ(view.size(), 12);
+	EXPECT_EQ(A.ref_count(), 1);
+
+	for (index_t j = 0; j < A.num_cols; ++j)
+	{
+		SGVectorView<const float64_t> col = view.col(j);
+		EXPECT_EQ(col.size(), A.num_rows);
+		for (index_t i = 0; i < A.num_rows; ++i)
+		{
+			EXPECT_EQ(view(i, j), A(i, j));
+			EXPECT_EQ(col[i], A(i, j));
+		}
+	}
+}
+
+TEST(SGVectorViewTest, linalg)
+{
+	SGVector<float64_t> a(4), b(4), c(4);
+	a.range_fill(1.0);
+	b.range_fill(2.0);
+
+	SGVectorView<const float64_t> va(a), vb(b);
+	SGVectorView<float64_t> vc(c);
+
+	EXPECT_EQ(linalg::dot(va, vb), linalg::dot(a, b));
+	EXPECT_NEAR(linalg::norm(va), linalg::norm(a), 1e-15);
+
+	linalg::add(va, vb, vc, 2.0, -1.0);
+	for (index_t i = 0; i < c.vlen; ++i)
+		EXPECT_EQ(c[i], 2 * a[i] - b[i]);
+
+	linalg::scale(va, vc, 3.0);
+	for (index_t i = 0; i < c.vlen; ++i)
+		EXPECT_EQ(c[i], 3 * a[i]);
+
+	SGMatrix<float64_t> A(3, 4);
+	for (index_t i = 0; i < A.num_rows * A.num_cols; ++i)
+		A.matrix[i] = i;
+	SGVector<float64_t> expected = linalg::matrix_prod(A, a);
+	SGVector<float64_t> result(3);
+	linalg::matrix_prod(
+		SGMatrixView<const float64_t>(A), va,
+		SGVectorView<float64_t>(result));
+	for (index_t i = 0; i < result.vlen; ++i)
+		EXPECT_EQ(result[i], expected[i]);
+
+	EXPECT_THROW(
+		linalg::dot(va, SGVectorView<const float64_t>(b.vector, 3)),
+		ShogunException);
+}
@@ -196,3 +196,129 @@ TEST(KernelDensity,dual_tree_single_tree_equivalence)
 	SG_UNREF(feats);
 	SG_UNREF(k);
 }
+
+TEST(KernelDensity,single_tree_compact_kernels)
+{
+	sg_rand->set_seed(1);
+
+	SGMatrix<float64_t> data(2,200);
+	sg_rand->fill_array_oo(data.matrix,400);
+	CDenseFeatures<float64_t>* feats=new CDenseFeatures<float64_t>(data);
+	SG_REF(feats);
+
+	// some query points lie outside the support of every kernel
+	SGMatrix<float64_t> test(2,50);
+	sg_rand->fill_array_oo(test.matrix,100);
+	for (int32_t i=0;i<10;i++)
+		test(0,i)+=2;
+	CDenseFeatures<float64_t>* testfeats=new CDenseFeatures<float64_t>(test);
+	SG_REF(testfeats);
+
+	float64_t h=0.3;
+	EKernelType kernels[]={K_EPANECHNIKOV, K_TOPHAT, K_TRIANGULAR};
+	EEvaluationMode modes[]={EM_KDTREE_SINGLE, EM_BALLTREE_SINGLE};
+	for (auto kernel : kernels)
+	{
+		// brute force density
+		SGVector<float64_t> expected(test.num_cols);
+		for (int32_t i=0;i<test.num_cols;i++)
+		{
+			float64_t sum=0;
+			for (int32_t j=0;j<data.num_cols;j++)
+			{
+				float64_t dist=CMath::sqrt(CMath::sq(test(0,i)-data(0,j))+CMath::sq(test(1,i)-data(1,j)));
+				sum+=std::exp(CKernelDensity::log_kernel(kernel,dist,h));
+			}
+			expected[i]=std::log(sum/data.num_cols)+CKernelDensity::log_norm(kernel,h,2);
+		}
+
+		for (auto mode : modes)
+		{
+			CKernelDensity* k=new CKernelDensity(h, kernel, D_EUCLIDEAN, mode, 5);
+			k->train(feats);
+			SGVector<float64_t> res=k->get_log_density(testfeats);
+
+			for (int32_t i=0;i<res.vlen;i++)
+			{
+				if (expected[i]==-CMath::INFTY)
+					EXPECT_EQ(res[i],-CMath::INFTY);
+				else
+					EXPECT_NEAR(res[i],expected[i],1e-8);
+			}
+
+			SG_UNREF(k);
+		}
+	}
+
+	SG_UNREF(testfeats);
+	SG_UNREF(feats);
+}
+
+TEST(KernelDensity,dual_tree_kernels_and_tolerance)
+{
+	sg_rand->set_seed(1);
+
+	SGMatrix<float64_t> data(3,500);
+	sg_rand->fill_array_oo(data.matrix,1500);
+	CDenseFeatures<float64_t>* feats=new CDenseFeatures<float64_t>(data);
+	SG_REF(feats);
+
+	SGMatrix<float64_t> test(3,100);
+	sg_rand->fill_array_oo(test.matrix,300);
+	CDenseFeatures<float64_t>* testfeats=new CDenseFeatures<float64_t>(test);
+	SG_REF(testfeats);
+
+	float64_t h=0.5;
+	EKernelType kernels[]={K_GAUSSIAN, K_EPANECHNIKOV, K_TOPHAT, K_TRIANGULAR};
+	EEvaluationMode modes[]={EM_KDTREE_DUAL, EM_BALLTREE_DUAL};
+	for (auto kernel : kernels)
+	{
+		// brute force density
+		SGVector<float64_t> expected(test.num_cols);
+		for (int32_t i=0;i<test.num_cols;i++)
+		{
+			float64_t sum=0;
+			for (int32_t j=0;j<data.num_cols;j++)
+			{
+				float64_t dist=0;
+				for (int32_t d=0;d<3;d++)
+					dist+=CMath::sq(test(d,i)-data(d,j));
+				sum+=std::exp(CKernelDensity::log_kernel(kernel,std::sqrt(dist),h));
+			}
+			expected[i]=std::log(sum/data.num_cols)+CKernelDensity::log_norm(kernel,h,3);
+		}
+
+		for (auto mode : modes)
+		{
+			// exact and within 1% of the density
+			float64_t rtols[]={0, 0.01};
+			for (auto rtol : rtols)
+			{
+				CKernelDensity* k=new CKernelDensity(h, kernel, D_EUCLIDEAN, mode, 5, 0, rtol);
+				k->train(feats);
+				SGVector<float64_t> res=k->get_log_density(testfeats,5);
+
+				for (int32_t i=0;i<res.vlen;i++)
+				{
+					if (expected[i]==-CMath::INFTY)
+						EXPECT_EQ(res[i],-CMath::INFTY);
+					else if (rtol==0)
+						EXPECT_NEAR(res[i],expected[i],1e-8);
+					else
+						EXPECT_LE(CMath::abs(std::exp(res[i])-std::exp(expected[i])),
+								(rtol+1e-8)*std::exp(expected[i]));
+				}
+
+				SG_UNREF(k);
+			}
+		}
+	}
+
+	/* the compact kernels integrate to one */
+	EXPECT_NEAR(CKernelDensity::log_norm(K_TOPHAT,1,2),-std::log(CMath::PI),1e-12);
+	EXPECT_NEAR(CKernelDensity::log_norm(K_EPANECHNIKOV,1,1),std::log(0.75),1e-12);
+	EXPECT_NEAR(CKernelDensity::log_norm(K_TRIANGULAR,1,1),0,1e-12);
+
+	SG_UNREF(testfeats);
+	SG_UNREF(feats);
+}
@@ -0,0 +1,120 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: agent
+ */
+
+#include <shogun/lib/config.h>
+#include <shogun/mathematics/RandomStream.h>
+#include <shogun/lib/SGVector.h>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+using namespace shogun;
+
+TEST(RandomStream, same_seed_and_stream)
+{
+	RandomStream a(12345, 3);
+	RandomStream b(12345, 3);
+	for (index_t i=0; i<100; ++i)
+		EXPECT_EQ(a.random_64(), b.random_64());
+}
+
+TEST(RandomStream, different_streams)
+{
+	RandomStream a(12345, 0);
+	RandomStream b(12345, 1);
+	RandomStream c(12346, 0);
+	index_t num_equal=0;
+	for (index_t i=0; i<100; ++i)
+	{
+		uint64_t r=a.random_64();
+		num_equal+=(r==b.random_64());
+		num_equal+=(r==c.random_64());
+	}
+	EXPECT_EQ(num_equal, 0);
+}
+
+TEST(RandomStream, split_independent_of_draws)
+{
+	RandomStream parent(12345);
+	RandomStream child_1=parent.split(7);
+	for (index_t i=0; i<10; ++i)
+		parent.random_64();
+	RandomStream child_2=parent.split(7);
+
+	for (index_t i=0; i<100; ++i)
+		EXPECT_EQ(child_1.random_64(), child_2.random_64());
+}
+
+TEST(RandomStream, fill_array_co_matches_scalar)
+{
+	const index_t size=37;
+	RandomStream a(12345, 2);
+	RandomStream b(12345, 2);
+
+	SGVector<float64_t> bulk(size);
+	a.fill_array_co(bulk.vector, size);
+	for (index_t i=0; i<size; ++i)
+	{
+		EXPECT_EQ(bulk[i], b.random_half_open());
+		EXPECT_GE(bulk[i], 0.0);
+		EXPECT_LT(bulk[i], 1.0);
+	}
+
+	/* the stream continues where the bulk draw stopped */
+	EXPECT_EQ(a.random_64(), b.random_64());
+}
+
+TEST(RandomStream, fill_array_normal_moments)
+{
+	const index_t size=100001;
+	RandomStream stream(12345);
+	SGVector<float64_t> samples(size);
+	stream.fill_array_normal(samples.vector, size, 1.0, 2.0);
+
+	float64_t mean=0;
+	for (index_t i=0; i<size; ++i)
+		mean+=samples[i];
+	mean/=size;
+
+	float64_t var=0;
+	for (index_t i=0; i<size; ++i)
+		var+=(samples[i]-mean)*(samples[i]-mean);
+	var/=size-1;
+
+	EXPECT_NEAR(mean, 1.0, 0.05);
+	EXPECT_NEAR(var, 4.0, 0.1);
+}
+
+TEST(RandomStream, random_range)
+{
+	RandomStream stream(12345);
+	for (index_t i=0; i<1000; ++i)
+	{
+		index_t r=stream.random(-3, 5);
+		EXPECT_GE(r, -3);
+		EXPECT_LE(r, 5);
+	}
+}
+
+TEST(RandomStream, permute)
+{
+	const index_t size=50;
+	SGVector<index_t> a(size);
+	SGVector<index_t> b(size);
+	std::iota(a.vector, a.vector+size, 0);
+	std::iota(b.vector, b.vector+size, 0);
+
+	RandomStream(12345, 4).permute(a);
+	RandomStream(12345, 4).permute(b);
+	for (index_t i=0; i<size; ++i)
+		EXPECT_EQ(a[i], b[i]);
+
+	std::sort(a.vector, a.vector+size);
+	for (index_t i=0; i<size; ++i)
+		EXPECT_EQ(a[i], i);
+}
@@ -0,0 +1,228 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: agent
+ */
+
+#include <shogun/lib/config.h>
+#include <shogun/features/CombinedDotFeatures.h>
+#include <shogun/features/DenseFeatures.h>
+#include <shogun/features/SparseFeatures.h>
+#include <shogun/features/StringFeatures.h>
+#include <shogun/features/WDFeatures.h>
+#include <shogun/features/hashed/HashedDenseFeatures.h>
+#include <shogun/features/streaming/StreamingDenseFeatures.h>
+#include <shogun/mathematics/Math.h>
+#include <shogun/mathematics/StatisticsAccumulator.h>
+#include <gtest/gtest.h>
+
+using namespace shogun;
+
+/* data with a large offset, where naive sums of squares lose all digits */
+static SGMatrix<float64_t> generate_data(index_t dim, index_t num_vectors)
+{
+	SGMatrix<float64_t> data(dim, num_vectors);
+	for (index_t i=0; i<data.size(); ++i)
+		data[i]=1e6+CMath::randn_double();
+
+	return data;
+}
+
+static void check_moments(const StatisticsAccumulator<float64_t>& statistics,
+		SGMatrix<float64_t> data)
+{
+	const index_t dim=data.num_rows;
+	const index_t num_vectors=data.num_cols;
+	ASSERT_EQ(statistics.get_num_vectors(), num_vectors);
+
+	auto mean=statistics.get_mean();
+	auto variance=statistics.get_variance(true);
+	auto min=statistics.get_min();
+	auto max=statistics.get_max();
+	for (index_t i=0; i<dim; ++i)
+	{
+		/* the sum is shifted by the first value, a plain sum of values
+		 * around 1e6 is not accurate enough for the reference */
+		float64_t ref_mean=0;
+		float64_t ref_min=data(i, 0);
+		float64_t ref_max=data(i, 0);
+		for (index_t j=0; j<num_vectors; ++j)
+		{
+			ref_mean+=data(i, j)-data(i, 0);
+			ref_min=CMath::min(ref_min, data(i, j));
+			ref_max=CMath::max(ref_max, data(i, j));
+		}
+		ref_mean=data(i, 0)+ref_mean/num_vectors;
+
+		float64_t ref_variance=0;
+		for (index_t j=0; j<num_vectors; ++j)
+			ref_variance+=CMath::sq(data(i, j)-ref_mean);
+		ref_variance/=num_vectors-1;
+
+		EXPECT_NEAR(mean[i], ref_mean, 1e-9);
+		EXPECT_NEAR(variance[i], ref_variance, 1e-8);
+		EXPECT_EQ(min[i], ref_min);
+		EXPECT_EQ(max[i], ref_max);
+	}
+}
+
+TEST(StatisticsAccumulator, dense_chunks)
+{
+	const index_t dim=4;
+	const index_t num_vectors=1000;
+	auto data=generate_data(dim, num_vectors);
+
+	StatisticsAccumulator<float64_t> statistics(dim, true);
+	statistics.add(data);
+	check_moments(statistics, data);
+
+	auto cov=statistics.get_cov(true);
+	auto mean=statistics.get_mean();
+	for (index_t i=0; i<dim; ++i)
+	{
+		for (index_t j=0; j<dim; ++j)
+		{
+			float64_t ref_cov=0;
+			for (index_t k=0; k<num_vectors; ++k)
+				ref_cov+=(data(i, k)-mean[i])*(data(j, k)-mean[j]);
+			EXPECT_NEAR(cov(i, j), ref_cov/(num_vectors-1), 1e-8);
+		}
+	}
+
+	/* symmetric, and the variances on the diagonal */
+	auto variance=statistics.get_variance(true);
+	for (index_t i=0; i<dim; ++i)
+	{
+		EXPECT_NEAR(cov(i, i), variance[i], 1e-10);
+		for (index_t j=0; j<dim; ++j)
+			EXPECT_EQ(cov(i, j), cov(j, i));
+	}
+}
+
+TEST(StatisticsAccumulator, vectors_and_merge)
+{
+	const index_t dim=3;
+	const index_t num_vectors=300;
+	auto data=generate_data(dim, num_vectors);
+
+	StatisticsAccumulator<float64_t> first;
+	for (index_t j=0; j<100; ++j)
+		first.add(data.get_column(j));
+
+	StatisticsAccumulator<float64_t> second;
+	SGVector<index_t> indices(num_vectors-100);
+	for (index_t j=0; j<indices.vlen; ++j)
+		indices[j]=num_vectors-1-j;
+	second.add(data, indices);
+
+	first.merge(second);
+	EXPECT_EQ(first.get_dim(), dim);
+	check_moments(first, data);
+}
+
+TEST(StatisticsAccumulator, sparse_features)
+{
+	const index_t dim=5;
+	const index_t num_vectors=600;
+	SGMatrix<float64_t> data(dim, num_vectors);
+	for (index_t j=0; j<num_vectors; ++j)
+	{
+		/* the first dimension is dense, the last one is empty */
+		for (index_t i=0; i<dim-1; ++i)
+			data(i, j)=(i==0 || CMath::random(0, 2)==0) ? CMath::randn_double() : 0;
+		data(dim-1, j)=0;
+	}
+
+	auto sparse=some<CSparseFeatures<float64_t>>(data);
+	StatisticsAccumulator<float64_t> statistics;
+	statistics.add(sparse);
+	check_moments(statistics, data);
+
+	StatisticsAccumulator<float64_t> with_cov(0, true);
+	with_cov.add(sparse);
+	check_moments(with_cov, data);
+}
+
+TEST(StatisticsAccumulator, dot_features)
+{
+	const index_t dim=6;
+	const index_t num_vectors=700;
+	SGMatrix<float64_t> data(dim, num_vectors);
+	for (index_t j=0; j<num_vectors; ++j)
+	{
+		for (index_t i=0; i<dim; ++i)
+			data(i, j)=(i==0 || CMath::random(0, 2)==0) ? CMath::randn_double() : 0;
+	}
+
+	/* combined features are only accessible as dot features */
+	auto dot=some<CCombinedDotFeatures>();
+	dot->append_feature_obj(new CDenseFeatures<float64_t>(data));
+
+	StatisticsAccumulator<float64_t> statistics;
+	statistics.add(dot);
+	check_moments(statistics, data);
+
+	StatisticsAccumulator<float64_t> with_cov(0, true);
+	with_cov.add(dot);
+	check_moments(with_cov, data);
+}
+
+TEST(StatisticsAccumulator, high_dimensional_dot_features)
+{
+	const index_t num_vectors=300;
+	const index_t length=20;
+
+	/* WD features of order 3 have 20*(4+16+64) dimensions, every vector
+	 * has 20+19+18 non-zero entries */
+	SGStringList<uint8_t> list(num_vectors, length);
+	for (index_t i=0; i<num_vectors; ++i)
+	{
+		list.strings[i]=SGString<uint8_t>(length);
+		for (index_t k=0; k<length; ++k)
+			list.strings[i].string[k]=CMath::random(0, 3);
+	}
+	auto strings=some<CStringFeatures<uint8_t>>(list, RAWDNA);
+	auto wd=some<CWDFeatures>(strings, 3, 3);
+	auto wd_data=wd->get_computed_dot_feature_matrix();
+	ASSERT_EQ(wd_data.num_rows, length*(4+16+64));
+
+	StatisticsAccumulator<float64_t> statistics;
+	statistics.add(wd);
+	check_moments(statistics, wd_data);
+
+	/* hashed features cannot be iterated over */
+	SGMatrix<float64_t> data(10, num_vectors);
+	for (index_t i=0; i<data.size(); ++i)
+		data[i]=CMath::randn_double();
+	auto hashed=some<CHashedDenseFeatures<float64_t>>(data, 4096);
+	auto hashed_data=hashed->get_computed_dot_feature_matrix();
+
+	StatisticsAccumulator<float64_t> hashed_statistics;
+	hashed_statistics.add(hashed);
+	check_moments(hashed_statistics, hashed_data);
+
+	/* the mean of dot features is a plain sum of the vectors */
+	auto mean=hashed->get_mean();
+	auto ref_mean=hashed_statistics.get_mean();
+	for (index_t i=0; i<mean.vlen; ++i)
+		EXPECT_NEAR(mean[i], ref_mean[i], 1e-12);
+
+	auto joint_mean=CDotFeatures::compute_mean(wd, wd);
+	auto wd_mean=statistics.get_mean();
+	for (index_t i=0; i<joint_mean.vlen; ++i)
+		EXPECT_NEAR(joint_mean[i], wd_mean[i], 1e-12);
+}
+
+TEST(StatisticsAccumulator, streaming_features)
+{
+	const index_t dim=3;
+	const index_t num_vectors=5000;
+	auto data=generate_data(dim, num_vectors);
+
+	auto features=some<CDenseFeatures<float64_t>>(data);
+	auto stream=some<CStreamingDenseFeatures<float64_t>>(features.get());
+
+	StatisticsAccumulator<float64_t> statistics;
+	statistics.add(stream);
+	check_moments(statistics, data);
+}
@@ -144,7 +144,7 @@ TEST_F(BaggingMachine, classify_CART)
 	EXPECT_EQ(0.0,res_vector[1]);
 	EXPECT_EQ(0.0,res_vector[2]);
 	EXPECT_EQ(1.0,res_vector[3]);
-	EXPECT_EQ(1.0,res_vector[4]);
+	EXPECT_EQ(0.0,res_vector[4]);
 
 	auto eval = some<CMulticlassAccuracy>();
 	EXPECT_NEAR(0.642857,c->get_oob_error(eval),1e-6);
@@ -174,13 +174,13 @@ TEST_F(BaggingMachine, output_binary)
 	EXPECT_EQ(-1.0, res_vector[1]);
 	EXPECT_EQ(-1.0, res_vector[2]);
 	EXPECT_EQ(1.0, res_vector[3]);
-	EXPECT_EQ(1.0, res_vector[4]);
+	EXPECT_EQ(-1.0, res_vector[4]);
 
-	EXPECT_DOUBLE_EQ(1.0, values_vector[0]);
-	EXPECT_DOUBLE_EQ(0.3, values_vector[1]);
+	EXPECT_DOUBLE_EQ(0.9, values_vector[0]);
+	EXPECT_DOUBLE_EQ(0.0, values_vector[1]);
 	EXPECT_DOUBLE_EQ(0.3, values_vector[2]);
 	EXPECT_DOUBLE_EQ(1.0, values_vector[3]);
-	EXPECT_DOUBLE_EQ(0.7, values_vector[4]);
+	EXPECT_DOUBLE_EQ(0.3, values_vector[4]);
 
 	SG_UNREF(result);
 }
@@ -207,7 +207,7 @@ TEST_F(BaggingMachine, output_multiclass_probs_sum_to_one)
 	EXPECT_EQ(0.0, res_vector[1]);
 	EXPECT_EQ(0.0, res_vector[2]);
 	EXPECT_EQ(1.0, res_vector[3]);
-	EXPECT_EQ(1.0, res_vector[4]);
+	EXPECT_EQ(0.0, res_vector[4]);
 
 	int32_t num_labels = result->get_num_labels();
 
@@ -101,3 +101,95 @@ TEST(KernelPCA, apply_to_feature_vector)
 	SG_UNREF(kpca);
 	SG_UNREF(kernel);
 }
+
+TEST(KernelPCA, randomized_transform)
+{
+	index_t num_test_vectors = 2;
+
+	SGMatrix<float64_t> train_matrix(num_features, num_vectors);
+	SGMatrix<float64_t> test_matrix(num_features, num_test_vectors);
+	load_data(train_matrix, test_matrix);
+
+	CDenseFeatures<float64_t>* train_feats =
+	    new CDenseFeatures<float64_t>(train_matrix);
+
+	CDenseFeatures<float64_t>* test_feats =
+	    new CDenseFeatures<float64_t>(test_matrix);
+
+	SG_REF(train_feats)
+	SG_REF(test_feats)
+
+	CGaussianKernel* kernel = new CGaussianKernel();
+	SG_REF(kernel)
+	kernel->set_width(1);
+
+	CKernelPCA* kpca = new CKernelPCA(kernel);
+	SG_REF(kpca)
+	kpca->set_target_dim(target_dim);
+	kpca->set_method(KPCA_RANDOMIZED);
+	kpca->fit(train_feats);
+
+	SGMatrix<float64_t> embedding = kpca->transform(test_feats)
+	                                    ->as<CDenseFeatures<float64_t>>()
+	                                    ->get_feature_matrix();
+
+	// allow embedding with opposite sign
+	for (index_t i = 0; i < num_test_vectors * target_dim; ++i)
+		EXPECT_NEAR(CMath::abs(embedding[i]), CMath::abs(resdata[i]), 1E-6);
+
+	SG_UNREF(train_feats)
+	SG_UNREF(test_feats)
+	SG_UNREF(kpca);
+	SG_UNREF(kernel);
+}
+
+TEST(KernelPCA, randomized_matches_dense)
+{
+	const index_t num_train_vectors = 200;
+	const index_t num_test_vectors = 10;
+
+	SGMatrix<float64_t> train_matrix(num_features, num_train_vectors);
+	for (index_t i = 0; i < train_matrix.size(); ++i)
+		train_matrix[i] = CMath::randn_double();
+	SGMatrix<float64_t> test_matrix(num_features, num_test_vectors);
+	for (index_t i = 0; i < test_matrix.size(); ++i)
+		test_matrix[i] = CMath::randn_double();
+
+	CDenseFeatures<float64_t>* train_feats =
+	    new CDenseFeatures<float64_t>(train_matrix);
+	CDenseFeatures<float64_t>* test_feats =
+	    new CDenseFeatures<float64_t>(test_matrix);
+	SG_REF(train_feats)
+	SG_REF(test_feats)
+
+	CGaussianKernel* kernel = new CGaussianKernel();
+	SG_REF(kernel)
+	kernel->set_width(2);
+
+	CKernelPCA* dense = new CKernelPCA(kernel);
+	SG_REF(dense)
+	dense->set_target_dim(target_dim);
+	dense->fit(train_feats);
+	SGMatrix<float64_t> dense_embedding =
+	    dense->apply_to_feature_matrix(test_feats);
+
+	CKernelPCA* randomized = new CKernelPCA(kernel);
+	SG_REF(randomized)
+	randomized->set_target_dim(target_dim);
+	randomized->set_method(KPCA_RANDOMIZED);
+	randomized->fit(train_feats);
+	SGMatrix<float64_t> randomized_embedding =
+	    randomized->apply_to_feature_matrix(test_feats);
+
+	// allow embedding with opposite sign
+	for (index_t i = 0; i < num_test_vectors * target_dim; ++i)
+		EXPECT_NEAR(
+		    CMath::abs(randomized_embedding[i]),
+		    CMath::abs(dense_embedding[i]), 1E-4);
+
+	SG_UNREF(train_feats)
+	SG_UNREF(test_feats)
+	SG_UNREF(randomized);
+	SG_UNREF(dense);
+	SG_UNREF(kernel);
+}
@@ -7,6 +7,7 @@
 #include <gtest/gtest.h>
 #include <shogun/mathematics/Math.h>
 #include <shogun/features/DenseFeatures.h>
+#include <shogun/features/streaming/StreamingDenseFeatures.h>
 #include <shogun/lib/SGMatrix.h>
 #include <shogun/lib/SGVector.h>
 #include <shogun/mathematics/linalg/LinalgNamespace.h>
@@ -32,6 +33,57 @@ inline T check_eigenvector_eq(
 	return (sign < 0.0) ? -1.0 : 1.0;
 }
 
+/** Noisy data around a three dimensional subspace with distinct variances */
+SGMatrix<float64_t> generate_low_rank_data(index_t num_features, index_t num_vectors)
+{
+	SGMatrix<float64_t> basis(num_features, 3);
+	for (index_t i = 0; i < basis.size(); ++i)
+		basis[i] = CMath::randn_double();
+
+	SGMatrix<float64_t> data(num_features, num_vectors);
+	for (index_t j = 0; j < num_vectors; ++j)
+	{
+		float64_t latent[3] = {3 * CMath::randn_double(),
+		                       2 * CMath::randn_double(),
+		                       CMath::randn_double()};
+		for (index_t i = 0; i < num_features; ++i)
+		{
+			data(i, j) = 1.0 + 0.1 * CMath::randn_double();
+			for (index_t k = 0; k < 3; ++k)
+				data(i, j) += basis(i, k) * latent[k];
+		}
+	}
+	return data;
+}
+
+/** Compares a fitted PCA against SVD based PCA on the same features, the
+ * eigenvalues up to epsilon times the largest one */
+void check_against_svd(
+    CPCA* pca, CDenseFeatures<float64_t>* features, float64_t epsilon = 1e-8)
+{
+	auto reference = some<CPCA>(SVD);
+	reference->set_target_dim(pca->get_target_dim());
+	reference->fit(features);
+
+	auto ref_eigenvalues = reference->get_eigenvalues();
+	auto ref_transmat = reference->get_transformation_matrix();
+	auto eigenvalues = pca->get_eigenvalues();
+	auto transmat = pca->get_transformation_matrix();
+
+	ASSERT_EQ(transmat.num_rows, ref_transmat.num_rows);
+	ASSERT_EQ(transmat.num_cols, ref_transmat.num_cols);
+	for (index_t i = 0; i < transmat.num_cols; ++i)
+	{
+		EXPECT_NEAR(ref_eigenvalues[i], eigenvalues[i], epsilon * ref_eigenvalues[0]);
+		check_eigenvector_eq(ref_transmat.get_column(i), transmat.get_column(i), epsilon);
+	}
+
+	auto ref_mean = reference->get_mean();
+	auto mean = pca->get_mean();
+	for (index_t i = 0; i < mean.vlen; ++i)
+		EXPECT_NEAR(ref_mean[i], mean[i], 1e-10);
+}
+
 TEST(PCA, PCA_N_greater_D_EVD)
 {
 	SGMatrix<float64_t> data(3,5);
@@ -603,3 +655,66 @@ TEST(PCA, PCA_WHITEN_EVD)
 	EXPECT_NEAR(0.0,covariance_mat(2,1),epsilon);
 	EXPECT_NEAR(1.0,covariance_mat(2,2),epsilon);
 }
+
+TEST(PCA, PCA_RANDOMIZED)
+{
+	auto features = some<CDenseFeatures<float64_t>>(generate_low_rank_data(50, 200));
+	auto pca = some<CPCA>(RANDOMIZED);
+	pca->set_target_dim(3);
+	pca->fit(features);
+
+	check_against_svd(pca, features);
+}
+
+TEST(PCA, PCA_INCREMENTAL)
+{
+	auto features = some<CDenseFeatures<float64_t>>(generate_low_rank_data(50, 200));
+	auto pca = some<CPCA>(INCREMENTAL);
+	pca->set_target_dim(3);
+	pca->set_batch_size(7);
+	pca->fit(features);
+
+	/* only the leading components are kept after every batch, which drops
+	 * a little of the noise variance */
+	check_against_svd(pca, features, 1e-6);
+}
+
+TEST(PCA, PCA_INCREMENTAL_partial_fit)
+{
+	auto data = generate_low_rank_data(5, 300);
+	SGMatrix<float64_t> first(5, 100);
+	SGMatrix<float64_t> second(5, 200);
+	sg_memcpy(first.matrix, data.matrix, first.size() * sizeof(float64_t));
+	sg_memcpy(second.matrix, data.get_column_vector(100), second.size() * sizeof(float64_t));
+
+	auto pca = some<CPCA>(INCREMENTAL);
+	pca->set_target_dim(3);
+	pca->partial_fit(some<CDenseFeatures<float64_t>>(first));
+	pca->partial_fit(some<CDenseFeatures<float64_t>>(second));
+
+	check_against_svd(pca, some<CDenseFeatures<float64_t>>(data), 1e-6);
+}
+
+TEST(PCA, PCA_INCREMENTAL_streaming)
+{
+	auto features = some<CDenseFeatures<float64_t>>(generate_low_rank_data(20, 250));
+	auto stream = some<CStreamingDenseFeatures<float64_t>>(features.get());
+
+	auto pca = some<CPCA>(INCREMENTAL, true);
+	pca->set_target_dim(3);
+	pca->set_batch_size(16);
+	pca->fit(stream);
+
+	auto whitened = some<CPCA>(SVD, true);
+	whitened->set_target_dim(3);
+	whitened->fit(features);
+
+	auto transmat = pca->get_transformation_matrix();
+	auto ref_transmat = whitened->get_transformation_matrix();
+	for (index_t j = 0; j < transmat.num_cols; ++j)
+	{
+		float64_t sign = linalg::dot(transmat.get_column(j), ref_transmat.get_column(j)) < 0 ? -1 : 1;
+		for (index_t i = 0; i < transmat.num_rows; ++i)
+			EXPECT_NEAR(ref_transmat(i, j), sign * transmat(i, j), 1e-6);
+	}
+}
@@ -0,0 +1,97 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: agent
+ */
+
+#include <gtest/gtest.h>
+#include <shogun/features/DenseFeatures.h>
+#include <shogun/features/streaming/StreamingDenseFeatures.h>
+#include <shogun/mathematics/Math.h>
+#include <shogun/preprocessor/PruneVarSubMean.h>
+
+using namespace shogun;
+
+/* features of different scales, the second one is constant */
+static SGMatrix<float64_t> generate_data(index_t num_vectors)
+{
+	SGMatrix<float64_t> data(3, num_vectors);
+	for (index_t j=0; j<num_vectors; ++j)
+	{
+		data(0, j)=1+CMath::randn_double();
+		data(1, j)=5;
+		data(2, j)=-3+100*CMath::randn_double();
+	}
+	return data;
+}
+
+TEST(PruneVarSubMean, per_feature_variance)
+{
+	const index_t num_vectors=50;
+	auto data=generate_data(num_vectors);
+
+	auto features=some<CDenseFeatures<float64_t>>(data.clone());
+	auto preproc=some<CPruneVarSubMean>(true);
+	preproc->fit(features);
+	auto transformed=wrap(preproc->transform(features)->as<CDenseFeatures<float64_t>>());
+	auto result=transformed->get_feature_matrix();
+
+	/* the constant feature is pruned, every other one has zero mean and
+	 * unit variance on its own */
+	ASSERT_EQ(result.num_rows, 2);
+	ASSERT_EQ(result.num_cols, num_vectors);
+	for (index_t i=0; i<result.num_rows; ++i)
+	{
+		float64_t mean=0;
+		float64_t var=0;
+		for (index_t j=0; j<num_vectors; ++j)
+			mean+=result(i, j);
+		mean/=num_vectors;
+		for (index_t j=0; j<num_vectors; ++j)
+			var+=CMath::sq(result(i, j)-mean);
+		var/=num_vectors;
+
+		EXPECT_NEAR(mean, 0, 1e-12);
+		EXPECT_NEAR(var, 1, 1e-12);
+	}
+
+	/* the features keep their order */
+	const index_t kept[2]={0, 2};
+	for (index_t i=0; i<2; ++i)
+	{
+		float64_t mean=0;
+		for (index_t j=0; j<num_vectors; ++j)
+			mean+=data(kept[i], j);
+		mean/=num_vectors;
+		float64_t var=0;
+		for (index_t j=0; j<num_vectors; ++j)
+			var+=CMath::sq(data(kept[i], j)-mean);
+		float64_t std=CMath::sqrt(var/num_vectors);
+
+		for (index_t j=0; j<num_vectors; ++j)
+			EXPECT_NEAR(result(i, j), (data(kept[i], j)-mean)/std, 1e-12);
+	}
+}
+
+TEST(PruneVarSubMean, streaming_features)
+{
+	const index_t num_vectors=1000;
+	auto data=generate_data(num_vectors);
+
+	auto features=some<CDenseFeatures<float64_t>>(data);
+	auto dense=some<CPruneVarSubMean>(true);
+	dense->fit(features);
+
+	auto stream=some<CStreamingDenseFeatures<float64_t>>(features.get());
+	auto streamed=some<CPruneVarSubMean>(true);
+	streamed->fit(stream);
+
+	for (index_t j=0; j<10; ++j)
+	{
+		auto ref=dense->apply_to_feature_vector(data.get_column(j));
+		auto vec=streamed->apply_to_feature_vector(data.get_column(j));
+		ASSERT_EQ(vec.vlen, ref.vlen);
+		for (index_t i=0; i<vec.vlen; ++i)
+			EXPECT_NEAR(vec[i], ref[i], 1e-10);
+	}
+}
@@ -5,6 +5,7 @@
  */
 
 #include <gtest/gtest.h>
+#include <shogun/features/streaming/StreamingDenseFeatures.h>
 #include <shogun/preprocessor/RescaleFeatures.h>
 
 using namespace shogun;
@@ -47,3 +48,31 @@ TEST(RescaleFeatures, transform)
 
 	SG_UNREF(feats);
 }
+
+TEST(RescaleFeatures, streaming_features)
+{
+	index_t num_features = 3;
+	index_t num_vectors = 2000;
+	SGMatrix<float64_t> m(num_features, num_vectors);
+	sg_rand->set_seed(12345);
+	for (index_t i = 0; i < m.size(); i++)
+		m[i] = CMath::random(-1024.0, 1024.0);
+
+	auto feats = some<CDenseFeatures<float64_t>>(m);
+	auto dense = some<CRescaleFeatures>();
+	dense->fit(feats);
+
+	/* the stream is read in several batches */
+	auto stream = some<CStreamingDenseFeatures<float64_t>>(feats.get());
+	auto streamed = some<CRescaleFeatures>();
+	streamed->fit(stream);
+
+	for (index_t i = 0; i < 10; i++)
+	{
+		auto expected = dense->apply_to_feature_vector(m.get_column(i));
+		auto vec = streamed->apply_to_feature_vector(m.get_column(i));
+		ASSERT_EQ(expected.vlen, vec.vlen);
+		for (index_t j = 0; j < vec.vlen; j++)
+			EXPECT_DOUBLE_EQ(expected[j], vec[j]);
+	}
+}
@@ -30,6 +30,7 @@
 
 #include <gtest/gtest.h>
 #include <shogun/features/DenseFeatures.h>
+#include <shogun/features/streaming/StreamingDenseFeatures.h>
 #include <shogun/labels/RegressionLabels.h>
 #include <shogun/kernel/GaussianKernel.h>
 #include <shogun/regression/KRRNystrom.h>
@@ -157,3 +158,99 @@ TEST(KRRNystrom, apply_and_compare_to_KRR_with_column_subset)
 	for (index_t i=0; i<num_vectors; ++i)
 		EXPECT_NEAR(result->get_label(i), result_krr->get_label(i), 1E-1);
 }
+
+/**
+ * Test sampling by ridge leverage scores with kernel rows computed in
+ * blocks that do not divide the number of training points.
+ */
+TEST(KRRNystrom, apply_with_ridge_leverage_sampling_and_blocks)
+{
+	index_t num_vectors=200;
+	index_t num_basis_rkhs=60;
+
+	SGVector<float64_t> lab(num_vectors);
+	SGMatrix<float64_t> train_dat(1, num_vectors);
+	for (index_t i=0; i<num_vectors; ++i)
+	{
+		float64_t point=(float64_t)i*10/num_vectors;
+		lab.vector[i]=std::sin(point)+CMath::normal_random(0, 0.1);
+		train_dat.matrix[i]=point;
+	}
+
+	auto features=some<CDenseFeatures<float64_t>>(train_dat);
+	auto labels=some<CRegressionLabels>(lab);
+	auto kernel=some<CGaussianKernel>(features, features, 10, 0.5);
+	auto kernel_krr=some<CGaussianKernel>(features, features, 10, 0.5);
+
+	float64_t tau=0.01;
+	auto nystrom=some<CKRRNystrom>(tau, num_basis_rkhs, kernel, labels);
+	nystrom->set_landmark_sampling(LANDMARKS_RIDGE_LEVERAGE);
+	nystrom->set_block_size(7);
+	auto krr=some<CKernelRidgeRegression>(tau, kernel_krr, labels);
+
+	nystrom->train(features);
+	krr->train(features);
+
+	/* one alpha per distinct sampled point */
+	SGVector<int32_t> svs=nystrom->get_support_vectors();
+	ASSERT_EQ(svs.vlen, num_basis_rkhs);
+	EXPECT_EQ(nystrom->get_alphas().vlen, num_basis_rkhs);
+	for (index_t i=1; i<svs.vlen; ++i)
+		EXPECT_LT(svs[i-1], svs[i]);
+
+	auto result = Some<CRegressionLabels>::from_raw(
+	    nystrom->apply_regression(features));
+	auto result_krr =
+	    Some<CRegressionLabels>::from_raw(krr->apply_regression(features));
+
+	for (index_t i=0; i<num_vectors; ++i)
+		EXPECT_NEAR(result->get_label(i), result_krr->get_label(i), 1E-1);
+}
+
+/**
+ * Test training on a stream of shuffled points, of which the first are
+ * sampled, with the remaining points read in blocks.
+ */
+TEST(KRRNystrom, train_streaming_and_compare_to_KRR)
+{
+	index_t num_vectors=200;
+	index_t num_basis_rkhs=60;
+
+	SGVector<index_t> order(num_vectors);
+	order.range_fill();
+	CMath::permute(order);
+
+	SGVector<float64_t> lab(num_vectors);
+	SGMatrix<float64_t> train_dat(1, num_vectors);
+	for (index_t i=0; i<num_vectors; ++i)
+	{
+		float64_t point=(float64_t)order[i]*10/num_vectors;
+		lab.vector[i]=std::sin(point)+CMath::normal_random(0, 0.1);
+		train_dat.matrix[i]=point;
+	}
+
+	auto features=some<CDenseFeatures<float64_t>>(train_dat);
+	auto labels=some<CRegressionLabels>(lab);
+	auto stream=some<CStreamingDenseFeatures<float64_t>>(features, lab.vector);
+	auto kernel=some<CGaussianKernel>(10.0);
+	auto kernel_krr=some<CGaussianKernel>(features, features, 10, 0.5);
+
+	float64_t tau=0.01;
+	auto nystrom=some<CKRRNystrom>(tau, num_basis_rkhs, kernel, nullptr);
+	nystrom->set_block_size(7);
+	auto krr=some<CKernelRidgeRegression>(tau, kernel_krr, labels);
+
+	ASSERT_TRUE(nystrom->train_streaming(stream));
+	krr->train(features);
+
+	EXPECT_EQ(nystrom->get_support_vectors().vlen, num_basis_rkhs);
+	EXPECT_EQ(nystrom->get_alphas().vlen, num_basis_rkhs);
+
+	auto result = Some<CRegressionLabels>::from_raw(
+	    nystrom->apply_regression(features));
+	auto result_krr =
+	    Some<CRegressionLabels>::from_raw(krr->apply_regression(features));
+
+	for (index_t i=0; i<num_vectors; ++i)
+		EXPECT_NEAR(result->get_label(i), result_krr->get_label(i), 1E-1);
+}
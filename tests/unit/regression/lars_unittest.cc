@@ -495,3 +495,84 @@ TEST(LeastAngleRegression, early_stop_l1_norm)
 	SG_UNREF(features);
 	SG_UNREF(labels);
 }
+
+TEST(LeastAngleRegression, lasso_gram_n_greater_than_d)
+{
+	SGMatrix<float64_t> data(3,5);
+	SGVector<float64_t> lab(5);
+	generate_data_n_greater_d(data, lab);
+
+	CDenseFeatures<float64_t>* features=new CDenseFeatures<float64_t>(data);
+	SG_REF(features);
+	CRegressionLabels* labels=new CRegressionLabels(lab);
+	SG_REF(labels);
+	CLeastAngleRegression* lars=new CLeastAngleRegression();
+	lars->set_labels((CLabels*) labels);
+	lars->set_use_gram(true);
+	lars->train(features);
+
+	SGVector<float64_t> active3=SGVector<float64_t>(lars->get_w_for_var(3));
+	SGVector<float64_t> active2=SGVector<float64_t>(lars->get_w_for_var(2));
+	SGVector<float64_t> active1=SGVector<float64_t>(lars->get_w_for_var(1));
+
+	float64_t epsilon=0.000000000001;
+	EXPECT_NEAR(active3[0],2.911072069591,epsilon);
+	EXPECT_NEAR(active3[1],1.290672330338,epsilon);
+	EXPECT_NEAR(active3[2],2.208741384416,epsilon);
+
+	EXPECT_NEAR(active2[0],1.747958837898,epsilon);
+	EXPECT_NEAR(active2[1],0.000000000000,epsilon);
+	EXPECT_NEAR(active2[2],1.840553057519,epsilon);
+
+	EXPECT_NEAR(active1[0],0.000000000000,epsilon);
+	EXPECT_NEAR(active1[1],0.000000000000,epsilon);
+	EXPECT_NEAR(active1[2],0.092594219621,epsilon);
+
+	SG_UNREF(lars);
+	SG_UNREF(features);
+	SG_UNREF(labels);
+}
+
+// Gram matrix computed over several blocks of vectors, in float32
+TEST(LeastAngleRegression, lars_gram_path_float32)
+{
+	int32_t n_feat=8, n_vec=3000;
+	SGMatrix<float32_t> data(n_feat, n_vec);
+	SGVector<float64_t> lab(n_vec);
+	for (index_t j=0; j<n_vec; j++)
+	{
+		lab[j]=0;
+		for (index_t i=0; i<n_feat; i++)
+		{
+			data(i,j)=CMath::randn_double();
+			lab[j]+=(i%3)*data(i,j);
+		}
+		lab[j]+=0.1*CMath::randn_double();
+	}
+
+	CDenseFeatures<float32_t>* features=new CDenseFeatures<float32_t>(data);
+	SG_REF(features);
+	CRegressionLabels* labels=new CRegressionLabels(lab);
+	SG_REF(labels);
+	CLeastAngleRegression* lars=new CLeastAngleRegression(false);
+	lars->set_labels((CLabels*) labels);
+	lars->train(features);
+	CLeastAngleRegression* lars_gram=new CLeastAngleRegression(false);
+	lars_gram->set_labels((CLabels*) labels);
+	lars_gram->set_use_gram(true);
+	lars_gram->train(features);
+
+	ASSERT_EQ(lars_gram->get_path_size(), lars->get_path_size());
+	for (index_t k=0; k<lars->get_path_size(); k++)
+	{
+		SGVector<float64_t> w=lars->get_w_for_var(k);
+		SGVector<float64_t> w_gram=lars_gram->get_w_for_var(k);
+		for (index_t i=0; i<n_feat; i++)
+			EXPECT_NEAR(w_gram[i], w[i], 1e-3);
+	}
+
+	SG_UNREF(lars);
+	SG_UNREF(lars_gram);
+	SG_UNREF(features);
+	SG_UNREF(labels);
+}
@@ -0,0 +1,191 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: agent
+ */
+
+#include <gtest/gtest.h>
+
+#include <shogun/base/some.h>
+#include <shogun/kernel/GaussianKernel.h>
+#include <shogun/kernel/LinearKernel.h>
+#include <shogun/features/DenseFeatures.h>
+#include <shogun/mathematics/Math.h>
+#include <shogun/mathematics/eigen3.h>
+#include <shogun/statistical_testing/TestEnums.h>
+#include <shogun/statistical_testing/LinearTimeHSIC.h>
+
+using namespace shogun;
+using namespace Eigen;
+
+/* y depends on x through its first dimension if dependent */
+static void create_data(SGMatrix<float64_t>& data_p, SGMatrix<float64_t>& data_q,
+		index_t num, bool dependent)
+{
+	data_p=SGMatrix<float64_t>(2, num);
+	data_q=SGMatrix<float64_t>(2, num);
+	for (index_t i=0; i<num; ++i)
+	{
+		data_p(0, i)=CMath::randn_double();
+		data_p(1, i)=CMath::randn_double();
+		data_q(0, i)=(dependent ? data_p(0, i) : 0)+0.5*CMath::randn_double();
+		data_q(1, i)=CMath::randn_double();
+	}
+}
+
+TEST(LinearTimeHSIC, statistic_from_exact_features)
+{
+	const index_t num=60;
+	const index_t blocksize=10;
+
+	SGMatrix<float64_t> data_p, data_q;
+	create_data(data_p, data_q, num, true);
+
+	/* the Nystrom features of linear kernels on landmarks that span the
+	 * space reproduce the Gram matrices */
+	auto hsic=some<CLinearTimeHSIC>();
+	hsic->set_p(new CDenseFeatures<float64_t>(data_p));
+	hsic->set_q(new CDenseFeatures<float64_t>(data_q));
+	hsic->set_kernel_p(new CLinearKernel());
+	hsic->set_kernel_q(new CLinearKernel());
+	hsic->set_feature_map_method(FMM_NYSTROM);
+	hsic->set_num_features(blocksize);
+	hsic->set_blocksize(blocksize);
+	hsic->set_num_blocks_per_burst(4);
+
+	/* unbiased estimates of the blocks from the Gram matrices */
+	const index_t num_blocks=num/blocksize;
+	SGVector<float64_t> estimates(num_blocks);
+	for (index_t b=0; b<num_blocks; ++b)
+	{
+		Map<MatrixXd> x(data_p.get_column_vector(b*blocksize), 2, blocksize);
+		Map<MatrixXd> y(data_q.get_column_vector(b*blocksize), 2, blocksize);
+		MatrixXd K=x.transpose()*x;
+		MatrixXd L=y.transpose()*y;
+		K.diagonal().setZero();
+		L.diagonal().setZero();
+		VectorXd ones=VectorXd::Ones(blocksize);
+		const float64_t m=blocksize;
+		estimates[b]=((K*L).trace()+ones.dot(K*ones)*ones.dot(L*ones)/(m-1)/(m-2)
+			-2*ones.dot(K*L*ones)/(m-2))/m/(m-3);
+	}
+
+	float64_t mean=0;
+	for (index_t b=0; b<num_blocks; ++b)
+		mean+=estimates[b]/num_blocks;
+	float64_t variance=0;
+	for (index_t b=0; b<num_blocks; ++b)
+		variance+=CMath::sq(estimates[b]-mean)/(num_blocks-1);
+
+	EXPECT_NEAR(hsic->compute_statistic(), blocksize*mean, 1E-4);
+	EXPECT_NEAR(hsic->compute_variance(), blocksize*blocksize*variance/num_blocks, 1E-4);
+}
+
+TEST(LinearTimeHSIC, perform_test)
+{
+	const index_t num=4000;
+	const float64_t alpha=0.05;
+
+	sg_rand->set_seed(12345);
+	bool dependent[]={true, false};
+	for (auto is_dependent : dependent)
+	{
+		SGMatrix<float64_t> data_p, data_q;
+		create_data(data_p, data_q, num, is_dependent);
+
+		auto hsic=some<CLinearTimeHSIC>();
+		hsic->set_p(new CDenseFeatures<float64_t>(data_p));
+		hsic->set_q(new CDenseFeatures<float64_t>(data_q));
+		hsic->set_kernel_p(new CGaussianKernel(10, 2));
+		hsic->set_kernel_q(new CGaussianKernel(10, 2));
+		hsic->set_num_features(64);
+		hsic->set_blocksize(50);
+		hsic->set_num_blocks_per_burst(20);
+
+		float64_t statistic=hsic->compute_statistic();
+		float64_t p_value_gaussian=hsic->compute_p_value(statistic);
+
+		hsic->set_null_approximation_method(NAM_PERMUTATION);
+		hsic->set_num_null_samples(50);
+		SGVector<float64_t> null_samples=hsic->sample_null();
+		ASSERT_EQ(null_samples.vlen, 50);
+		float64_t p_value_permutation=hsic->compute_p_value(statistic);
+
+		if (is_dependent)
+		{
+			EXPECT_LT(p_value_gaussian, alpha);
+			EXPECT_LT(p_value_permutation, alpha);
+		}
+		else
+		{
+			EXPECT_GT(p_value_gaussian, 0.001);
+			EXPECT_GT(p_value_permutation, 0.001);
+		}
+	}
+}
+
+TEST(LinearTimeHSIC, feature_maps_follow_kernels_and_features)
+{
+	const index_t num=60;
+	const index_t blocksize=10;
+
+	SGMatrix<float64_t> data_p, data_q;
+	create_data(data_p, data_q, num, true);
+
+	/* a changed width redraws the random Fourier features */
+	auto kernel_p=some<CGaussianKernel>(10, 1);
+	auto hsic=some<CLinearTimeHSIC>();
+	hsic->set_p(new CDenseFeatures<float64_t>(data_p));
+	hsic->set_q(new CDenseFeatures<float64_t>(data_q));
+	hsic->set_kernel_p(kernel_p);
+	hsic->set_kernel_q(new CGaussianKernel(10, 2));
+	hsic->set_num_features(16);
+	hsic->set_blocksize(blocksize);
+	hsic->compute_statistic();
+
+	kernel_p->set_width(4);
+	sg_rand->set_seed(12345);
+	float64_t statistic=hsic->compute_statistic();
+
+	auto reference=some<CLinearTimeHSIC>();
+	reference->set_p(new CDenseFeatures<float64_t>(data_p));
+	reference->set_q(new CDenseFeatures<float64_t>(data_q));
+	reference->set_kernel_p(new CGaussianKernel(10, 4));
+	reference->set_kernel_q(new CGaussianKernel(10, 2));
+	reference->set_num_features(16);
+	reference->set_blocksize(blocksize);
+	sg_rand->set_seed(12345);
+	EXPECT_NEAR(statistic, reference->compute_statistic(), 1E-10);
+
+	/* samples of another dimension get their own Nystrom landmarks */
+	hsic=some<CLinearTimeHSIC>();
+	hsic->set_p(new CDenseFeatures<float64_t>(data_p));
+	hsic->set_q(new CDenseFeatures<float64_t>(data_q));
+	hsic->set_kernel_p(new CLinearKernel());
+	hsic->set_kernel_q(new CLinearKernel());
+	hsic->set_feature_map_method(FMM_NYSTROM);
+	hsic->set_num_features(blocksize);
+	hsic->set_blocksize(blocksize);
+	hsic->compute_statistic();
+
+	SGMatrix<float64_t> data_p3(3, num);
+	for (index_t i=0; i<num; ++i)
+	{
+		data_p3(0, i)=data_p(0, i);
+		data_p3(1, i)=data_p(1, i);
+		data_p3(2, i)=CMath::randn_double();
+	}
+	hsic->set_p(new CDenseFeatures<float64_t>(data_p3));
+	hsic->set_q(new CDenseFeatures<float64_t>(data_q));
+	hsic->set_blocksize(blocksize);
+
+	reference=some<CLinearTimeHSIC>();
+	reference->set_p(new CDenseFeatures<float64_t>(data_p3));
+	reference->set_q(new CDenseFeatures<float64_t>(data_q));
+	reference->set_kernel_p(new CLinearKernel());
+	reference->set_kernel_q(new CLinearKernel());
+	reference->set_feature_map_method(FMM_NYSTROM);
+	reference->set_num_features(blocksize);
+	reference->set_blocksize(blocksize);
+	EXPECT_NEAR(hsic->compute_statistic(), reference->compute_statistic(), 1E-6);
+}
@@ -43,6 +43,9 @@
 #include <shogun/statistical_testing/TestEnums.h>
 #include <shogun/statistical_testing/QuadraticTimeMMD.h>
 #include <shogun/statistical_testing/MultiKernelQuadraticTimeMMD.h>
+#include "utils/Utils.h"
+
+#include <unistd.h>
 
 using namespace shogun;
 using namespace Eigen;
@@ -538,6 +541,55 @@ TEST(QuadraticTimeMMD, precomputed_vs_nonprecomputed)
 		EXPECT_NEAR(result_1[i], result_2[i], 1E-6);
 }
 
+TEST(QuadraticTimeMMD, memory_mapped_kernel)
+{
+	const index_t m=20;
+	const index_t n=15;
+	const index_t dim=3;
+
+	auto gen_p=some<CMeanShiftDataGenerator>(0, dim, 0);
+	auto gen_q=some<CMeanShiftDataGenerator>(0.5, dim, 0);
+
+	CFeatures* features_p=gen_p->get_streamed_features(m);
+	CFeatures* features_q=gen_q->get_streamed_features(n);
+	CFeatures* features=features_p->create_merged_copy(features_q);
+	SG_REF(features);
+
+	auto kernel=some<CGaussianKernel>(10, 8);
+	kernel->init(features, features);
+
+	auto mmd=some<CQuadraticTimeMMD>();
+	mmd->set_p(features_p);
+	mmd->set_q(features_q);
+	mmd->set_kernel(kernel);
+	mmd->set_num_null_samples(10);
+	mmd->set_null_approximation_method(NAM_PERMUTATION);
+
+	sg_rand->set_seed(12345);
+	SGVector<float64_t> expected=mmd->sample_null();
+	float64_t statistic=mmd->compute_statistic();
+
+	/* the Gram matrix is kept in 16 bit floats on disk */
+	char filename[]="QuadraticTimeMMD-mmap.XXXXXX";
+	generate_temp_filename(filename);
+	kernel->init(features, features);
+	EXPECT_TRUE(CCustomKernel::save_triangle_kernel_matrix_to_file(kernel, filename, 8, true));
+
+	auto custom=new CCustomKernel();
+	EXPECT_TRUE(custom->set_triangle_kernel_matrix_from_file(filename));
+	mmd->set_kernel(custom);
+
+	sg_rand->set_seed(12345);
+	SGVector<float64_t> result=mmd->sample_null();
+	ASSERT_EQ(result.size(), expected.size());
+	for (auto i=0; i<result.size(); ++i)
+		EXPECT_NEAR(result[i], expected[i], 1E-2);
+	EXPECT_NEAR(mmd->compute_statistic(), statistic, 1E-2);
+
+	unlink(filename);
+	SG_UNREF(features);
+}
+
 TEST(QuadraticTimeMMD, multikernel_compute_statistic)
 {
 	const index_t m=20;
@@ -41,6 +41,7 @@
 #include <shogun/kernel/Kernel.h>
 #include <shogun/kernel/GaussianKernel.h>
 #include <shogun/mathematics/Math.h>
+#include <shogun/mathematics/RandomStream.h>
 #include <shogun/mathematics/eigen3.h>
 #include <shogun/statistical_testing/MMD.h>
 #include <shogun/statistical_testing/TestEnums.h>
@@ -103,12 +104,13 @@ TEST(PermutationMMD, biased_full_single_kernel)
 	Map<MatrixXf> map(kernel_matrix.matrix, kernel_matrix.num_rows, kernel_matrix.num_cols);
 	SGVector<float32_t> result_2(num_null_samples);
 	sg_rand->set_seed(12345);
+	auto seed=CMath::random();
 	for (auto i=0; i<num_null_samples; ++i)
 	{
 		PermutationMatrix<Dynamic, Dynamic> perm(kernel_matrix.num_rows);
 		perm.setIdentity();
 		SGVector<int> perminds(perm.indices().data(), perm.indices().size(), false);
-		CMath::permute(perminds);
+		RandomStream(seed, i).permute(perminds);
 		MatrixXf permuted = perm.transpose()*map*perm;
 		SGMatrix<float32_t> permuted_km(permuted.data(), permuted.rows(), permuted.cols(), false);
 		result_2[i]=compute_mmd(permuted_km);
@@ -116,11 +118,10 @@ TEST(PermutationMMD, biased_full_single_kernel)
 
 	SGVector<index_t> inds(kernel_matrix.num_rows);
 	SGVector<float32_t> result_3(num_null_samples);
-	sg_rand->set_seed(12345);
 	for (auto i=0; i<num_null_samples; ++i)
 	{
 		std::iota(inds.vector, inds.vector+inds.vlen, 0);
-		CMath::permute(inds);
+		RandomStream(seed, i).permute(inds);
 		feats->add_subset(inds);
 		kernel->init(feats, feats);
 		kernel_matrix=kernel->get_kernel_matrix<float32_t>();
@@ -183,12 +184,13 @@ TEST(PermutationMMD, unbiased_full_single_kernel)
 	Map<MatrixXf> map(kernel_matrix.matrix, kernel_matrix.num_rows, kernel_matrix.num_cols);
 	SGVector<float32_t> result_2(num_null_samples);
 	sg_rand->set_seed(12345);
+	auto seed=CMath::random();
 	for (auto i=0; i<num_null_samples; ++i)
 	{
 		PermutationMatrix<Dynamic, Dynamic> perm(kernel_matrix.num_rows);
 		perm.setIdentity();
 		SGVector<int> perminds(perm.indices().data(), perm.indices().size(), false);
-		CMath::permute(perminds);
+		RandomStream(seed, i).permute(perminds);
 		MatrixXf permuted = perm.transpose()*map*perm;
 		SGMatrix<float32_t> permuted_km(permuted.data(), permuted.rows(), permuted.cols(), false);
 		result_2[i]=compute_mmd(permuted_km);
@@ -196,11 +198,10 @@ TEST(PermutationMMD, unbiased_full_single_kernel)
 
 	SGVector<index_t> inds(kernel_matrix.num_rows);
 	SGVector<float32_t> result_3(num_null_samples);
-	sg_rand->set_seed(12345);
 	for (auto i=0; i<num_null_samples; ++i)
 	{
 		std::iota(inds.vector, inds.vector+inds.vlen, 0);
-		CMath::permute(inds);
+		RandomStream(seed, i).permute(inds);
 		feats->add_subset(inds);
 		kernel->init(feats, feats);
 		kernel_matrix=kernel->get_kernel_matrix<float32_t>();
@@ -262,12 +263,13 @@ TEST(PermutationMMD, unbiased_incomplete_single_kernel)
 	Map<MatrixXf> map(kernel_matrix.matrix, kernel_matrix.num_rows, kernel_matrix.num_cols);
 	SGVector<float32_t> result_2(num_null_samples);
 	sg_rand->set_seed(12345);
+	auto seed=CMath::random();
 	for (auto i=0; i<num_null_samples; ++i)
 	{
 		PermutationMatrix<Dynamic, Dynamic> perm(kernel_matrix.num_rows);
 		perm.setIdentity();
 		SGVector<int> perminds(perm.indices().data(), perm.indices().size(), false);
-		CMath::permute(perminds);
+		RandomStream(seed, i).permute(perminds);
 		MatrixXf permuted = perm.transpose()*map*perm;
 		SGMatrix<float32_t> permuted_km(permuted.data(), permuted.rows(), permuted.cols(), false);
 		result_2[i]=compute_mmd(permuted_km);
@@ -275,11 +277,10 @@ TEST(PermutationMMD, unbiased_incomplete_single_kernel)
 
 	SGVector<index_t> inds(kernel_matrix.num_rows);
 	SGVector<float32_t> result_3(num_null_samples);
-	sg_rand->set_seed(12345);
 	for (auto i=0; i<num_null_samples; ++i)
 	{
 		std::iota(inds.vector, inds.vector+inds.vlen, 0);
-		CMath::permute(inds);
+		RandomStream(seed, i).permute(inds);
 		feats->add_subset(inds);
 		kernel->init(feats, feats);
 		kernel_matrix=kernel->get_kernel_matrix<float32_t>();
@@ -541,3 +542,66 @@ TEST(PermutationMMD, unbiased_incomplete_multi_kernel)
 	}
 	SG_UNREF(merged_feats);
 }
+
+TEST(PermutationMMD, blocks_and_batches_single_kernel)
+{
+	const index_t dim=2;
+	const index_t n=11;
+	const index_t num_null_samples=7;
+
+	auto gen_p=some<CMeanShiftDataGenerator>(0, dim, 0);
+	auto gen_q=some<CMeanShiftDataGenerator>(0.5, dim, 0);
+	auto feats_p=gen_p->get_streamed_features(n);
+	auto feats_q=gen_q->get_streamed_features(n);
+	auto feats=feats_p->create_merged_copy(feats_q);
+	SG_REF(feats);
+	SG_UNREF(feats_p);
+	SG_UNREF(feats_q);
+
+	auto kernel=some<CGaussianKernel>();
+	kernel->set_width(2.0);
+	kernel->init(feats, feats);
+	auto kernel_matrix=kernel->get_kernel_matrix<float32_t>();
+	Map<MatrixXf> map(kernel_matrix.matrix, kernel_matrix.num_rows, kernel_matrix.num_cols);
+
+	EStatisticType stypes[]={ST_UNBIASED_FULL, ST_UNBIASED_INCOMPLETE, ST_BIASED_FULL};
+	for (auto stype : stypes)
+	{
+		/* blocks and batches that do not divide the sizes */
+		auto permutation_mmd=PermutationMMD();
+		permutation_mmd.m_n_x=n;
+		permutation_mmd.m_n_y=n;
+		permutation_mmd.m_stype=stype;
+		permutation_mmd.m_num_null_samples=num_null_samples;
+		permutation_mmd.m_block_size=5;
+		permutation_mmd.m_batch_size=3;
+
+		sg_rand->set_seed(12345);
+		SGVector<float32_t> result_1=permutation_mmd(kernel_matrix);
+		sg_rand->set_seed(12345);
+		SGVector<float32_t> result_2=permutation_mmd(Kernel(kernel));
+
+		auto compute_mmd=ComputeMMD();
+		compute_mmd.m_n_x=n;
+		compute_mmd.m_n_y=n;
+		compute_mmd.m_stype=stype;
+
+		sg_rand->set_seed(12345);
+		auto seed=CMath::random();
+		for (auto i=0; i<num_null_samples; ++i)
+		{
+			PermutationMatrix<Dynamic, Dynamic> perm(kernel_matrix.num_rows);
+			perm.setIdentity();
+			SGVector<int> perminds(perm.indices().data(), perm.indices().size(), false);
+			RandomStream(seed, i).permute(perminds);
+			MatrixXf permuted = perm.transpose()*map*perm;
+			SGMatrix<float32_t> permuted_km(permuted.data(), permuted.rows(), permuted.cols(), false);
+
+			float32_t expected=compute_mmd(permuted_km);
+			EXPECT_NEAR(result_1[i], expected, 1E-6);
+			EXPECT_NEAR(result_2[i], expected, 1E-6);
+		}
+	}
+
+	SG_UNREF(feats);
+}
@@ -5,6 +5,7 @@
 #include <shogun/structure/Factor.h>
 #include <shogun/labels/FactorGraphLabels.h>
 #include <shogun/structure/MAPInference.h>
+#include <shogun/structure/BeliefPropagation.h>
 #include <shogun/structure/FactorGraphDataGenerator.h>
 
 #include <gtest/gtest.h>
@@ -174,3 +175,337 @@ TEST(BeliefPropagation, tree_max_product_multi_states)
 	SG_UNREF(fg_test_data);
 }
 
+
+TEST(BeliefPropagation, loopy_max_product_string)
+{
+	CFactorGraphDataGenerator* fg_test_data = new CFactorGraphDataGenerator();
+	SG_REF(fg_test_data);
+
+	CFactorGraph* fg = fg_test_data->simple_chain_graph();
+
+	CMAPInference infer_met(fg, LOOPY_MAX_PROD);
+	infer_met.inference();
+
+	CFactorGraphObservation* fg_observ = infer_met.get_structured_outputs();
+	SGVector<int32_t> assignment = fg_observ->get_data();
+	SG_UNREF(fg_observ);
+
+	EXPECT_EQ(assignment[0], 0);
+	EXPECT_EQ(assignment[1], 0);
+	EXPECT_NEAR(0.4, infer_met.get_energy(), 1E-10);
+
+	SG_UNREF(fg);
+	SG_UNREF(fg_test_data);
+}
+
+TEST(BeliefPropagation, loopy_max_product_random)
+{
+	SGVector<int32_t> assignment_expected; // expected assignment
+	float64_t min_energy_expected; // expected minimum energy
+
+	CFactorGraphDataGenerator* fg_test_data = new CFactorGraphDataGenerator();
+	SG_REF(fg_test_data);
+	CFactorGraph* fg = fg_test_data->random_chain_graph(assignment_expected, min_energy_expected);
+
+	CMAPInference infer_met(fg, LOOPY_MAX_PROD);
+	infer_met.inference();
+
+	CFactorGraphObservation* fg_observ = infer_met.get_structured_outputs();
+	SGVector<int32_t> assignment = fg_observ->get_data();
+	SG_UNREF(fg_observ);
+
+	EXPECT_EQ(assignment.size(), assignment_expected.size());
+
+	for (int32_t i = 0; i < assignment.size(); i++)
+		EXPECT_EQ(assignment[i], assignment_expected[i]);
+
+	EXPECT_NEAR(min_energy_expected, infer_met.get_energy(), 1E-10);
+
+	SG_UNREF(fg_test_data);
+	SG_UNREF(fg);
+}
+
+TEST(BeliefPropagation, loopy_max_product_multi_states)
+{
+	CFactorGraphDataGenerator* fg_test_data = new CFactorGraphDataGenerator();
+	SG_REF(fg_test_data);
+
+	CFactorGraph* fg = fg_test_data->multi_state_tree_graph();
+
+	CLoopyMaxProduct* bp = new CLoopyMaxProduct(fg);
+	SG_REF(bp);
+
+	SGVector<int32_t> assignment(fg->get_num_vars());
+	float64_t energy = bp->inference(assignment);
+
+	EXPECT_TRUE(bp->is_converged());
+	EXPECT_EQ(assignment[0],2);
+	EXPECT_EQ(assignment[1],0);
+	EXPECT_EQ(assignment[2],2);
+	EXPECT_NEAR(-3.8, energy, 1E-10);
+
+	SG_UNREF(bp);
+	SG_UNREF(fg);
+	SG_UNREF(fg_test_data);
+}
+
+TEST(BeliefPropagation, loopy_sum_product_marginals)
+{
+	CFactorGraphDataGenerator* fg_test_data = new CFactorGraphDataGenerator();
+	SG_REF(fg_test_data);
+
+	CFactorGraph* fg = fg_test_data->simple_chain_graph();
+
+	CLoopyMaxProduct::Parameter param;
+	param.m_sum_product = true;
+	CLoopyMaxProduct* bp = new CLoopyMaxProduct(fg, param);
+	SG_REF(bp);
+
+	SGVector<int32_t> assignment(fg->get_num_vars());
+	bp->inference(assignment);
+	EXPECT_TRUE(bp->is_converged());
+
+	// exact marginals by enumerating all configurations
+	SGMatrix<float64_t> marginals(2, 2);
+	marginals.zero();
+	float64_t partition = 0;
+	SGVector<int32_t> state(2);
+	for (int32_t s0 = 0; s0 < 2; s0++)
+	{
+		for (int32_t s1 = 0; s1 < 2; s1++)
+		{
+			state[0] = s0;
+			state[1] = s1;
+			float64_t p = std::exp(-fg->evaluate_energy(state));
+			marginals(s0, 0) += p;
+			marginals(s1, 1) += p;
+			partition += p;
+		}
+	}
+
+	for (int32_t vi = 0; vi < 2; vi++)
+	{
+		SGVector<float64_t> log_beliefs = bp->get_log_beliefs(vi);
+		for (int32_t si = 0; si < 2; si++)
+			EXPECT_NEAR(marginals(si, vi) / partition, std::exp(log_beliefs[si]), 1E-10);
+	}
+
+	SG_UNREF(bp);
+	SG_UNREF(fg);
+	SG_UNREF(fg_test_data);
+}
+
+// binary w x h grid with 4-connected pairwise factors, i.e. a graph with
+// cycles; unary energies are in [0, 1], pairwise ones in [0, coupling]
+static CFactorGraph* random_grid_graph(int32_t w, int32_t h, float64_t coupling)
+{
+	SGVector<int32_t> card(2);
+	card[0] = 2;
+	card[1] = 2;
+	SGVector<float64_t> empty;
+	CTableFactorType* ft_pairwise = new CTableFactorType(0, card, empty);
+	SG_REF(ft_pairwise);
+
+	SGVector<int32_t> card1(1);
+	card1[0] = 2;
+	CTableFactorType* ft_unary = new CTableFactorType(1, card1, empty);
+	SG_REF(ft_unary);
+
+	SGVector<int32_t> vc(w * h);
+	SGVector<int32_t>::fill_vector(vc.vector, vc.vlen, 2);
+	CFactorGraph* fg = new CFactorGraph(vc);
+	SG_REF(fg);
+
+	for (int32_t y = 0; y < h; y++)
+	{
+		for (int32_t x = 0; x < w; x++)
+		{
+			SGVector<float64_t> data(2);
+			data[0] = CMath::random(0.0, 1.0);
+			data[1] = CMath::random(0.0, 1.0);
+			SGVector<int32_t> var_index(1);
+			var_index[0] = grid_to_index(x, y, w);
+			fg->add_factor(new CFactor(ft_unary, var_index, data));
+
+			for (int32_t dir = 0; dir < 2; dir++)
+			{
+				int32_t nx = x + (dir == 0);
+				int32_t ny = y + (dir == 1);
+				if (nx >= w || ny >= h)
+					continue;
+
+				SGVector<float64_t> pw_data(4);
+				for (int32_t i = 0; i < 4; i++)
+					pw_data[i] = CMath::random(0.0, coupling);
+				SGVector<int32_t> pw_index(2);
+				pw_index[0] = grid_to_index(x, y, w);
+				pw_index[1] = grid_to_index(nx, ny, w);
+				fg->add_factor(new CFactor(ft_pairwise, pw_index, pw_data));
+			}
+		}
+	}
+
+	SG_UNREF(ft_pairwise);
+	SG_UNREF(ft_unary);
+
+	fg->compute_energies();
+	fg->connect_components();
+
+	return fg;
+}
+
+// minimum energy assignment and exact marginals (one column per variable)
+// by enumerating all configurations of a binary factor graph
+static float64_t brute_force(CFactorGraph* fg, SGVector<int32_t>& map_assignment,
+	SGMatrix<float64_t>& marginals)
+{
+	int32_t num_vars = fg->get_num_vars();
+	SGVector<int32_t> state(num_vars);
+	map_assignment = SGVector<int32_t>(num_vars);
+	marginals = SGMatrix<float64_t>(2, num_vars);
+	marginals.zero();
+
+	float64_t min_energy = std::numeric_limits<float64_t>::infinity();
+	float64_t partition = 0;
+	for (int32_t c = 0; c < (1 << num_vars); c++)
+	{
+		for (int32_t vi = 0; vi < num_vars; vi++)
+			state[vi] = (c >> vi) & 1;
+
+		float64_t energy = fg->evaluate_energy(state);
+		if (energy < min_energy)
+		{
+			min_energy = energy;
+			map_assignment = state.clone();
+		}
+
+		float64_t p = std::exp(-energy);
+		for (int32_t vi = 0; vi < num_vars; vi++)
+			marginals(state[vi], vi) += p;
+		partition += p;
+	}
+
+	for (int32_t i = 0; i < marginals.num_rows * marginals.num_cols; i++)
+		marginals.matrix[i] /= partition;
+
+	return min_energy;
+}
+
+TEST(BeliefPropagation, loopy_max_product_grid)
+{
+	CMath::init_random(17);
+	CFactorGraph* fg = random_grid_graph(3, 3, 0.2);
+
+	SGVector<int32_t> assignment_expected;
+	SGMatrix<float64_t> marginals;
+	float64_t min_energy_expected = brute_force(fg, assignment_expected, marginals);
+
+	CLoopyMaxProduct* bp = new CLoopyMaxProduct(fg);
+	SG_REF(bp);
+
+	SGVector<int32_t> assignment(fg->get_num_vars());
+	float64_t energy = bp->inference(assignment);
+
+	// weakly coupled, so the fixed point on the loopy graph is the MAP
+	EXPECT_TRUE(bp->is_converged());
+	for (int32_t vi = 0; vi < assignment.vlen; vi++)
+		EXPECT_EQ(assignment_expected[vi], assignment[vi]);
+	EXPECT_NEAR(min_energy_expected, energy, 1E-10);
+
+	SG_UNREF(bp);
+	SG_UNREF(fg);
+}
+
+TEST(BeliefPropagation, loopy_sum_product_grid)
+{
+	CMath::init_random(17);
+	CFactorGraph* fg = random_grid_graph(3, 3, 0.2);
+
+	SGVector<int32_t> assignment_expected;
+	SGMatrix<float64_t> marginals;
+	brute_force(fg, assignment_expected, marginals);
+
+	CLoopyMaxProduct::Parameter param;
+	param.m_sum_product = true;
+	CLoopyMaxProduct* bp = new CLoopyMaxProduct(fg, param);
+	SG_REF(bp);
+
+	SGVector<int32_t> assignment(fg->get_num_vars());
+	bp->inference(assignment);
+	EXPECT_TRUE(bp->is_converged());
+
+	// loopy beliefs only approximate the marginals on a graph with cycles
+	for (int32_t vi = 0; vi < fg->get_num_vars(); vi++)
+	{
+		SGVector<float64_t> log_beliefs = bp->get_log_beliefs(vi);
+		for (int32_t si = 0; si < 2; si++)
+			EXPECT_NEAR(marginals(si, vi), std::exp(log_beliefs[si]), 1E-2);
+	}
+
+	SG_UNREF(bp);
+	SG_UNREF(fg);
+}
+
+TEST(BeliefPropagation, loopy_sum_product_infinite_energies)
+{
+	CMath::init_random(17);
+	CFactorGraph* fg = random_grid_graph(2, 2, 0.2);
+
+	// rule out state 1 of variable 0 by the pairwise factor between the
+	// variables 0 and 1, the first variable is the fastest running one
+	CDynamicObjectArray* facs = fg->get_factors();
+	CFactor* fac = dynamic_cast<CFactor*>(facs->get_element(1));
+	SGVector<float64_t> energies = fac->get_energies().clone();
+	energies[1] = std::numeric_limits<float64_t>::infinity();
+	energies[3] = std::numeric_limits<float64_t>::infinity();
+	fac->set_energies(energies);
+	SG_UNREF(fac);
+
+	SGVector<int32_t> assignment_expected;
+	SGMatrix<float64_t> marginals;
+	brute_force(fg, assignment_expected, marginals);
+
+	CLoopyMaxProduct::Parameter param;
+	param.m_sum_product = true;
+	CLoopyMaxProduct* bp = new CLoopyMaxProduct(fg, param);
+	SG_REF(bp);
+
+	SGVector<int32_t> assignment(fg->get_num_vars());
+	bp->inference(assignment);
+	EXPECT_TRUE(bp->is_converged());
+	EXPECT_EQ(assignment[0], 0);
+
+	for (int32_t vi = 0; vi < fg->get_num_vars(); vi++)
+	{
+		SGVector<float64_t> log_beliefs = bp->get_log_beliefs(vi);
+		for (int32_t si = 0; si < 2; si++)
+		{
+			EXPECT_FALSE(std::isnan(log_beliefs[si]));
+			EXPECT_NEAR(marginals(si, vi), std::exp(log_beliefs[si]), 1E-2);
+		}
+	}
+
+	// rule out state 0 by its unary factor, no state of variable 0 remains
+	fac = dynamic_cast<CFactor*>(facs->get_element(0));
+	SGVector<float64_t> unary_energies = fac->get_energies().clone();
+	unary_energies[0] = std::numeric_limits<float64_t>::infinity();
+	fac->set_energies(unary_energies);
+	SG_UNREF(fac);
+	SG_UNREF(facs);
+
+	bp->inference(assignment);
+	for (int32_t vi = 0; vi < fg->get_num_vars(); vi++)
+	{
+		SGVector<float64_t> log_beliefs = bp->get_log_beliefs(vi);
+		for (int32_t si = 0; si < 2; si++)
+			EXPECT_FALSE(std::isnan(log_beliefs[si]));
+	}
+
+	// both states of variable 0 are ruled out, neither is preferred
+	SGVector<float64_t> log_beliefs = bp->get_log_beliefs(0);
+	EXPECT_NEAR(0.5, std::exp(log_beliefs[0]), 1E-10);
+	EXPECT_NEAR(0.5, std::exp(log_beliefs[1]), 1E-10);
+
+	SG_UNREF(bp);
+	SG_UNREF(fg);
+}